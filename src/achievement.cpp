@@ -1000,6 +1000,11 @@ void achievements_tracker::notify( const cata::event &e )
     }
 }
 
+bool achievements_tracker::wants( event_type type ) const
+{
+    return type == event_type::game_start;
+}
+
 void achievements_tracker::serialize( JsonOut &jsout ) const
 {
     jsout.start_object();
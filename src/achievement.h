@@ -236,6 +236,7 @@ class achievements_tracker : public event_subscriber
 
         void clear();
         void notify( const cata::event & ) override;
+        bool wants( event_type ) const override;
 
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
@@ -1,32 +1,34 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "item.h"
 #include "safe_reference.h"
 
+static std::uint64_t explosives_added_count = 0;
+
+// Buckets of items of one speed, enough that looking through one stays short even for
+// items processed every turn
+static std::size_t num_buckets( int speed )
+{
+    constexpr int min_buckets = 16;
+    const int per_call = ( min_buckets + speed - 1 ) / speed;
+    return static_cast<std::size_t>( per_call * speed );
+}
+
 void active_item_cache::remove( const item *it )
 {
-    for( auto &list : active_items ) {
-        int count = 0;
-        list.second.second.erase( std::remove_if( list.second.second.begin(),
-        list.second.second.end(), [it, &count, &list]( const cache_reference<item> &active_item ) {
-            if( !active_item ) {
-                count++;
-                return true;
-            }
-            item *const target = &*active_item;
-            if( !target || target == it ) {
-                if( count >= list.second.first ) {
-                    list.second.first = std::max( 0, list.second.first - 1 );
-                }
-                count++;
-                return true;
-            }
-            count++;
-            return false;
-        } ), list.second.second.end() );
+    // The item may have been added when its speed was different, like a can that had food in it
+    for( std::pair<const int, speed_buckets> &by_speed : active_items ) {
+        for( std::vector<cache_reference<item>> &bucket : by_speed.second.buckets ) {
+            bucket.erase( std::remove_if( bucket.begin(), bucket.end(),
+            [it]( const cache_reference<item> &active_item ) {
+                return !active_item || &*active_item == it;
+            } ), bucket.end() );
+        }
     }
     if( it->can_revive() ) {
         std::vector<cache_reference<item>> &corpse = special_items[ special_item_type::corpse ];
@@ -40,39 +42,67 @@ void active_item_cache::remove( const item *it )
 
 void active_item_cache::add( item &it )
 {
+    const int speed = it.processing_speed();
+    speed_buckets &by_speed = active_items[speed];
+    if( by_speed.buckets.empty() ) {
+        by_speed.buckets.resize( num_buckets( speed ) );
+    }
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::vector<cache_reference<item>> &target_list = active_items[it.processing_speed()].second;
-    if( std::find( target_list.begin(), target_list.end(), it ) != target_list.end() ) {
-        return;
+    for( const std::vector<cache_reference<item>> &bucket : by_speed.buckets ) {
+        if( std::find( bucket.begin(), bucket.end(), it ) != bucket.end() ) {
+            return;
+        }
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].emplace_back( it );
     }
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].emplace_back( it );
+        explosives_added_count++;
     }
-    target_list.emplace_back( it );
+    by_speed.buckets[by_speed.added++ % by_speed.buckets.size()].emplace_back( it );
 }
 
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.second.empty();
+    return std::all_of( active_items.begin(), active_items.end(), []( const auto & by_speed ) {
+        return std::all_of( by_speed.second.buckets.begin(), by_speed.second.buckets.end(),
+        []( const std::vector<cache_reference<item>> &bucket ) {
+            return bucket.empty();
+        } );
     } );
 }
 
+std::size_t active_item_cache::size() const
+{
+    std::size_t ret = 0;
+    for( const auto &by_speed : active_items ) {
+        for( const std::vector<cache_reference<item>> &bucket : by_speed.second.buckets ) {
+            ret += bucket.size();
+        }
+    }
+    return ret;
+}
+
+// Moves the items still alive in the bucket to the end of `out`, dropping the broken ones
+static void collect_bucket( std::vector<cache_reference<item>> &bucket, std::vector<item *> &out )
+{
+    bucket.erase( std::remove_if( bucket.begin(), bucket.end(),
+    [&out]( const cache_reference<item> &active_item ) {
+        if( !active_item ) {
+            return true;
+        }
+        out.push_back( & *active_item );
+        return false;
+    } ), bucket.end() );
+}
+
 std::vector<item *> active_item_cache::get()
 {
     std::vector<item *> all_cached_items;
-    for( std::pair<const int, std::pair<int, std::vector<cache_reference<item>>>> &kv : active_items ) {
-        for( std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-             it != kv.second.second.end(); ) {
-            if( *it ) {
-                all_cached_items.push_back( & **it );
-                ++it;
-            } else {
-                it = kv.second.second.erase( it );
-            }
+    for( std::pair<const int, speed_buckets> &kv : active_items ) {
+        for( std::vector<cache_reference<item>> &bucket : kv.second.buckets ) {
+            collect_bucket( bucket, all_cached_items );
         }
     }
     return all_cached_items;
@@ -81,41 +111,16 @@ std::vector<item *> active_item_cache::get()
 std::vector<item *> active_item_cache::get_for_processing()
 {
     std::vector<item *> items_to_process;
-    for( std::pair < const int, std::pair<int, std::vector<cache_reference<item>>>> &kv :
-         active_items ) {
-        //The algorithm here is a bit weird. We're going to process a fraction of the list at a time, keeping track of where we are in the list with a simple int.
-        //But, the list could change between each run. As such the number will be reduced when items are removed from it (in ::remove) to prevent skips.
-
-        if( kv.second.second.empty() ) { //Prevents a div by 0 in the modulo operations
-            kv.second.first = 0; //May as well reset the position
-            continue;
-        }
-
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = std::max( 1, static_cast<int>( kv.second.second.size() / kv.first ) );
-        std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-
-
-        kv.second.first = kv.second.first %
-                          kv.second.second.size(); //Make sure the key isn't larger than the array
-        std::advance( it, kv.second.first );
-
-        kv.second.first += num_to_process + 1;
-        while( num_to_process > 0 ) {
-            if( *it ) {
-                items_to_process.push_back( & **it );
-                --num_to_process;
-                ++it;
-            } else {
-                // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.second.erase( it );
-                if( kv.second.second.empty() ) {
-                    break;
-                }
-            }
-            if( it == kv.second.second.end() ) {
-                it = kv.second.second.begin();
-            }
+    for( std::pair<const int, speed_buckets> &kv : active_items ) {
+        speed_buckets &by_speed = kv.second;
+        const std::size_t per_call = by_speed.buckets.size() / kv.first;
+        // As long as there are any, at least one item comes up each call, so a few slow items
+        // don't wait for the ring to come round to them
+        const std::size_t found_before = items_to_process.size();
+        for( std::size_t i = 0; i < by_speed.buckets.size() &&
+             ( i < per_call || items_to_process.size() == found_before ); i++ ) {
+            collect_bucket( by_speed.buckets[by_speed.next], items_to_process );
+            by_speed.next = ( by_speed.next + 1 ) % by_speed.buckets.size();
         }
     }
     return items_to_process;
@@ -131,3 +136,8 @@ std::vector<item *> active_item_cache::get_special( special_item_type type )
     }
     return matching_items;
 }
+
+std::uint64_t active_item_cache::explosives_added()
+{
+    return explosives_added_count;
+}
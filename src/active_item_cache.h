@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_ACTIVE_ITEM_CACHE_H
 #define CATA_SRC_ACTIVE_ITEM_CACHE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <list>
 #include <unordered_map>
@@ -31,13 +33,25 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::pair<int, std::vector<cache_reference<item>>>> active_items;
+        /**
+         * The items of one processing speed, dealt out over buckets in the order they were added,
+         * so which turn an item comes up on doesn't depend on where it is in memory. Each call
+         * to @ref get_for_processing takes the next few buckets, so every item comes up at least
+         * once every `speed` calls.
+         */
+        struct speed_buckets {
+            std::vector<std::vector<cache_reference<item>>> buckets;
+            // The bucket to process next
+            std::size_t next = 0;
+            // Items ever added, the next one goes in the bucket after
+            std::size_t added = 0;
+        };
+        std::unordered_map<int, speed_buckets> active_items;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
 
     public:
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          * Also removes any items that have been destroyed in the list containing it
          */
         void remove( const item *it );
@@ -52,6 +66,8 @@ class active_item_cache
          * Returns true if the cache is empty
          */
         bool empty() const;
+        /** Number of cached references, broken ones included until they are next cleaned up. */
+        std::size_t size() const;
 
         /**
          * Returns a vector of all cached active item references.
@@ -60,9 +76,9 @@ class active_item_cache
         std::vector<item *> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items due for processing, about size() / processing_speed() of each speed.
+         * Every item is returned at least once in processing_speed() calls, and as long as
+         * there are items at least one is returned, however few there are.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
@@ -73,6 +89,12 @@ class active_item_cache
          * Returns the currently tracked list of special active items.
          */
         std::vector<item *> get_special( special_item_type type );
+
+        /**
+         * Goes up every time an explosive is added to any cache, so a search for explosives
+         * stays valid until then.
+         */
+        static std::uint64_t explosives_added();
 };
 
 #endif // CATA_SRC_ACTIVE_ITEM_CACHE_H
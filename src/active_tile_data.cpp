@@ -86,6 +86,9 @@ class null_tile_data : public active_tile_data
 {
         void update_internal( time_point, const tripoint_abs_ms &, distribution_grid & ) override
         {}
+        bool needs_updates() const override {
+            return false;
+        }
         active_tile_data *clone() const override {
             return new null_tile_data( *this );
         }
@@ -166,6 +169,11 @@ void battery_tile::update_internal( time_point, const tripoint_abs_ms &, distrib
     // TODO: Shouldn't have this function!
 }
 
+bool battery_tile::needs_updates() const
+{
+    return false;
+}
+
 active_tile_data *battery_tile::clone() const
 {
     return new battery_tile( *this );
@@ -355,6 +363,11 @@ void vehicle_connector_tile::update_internal( time_point, const tripoint_abs_ms
 {
 }
 
+bool vehicle_connector_tile::needs_updates() const
+{
+    return false;
+}
+
 active_tile_data *vehicle_connector_tile::clone() const
 {
     return new vehicle_connector_tile( *this );
@@ -34,6 +34,14 @@ class active_tile_data
             last_updated = to;
         }
 
+        /**
+         * Whether updating the tile can do anything. Tiles that only store or pass on
+         * the resource don't need to be updated every turn.
+         */
+        virtual bool needs_updates() const {
+            return true;
+        }
+
         time_point get_last_updated() {
             return last_updated;
         }
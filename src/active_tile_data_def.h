@@ -25,6 +25,7 @@ class battery_tile : public active_tile_data
         int max_stored;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        bool needs_updates() const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -95,6 +96,7 @@ class vehicle_connector_tile : public active_tile_data
         std::vector<tripoint_abs_ms> connected_vehicles;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        bool needs_updates() const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
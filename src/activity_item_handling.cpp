@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <iterator>
 #include <list>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -123,6 +124,7 @@ static const zone_type_id zone_type_CONSTRUCTION_BLUEPRINT( "CONSTRUCTION_BLUEPR
 static const zone_type_id zone_type_FARM_PLOT( "FARM_PLOT" );
 static const zone_type_id zone_type_FISHING_SPOT( "FISHING_SPOT" );
 static const zone_type_id zone_type_LOOT_CORPSE( "LOOT_CORPSE" );
+static const zone_type_id zone_type_LOOT_CUSTOM( "LOOT_CUSTOM" );
 static const zone_type_id zone_type_LOOT_IGNORE( "LOOT_IGNORE" );
 static const zone_type_id zone_type_LOOT_IGNORE_FAVORITES( "LOOT_IGNORE_FAVORITES" );
 static const zone_type_id zone_type_MINING( "MINING" );
@@ -1497,7 +1499,7 @@ static activity_reason_info can_do_activity_there( const activity_id &act, playe
         return activity_reason_info::fail( do_activity_reason::NO_ZONE );
     }
     if( act == ACT_MULTIPLE_MINE ) {
-        if( !here.has_flag( "MINEABLE", src_loc ) ) {
+        if( !here.has_flag( TFLAG_MINEABLE, src_loc ) ) {
             return activity_reason_info::fail( do_activity_reason::NO_ZONE );
         }
         std::vector<item *> mining_inv = p.items_with( []( const item & itm ) {
@@ -2323,8 +2325,8 @@ void activity_on_turn_move_loot( player_activity &act, player &p )
 
         // the boolean in this pair being true indicates the item is from a vehicle storage space
         auto items = std::vector<std::pair<item *, bool>>();
-        vehicle *src_veh, *dest_veh;
-        int src_part, dest_part;
+        vehicle *src_veh;
+        int src_part;
 
         //Check source for cargo part
         //map_stack and vehicle_stack are different types but inherit from item_stack
@@ -2352,6 +2354,18 @@ void activity_on_turn_move_loot( player_activity &act, player &p )
             items.emplace_back( it, false );
         }
 
+        // Destination tiles of each zone type, looked up once for all the items on this tile
+        struct sort_destination {
+            tripoint abs;
+            // Tiles in a custom zone only take the items its filter matches
+            bool custom = false;
+            // Whether the tile was looked at since the last item was moved there
+            bool checked = false;
+            bool usable = false;
+            units::volume free_space = 0_ml;
+        };
+        std::map<zone_type_id, std::vector<sort_destination>> destinations;
+
         //Skip items that have already been processed
         for( auto it = items.begin() + num_processed; it < items.end(); ++it ) {
             ++num_processed;
@@ -2377,37 +2391,42 @@ void activity_on_turn_move_loot( player_activity &act, player &p )
                 continue;
             }
 
-            const std::unordered_set<tripoint> &dest_set = mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE,
-                    &thisitem );
-            for( const tripoint &dest : dest_set ) {
-                const tripoint &dest_loc = here.getlocal( dest );
-
-                //Check destination for cargo part
-                if( const std::optional<vpart_reference> vp = here.veh_at( dest_loc ).part_with_feature( "CARGO",
-                        false ) ) {
-                    dest_veh = &vp->vehicle();
-                    dest_part = vp->part_index();
-                } else {
-                    dest_veh = nullptr;
-                    dest_part = -1;
+            auto dest_set = destinations.find( id );
+            if( dest_set == destinations.end() ) {
+                dest_set = destinations.emplace( id, std::vector<sort_destination>() ).first;
+                for( const tripoint &dest : mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE ) ) {
+                    sort_destination &added = dest_set->second.emplace_back();
+                    added.abs = dest;
+                    added.custom = mgr.has( zone_type_LOOT_CUSTOM, dest );
                 }
-
-                // skip tiles with inaccessible furniture, like filled charcoal kiln
-                if( !here.can_put_items_ter_furn( dest_loc ) ||
-                    static_cast<int>( here.i_at( dest_loc ).size() ) >= MAX_ITEM_IN_SQUARE ) {
+            }
+            for( sort_destination &dest : dest_set->second ) {
+                if( dest.custom && !mgr.custom_loot_has( dest.abs, &thisitem ) ) {
                     continue;
                 }
-
-                units::volume free_space;
-                // if there's a vehicle with space do not check the tile beneath
-                if( dest_veh ) {
-                    free_space = dest_veh->free_volume( dest_part );
-                } else {
-                    free_space = here.free_volume( dest_loc );
+                const tripoint &dest_loc = here.getlocal( dest.abs );
+
+                if( !dest.checked ) {
+                    dest.checked = true;
+                    // skip tiles with inaccessible furniture, like filled charcoal kiln
+                    dest.usable = here.can_put_items_ter_furn( dest_loc ) &&
+                                  static_cast<int>( here.i_at( dest_loc ).size() ) < MAX_ITEM_IN_SQUARE;
+                    if( dest.usable ) {
+                        //Check destination for cargo part
+                        // if there's a vehicle with space do not check the tile beneath
+                        if( const std::optional<vpart_reference> vp = here.veh_at( dest_loc ).part_with_feature( "CARGO",
+                                false ) ) {
+                            dest.free_space = vp->vehicle().free_volume( vp->part_index() );
+                        } else {
+                            dest.free_space = here.free_volume( dest_loc );
+                        }
+                    }
                 }
+
                 // check free space at destination
-                if( free_space >= thisitem.volume() ) {
+                if( dest.usable && dest.free_space >= thisitem.volume() ) {
                     move_item( p, thisitem, thisitem.count(), src_loc, dest_loc );
+                    dest.checked = false;
 
                     // moved item away from source so decrement
                     if( num_processed > 0 ) {
@@ -2443,7 +2462,7 @@ static bool mine_activity( player &p, const tripoint &src_loc )
                ( itm.type->can_use( "JACKHAMMER" ) && itm.ammo_sufficient() );
     } );
     if( mining_inv.empty() || p.is_mounted() || p.is_underwater() || here.veh_at( src_loc ) ||
-        !here.has_flag( "MINEABLE", src_loc ) ) {
+        !here.has_flag( TFLAG_MINEABLE, src_loc ) ) {
         return false;
     }
     item *chosen_item = nullptr;
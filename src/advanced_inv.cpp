@@ -557,6 +557,8 @@ int advanced_inventory::print_header( advanced_inventory_pane &pane, aim_locatio
 
 void advanced_inventory::recalc_pane( side p )
 {
+    // Filtering and listing ask for the names of the same items several times
+    const scoped_item_name_cache names;
     auto &pane = panes[p];
     pane.recalc = false;
     pane.items.clear();
@@ -1222,6 +1224,7 @@ bool advanced_inventory::action_move_item( advanced_inv_listitem *sitem,
     // are recalculated, even when they might not have changed, but they could (e.g. items
     // taken from inventory, but unable to put into the cargo trunk go back into the inventory,
     // but are potentially at a different place).
+    invalidate_listings();
     recalc = true;
     assert( amount_to_move > 0 );
     if( destarea == AIM_CONTAINER ) {
@@ -1464,6 +1467,7 @@ void advanced_inventory::display()
                 item->set_favorite( !item->is_favorite );
             }
             // In case we've merged faved and unfaved items
+            invalidate_listings();
             recalc = true;
         } else if( action == "MOVE_SINGLE_ITEM" ||
                    action == "MOVE_VARIABLE_ITEM" ||
@@ -1471,6 +1475,7 @@ void advanced_inventory::display()
             exit = action_move_item( sitem, dpane, spane, action );
         } else if( action == "MOVE_ALL_ITEMS" ) {
             exit = move_all_items();
+            invalidate_listings();
             recalc = true;
         } else if( action == "SORT" ) {
             if( show_sort_menu( spane ) ) {
@@ -1517,12 +1522,15 @@ void advanced_inventory::display()
                 get_auto_pickup().add_rule( sitem->items.front() );
                 sitem->autopickup = true;
             }
+            invalidate_listings();
             recalc = true;
         } else if( action == "EXAMINE" ) {
             if( sitem == nullptr || !sitem->is_item_entry() ) {
                 continue;
             }
             action_examine( sitem, spane );
+            // Examining can change the items in ways the listings don't notice
+            invalidate_listings();
         } else if( action == "QUIT" ) {
             exit = true;
             if( get_option<bool>( "AIM_AUTORESET_FILTER" ) ) {
@@ -1910,6 +1918,13 @@ void advanced_inventory::swap_panes()
     recalc = true;
 }
 
+void advanced_inventory::invalidate_listings()
+{
+    for( advanced_inv_area &square : squares ) {
+        square.invalidate_listings();
+    }
+}
+
 void advanced_inventory::do_return_entry()
 {
     // only save pane settings
@@ -124,6 +124,8 @@ class advanced_inventory
         // store/load settings (such as index, filter, etc)
         void save_settings( bool only_panes );
         void load_settings();
+        /** Makes the squares stack their items again, see @ref advanced_inv_area::listed_stacks. */
+        void invalidate_listings();
         // used to return back to AIM when other activities queued are finished
         void do_return_entry();
         // returns true if currently processing a routine
@@ -467,3 +467,40 @@ advanced_inv_area::itemstack advanced_inv_area::i_stacked<vehicle_stack>( vehicl
 
 template
 advanced_inv_area::itemstack advanced_inv_area::i_stacked<map_stack>( map_stack items );
+
+template <typename T>
+static std::vector<std::pair<const item *, int>> listing_source( T items )
+{
+    std::vector<std::pair<const item *, int>> ret;
+    for( const item *it : items ) {
+        ret.emplace_back( it, it->charges );
+    }
+    return ret;
+}
+
+const std::vector<advanced_inv_listitem> &advanced_inv_area::listed_stacks( bool in_vehicle )
+{
+    listing &cached = listings[in_vehicle ? 1 : 0];
+    map &here = get_map();
+    std::vector<std::pair<const item *, int>> source = in_vehicle ?
+            listing_source( veh->get_items( vstor ) ) : listing_source( here.i_at( pos ) );
+    if( cached.valid && cached.source == source ) {
+        return cached.stacks;
+    }
+    const itemstack stacks = in_vehicle ? i_stacked( veh->get_items( vstor ) ) :
+                             i_stacked( here.i_at( pos ) );
+    cached.stacks.clear();
+    for( size_t x = 0; x < stacks.size(); ++x ) {
+        cached.stacks.emplace_back( stacks[x], x, id, in_vehicle );
+    }
+    cached.source = std::move( source );
+    cached.valid = true;
+    return cached.stacks;
+}
+
+void advanced_inv_area::invalidate_listings()
+{
+    for( listing &cached : listings ) {
+        cached.valid = false;
+    }
+}
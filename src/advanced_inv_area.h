@@ -2,12 +2,14 @@
 #ifndef CATA_SRC_ADVANCED_INV_AREA_H
 #define CATA_SRC_ADVANCED_INV_AREA_H
 
+#include "advanced_inv_listitem.h"
 #include "point.h"
 #include "units.h"
 
 #include <array>
 #include <list>
 #include <string>
+#include <utility>
 #include <vector>
 
 enum aim_location : char {
@@ -33,7 +35,6 @@ enum aim_location : char {
     AIM_AROUND_END = AIM_NORTHEAST
 };
 
-class advanced_inv_listitem;
 class item;
 class vehicle;
 
@@ -90,6 +91,14 @@ class advanced_inv_area
 
         template <typename T>
         advanced_inv_area::itemstack i_stacked( T items );
+        /**
+         * The unfiltered stacks of the ground (or the vehicle cargo) of a map square. They are
+         * kept until the items or charges there change, so filtering, sorting or changing the
+         * other pane doesn't stack a big pile again.
+         */
+        const std::vector<advanced_inv_listitem> &listed_stacks( bool in_vehicle );
+        /** Forgets the stacks listed so far, for changes to the items that keep their charges. */
+        void invalidate_listings();
         // if you want vehicle cargo, specify so via `in_vehicle'
         units::volume free_volume( bool in_vehicle = false ) const;
         int get_item_count() const;
@@ -109,5 +118,15 @@ class advanced_inv_area
             }
             return veh != nullptr && vstor >= 0;
         }
+
+    private:
+        struct listing {
+            bool valid = false;
+            // The items and their charges the stacks were made of
+            std::vector<std::pair<const item *, int>> source;
+            std::vector<advanced_inv_listitem> stacks;
+        };
+        // Of the ground and the vehicle cargo
+        std::array<listing, 2> listings;
 };
 #endif // CATA_SRC_ADVANCED_INV_AREA_H
@@ -89,7 +89,6 @@ void advanced_inventory_pane::add_items_from_area( advanced_inv_area &square,
     if( !square.canputitems() ) {
         return;
     }
-    map &m = get_map();
     avatar &u = get_avatar();
     // Existing items are *not* cleared on purpose, this might be called
     // several times in case all surrounding squares are to be shown.
@@ -134,12 +133,7 @@ void advanced_inventory_pane::add_items_from_area( advanced_inv_area &square,
         }
     } else {
         bool is_in_vehicle = square.can_store_in_vehicle() && ( in_vehicle() || vehicle_override );
-        const advanced_inv_area::itemstack &stacks = is_in_vehicle ?
-                square.i_stacked( square.veh->get_items( square.vstor ) ) :
-                square.i_stacked( m.i_at( square.pos ) );
-
-        for( size_t x = 0; x < stacks.size(); ++x ) {
-            advanced_inv_listitem it( stacks[x], x, square.id, is_in_vehicle );
+        for( const advanced_inv_listitem &it : square.listed_stacks( is_in_vehicle ) ) {
             if( is_filtered( *it.items.front() ) ) {
                 continue;
             }
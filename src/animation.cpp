@@ -32,6 +32,7 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <list>
 #include <map>
 #include <string>
@@ -60,10 +61,13 @@ class basic_animation
         }
 
         void progress() const {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
             draw();
 
+            // Drawing the frame is part of its delay, instead of adding to it
             // NOLINTNEXTLINE(cata-no-long): timespec uses long int
-            long int remain = delay;
+            long int remain = delay - std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start ).count();
             while( remain > 0 ) {
                 // NOLINTNEXTLINE(cata-no-long): timespec uses long int
                 long int do_sleep = std::min( remain, 100'000'000L );
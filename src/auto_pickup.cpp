@@ -32,9 +32,6 @@
 
 using namespace auto_pickup;
 
-static bool check_special_rule( const std::vector<material_id> &materials,
-                                const std::string &rule );
-
 auto_pickup::player_settings &get_auto_pickup()
 {
     static auto_pickup::player_settings single_instance;
@@ -420,9 +417,10 @@ void rule::test_pattern() const
 
     //Loop through all itemfactory items
     //APU now ignores prefixes, bottled items and suffix combinations still not generated
+    const compiled_rule compiled( *this );
     for( const itype *e : item_controller->all() ) {
         const std::string sItemName = e->nname( 1 );
-        if( !check_special_rule( e->materials, sRule ) && !wildcard_match( sItemName, sRule ) ) {
+        if( !compiled.matches( sItemName, e->materials ) ) {
             continue;
         }
 
@@ -540,6 +538,7 @@ bool player_settings::has_rule( const item *it )
 void player_settings::add_rule( const item *it )
 {
     character_rules.push_back( rule( it->tname( 1, false ), true, false ) );
+    invalidate();
     create_rule( it );
 
     if( !get_option<bool>( "AUTO_PICKUP" ) &&
@@ -568,32 +567,45 @@ bool player_settings::empty() const
     return global_rules.empty() && character_rules.empty();
 }
 
-bool check_special_rule( const std::vector<material_id> &materials, const std::string &rule )
+compiled_rule::compiled_rule( const rule &r )
+    : exclude( r.bExclude ), blank( r.sRule.empty() ), pattern( r.sRule )
 {
-    char type = ' ';
-    std::vector<std::string> filter;
-    if( rule[1] == ':' ) {
-        type = rule[0];
-        filter = string_split( rule.substr( 2 ), ',' );
+    if( r.sRule.size() > 1 && r.sRule[1] == ':' ) {
+        material_type = r.sRule[0];
+        for( const std::string &search : string_split( r.sRule.substr( 2 ), ',' ) ) {
+            material_filter.emplace_back( search );
+        }
     }
+}
+
+bool compiled_rule::matches( const std::string &name ) const
+{
+    return pattern.matches( name );
+}
+
+bool compiled_rule::matches( const std::string &name,
+                             const std::vector<material_id> &materials ) const
+{
+    return matches_materials( materials ) || pattern.matches( name );
+}
 
-    if( filter.empty() || materials.empty() ) {
+bool compiled_rule::matches_materials( const std::vector<material_id> &materials ) const
+{
+    if( material_filter.empty() || materials.empty() ) {
         return false;
     }
 
-    if( type == 'm' ) {
-        return std::any_of( materials.begin(), materials.end(), [&filter]( const material_id & mat ) {
-            return std::any_of( filter.begin(), filter.end(), [&mat]( const std::string & search ) {
-                return lcmatch( mat->name(), search );
-            } );
-        } );
-
-    } else if( type == 'M' ) {
-        return std::all_of( materials.begin(), materials.end(), [&filter]( const material_id & mat ) {
-            return std::any_of( filter.begin(), filter.end(), [&mat]( const std::string & search ) {
-                return lcmatch( mat->name(), search );
-            } );
+    const auto matches_filter = [this]( const material_id & mat ) {
+        const std::string name = mat->name();
+        return std::any_of( material_filter.begin(), material_filter.end(),
+        [&name]( const lcmatcher & search ) {
+            return search( name );
         } );
+    };
+    if( material_type == 'm' ) {
+        return std::any_of( materials.begin(), materials.end(), matches_filter );
+    } else if( material_type == 'M' ) {
+        return std::all_of( materials.begin(), materials.end(), matches_filter );
     }
 
     return false;
@@ -602,41 +614,40 @@ bool check_special_rule( const std::vector<material_id> &materials, const std::s
 //Special case. Required for NPC harvest autopickup. Ignores material rules.
 void npc_settings::create_rule( const std::string &to_match )
 {
-    rules.create_rule( map_items, to_match );
-}
+    if( !map_items.ready ) {
+        recreate();
+    }
+    if( map_items.count( to_match ) ) {
+        return;
+    }
 
-void rule_list::create_rule( cache &map_items, const std::string &to_match )
-{
-    for( const rule &elem : *this ) {
-        if( !elem.bActive || !wildcard_match( to_match, elem.sRule ) ) {
-            continue;
+    rule_state state = RULE_NONE;
+    for( const compiled_rule &elem : map_items.rules ) {
+        if( elem.matches( to_match ) ) {
+            state = elem.exclude ? RULE_BLACKLISTED : RULE_WHITELISTED;
         }
-
-        map_items[ to_match ] = elem.bExclude ? RULE_BLACKLISTED : RULE_WHITELISTED;
     }
+    map_items[ to_match ] = state;
 }
 
 void player_settings::create_rule( const item *it )
 {
+    if( !map_items.ready ) {
+        recreate();
+    }
     // TODO: change it to be a reference
-    global_rules.create_rule( map_items, *it );
-    character_rules.create_rule( map_items, *it );
-}
-
-void rule_list::create_rule( cache &map_items, const item &it )
-{
-    const std::string to_match = it.tname( 1, false );
+    const std::string to_match = it->tname( 1, false );
+    if( map_items.count( to_match ) ) {
+        return;
+    }
 
-    for( const rule &elem : *this ) {
-        if( !elem.bActive ) {
-            continue;
-        } else if( !check_special_rule( it.made_of(), elem.sRule ) &&
-                   !wildcard_match( to_match, elem.sRule ) ) {
-            continue;
+    rule_state state = RULE_NONE;
+    for( const compiled_rule &elem : map_items.rules ) {
+        if( elem.matches( to_match, it->made_of() ) ) {
+            state = elem.exclude ? RULE_BLACKLISTED : RULE_WHITELISTED;
         }
-
-        map_items[ to_match ] = elem.bExclude ? RULE_BLACKLISTED : RULE_WHITELISTED;
     }
+    map_items[ to_match ] = state;
 }
 
 void player_settings::refresh_map_items( cache &map_items ) const
@@ -650,17 +661,22 @@ void player_settings::refresh_map_items( cache &map_items ) const
 
 void rule_list::refresh_map_items( cache &map_items ) const
 {
-    for( const rule &elem : *this ) {
-        if( elem.sRule.empty() || !elem.bActive ) {
+    for( const rule &r : *this ) {
+        if( !r.bActive ) {
+            continue;
+        }
+        map_items.rules.emplace_back( r );
+        const compiled_rule &elem = map_items.rules.back();
+        if( elem.blank ) {
             continue;
         }
 
-        if( !elem.bExclude ) {
+        if( !elem.exclude ) {
             //Check include patterns against all itemfactory items
             for( const itype *e : item_controller->all() ) {
                 const std::string &cur_item = e->nname( 1 );
 
-                if( !check_special_rule( e->materials, elem.sRule ) && !wildcard_match( cur_item, elem.sRule ) ) {
+                if( !elem.matches( cur_item, e->materials ) ) {
                     continue;
                 }
 
@@ -671,8 +687,7 @@ void rule_list::refresh_map_items( cache &map_items ) const
             //only re-exclude items from the existing mapping for now
             //new exclusions will process during pickup attempts
             for( auto &map_item : map_items ) {
-                if( !check_special_rule( map_items.temp_items[ map_item.first ]->materials, elem.sRule ) &&
-                    !wildcard_match( map_item.first, elem.sRule ) ) {
+                if( !elem.matches( map_item.first, map_items.temp_items[ map_item.first ]->materials ) ) {
                     continue;
                 }
 
@@ -830,6 +845,7 @@ bool npc_settings::empty() const
 void base_settings::recreate() const
 {
     map_items.clear();
+    map_items.rules.clear();
     map_items.temp_items.clear();
     refresh_map_items( map_items );
     map_items.ready = true;
@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "enums.h"
+#include "string_utils.h"
+#include "type_id.h"
 
 class JsonIn;
 class JsonOut;
@@ -18,22 +20,6 @@ struct itype;
 namespace auto_pickup
 {
 
-/**
- * The currently-active set of auto-pickup rules, in a form that allows quick
- * lookup. When this is filled (by @ref auto_pickup::create_rule()), every
- * item existing in the game that matches a rule (either white- or blacklist)
- * is added as the key, with RULE_WHITELISTED or RULE_BLACKLISTED as the values.
- */
-class cache : public std::unordered_map<std::string, rule_state>
-{
-    public:
-        /// Defines whether this cache has been filled.
-        bool ready = false;
-
-        /// Temporary data used while filling the cache.
-        std::unordered_map<std::string, const itype *> temp_items;
-};
-
 /**
  * A single entry in the list of auto pickup entries @ref rule_list.
  * The data contained can be edited by the player and determines what to pick/ignore.
@@ -56,6 +42,52 @@ class rule
         void test_pattern() const;
 };
 
+/**
+ * An active @ref rule with its wildcard pattern and material filter ("m:" or "M:") split
+ * once, so matching it against many item names doesn't parse the rule again.
+ */
+class compiled_rule
+{
+    public:
+        explicit compiled_rule( const rule &r );
+
+        /** Matches the name only, material rules are ignored. */
+        bool matches( const std::string &name ) const;
+        bool matches( const std::string &name, const std::vector<material_id> &materials ) const;
+
+        bool exclude = false;
+        /** Rules without any text only apply to single items, see @ref cache::rules. */
+        bool blank = false;
+
+    private:
+        bool matches_materials( const std::vector<material_id> &materials ) const;
+
+        wildcard_pattern pattern;
+        char material_type = ' ';
+        std::vector<lcmatcher> material_filter;
+};
+
+/**
+ * The currently-active set of auto-pickup rules, in a form that allows quick
+ * lookup. When this is filled, every item existing in the game that matches
+ * a rule (either white- or blacklist) is added as the key, with RULE_WHITELISTED
+ * or RULE_BLACKLISTED as the values. Names of other items are added as they are
+ * looked up by @ref auto_pickup::player_settings::create_rule(), RULE_NONE included,
+ * so each name is matched against the rules only once until the rules change.
+ */
+class cache : public std::unordered_map<std::string, rule_state>
+{
+    public:
+        /// Defines whether this cache has been filled.
+        bool ready = false;
+
+        /// The active rules the cache was filled from, in the order they apply.
+        std::vector<compiled_rule> rules;
+
+        /// Temporary data used while filling the cache.
+        std::unordered_map<std::string, const itype *> temp_items;
+};
+
 /**
  * A list of rules. This is primarily a container with a few convenient functions (like saving/loading).
  */
@@ -66,9 +98,6 @@ class rule_list : public std::vector<rule>
         void deserialize( JsonIn &jsin );
 
         void refresh_map_items( cache &map_items ) const;
-
-        void create_rule( cache &map_items, const std::string &to_match );
-        void create_rule( cache &map_items, const item &it );
 };
 
 class user_interface
@@ -99,12 +128,11 @@ class base_settings
         mutable cache map_items;
 
         void invalidate();
+        void recreate() const;
 
     private:
         virtual void refresh_map_items( cache &map_items ) const = 0;
 
-        void recreate() const;
-
     public:
         virtual ~base_settings() = default;
         rule_state check_item( const std::string &sItemName ) const;
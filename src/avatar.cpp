@@ -133,9 +133,9 @@ bool avatar::should_show_map_memory()
     return show_map_memory;
 }
 
-bool avatar::save_map_memory()
+bool avatar::save_map_memory( const bool background )
 {
-    return player_map_memory->save( g->m.getabs( pos() ) );
+    return player_map_memory->save( g->m.getabs( pos() ), background );
 }
 
 void avatar::load_map_memory()
@@ -143,6 +143,11 @@ void avatar::load_map_memory()
     player_map_memory->load( g->m.getabs( pos() ) );
 }
 
+std::size_t avatar::map_memory_usage() const
+{
+    return player_map_memory->memory_usage();
+}
+
 void avatar::prepare_map_memory_region( const tripoint &p1, const tripoint &p2 )
 {
     player_map_memory->prepare_region( p1, p2 );
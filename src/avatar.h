@@ -65,8 +65,10 @@ class avatar : public player
         void load( const JsonObject &data );
         void serialize( JsonOut &json ) const override;
         void deserialize( JsonIn &jsin ) override;
-        bool save_map_memory();
+        bool save_map_memory( bool background = false );
         void load_map_memory();
+        /** See @ref map_memory::memory_usage. */
+        std::size_t map_memory_usage() const;
 
         // newcharacter.cpp
         bool create( character_type type, const std::string &tempname = "" );
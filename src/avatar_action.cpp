@@ -1091,6 +1091,7 @@ void avatar_action::wield( item &loc )
                     auto it = u.worn.begin();
                     std::advance( it, worn_index );
                     u.worn.insert( it, to_wield->detach() );
+                    u.flag_encumbrance();
                 } else {
                     u.i_add( to_wield->detach() );
                 }
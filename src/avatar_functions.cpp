@@ -78,7 +78,7 @@ void try_to_sleep( avatar &you, const time_duration &dur )
         }
     } else if( you.has_trait( trait_M_SKIN3 ) ) {
         fungaloid_cosplay = true;
-        if( here.has_flag_ter_or_furn( "FUNGUS", you.pos() ) ) {
+        if( here.has_flag_ter_or_furn( TFLAG_FUNGUS, you.pos() ) ) {
             you.add_msg_if_player( m_good,
                                    _( "Our fibers meld with the ground beneath us.  The gills on our neck begin to seed the air with spores as our awareness fades." ) );
         }
@@ -125,7 +125,7 @@ void try_to_sleep( avatar &you, const time_duration &dur )
             you.add_msg_if_player( m_good,
                                    _( "You lay beneath the waves' embrace, gazing up through the water's surface�" ) );
             watersleep = true;
-        } else if( here.has_flag_ter( "SWIMMABLE", you.pos() ) ) {
+        } else if( here.has_flag_ter( TFLAG_SWIMMABLE, you.pos() ) ) {
             you.add_msg_if_player( m_good, _( "You settle into the water and begin to drowse�" ) );
             watersleep = true;
         }
@@ -0,0 +1,202 @@
+#include "background_saver.h"
+
+#include <exception>
+#include <utility>
+
+#include "debug.h"
+#include "save_journal.h"
+
+background_saver &get_background_saver()
+{
+    static background_saver instance;
+    return instance;
+}
+
+background_saver::background_saver() = default;
+
+background_saver::~background_saver()
+{
+    if( !worker ) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    work_available.notify_all();
+    worker->join();
+}
+
+void background_saver::write( const std::string &path, std::string data )
+{
+    queue( save_journal::entry{ path, std::move( data ) } );
+}
+
+void background_saver::remove( const std::string &path )
+{
+    save_journal::entry e{ path, std::string() };
+    e.remove = true;
+    queue( std::move( e ) );
+}
+
+void background_saver::queue( save_journal::entry e )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        pending_count[e.path]++;
+        if( transaction ) {
+            transaction->entries.push_back( std::move( e ) );
+            return;
+        }
+        std::vector<save_journal::entry> entries;
+        entries.push_back( std::move( e ) );
+        jobs.push_back( job{ std::move( entries ), nullptr, std::string() } );
+        if( !worker ) {
+            worker = std::make_unique<std::thread>( &background_saver::run, this );
+        }
+    }
+    work_available.notify_one();
+}
+
+void background_saver::on_written( std::function<void()> callback )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( transaction ) {
+            transaction_callbacks.push_back( std::move( callback ) );
+            return;
+        }
+        if( jobs.empty() && !working ) {
+            // Nothing in flight, no need to bother the worker.
+            completed_callbacks.push_back( std::move( callback ) );
+            return;
+        }
+        jobs.push_back( job{ {}, std::move( callback ), std::string() } );
+    }
+    work_available.notify_one();
+}
+
+void background_saver::begin_transaction( const std::string &journal_path )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    if( transaction ) {
+        debugmsg( "Nested background save transactions are not supported" );
+        return;
+    }
+    transaction = job{ {}, nullptr, journal_path };
+}
+
+void background_saver::end_transaction()
+{
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( !transaction ) {
+            return;
+        }
+        if( !transaction->entries.empty() ) {
+            jobs.push_back( std::move( *transaction ) );
+            if( !worker ) {
+                worker = std::make_unique<std::thread>( &background_saver::run, this );
+            }
+        }
+        transaction.reset();
+        callbacks.swap( transaction_callbacks );
+    }
+    work_available.notify_one();
+    for( std::function<void()> &cb : callbacks ) {
+        on_written( std::move( cb ) );
+    }
+}
+
+bool background_saver::is_pending( const std::string &path ) const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return pending_count.contains( path );
+}
+
+bool background_saver::busy() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return !jobs.empty() || working;
+}
+
+void background_saver::wait()
+{
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        work_done.wait( lock, [this]() {
+            return jobs.empty() && !working;
+        } );
+    }
+    process_completed();
+}
+
+void background_saver::process_completed()
+{
+    std::vector<std::function<void()>> callbacks;
+    std::vector<std::string> failures;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        callbacks.swap( completed_callbacks );
+        failures.swap( errors );
+    }
+    for( const std::string &err : failures ) {
+        debugmsg( "Failed to save in background: %s", err );
+    }
+    for( std::function<void()> &cb : callbacks ) {
+        cb();
+    }
+}
+
+void background_saver::run()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_available.wait( lock, [this]() {
+            return stopping || !jobs.empty();
+        } );
+        if( jobs.empty() ) {
+            // Only reachable when stopping, the queue is always drained first.
+            return;
+        }
+        job current = std::move( jobs.front() );
+        jobs.pop_front();
+        if( current.callback ) {
+            completed_callbacks.push_back( std::move( current.callback ) );
+        } else {
+            write_job( current, lock );
+        }
+        if( jobs.empty() ) {
+            work_done.notify_all();
+        }
+    }
+}
+
+void background_saver::write_job( const job &current, std::unique_lock<std::mutex> &lock )
+{
+    // Each job owns its data, so later writes to the same paths can't change what
+    // an earlier transaction commits
+    const std::vector<save_journal::entry> &entries = current.entries;
+    working = true;
+    lock.unlock();
+    try {
+        if( current.journal_path.empty() ) {
+            save_journal::apply( entries );
+        } else if( !entries.empty() ) {
+            save_journal::commit( current.journal_path, entries );
+            save_journal::checkpoint( current.journal_path, entries );
+        }
+    } catch( const std::exception &err ) {
+        std::lock_guard<std::mutex> err_lock( mutex );
+        errors.push_back( ( entries.empty() ? current.journal_path : entries.front().path ) + ": " +
+                          err.what() );
+    }
+    lock.lock();
+    working = false;
+    for( const save_journal::entry &e : entries ) {
+        if( --pending_count[e.path] <= 0 ) {
+            pending_count.erase( e.path );
+        }
+    }
+}
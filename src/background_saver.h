@@ -0,0 +1,105 @@
+#pragma once
+#ifndef CATA_SRC_BACKGROUND_SAVER_H
+#define CATA_SRC_BACKGROUND_SAVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "save_journal.h"
+
+/**
+ * Writes already serialized save files on a worker thread.
+ *
+ * Serialization itself still happens on the game thread (the game state is not
+ * thread safe), producing an in-memory snapshot of each file. The slow part - writing,
+ * renaming and syncing to disk - happens in the background, so the next turn doesn't
+ * wait on it.
+ *
+ * Files are written in the order they were queued. Callbacks queued with @ref on_written
+ * run on the game thread (from @ref process_completed) once every file queued before
+ * them has been written.
+ *
+ * Writes and removals between @ref begin_transaction and @ref end_transaction are recorded
+ * in a @ref save_journal first, so either all or none of them take effect after a crash.
+ * Segment archives are appended to in place, outside of any transaction, so they are not
+ * crash consistent with the files saved here, see @ref segment_archive.
+ */
+class background_saver
+{
+    public:
+        background_saver();
+        ~background_saver();
+
+        /** Queue @p data to be written to @p path, after anything queued for it before. */
+        void write( const std::string &path, std::string data );
+        /** Queue removing @p path, if it exists by then. */
+        void remove( const std::string &path );
+        /** Queue a callback to run after everything queued so far is on disk. */
+        void on_written( std::function<void()> callback );
+
+        /** Collect the following writes into one transaction journaled at @p journal_path. */
+        void begin_transaction( const std::string &journal_path );
+        /**
+         * Queue the collected writes, callbacks queued during the transaction run after them.
+         * Nothing is written at all if the transaction is empty.
+         */
+        void end_transaction();
+
+        /** Whether a write to @p path is queued or in progress. */
+        bool is_pending( const std::string &path ) const;
+        /** Whether any write is queued or in progress. */
+        bool busy() const;
+
+        /**
+         * Block until all queued writes are done and run completed callbacks.
+         * Must be called before anything reads back files that may still be pending
+         * and before saving synchronously.
+         */
+        void wait();
+
+        /** Run callbacks of finished batches and report errors. Call once per turn. */
+        void process_completed();
+
+    private:
+        struct job {
+            std::vector<save_journal::entry> entries;
+            std::function<void()> callback;
+            // Set for transactions
+            std::string journal_path;
+        };
+
+        void queue( save_journal::entry e );
+        void run();
+        void write_job( const job &current, std::unique_lock<std::mutex> &lock );
+
+        mutable std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable work_done;
+        std::deque<job> jobs;
+        // Number of queued jobs per path, including the one currently being written.
+        std::unordered_map<std::string, int> pending_count;
+        std::vector<std::function<void()>> completed_callbacks;
+        std::vector<std::string> errors;
+        bool working = false;
+        bool stopping = false;
+        std::unique_ptr<std::thread> worker;
+        // Open transaction, only touched by the game thread
+        std::optional<job> transaction;
+        std::vector<std::function<void()>> transaction_callbacks;
+};
+
+background_saver &get_background_saver();
+
+#endif // CATA_SRC_BACKGROUND_SAVER_H
@@ -243,7 +243,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
     // If we were targetting a tile rather than a monster, don't overshoot
     // Unless the target was a wall, then we are aiming high enough to overshoot
     const bool no_overshoot = proj.has_effect( ammo_effect_NO_OVERSHOOT ) ||
-                              ( g->critter_at( target_arg ) == nullptr && here.passable( target_arg ) );
+                              ( target_critter == nullptr && here.passable( target_arg ) );
 
     double extend_to_range = no_overshoot ? range : proj_arg.range;
 
@@ -364,9 +364,12 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
             }
         }
 
+        // Only a shot from a vehicle cares about the vehicle on the tile, look it up once per step
+        const vehicle *veh_here = nullptr;
         if( in_veh != nullptr ) {
             const optional_vpart_position other = here.veh_at( tp );
-            if( in_veh == veh_pointer_or_null( other ) && other->is_inside() ) {
+            veh_here = veh_pointer_or_null( other );
+            if( in_veh == veh_here && other->is_inside() ) {
                 // Turret is on the roof and can't hit anything inside
                 continue;
             }
@@ -414,6 +417,10 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
             }
             if( in_veh == nullptr || veh_pointer_or_null( here.veh_at( rand ) ) != in_veh ) {
                 here.shoot( source, rand, proj, false );
+                if( in_veh != nullptr ) {
+                    // The wall we hit may have been part of the vehicle here
+                    veh_here = veh_pointer_or_null( here.veh_at( tp ) );
+                }
                 if( proj.impact.total_damage() <= 0 ) {
                     //If the projectile stops here move it back a square so it doesn't end up inside the vehicle
                     traj_len = i - 1;
@@ -425,8 +432,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
 
 
         if( critter != nullptr && cur_missed_by < 1.0 ) {
-            if( in_veh != nullptr && veh_pointer_or_null( here.veh_at( tp ) ) == in_veh &&
-                critter->is_player() ) {
+            if( in_veh != nullptr && veh_here == in_veh && critter->is_player() ) {
                 // Turret either was aimed by the player (who is now ducking) and shoots from above
                 // Or was just IFFing, giving lots of warnings and time to get out of the line of fire
                 continue;
@@ -446,7 +452,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
             } else {
                 attack.missed_by = aim.missed_by;
             }
-        } else if( in_veh != nullptr && veh_pointer_or_null( here.veh_at( tp ) ) == in_veh ) {
+        } else if( in_veh != nullptr && veh_here == in_veh ) {
             // Don't do anything, especially don't call map::shoot as this would damage the vehicle
         } else {
             here.shoot( source, tp, proj, !no_item_damage && tp == target );
@@ -47,7 +47,7 @@ behavior_return node_t::tick( const oracle_t *subject ) const
     }
 }
 
-std::string node_t::goal() const
+const std::string &node_t::goal() const
 {
     return _goal;
 }
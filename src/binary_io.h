@@ -0,0 +1,114 @@
+#pragma once
+#ifndef CATA_SRC_BINARY_IO_H
+#define CATA_SRC_BINARY_IO_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * Minimal little-endian binary streams used by the binary save formats.
+ *
+ * Values are always written in little-endian byte order, independent of the host,
+ * so save files can be moved between machines. Readers throw @ref binary_error on
+ * short reads or malformed data; callers that load save data already catch
+ * std::exception and report it like a JSON error.
+ */
+class binary_error : public std::runtime_error
+{
+    public:
+        explicit binary_error( const std::string &msg ) : std::runtime_error( msg ) {}
+};
+
+class binary_out
+{
+    public:
+        explicit binary_out( std::ostream &stream ) : stream( &stream ) {}
+
+        template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        void write( T value ) {
+            using U = std::make_unsigned_t<T>;
+            U v = static_cast<U>( value );
+            char buf[sizeof( T )];
+            for( size_t i = 0; i < sizeof( T ); ++i ) {
+                buf[i] = static_cast<char>( v & 0xff );
+                v = static_cast<U>( v >> 8 );
+            }
+            stream->write( buf, sizeof( T ) );
+        }
+
+        void write( bool value ) {
+            write<std::uint8_t>( value ? 1 : 0 );
+        }
+
+        /** Strings are stored as a 32-bit length followed by the raw bytes. */
+        void write( const std::string &value ) {
+            write<std::uint32_t>( value.size() );
+            write_raw( value.data(), value.size() );
+        }
+
+        void write( const char *value ) {
+            write( std::string( value ) );
+        }
+
+        void write_raw( const char *data, size_t size ) {
+            stream->write( data, size );
+        }
+
+    private:
+        std::ostream *stream;
+};
+
+class binary_in
+{
+    public:
+        explicit binary_in( std::istream &stream ) : stream( &stream ) {}
+
+        template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        T read() {
+            using U = std::make_unsigned_t<T>;
+            unsigned char buf[sizeof( T )];
+            read_raw( reinterpret_cast<char *>( buf ), sizeof( T ) );
+            U v = 0;
+            for( size_t i = sizeof( T ); i-- > 0; ) {
+                v = static_cast<U>( ( v << 8 ) | buf[i] );
+            }
+            return static_cast<T>( v );
+        }
+
+        bool read_bool() {
+            return read<std::uint8_t>() != 0;
+        }
+
+        std::string read_string() {
+            const std::uint32_t size = read<std::uint32_t>();
+            std::string result( size, '\0' );
+            read_raw( result.data(), size );
+            return result;
+        }
+
+        void read_raw( char *data, size_t size ) {
+            if( !stream->read( data, size ) ) {
+                throw binary_error( "unexpected end of binary data" );
+            }
+        }
+
+        void skip( size_t size ) {
+            if( !stream->ignore( size ) || static_cast<size_t>( stream->gcount() ) != size ) {
+                throw binary_error( "unexpected end of binary data" );
+            }
+        }
+
+        /** Returns true if there is no more data to read. Does not consume anything. */
+        bool eof() {
+            return stream->peek() == std::istream::traits_type::eof();
+        }
+
+    private:
+        std::istream *stream;
+};
+
+#endif // CATA_SRC_BINARY_IO_H
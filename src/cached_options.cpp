@@ -19,6 +19,7 @@ int fov_3d_z_range;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
+int worker_threads = -1;
 
 FungalOptions fungal_opt;
 
@@ -79,6 +79,12 @@ extern bool pixel_minimap_option;
 */
 extern int PICKUP_RANGE;
 
+/**
+ * Worker threads the thread pool runs besides the main thread, -1 to pick a number from
+ * the hardware, see get_thread_pool.
+ */
+extern int worker_threads;
+
 /**
  * If true, disables all debug messages. Only used for debugging "weird" saves.
  */
@@ -2,8 +2,9 @@
 #ifndef CATA_SRC_CATA_ARENA_H
 #define CATA_SRC_CATA_ARENA_H
 
+#include <algorithm>
 #include <unordered_map>
-#include <set>
+#include <vector>
 
 #include "safe_reference.h"
 
@@ -11,7 +12,8 @@ template <typename T>
 class cata_arena
 {
     private:
-        std::set<T *> pending_deletion;
+        // May hold the same object more than once, duplicates are dropped at cleanup
+        std::vector<T *> pending_deletion;
 
         static cata_arena<T> &get_instance() {
             static cata_arena<T> instance;
@@ -19,7 +21,7 @@ class cata_arena
         }
 
         void mark_for_destruction_internal( T *alloc ) {
-            pending_deletion.insert( alloc );
+            pending_deletion.push_back( alloc );
             safe_reference<T>::mark_destroyed( alloc );
             cache_reference<T>::mark_destroyed( alloc );
         }
@@ -28,8 +30,11 @@ class cata_arena
             if( pending_deletion.empty() ) {
                 return false;
             }
-            std::set<T *> dcopy = std::set<T *>( pending_deletion );
-            pending_deletion.clear();
+            // Deleting these can mark more for destruction, those wait for the next round
+            std::vector<T *> dcopy;
+            dcopy.swap( pending_deletion );
+            std::sort( dcopy.begin(), dcopy.end() );
+            dcopy.erase( std::unique( dcopy.begin(), dcopy.end() ), dcopy.end() );
             for( T * const &p : dcopy ) {
                 safe_reference<T>::mark_deallocated( p );
                 delete p;
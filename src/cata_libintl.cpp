@@ -730,18 +730,31 @@ const char *trans_catalogue::get_nth_pl_translation( u32 n, size_t num ) const
 // Translation library
 // ===============================================================================================
 
+// FNV-1a
+static u32 hash_string( const char *str )
+{
+    u32 hash = 2166136261u;
+    for( ; *str; ++str ) {
+        hash = ( hash ^ static_cast<u8>( *str ) ) * 16777619u;
+    }
+    return hash;
+}
+
+const char *trans_library::get_orig_string( const library_string_descr &descr ) const
+{
+    return catalogues[descr.catalogue].get_nth_orig_string( descr.entry );
+}
+
 std::vector<trans_library::library_string_descr>::const_iterator trans_library::find_entry(
     const char *id ) const
 {
-    auto it = std::lower_bound( strings.begin(), strings.end(),
-    id, [this]( const library_string_descr & a_descr, const char *b ) -> bool {
-        const char *a = this->catalogues[a_descr.catalogue].get_nth_orig_string( a_descr.entry );
-        return strcmp( a, b ) < 0;
-    } );
-
-    if( it != strings.end() ) {
-        const char *found = catalogues[it->catalogue].get_nth_orig_string( it->entry );
-        if( strcmp( id, found ) == 0 ) {
+    if( string_hash_table.empty() ) {
+        return strings.end();
+    }
+    const u32 mask = static_cast<u32>( string_hash_table.size() ) - 1;
+    for( u32 slot = hash_string( id ) & mask; string_hash_table[slot] != 0; slot = ( slot + 1 ) & mask ) {
+        const auto it = strings.begin() + ( string_hash_table[slot] - 1 );
+        if( strcmp( id, get_orig_string( *it ) ) == 0 ) {
             return it;
         }
     }
@@ -753,38 +766,61 @@ void trans_library::build_string_table()
 {
     assert( strings.empty() );
 
-    for( size_t i_cat = 0; i_cat < catalogues.size(); i_cat++ ) {
-        const trans_catalogue &cat = catalogues[i_cat];
-        u32 num = cat.get_num_strings();
+    size_t total = 0;
+    for( const trans_catalogue &cat : catalogues ) {
         // 0th entry is the metadata, we skip it
-        strings.reserve( num - 1 );
+        total += std::max<u32>( cat.get_num_strings(), 1 ) - 1;
+    }
+    std::vector<library_string_descr> all;
+    all.reserve( total );
+    for( size_t i_cat = 0; i_cat < catalogues.size(); i_cat++ ) {
+        u32 num = catalogues[i_cat].get_num_strings();
         for( u32 i = 1; i < num; i++ ) {
-            const char *i_cstr = cat.get_nth_orig_string( i );
-
-            auto it = std::lower_bound( strings.begin(), strings.end(),
-            i_cstr, [this]( const library_string_descr & a_descr, const char *b ) -> bool {
-                const char *a = this->catalogues[a_descr.catalogue].get_nth_orig_string( a_descr.entry );
-                return strcmp( a, b ) < 0;
-            } );
-
-            library_string_descr desc = { static_cast<u32>( i_cat ), i };
-            if( it == strings.end() ) {
-                // Not found, or all elements are greater
-                strings.push_back( desc );
-            } else if( strcmp( catalogues[it->catalogue].get_nth_orig_string( it->entry ), i_cstr ) == 0 ) {
-                // Overwrite existing string only if new string has plural form(s),
-                // but existing one does not.
-                if(
-                    cat.check_nth_translation_has_plf( i ) &&
-                    !catalogues[it->catalogue].check_nth_translation_has_plf( it->entry )
-                ) {
-                    *it = desc;
-                }
-                continue;
-            } else {
-                strings.insert( it, desc );
-            }
+            all.push_back( { static_cast<u32>( i_cat ), i } );
+        }
+    }
+    // Entries with the same id stay in catalogue order
+    std::stable_sort( all.begin(), all.end(),
+    [this]( const library_string_descr & a, const library_string_descr & b ) {
+        return strcmp( get_orig_string( a ), get_orig_string( b ) ) < 0;
+    } );
+
+    strings.reserve( all.size() );
+    for( const library_string_descr &desc : all ) {
+        if( strings.empty() ||
+            strcmp( get_orig_string( strings.back() ), get_orig_string( desc ) ) != 0 ) {
+            strings.push_back( desc );
+            continue;
+        }
+        // Overwrite existing string only if new string has plural form(s),
+        // but existing one does not.
+        library_string_descr &existing = strings.back();
+        if(
+            catalogues[desc.catalogue].check_nth_translation_has_plf( desc.entry ) &&
+            !catalogues[existing.catalogue].check_nth_translation_has_plf( existing.entry )
+        ) {
+            existing = desc;
+        }
+    }
+
+    build_string_hash_table();
+}
+
+void trans_library::build_string_hash_table()
+{
+    // At most half full, so probe sequences stay short
+    size_t size = 1;
+    while( size < strings.size() * 2 ) {
+        size *= 2;
+    }
+    string_hash_table.assign( size, 0 );
+    const u32 mask = static_cast<u32>( size ) - 1;
+    for( size_t i = 0; i < strings.size(); i++ ) {
+        u32 slot = hash_string( get_orig_string( strings[i] ) ) & mask;
+        while( string_hash_table[slot] != 0 ) {
+            slot = ( slot + 1 ) & mask;
         }
+        string_hash_table[slot] = static_cast<u32>( i + 1 );
     }
 }
 
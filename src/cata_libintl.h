@@ -187,11 +187,16 @@ class trans_library
 
         // Full index of loaded strings
         std::vector<library_string_descr> strings;
+        // Open addressing hash table over the ids of strings, 1 + index into strings
+        // or 0 for an empty slot. Its size is a power of 2.
+        std::vector<u32> string_hash_table;
 
         // Full index of loaded catalogues
         std::vector<trans_catalogue> catalogues;
 
         void build_string_table();
+        void build_string_hash_table();
+        const char *get_orig_string( const library_string_descr &descr ) const;
         std::vector<library_string_descr>::const_iterator find_entry( const char *id ) const;
         const char *lookup_string( const char *id ) const;
         const char *lookup_pl_string( const char *id, size_t n ) const;
@@ -8,11 +8,14 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <map>
 #include <optional>
 #include <set>
 #include <stdexcept>
+#include <system_error>
 #include <tuple>
 #include <unordered_set>
 
@@ -66,6 +69,7 @@
 #include "sdl_wrappers.h"
 #include "sdltiles.h"
 #include "sounds.h"
+#include "startup_timings.h"
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_utils.h"
@@ -298,6 +302,33 @@ tileset::find_tile_type_by_season( const std::string &id, season_type season ) c
     return std::nullopt;
 }
 
+std::size_t tileset::texture_memory_usage() const
+{
+    // Tiles are parts of a few large textures, count each of those once
+    std::set<SDL_Texture *> textures;
+    for( const std::vector<texture> *values : {
+             &tile_values, &shadow_tile_values, &night_tile_values, &overexposed_tile_values,
+             &memory_tile_values, &z_overlay_values
+         } ) {
+        for( const texture &tex : *values ) {
+            textures.insert( tex.sdl_texture() );
+        }
+    }
+    std::size_t bytes = 0;
+    for( SDL_Texture *tex : textures ) {
+        Uint32 format = 0;
+        int width = 0;
+        int height = 0;
+        if( tex != nullptr && SDL_QueryTexture( tex, &format, nullptr, &width, &height ) == 0 ) {
+            // Formats without a fixed pixel size are taken as 32 bit
+            const int pixel_bytes = SDL_BYTESPERPIXEL( format ) > 0 ?
+                                    SDL_BYTESPERPIXEL( format ) : 4;
+            bytes += static_cast<std::size_t>( width ) * height * pixel_bytes;
+        }
+    }
+    return bytes;
+}
+
 tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_tile_type )
 {
     // Must overwrite existing tile
@@ -343,6 +374,13 @@ void cata_tiles::load_tileset(
     const bool pump_events
 )
 {
+    // The tiles are looked up again for the new tileset, and for the game data it
+    // is loaded with
+    for( auto &season_cache : looks_like_cache ) {
+        for( auto &category_cache : season_cache ) {
+            category_cache.clear();
+        }
+    }
     if( !force && tileset_ptr &&
         !get_option<bool>( "FORCE_TILESET_RELOAD" ) &&
         tileset_ptr->get_tileset_id() == tileset_id &&
@@ -350,6 +388,7 @@ void cata_tiles::load_tileset(
       ) {
         return;
     }
+    startup_timings::timer timing( precheck ? "tileset precheck" : "tileset", tileset_id );
     // TODO: move into clear or somewhere else.
     // reset the overlay ordering from the previous loaded tileset
     tileset_mutation_overlay_ordering.clear();
@@ -519,9 +558,61 @@ static void extend_vector_by( std::vector<T> &vec, const size_t additional_size
     vec.resize( vec.size() + additional_size );
 }
 
+namespace
+{
+
+/** A decoded sprite sheet, and the size and modification time of its file when it was decoded. */
+struct decoded_sheet {
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size = 0;
+    SDL_Surface_Ptr surface;
+};
+
+// The sheets decoded by the last tileset load, and the ones used so far by the current one.
+// Loading the same tileset again, e.g. for a world with other mods, reuses them as long as
+// their files haven't changed.
+std::map<std::string, decoded_sheet> decoded_sheets;
+std::map<std::string, decoded_sheet> used_sheets;
+
+} // namespace
+
+/** Get a copy of the decoded image at img_path, decoding it only if it isn't cached yet. */
+static SDL_Surface_Ptr load_sprite_sheet( const std::string &img_path )
+{
+    const std::filesystem::path path( img_path );
+    std::error_code ec;
+    decoded_sheet sheet;
+    sheet.mtime = std::filesystem::last_write_time( path, ec );
+    if( !ec ) {
+        sheet.size = std::filesystem::file_size( path, ec );
+    }
+    if( ec ) {
+        return load_image( img_path.c_str() );
+    }
+
+    const auto is_current = [&]( const std::map<std::string, decoded_sheet> &sheets ) {
+        const auto iter = sheets.find( img_path );
+        return iter != sheets.end() && iter->second.mtime == sheet.mtime &&
+               iter->second.size == sheet.size;
+    };
+    if( is_current( used_sheets ) ) {
+        sheet.surface = std::move( used_sheets[img_path].surface );
+    } else if( is_current( decoded_sheets ) ) {
+        sheet.surface = std::move( decoded_sheets[img_path].surface );
+        decoded_sheets.erase( img_path );
+    } else {
+        sheet.surface = load_image( img_path.c_str() );
+    }
+    // The caller sets a color key on its copy, the cached one stays as decoded
+    SDL_Surface_Ptr copy( SDL_ConvertSurface( sheet.surface.get(), sheet.surface->format, 0 ) );
+    throwErrorIf( !copy, "SDL_ConvertSurface failed" );
+    used_sheets[img_path] = std::move( sheet );
+    return copy;
+}
+
 void tileset_loader::load_tileset( const std::string &img_path, const bool pump_events )
 {
-    const SDL_Surface_Ptr tile_atlas = load_image( img_path.c_str() );
+    const SDL_Surface_Ptr tile_atlas = load_sprite_sheet( img_path );
     assert( tile_atlas );
     tile_atlas_width = tile_atlas->w;
 
@@ -634,6 +725,11 @@ void tileset_loader::load_tileset( const std::string &img_path, const bool pump_
     size = expected_tilecount;
 }
 
+std::size_t cata_tiles::texture_memory_usage() const
+{
+    return tileset_ptr ? tileset_ptr->texture_memory_usage() : 0;
+}
+
 void cata_tiles::set_draw_scale( int scale )
 {
     assert( tileset_ptr );
@@ -649,7 +745,7 @@ std::optional<tile_search_result> cata_tiles::tile_type_search(
     const std::string &subcategory, int subtile, int rota
 )
 {
-    std::optional<tile_lookup_res> res = find_tile_looks_like( id, category );
+    std::optional<tile_lookup_res> res = find_tile_looks_like_cached( id, category );
     const tile_type *tt = nullptr;
     if( res ) {
         tt = &( res->tile() );
@@ -888,6 +984,7 @@ void tileset_loader::load( const std::string &tileset_id, const bool precheck,
 
     // Load tile information if available.
     offset = 0;
+    used_sheets.clear();
     load_internal( config, tileset_root, img_path, pump_events );
 
     // Load mod tilesets if available
@@ -962,6 +1059,10 @@ void tileset_loader::load( const std::string &tileset_id, const bool precheck,
     }
     ensure_default_item_highlight();
 
+    // Keep only what this tileset uses for the next load
+    decoded_sheets = std::move( used_sheets );
+    used_sheets.clear();
+
     ts.tileset_id = tileset_id;
 }
 
@@ -1433,6 +1534,28 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
         }
     }
 
+    const auto compare_z = []( const tile_render_info &a, const tile_render_info &b ) -> bool {
+        return ( a.pos.z < b.pos.z );
+    };
+
+    const std::array<decltype( &cata_tiles::draw_furniture ), 3> base_drawing_layers = {{
+            &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap
+        }
+    };
+    struct zlevel_layer {
+        bool hide_unseen;
+        decltype( &cata_tiles::draw_furniture ) function;
+    };
+    const std::array < zlevel_layer, 3 > zlevel_drawing_layers = {{
+            {true, &cata_tiles::draw_field_or_item}, {false, &cata_tiles::draw_vpart}, {true, &cata_tiles::draw_critter_at}
+        }
+    };
+
+    const std::array<decltype( &cata_tiles::draw_furniture ), 2> final_drawing_layers = {{
+            &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
+        }
+    };
+
     std::vector<tile_render_info> &draw_points = *draw_points_cache;
     int min_z = OVERMAP_HEIGHT;
 
@@ -1659,28 +1782,6 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
             }
         }
 
-        auto compare_z = [&]( tile_render_info a, tile_render_info b ) -> bool {
-            return ( a.pos.z < b.pos.z );
-        };
-
-        const std::array<decltype( &cata_tiles::draw_furniture ), 3> base_drawing_layers = {{
-                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap
-            }
-        };
-        struct zlevel_layer {
-            bool hide_unseen;
-            decltype( &cata_tiles::draw_furniture ) function;
-        };
-        const std::array < zlevel_layer, 3 > zlevel_drawing_layers = {{
-                {true, &cata_tiles::draw_field_or_item}, {false, &cata_tiles::draw_vpart}, {true, &cata_tiles::draw_critter_at}
-            }
-        };
-
-        const std::array<decltype( &cata_tiles::draw_furniture ), 2> final_drawing_layers = {{
-                &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
-            }
-        };
-
         std::stable_sort( draw_points.begin(), draw_points.end(), compare_z );
         for( tile_render_info &p : draw_points ) {
             draw_terrain( p.pos, p.ll, p.height_3d, p.invisible, center.z - p.pos.z );
@@ -2105,6 +2206,19 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     }
 }
 
+std::optional<tile_lookup_res>
+cata_tiles::find_tile_looks_like_cached( const std::string &id, TILE_CATEGORY category )
+{
+    const season_type season = season_of_year( calendar::turn );
+    std::unordered_map<std::string, std::optional<tile_lookup_res>> &cache =
+        looks_like_cache[season][category];
+    const auto iter = cache.find( id );
+    if( iter != cache.end() ) {
+        return iter->second;
+    }
+    return cache.emplace( id, find_tile_looks_like( id, category ) ).first->second;
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         std::string &draw_id )
 {
@@ -2436,10 +2550,16 @@ bool cata_tiles::draw_sprite_at(
     destination.h = height * tile_height / tileset_ptr->get_tile_height();
 
     auto render = [&]( const int rotation, const SDL_RendererFlip flip ) {
-        int ret = sprite_tex->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
+        // Most sprites are drawn as they are, which the renderers can queue and batch
+        // without working out a rotated quad
+        const auto copy = [&]( const texture & tex ) {
+            return rotation == 0 && flip == SDL_FLIP_NONE ? tex.render_copy( renderer, &destination ) :
+                   tex.render_copy_ex( renderer, &destination, rotation, nullptr, flip );
+        };
+        int ret = copy( *sprite_tex );
         if( !static_z_effect && overlay && overlay_count > 0 ) {
             overlay->set_alpha_mod( std::min( 192, ( 1 + overlay_count ) * 24 ) );
-            overlay->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
+            copy( *overlay );
         }
         return ret;
     };
@@ -2487,7 +2607,7 @@ bool cata_tiles::draw_sprite_at(
         ret = render( 0, SDL_FLIP_NONE );
     }
 
-    printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
+    printErrorIf( ret != 0, "SDL_RenderCopy() failed" );
     // this reference passes all the way back up the call chain back to
     // cata_tiles::draw() std::vector<tile_render_info> draw_points[].height_3d
     // where we are accumulating the height of every sprite stacked up in a tile
@@ -2663,7 +2783,7 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
 bool cata_tiles::has_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         return !t.tile.empty();
     }
     return false;
@@ -2672,7 +2792,7 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
 bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "t_" ) ) {
             return true;
         }
@@ -2683,7 +2803,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "f_" ) ) {
             return true;
         }
@@ -2694,7 +2814,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "tr_" ) ) {
             return true;
         }
@@ -2705,7 +2825,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "vp_" ) ) {
             return true;
         }
@@ -2716,7 +2836,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "t_" ) ) {
             return t;
         }
@@ -2727,7 +2847,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
 memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "f_" ) ) {
             return t;
         }
@@ -2738,7 +2858,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
 memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "tr_" ) ) {
             return t;
         }
@@ -2749,7 +2869,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
-        const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = g->u.get_memorized_tile( get_map().getabs( p ) );
         if( t.tile.starts_with( "vp_" ) ) {
             return t;
         }
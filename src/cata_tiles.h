@@ -92,6 +92,14 @@ class texture
         std::pair<int, int> dimension() const {
             return std::make_pair( srcrect.w, srcrect.h );
         }
+        /// The whole texture this one is a part of.
+        SDL_Texture *sdl_texture() const {
+            return sdl_texture_ptr.get();
+        }
+        /// Interface to @ref SDL_RenderCopy, using this as the texture.
+        int render_copy( const SDL_Renderer_Ptr &renderer, const SDL_Rect *const dstrect ) const {
+            return SDL_RenderCopy( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect );
+        }
         /// Interface to @ref SDL_RenderCopyEx, using this as the texture, and
         /// null as source rectangle (render the whole texture). Other parameters
         /// are simply passed through.
@@ -177,6 +185,9 @@ class tileset
 
         tile_type &create_tile_type( const std::string &id, tile_type &&new_tile_type );
         const tile_type *find_tile_type( const std::string &id ) const;
+
+        /** Approximate bytes taken by the textures of all the tiles and their variants. */
+        std::size_t texture_memory_usage() const;
         /**
          * Looks up tile by id + season suffix AND just raw id
          * Example: if id == "t_tree_apple" and season == SPRING
@@ -361,6 +372,9 @@ class cata_tiles
          *  float inaccuracies. */
         void set_draw_scale( int scale );
 
+        /** See @ref tileset::texture_memory_usage, 0 if no tileset is loaded. */
+        std::size_t texture_memory_usage() const;
+
         /** Tries to find tile with specified parameters and return it if exists **/
         std::optional<tile_search_result> tile_type_search(
             const std::string &id, TILE_CATEGORY category, const std::string &subcategory,
@@ -393,6 +407,9 @@ class cata_tiles
         std::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                               int looks_like_jumps_limit = 10 ) const;
+        /** @ref find_tile_looks_like, remembering the result until the next tileset or data load. */
+        std::optional<tile_lookup_res> find_tile_looks_like_cached( const std::string &id,
+                TILE_CATEGORY category );
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
@@ -696,6 +713,9 @@ class cata_tiles
         std::unique_ptr<tileset> tileset_ptr;
         /** List of mods with which @ref tileset_ptr was loaded. */
         std::vector<mod_id> tileset_mod_list_stamp;
+        /** Results of @ref find_tile_looks_like_cached by season and category. */
+        std::unordered_map<std::string, std::optional<tile_lookup_res>>
+        looks_like_cache[season_type::NUM_SEASONS][C_OVERMAP_NOTE + 1];
 
         int tile_height = 0;
         int tile_width = 0;
@@ -78,6 +78,11 @@ std::unique_ptr<lua_state, lua_state_deleter> make_wrapped_state()
            );
 }
 
+std::size_t lua_memory_usage( lua_state & )
+{
+    return 0;
+}
+
 void init_global_state_tables( lua_state &, const std::vector<mod_id> & ) {}
 void set_mod_being_loaded( lua_state &, const mod_id & ) {}
 void clear_mod_being_loaded( lua_state & ) {}
@@ -97,7 +102,12 @@ void run_on_every_x_hooks( lua_state & ) {}
 
 #include "catalua_sol.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
 #include "avatar.h"
+#include "binary_io.h"
 #include "catalua_console.h"
 #include "catalua_impl.h"
 #include "catalua_iuse_actor.h"
@@ -107,10 +117,13 @@ void run_on_every_x_hooks( lua_state & ) {}
 #include "fstream_utils.h"
 #include "init.h"
 #include "item_factory.h"
+#include "lua_stats.h"
 #include "map.h"
 #include "mod_manager.h"
 #include "path_info.h"
 #include "point.h"
+#include "profile.h"
+#include "string_formatter.h"
 #include "worldfactory.h"
 
 namespace cata
@@ -194,14 +207,53 @@ static sol::table get_mod_storage_table( lua_state &state )
     return state.lua.globals()["game"]["cata_internal"]["mod_storage"];
 }
 
-bool save_world_lua_state( const std::string &path )
+// Mod storage with at least this many keys and values is saved in the binary format
+static constexpr size_t binary_lua_state_min_values = 10000;
+// Binary Lua state files start with this magic followed by the binary format version.
+static constexpr char binary_lua_state_magic[4] = { 'C', 'B', 'L', 'S' };
+static constexpr std::uint32_t binary_lua_state_version = 1;
+
+static std::string json_lua_state_path( const std::string &world_path )
+{
+    return world_path + "/lua_state.json";
+}
+
+static std::string binary_lua_state_path( const std::string &world_path )
+{
+    return world_path + "/lua_state.bin";
+}
+
+bool save_world_lua_state( const std::string &world_path )
 {
     lua_state &state = *DynamicDataLoader::get_instance().lua;
 
     const mod_management::t_mod_list &mods = world_generator->active_world->active_mod_order;
     sol::table t = get_mod_storage_table( state );
     run_on_game_save_hooks( state );
+
+    // The binary format writes all mods as one table, so they share the written strings
+    sol::table all_mods = state.lua.create_table();
+    for( const mod_id &mod : mods ) {
+        if( !mod.is_valid() ) {
+            // The mod is missing from installation
+            continue;
+        }
+        all_mods[mod.str()] = t[mod.str()];
+    }
+    const bool binary = count_lua_table_values( all_mods ) >= binary_lua_state_min_values;
+    const std::string path = binary ? binary_lua_state_path( world_path ) :
+                             json_lua_state_path( world_path );
+    const std::string other_path = binary ? json_lua_state_path( world_path ) :
+                                   binary_lua_state_path( world_path );
+
     bool ret = write_to_file( path, [&]( std::ostream & stream ) {
+        if( binary ) {
+            binary_out out( stream );
+            out.write_raw( binary_lua_state_magic, sizeof( binary_lua_state_magic ) );
+            out.write( binary_lua_state_version );
+            serialize_lua_table_binary( all_mods, out );
+            return;
+        }
         JsonOut jsout( stream );
         jsout.start_object();
         for( const mod_id &mod : mods ) {
@@ -214,32 +266,75 @@ bool save_world_lua_state( const std::string &path )
         }
         jsout.end_object();
     }, "world_lua_state" );
+    // Don't leave the state in the other format behind to be loaded instead
+    if( ret && file_exist( other_path ) ) {
+        remove_file( other_path );
+    }
     return ret;
 }
 
-bool load_world_lua_state( const std::string &path )
+bool load_world_lua_state( const std::string &world_path )
 {
     lua_state &state = *DynamicDataLoader::get_instance().lua;
     const mod_management::t_mod_list &mods = world_generator->active_world->active_mod_order;
     sol::table t = get_mod_storage_table( state );
 
-    bool ret = read_from_file_optional( path, [&]( std::istream & stream ) {
-        JsonIn jsin( stream );
-        JsonObject jsobj = jsin.get_object();
-
-        for( const mod_id &mod : mods ) {
-            if( !jsobj.has_object( mod.str() ) ) {
-                // Mod could have been added to existing save
-                continue;
+    bool ret = false;
+    if( file_exist( binary_lua_state_path( world_path ) ) ) {
+        ret = read_from_file( binary_lua_state_path( world_path ), [&]( std::istream & stream ) {
+            binary_in in( stream );
+            char magic[sizeof( binary_lua_state_magic )];
+            in.read_raw( magic, sizeof( magic ) );
+            if( !std::equal( std::begin( magic ), std::end( magic ),
+                             std::begin( binary_lua_state_magic ) ) ) {
+                throw binary_error( "not a binary Lua state file" );
             }
-            if( !mod.is_valid() ) {
-                // Trying to load without the mod
-                continue;
+            const std::uint32_t format_version = in.read<std::uint32_t>();
+            if( format_version > binary_lua_state_version ) {
+                throw binary_error( string_format(
+                                        "binary Lua state format %d is newer than supported %d",
+                                        format_version, binary_lua_state_version ) );
             }
-            JsonObject mod_obj = jsobj.get_object( mod.str() );
-            deserialize_lua_table( t[mod.str()], mod_obj );
-        }
-    } );
+            sol::table all_mods = state.lua.create_table();
+            deserialize_lua_table_binary( all_mods, in );
+
+            for( const mod_id &mod : mods ) {
+                sol::object stored = all_mods[mod.str()];
+                if( stored.get_type() != sol::type::table ) {
+                    // Mod could have been added to existing save
+                    continue;
+                }
+                if( !mod.is_valid() ) {
+                    // Trying to load without the mod
+                    continue;
+                }
+                sol::table mod_table = t[mod.str()];
+                stored.as<sol::table>().for_each( [&]( const sol::object & key,
+                const sol::object & val ) {
+                    mod_table.set( key, val );
+                } );
+            }
+        } );
+    } else {
+        const std::string path = json_lua_state_path( world_path );
+        ret = read_from_file_optional( path, [&]( std::istream & stream ) {
+            JsonIn jsin( stream );
+            JsonObject jsobj = jsin.get_object();
+
+            for( const mod_id &mod : mods ) {
+                if( !jsobj.has_object( mod.str() ) ) {
+                    // Mod could have been added to existing save
+                    continue;
+                }
+                if( !mod.is_valid() ) {
+                    // Trying to load without the mod
+                    continue;
+                }
+                JsonObject mod_obj = jsobj.get_object( mod.str() );
+                deserialize_lua_table( t[mod.str()], mod_obj );
+            }
+        } );
+    }
 
     run_on_game_load_hooks( state );
     return ret;
@@ -262,6 +357,11 @@ std::unique_ptr<lua_state, lua_state_deleter> make_wrapped_state()
     return ret;
 }
 
+std::size_t lua_memory_usage( lua_state &state )
+{
+    return state.lua.memory_used();
+}
+
 void init_global_state_tables( lua_state &state, const std::vector<mod_id> &modlist )
 {
     sol::state &lua = state.lua;
@@ -299,9 +399,14 @@ void init_global_state_tables( lua_state &state, const std::vector<mod_id> &modl
     gt["iuse_functions"] = lua.create_table();
 
     // hooks
-    hooks["on_game_load"] = lua.create_table();
-    hooks["on_game_save"] = lua.create_table();
-    hooks["on_mapgen_postprocess"] = lua.create_table();
+    state.hooks.clear();
+    for( const char *name : {
+             "on_game_load", "on_game_save", "on_mapgen_postprocess"
+         } ) {
+        sol::table list = lua.create_table();
+        hooks[name] = list;
+        state.hooks.emplace( name, std::move( list ) );
+    }
 }
 
 void set_mod_being_loaded( lua_state &state, const mod_id &mod )
@@ -352,17 +457,31 @@ void run_mod_main_script( lua_state &state, const mod_id &mod )
 template<typename... Args>
 void run_hooks( lua_state &state, std::string_view hooks_table, Args &&...args )
 {
-    sol::state &lua = state.lua;
-    sol::table hooks = lua.globals()["game"]["hooks"][hooks_table];
+    const auto found = state.hooks.find( hooks_table );
+    if( found == state.hooks.end() ) {
+        debugmsg( "Tried to run unknown hooks %s", hooks_table );
+        return;
+    }
+    const sol::table &hooks = found->second;
+    if( hooks.empty() ) {
+        return;
+    }
     for( auto &ref : hooks ) {
         int idx = -1;
+        std::string source;
         try {
             idx = ref.first.as<int>();
             sol::protected_function func = ref.second;
+            source = get_function_source( func );
+            const std::string id = string_format( "%s %s", hooks_table, source );
+            ZoneScopedN( "lua_hook" );
+            ZoneText( id.c_str(), id.size() );
+            const lua_stats::timer timer( lua_call_kind::hook, id );
+            const lua_time_budget budget( state.lua );
             sol::protected_function_result res = func( std::forward<Args>( args )... );
             check_func_result( res );
         } catch( std::runtime_error &e ) {
-            debugmsg( "Failed to run hook %s[%d]: %s", hooks_table, idx, e.what() );
+            debugmsg( "Failed to run hook %s[%d] from %s: %s", hooks_table, idx, source, e.what() );
             break;
         }
     }
@@ -394,13 +513,19 @@ void run_on_every_x_hooks( lua_state &state )
     for( const auto &entry : master_table ) {
         if( calendar::once_every( entry.interval ) ) {
             for( auto &func : entry.functions ) {
+                const std::string source = get_function_source( func );
                 try {
+                    const std::string id = string_format( "%s %s", to_string( entry.interval ), source );
+                    ZoneScopedN( "lua_every_x_hook" );
+                    ZoneText( id.c_str(), id.size() );
+                    const lua_stats::timer timer( lua_call_kind::every_x, id );
+                    const lua_time_budget budget( state.lua );
                     sol::protected_function_result res = func();
                     check_func_result( res );
                 } catch( std::runtime_error &e ) {
                     debugmsg(
-                        "Failed to run hook on_every_x(interval = %s): %s",
-                        to_string( entry.interval ), e.what()
+                        "Failed to run hook on_every_x(interval = %s) from %s: %s",
+                        to_string( entry.interval ), source, e.what()
                     );
                 }
             }
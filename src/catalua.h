@@ -4,6 +4,7 @@
 
 #include "type_id.h"
 
+#include <cstddef>
 #include <memory>
 
 class Item_factory;
@@ -27,10 +28,13 @@ void show_lua_console();
 void reload_lua_code();
 void debug_write_lua_backtrace( std::ostream &out );
 
-bool save_world_lua_state( const std::string &path );
-bool load_world_lua_state( const std::string &path );
+/** Saves the mods' Lua storage into the world folder, as JSON or as binary when it's large. */
+bool save_world_lua_state( const std::string &world_path );
+bool load_world_lua_state( const std::string &world_path );
 
 std::unique_ptr<lua_state, lua_state_deleter> make_wrapped_state();
+/** Bytes the Lua interpreter has allocated, 0 without Lua. */
+std::size_t lua_memory_usage( lua_state &state );
 
 void init_global_state_tables( lua_state &state, const std::vector<mod_id> &modlist );
 void set_mod_being_loaded( lua_state &state, const mod_id &mod );
@@ -21,6 +21,7 @@
 #include "game.h"
 #include "itype.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "messages.h"
 #include "monfaction.h"
 #include "monster.h"
@@ -39,6 +40,9 @@
 #include "units_mass.h"
 #include "units_volume.h"
 
+#include <algorithm>
+#include <vector>
+
 std::string_view luna::detail::current_comment;
 
 std::string cata::detail::fmt_lua_va( sol::variadic_args va )
@@ -366,7 +370,37 @@ void cata::detail::reg_map( sol::state &lua )
         } );
 
 
+        DOC( "Top-level items on the squares up to radius squares away in each direction, optionally only those of the given type, as one Lua table." );
+        luna::set_fx( ut, "get_items_in_radius", []( map & m, const tripoint & center, int radius,
+        sol::optional<itype_id> type ) -> sol::as_table_t<std::vector<item *>> {
+            std::vector<item *> ret;
+            for( const tripoint &p : m.points_in_radius( center, std::max( radius, 0 ) ) )
+            {
+                for( item * const &it : m.i_at( p ) ) {
+                    if( !type || it->typeId() == *type ) {
+                        ret.push_back( it );
+                    }
+                }
+            }
+            return sol::as_table( std::move( ret ) );
+        } );
+
         luna::set_fx( ut, "get_ter_at", sol::resolve<ter_id( const tripoint & )const>( &map::ter ) );
+        DOC( "Terrain of every square of the box between the two corners as one Lua table, x changing fastest, then y, then z.  Squares outside of the map are t_null." );
+        luna::set_fx( ut, "get_ter_in_rect", []( const map & m, const tripoint & from,
+        const tripoint & to ) -> sol::as_table_t<std::vector<ter_id>> {
+            const tripoint_range<tripoint> box( tripoint( std::min( from.x, to.x ), std::min( from.y, to.y ),
+                                                std::min( from.z, to.z ) ),
+                                                tripoint( std::max( from.x, to.x ), std::max( from.y, to.y ),
+                                                        std::max( from.z, to.z ) ) );
+            std::vector<ter_id> ret;
+            ret.reserve( box.size() );
+            for( const tripoint &p : box )
+            {
+                ret.push_back( m.ter( p ) );
+            }
+            return sol::as_table( std::move( ret ) );
+        } );
         luna::set_fx( ut, "set_ter_at",
                       sol::resolve<bool( const tripoint &, const ter_id & )>( &map::ter_set ) );
 
@@ -631,6 +665,14 @@ void cata::detail::reg_game_api( sol::state &lua )
         hooks.push_back( on_every_x_hooks{ interval, vec } );
     } );
 
+    DOC( "Living creatures up to radius squares away, as one Lua table." );
+    luna::set_fx( lib, "get_creatures_in_radius", []( const tripoint & center,
+    int radius ) -> sol::as_table_t<std::vector<Creature *>> {
+        return sol::as_table( g->get_creatures_in_radius( center, radius, []( const Creature & )
+        {
+            return true;
+        } ) );
+    } );
     luna::set_fx( lib, "get_creature_at", []( const tripoint & p,
     sol::optional<bool> allow_hallucination ) -> Creature * {
         if( allow_hallucination.has_value() )
@@ -1,12 +1,15 @@
 #ifdef LUA
 #include "catalua_impl.h"
 
+#include "calendar.h"
 #include "catalua_bindings.h"
 #include "catalua_log.h"
 #include "catalua_sol.h"
 #include "debug.h"
+#include "options.h"
 #include "string_formatter.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <optional>
@@ -123,6 +126,75 @@ void check_func_result( sol::protected_function_result &res )
     }
 }
 
+std::string get_function_source( const sol::protected_function &func )
+{
+    lua_State *L = func.lua_state();
+    func.push();
+    lua_Debug ar;
+    // '>' takes the function off the stack
+    if( !lua_getinfo( L, ">S", &ar ) ) {
+        return "?";
+    }
+    return string_format( "%s:%d", ar.short_src, ar.linedefined );
+}
+
+namespace
+{
+
+// How many Lua instructions run between checks of the time budget
+constexpr int budget_check_instructions = 1000;
+
+using budget_clock = std::chrono::steady_clock;
+
+bool budget_running = false;
+budget_clock::time_point budget_deadline = budget_clock::time_point::max();
+std::optional<time_point> budget_turn;
+budget_clock::duration budget_used_this_turn = budget_clock::duration::zero();
+
+void check_budget( lua_State *L, lua_Debug * )
+{
+    if( budget_clock::now() > budget_deadline ) {
+        luaL_error( L, "ran out of time, see the Lua call and turn time limits in the debug options" );
+    }
+}
+
+} // namespace
+
+lua_time_budget::lua_time_budget( sol::state_view lua ) : L( lua.lua_state() ),
+    outermost( !budget_running ), start( budget_clock::now() ), previous_deadline( budget_deadline )
+{
+    if( outermost && budget_turn != calendar::turn ) {
+        budget_turn = calendar::turn;
+        budget_used_this_turn = budget_clock::duration::zero();
+    }
+    budget_clock::time_point deadline = budget_clock::time_point::max();
+    const int call_limit = get_option<int>( "LUA_CALL_TIME_LIMIT" );
+    if( call_limit > 0 ) {
+        deadline = start + std::chrono::milliseconds( call_limit );
+    }
+    const int turn_limit = get_option<int>( "LUA_TURN_TIME_LIMIT" );
+    if( turn_limit > 0 ) {
+        deadline = std::min( deadline,
+                             start + std::chrono::milliseconds( turn_limit ) - budget_used_this_turn );
+    }
+    budget_deadline = std::min( previous_deadline, deadline );
+    budget_running = true;
+    if( budget_deadline != budget_clock::time_point::max() ) {
+        lua_sethook( L, check_budget, LUA_MASKCOUNT, budget_check_instructions );
+    }
+}
+
+lua_time_budget::~lua_time_budget()
+{
+    budget_deadline = previous_deadline;
+    if( !outermost ) {
+        return;
+    }
+    budget_running = false;
+    budget_used_this_turn += budget_clock::now() - start;
+    lua_sethook( L, nullptr, 0, 0 );
+}
+
 bool is_number_integer( sol::state_view lua, const sol::object &val )
 {
     if( val.get_type() != sol::type::number ) {
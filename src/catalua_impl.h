@@ -2,6 +2,11 @@
 #ifndef CATA_SRC_CATALUA_IMPL_H
 #define CATA_SRC_CATALUA_IMPL_H
 
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+
 #include "calendar.h"
 #include "catalua_sol.h"
 
@@ -19,6 +24,12 @@ struct on_every_x_hooks {
  */
 struct lua_state {
     sol::state lua;
+    /**
+     * Lists of hook functions by hook name, as created by init_global_state_tables().
+     * Mods can't replace the lists through the read-only game.hooks table,
+     * so running the hooks doesn't have to look them up again every time.
+     */
+    std::map<std::string, sol::table, std::less<>> hooks;
 
     lua_state() = default;
     ~lua_state() = default;
@@ -31,6 +42,30 @@ void run_lua_script( sol::state &lua, const std::string &script_name );
 void run_console_input( sol::state &lua, const std::string &chunk );
 void check_func_result( sol::protected_function_result &res );
 
+// Where the function was defined, as "<script>:<line>", to tell which mod it came from.
+std::string get_function_source( const sol::protected_function &func );
+
+/**
+ * Stops the Lua code run while it exists with a Lua error once it ran for longer than
+ * the LUA_CALL_TIME_LIMIT option allows, or for longer than what is left of
+ * LUA_TURN_TIME_LIMIT in this turn. The error carries the script and line it stopped at.
+ * Budgets made while another one exists don't give the code more time than the outer one.
+ */
+class lua_time_budget
+{
+    public:
+        explicit lua_time_budget( sol::state_view lua );
+        ~lua_time_budget();
+        lua_time_budget( const lua_time_budget & ) = delete;
+        lua_time_budget &operator=( const lua_time_budget & ) = delete;
+
+    private:
+        lua_State *L;
+        bool outermost;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point previous_deadline;
+};
+
 // Numbers in Lua can be either integers or floating-point,
 // but you can't determine that with simple get_type()
 bool is_number_integer( sol::state_view lua, const sol::object &val );
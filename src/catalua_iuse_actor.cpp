@@ -3,7 +3,10 @@
 #include "catalua_iuse_actor.h"
 
 #include "catalua_impl.h"
+#include "lua_stats.h"
 #include "player.h"
+#include "profile.h"
+#include "string_formatter.h"
 
 lua_iuse_actor::lua_iuse_actor( const std::string &type, sol::protected_function &&luafunc )
     : iuse_actor( type ), luafunc( luafunc ) {}
@@ -18,13 +21,19 @@ void lua_iuse_actor::load( const JsonObject & )
 int lua_iuse_actor::use( player &who, item &itm, bool tick, const tripoint &pos ) const
 {
     if( !tick ) {
+        const std::string source = get_function_source( luafunc );
         try {
+            const std::string id = string_format( "%s %s", type, source );
+            ZoneScopedN( "lua_iuse" );
+            ZoneText( id.c_str(), id.size() );
+            const lua_stats::timer timer( lua_call_kind::iuse, id );
+            const lua_time_budget budget( luafunc.lua_state() );
             sol::protected_function_result res = luafunc( who.as_character(), itm, pos );
             check_func_result( res );
             int ret = res;
             return ret;
         } catch( std::runtime_error &e ) {
-            debugmsg( "Failed to run iuse_function k='%s': %s", type, e.what() );
+            debugmsg( "Failed to run iuse_function k='%s' from %s: %s", type, source, e.what() );
         }
     } else {
         // TODO: ticking use
@@ -167,6 +167,14 @@ std::string doc_value( sol::types<std::vector<Val>> )
     return ret + " )";
 }
 
+template<typename Val>
+std::string doc_value( sol::types<sol::as_table_t<std::vector<Val>>> )
+{
+    std::string ret = "Table( ";
+    ret += doc_value( sol::types<Val>() );
+    return ret + " )";
+}
+
 template<typename Val>
 std::string doc_value( sol::types<std::set<Val>> )
 {
@@ -1,6 +1,7 @@
 #if defined(LUA)
 #include "catalua_serde.h"
 
+#include "binary_io.h"
 #include "catalua_impl.h"
 #include "catalua_sol.h"
 #include "debug.h"
@@ -8,6 +9,10 @@
 #include "string_formatter.h"
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <stdexcept>
@@ -126,6 +131,38 @@ void serialize_lua_table( const sol::table &t, JsonOut &jsout )
     serialize_lua_table_internal( t, jsout, stack );
 }
 
+static sol::object deserialize_lua_userdata( sol::state_view lua, const std::string &kind,
+        JsonIn &data_raw )
+{
+    // Horrible hack ahead
+    std::string script = string_format( "return %s.new()", kind );
+    sol::protected_function_result res = lua.script( script, "deserialize_init",
+                                          sol::load_mode::any );
+    if( res.status() != sol::call_status::ok ) {
+        debugmsg( "Failed to init container for deserializable type '%s'", kind );
+    } else {
+        sol::object obj = res;
+        sol::table obj_table = obj.as<sol::table>();
+        if( !obj_table ) {
+            debugmsg( "Failed to init container for deserializable type '%s'", kind );
+        } else {
+            sol::protected_function deserialize_func = obj_table["deserialize"];
+            if( !deserialize_func ) {
+                debugmsg( "Failed to deserialize type '%s': not deserializable.", kind );
+            } else {
+                sol::protected_function_result res = deserialize_func( obj, data_raw );
+                if( res.status() != sol::call_status::ok ) {
+                    sol::error err = res;
+                    debugmsg( "Failed to deserialize type '%s': %s", kind, err.what() );
+                } else {
+                    return obj;
+                }
+            }
+        }
+    }
+    return sol::nil;
+}
+
 static sol::object
 deserialize_lua_object( sol::state_view lua, const JsonObject &jo )
 {
@@ -150,31 +187,7 @@ deserialize_lua_object( sol::state_view lua, const JsonObject &jo )
     } else if( entry_type == "userdata" ) {
         std::string kind = jo.get_member( "kind" );
         JsonIn &data_raw = *jo.get_raw( "data" );
-        // Horrible hack ahead
-        std::string script = string_format( "return %s.new()", kind );
-        sol::protected_function_result res = lua.script( script, "deserialize_init", sol::load_mode::any );
-        if( res.status() != sol::call_status::ok ) {
-            debugmsg( "Failed to init container for deserializable type '%s'", kind );
-        } else {
-            sol::object obj = res;
-            sol::table obj_table = obj.as<sol::table>();
-            if( !obj_table ) {
-                debugmsg( "Failed to init container for deserializable type '%s'", kind );
-            } else {
-                sol::protected_function deserialize_func = obj_table["deserialize"];
-                if( !deserialize_func ) {
-                    debugmsg( "Failed to deserialize type '%s': not deserializable.", kind );
-                } else {
-                    sol::protected_function_result res = deserialize_func( obj, data_raw );
-                    if( res.status() != sol::call_status::ok ) {
-                        sol::error err = res;
-                        debugmsg( "Failed to deserialize type '%s': %s", kind, err.what() );
-                    } else {
-                        return obj;
-                    }
-                }
-            }
-        }
+        return deserialize_lua_userdata( lua, kind, data_raw );
     } else {
         debugmsg( "Deserialization of record type '%s' is not implemented.", entry_type );
     }
@@ -203,6 +216,263 @@ void deserialize_lua_table( sol::table t, JsonObject &obj )
     }
 }
 
+namespace
+{
+
+/**
+ * Tags of the values in binary Lua storage.
+ * A table is its tag, its keys and values one after the other and the end tag.
+ * Never renumber existing tags.
+ */
+enum class lua_value_tag : std::uint8_t {
+    end = 0,
+    nil = 1,
+    boolean_false = 2,
+    boolean_true = 3,
+    integer = 4,
+    number = 5,
+    // A string not written before, followed by the string; it gets the next string index
+    string = 6,
+    // The index of a string written before
+    string_ref = 7,
+    table = 8,
+    // Name of the type as a string, followed by its JSON representation
+    userdata = 9,
+};
+
+class lua_binary_writer
+{
+    public:
+        explicit lua_binary_writer( binary_out &out ) : out( out ) {}
+
+        void write_table( const sol::table &t ) {
+            for( const sol::table &it : stack ) {
+                if( it == t ) {
+                    debugmsg( "Tried to serialize recursive table structure." );
+                    write_tag( lua_value_tag::nil );
+                    return;
+                }
+            }
+            stack.push_back( t );
+            write_tag( lua_value_tag::table );
+            // TODO: persistent key order?
+            t.for_each( [&]( const sol::object & key, const sol::object & val ) {
+                write_object( key );
+                write_object( val );
+            } );
+            write_tag( lua_value_tag::end );
+            stack.pop_back();
+        }
+
+    private:
+        void write_tag( lua_value_tag tag ) {
+            out.write( static_cast<std::uint8_t>( tag ) );
+        }
+
+        void write_string( const std::string &str ) {
+            const auto it = string_indices.find( str );
+            if( it != string_indices.end() ) {
+                write_tag( lua_value_tag::string_ref );
+                out.write( it->second );
+                return;
+            }
+            string_indices.emplace( str, static_cast<std::uint32_t>( string_indices.size() ) );
+            write_tag( lua_value_tag::string );
+            out.write( str );
+        }
+
+        void write_userdata( const sol::object &val ) {
+            std::optional<std::string> luna_type = get_luna_type( val );
+            if( !luna_type ) {
+                debugmsg( "Tried to serialize usertype that was not registered with luna." );
+                write_tag( lua_value_tag::nil );
+                return;
+            }
+            sol::table table_val = val.as<sol::table>();
+            sol::protected_function serialize_func = table_val["serialize"];
+            if( !serialize_func ) {
+                debugmsg( "Tried to serialize usertype that does not allow serialization." );
+                write_tag( lua_value_tag::nil );
+                return;
+            }
+            std::ostringstream data;
+            JsonOut jsout( data );
+            sol::protected_function_result res = serialize_func( val, jsout );
+            if( res.status() != sol::call_status::ok ) {
+                sol::error err = res;
+                debugmsg( "Failed to serialize type '%s': %s", *luna_type, err.what() );
+                write_tag( lua_value_tag::nil );
+                return;
+            }
+            write_tag( lua_value_tag::userdata );
+            write_string( *luna_type );
+            out.write( data.str() );
+        }
+
+        void write_object( const sol::object &val ) {
+            switch( val.get_type() ) {
+                case sol::type::boolean: {
+                    write_tag( val.as<bool>() ? lua_value_tag::boolean_true :
+                               lua_value_tag::boolean_false );
+                    break;
+                }
+                case sol::type::number: {
+                    if( is_number_integer( sol::state_view( val.lua_state() ), val ) ) {
+                        write_tag( lua_value_tag::integer );
+                        out.write( val.as<std::int64_t>() );
+                    } else {
+                        write_tag( lua_value_tag::number );
+                        out.write( std::bit_cast<std::uint64_t>( val.as<double>() ) );
+                    }
+                    break;
+                }
+                case sol::type::string: {
+                    write_string( val.as<std::string>() );
+                    break;
+                }
+                case sol::type::table: {
+                    write_table( val.as<sol::table>() );
+                    break;
+                }
+                case sol::type::userdata: {
+                    write_userdata( val );
+                    break;
+                }
+                default: {
+                    debugmsg( "Unsupported type encountered when serializing Lua table." );
+                    write_tag( lua_value_tag::nil );
+                    break;
+                }
+            }
+        }
+
+        binary_out &out;
+        std::unordered_map<std::string, std::uint32_t> string_indices;
+        std::vector<sol::table> stack;
+};
+
+class lua_binary_reader
+{
+    public:
+        lua_binary_reader( sol::state_view lua, binary_in &in ) : lua( lua ), in( in ) {}
+
+        // Reads the entries of a table after its tag, up to and including the end tag
+        void read_entries( sol::table t ) {
+            for( lua_value_tag tag = read_tag(); tag != lua_value_tag::end; tag = read_tag() ) {
+                sol::object key = read_value( tag );
+                sol::object val = read_value( read_tag() );
+                // Keys that could not be written are stored as nil
+                if( key.get_type() != sol::type::lua_nil ) {
+                    t.set( key, val );
+                }
+            }
+        }
+
+        lua_value_tag read_tag() {
+            return static_cast<lua_value_tag>( in.read<std::uint8_t>() );
+        }
+
+    private:
+        std::string read_string( lua_value_tag tag ) {
+            if( tag == lua_value_tag::string ) {
+                strings.push_back( in.read_string() );
+                return strings.back();
+            }
+            if( tag == lua_value_tag::string_ref ) {
+                const std::uint32_t index = in.read<std::uint32_t>();
+                if( index >= strings.size() ) {
+                    throw binary_error( "invalid string index in binary Lua storage" );
+                }
+                return strings[index];
+            }
+            throw binary_error( "expected a string in binary Lua storage" );
+        }
+
+        sol::object read_value( lua_value_tag tag ) {
+            switch( tag ) {
+                case lua_value_tag::nil:
+                    return sol::nil;
+                case lua_value_tag::boolean_false:
+                    return sol::object( lua, sol::in_place, false );
+                case lua_value_tag::boolean_true:
+                    return sol::object( lua, sol::in_place, true );
+                case lua_value_tag::integer:
+                    return sol::object( lua, sol::in_place, in.read<std::int64_t>() );
+                case lua_value_tag::number:
+                    return sol::object( lua, sol::in_place,
+                                        std::bit_cast<double>( in.read<std::uint64_t>() ) );
+                case lua_value_tag::string:
+                case lua_value_tag::string_ref:
+                    return sol::object( lua, sol::in_place, read_string( tag ) );
+                case lua_value_tag::table: {
+                    sol::table new_table = lua.create_table();
+                    read_entries( new_table );
+                    return new_table;
+                }
+                case lua_value_tag::userdata: {
+                    const std::string kind = read_string( read_tag() );
+                    std::istringstream data( in.read_string() );
+                    JsonIn jsin( data );
+                    return deserialize_lua_userdata( lua, kind, jsin );
+                }
+                case lua_value_tag::end:
+                    break;
+            }
+            throw binary_error( string_format( "invalid value tag %d in binary Lua storage",
+                                               static_cast<int>( tag ) ) );
+        }
+
+        sol::state_view lua;
+        binary_in &in;
+        std::vector<std::string> strings;
+};
+
+} // namespace
+
+void serialize_lua_table_binary( const sol::table &t, binary_out &out )
+{
+    lua_binary_writer writer( out );
+    writer.write_table( t );
+}
+
+static size_t count_lua_table_values_internal( const sol::table &t,
+        std::vector<sol::table> &stack )
+{
+    for( const sol::table &it : stack ) {
+        if( it == t ) {
+            return 0;
+        }
+    }
+    stack.push_back( t );
+    size_t count = 0;
+    t.for_each( [&]( const sol::object & key, const sol::object & val ) {
+        count += 2;
+        if( key.get_type() == sol::type::table ) {
+            count += count_lua_table_values_internal( key.as<sol::table>(), stack );
+        }
+        if( val.get_type() == sol::type::table ) {
+            count += count_lua_table_values_internal( val.as<sol::table>(), stack );
+        }
+    } );
+    stack.pop_back();
+    return count;
+}
+
+size_t count_lua_table_values( const sol::table &t )
+{
+    std::vector<sol::table> stack;
+    return count_lua_table_values_internal( t, stack );
+}
+
+void deserialize_lua_table_binary( sol::table t, binary_in &in )
+{
+    lua_binary_reader reader( t.lua_state(), in );
+    if( reader.read_tag() != lua_value_tag::table ) {
+        throw binary_error( "binary Lua storage does not start with a table" );
+    }
+    reader.read_entries( t );
+}
+
 } // namespace cata
 
 #endif
@@ -2,8 +2,12 @@
 #ifndef CATA_SRC_CATALUA_SERDE_H
 #define CATA_SRC_CATALUA_SERDE_H
 
+#include <cstddef>
+
 #include "catalua_sol_fwd.h"
 
+class binary_in;
+class binary_out;
 class JsonObject;
 class JsonOut;
 
@@ -13,6 +17,17 @@ namespace cata
 void serialize_lua_table( const sol::table &t, JsonOut &jsout );
 void deserialize_lua_table( sol::table t, JsonObject &obj );
 
+/**
+ * Compact binary encoding of the same tables, for storage too big to write as JSON.
+ * Every string is written once and referred to by index after that.
+ * Usertypes are embedded as their JSON representation.
+ */
+void serialize_lua_table_binary( const sol::table &t, binary_out &out );
+void deserialize_lua_table_binary( sol::table t, binary_in &in );
+
+/** Number of keys and values in the table and the tables inside it. */
+size_t count_lua_table_values( const sol::table &t );
+
 } // namespace cata
 
 #endif // CATA_SRC_CATALUA_SERDE_H
@@ -1,5 +1,8 @@
 #include "cellular_automata.h"
 
+#include <algorithm>
+#include <cstdint>
+
 int CellularAutomata::neighbor_count( const std::vector<std::vector<int>> &cells,
                                       point size,
                                       point p )
@@ -29,47 +32,51 @@ std::vector<std::vector<int>> CellularAutomata::generate_cellular_automaton(
                                const int birth_limit,
                                const int stasis_limit )
 {
-    std::vector<std::vector<int>> current( size.x, std::vector<int>( size.y, 0 ) );
-    std::vector<std::vector<int>> next( size.x, std::vector<int>( size.y, 0 ) );
+    // The cells are kept in flat column-major grids, cell (i, j) at i * size.y + j, so
+    // a step is a few passes over contiguous columns the compiler can vectorize.
+    const int width = std::max( size.x, 0 );
+    const int height = std::max( size.y, 0 );
+    std::vector<std::uint8_t> current( static_cast<size_t>( width ) * height, 0 );
+    std::vector<std::uint8_t> next( current.size(), 0 );
+    // Number of alive cells in the column and the ones either side of it, for each row
+    std::vector<std::uint8_t> strip( height, 0 );
 
     // Initialize our initial set of cells.
-    for( int i = 0; i < size.x; i++ ) {
-        for( int j = 0; j < size.y; j++ ) {
-            current[i][j] = x_in_y( alive, 100 );
+    for( int i = 0; i < width; i++ ) {
+        for( int j = 0; j < height; j++ ) {
+            current[i * height + j] = x_in_y( alive, 100 );
         }
     }
 
     for( int iteration = 0; iteration < iterations; iteration++ ) {
-        for( int i = 0; i < size.x; i++ ) {
-            for( int j = 0; j < size.y; j++ ) {
-                // Skip the edges--no need to complicate this with more complex neighbor
-                // calculations, just keep them constant.
-                if( i == 0 || i == size.x - 1 || j == 0 || j == size.y - 1 ) {
-                    next[i][j] = 0;
-                    continue;
-                }
-
-                // Count our neighors.
-                const int neighbors = neighbor_count( current, size, point( i, j ) );
-
-                // Dead and > birth_limit neighbors, so become alive.
-                if( ( current[i][j] == 0 ) && ( neighbors > birth_limit ) ) {
-                    next[i][j] = 1;
-                }
-                // Alive and > statis_limit neighbors, so stay alive.
-                else if( ( current[i][j] == 1 ) && ( neighbors > stasis_limit ) ) {
-                    next[i][j] = 1;
-                }
-                // Else, die.
-                else {
-                    next[i][j] = 0;
-                }
+        // Skip the edges--no need to complicate this with more complex neighbor
+        // calculations, just keep them constant.
+        std::fill( next.begin(), next.end(), 0 );
+        for( int i = 1; i < width - 1; i++ ) {
+            const std::uint8_t *left = &current[( i - 1 ) * height];
+            const std::uint8_t *middle = &current[i * height];
+            const std::uint8_t *right = &current[( i + 1 ) * height];
+            std::uint8_t *out = &next[i * height];
+            for( int j = 0; j < height; j++ ) {
+                strip[j] = left[j] + middle[j] + right[j];
+            }
+            for( int j = 1; j < height - 1; j++ ) {
+                // The 3x3 block around the cell, minus the cell itself.
+                const int neighbors = strip[j - 1] + strip[j] + strip[j + 1] - middle[j];
+                // Dead cells with > birth_limit neighbors become alive, alive ones with
+                // > stasis_limit neighbors stay alive, the rest die.
+                out[j] = neighbors > ( middle[j] ? stasis_limit : birth_limit );
             }
         }
 
-        // Swap our current and next vectors and repeat.
+        // Swap our current and next grids and repeat.
         std::swap( current, next );
     }
 
-    return current;
+    std::vector<std::vector<int>> ret( width, std::vector<int>( height ) );
+    for( int i = 0; i < width; i++ ) {
+        std::copy( current.begin() + i * height, current.begin() + ( i + 1 ) * height,
+                   ret[i].begin() );
+    }
+    return ret;
 }
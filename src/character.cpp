@@ -547,11 +547,13 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     known_traps = std::move( source.known_traps );
     encumbrance_cache = std::move( source.encumbrance_cache );
+    worn_warmth_cache = std::move( source.worn_warmth_cache );
     my_mutations = std::move( source.my_mutations );
     last_sleep_check = source.last_sleep_check ;
     bio_soporific_powered_at_last_sleep_check = source.bio_soporific_powered_at_last_sleep_check ;
     my_traits = std::move( source.my_traits );
     cached_mutations = std::move( source.cached_mutations );
+    cached_mutation_bits = std::move( source.cached_mutation_bits );
     _skills = std::move( source._skills );
     autolearn_skills_stamp = std::move( source.autolearn_skills_stamp );
     learned_recipes = std::move( source.learned_recipes );
@@ -585,6 +587,7 @@ void Character::move_operator_common( Character &&source ) noexcept
     fatigue = source.fatigue ;
     sleep_deprivation = source.sleep_deprivation ;
     check_encumbrance = source.check_encumbrance ;
+    encumbrance_inv_volume = source.encumbrance_inv_volume;
 
     stim = source.stim ;
     pkill = source.pkill ;
@@ -599,12 +602,15 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     cached_moves = source.cached_moves ;
     cached_position = source.cached_position ;
+    cached_radius = source.cached_radius ;
+    cached_clear_path = source.cached_clear_path ;
     cached_crafting_inventory = std::move( source.cached_crafting_inventory );
 
     npc_ai_info_cache = source.npc_ai_info_cache ;
 
 
     enchantment_cache = std::move( source.enchantment_cache );
+    enchantment_cache_sources = std::move( source.enchantment_cache_sources );
 
     overmap_time = std::move( source.overmap_time );
 
@@ -1984,9 +1990,14 @@ void Character::flag_encumbrance()
     check_encumbrance = true;
 }
 
+bool Character::get_check_encumbrance() const
+{
+    return check_encumbrance || inv_volume() != encumbrance_inv_volume;
+}
+
 void Character::check_item_encumbrance_flag()
 {
-    bool update_required = check_encumbrance;
+    bool update_required = get_check_encumbrance();
     for( auto &i : worn ) {
         if( !update_required && i->encumbrance_update_ ) {
             update_required = true;
@@ -4014,9 +4025,72 @@ void Character::reset()
     Creature::reset();
 }
 
+// The worn items covering each body part, outermost last
+static std::map<bodypart_id, std::vector<const item *>> worn_clothing_map( const Character &who )
+{
+    std::map<bodypart_id, std::vector<const item *>> clothing_map;
+    for( const auto &pr : who.get_body() ) {
+        clothing_map.emplace( pr.first, std::vector<const item *>() );
+    }
+    for( const item * const &it : who.worn ) {
+        // TODO: Port body part set id changes
+        const body_part_set &covered = it->get_covered_body_parts();
+        for( size_t i = 0; i < num_bp; i++ ) {
+            body_part token = static_cast<body_part>( i );
+            if( covered.test( convert_bp( token ) ) ) {
+                clothing_map[convert_bp( token )].emplace_back( it );
+            }
+        }
+    }
+    return clothing_map;
+}
+
 void Character::reset_encumbrance()
 {
     *encumbrance_cache = calc_encumbrance();
+    *worn_warmth_cache = calc_worn_warmth();
+    check_encumbrance = false;
+    encumbrance_inv_volume = inv_volume();
+}
+
+worn_warmth_data Character::calc_worn_warmth() const
+{
+    const std::map<bodypart_id, std::vector<const item *>> clothing_map =
+                worn_clothing_map( *this );
+    std::map<bodypart_id, std::vector<const item *>> bonus_clothing_map;
+    for( const auto &pr : clothing_map ) {
+        bonus_clothing_map.emplace( pr.first, std::vector<const item *>() );
+    }
+    for( const item * const &it : worn ) {
+        // Added once for each body part, as the wind resistance has always counted them
+        for( size_t i = 0; i < num_bp; i++ ) {
+            if( it->has_flag( flag_HOOD ) ) {
+                bonus_clothing_map[body_part_head].emplace_back( it );
+            }
+            if( it->has_flag( flag_COLLAR ) ) {
+                bonus_clothing_map[body_part_mouth].emplace_back( it );
+            }
+            if( it->has_flag( flag_POCKETS ) ) {
+                bonus_clothing_map[body_part_hand_l].emplace_back( it );
+                bonus_clothing_map[body_part_hand_r].emplace_back( it );
+            }
+        }
+    }
+
+    worn_warmth_data ret;
+    for( const auto &pr : warmth::from_clothing( clothing_map ) ) {
+        ret.warmth[pr.first->token] = pr.second;
+    }
+    for( const auto &pr : warmth::bonus_from_clothing( bonus_clothing_map ) ) {
+        ret.bonus_warmth[pr.first->token] = pr.second;
+    }
+    for( const auto &pr : warmth::wind_resistance_from_clothing( clothing_map ) ) {
+        ret.wind_resistance[pr.first->token] = pr.second;
+    }
+    for( const auto &pr : warmth::wind_resistance_from_clothing( bonus_clothing_map ) ) {
+        ret.bonus_wind_resistance[pr.first->token] = pr.second;
+    }
+    return ret;
 }
 
 char_encumbrance_data Character::calc_encumbrance() const
@@ -4208,7 +4282,7 @@ bool Character::in_climate_control()
         return true;
     }
     map &here = get_map();
-    if( has_trait( trait_M_SKIN3 ) && here.has_flag_ter_or_furn( "FUNGUS", pos() ) &&
+    if( has_trait( trait_M_SKIN3 ) && here.has_flag_ter_or_furn( TFLAG_FUNGUS, pos() ) &&
         in_sleep_state() ) {
         return true;
     }
@@ -4333,6 +4407,8 @@ location_vector<item>::iterator Character::position_to_wear_new_item( const item
  */
 void Character::item_encumb( char_encumbrance_data &vals, const item &new_item ) const
 {
+    // Every worn item covering a part adds up the volume of its contents and the inventory
+    const scoped_item_measure_cache measures;
 
     // reset all layer data
     vals = char_encumbrance_data();
@@ -4868,7 +4944,7 @@ bool Character::is_deaf() const
     return get_effect_int( effect_deaf ) > 2 || worn_with_flag( flag_DEAF ) ||
            has_trait( trait_DEAF ) ||
            ( has_active_bionic( bio_earplugs ) && !has_active_bionic( bio_ears ) ) ||
-           ( has_trait( trait_M_SKIN3 ) && get_map().has_flag_ter_or_furn( "FUNGUS", pos() )
+           ( has_trait( trait_M_SKIN3 ) && get_map().has_flag_ter_or_furn( TFLAG_FUNGUS, pos() )
              && in_sleep_state() );
 }
 
@@ -5644,12 +5720,7 @@ void Character::update_bodytemp( const map &m, const weather_manager &weather )
     const bool submerged = !in_vehicle && ter_at_pos->has_flag( TFLAG_DEEP_WATER );
     const bool submerged_low = !in_vehicle && ( submerged || ter_at_pos->has_flag( TFLAG_SWIMMABLE ) );
 
-    std::map<bodypart_id, std::vector<const item *>> clothing_map;
-    std::map<bodypart_id, std::vector<const item *>> bonus_clothing_map;
     for( auto &pr : get_body() ) {
-        const bodypart_id &bp_id = pr.first;
-        clothing_map.emplace( bp_id, std::vector<const item *>() );
-        bonus_clothing_map.emplace( bp_id, std::vector<const item *>() );
         // HACK: we're using temp_conv here to temporarily save
         //       temperature values from before equalization.
         bodypart &bp = pr.second;
@@ -5672,60 +5743,31 @@ void Character::update_bodytemp( const map &m, const weather_manager &weather )
     temp_equalizer( *this, body_part_leg_l, body_part_foot_l );
     temp_equalizer( *this, body_part_leg_r, body_part_foot_r );
 
-    for( const item * const &it : worn ) {
-        // TODO: Port body part set id changes
-        const body_part_set &covered = it->get_covered_body_parts();
-        for( size_t i = 0; i < num_bp; i++ ) {
-            body_part token = static_cast<body_part>( i );
-            if( covered.test( convert_bp( token ) ) ) {
-                clothing_map[convert_bp( token )].emplace_back( it );
-            }
-            if( it->has_flag( flag_HOOD ) ) {
-                bonus_clothing_map[body_part_head].emplace_back( it );
-            }
-            if( it->has_flag( flag_COLLAR ) ) {
-                bonus_clothing_map[body_part_mouth].emplace_back( it );
-            }
-            if( it->has_flag( flag_POCKETS ) ) {
-                bonus_clothing_map[body_part_hand_l].emplace_back( it );
-                bonus_clothing_map[body_part_hand_r].emplace_back( it );
-            }
-        }
-    }
+    // Picks up clothing changes made since the items were last processed
+    check_item_encumbrance_flag();
+    const worn_warmth_data &worn_warmth = *worn_warmth_cache;
     // If player is wielding something large, pockets are not usable
-    if( primary_weapon().volume() >= 500_ml ) {
-        bonus_clothing_map[body_part_hand_l].clear();
-        bonus_clothing_map[body_part_hand_r].clear();
-    }
+    const bool pockets_usable = primary_weapon().volume() < 500_ml;
     // If player's head is encumbered, hood can't be put up
-    if( encumb( body_part_head ) >= 10 ) {
-        bonus_clothing_map[body_part_head].clear();
-    }
+    const bool hood_usable = encumb( body_part_head ) < 10;
     // Similar for mouth
-    if( encumb( body_part_mouth ) >= 10 ) {
-        bonus_clothing_map[body_part_mouth].clear();
-    }
+    const bool collar_usable = encumb( body_part_mouth ) < 10;
+    const auto bonus_usable = [&]( const bodypart_id & bp ) {
+        if( bp == body_part_hand_l || bp == body_part_hand_r ) {
+            return pockets_usable;
+        } else if( bp == body_part_head ) {
+            return hood_usable;
+        } else if( bp == body_part_mouth ) {
+            return collar_usable;
+        }
+        return true;
+    };
 
-    std::map<bodypart_id, int> warmth_per_bp = warmth::from_clothing( clothing_map );
-    std::map<bodypart_id, int> bonus_warmth_per_bp = warmth::bonus_from_clothing( bonus_clothing_map );
+    std::array<int, num_bp> warmth_per_bp = worn_warmth.warmth;
     for( const auto &pr : warmth::from_effects( *this ) ) {
-        warmth_per_bp[pr.first] += pr.second;
-    }
-
-    std::map<bodypart_id, int> wind_res_per_bp = warmth::wind_resistance_from_clothing( clothing_map );
-    std::map<bodypart_id, int> wind_res_per_bp_bonus = warmth::wind_resistance_from_clothing(
-                bonus_clothing_map );
-    for( std::pair<const bodypart_id, int> &bp_wind_res : wind_res_per_bp ) {
-        int exposed = std::max( 0, 100 - bp_wind_res.second );
-        int exposed_bonus = std::max( 0, 100 - wind_res_per_bp_bonus.at( bp_wind_res.first ) );
-        int exposed_final = exposed * exposed_bonus / ( 100 * 100 );
-        bp_wind_res.second = 100 - exposed_final;
-    }
-    if( has_active_mutation( trait_SHELL2 ) ) {
-        for( std::pair<const bodypart_id, int> &bp_wind_res : wind_res_per_bp ) {
-            bp_wind_res.second = 100;
-        }
+        warmth_per_bp[pr.first->token] += pr.second;
     }
+    const bool wind_proof = has_active_mutation( trait_SHELL2 );
     // We might not use this at all, so leave it empty
     // If we do need to use it, we'll initialize it (once) there
     std::map<bodypart_id, int> fire_armor_per_bp;
@@ -5756,11 +5798,20 @@ void Character::update_bodytemp( const map &m, const weather_manager &weather )
                                     bp_stats.get_temp_cur() );
         // Produces a smooth curve between 30.0 and 60.0.
         double homeostasis_adjustment = 30.0 * ( 1.0 + scaled_temperature );
-        int clothing_warmth_adjustment = static_cast<int>( homeostasis_adjustment * warmth_per_bp[bp] );
-        int clothing_warmth_adjusted_bonus = static_cast<int>( homeostasis_adjustment *
-                                             bonus_warmth_per_bp[bp] );
+        int clothing_warmth_adjustment = static_cast<int>( homeostasis_adjustment *
+                                         warmth_per_bp[bp->token] );
+        const bool use_bonus = bonus_usable( bp );
+        int clothing_warmth_adjusted_bonus = use_bonus ? static_cast<int>( homeostasis_adjustment *
+                                             worn_warmth.bonus_warmth[bp->token] ) : 0;
         // WINDCHILL
-        double bp_windpower = total_windpower * ( 1 - wind_res_per_bp[bp] / 100.0 );
+        int wind_res = 100;
+        if( !wind_proof ) {
+            int exposed = std::max( 0, 100 - worn_warmth.wind_resistance[bp->token] );
+            int exposed_bonus = std::max( 0, 100 - ( use_bonus ?
+                                          worn_warmth.bonus_wind_resistance[bp->token] : 0 ) );
+            wind_res = 100 - exposed * exposed_bonus / ( 100 * 100 );
+        }
+        double bp_windpower = total_windpower * ( 1 - wind_res / 100.0 );
         // Calculate windchill
         int windchill = submerged_bp
                         ? 0
@@ -5790,7 +5841,7 @@ void Character::update_bodytemp( const map &m, const weather_manager &weather )
             blister_count -= 20;
         }
         if( fire_armor_per_bp.empty() && blister_count > 0 ) {
-            fire_armor_per_bp = get_armor_fire( clothing_map );
+            fire_armor_per_bp = get_armor_fire( worn_clothing_map( *this ) );
         }
         // BLISTERS : Skin gets blisters from intense heat exposure.
         // Fire protection protects from blisters.
@@ -5940,12 +5991,12 @@ void Character::update_bodytemp( const map &m, const weather_manager &weather )
             int wetness_percentage = 100 * bp_stats.get_wetness() / bp_stats.get_drench_capacity(); // 0 - 100
             // Warmth gives a slight buff to temperature resistance
             // Wetness gives a heavy nerf to temperature resistance
-            double adjusted_warmth = warmth_per_bp.at( bp ) - wetness_percentage;
+            double adjusted_warmth = warmth_per_bp[bp->token] - wetness_percentage;
             int Ftemperature = static_cast<int>( units::to_fahrenheit( player_local_temp ) + 0.2 *
                                                  adjusted_warmth );
             // Windchill reduced by your armor
             int FBwindPower = static_cast<int>(
-                                  total_windpower * ( 1 - wind_res_per_bp[ bp ] / 100.0 ) );
+                                  total_windpower * ( 1 - wind_res / 100.0 ) );
 
             int intense = get_effect_int( effect_frostbite, bp.id() );
 
@@ -8210,13 +8261,13 @@ mutation_category_id Character::get_highest_category() const
 
 void Character::recalculate_enchantment_cache()
 {
-    // start by resetting the cache
-    *enchantment_cache = enchantment();
+    std::vector<const enchantment *> sources;
+    sources.reserve( enchantment_cache_sources.size() );
 
     visit_items( [&]( const item * it ) {
         for( const enchantment &ench : it->get_enchantments() ) {
-            if( ench.is_active( *this, *it ) ) {
-                enchantment_cache->force_add( ench );
+            if( ench.is_active_carried( *this, *it ) ) {
+                sources.push_back( &ench );
             }
         }
         return VisitResponse::NEXT;
@@ -8229,7 +8280,7 @@ void Character::recalculate_enchantment_cache()
         for( const enchantment_id &ench_id : mut.enchantments ) {
             const enchantment &ench = ench_id.obj();
             if( ench.is_active( *this, mut.activated && mut_map.second.powered ) ) {
-                enchantment_cache->force_add( ench );
+                sources.push_back( &ench );
             }
         }
     }
@@ -8241,22 +8292,46 @@ void Character::recalculate_enchantment_cache()
             const enchantment &ench = ench_id.obj();
             if( ench.is_active( *this, bio.powered &&
                                 bid->has_flag( STATIC( flag_id( "BIONIC_TOGGLED" ) ) ) ) ) {
-                enchantment_cache->force_add( ench );
+                sources.push_back( &ench );
             }
         }
     }
 
+    // Most turns nothing was picked up, dropped, switched or moved under water
+    const auto same = []( const enchantment * ench, const enchantment & cached ) {
+        return *ench == cached;
+    };
+    if( std::equal( sources.begin(), sources.end(), enchantment_cache_sources.begin(),
+                    enchantment_cache_sources.end(), same ) ) {
+        return;
+    }
+
+    *enchantment_cache = enchantment();
+    enchantment_cache_sources.clear();
+    for( const enchantment *ench : sources ) {
+        enchantment_cache->force_add( *ench );
+        enchantment_cache_sources.push_back( *ench );
+    }
+
     rebuild_mutation_cache();
 }
 
 void Character::rebuild_mutation_cache()
 {
     cached_mutations.clear();
+    cached_mutation_bits.assign( mutation_branch::get_all().size(), false );
+    const auto cache = [this]( const trait_id & mut ) {
+        cached_mutations.push_back( &mut.obj() );
+        const int index = mutation_branch::get_index( mut );
+        if( index >= 0 ) {
+            cached_mutation_bits[index] = true;
+        }
+    };
     for( const std::pair<const trait_id, char_trait_data> &mut : my_mutations ) {
-        cached_mutations.push_back( &mut.first.obj() );
+        cache( mut.first );
     }
     for( const trait_id &mut : enchantment_cache->get_mutations() ) {
-        cached_mutations.push_back( &mut.obj() );
+        cache( mut );
     }
 }
 
@@ -9369,6 +9444,7 @@ std::vector<detached_ptr<item>> Character::inv_dump_remove()
         it = worn.erase( it, &t );
         ret.push_back( std::move( t ) );
     }
+    flag_encumbrance();
     inv.dump_remove( ret );
     return ret;
 }
@@ -10309,7 +10385,7 @@ void Character::on_item_wear( const item &it )
     for( const trait_id &mut : it.mutations_from_wearing( *this ) ) {
         mutation_effect( mut );
         recalc_sight_limits();
-        calc_encumbrance();
+        reset_encumbrance();
 
         // If the stamina is higher than the max (Languorous), set it back to max
         if( get_stamina() > get_stamina_max() ) {
@@ -10324,7 +10400,7 @@ void Character::on_item_takeoff( const item &it )
     for( const trait_id &mut : it.mutations_from_wearing( *this ) ) {
         mutation_loss_effect( mut );
         recalc_sight_limits();
-        calc_encumbrance();
+        reset_encumbrance();
         if( get_stamina() > get_stamina_max() ) {
             set_stamina( get_stamina_max() );
         }
@@ -10481,7 +10557,7 @@ int Character::run_cost( int base_cost, bool diag ) const
     map &here = get_map();
     // The "FLAT" tag includes soft surfaces, so not a good fit.
     const bool on_road = flatground && here.has_flag( "ROAD", pos() );
-    const bool on_fungus = here.has_flag_ter_or_furn( "FUNGUS", pos() );
+    const bool on_fungus = here.has_flag_ter_or_furn( TFLAG_FUNGUS, pos() );
 
     if( !is_mounted() ) {
         if( movecost > 100 ) {
@@ -10554,7 +10630,7 @@ int Character::run_cost( int base_cost, bool diag ) const
         // ROOTS3 does slow you down as your roots are probing around for nutrients,
         // whether you want them to or not.  ROOTS1 is just too squiggly without shoes
         // to give you some stability.  Plants are a bit of a slow-mover.  Deal.
-        if( has_trait( trait_ROOTS3 ) && here.has_flag( "DIGGABLE", pos() ) ) {
+        if( has_trait( trait_ROOTS3 ) && here.has_flag( TFLAG_DIGGABLE, pos() ) ) {
             movecost += 10 * footwear_factor();
         }
 
@@ -10676,15 +10752,15 @@ bool Character::is_visible_in_range( const Creature &critter, const int range )
 
 std::vector<Creature *> Character::get_visible_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return g->get_creatures_in_radius( pos(), range, [this]( const Creature & critter ) -> bool {
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
-        rl_dist( pos(), critter.pos() ) <= range && sees( critter );
+        sees( critter );
     } );
 }
 
 std::vector<Creature *> Character::get_hostile_creatures( int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return g->get_creatures_in_radius( pos(), range, [this, range]( const Creature & critter ) -> bool {
         // Fixes circular distance range for ranged attacks
         float dist_to_creature = std::round( rl_dist_exact( pos(), critter.pos() ) );
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
@@ -11458,7 +11534,7 @@ void Character::knock_back_to( const tripoint &to )
     }
 
     // If we're still in the function at this point, we're actually moving a tile!
-    if( g->m.has_flag( "LIQUID", to ) && g->m.has_flag( TFLAG_DEEP_WATER, to ) ) {
+    if( g->m.has_flag( TFLAG_LIQUID, to ) && g->m.has_flag( TFLAG_DEEP_WATER, to ) ) {
         if( !is_npc() ) {
             avatar_action::swim( g->m, g->u, to );
         }
@@ -70,6 +70,7 @@ class monster;
 class weather_manager;
 struct bionic;
 struct char_encumbrance_data;
+struct worn_warmth_data;
 struct construction;
 struct consumption_history_t;
 struct dealt_projectile_attack;
@@ -486,7 +487,7 @@ class Character : public Creature, public location_visitable<Character>
 
         void environmental_revert_effect();
 
-        /** Recalculates encumbrance cache. */
+        /** Recalculates encumbrance cache, and the warmth of the worn clothing with it. */
         void reset_encumbrance();
         /** Returns ENC provided by armor, etc. */
         int encumb( const bodypart_str_id &bp ) const;
@@ -856,6 +857,8 @@ class Character : public Creature, public location_visitable<Character>
         /** Recalculate encumbrance for all body parts as if `new_item` was also worn. */
         char_encumbrance_data calc_encumbrance( const item &new_item ) const;
 
+        /** Sums up the warmth and wind resistance the worn clothing gives each body part. */
+        worn_warmth_data calc_worn_warmth() const;
         /** Applies encumbrance from mutations and bionics only */
         void mut_cbm_encumb( char_encumbrance_data &vals ) const;
 
@@ -2080,9 +2083,11 @@ class Character : public Creature, public location_visitable<Character>
         bool change_side( item &it, bool interactive = true );
         bool change_side( item *it, bool interactive = true );
 
-        bool get_check_encumbrance() const {
-            return check_encumbrance;
-        }
+        /**
+         * Whether the encumbrance was flagged for updating, or the volume carried, which worn
+         * storage items are encumbered by, changed since it was last calculated.
+         */
+        bool get_check_encumbrance() const;
         void set_check_encumbrance( bool new_check ) {
             check_encumbrance = new_check;
         }
@@ -2204,6 +2209,7 @@ class Character : public Creature, public location_visitable<Character>
 
         trap_map known_traps;
         pimpl<char_encumbrance_data> encumbrance_cache;
+        pimpl<worn_warmth_data> worn_warmth_cache;
     public:
         /**
          * Traits / mutations of the character. Key is the mutation id (it's also a valid
@@ -2223,6 +2229,11 @@ class Character : public Creature, public location_visitable<Character>
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /**
+         * The mutations of @ref cached_mutations by @ref mutation_branch::get_index, so
+         * @ref has_trait doesn't have to look them up.
+         */
+        std::vector<bool> cached_mutation_bits;
 
         void store( JsonOut &json ) const;
         void load( const JsonObject &data );
@@ -2316,6 +2327,8 @@ class Character : public Creature, public location_visitable<Character>
         int fatigue = 0;
         int sleep_deprivation = 0;
         bool check_encumbrance = true;
+        /** Volume carried when the encumbrance was last calculated. */
+        units::volume encumbrance_inv_volume = 0_ml;
 
         int stim = 0;
         int pkill = 0;
@@ -2331,6 +2344,8 @@ class Character : public Creature, public location_visitable<Character>
 
         int cached_moves = 0;
         tripoint cached_position;
+        int cached_radius = 0;
+        bool cached_clear_path = false;
         inventory cached_crafting_inventory;
 
         mutable std::array<double, npc_ai_info::num_npc_ai_info> npc_ai_info_cache;
@@ -2339,8 +2354,11 @@ class Character : public Creature, public location_visitable<Character>
 
     protected:
         // a cache of all active enchantment values.
-        // is recalculated every turn in Character::recalculate_enchantment_cache
+        // is recalculated in Character::recalculate_enchantment_cache when the active ones change
         pimpl<enchantment> enchantment_cache;
+        // copies of the active enchantments the cache was last built from, in the order they
+        // were added, so an item changed or replaced in the same place isn't taken for the same
+        std::vector<enchantment> enchantment_cache_sources;
 
         /** Amount of time the player has spent in each overmap tile. */
         std::unordered_map<point_abs_omt, time_duration> overmap_time;
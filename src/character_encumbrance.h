@@ -52,4 +52,16 @@ struct char_encumbrance_data {
     std::array<encumbrance_data, num_bp> elems;
 };
 
+/**
+ * What the worn clothing adds to the body temperature of each body part. Like the
+ * encumbrance it only changes with the clothing, so both are recalculated together.
+ */
+struct worn_warmth_data {
+    std::array<int, num_bp> warmth = {};
+    /** From hoods, collars and pockets, whether they can be used right now or not. */
+    std::array<int, num_bp> bonus_warmth = {};
+    std::array<int, num_bp> wind_resistance = {};
+    std::array<int, num_bp> bonus_wind_resistance = {};
+};
+
 #endif // CATA_SRC_CHARACTER_ENCUMBRANCE_H
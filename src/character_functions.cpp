@@ -286,9 +286,9 @@ comfort_response_t base_comfort_value( const Character &who, const tripoint &p )
                 }
             }
         }
-        if( fungaloid_cosplay && here.has_flag_ter_or_furn( "FUNGUS", p ) ) {
+        if( fungaloid_cosplay && here.has_flag_ter_or_furn( TFLAG_FUNGUS, p ) ) {
             comfort += static_cast<int>( comfort_level::very_comfortable );
-        } else if( watersleep && here.has_flag_ter( "SWIMMABLE", p ) ) {
+        } else if( watersleep && here.has_flag_ter( TFLAG_SWIMMABLE, p ) ) {
             comfort += static_cast<int>( comfort_level::very_comfortable );
         }
     } else if( plantsleep ) {
@@ -364,7 +364,7 @@ int rate_sleep_spot( const Character &who, const tripoint &p )
         // At this point, the only limit to sleep is tiredness
         sleepy += 100;
     }
-    if( watersleep && get_map().has_flag_ter( "SWIMMABLE", p ) ) {
+    if( watersleep && get_map().has_flag_ter( TFLAG_SWIMMABLE, p ) ) {
         sleepy += 10; //comfy water!
     }
 
@@ -273,12 +273,17 @@ void Character::process_turn()
     // SkillLevel::readBook (has no connection to the skill or the player),
     // player::read, player::practice, ...
     // Check for spontaneous discovery of martial art styles
-    for( auto &style : autolearn_martialart_types() ) {
-        const matype_id &ma( style );
-
-        if( !martial_arts_data->has_martialart( ma ) && can_autolearn_martial_art( *this, ma ) ) {
-            martial_arts_data->add_martialart( ma );
-            add_msg_if_player( m_info, _( "You have learned a new style: %s!" ), ma.obj().name );
+    // Skills take hours to rise, once a minute is soon enough to notice
+    if( calendar::once_every( 1_minutes ) ) {
+        for( auto &style : autolearn_martialart_types() ) {
+            const matype_id &ma( style );
+
+            if( !martial_arts_data->has_martialart( ma ) &&
+                can_autolearn_martial_art( *this, ma ) ) {
+                martial_arts_data->add_martialart( ma );
+                add_msg_if_player( m_info, _( "You have learned a new style: %s!" ),
+                                   ma.obj().name );
+            }
         }
     }
 
@@ -353,7 +358,7 @@ void Character::process_one_effect( effect &it, bool is_new )
     };
 
     // Handle miss messages
-    auto msgs = it.get_miss_msgs();
+    const auto &msgs = it.get_miss_msgs();
     if( !msgs.empty() ) {
         for( const auto &i : msgs ) {
             add_miss_reason( _( i.first ), static_cast<unsigned>( i.second ) );
@@ -1031,7 +1036,7 @@ void do_pause( Character &who )
                     bodypart_str_id( "hand_r" )
                 }
             }, true );
-        } else if( here.has_flag( "SWIMMABLE", who.pos() ) ) {
+        } else if( here.has_flag( TFLAG_SWIMMABLE, who.pos() ) ) {
             who.drench( 40, { { bodypart_str_id( "foot_l" ), bodypart_str_id( "foot_r" ), bodypart_str_id( "leg_l" ), bodypart_str_id( "leg_r" ) } },
             false );
         }
@@ -580,6 +580,7 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
 void zone_manager::cache_data()
 {
     area_cache.clear();
+    area_boxes.clear();
 
     for( auto &elem : zones ) {
         if( !elem.get_enabled() ) {
@@ -588,6 +589,7 @@ void zone_manager::cache_data()
 
         const std::string &type_hash = elem.get_type_hash();
         auto &cache = area_cache[type_hash];
+        area_boxes[type_hash].emplace_back( elem.get_start_point(), elem.get_end_point() );
 
         // Draw marked area
         for( const tripoint &p : tripoint_range<tripoint>( elem.get_start_point(),
@@ -600,6 +602,7 @@ void zone_manager::cache_data()
 void zone_manager::cache_vzones()
 {
     vzone_cache.clear();
+    vzone_boxes.clear();
     auto vzones = get_map().get_vehicle_zones( g->get_levz() );
     for( auto elem : vzones ) {
         if( !elem->get_enabled() ) {
@@ -608,6 +611,7 @@ void zone_manager::cache_vzones()
 
         const std::string &type_hash = elem->get_type_hash();
         auto &cache = vzone_cache[type_hash];
+        vzone_boxes[type_hash].emplace_back( elem->get_start_point(), elem->get_end_point() );
 
         // TODO: looks very similar to the above cache_data - maybe merge it?
 
@@ -619,17 +623,33 @@ void zone_manager::cache_vzones()
     }
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
+static const cata::tripoint_set no_points;
+static const std::vector<inclusive_cuboid<tripoint>> no_boxes;
+
+const cata::tripoint_set &zone_manager::get_point_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return no_points;
     }
 
     return type_iter->second;
 }
 
+std::array<const std::vector<inclusive_cuboid<tripoint>> *, 2> zone_manager::get_boxes(
+    const zone_type_id &type, const faction_id &fac ) const
+{
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    const auto area_iter = area_boxes.find( type_hash );
+    const auto vzone_iter = vzone_boxes.find( type_hash );
+    return {{
+            area_iter == area_boxes.end() ? &no_boxes : &area_iter->second,
+            vzone_iter == vzone_boxes.end() ? &no_boxes : &vzone_iter->second
+        }
+    };
+}
+
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
         int radius, const faction_id &fac ) const
 {
@@ -655,13 +675,13 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
+const cata::tripoint_set &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     //Only regenerate the vehicle zone cache if any vehicles have moved
     const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return no_points;
     }
 
     return type_iter->second;
@@ -672,25 +692,16 @@ bool zone_manager::has( const zone_type_id &type, const tripoint &where,
 {
     const auto &point_set = get_point_set( type, fac );
     const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    return point_set.contains( where ) || vzone_set.contains( where );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
+    for( const std::vector<inclusive_cuboid<tripoint>> *boxes : get_boxes( type, fac ) ) {
+        for( const inclusive_cuboid<tripoint> &box : *boxes ) {
+            if( where.z >= box.p_min.z && where.z <= box.p_max.z &&
+                square_dist( clamp( where, box ), where ) <= range ) {
                 return true;
             }
         }
@@ -739,42 +750,40 @@ bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) cons
         return false;
     }
     const loot_options &options = dynamic_cast<const loot_options &>( zone->get_options() );
-    std::string filter_string = options.get_mark();
-    auto z = item_filter_from_string( filter_string );
+    const std::string filter_string = options.get_mark();
+    auto filter = custom_filters.find( filter_string );
+    if( filter == custom_filters.end() ) {
+        filter = custom_filters.emplace( filter_string, item_filter_from_string( filter_string ) ).first;
+    }
 
-    return z( *it );
+    return filter->second( *it );
 }
 
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint>();
 
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
+    for( const std::vector<inclusive_cuboid<tripoint>> *boxes : get_boxes( type, fac ) ) {
+        for( const inclusive_cuboid<tripoint> &box : *boxes ) {
+            if( where.z < box.p_min.z || where.z > box.p_max.z ) {
+                continue;
             }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
+            // Only the part of the zone within range
+            const point from( std::max( box.p_min.x, where.x - range ),
+                              std::max( box.p_min.y, where.y - range ) );
+            const point to( std::min( box.p_max.x, where.x + range ),
+                            std::min( box.p_max.y, where.y + range ) );
+            for( int x = from.x; x <= to.x; x++ ) {
+                for( int y = from.y; y <= to.y; y++ ) {
+                    const tripoint point( x, y, where.z );
+                    if( it && has( zone_LOOT_CUSTOM, point ) ) {
+                        if( custom_loot_has( point, it ) ) {
+                            near_point_set.insert( point );
+                        }
+                    } else {
                         near_point_set.insert( point );
                     }
-                } else {
-                    near_point_set.insert( point );
                 }
             }
         }
@@ -792,26 +801,17 @@ std::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, con
 
     tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    for( const std::vector<inclusive_cuboid<tripoint>> *boxes : get_boxes( type, fac ) ) {
+        for( const inclusive_cuboid<tripoint> &box : *boxes ) {
+            // The closest square of the zone
+            const tripoint p = clamp( where, box );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CLZONES_H
 #define CATA_SRC_CLZONES_H
 
+#include <array>
 #include <cstddef>
 #include <functional>
 #include <map>
@@ -14,9 +15,11 @@
 #include <utility>
 #include <vector>
 
+#include "cuboid_rectangle.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "string_id.h"
+#include "tripoint_map.h"
 #include "type_id.h"
 
 class JsonIn;
@@ -354,12 +357,21 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
+        std::unordered_map<std::string, cata::tripoint_set> area_cache;
+        std::unordered_map<std::string, cata::tripoint_set> vzone_cache;
+        // The same areas as boxes, so queries near a point don't look at every square
+        std::unordered_map<std::string, std::vector<inclusive_cuboid<tripoint>>> area_boxes;
+        std::unordered_map<std::string, std::vector<inclusive_cuboid<tripoint>>> vzone_boxes;
+        const cata::tripoint_set &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
+        const cata::tripoint_set &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
+        /** Boxes of the zones of this type, then those of vehicle zones. */
+        std::array<const std::vector<inclusive_cuboid<tripoint>> *, 2> get_boxes(
+            const zone_type_id &type, const faction_id &fac ) const;
+
+        // Custom loot filters by their text, so they aren't parsed again for every item
+        mutable std::unordered_map<std::string, std::function<bool( const item & )>> custom_filters;
 
         //Cache number of items already checked on each source tile when sorting
         std::unordered_map<tripoint, int> num_processed;
@@ -113,13 +113,13 @@ void conditional_t<T>::set_has_any_trait( const JsonObject &jo, const std::strin
 template<class T>
 void conditional_t<T>::set_has_trait( const JsonObject &jo, const std::string &member, bool is_npc )
 {
-    const std::string &trait_to_check = jo.get_string( member );
+    const trait_id trait_to_check( jo.get_string( member ) );
     condition = [trait_to_check, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        return actor->has_trait( trait_id( trait_to_check ) );
+        return actor->has_trait( trait_to_check );
     };
 }
 
@@ -172,19 +172,19 @@ void conditional_t<T>::set_is_riding( bool is_npc )
 template<class T>
 void conditional_t<T>::set_npc_has_class( const JsonObject &jo )
 {
-    const std::string &class_to_check = jo.get_string( "npc_has_class" );
+    const npc_class_id class_to_check( jo.get_string( "npc_has_class" ) );
     condition = [class_to_check]( const T & d ) {
-        return d.beta->myclass == npc_class_id( class_to_check );
+        return d.beta->myclass == class_to_check;
     };
 }
 
 template<class T>
 void conditional_t<T>::set_u_has_mission( const JsonObject &jo )
 {
-    const std::string &mission = jo.get_string( "u_has_mission" );
+    const mission_type_id mission( jo.get_string( "u_has_mission" ) );
     condition = [mission]( const T & ) {
         for( auto miss_it : g->u.get_active_missions() ) {
-            if( miss_it->mission_id() == mission_type_id( mission ) ) {
+            if( miss_it->mission_id() == mission ) {
                 return true;
             }
         }
@@ -326,16 +326,18 @@ template<class T>
 void conditional_t<T>::set_has_bionics( const JsonObject &jo, const std::string &member,
                                         bool is_npc )
 {
-    const std::string bionics_id = jo.get_string( member );
-    condition = [bionics_id, is_npc]( const T & d ) {
+    const std::string &bionics_id = jo.get_string( member );
+    const bool any_bionic = bionics_id == "ANY";
+    const bionic_id bionic_to_check( any_bionic ? "" : bionics_id );
+    condition = [any_bionic, bionic_to_check, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        if( bionics_id == "ANY" ) {
+        if( any_bionic ) {
             return actor->has_bionics();
         }
-        return actor->has_bionic( bionic_id( bionics_id ) );
+        return actor->has_bionic( bionic_to_check );
     };
 }
 
@@ -343,13 +345,13 @@ template<class T>
 void conditional_t<T>::set_has_effect( const JsonObject &jo, const std::string &member,
                                        bool is_npc )
 {
-    const std::string &effect_id = jo.get_string( member );
+    const efftype_id effect_id( jo.get_string( member ) );
     condition = [effect_id, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        return actor->has_effect( efftype_id( effect_id ) );
+        return actor->has_effect( effect_id );
     };
 }
 
@@ -367,15 +369,22 @@ void conditional_t<T>::set_need( const JsonObject &jo, const std::string &member
             amount = static_cast<int>( flevel->second );
         }
     }
-    condition = [need, amount, is_npc]( const T & d ) {
+    const bool fatigue = need == "fatigue";
+    const bool hunger = need == "hunger";
+    const bool thirst = need == "thirst";
+    condition = [fatigue, hunger, thirst, amount, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        int effective_hunger = ( actor->max_stored_kcal() - actor->get_stored_kcal() ) / 10;
-        return ( actor->get_fatigue() > amount && need == "fatigue" ) ||
-               ( effective_hunger > amount && need == "hunger" ) ||
-               ( actor->get_thirst() > amount && need == "thirst" );
+        if( fatigue ) {
+            return actor->get_fatigue() > amount;
+        } else if( hunger ) {
+            return ( actor->max_stored_kcal() - actor->get_stored_kcal() ) / 10 > amount;
+        } else if( thirst ) {
+            return actor->get_thirst() > amount;
+        }
+        return false;
     };
 }
 
@@ -415,9 +424,24 @@ void conditional_t<T>::set_compare_var( const JsonObject &jo, const std::string
                                         bool is_npc )
 {
     const std::string var_name = get_talk_varname( jo, member, false );
-    const std::string &op = jo.get_string( "op" );
+    static const std::map<std::string, std::function<bool( int, int )>> ops = {
+        { "==", std::equal_to<int>() },
+        { "!=", std::not_equal_to<int>() },
+        { "<=", std::less_equal<int>() },
+        { ">=", std::greater_equal<int>() },
+        { "<", std::less<int>() },
+        { ">", std::greater<int>() }
+    };
+    const auto op = ops.find( jo.get_string( "op" ) );
+    if( op == ops.end() ) {
+        condition = []( const T & ) {
+            return false;
+        };
+        return;
+    }
+    const std::function<bool( int, int )> &compare = op->second;
     const int value = jo.get_int( "value" );
-    condition = [var_name, op, value, is_npc]( const T & d ) {
+    condition = [var_name, compare, value, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
@@ -429,26 +453,7 @@ void conditional_t<T>::set_compare_var( const JsonObject &jo, const std::string
             stored_value = std::stoi( var );
         }
 
-        if( op == "==" ) {
-            return stored_value == value;
-
-        } else if( op == "!=" ) {
-            return stored_value != value;
-
-        } else if( op == "<=" ) {
-            return stored_value <= value;
-
-        } else if( op == ">=" ) {
-            return stored_value >= value;
-
-        } else if( op == "<" ) {
-            return stored_value < value;
-
-        } else if( op == ">" ) {
-            return stored_value > value;
-        }
-
-        return false;
+        return compare( stored_value, value );
     };
 }
 
@@ -867,10 +872,10 @@ void conditional_t<T>::set_has_skill( const JsonObject &jo, const std::string &m
 template<class T>
 void conditional_t<T>::set_u_know_recipe( const JsonObject &jo, const std::string &member )
 {
-    const std::string &known_recipe_id = jo.get_string( member );
+    const recipe_id known_recipe_id( jo.get_string( member ) );
     condition = [known_recipe_id]( const T & d ) {
         player *actor = d.alpha;
-        const recipe &r = recipe_id( known_recipe_id ).obj();
+        const recipe &r = known_recipe_id.obj();
         return actor->knows_recipe( &r );
     };
 }
@@ -1403,6 +1403,7 @@ void construct::done_vehicle( const tripoint &p )
     // Update the vehicle cache immediately,
     // or the vehicle will be invisible for the first couple of turns.
     m.add_vehicle_to_cache( veh );
+    m.set_pathfinding_cache_dirty( veh->global_part_pos3( 0 ) );
 }
 
 void construct::done_deconstruct( const tripoint &p )
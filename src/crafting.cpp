@@ -553,13 +553,25 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     }
     if( cached_moves == moves
         && cached_time == calendar::turn
-        && cached_position == inv_pos ) {
+        && cached_position == inv_pos
+        && cached_radius == radius
+        && cached_clear_path == clear_path ) {
         return cached_crafting_inventory;
     }
     cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
-    cached_crafting_inventory += inv;
-    cached_crafting_inventory += primary_weapon();
-    cached_crafting_inventory += worn;
+    // The map's items are binned by type, so the character's own only have to be
+    // compared with the stacks of their type, not with everything lying around
+    for( const std::vector<item *> *stack : inv.const_slice() ) {
+        for( item *it : *stack ) {
+            cached_crafting_inventory.add_item_by_items_type_cache( *it, true );
+        }
+    }
+    if( !primary_weapon().is_null() ) {
+        cached_crafting_inventory.add_item_by_items_type_cache( primary_weapon() );
+    }
+    for( item *it : worn ) {
+        cached_crafting_inventory.add_item_by_items_type_cache( *it, true );
+    }
     for( const bionic &bio : *my_bionics ) {
         const bionic_data &bio_data = bio.info();
         if( ( !bio_data.activated || bio.powered ) &&
@@ -576,6 +588,8 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     cached_moves = moves;
     cached_time = calendar::turn;
     cached_position = inv_pos;
+    cached_radius = radius;
+    cached_clear_path = clear_path;
     // cache the qualities of the items in cached_crafting_inventory
     cached_crafting_inventory.update_quality_cache();
     return cached_crafting_inventory;
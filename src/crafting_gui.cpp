@@ -136,50 +136,80 @@ void reset_recipe_categories()
 
 namespace
 {
+/**
+ * Whether a recipe can be crafted from the crafting inventory. Only what the recipe list
+ * is sorted by is worked out up front, the rest waits until a row is drawn or selected,
+ * so opening a category with hundreds of recipes doesn't check each of them four times.
+ */
 struct availability {
-    explicit availability( const recipe *r, int batch_size, bool known ) {
-        this->known = known;
+    explicit availability( const recipe *r, int batch_size, bool known ) :
+        r( r ), batch_size( batch_size ), known( known ) {
         const inventory &inv = get_avatar().crafting_inventory();
-        auto all_items_filter = r->get_component_filter( recipe_filter_flags::none );
-        auto no_rotten_filter = r->get_component_filter( recipe_filter_flags::no_rotten );
-        const deduped_requirement_data &req = r->deduped_requirements();
-        could_craft_if_knew = req.can_make_with_inventory(
-                                  inv, all_items_filter, batch_size, cost_adjustment::start_only );
+        could_craft_if_knew = r->deduped_requirements().can_make_with_inventory(
+                                  inv, r->get_component_filter( recipe_filter_flags::none ), batch_size,
+                                  cost_adjustment::start_only );
         can_craft = known && could_craft_if_knew;
-        can_craft_non_rotten = req.can_make_with_inventory(
-                                   inv, no_rotten_filter, batch_size, cost_adjustment::start_only );
-        const requirement_data &simple_req = r->simple_requirements();
-        apparently_craftable = simple_req.can_make_with_inventory(
-                                   inv, all_items_filter, batch_size, cost_adjustment::start_only );
-        has_all_skills = r->skill_used.is_null() ||
-                         get_player_character().get_skill_level( r->skill_used ) >= r->difficulty;
-        for( const std::pair<const skill_id, int> &e : r->required_skills ) {
-            if( get_player_character().get_skill_level( e.first ) < e.second ) {
-                has_all_skills = false;
-                break;
+    }
+    const recipe *r;
+    int batch_size;
+    bool known;
+    bool could_craft_if_knew;
+    bool can_craft;
+
+    bool can_craft_non_rotten() const {
+        if( !cached_can_craft_non_rotten ) {
+            cached_can_craft_non_rotten = could_craft_if_knew &&
+                                          r->deduped_requirements().can_make_with_inventory(
+                                              get_avatar().crafting_inventory(),
+                                              r->get_component_filter( recipe_filter_flags::no_rotten ),
+                                              batch_size, cost_adjustment::start_only );
+        }
+        return *cached_can_craft_non_rotten;
+    }
+
+    bool apparently_craftable() const {
+        if( !cached_apparently_craftable ) {
+            cached_apparently_craftable = r->simple_requirements().can_make_with_inventory(
+                                              get_avatar().crafting_inventory(),
+                                              r->get_component_filter( recipe_filter_flags::none ),
+                                              batch_size, cost_adjustment::start_only );
+        }
+        return *cached_apparently_craftable;
+    }
+
+    bool has_all_skills() const {
+        if( !cached_has_all_skills ) {
+            const Character &you = get_player_character();
+            bool has_all = r->skill_used.is_null() ||
+                           you.get_skill_level( r->skill_used ) >= r->difficulty;
+            for( const std::pair<const skill_id, int> &e : r->required_skills ) {
+                if( you.get_skill_level( e.first ) < e.second ) {
+                    has_all = false;
+                    break;
+                }
             }
+            cached_has_all_skills = has_all;
         }
+        return *cached_has_all_skills;
     }
-    bool can_craft;
-    bool can_craft_non_rotten;
-    bool could_craft_if_knew;
-    bool apparently_craftable;
-    bool has_all_skills;
-    bool known;
 
     nc_color selected_color() const {
         return can_craft
-               ? ( can_craft_non_rotten && has_all_skills ? h_white : h_brown )
-               : ( could_craft_if_knew && has_all_skills ? h_yellow : h_dark_gray );
+               ? ( can_craft_non_rotten() && has_all_skills() ? h_white : h_brown )
+               : ( could_craft_if_knew && has_all_skills() ? h_yellow : h_dark_gray );
     }
 
     nc_color color( bool ignore_missing_skills = false ) const {
         return can_craft
-               ? ( ( can_craft_non_rotten && has_all_skills ) || ignore_missing_skills ? c_white : c_yellow )
-               : ( ( could_craft_if_knew && has_all_skills ) ||
+               ? ( ( can_craft_non_rotten() && has_all_skills() ) || ignore_missing_skills ? c_white :
+                   c_yellow )
+               : ( ( could_craft_if_knew && has_all_skills() ) ||
                    ignore_missing_skills ? c_light_gray : c_dark_gray );
     }
 
+    mutable std::optional<bool> cached_can_craft_non_rotten;
+    mutable std::optional<bool> cached_apparently_craftable;
+    mutable std::optional<bool> cached_has_all_skills;
 };
 } // namespace
 
@@ -234,7 +264,7 @@ static std::vector<std::string> recipe_info(
     oss << string_format( _( "Nearby: %s\n" ), nearby_string );
 
     const bool can_craft_this = avail.can_craft;
-    if( can_craft_this && !avail.can_craft_non_rotten ) {
+    if( can_craft_this && !avail.can_craft_non_rotten() ) {
         oss << _( "<color_red>Will use rotten ingredients</color>\n" );
     }
     const bool too_complex = recp.deduped_requirements().is_too_complex();
@@ -243,7 +273,7 @@ static std::vector<std::string> recipe_info(
                   "recipe <color_yellow>may appear to be craftable "
                   "when it is not</color>.\n" );
     }
-    if( !can_craft_this && avail.apparently_craftable && avail.known ) {
+    if( !can_craft_this && avail.known && avail.apparently_craftable() ) {
         oss << _( "<color_red>Cannot be crafted because the same item is needed "
                   "for multiple components</color>\n" );
     }
@@ -465,7 +495,9 @@ const recipe *select_crafting_recipe( int &batch_size_out )
     list_circularizer<std::string> tab( craft_cat_list );
     list_circularizer<std::string> subtab( craft_subcat_list[tab.cur()] );
     std::vector<const recipe *> current;
-    std::vector<availability> available;
+    // Rows of the list, pointing into availability_cache or, in batch mode, batch_available
+    std::vector<const availability *> available;
+    std::vector<availability> batch_available;
     int line = 0;
     bool recalc = true;
     bool keepline = false;
@@ -537,7 +569,7 @@ const recipe *select_crafting_recipe( int &batch_size_out )
             }
             const point print_from( 2, i - recipe_scroll_window_min );
             const bool highlight = i == line;
-            const nc_color col = highlight ? available[i].selected_color() : available[i].color();
+            const nc_color col = highlight ? available[i]->selected_color() : available[i]->color();
             if( highlight ) {
                 ui.set_cursor( w_data, print_from );
             }
@@ -551,7 +583,7 @@ const recipe *select_crafting_recipe( int &batch_size_out )
             draw_can_craft_indicator( w_head, recp );
             wnoutrefresh( w_head );
 
-            const availability &avail = available[line];
+            const availability &avail = *available[line];
             // border + padding + name + padding
             const int xpos = 1 + 1 + max_recipe_name_width + 3;
             const int fold_width = FULL_SCREEN_WIDTH - xpos - 2;
@@ -615,10 +647,13 @@ const recipe *select_crafting_recipe( int &batch_size_out )
 
             if( batch ) {
                 current.clear();
+                batch_available.clear();
+                batch_available.reserve( 50 );
                 for( int i = 1; i <= 50; i++ ) {
                     current.push_back( chosen );
-                    available.emplace_back( chosen, i,
-                                            !show_unavailable || available_recipes.contains( *chosen ) );
+                    batch_available.emplace_back( chosen, i,
+                                                  !show_unavailable || available_recipes.contains( *chosen ) );
+                    available.push_back( &batch_available.back() );
                 }
             } else {
                 std::vector<const recipe *> picking;
@@ -738,7 +773,7 @@ const recipe *select_crafting_recipe( int &batch_size_out )
 
                 std::transform( current.begin(), current.end(),
                 std::back_inserter( available ), [&]( const recipe * e ) {
-                    return availability_cache.at( e );
+                    return &availability_cache.at( e );
                 } );
             }
 
@@ -794,7 +829,7 @@ const recipe *select_crafting_recipe( int &batch_size_out )
         } else if( action == "UP" ) {
             line--;
         } else if( action == "CONFIRM" ) {
-            if( available.empty() || !available[line].can_craft ) {
+            if( available.empty() || !available[line]->can_craft ) {
                 popup( _( "You can't do that!  Press [<color_yellow>ESC</color>]!" ) );
             } else if( !u.check_eligible_containers_for_crafting( *current[line],
                        ( batch ) ? line + 1 : 1 ) ) {
@@ -164,6 +164,7 @@ Creature::Creature( const Creature &source )
             placed.first->second.wielding.wielded = item::spawn( *bp.second.wielding.wielded );
         }
     }
+    index_body();
 }
 
 Creature::~Creature() = default;
@@ -1713,28 +1714,47 @@ void Creature::set_body()
                                                  new wield_item_location( this ) ) );
         }
     }
+    index_body();
+}
+
+void Creature::remove_body_part( const bodypart_id &id )
+{
+    body.erase( id.id() );
+    index_body();
+}
+
+void Creature::index_body()
+{
+    body_index.clear();
+    for( std::pair<const bodypart_str_id, bodypart> &elem : body ) {
+        const size_t index = bodypart_id( elem.first ).to_i();
+        if( index >= body_index.size() ) {
+            body_index.resize( index + 1, nullptr );
+        }
+        body_index[index] = &elem.second;
+    }
 }
 
 bodypart &Creature::get_part( const bodypart_id &id )
 {
-    auto found = body.find( id.id() );
-    if( found == body.end() ) {
+    const size_t index = id.to_i();
+    if( index >= body_index.size() || body_index[index] == nullptr ) {
         debugmsg( "Could not find bodypart %s in %s's body", id.id().c_str(), get_name() );
         static bodypart nullpart( new fake_item_location() );
         return nullpart;
     }
-    return found->second;
+    return *body_index[index];
 }
 
 const bodypart &Creature::get_part( const bodypart_id &id ) const
 {
-    auto found = body.find( id.id() );
-    if( found == body.end() ) {
+    const size_t index = id.to_i();
+    if( index >= body_index.size() || body_index[index] == nullptr ) {
         debugmsg( "Could not find bodypart %s in %s's body", id.id().c_str(), get_name() );
         static const bodypart nullpart( new fake_item_location() );
         return nullpart;
     }
-    return found->second;
+    return *body_index[index];
 }
 
 int Creature::get_part_hp_cur( const bodypart_id &id ) const
@@ -619,6 +619,9 @@ class Creature
         anatomy_id creature_anatomy = anatomy_id( "default_anatomy" );
         /**this is the actual body of the creature*/
         std::map<bodypart_str_id, bodypart> body;
+        /** Parts of @ref body by bodypart_id::to_i(), null for the ones this body lacks. */
+        std::vector<bodypart *> body_index;
+        void index_body();
     public:
         anatomy_id get_anatomy() const;
         void set_anatomy( anatomy_id anat );
@@ -630,9 +633,11 @@ class Creature
          */
         std::vector<bodypart_id> get_all_body_parts( bool only_main = false ) const;
 
+        /** Parts can be changed through this, but only added or removed by the functions below. */
         std::map<bodypart_str_id, bodypart> &get_body();
         const std::map<bodypart_str_id, bodypart> &get_body() const;
         void set_body();
+        void remove_body_part( const bodypart_id &id );
         bodypart &get_part( const bodypart_id &id );
         const bodypart &get_part( const bodypart_id &id ) const;
 
@@ -7,6 +7,9 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
+#include "monfaction.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -16,6 +19,12 @@
 
 #define dbg(x) DebugLogFL((x),DC::Game)
 
+static tripoint bucket_of( const tripoint &pos )
+{
+    return tripoint( divide_round_to_minus_infinity( pos.x, SEEX ),
+                     divide_round_to_minus_infinity( pos.y, SEEY ), pos.z );
+}
+
 Creature_tracker::Creature_tracker() = default;
 
 Creature_tracker::~Creature_tracker() = default;
@@ -32,6 +41,107 @@ shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
     return nullptr;
 }
 
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_rect( const tripoint &min,
+                                      const tripoint &max ) const
+{
+    std::vector<shared_ptr_fast<monster>> ret;
+    const tripoint bucket_min = bucket_of( min );
+    const tripoint bucket_max = bucket_of( max );
+    for( int z = std::max( min.z, -OVERMAP_DEPTH ); z <= std::min( max.z, OVERMAP_HEIGHT ); z++ ) {
+        for( int x = bucket_min.x; x <= bucket_max.x; x++ ) {
+            for( int y = bucket_min.y; y <= bucket_max.y; y++ ) {
+                const auto bucket = locations_by_bucket.find( tripoint( x, y, z ) );
+                if( bucket == locations_by_bucket.end() ) {
+                    continue;
+                }
+                for( const tripoint &pos : bucket->second ) {
+                    if( pos.x < min.x || pos.x > max.x || pos.y < min.y || pos.y > max.y ) {
+                        continue;
+                    }
+                    const shared_ptr_fast<monster> &mon_ptr = monsters_by_location.at( pos );
+                    if( !mon_ptr->is_dead() ) {
+                        ret.push_back( mon_ptr );
+                    }
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_radius( const tripoint &center,
+                                   const int radius ) const
+{
+    // No distance rl_dist measures is shorter than the square one
+    std::vector<shared_ptr_fast<monster>> ret = find_in_rect( center - tripoint( radius, radius,
+                                       radius ), center + tripoint( radius, radius, radius ) );
+    ret.erase( std::remove_if( ret.begin(), ret.end(), [&]( const shared_ptr_fast<monster> &mon_ptr ) {
+        return rl_dist( center, mon_ptr->pos() ) > radius;
+    } ), ret.end() );
+    return ret;
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_hostiles_in_rect(
+                                       const mfaction_id &faction, const tripoint &min, const tripoint &max ) const
+{
+    static const mfaction_str_id playerfaction( "player" );
+    std::vector<shared_ptr_fast<monster>> ret = find_in_rect( min, max );
+    ret.erase( std::remove_if( ret.begin(), ret.end(), [&]( const shared_ptr_fast<monster> &mon_ptr ) {
+        // Same faction as add_to_faction_map files them under
+        const mfaction_id listed = mon_ptr->friendly == 0 ? mon_ptr->faction : playerfaction.id();
+        const mf_attitude att = attitude( faction, listed );
+        return att == MFA_NEUTRAL || att == MFA_FRIENDLY;
+    } ), ret.end() );
+    return ret;
+}
+
+mf_attitude Creature_tracker::attitude( const mfaction_id &from, const mfaction_id &to ) const
+{
+    const std::uint64_t key = static_cast<std::uint64_t>( static_cast<std::uint32_t>( from.to_i() ) ) << 32 |
+                              static_cast<std::uint32_t>( to.to_i() );
+    const auto found = attitudes.find( key );
+    if( found != attitudes.end() ) {
+        return found->second;
+    }
+    const mf_attitude att = from.obj().attitude( to );
+    attitudes.emplace( key, att );
+    return att;
+}
+
+void Creature_tracker::forget_attitudes()
+{
+    attitudes.clear();
+}
+
+void Creature_tracker::set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() ) {
+        // Same key, the bucket already lists it
+        iter->second = critter;
+        return;
+    }
+    monsters_by_location.emplace( pos, critter );
+    locations_by_bucket[bucket_of( pos )].push_back( pos );
+}
+
+void Creature_tracker::erase_location( cata::tripoint_map<shared_ptr_fast<monster>>::iterator iter )
+{
+    const auto bucket = locations_by_bucket.find( bucket_of( iter->first ) );
+    if( bucket != locations_by_bucket.end() ) {
+        std::vector<tripoint> &locations = bucket->second;
+        const auto found = std::find( locations.begin(), locations.end(), iter->first );
+        if( found != locations.end() ) {
+            *found = locations.back();
+            locations.pop_back();
+        }
+        if( locations.empty() ) {
+            locations_by_bucket.erase( bucket );
+        }
+    }
+    monsters_by_location.erase( iter );
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -86,7 +196,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +274,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -184,7 +297,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -195,7 +308,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
     }
 }
 
@@ -228,16 +341,19 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    locations_by_bucket.clear();
     monster_faction_map_.clear();
     removed_.clear();
+    attitudes.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    locations_by_bucket.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +372,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +388,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -3,6 +3,7 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -10,11 +11,13 @@
 
 #include "memory_fast.h"
 #include "point.h"
+#include "tripoint_map.h"
 #include "type_id.h"
 
 class JsonIn;
 class JsonOut;
 class monster;
+enum mf_attitude : int;
 
 class Creature_tracker
 {
@@ -49,6 +52,23 @@ class Creature_tracker
          * Dead monsters are ignored and not returned.
          */
         shared_ptr_fast<monster> find( const tripoint &pos ) const;
+        /**
+         * Returns the living monsters in the box from @p min to @p max, both included.
+         * Only looks through the submap sized buckets the box overlaps.
+         */
+        std::vector<shared_ptr_fast<monster>> find_in_rect( const tripoint &min,
+                                           const tripoint &max ) const;
+        /** Returns the living monsters within @p radius (as of @ref rl_dist) of @p center. */
+        std::vector<shared_ptr_fast<monster>> find_in_radius( const tripoint &center, int radius ) const;
+        /**
+         * Returns the living monsters in the box from @p min to @p max that @p faction is
+         * hostile to, by the factions they are listed under in @ref factions.
+         */
+        std::vector<shared_ptr_fast<monster>> find_hostiles_in_rect( const mfaction_id &faction,
+                                           const tripoint &min, const tripoint &max ) const;
+        /** Attitude of faction @p from to faction @p to, remembered until @ref forget_attitudes. */
+        mf_attitude attitude( const mfaction_id &from, const mfaction_id &to ) const;
+        void forget_attitudes();
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -95,9 +115,16 @@ class Creature_tracker
 
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
-        std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        cata::tripoint_map<shared_ptr_fast<monster>> monsters_by_location;
+        /** Keys of @ref monsters_by_location, bucketed by the submap they are on. */
+        cata::tripoint_map<std::vector<tripoint>> locations_by_bucket;
+        /** Looked up faction attitudes, keyed by both faction ids. */
+        mutable std::unordered_map<std::uint64_t, mf_attitude> attitudes;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** These change @ref monsters_by_location and keep @ref locations_by_bucket in step with it. */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        void erase_location( cata::tripoint_map<shared_ptr_fast<monster>>::iterator iter );
 };
 
 #endif // CATA_SRC_CREATURE_TRACKER_H
@@ -45,6 +45,7 @@
 #include "enums.h"
 #include "faction.h"
 #include "filesystem.h"
+#include "fstream_utils.h"
 #include "game.h"
 #include "game_constants.h"
 #include "game_inventory.h"
@@ -55,14 +56,17 @@
 #include "json.h"
 #include "json_export.h"
 #include "language.h"
+#include "lua_stats.h"
 #include "magic.h"
 #include "map.h"
 #include "map_extras.h"
 #include "map_iterator.h"
 #include "mapgen.h"
+#include "mapgen_stats.h"
 #include "mapgendata.h"
 #include "martialarts.h"
 #include "memory_fast.h"
+#include "memory_stats.h"
 #include "messages.h"
 #include "mission.h"
 #include "monster.h"
@@ -77,6 +81,9 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
+#include "pathfinding.h"
+#include "pathfinding_stats.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -92,6 +99,7 @@
 #include "string_utils.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_stats.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -190,6 +198,11 @@ enum debug_menu_index {
     DEBUG_NESTED_MAPGEN,
     DEBUG_RESET_IGNORED_MESSAGES,
     DEBUG_RELOAD_TILES,
+    DEBUG_PATHFINDING_STATS,
+    DEBUG_MAPGEN_STATS,
+    DEBUG_LUA_STATS,
+    DEBUG_TURN_STATS,
+    DEBUG_MEMORY_STATS,
 };
 
 class mission_debug
@@ -243,6 +256,11 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
             { uilist_entry( DEBUG_RELOAD_TRANSLATIONS, true, 'L', _( "Reload translations" ) ) },
             { uilist_entry( DEBUG_DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
+            { uilist_entry( DEBUG_PATHFINDING_STATS, true, 'P', _( "Show pathfinding statistics" ) ) },
+            { uilist_entry( DEBUG_MAPGEN_STATS, true, 'g', _( "Show mapgen statistics" ) ) },
+            { uilist_entry( DEBUG_LUA_STATS, true, 'x', _( "Show Lua statistics" ) ) },
+            { uilist_entry( DEBUG_TURN_STATS, true, 'X', _( "Show turn timing statistics" ) ) },
+            { uilist_entry( DEBUG_MEMORY_STATS, true, 'Y', _( "Show memory usage" ) ) },
             { uilist_entry( DEBUG_PRINT_FACTION_INFO, true, 'f', _( "Print faction info to console" ) ) },
             { uilist_entry( DEBUG_PRINT_NPC_MAGIC, true, 'M', _( "Print NPC magic info to console" ) ) },
             { uilist_entry( DEBUG_TEST_WEATHER, true, 'W', _( "Test weather" ) ) },
@@ -679,6 +697,7 @@ void character_edit_menu( Character &c )
             if( to_wear.is_armor() ) {
                 p.worn.push_back( to_wear.detach() );
                 p.on_item_wear( to_wear );
+                p.reset_encumbrance();
             } else if( !to_wear.is_null() ) {
                 p.set_primary_weapon( to_wear.detach() );
             }
@@ -1446,6 +1465,7 @@ void debug()
                     }
                 }
             }
+            overmap_buffer.invalidate_travel_paths();
             add_msg( m_good, _( "Current overmap revealed." ) );
         }
         break;
@@ -1493,6 +1513,21 @@ void debug()
                        MonsterGenerator::generator().m_flag_usage_stats.end(), 0 );
             popup_top( "Monster flag usage statistics were dumped to debug.log and cleared." );
 
+            map &here = get_map();
+            const auto report_memo = []( const char *name, line_memo & memo ) {
+                DebugLog( DL::Info, DC::Main ) << name << " cache: " << memo.hits() << " hits, " <<
+                                               memo.misses() << " misses";
+                add_msg( m_info, "%s cache: %d hits, %d misses", name, memo.hits(), memo.misses() );
+                memo.reset_stats();
+            };
+            report_memo( "Line of sight", here.get_sees_cache() );
+            report_memo( "Clear path", here.get_clear_path_cache() );
+            route_memo &routes = here.get_route_cache( u.posz() );
+            add_msg( m_info, "Route cache: %d hits, %d misses", routes.hits(), routes.misses() );
+            DebugLog( DL::Info, DC::Main ) << "Route cache: " << routes.hits() << " hits, " <<
+                                           routes.misses() << " misses";
+            routes.reset_stats();
+
             std::string s = _( "Location %d:%d in %d:%d, %s\n" );
             s += _( "Current turn: %d.\n%s\n" );
             s += vgettext( "%d creature exists.\n", "%d creatures exist.\n", g->num_creatures() );
@@ -2031,6 +2066,78 @@ void debug()
         case DEBUG_DISPLAY_NPC_PATH:
             g->debug_pathfinding = !g->debug_pathfinding;
             break;
+        case DEBUG_PATHFINDING_STATS: {
+            const std::string report = pathfinding_stats::report();
+            if( report.empty() ) {
+                popup_top( "No route searches since the statistics were last reset." );
+                break;
+            }
+            DebugLog( DL::Info, DC::Main ) << "Pathfinding statistics:\n" << report;
+            if( query_yn( "%s\nReset pathfinding statistics?", report ) ) {
+                pathfinding_stats::reset();
+            }
+            break;
+        }
+        case DEBUG_MAPGEN_STATS: {
+            const std::string report = mapgen_stats::report( 20 );
+            if( report.empty() ) {
+                popup_top( "No map generation since the statistics were last reset." );
+                break;
+            }
+            DebugLog( DL::Info, DC::Main ) << "Mapgen statistics:\n" <<
+                                           mapgen_stats::report( std::numeric_limits<int>::max() );
+            if( query_yn( "%s\nWrite all of them to mapgen_stats.csv?", report ) ) {
+                const std::string path = PATH_INFO::config_dir() + "mapgen_stats.csv";
+                if( write_to_file( path, [&]( std::ostream & fout ) {
+                fout << mapgen_stats::csv();
+                }, _( "mapgen statistics" ) ) ) {
+                    popup( "Wrote %s", path );
+                }
+            }
+            if( query_yn( "Reset mapgen statistics?" ) ) {
+                mapgen_stats::reset();
+            }
+            break;
+        }
+        case DEBUG_LUA_STATS: {
+            const std::string report = lua_stats::report( 20 );
+            if( report.empty() ) {
+                popup_top( "No Lua functions ran since the statistics were last reset." );
+                break;
+            }
+            DebugLog( DL::Info, DC::Main ) << "Lua statistics:\n" <<
+                                           lua_stats::report( std::numeric_limits<int>::max() );
+            if( query_yn( "%s\nWrite all of them to lua_stats.csv?", report ) ) {
+                const std::string path = PATH_INFO::config_dir() + "lua_stats.csv";
+                if( write_to_file( path, [&]( std::ostream & fout ) {
+                fout << lua_stats::csv();
+                }, _( "Lua statistics" ) ) ) {
+                    popup( "Wrote %s", path );
+                }
+            }
+            if( query_yn( "Reset Lua statistics?" ) ) {
+                lua_stats::reset();
+            }
+            break;
+        }
+        case DEBUG_TURN_STATS: {
+            const std::string report = turn_stats::report();
+            if( report.empty() ) {
+                popup_top( "No turns passed since the statistics were last reset." );
+                break;
+            }
+            DebugLog( DL::Info, DC::Main ) << "Turn timing statistics:\n" << report;
+            if( query_yn( "%s\nReset turn timing statistics?", report ) ) {
+                turn_stats::reset();
+            }
+            break;
+        }
+        case DEBUG_MEMORY_STATS: {
+            const std::string report = memory_stats::report();
+            DebugLog( DL::Info, DC::Main ) << "Memory usage:\n" << report;
+            popup_top( "%s", report );
+            break;
+        }
         case DEBUG_PRINT_FACTION_INFO: {
             int count = 0;
             for( const auto &elem : g->faction_manager_ptr->all() ) {
@@ -13,6 +13,7 @@
 #include "submap.h"
 #include "options.h"
 #include "overmapbuffer.h"
+#include "simulation_area.h"
 
 static distribution_grid empty_grid( {}, MAPBUFFER );
 
@@ -31,6 +32,9 @@ distribution_grid::distribution_grid( const std::vector<tripoint_abs_sm> &global
         for( auto &active : sm->active_furniture ) {
             const tripoint_abs_ms abs_pos = project_combine( sm_coord, active.first );
             contents[sm_coord].emplace_back( active.first, abs_pos );
+            if( !active.second || active.second->needs_updates() ) {
+                contents_requiring_updates[sm_coord].emplace_back( active.first, abs_pos );
+            }
             flat_contents.emplace_back( abs_pos );
         }
     }
@@ -41,6 +45,11 @@ bool distribution_grid::empty() const
     return contents.empty();
 }
 
+bool distribution_grid::requires_updates() const
+{
+    return !contents_requiring_updates.empty();
+}
+
 distribution_grid::operator bool() const
 {
     return !empty() && !submap_coords.empty();
@@ -48,7 +57,7 @@ distribution_grid::operator bool() const
 
 void distribution_grid::update( time_point to )
 {
-    for( const auto &c : contents ) {
+    for( const auto &c : contents_requiring_updates ) {
         submap *sm = mb.lookup_submap( c.first );
         if( sm == nullptr ) {
             return;
@@ -59,6 +68,7 @@ void distribution_grid::update( time_point to )
             if( !active ) {
                 debugmsg( "No active furniture at %s", loc.absolute.to_string() );
                 contents.clear();
+                contents_requiring_updates.clear();
                 return;
             }
             active->update( to, loc.absolute, *this );
@@ -207,7 +217,7 @@ distribution_grid &distribution_grid_tracker::make_distribution_grid_at(
         }
     }
 
-    if( !dist_grid->empty() ) {
+    if( dist_grid->requires_updates() ) {
         grids_requiring_updates.emplace( dist_grid );
     }
 
@@ -229,13 +239,42 @@ void distribution_grid_tracker::on_saved()
     tripoint_abs_sm min_bounds( bounds.p_min, -OVERMAP_DEPTH );
     tripoint_abs_sm max_bounds( bounds.p_max, OVERMAP_HEIGHT );
     tripoint_range<tripoint_abs_sm> bounds_range( min_bounds, max_bounds );
-    // Remove all grids that are no longer in the bounds
+    simulation_areas &areas = get_simulation_areas();
+    for( const simulation_area &area : areas.get_all() ) {
+        for( const tripoint_abs_sm &sm_pos : area.submaps() ) {
+            if( !parent_distribution_grids.contains( sm_pos ) ) {
+                make_distribution_grid_at( sm_pos );
+            }
+        }
+    }
+    // Areas the bubble covers again, or whose grids stopped doing anything
+    areas.remove_if( [&]( const simulation_area & area ) {
+        bool inside = true;
+        bool running = false;
+        for( const tripoint_abs_sm &sm_pos : area.submaps() ) {
+            inside &= bounds_range.is_point_inside( sm_pos );
+            const auto iter = parent_distribution_grids.find( sm_pos );
+            running |= iter != parent_distribution_grids.end() &&
+                       grids_requiring_updates.contains( iter->second );
+        }
+        return inside || !running;
+    } );
+    const auto keeps_running = [&]( const tripoint_abs_sm & sm_pos,
+    const distribution_grid & grid ) {
+        if( areas.contains( sm_pos ) ) {
+            return true;
+        }
+        const tripoint_abs_omt omt_pos = project_to<coords::omt>( sm_pos );
+        return grid.requires_updates() && areas.add( overmap_buffer.electric_grid_at( omt_pos ) );
+    };
+    // Remove all grids that are no longer in the bounds, unless they keep running remotely
     for( auto iter = parent_distribution_grids.begin(); iter != parent_distribution_grids.end(); ) {
-        if( !bounds_range.is_point_inside( iter->first ) ) {
+        if( bounds_range.is_point_inside( iter->first ) ||
+            keeps_running( iter->first, *iter->second ) ) {
+            ++iter;
+        } else {
             grids_requiring_updates.erase( iter->second );
             iter = parent_distribution_grids.erase( iter );
-        } else {
-            ++iter;
         }
     }
     for( const tripoint_abs_sm &sm_pos : bounds_range ) {
@@ -256,6 +295,12 @@ void distribution_grid_tracker::on_changed( const tripoint_abs_ms &p )
     }
 }
 
+bool distribution_grid_tracker::uses_submap( const tripoint_abs_sm &p ) const
+{
+    const auto iter = parent_distribution_grids.find( p );
+    return iter != parent_distribution_grids.end() && !iter->second->empty();
+}
+
 void distribution_grid_tracker::on_options_changed()
 {
     on_saved();
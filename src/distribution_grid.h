@@ -43,6 +43,8 @@ class distribution_grid
          * that contain an active tile.
          */
         std::map<tripoint_abs_sm, std::vector<tile_location>> contents;
+        // The part of the above that needs to be updated every turn, see active_tile_data::needs_updates
+        std::map<tripoint_abs_sm, std::vector<tile_location>> contents_requiring_updates;
         std::vector<tripoint_abs_ms> flat_contents;
         std::vector<tripoint_abs_sm> submap_coords;
 
@@ -53,6 +55,7 @@ class distribution_grid
     public:
         distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords, mapbuffer &buffer );
         bool empty() const;
+        bool requires_updates() const;
         explicit operator bool() const;
         void update( time_point to );
         int mod_resource( int amt, bool recurse = true );
@@ -175,6 +178,11 @@ class distribution_grid_tracker
          * Updates grid at given global map square coordinate.
          */
         void on_changed( const tripoint_abs_ms &p );
+        /**
+         * Whether a grid with active tiles covers given submap, so it can't be
+         * dropped from the @ref mapbuffer.
+         */
+        bool uses_submap( const tripoint_abs_sm &p ) const;
         void on_saved();
         void on_options_changed();
 };
@@ -1,7 +1,6 @@
 #include "editmap.h"
 
 #include <cstdlib>
-#include <cstring>
 #include <exception>
 #include <iosfwd>
 #include <map>
@@ -2157,7 +2156,7 @@ void editmap::cleartmpmap( tinymap &tmpmap )
     }
 
     auto &ch = tmpmap.get_cache( target.z );
-    std::memset( ch.veh_exists_at, 0, sizeof( ch.veh_exists_at ) );
+    ch.veh_exists_at.reset();
     ch.veh_cached_parts.clear();
     ch.vehicle_list.clear();
     ch.zone_vehicles.clear();
@@ -507,6 +507,10 @@ bool effect_type::is_permanent() const
 {
     return permanent;
 }
+bool effect_type::has_mod( const std::string &type ) const
+{
+    return mod_types.contains( type );
+}
 bool effect_type::is_show_in_info() const
 {
     return show_in_info;
@@ -925,6 +929,9 @@ std::vector<efftype_id> effect::get_blocks_effects() const
 
 int effect::get_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -957,6 +964,9 @@ int effect::get_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -989,6 +999,9 @@ int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_amount( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     int intensity_capped = eff_type->max_effective_intensity > 0 ? std::min(
                                eff_type->max_effective_intensity, intensity ) : intensity;
     auto &mod_data = eff_type->mod_data;
@@ -1006,6 +1019,9 @@ int effect::get_amount( const std::string &arg, bool reduced ) const
 
 int effect::get_min_val( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double ret = 0;
     auto found = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "min_val" ) );
@@ -1021,6 +1037,9 @@ int effect::get_min_val( const std::string &arg, bool reduced ) const
 
 int effect::get_max_val( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double ret = 0;
     auto found = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "max_val" ) );
@@ -1046,6 +1065,10 @@ bool effect::get_sizing( const std::string &arg ) const
 
 double effect::get_percentage( const std::string &arg, int val, bool reduced ) const
 {
+    // Without a chance a valueless effect never triggers
+    if( val == 0 && !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     auto found_top_base = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "chance_top" ) );
     auto found_top_scale = mod_data.find( std::make_tuple( "scaling_mods", reduced, arg,
@@ -1124,6 +1147,10 @@ double effect::get_percentage( const std::string &arg, int val, bool reduced ) c
 bool effect::activated( const time_point &when, const std::string &arg, int val, bool reduced,
                         double mod ) const
 {
+    // Without a chance a valueless effect never triggers
+    if( val == 0 && !eff_type->has_mod( arg ) ) {
+        return false;
+    }
     auto &mod_data = eff_type->mod_data;
     auto found_top_base = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "chance_top" ) );
     auto found_top_scale = mod_data.find( std::make_tuple( "scaling_mods", reduced, arg,
@@ -1229,7 +1256,7 @@ int effect::get_int_add_val() const
     return eff_type->int_add_val;
 }
 
-std::vector<std::pair<std::string, int>> effect::get_miss_msgs() const
+const std::vector<std::pair<std::string, int>> &effect::get_miss_msgs() const
 {
     return eff_type->miss_msgs;
 }
@@ -1380,6 +1407,9 @@ void load_effect_type( const JsonObject &jo )
 
     new_etype.load_mod_data( jo, "base_mods" );
     new_etype.load_mod_data( jo, "scaling_mods" );
+    for( const auto &mod : new_etype.mod_data ) {
+        new_etype.mod_types.insert( std::get<2>( mod.first ) );
+    }
 
     new_etype.impairs_movement = hardcoded_movement_impairing.contains( new_etype.id );
 
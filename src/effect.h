@@ -6,6 +6,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -135,6 +136,9 @@ class effect_type
         /** Returns true if an effect is permanent, i.e. it's duration does not decrease over time. */
         bool is_permanent() const;
 
+        /** Returns true if any of the mods has a value for the type of mod, e.g. "PAIN". */
+        bool has_mod( const std::string &type ) const;
+
         /** Loading helper functions */
         bool load_mod_data( const JsonObject &jo, const std::string &member );
         bool load_miss_msgs( const JsonObject &jo, const std::string &member );
@@ -213,6 +217,8 @@ class effect_type
         /** Key tuple order is:("base_mods"/"scaling_mods", reduced: bool, type of mod: "STR", desired argument: "tick") */
         std::unordered_map <
         std::tuple<std::string, bool, std::string, std::string>, double, cata::tuple_hash > mod_data;
+        /** The types of mod in @ref mod_data, most effects only have a few of them. */
+        std::unordered_set<std::string> mod_types;
 };
 
 class effect
@@ -351,7 +357,7 @@ class effect
         int get_int_add_val() const;
 
         /** Returns a vector of the miss message messages and chances for use in add_miss_reason() while the effect is in effect. */
-        std::vector<std::pair<std::string, int>> get_miss_msgs() const;
+        const std::vector<std::pair<std::string, int>> &get_miss_msgs() const;
 
         /** Returns the value used for display on the speed modifier window in the player status menu. */
         std::string get_speed_name() const;
@@ -40,6 +40,11 @@ void event_bus::subscribe( event_subscriber *s )
 {
     if( get_option<bool>( "ENABLE_EVENTS" ) ) {
         subscribers.push_back( s );
+        for( size_t type = 0; type < subscribers_by_type.size(); type++ ) {
+            if( s->wants( static_cast<event_type>( type ) ) ) {
+                subscribers_by_type[type].push_back( s );
+            }
+        }
         s->on_subscribe( this );
     }
 }
@@ -52,12 +57,15 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &of_type : subscribers_by_type ) {
+            of_type.erase( std::remove( of_type.begin(), of_type.end(), s ), of_type.end() );
+        }
     }
 }
 
 void event_bus::send( const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_by_type[static_cast<size_t>( e.type() )] ) {
         s->notify( e );
     }
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EVENT_BUS_H
 #define CATA_SRC_EVENT_BUS_H
 
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,13 @@ class event_subscriber
         event_subscriber &operator=( const event_subscriber & ) = delete;
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
+        /**
+         * Whether @ref notify does anything with events of this type, asked once for every
+         * type when subscribing. Events of other types are not sent to this subscriber.
+         */
+        virtual bool wants( event_type ) const {
+            return true;
+        }
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
@@ -41,6 +49,9 @@ class event_bus
         }
     private:
         std::vector<event_subscriber *> subscribers;
+        // The subscribers that want each type of event, in the order they subscribed
+        std::array<std::vector<event_subscriber *>,
+            static_cast<size_t>( event_type::num_event_types )> subscribers_by_type;
 };
 
 event_bus &get_event_bus();
@@ -145,7 +145,7 @@ class event_transformation::impl
     public:
         virtual ~impl() = default;
         virtual event_multiset initialize( stats_tracker & ) const = 0;
-        virtual std::unique_ptr<stats_tracker_state> watch( stats_tracker & ) const = 0;
+        virtual std::unique_ptr<event_transformation_state> watch( stats_tracker & ) const = 0;
         virtual void check( const std::string &/*name*/ ) const {}
         virtual cata::event::fields_type fields() const = 0;
         virtual monotonically monotonicity() const = 0;
@@ -169,15 +169,23 @@ struct value_constraint {
     std::optional<std::string> equals_string_;
     std::optional<string_id<event_statistic>> equals_statistic_;
 
-    bool permits( const cata_variant &v, stats_tracker &stats ) const {
+    // The statistic is only worked out the first time it is needed, and then
+    // kept in statistic_value for the later calls
+    bool permits( const cata_variant &v, stats_tracker &stats,
+                  std::optional<cata_variant> &statistic_value ) const {
         if( equals_ && *equals_ != v ) {
             return false;
         }
         if( equals_string_ && *equals_string_ != v.get_string() ) {
             return false;
         }
-        if( equals_statistic_ && stats.value_of( *equals_statistic_ ) != v ) {
-            return false;
+        if( equals_statistic_ ) {
+            if( !statistic_value ) {
+                statistic_value = stats.value_of( *equals_statistic_ );
+            }
+            if( *statistic_value != v ) {
+                return false;
+            }
         }
         return true;
     }
@@ -428,9 +436,13 @@ struct event_transformation_impl : public event_transformation::impl {
     std::vector<std::string> drop_fields_;
 
     using EventVector = std::vector<cata::event::data_type>;
+    // The values of the statistics the constraints compare against, by constraint
+    using StatisticValues = std::vector<std::optional<cata_variant>>;
 
-    EventVector match_and_transform( const cata::event::data_type &input_data,
-                                     stats_tracker &stats ) const {
+    // The statistics can't change while one set of events is transformed, so the
+    // values are shared between all the events of the set
+    EventVector match_and_transform( const cata::event::data_type &input_data, stats_tracker &stats,
+                                     StatisticValues &statistic_values ) const {
         EventVector result = { input_data };
         for( const std::pair<std::string, new_field> &p : new_fields_ ) {
             EventVector before_this_pass = std::move( result );
@@ -441,12 +453,14 @@ struct event_transformation_impl : public event_transformation::impl {
             }
         }
 
+        statistic_values.resize( constraints_.size() );
         auto violates_constraints = [&]( const cata::event::data_type & data ) {
-            for( const std::pair<std::string, value_constraint> &p : constraints_ ) {
-                const std::string &field = p.first;
-                const value_constraint &constraint = p.second;
+            for( size_t i = 0; i < constraints_.size(); i++ ) {
+                const std::string &field = constraints_[i].first;
+                const value_constraint &constraint = constraints_[i].second;
                 const auto it = data.find( field );
-                if( it == data.end() || !constraint.permits( it->second, stats ) ) {
+                if( it == data.end() ||
+                    !constraint.permits( it->second, stats, statistic_values[i] ) ) {
                     return true;
                 }
             }
@@ -468,10 +482,11 @@ struct event_transformation_impl : public event_transformation::impl {
     event_multiset initialize( const event_multiset::counts_type &input,
                                stats_tracker &stats ) const {
         event_multiset result;
+        StatisticValues statistic_values;
 
         for( const std::pair<const cata::event::data_type, int> &p : input ) {
             cata::event::data_type event_data = p.first;
-            EventVector transformed = match_and_transform( event_data, stats );
+            EventVector transformed = match_and_transform( event_data, stats, statistic_values );
             for( cata::event::data_type &d : transformed ) {
                 result.add( { d, p.second } );
             }
@@ -512,7 +527,7 @@ struct event_transformation_impl : public event_transformation::impl {
         }
     }
 
-    struct state : stats_tracker_state, event_multiset_watcher, stat_watcher {
+    struct state : event_transformation_state, event_multiset_watcher, stat_watcher {
         state( const event_transformation_impl *trans, stats_tracker &stats ) :
             transformation_( trans ),
             data_( trans->initialize( stats ) ) {
@@ -529,8 +544,14 @@ struct event_transformation_impl : public event_transformation::impl {
             stats.transformed_set_changed( transformation_->id_, data_ );
         }
 
+        const event_multiset &events() const override {
+            return data_;
+        }
+
         void event_added( const cata::event &e, stats_tracker &stats ) override {
-            EventVector transformed = transformation_->match_and_transform( e.data(), stats );
+            StatisticValues statistic_values;
+            EventVector transformed = transformation_->match_and_transform( e.data(), stats,
+                                      statistic_values );
             for( cata::event::data_type &d : transformed ) {
                 cata::event new_event( e.type(), e.time(), std::move( d ) );
                 data_.add( new_event );
@@ -547,7 +568,7 @@ struct event_transformation_impl : public event_transformation::impl {
         event_multiset data_;
     };
 
-    std::unique_ptr<stats_tracker_state> watch( stats_tracker &stats ) const override {
+    std::unique_ptr<event_transformation_state> watch( stats_tracker &stats ) const override {
         return std::make_unique<state>( this, stats );
     }
 
@@ -584,7 +605,8 @@ event_multiset event_transformation::value( stats_tracker &stats ) const
     return impl_->initialize( stats );
 }
 
-std::unique_ptr<stats_tracker_state> event_transformation::watch( stats_tracker &stats ) const
+std::unique_ptr<event_transformation_state> event_transformation::watch(
+    stats_tracker &stats ) const
 {
     return impl_->watch( stats );
 }
@@ -17,6 +17,7 @@ class event_multiset;
 enum class event_type : int;
 class JsonObject;
 enum class monotonically : int;
+class event_transformation_state;
 class stats_tracker;
 class stats_tracker_state;
 
@@ -41,7 +42,7 @@ class event_transformation
 {
     public:
         event_multiset value( stats_tracker & ) const;
-        std::unique_ptr<stats_tracker_state> watch( stats_tracker & ) const;
+        std::unique_ptr<event_transformation_state> watch( stats_tracker & ) const;
 
         void load( const JsonObject &, const std::string & );
         void check() const;
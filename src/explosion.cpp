@@ -341,6 +341,8 @@ class ExplosionProcess
         float cur_relative_time;
         long long last_update_ms;
         bool request_redraw;
+        // Looked up once, it's checked for every tile
+        const bool animated;
     public:
         void run();
 
@@ -370,7 +372,8 @@ class ExplosionProcess
                 std::chrono::time_point_cast<std::chrono::milliseconds>
                 ( std::chrono::system_clock::now() ).time_since_epoch().count()
             ),
-            request_redraw( false ) {}
+            request_redraw( false ),
+            animated( !test_mode && get_option<int>( "ANIMATION_DELAY" ) > 0 ) {}
     private:
         static bool dist_comparator( dist_point_pair a, dist_point_pair b ) {
             return a.first < b.first;
@@ -405,8 +408,8 @@ class ExplosionProcess
             assert( delay >= 0 );
             event_queue.emplace( cur_relative_time + delay + std::numeric_limits<float>::epsilon(), event );
         }
-        bool is_animated() {
-            return !test_mode && get_option<int>( "ANIMATION_DELAY" ) > 0;
+        bool is_animated() const {
+            return animated;
         }
 
         bool process_next();
@@ -498,11 +501,7 @@ inline bool ExplosionProcess::is_occluded( const tripoint from, const tripoint t
     map &here = get_map();
     tripoint last_position = from;
 
-    std::vector<tripoint> line_of_movement = line_to( from, to );
-    // Annoyingly, line_to does not include the origin point
-    //   so it has to be added manually
-    line_of_movement.insert( line_of_movement.begin(), from );
-    for( const auto &position : line_of_movement ) {
+    const auto blocks = [&]( const tripoint & position ) {
         // position != to necessary because we do want to strike the
         //   target obstacle
         if( position != to && here.impassable( position ) ) {
@@ -514,6 +513,17 @@ inline bool ExplosionProcess::is_occluded( const tripoint from, const tripoint t
             return true;
         }
         last_position = position;
+        return false;
+    };
+    // Annoyingly, line_to does not include the origin point
+    //   so it has to be checked on its own
+    if( blocks( from ) ) {
+        return true;
+    }
+    for( const tripoint &position : line_to( from, to ) ) {
+        if( blocks( position ) ) {
+            return true;
+        }
     }
     return false;
 }
@@ -1015,13 +1025,15 @@ void ExplosionProcess::run()
         g->toggle_pixel_minimap();
     }
 
-    // Remove temporary flags
-    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-        for( const auto &pos : here.points_on_zlevel( z ) ) {
-            for( auto &it : here.i_at( pos ) ) {
-                it->unset_flag( flag_EXPLOSION_SMASHED );
-                it->unset_flag( flag_EXPLOSION_PROPELLED );
-            }
+    std::sort( recombination_targets.begin(), recombination_targets.end() );
+    auto end = std::unique( recombination_targets.begin(), recombination_targets.end() );
+    recombination_targets.erase( end, recombination_targets.end() );
+
+    // Remove temporary flags, the items that got them were blasted or landed on these tiles
+    for( const tripoint &pos : recombination_targets ) {
+        for( auto &it : here.i_at( pos ) ) {
+            it->unset_flag( flag_EXPLOSION_SMASHED );
+            it->unset_flag( flag_EXPLOSION_PROPELLED );
         }
     }
 
@@ -1031,9 +1043,6 @@ void ExplosionProcess::run()
     }
 
     // Finally, recombine thrown items into full stacks again
-    std::sort( recombination_targets.begin(), recombination_targets.end() );
-    auto end = std::unique( recombination_targets.begin(), recombination_targets.end() );
-    recombination_targets.erase( end, recombination_targets.end() );
 
     for( const auto &position : recombination_targets ) {
         for( detached_ptr<item> &it : here.i_clear( position ) ) {
@@ -1086,7 +1095,9 @@ static std::map<const Creature *, int> legacy_shrapnel( const tripoint &src,
     // TODO: Calculate range based on max effective range for projectiles.
     // Basically bisect between 0 and map diameter using shrapnel_calc().
     // Need to update shadowcasting to support limiting range without adjusting initial distance.
-    const tripoint_range<tripoint> area = here.points_on_zlevel( src.z );
+    // Fragments are cast no further than one square past their range, so the obstacles
+    // and the hits are only worked out for the squares up to there.
+    const tripoint_range<tripoint> area = here.points_in_radius( src, fragment.range + 1 );
 
     here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east, obstacle_cache );
 
@@ -1597,14 +1608,13 @@ void explosion_funcs::shockwave( const queued_explosion &qe )
                    false,
                    "misc", "shockwave" );
 
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.posz() != p.z ) {
+    for( monster *critter : g->get_monsters_in_radius( p, sw.radius ) ) {
+        // Earlier knockbacks may have killed it
+        if( critter->is_dead() || critter->posz() != p.z ) {
             continue;
         }
-        if( rl_dist( critter.pos(), p ) <= sw.radius ) {
-            add_msg( _( "%s is caught in the shockwave!" ), critter.name() );
-            g->knockback( p, critter.pos(), sw.force, sw.stun, sw.dam_mult, qe.source );
-        }
+        add_msg( _( "%s is caught in the shockwave!" ), critter->name() );
+        g->knockback( p, critter->pos(), sw.force, sw.stun, sw.dam_mult, qe.source );
     }
     // TODO: combine the two loops and the case for g->u using all_creatures()
     for( npc &guy : g->all_npcs() ) {
@@ -0,0 +1,111 @@
+#include "file_prefetcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "filesystem.h"
+
+file_prefetcher::file_prefetcher() = default;
+
+file_prefetcher::~file_prefetcher()
+{
+    if( !worker ) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+        queue.clear();
+    }
+    work_available.notify_all();
+    worker->join();
+}
+
+void file_prefetcher::request( const std::string &path )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( files.contains( path ) ) {
+            return;
+        }
+        files.emplace( path, std::nullopt );
+        queue.push_back( path );
+        if( !worker ) {
+            worker = std::make_unique<std::thread>( &file_prefetcher::run, this );
+        }
+    }
+    work_available.notify_one();
+}
+
+bool file_prefetcher::is_requested( const std::string &path ) const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return files.contains( path );
+}
+
+std::optional<std::string> file_prefetcher::take( const std::string &path )
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    if( !files.contains( path ) ) {
+        return std::nullopt;
+    }
+    const auto queued = std::find( queue.begin(), queue.end(), path );
+    if( queued != queue.end() ) {
+        // Not started yet, the caller reading it right away is faster than waiting in line
+        queue.erase( queued );
+        files.erase( path );
+        return std::nullopt;
+    }
+    work_done.wait( lock, [&]() {
+        return reading != path;
+    } );
+    const auto iter = files.find( path );
+    if( iter == files.end() ) {
+        return std::nullopt;
+    }
+    std::optional<std::string> result = std::move( iter->second );
+    files.erase( iter );
+    return result;
+}
+
+void file_prefetcher::clear()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    queue.clear();
+    work_done.wait( lock, [this]() {
+        return reading.empty();
+    } );
+    files.clear();
+}
+
+void file_prefetcher::run()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_available.wait( lock, [this]() {
+            return stopping || !queue.empty();
+        } );
+        if( stopping ) {
+            return;
+        }
+        reading = std::move( queue.front() );
+        queue.pop_front();
+        lock.unlock();
+
+        // Can't report errors from here, failed reads are simply dropped and
+        // the file is read again (and the error shown) on the game thread.
+        std::optional<std::string> data = try_read_entire_file( reading );
+
+        lock.lock();
+        const auto iter = files.find( reading );
+        if( iter != files.end() ) {
+            if( data ) {
+                iter->second = std::move( data );
+            } else {
+                files.erase( iter );
+            }
+        }
+        reading.clear();
+        work_done.notify_all();
+    }
+}
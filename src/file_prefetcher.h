@@ -0,0 +1,57 @@
+#pragma once
+#ifndef CATA_SRC_FILE_PREFETCHER_H
+#define CATA_SRC_FILE_PREFETCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * Reads whole files into memory on a worker thread.
+ *
+ * Only the disk access happens in the background, whoever requested a file parses
+ * the data on the game thread after collecting it with @ref take. Requested files
+ * must not be written to until they have been taken or @ref clear has been called.
+ */
+class file_prefetcher
+{
+    public:
+        file_prefetcher();
+        ~file_prefetcher();
+
+        /** Queue @p path to be read, unless it was already requested. */
+        void request( const std::string &path );
+        /** Whether @p path was requested and not yet taken. */
+        bool is_requested( const std::string &path ) const;
+        /**
+         * Get the contents of a requested file, waiting for the read if it is still in progress.
+         * Returns nothing if the file wasn't requested or couldn't be read.
+         */
+        std::optional<std::string> take( const std::string &path );
+        /** Drop all requests and read data. */
+        void clear();
+
+    private:
+        void run();
+
+        mutable std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable work_done;
+        std::deque<std::string> queue;
+        // Requested paths, empty until read. Failed reads are removed.
+        std::unordered_map<std::string, std::optional<std::string>> files;
+        std::string reading;
+        bool stopping = false;
+        std::unique_ptr<std::thread> worker;
+};
+
+#endif // CATA_SRC_FILE_PREFETCHER_H
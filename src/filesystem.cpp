@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <iterator>
+#include <optional>
 #include <utility>
 
 #include "debug.h"
@@ -155,16 +156,37 @@ const char *cata_files::eol()
 }
 
 std::string read_entire_file( const std::string &path )
+{
+    return try_read_entire_file( path ).value_or( "" );
+}
+
+std::optional<std::string> try_read_entire_file( const std::string &path )
 {
     cata_ifstream infile;
     infile.mode( cata_ios_mode::binary ).open( path );
     if( !infile.is_open() ) {
-        return "";
+        return std::nullopt;
+    }
+    std::istream &in = *infile;
+    // Size the string up front and fill it in one read instead of growing it a
+    // character at a time
+    std::string ret;
+    in.seekg( 0, std::ios::end );
+    const std::streamoff size = in.tellg();
+    in.seekg( 0, std::ios::beg );
+    if( size > 0 && in ) {
+        ret.resize( static_cast<size_t>( size ) );
+        in.read( ret.data(), size );
+        ret.resize( static_cast<size_t>( in.gcount() ) );
+        in.clear();
+    } else {
+        in.clear();
+        in.seekg( 0, std::ios::beg );
     }
-    std::string ret = std::string( std::istreambuf_iterator<char>( *infile ),
-                                   std::istreambuf_iterator<char>() );
-    if( infile.fail() ) {
-        return "";
+    // Whatever is left if the size was unknown or the file grew meanwhile
+    ret.append( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    if( in.bad() ) {
+        return std::nullopt;
     }
     return ret;
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_FILESYSTEM_H
 #define CATA_SRC_FILESYSTEM_H
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -59,6 +60,11 @@ std::string get_pid_string();
  * @return empty string on failure.
  */
 std::string read_entire_file( const std::string &path );
+/**
+ * Read entire file to string, with a single read of the whole file where possible.
+ * @return nothing if the file can't be opened or read.
+ */
+std::optional<std::string> try_read_entire_file( const std::string &path );
 
 /** Force 'path' to be a normalized directory */
 std::string as_norm_dir( const std::string &path );
@@ -0,0 +1,426 @@
+#pragma once
+#ifndef CATA_SRC_FLAT_HASH_MAP_H
+#define CATA_SRC_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cata
+{
+
+namespace flat_hash_detail
+{
+
+struct map_key_of {
+    template<typename Pair>
+    const auto &operator()( const Pair &p ) const {
+        return p.first;
+    }
+};
+
+struct set_key_of {
+    template<typename Key>
+    const Key &operator()( const Key &k ) const {
+        return k;
+    }
+};
+
+/**
+ * Open addressing hash table with linear probing, the storage of @ref flat_hash_map and
+ * @ref flat_hash_set.
+ *
+ * All elements live in one array, so lookups touch one or two cache lines instead of
+ * following node pointers. Erased elements leave a marker behind until the next rehash,
+ * so erasing never moves other elements and iterators to them stay valid. Inserting may
+ * rehash, which invalidates all iterators and references.
+ */
+template<typename Key, typename Stored, typename KeyOf, typename Hash, typename KeyEqual>
+class flat_hash_table
+{
+    private:
+        enum class slot_state : unsigned char {
+            empty,
+            full,
+            erased,
+        };
+
+        template<bool Const>
+        class iterator_impl
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Stored;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const Stored *, Stored *>;
+                using reference = std::conditional_t<Const, const Stored &, Stored &>;
+                using table_type = std::conditional_t<Const, const flat_hash_table, flat_hash_table>;
+
+                iterator_impl() = default;
+                iterator_impl( table_type *table, std::size_t index ) : table( table ), index( index ) {
+                    skip_unused();
+                }
+                // Iterators convert to const iterators
+                template<bool C = Const, std::enable_if_t<C, int> = 0>
+                iterator_impl( const iterator_impl<false> &other ) :
+                    table( other.table ), index( other.index ) {}
+
+                reference operator*() const {
+                    return *table->values[index];
+                }
+                pointer operator->() const {
+                    return &*table->values[index];
+                }
+                iterator_impl &operator++() {
+                    ++index;
+                    skip_unused();
+                    return *this;
+                }
+                iterator_impl operator++( int ) {
+                    iterator_impl ret = *this;
+                    ++*this;
+                    return ret;
+                }
+                friend bool operator==( const iterator_impl &l, const iterator_impl &r ) {
+                    return l.index == r.index;
+                }
+                friend bool operator!=( const iterator_impl &l, const iterator_impl &r ) {
+                    return l.index != r.index;
+                }
+
+            private:
+                friend class flat_hash_table;
+                friend class iterator_impl<!Const>;
+
+                void skip_unused() {
+                    while( index < table->states.size() && table->states[index] != slot_state::full ) {
+                        ++index;
+                    }
+                }
+
+                table_type *table = nullptr;
+                std::size_t index = 0;
+        };
+
+    public:
+        using key_type = Key;
+        using value_type = Stored;
+        using size_type = std::size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using iterator = iterator_impl<false>;
+        using const_iterator = iterator_impl<true>;
+
+        flat_hash_table() = default;
+
+        iterator begin() {
+            return iterator( this, 0 );
+        }
+        iterator end() {
+            return iterator( this, states.size() );
+        }
+        const_iterator begin() const {
+            return const_iterator( this, 0 );
+        }
+        const_iterator end() const {
+            return const_iterator( this, states.size() );
+        }
+        const_iterator cbegin() const {
+            return begin();
+        }
+        const_iterator cend() const {
+            return end();
+        }
+
+        bool empty() const {
+            return count_full == 0;
+        }
+        size_type size() const {
+            return count_full;
+        }
+        /** Number of slots, elements fit in before the next rehash is three quarters of it. */
+        size_type capacity() const {
+            return states.size();
+        }
+
+        void clear() {
+            for( std::size_t i = 0; i < states.size(); ++i ) {
+                if( states[i] == slot_state::full ) {
+                    values[i].reset();
+                }
+                states[i] = slot_state::empty;
+            }
+            count_full = 0;
+            count_erased = 0;
+        }
+
+        /** Make room for @p n elements without rehashing. */
+        void reserve( size_type n ) {
+            if( n * 4 > states.size() * 3 ) {
+                rehash( slots_for( n ) );
+            }
+        }
+
+        iterator find( const Key &key ) {
+            return iterator( this, find_index( key ) );
+        }
+        const_iterator find( const Key &key ) const {
+            return const_iterator( this, find_index( key ) );
+        }
+        size_type count( const Key &key ) const {
+            return find_index( key ) != states.size() ? 1 : 0;
+        }
+        bool contains( const Key &key ) const {
+            return find_index( key ) != states.size();
+        }
+
+        size_type erase( const Key &key ) {
+            const std::size_t index = find_index( key );
+            if( index == states.size() ) {
+                return 0;
+            }
+            erase_index( index );
+            return 1;
+        }
+        iterator erase( const_iterator pos ) {
+            erase_index( pos.index );
+            return iterator( this, pos.index + 1 );
+        }
+        iterator erase( iterator pos ) {
+            return erase( const_iterator( pos ) );
+        }
+
+        void swap( flat_hash_table &other ) noexcept {
+            states.swap( other.states );
+            values.swap( other.values );
+            std::swap( count_full, other.count_full );
+            std::swap( count_erased, other.count_erased );
+            std::swap( shift, other.shift );
+        }
+
+        /** Same elements, regardless of their order. */
+        friend bool operator==( const flat_hash_table &l, const flat_hash_table &r ) {
+            if( l.size() != r.size() ) {
+                return false;
+            }
+            for( const Stored &v : l ) {
+                const auto iter = r.find( KeyOf()( v ) );
+                if( iter == r.end() || !( *iter == v ) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    protected:
+        /** Insert a new element made from @p args under @p key, unless there already is one. */
+        template<typename... Args>
+        std::pair<iterator, bool> emplace_with_key( const Key &key, Args &&... args ) {
+            if( ( count_full + count_erased + 1 ) * 4 > states.size() * 3 ) {
+                // Grows when full of elements, only clears out the erased ones otherwise
+                rehash( slots_for( count_full + 1 ) );
+            }
+            const std::size_t mask = states.size() - 1;
+            std::size_t index = home_index( key );
+            std::optional<std::size_t> reusable;
+            while( states[index] != slot_state::empty ) {
+                if( states[index] == slot_state::full ) {
+                    if( KeyEqual()( KeyOf()( *values[index] ), key ) ) {
+                        return { iterator( this, index ), false };
+                    }
+                } else if( !reusable ) {
+                    reusable = index;
+                }
+                index = ( index + 1 ) & mask;
+            }
+            if( reusable ) {
+                index = *reusable;
+                count_erased--;
+            }
+            values[index].emplace( std::forward<Args>( args )... );
+            states[index] = slot_state::full;
+            count_full++;
+            return { iterator( this, index ), true };
+        }
+
+    private:
+        static constexpr std::size_t min_slots = 16;
+
+        static std::size_t slots_for( std::size_t n ) {
+            std::size_t slots = min_slots;
+            while( n * 4 > slots * 3 ) {
+                slots *= 2;
+            }
+            return slots;
+        }
+
+        // Fibonacci hashing on top of Hash, so weak hashes still spread over the table
+        std::size_t home_index( const Key &key ) const {
+            const std::uint64_t h = static_cast<std::uint64_t>( Hash()( key ) );
+            return static_cast<std::size_t>( ( h * 0x9e3779b97f4a7c15ULL ) >> shift );
+        }
+
+        std::size_t find_index( const Key &key ) const {
+            if( count_full == 0 ) {
+                return states.size();
+            }
+            const std::size_t mask = states.size() - 1;
+            for( std::size_t index = home_index( key ); states[index] != slot_state::empty;
+                 index = ( index + 1 ) & mask ) {
+                if( states[index] == slot_state::full && KeyEqual()( KeyOf()( *values[index] ), key ) ) {
+                    return index;
+                }
+            }
+            return states.size();
+        }
+
+        void erase_index( std::size_t index ) {
+            values[index].reset();
+            states[index] = slot_state::erased;
+            count_full--;
+            count_erased++;
+        }
+
+        void rehash( std::size_t slots ) {
+            std::vector<slot_state> old_states( slots, slot_state::empty );
+            std::vector<std::optional<Stored>> old_values( slots );
+            old_states.swap( states );
+            old_values.swap( values );
+            shift = 64;
+            for( std::size_t s = slots; s > 1; s /= 2 ) {
+                shift--;
+            }
+            count_full = 0;
+            count_erased = 0;
+            const std::size_t mask = slots - 1;
+            for( std::size_t i = 0; i < old_states.size(); ++i ) {
+                if( old_states[i] != slot_state::full ) {
+                    continue;
+                }
+                std::size_t index = home_index( KeyOf()( *old_values[i] ) );
+                while( states[index] != slot_state::empty ) {
+                    index = ( index + 1 ) & mask;
+                }
+                values[index].emplace( std::move( *old_values[i] ) );
+                states[index] = slot_state::full;
+                count_full++;
+            }
+        }
+
+        std::vector<slot_state> states;
+        std::vector<std::optional<Stored>> values;
+        std::size_t count_full = 0;
+        std::size_t count_erased = 0;
+        // 64 minus the number of bits of a slot index
+        int shift = 64;
+};
+
+} // namespace flat_hash_detail
+
+/**
+ * Drop-in replacement for the parts of std::unordered_map the game uses, for small keys
+ * that are looked up often, see @ref flat_hash_detail::flat_hash_table for the trade-offs.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map : public flat_hash_detail::flat_hash_table < Key,
+    std::pair<const Key, Value>, flat_hash_detail::map_key_of, Hash, KeyEqual >
+{
+    private:
+        using base = flat_hash_detail::flat_hash_table < Key, std::pair<const Key, Value>,
+              flat_hash_detail::map_key_of, Hash, KeyEqual >;
+
+    public:
+        using mapped_type = Value;
+        using typename base::iterator;
+        using typename base::value_type;
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace( const Key &key, Args &&... args ) {
+            return this->emplace_with_key( key, std::piecewise_construct, std::forward_as_tuple( key ),
+                                           std::forward_as_tuple( std::forward<Args>( args )... ) );
+        }
+        template<typename K, typename V>
+        std::pair<iterator, bool> emplace( K &&key, V &&value ) {
+            const Key k( std::forward<K>( key ) );
+            return this->emplace_with_key( k, k, std::forward<V>( value ) );
+        }
+        std::pair<iterator, bool> insert( const value_type &value ) {
+            return this->emplace_with_key( value.first, value );
+        }
+        template<typename V>
+        std::pair<iterator, bool> insert_or_assign( const Key &key, V &&value ) {
+            std::pair<iterator, bool> ret = try_emplace( key, std::forward<V>( value ) );
+            if( !ret.second ) {
+                ret.first->second = std::forward<V>( value );
+            }
+            return ret;
+        }
+
+        Value &operator[]( const Key &key ) {
+            return try_emplace( key ).first->second;
+        }
+        Value &at( const Key &key ) {
+            const auto iter = this->find( key );
+            if( iter == this->end() ) {
+                throw std::out_of_range( "flat_hash_map::at" );
+            }
+            return iter->second;
+        }
+        const Value &at( const Key &key ) const {
+            const auto iter = this->find( key );
+            if( iter == this->end() ) {
+                throw std::out_of_range( "flat_hash_map::at" );
+            }
+            return iter->second;
+        }
+};
+
+/** Drop-in replacement for the parts of std::unordered_set the game uses, see @ref flat_hash_map. */
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_set : public flat_hash_detail::flat_hash_table < Key, const Key,
+    flat_hash_detail::set_key_of, Hash, KeyEqual >
+{
+    private:
+        using base = flat_hash_detail::flat_hash_table < Key, const Key, flat_hash_detail::set_key_of,
+              Hash, KeyEqual >;
+
+    public:
+        using typename base::iterator;
+
+        flat_hash_set() = default;
+        flat_hash_set( std::initializer_list<Key> keys ) {
+            insert( keys.begin(), keys.end() );
+        }
+        template<typename InputIt>
+        flat_hash_set( InputIt first, InputIt last ) {
+            insert( first, last );
+        }
+
+        std::pair<iterator, bool> insert( const Key &key ) {
+            return this->emplace_with_key( key, key );
+        }
+        template<typename InputIt>
+        void insert( InputIt first, InputIt last ) {
+            for( ; first != last; ++first ) {
+                insert( *first );
+            }
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> emplace( Args &&... args ) {
+            const Key key( std::forward<Args>( args )... );
+            return this->emplace_with_key( key, key );
+        }
+};
+
+} // namespace cata
+
+#endif // CATA_SRC_FLAT_HASH_MAP_H
@@ -12,6 +12,7 @@
 #include <ctime>
 #include <cwctype>
 #include <exception>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -43,6 +44,7 @@
 #include "avatar.h"
 #include "avatar_action.h"
 #include "avatar_functions.h"
+#include "background_saver.h"
 #include "bionics.h"
 #include "bodypart.h"
 #include "calendar.h"
@@ -91,6 +93,7 @@
 #include "iexamine.h"
 #include "init.h"
 #include "input.h"
+#include "input_recorder.h"
 #include "int_id.h"
 #include "inventory.h"
 #include "item.h"
@@ -121,6 +124,7 @@
 #include "mod_manager.h"
 #include "monattack.h"
 #include "monexamine.h"
+#include "monster_turn_stats.h"
 #include "monstergenerator.h"
 #include "morale_types.h"
 #include "mtype.h"
@@ -135,6 +139,8 @@
 #include "overmapbuffer.h"
 #include "panels.h"
 #include "path_info.h"
+#include "pathfinding.h"
+#include "pathfinding_stats.h"
 #include "pickup.h"
 #include "player.h"
 #include "player_activity.h"
@@ -147,10 +153,12 @@
 #include "rot.h"
 #include "rng.h"
 #include "safemode_ui.h"
+#include "save_journal.h"
 #include "scenario.h"
 #include "scent_map.h"
 #include "scores_ui.h"
 #include "sdltiles.h"
+#include "simulation_area.h"
 #include "sounds.h"
 #include "start_location.h"
 #include "stats_tracker.h"
@@ -158,10 +166,12 @@
 #include "string_id.h"
 #include "string_input_popup.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_stats.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -199,9 +209,20 @@ class computer;
 #define dbg(x) DebugLogFL((x),DC::Game)
 
 static constexpr int DANGEROUS_PROXIMITY = 5;
+// Hostiles closer than this to the avatar stop fast-forwarding even while they wander
+static constexpr int FAST_FORWARD_SAFE_DISTANCE = 12;
+// How often fast-forwarded and travel turns rebuild the map caches
+static constexpr time_duration FAST_FORWARD_CACHE_INTERVAL = 10_turns;
+// Redraws while waiting or travelling that are due by game time are skipped if the last
+// one was this recent, so fast turns don't spend their time drawing
+static constexpr std::chrono::milliseconds WAIT_REDRAW_MIN_INTERVAL( 100 );
 
 static const activity_id ACT_OPERATION( "ACT_OPERATION" );
 static const activity_id ACT_AUTODRIVE( "ACT_AUTODRIVE" );
+static const activity_id ACT_WAIT( "ACT_WAIT" );
+static const activity_id ACT_WAIT_NPC( "ACT_WAIT_NPC" );
+static const activity_id ACT_WAIT_STAMINA( "ACT_WAIT_STAMINA" );
+static const activity_id ACT_WAIT_WEATHER( "ACT_WAIT_WEATHER" );
 
 static const skill_id skill_melee( "melee" );
 static const skill_id skill_dodge( "dodge" );
@@ -511,6 +532,7 @@ void game::setup()
     // reset kill counts
     get_kill_tracker().clear();
     achievements_tracker_ptr->clear();
+    simulation_areas_ptr->clear();
     // reset follower list
     follower_ids.clear();
     scent.reset();
@@ -1353,6 +1375,8 @@ bool game::do_turn()
 {
     ZoneScoped;
     cleanup_arenas();
+    // Messages and such the workers left for us during the last turn
+    get_thread_pool().run_main_thread_tasks();
     if( is_game_over() ) {
         return cleanup_at_end();
     }
@@ -1372,8 +1396,21 @@ bool game::do_turn()
         load_npcs();
     }
 
-    timed_events.process();
-    mission::process_all();
+    fast_forwarding = can_fast_forward();
+    if( map_cache_stale && !fast_forwarding && !u.has_destination() ) {
+        // The caches may be a few turns old, whatever woke us up has to be seen right away
+        m.build_map_cache( get_levz() );
+        map_cache_stale = false;
+    }
+
+    {
+        const turn_stats::phase_timer timer( turn_phase::timed_events );
+        timed_events.process();
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::missions );
+        mission::process_all();
+    }
     // If controlling a vehicle that is owned by someone else
     if( u.in_vehicle && u.controlling_vehicle ) {
         vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) );
@@ -1401,6 +1438,9 @@ bool game::do_turn()
 
     u.update_body();
 
+    // Finish up anything the last background autosave completed
+    get_background_saver().process_completed();
+
     // Auto-save if autosave is enabled
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
@@ -1408,6 +1448,11 @@ bool game::do_turn()
         autosave();
     }
 
+    // Drop far away submaps that weren't used in a while when the buffer grows too big
+    if( calendar::once_every( 1_minutes ) ) {
+        MAPBUFFER.enforce_memory_budget();
+    }
+
     weather.update_weather();
     reset_light_level();
 
@@ -1482,32 +1527,79 @@ bool game::do_turn()
         calc_driving_offset( veh );
     }
 
-    // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
-        !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
-        scent.set( u.pos(), u.scent, u.get_type_of_scent() );
-        overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+    {
+        const turn_stats::phase_timer timer( turn_phase::scent );
+        // No-scent debug mutation has to be processed here or else it takes time to start working
+        if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
+            !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
+            scent.set( u.pos(), u.scent, u.get_type_of_scent() );
+            overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+        }
+        scent.update( u.pos(), m );
     }
-    scent.update( u.pos(), m );
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        const turn_stats::phase_timer timer( turn_phase::floor_caches );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    autopilot_vehicles();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
+    {
+        const turn_stats::phase_timer timer( turn_phase::falling );
+        m.process_falling();
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::vehmove );
+        autopilot_vehicles();
+        m.vehmove();
+    }
+    if( u.in_vehicle ) {
+        if( const vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) ) ) {
+            m.prefetch_submaps_ahead( *veh );
+        }
+    } else {
+        m.prefetch_submaps_ahead( u.pos() );
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::fields );
+        m.process_fields();
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::items );
+        m.process_items();
+    }
     m.creature_in_field( u );
-    grid_tracker_ptr->update( calendar::turn );
-
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
+    {
+        const turn_stats::phase_timer timer( turn_phase::grid );
+        grid_tracker_ptr->update( calendar::turn );
+        simulation_areas_ptr->update( m );
+    }
+
+    {
+        const turn_stats::phase_timer timer( turn_phase::sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        const bool defer = fast_forwarding ?
+                           !calendar::once_every( FAST_FORWARD_CACHE_INTERVAL ) :
+                           can_defer_travel_map_cache();
+        if( defer ) {
+            map_cache_stale = true;
+        } else {
+            m.build_map_cache( get_levz(), true );
+            map_cache_stale = false;
+        }
+    }
+    {
+        const turn_stats::phase_timer timer( turn_phase::monmove );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
+        const turn_stats::phase_timer timer( turn_phase::npc_move );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
@@ -1521,9 +1613,15 @@ bool game::do_turn()
     }
     update_stair_monsters();
     mon_info_update();
-    u.process_turn();
+    {
+        const turn_stats::phase_timer timer( turn_phase::avatar );
+        u.process_turn();
+    }
 
-    cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
+    {
+        const turn_stats::phase_timer timer( turn_phase::lua_hooks );
+        cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
+    }
 
     explosion_handler::get_explosion_queue().execute();
     cleanup_dead();
@@ -1563,11 +1661,20 @@ bool game::do_turn()
     }
     if( wait_redraw ) {
         ZoneScopedN( "wait_redraw" );
-        if( first_redraw_since_waiting_started ||
-            calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) ) {
+        const auto now = std::chrono::steady_clock::now();
+        const bool redraw_due = calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) &&
+                                ( wait_refresh_rate <= 1_turns ||
+                                  now - last_wait_redraw >= WAIT_REDRAW_MIN_INTERVAL );
+        if( first_redraw_since_waiting_started || redraw_due ) {
+            if( map_cache_stale ) {
+                // Show what is there now, not where we were some turns ago
+                m.build_map_cache( get_levz() );
+                map_cache_stale = false;
+            }
             if( first_redraw_since_waiting_started || calendar::once_every( wait_refresh_rate ) ) {
                 ui_manager::redraw();
             }
+            last_wait_redraw = now;
 
             // Avoid redrawing the main UI every time due to invalidation
             ui_adaptor dummy( ui_adaptor::disable_uis_below {} );
@@ -1598,9 +1705,75 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
+    const int slow_turn_ms = get_option<int>( "SLOW_TURN_LOG_THRESHOLD" );
+    turn_stats::end_turn( std::chrono::milliseconds( slow_turn_ms ) );
+    TracyPlot( "Creatures", static_cast<int64_t>( num_creatures() ) );
+    TracyPlot( "Loaded submaps", static_cast<int64_t>( MAPBUFFER.size() ) );
+    FrameMarkNamed( "Turn" );
+
     return false;
 }
 
+bool game::can_fast_forward()
+{
+    if( !get_option<bool>( "FAST_FORWARD_WAITING" ) || uquit == QUIT_WATCH ) {
+        return false;
+    }
+    static const std::set<activity_id> waiting = {
+        ACT_WAIT, ACT_WAIT_NPC, ACT_WAIT_STAMINA, ACT_WAIT_WEATHER
+    };
+    if( !u.has_effect( effect_sleep ) && !( u.activity && waiting.contains( u.activity->id() ) ) ) {
+        return false;
+    }
+    if( u.in_vehicle ) {
+        const vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) );
+        if( veh != nullptr && veh->velocity != 0 ) {
+            return false;
+        }
+    }
+    for( monster &critter : all_monsters() ) {
+        if( critter.attitude_to( u ) != Attitude::A_HOSTILE ) {
+            continue;
+        }
+        // Anything that is after something might be after us
+        if( !critter.wander() || critter.wandf > 0 ||
+            rl_dist( critter.pos(), u.pos() ) <= FAST_FORWARD_SAFE_DISTANCE ) {
+            return false;
+        }
+    }
+    for( const npc &guy : all_npcs() ) {
+        if( guy.attitude_to( u ) == Attitude::A_HOSTILE &&
+            rl_dist( guy.pos(), u.pos() ) <= MAX_VIEW_DISTANCE ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool game::can_defer_travel_map_cache()
+{
+    if( !u.has_destination() || !get_option<bool>( "FAST_FORWARD_TRAVEL" ) ||
+        calendar::once_every( FAST_FORWARD_CACHE_INTERVAL ) ) {
+        return false;
+    }
+    if( u.in_vehicle ) {
+        // Driving needs the view every turn
+        return false;
+    }
+    // Anything in view might be dangerous, noticing it needs the vision caches
+    for( const monster &critter : all_monsters() ) {
+        if( rl_dist( critter.pos(), u.pos() ) <= MAX_VIEW_DISTANCE ) {
+            return false;
+        }
+    }
+    for( const npc &guy : all_npcs() ) {
+        if( rl_dist( guy.pos(), u.pos() ) <= MAX_VIEW_DISTANCE ) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void game::set_driving_view_offset( point p )
 {
     // remove the previous driving offset,
@@ -1656,6 +1829,7 @@ void game::process_voluntary_act_interrupt()
 void game::process_activity()
 {
     ZoneScoped;
+    const pathfinding_stats::caller_scope tag( route_caller::player );
     if( !u.activity ) {
         return;
     }
@@ -2507,6 +2681,8 @@ void game::move_save_to_graveyard( const std::string &dirname )
 void game::load_master()
 {
     using namespace std::placeholders;
+    // Finish or drop a background save that was cut short, before anything reads the files
+    save_journal::recover( get_world_base_save_path() + "/" + SAVE_JOURNAL );
     const auto datafile = get_world_base_save_path() + "/" + SAVE_MASTER;
     read_from_file_optional( datafile, std::bind( &game::unserialize_master, this, _1 ) );
 }
@@ -2537,6 +2713,7 @@ bool game::load( const std::string &world )
 
 bool game::load( const save_t &name )
 {
+    ZoneScoped;
     background_pane background;
     static_popup popup;
     popup.message( "%s", _( "Please wait…\nLoading the save…" ) );
@@ -2547,6 +2724,7 @@ bool game::load( const save_t &name )
 
     const std::string worldpath = get_world_base_save_path() + "/";
     const std::string playerpath = worldpath + name.base_path();
+    input_recorder::record_load( world_generator->active_world->world_name, name.base_path() );
 
     // Now load up the master game data; factions (and more?)
     load_master();
@@ -2620,7 +2798,7 @@ bool game::load( const save_t &name )
 
     u.reset();
 
-    cata::load_world_lua_state( get_world_base_save_path() + "/lua_state.json" );
+    cata::load_world_lua_state( get_world_base_save_path() );
 
     cata::run_on_game_load_hooks( *DynamicDataLoader::get_instance().lua );
 
@@ -2654,11 +2832,29 @@ void game::reset_npc_dispositions()
 
 }
 
+// Background saves queue the file so it is journaled together with the maps.
+static bool write_save_file( const std::string &path, bool background,
+                             const std::function<void( std::ostream & )> &writer, const char *fail_message )
+{
+    if( !background ) {
+        return write_to_file( path, writer, fail_message );
+    }
+    std::ostringstream buffer;
+    try {
+        writer( buffer );
+    } catch( const std::exception &err ) {
+        popup( _( "Failed to write %1$s to \"%2$s\": %3$s" ), fail_message, path, err.what() );
+        return false;
+    }
+    get_background_saver().write( path, buffer.str() );
+    return true;
+}
+
 //Saves all factions and missions and npcs.
-bool game::save_factions_missions_npcs()
+bool game::save_factions_missions_npcs( bool background )
 {
     std::string masterfile = get_world_base_save_path() + "/" + SAVE_MASTER;
-    return write_to_file( masterfile, [&]( std::ostream & fout ) {
+    return write_save_file( masterfile, background, [&]( std::ostream & fout ) {
         serialize_master( fout );
     }, _( "factions data" ) );
 }
@@ -2669,12 +2865,13 @@ bool game::save_artifacts()
     return ::save_artifacts( artfilename );
 }
 
-bool game::save_maps()
+bool game::save_maps( bool background )
 {
+    ZoneScoped;
     try {
         m.save();
-        overmap_buffer.save(); // can throw
-        MAPBUFFER.save(); // can throw
+        overmap_buffer.save( background ); // can throw
+        MAPBUFFER.save( false, background ); // can throw
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -2682,14 +2879,16 @@ bool game::save_maps()
     }
 }
 
-bool game::save_player_data()
+bool game::save_player_data( bool background )
 {
+    ZoneScoped;
     const std::string playerfile = get_player_base_save_path();
 
-    const bool saved_data = write_to_file( playerfile + SAVE_EXTENSION, [&]( std::ostream & fout ) {
+    const bool saved_data = write_save_file( playerfile + SAVE_EXTENSION, background, [&](
+    std::ostream & fout ) {
         serialize( fout );
     }, _( "player data" ) );
-    const bool saved_map_memory = u.save_map_memory();
+    const bool saved_map_memory = u.save_map_memory( background );
     const bool saved_log = write_to_file( playerfile + SAVE_EXTENSION_LOG, [&](
     std::ostream & fout ) {
         fout << memorial().dump();
@@ -2741,19 +2940,32 @@ static bool save_uistate_data( const game &g )
     }, _( "uistate data" ) );
 }
 
-bool game::save( bool quitting )
+bool game::save( bool quitting, bool background )
 {
+    ZoneScoped;
     cata::run_on_game_save_hooks( *DynamicDataLoader::get_instance().lua );
+    if( !background ) {
+        // Don't race earlier background writes to the same files.
+        get_background_saver().wait();
+    } else {
+        // Master, player, overmap and map files change together or not at all
+        get_background_saver().begin_transaction( get_world_base_save_path() + "/" + SAVE_JOURNAL );
+    }
+    on_out_of_scope end_transaction( [background]() {
+        if( background ) {
+            get_background_saver().end_transaction();
+        }
+    } );
     try {
         reset_save_ids( time( nullptr ), quitting );
-        if( !save_factions_missions_npcs() ||
+        if( !save_factions_missions_npcs( background ) ||
             !save_artifacts() ||
-            !save_maps() ||
-            !save_player_data() ||
+            !save_maps( background ) ||
+            !save_player_data( background ) ||
             !get_auto_pickup().save_character() ||
             !get_auto_notes_settings().save() ||
             !get_safemode().save_character() ||
-            !cata::save_world_lua_state( g->get_world_base_save_path() + "/lua_state.json" ) ||
+            !cata::save_world_lua_state( g->get_world_base_save_path() ) ||
             !save_uistate_data( *this )
           ) {
             return false;
@@ -3146,7 +3358,17 @@ void game::draw_panels( bool force_draw )
         }
     }
     log_height = std::max( TERMY - log_height, 3 );
-    for( const window_panel &panel : mgr.get_current_layout() ) {
+    panel_change_key key;
+    key.turn = calendar::turn;
+    key.moves = u.moves;
+    key.user_actions = user_action_counter;
+    key.pos = u.pos();
+    key.view_offset = u.view_offset;
+    key.safe_mode = safe_mode;
+    key.show_panel_adm = show_panel_adm;
+    key.messages = Messages::size();
+    key.undisplayed_messages = Messages::has_undisplayed_messages();
+    for( window_panel &panel : mgr.get_current_layout() ) {
         if( panel.render() ) {
             // height clamped to window height.
             int h = std::min( panel.get_height(), TERMY - y );
@@ -3156,8 +3378,16 @@ void game::draw_panels( bool force_draw )
             h += spacer;
             if( panel.toggle && panel.render() && h > 0 ) {
                 if( panel.always_draw || draw_this_turn ) {
-                    panel.draw( u, catacurses::newwin( h, panel.get_width(),
-                                                       point( sidebar_right ? TERMX - panel.get_width() : 0, y ) ) );
+                    key.origin = point( sidebar_right ? TERMX - panel.get_width() : 0, y );
+                    key.size = point( panel.get_width(), h );
+                    if( !panel.always_draw && panel.drawn_key == key ) {
+                        // Nothing it shows changed, e.g. a popup over it closed or an animation plays
+                        wnoutrefresh( panel.drawn_window );
+                    } else {
+                        panel.drawn_window = catacurses::newwin( h, panel.get_width(), key.origin );
+                        panel.draw( u, panel.drawn_window );
+                        panel.drawn_key = key;
+                    }
                 }
                 if( show_panel_adm ) {
                     const std::string panel_name = _( panel.get_name() );
@@ -4088,7 +4318,59 @@ void game::cleanup_dead()
 void game::monmove()
 {
     ZoneScoped;
+    const pathfinding_stats::caller_scope monsters_tag( route_caller::monster );
     cleanup_dead();
+    // Sunlight and attitudes may have changed since the last turn
+    m.clear_monster_move_caches();
+    critter_tracker->forget_attitudes();
+
+    if( get_thread_pool().concurrency() > 1 ) {
+        // Search for the routes monsters are about to ask for all at once, they're remembered
+        std::vector<route_request> requests;
+        for( const monster &critter : all_monsters() ) {
+            if( std::optional<route_request> request = critter.expected_route_request() ) {
+                requests.push_back( std::move( *request ) );
+            }
+        }
+        m.route_batch( requests );
+    }
+
+    // Monsters that far from everyone, and not after anything, only plan every few turns
+    const int detail_distance = get_option<int>( "MONSTER_DETAIL_DISTANCE" );
+    constexpr int distant_monster_turns = 4;
+    std::vector<tripoint> watchers = { u.pos() };
+    for( const npc &guy : all_npcs() ) {
+        watchers.push_back( guy.pos() );
+    }
+    const auto is_distant = [&]( monster & critter ) {
+        if( critter.friendly != 0 || critter.wandf > 0 || !critter.wander() ||
+            critter.is_hallucination() || critter.has_effect( effect_ai_controlled ) ) {
+            return false;
+        }
+        if( fast_forwarding ) {
+            // Nothing is near, everyone wandering can be treated as far away
+            return true;
+        }
+        if( detail_distance <= 0 ) {
+            return false;
+        }
+        return std::all_of( watchers.begin(), watchers.end(), [&]( const tripoint & p ) {
+            return rl_dist( p, critter.pos() ) > detail_distance;
+        } );
+    };
+
+    {
+        // The lines of sight monsters are about to check, so their plans only look them up.
+        // Done on any number of threads so the results are the same everywhere.
+        const monster_turn_stats::phase_timer timer( monster_phase::sees );
+        std::vector<std::pair<tripoint, tripoint>> lines;
+        for( monster &critter : all_monsters() ) {
+            if( !critter.has_effect( effect_ai_controlled ) && !is_distant( critter ) ) {
+                critter.expected_sight_lines( lines );
+            }
+        }
+        m.sees_batch( lines );
+    }
 
     for( monster &critter : all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
@@ -4126,14 +4408,30 @@ void game::monmove()
             }
             critter.try_reproduce();
         }
+        const bool distant = is_distant( critter );
+        if( distant && ++critter.distant_turns < distant_monster_turns ) {
+            // The moves of skipped turns are kept for the turn it plans again
+            continue;
+        }
+        if( !distant && critter.distant_turns > 0 ) {
+            // Noticed something, it doesn't get to catch up all at once
+            critter.moves = std::min( critter.moves, critter.get_speed() );
+        }
+        critter.distant_turns = 0;
+        bool planned = false;
         while( critter.moves > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
-            if( !critter.has_effect( effect_ai_controlled ) ) {
+            if( !critter.has_effect( effect_ai_controlled ) && ( !distant || !planned ) ) {
                 // Formulate a path to follow
+                const monster_turn_stats::phase_timer timer( monster_phase::plan );
                 critter.plan();
+                planned = true;
+            }
+            {
+                const monster_turn_stats::phase_timer timer( monster_phase::move );
+                critter.move(); // Move one square, possibly hit u
             }
-            critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
             m.creature_in_field( critter );
         }
@@ -4169,7 +4467,34 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    // Deciding what to do is shared out, a few NPCs each turn. Those fighting or near you
+    // always get to, the rest go by how long they've waited and otherwise carry on with
+    // what they were doing, or keep their moves for when they get to decide.
+    // It's counted in decisions rather than time so that replays and saves play out the same.
+    const int npc_budget = get_option<int>( "NPC_AI_BUDGET" );
+    constexpr int npc_detail_distance = 2 * SEEX;
+    constexpr int max_deferred_npc_turns = 4;
+    const auto is_urgent = [&]( const npc & guy ) {
+        return guy.in_danger() || guy.is_enemy() || rl_dist( guy.pos(), u.pos() ) <= npc_detail_distance;
+    };
+    std::vector<npc *> active_npcs;
     for( npc &guy : g->all_npcs() ) {
+        active_npcs.push_back( &guy );
+    }
+    if( npc_budget > 0 ) {
+        std::stable_sort( active_npcs.begin(), active_npcs.end(), [&]( const npc * a, const npc * b ) {
+            const bool a_urgent = is_urgent( *a );
+            const bool b_urgent = is_urgent( *b );
+            if( a_urgent != b_urgent ) {
+                return a_urgent;
+            }
+            return a->deferred_turns > b->deferred_turns;
+        } );
+    }
+    int npc_decisions = 0;
+    for( npc *guy_ptr : active_npcs ) {
+        npc &guy = *guy_ptr;
+        const pathfinding_stats::caller_scope npc_tag( route_caller::npc );
         int turns = 0;
         if( guy.is_mounted() ) {
             guy.check_mount_is_spooked();
@@ -4178,11 +4503,23 @@ void game::monmove()
         if( !guy.has_effect( effect_npc_suspend ) ) {
             guy.process_turn();
         }
+        const bool urgent = is_urgent( guy );
+        const bool deferred = npc_budget > 0 && !urgent && npc_decisions >= npc_budget &&
+                              guy.deferred_turns < max_deferred_npc_turns;
+        guy.deferred_turns = deferred ? guy.deferred_turns + 1 : 0;
+        if( !deferred && !urgent ) {
+            npc_decisions++;
+        }
         while( !guy.is_dead() && guy.moves > 0 && turns < 10 &&
                ( !guy.in_sleep_state() || guy.activity->id() == ACT_OPERATION )
              ) {
             int moves = guy.moves;
-            guy.move();
+            if( !deferred ) {
+                guy.move();
+            } else if( !guy.continue_action() ) {
+                // The moves are kept for when it decides again
+                break;
+            }
             if( moves == guy.moves ) {
                 // Count every time we exit npc::move() without spending any moves.
                 turns++;
@@ -4215,6 +4552,7 @@ void game::monmove()
 void game::overmap_npc_move()
 {
     ZoneScoped;
+    const pathfinding_stats::caller_scope tag( route_caller::npc );
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
     for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
@@ -4227,6 +4565,7 @@ void game::overmap_npc_move()
             travelling_npcs.push_back( npc_to_add );
         }
     }
+    bool moved = false;
     for( auto &elem : travelling_npcs ) {
         if( elem->has_omt_destination() ) {
             if( !elem->omt_path.empty() && rl_dist( elem->omt_path.back(), elem->global_omt_location() ) > 2 ) {
@@ -4251,11 +4590,14 @@ void game::overmap_npc_move()
                 // TODO: fix point types
                 elem->travel_overmap(
                     project_to<coords::sm>( elem->omt_path.back() ).raw() );
+                moved = true;
             }
-            reload_npcs();
         }
     }
-    return;
+    // Once for all of them, reloading unloads and places every active NPC again
+    if( moved ) {
+        reload_npcs();
+    }
 }
 
 /* Knockback target at t by force number of tiles in direction from s to t
@@ -4339,13 +4681,13 @@ void game::knockback( std::vector<tripoint> &traj, int stun, int dam_mult,
                 break;
             }
             targ->setpos( traj[i] );
-            if( m.has_flag( "LIQUID", targ->pos() ) && targ->can_drown() && !targ->is_dead() ) {
+            if( m.has_flag( TFLAG_LIQUID, targ->pos() ) && targ->can_drown() && !targ->is_dead() ) {
                 targ->die( source );
                 if( u.sees( *targ ) ) {
                     add_msg( _( "The %s drowns!" ), targ->name() );
                 }
             }
-            if( !m.has_flag( "LIQUID", targ->pos() ) && targ->has_flag( MF_AQUATIC ) &&
+            if( !m.has_flag( TFLAG_LIQUID, targ->pos() ) && targ->has_flag( MF_AQUATIC ) &&
                 !targ->is_dead() ) {
                 targ->die( source );
                 if( u.sees( *targ ) ) {
@@ -4506,7 +4848,7 @@ void game::knockback( std::vector<tripoint> &traj, int stun, int dam_mult,
                 knockback( traj, stun, dam_mult, source );
                 break;
             }
-            if( m.has_flag( "LIQUID", u.pos() ) && force_remaining == 0 ) {
+            if( m.has_flag( TFLAG_LIQUID, u.pos() ) && force_remaining == 0 ) {
                 avatar_action::swim( m, u, u.pos() );
             } else {
                 u.setpos( traj[i] );
@@ -4687,7 +5029,7 @@ monster *game::place_critter_around( const mtype_id &id, const tripoint &center,
     if( id.is_null() ) {
         return nullptr;
     }
-    return place_critter_around( make_shared_fast<monster>( id ), center, radius );
+    return place_critter_around( make_shared_pooled<monster>( id ), center, radius );
 }
 
 monster *game::place_critter_around( const shared_ptr_fast<monster> &mon,
@@ -4719,7 +5061,7 @@ monster *game::place_critter_within( const mtype_id &id, const tripoint_range<tr
     if( id.is_null() ) {
         return nullptr;
     }
-    return place_critter_within( make_shared_fast<monster>( id ), range );
+    return place_critter_within( make_shared_pooled<monster>( id ), range );
 }
 
 monster *game::place_critter_within( const shared_ptr_fast<monster> &mon,
@@ -4775,7 +5117,7 @@ bool game::spawn_hallucination( const tripoint &p )
     }
 
     const mtype_id &mt = MonsterGenerator::generator().get_valid_hallucination();
-    const shared_ptr_fast<monster> phantasm = make_shared_fast<monster>( mt );
+    const shared_ptr_fast<monster> phantasm = make_shared_pooled<monster>( mt );
     phantasm->hallucination = true;
     phantasm->spawn( p );
 
@@ -4859,7 +5201,7 @@ bool game::swap_critters( Creature &a, Creature &b )
 
 bool game::is_empty( const tripoint &p )
 {
-    return ( m.passable( p ) || m.has_flag( "LIQUID", p ) ) &&
+    return ( m.passable( p ) || m.has_flag( TFLAG_LIQUID, p ) ) &&
            critter_at( p ) == nullptr;
 }
 
@@ -4879,7 +5221,7 @@ bool game::revive_corpse( const tripoint &p, item &it )
         debugmsg( "Tried to revive a non-corpse." );
         return false;
     }
-    shared_ptr_fast<monster> newmon_ptr = make_shared_fast<monster>
+    shared_ptr_fast<monster> newmon_ptr = make_shared_pooled<monster>
                                           ( it.get_mtype()->id );
     monster &critter = *newmon_ptr;
     critter.init_from_item( it );
@@ -5130,7 +5472,7 @@ bool game::forced_door_closing( const tripoint &p, const ter_id &door_type, int
     }
 
     m.ter_set( p, door_type );
-    if( m.has_flag( "NOITEM", p ) ) {
+    if( m.has_flag( TFLAG_NOITEM, p ) ) {
         map_stack items = m.i_at( p );
         for( map_stack::iterator it = items.begin(); it != items.end(); ) {
             if( ( *it )->made_of( LIQUID ) ) {
@@ -5183,7 +5525,7 @@ void game::moving_vehicle_dismount( const tripoint &dest_loc )
     // Dive three tiles in the direction of tox and toy
     fling_creature( &u, d, 30, true );
     // Hit the ground according to vehicle speed
-    if( !m.has_flag( "SWIMMABLE", u.pos() ) ) {
+    if( !m.has_flag( TFLAG_SWIMMABLE, u.pos() ) ) {
         if( veh->velocity > 0 ) {
             fling_creature( &u, veh->face.dir(), veh->velocity / static_cast<float>( 100 ) );
         } else {
@@ -5610,9 +5952,9 @@ void game::examine( const tripoint &examp )
         add_msg( fire_fuel );
     }
 
-    if( m.has_flag( "SEALED", examp ) ) {
+    if( m.has_flag( TFLAG_SEALED, examp ) ) {
         if( none ) {
-            if( m.has_flag( "UNSTABLE", examp ) ) {
+            if( m.has_flag( TFLAG_UNSTABLE, examp ) ) {
                 add_msg( _( "The %s is too unstable to remove anything." ), m.name( examp ) );
             } else {
                 add_msg( _( "The %s is firmly sealed." ), m.name( examp ) );
@@ -8385,7 +8727,7 @@ void game::butcher()
     const std::string no_corpse_msg = _( "There are no corpses here to butcher." );
 
     //You can't butcher on sealed terrain- you have to smash/shovel/etc it open first
-    if( m.has_flag( "SEALED", u.pos() ) ) {
+    if( m.has_flag( TFLAG_SEALED, u.pos() ) ) {
         if( m.sees_some_items( u.pos(), u ) ) {
             add_msg( m_info, _( "You can't access the items here." ) );
         } else if( factor > INT_MIN || factorD > INT_MIN ) {
@@ -8756,11 +9098,11 @@ std::vector<std::string> game::get_dangerous_tile( const tripoint &dest_loc ) co
             return character_funcs::is_bp_immune_to( u, bp, { DT_CUT, 10 } );
         };
 
-        if( m.has_flag( "ROUGH", dest_loc ) && !m.has_flag( "ROUGH", u.pos() ) && !boardable &&
+        if( m.has_flag( TFLAG_ROUGH, dest_loc ) && !m.has_flag( TFLAG_ROUGH, u.pos() ) && !boardable &&
             ( u.get_armor_bash( bodypart_id( "foot_l" ) ) < 5 ||
               u.get_armor_bash( bodypart_id( "foot_r" ) ) < 5 ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
-        } else if( m.has_flag( "SHARP", dest_loc ) && !m.has_flag( "SHARP", u.pos() ) && !( u.in_vehicle ||
+        } else if( m.has_flag( TFLAG_SHARP, dest_loc ) && !m.has_flag( TFLAG_SHARP, u.pos() ) && !( u.in_vehicle ||
                    m.veh_at( dest_loc ) ) &&
                    u.dex_cur < 78 && !std::all_of( sharp_bps.begin(), sharp_bps.end(), sharp_bp_check ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
@@ -8968,8 +9310,8 @@ bool game::walk_move( const tripoint &dest_loc, const bool via_ramp )
 
     // Print a message if movement is slow
     const int mcost_to = m.move_cost( dest_loc ); //calculate this _after_ calling grabbed_move
-    const bool fungus = m.has_flag_ter_or_furn( "FUNGUS", u.pos() ) ||
-                        m.has_flag_ter_or_furn( "FUNGUS",
+    const bool fungus = m.has_flag_ter_or_furn( TFLAG_FUNGUS, u.pos() ) ||
+                        m.has_flag_ter_or_furn( TFLAG_FUNGUS,
                                 dest_loc ); //fungal furniture has no slowing effect on mycus characters
     const bool slowed = ( ( !u.has_trait( trait_PARKOUR ) && ( mcost_to > 2 || mcost_from > 2 ) ) ||
                           mcost_to > 4 || mcost_from > 4 ) &&
@@ -9006,7 +9348,7 @@ bool game::walk_move( const tripoint &dest_loc, const bool via_ramp )
         ///\EFFECT_DEX decreases chance of tentacles getting stuck to the ground
 
         ///\EFFECT_INT decreases chance of tentacles getting stuck to the ground
-        if( !m.has_flag( "SWIMMABLE", dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
+        if( !m.has_flag( TFLAG_SWIMMABLE, dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
             add_msg( _( "Your tentacles stick to the ground, but you pull them free." ) );
             u.mod_fatigue( 1 );
         }
@@ -9117,22 +9459,22 @@ point game::place_player( const tripoint &dest_loc )
         }
     }
     // TODO: Move the stuff below to a Character method so that NPCs can reuse it
-    if( m.has_flag( "ROUGH", dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
+    if( m.has_flag( TFLAG_ROUGH, dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_l" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your left foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( TFLAG_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_r" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your right foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( TFLAG_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
     }
     ///\EFFECT_DEX increases chance of avoiding cuts on sharp terrain
-    if( m.has_flag( "SHARP", dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
+    if( m.has_flag( TFLAG_SHARP, dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
         ( !u.in_vehicle && !m.veh_at( dest_loc ) ) && ( !u.has_trait( trait_PARKOUR ) ||
                 one_in( 4 ) ) && ( u.has_trait( trait_THICKSKIN ) ? !one_in( 8 ) : true ) ) {
         if( u.is_mounted() ) {
@@ -9144,12 +9486,12 @@ point game::place_player( const tripoint &dest_loc )
                 //~ 1$s - bodypart name in accusative, 2$s is terrain name.
                 add_msg( m_bad, _( "You cut your %1$s on the %2$s!" ),
                          body_part_name_accusative( bp->token ),
-                         m.has_flag_ter( "SHARP", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                         m.has_flag_ter( TFLAG_SHARP, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                              dest_loc ) );
             }
         }
     }
-    if( m.has_flag( "UNSTABLE", dest_loc ) && !u.is_mounted() ) {
+    if( m.has_flag( TFLAG_UNSTABLE, dest_loc ) && !u.is_mounted() ) {
         u.add_effect( effect_bouldering, 1_turns, bodypart_str_id::NULL_ID() );
     } else if( u.has_effect( effect_bouldering ) ) {
         u.remove_effect( effect_bouldering );
@@ -9161,7 +9503,7 @@ point game::place_player( const tripoint &dest_loc )
     }
 
     // If we moved out of the nonant, we need update our map data
-    if( m.has_flag( "SWIMMABLE", dest_loc ) && u.has_effect( effect_onfire ) ) {
+    if( m.has_flag( TFLAG_SWIMMABLE, dest_loc ) && u.has_effect( effect_onfire ) ) {
         add_msg( _( "The water puts out the flames!" ) );
         u.remove_effect( effect_onfire );
         if( u.is_mounted() ) {
@@ -9333,14 +9675,14 @@ point game::place_player( const tripoint &dest_loc )
         m.creature_on_trap( u );
     }
     // Drench the player if swimmable
-    if( m.has_flag( "SWIMMABLE", u.pos() ) &&
+    if( m.has_flag( TFLAG_SWIMMABLE, u.pos() ) &&
         !( u.is_mounted() || ( u.in_vehicle && vp1->vehicle().can_float() ) ) ) {
         u.drench( 40, { { bodypart_str_id( "foot_l" ), bodypart_str_id( "foot_r" ), bodypart_str_id( "leg_l" ), bodypart_str_id( "leg_r" ) } },
         false );
     }
 
     // List items here
-    if( !m.has_flag( "SEALED", u.pos() ) ) {
+    if( !m.has_flag( TFLAG_SEALED, u.pos() ) ) {
         if( get_option<bool>( "NO_AUTO_PICKUP_ZONES_LIST_ITEMS" ) ||
             !check_zone( zone_type_id( "NO_AUTO_PICKUP" ), u.pos() ) ) {
             if( u.is_blind() && !m.i_at( u.pos() ).empty() && u.clairvoyance() < 1 ) {
@@ -9565,7 +9907,7 @@ bool game::grabbed_furn_move( const tripoint &dp )
                              critter_at<npc>( fdest ) == nullptr &&
                              critter_at<monster>( fdest ) == nullptr &&
                              ( !pulling_furniture || is_empty( u.pos() + dp ) ) &&
-                             ( !has_floor || m.has_flag( "FLAT", fdest ) ) &&
+                             ( !has_floor || m.has_flag( TFLAG_FLAT, fdest ) ) &&
                              !m.has_furn( fdest ) &&
                              !m.veh_at( fdest ) &&
                              ( !has_floor || m.tr_at( fdest ).is_null() )
@@ -9580,9 +9922,9 @@ bool game::grabbed_furn_move( const tripoint &dp )
         return liquid_item->made_of( LIQUID );
     } );
 
-    const bool dst_item_ok = !m.has_flag( "NOITEM", fdest ) &&
-                             !m.has_flag( "SWIMMABLE", fdest ) &&
-                             !m.has_flag( "DESTROY_ITEM", fdest );
+    const bool dst_item_ok = !m.has_flag( TFLAG_NOITEM, fdest ) &&
+                             !m.has_flag( TFLAG_SWIMMABLE, fdest ) &&
+                             !m.has_flag( TFLAG_DESTROY_ITEM, fdest );
 
     const bool src_item_ok = m.furn( fpos ).obj().has_flag( "CONTAINER" ) ||
                              m.furn( fpos ).obj().has_flag( "FIRE_CONTAINER" ) ||
@@ -9775,6 +10117,7 @@ void game::on_move_effects()
 
 void game::on_options_changed()
 {
+    panel_manager::get_manager().forget_drawn();
 #if defined(TILES)
     tilecontext->on_options_changed();
 #endif
@@ -9915,7 +10258,7 @@ void game::fling_creature( Creature *c, const units::angle &dir, float flvel, bo
     }
 
     // Fall down to the ground - always on the last reached tile
-    if( !m.has_flag( "SWIMMABLE", c->pos() ) ) {
+    if( !m.has_flag( TFLAG_SWIMMABLE, c->pos() ) ) {
         const trap_id trap_under_creature = m.tr_at( c->pos() ).loadid;
         // Didn't smash into a wall or a floor so only take the fall damage
         if( thru && trap_under_creature == tr_ledge ) {
@@ -10013,7 +10356,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
     bool climbing = false;
     int move_cost = 100;
     tripoint stairs( u.posx(), u.posy(), u.posz() + movez );
-    if( m.has_zlevels() && !force && movez == 1 && !m.has_flag( "GOES_UP", u.pos() ) &&
+    if( m.has_zlevels() && !force && movez == 1 && !m.has_flag( TFLAG_GOES_UP, u.pos() ) &&
         !u.is_underwater() ) {
         // Climbing
         if( m.has_floor_or_support( stairs ) ) {
@@ -10077,11 +10420,11 @@ void game::vertical_move( int movez, bool force, bool peeking )
         }
     }
 
-    if( !force && movez == -1 && !m.has_flag( "GOES_DOWN", u.pos() ) &&
+    if( !force && movez == -1 && !m.has_flag( TFLAG_GOES_DOWN, u.pos() ) &&
         !u.is_underwater() ) {
         add_msg( m_info, _( "You can't go down here!" ) );
         return;
-    } else if( !climbing && !force && movez == 1 && !m.has_flag( "GOES_UP", u.pos() ) &&
+    } else if( !climbing && !force && movez == 1 && !m.has_flag( TFLAG_GOES_UP, u.pos() ) &&
                !u.is_underwater() ) {
         add_msg( m_info, _( "You can't go up here!" ) );
         return;
@@ -10271,7 +10614,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
         // Store a *copy* of the mount, so we can remove the original monster instance
         // from the tracker before the map shifts.
         // Map shifting would otherwise just despawn the mount and would later respawn it.
-        stored_mount = make_shared_fast<monster>( *u.mounted_creature );
+        stored_mount = make_shared_pooled<monster>( *u.mounted_creature );
         critter_tracker->remove( *u.mounted_creature );
     }
     if( !m.has_zlevels() ) {
@@ -10289,7 +10632,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
                 && !slippedpast ) {
                 critter.staircount = 10 + turns;
                 critter.on_unload();
-                coming_to_stairs.push_back( make_shared_fast<monster>( critter ) );
+                coming_to_stairs.push_back( make_shared_pooled<monster>( critter ) );
                 remove_zombie( critter );
             }
         }
@@ -10601,12 +10944,12 @@ std::optional<tripoint> game::find_or_make_stairs( map &mp, const int z_after, b
     }
 
     if( movez > 0 ) {
-        if( mp.has_flag( "DEEP_WATER", *stairs ) ) {
+        if( mp.has_flag( TFLAG_DEEP_WATER, *stairs ) ) {
             if( !query_yn(
                     _( "There is a huge blob of water!  You may be unable to return back down these stairs.  Continue up?" ) ) ) {
                 return std::nullopt;
             }
-        } else if( !mp.has_flag( "GOES_DOWN", *stairs ) ) {
+        } else if( !mp.has_flag( TFLAG_GOES_DOWN, *stairs ) ) {
             if( !query_yn( _( "You may be unable to return back down these stairs.  Continue up?" ) ) ) {
                 return std::nullopt;
             }
@@ -10833,14 +11176,7 @@ point game::update_map( int &x, int &y )
     // Put those in the active list.
     load_npcs();
 
-    // Make sure map cache is consistent since it may have shifted.
-    if( m.has_zlevels() ) {
-        for( int zlev = -OVERMAP_DEPTH; zlev <= OVERMAP_HEIGHT; ++zlev ) {
-            m.invalidate_map_cache( zlev );
-        }
-    } else {
-        m.invalidate_map_cache( get_levz() );
-    }
+    // map::shift moved the caches along and marked what the new submaps change
     m.build_map_cache( get_levz() );
 
     // Spawn monsters if appropriate
@@ -10857,9 +11193,21 @@ void game::update_overmap_seen()
 {
     const tripoint_abs_omt ompos = u.global_omt_location();
     const int dist = u.overmap_sight_range( light_level( u.posz() ) );
+    // Everything in sight was marked the last time, unless the overmaps were reloaded since
+    if( ompos == overmap_seen_origin && dist == overmap_seen_range &&
+        overmap_buffer.seen( ompos ) ) {
+        return;
+    }
+    overmap_seen_origin = ompos;
+    overmap_seen_range = dist;
     const int dist_squared = dist * dist;
     // We can always see where we're standing
     overmap_buffer.set_seen( ompos, true );
+    // Tiles seen from here are seen all the way down to the ground level
+    const auto already_seen = []( const tripoint_abs_omt & p ) {
+        return overmap_buffer.seen( p ) &&
+               ( p.z() <= 0 || overmap_buffer.seen( tripoint_abs_omt( p.xy(), 0 ) ) );
+    };
     for( const tripoint_abs_omt &p : points_in_radius( ompos, dist ) ) {
         const point_rel_omt delta = p.xy() - ompos.xy();
         const int h_squared = delta.x() * delta.x() + delta.y() * delta.y();
@@ -10871,6 +11219,10 @@ void game::update_overmap_seen()
             // 2. Calculating multiplier would cause division by zero
             continue;
         }
+        // Most of the circle was already seen from the previous tile, only the edge is new
+        if( already_seen( p ) ) {
+            continue;
+        }
         // If circular distances are enabled, scale overmap distances by the diagonality of the sight line.
         point abs_delta = delta.raw().abs();
         int max_delta = std::max( abs_delta.x, abs_delta.y );
@@ -10927,8 +11279,8 @@ void game::update_stair_monsters()
     }
 
     for( const tripoint &dest : m.points_on_zlevel( u.posz() ) ) {
-        if( ( from_below && m.has_flag( "GOES_DOWN", dest ) ) ||
-            ( !from_below && m.has_flag( "GOES_UP", dest ) ) ) {
+        if( ( from_below && m.has_flag( TFLAG_GOES_DOWN, dest ) ) ||
+            ( !from_below && m.has_flag( TFLAG_GOES_UP, dest ) ) ) {
             stairx.push_back( dest.x );
             stairy.push_back( dest.y );
             stairdist.push_back( rl_dist( dest, u.pos() ) );
@@ -11005,7 +11357,7 @@ void game::update_stair_monsters()
         if( is_empty( dest ) ) {
             critter.spawn( dest );
             critter.staircount = 0;
-            place_critter_at( make_shared_fast<monster>( critter ), dest );
+            place_critter_at( make_shared_pooled<monster>( critter ), dest );
             if( u.sees( dest ) ) {
                 if( !from_below ) {
                     add_msg( m_warning, _( "The %1$s comes down the %2$s!" ),
@@ -11388,7 +11740,7 @@ void game::init_autosave()
     last_save_timestamp = time( nullptr );
 }
 
-void game::quicksave()
+void game::quicksave( bool background )
 {
     //Don't autosave if the player hasn't done anything since the last autosave/quicksave,
     if( !moves_since_last_save ) {
@@ -11404,7 +11756,7 @@ void game::quicksave()
     time_t now = time( nullptr ); //timestamp for start of saving procedure
 
     //perform save
-    save( false );
+    save( false, background );
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -11439,7 +11791,8 @@ void game::autosave()
     if( time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
         return;
     }
-    quicksave();    //Driving checks are handled by quicksave()
+    //Driving checks are handled by quicksave()
+    quicksave( get_option<bool>( "AUTOSAVE_BACKGROUND" ) );
 }
 
 void game::process_artifact( item &it, player &p )
@@ -12039,6 +12392,35 @@ std::vector<Creature *> game::get_creatures_if( const std::function<bool( const
     return result;
 }
 
+std::vector<Creature *> game::get_creatures_in_radius( const tripoint &center, const int radius,
+        const std::function<bool( const Creature & )> &pred )
+{
+    std::vector<Creature *> result;
+    for( const shared_ptr_fast<monster> &critter : critter_tracker->find_in_radius( center, radius ) ) {
+        if( pred( *critter ) ) {
+            result.push_back( critter.get() );
+        }
+    }
+    for( npc &guy : all_npcs() ) {
+        if( rl_dist( center, guy.pos() ) <= radius && pred( guy ) ) {
+            result.push_back( &guy );
+        }
+    }
+    if( rl_dist( center, u.pos() ) <= radius && pred( u ) ) {
+        result.push_back( &u );
+    }
+    return result;
+}
+
+std::vector<monster *> game::get_monsters_in_radius( const tripoint &center, const int radius )
+{
+    std::vector<monster *> result;
+    for( const shared_ptr_fast<monster> &critter : critter_tracker->find_in_radius( center, radius ) ) {
+        result.push_back( critter.get() );
+    }
+    return result;
+}
+
 std::vector<npc *> game::get_npcs_if( const std::function<bool( const npc & )> &pred )
 {
     std::vector<npc *> result;
@@ -12187,6 +12569,11 @@ distribution_grid_tracker &get_distribution_grid_tracker()
     return *g->grid_tracker_ptr;
 }
 
+simulation_areas &get_simulation_areas()
+{
+    return *g->simulation_areas_ptr;
+}
+
 void cleanup_arenas()
 {
     bool cont = true;
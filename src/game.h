@@ -41,6 +41,7 @@ static constexpr int DEFAULT_TILESET_ZOOM = 16;
 
 static const std::string SAVE_MASTER( "master.gsav" );
 static const std::string SAVE_ARTIFACTS( "artifacts.gsav" );
+static const std::string SAVE_JOURNAL( "save.journal" );
 static const std::string SAVE_EXTENSION( ".sav" );
 static const std::string SAVE_EXTENSION_LOG( ".log" );
 static const std::string SAVE_EXTENSION_WEATHER( ".weather" );
@@ -112,6 +113,7 @@ class ui_adaptor;
 struct visibility_variables;
 
 class distribution_grid_tracker;
+class simulation_areas;
 struct weather_printable;
 class weather_manager;
 
@@ -145,6 +147,7 @@ class game
         friend class advanced_inventory;
         friend class main_menu;
         friend distribution_grid_tracker &get_distribution_grid_tracker();
+        friend simulation_areas &get_simulation_areas();
         friend map &get_map();
         friend Character &get_player_character();
         friend avatar &get_avatar();
@@ -184,7 +187,11 @@ class game
         bool dump_stats( const std::string &what, dump_mode mode, const std::vector<std::string> &opts );
 
         /** Returns false if saving failed. */
-        bool save( bool quitting );
+        /**
+         * @param background write map files on a background thread, see @ref background_saver.
+         * Everything else is still written before this returns.
+         */
+        bool save( bool quitting, bool background = false );
 
         /** Returns a list of currently active character saves. */
         std::vector<std::string> list_active_saves();
@@ -193,6 +200,20 @@ class game
         void start_calendar();
         /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
         bool do_turn();
+        /** Monster movement, the monsters' part of @ref do_turn. */
+        void monmove();
+        /**
+         * Whether the coming turns can be fast-forwarded: the avatar is asleep or just waiting,
+         * and nothing hostile is close by or after anything. Such turns rebuild the map caches
+         * only every few turns and let all wandering monsters plan less often, see
+         * @ref fast_forwarding. Checked again each turn, so anything showing up ends it.
+         */
+        bool can_fast_forward();
+        /**
+         * Whether the avatar travels with no creature in view distance, so the map caches
+         * aren't needed to notice danger and can wait for the next redraw.
+         */
+        bool can_defer_travel_map_cache();
         shared_ptr_fast<ui_adaptor> create_or_get_main_ui_adaptor();
         void invalidate_main_ui_adaptor() const;
         void mark_main_ui_adaptor_resize() const;
@@ -420,6 +441,14 @@ class game
          * are checked ( and returned ). Returned pointers are never null.
          */
         std::vector<Creature *> get_creatures_if( const std::function<bool( const Creature & )> &pred );
+        /**
+         * Same as @ref get_creatures_if, but only for creatures within @p radius (as of @ref rl_dist)
+         * of @p center. Monsters are looked up by area instead of checking every one of them.
+         */
+        std::vector<Creature *> get_creatures_in_radius( const tripoint &center, int radius,
+                const std::function<bool( const Creature & )> &pred );
+        /** Living monsters within @p radius (as of @ref rl_dist) of @p center. */
+        std::vector<monster *> get_monsters_in_radius( const tripoint &center, int radius );
         std::vector<npc *> get_npcs_if( const std::function<bool( const npc & )> &pred );
         /**
          * Returns a creature matching a predicate. Only living (not dead) creatures
@@ -730,9 +759,10 @@ class game
         // Regular movement. Returns false if it failed for any reason
         bool walk_move( const tripoint &dest, bool via_ramp = false );
         void on_move_effects();
+        // Load a player-specific save file of the active world
+        bool load( const save_t &name );
     private:
         // Game-start procedures
-        bool load( const save_t &name ); // Load a player-specific save file
         void load_master(); // Load the master data file, with factions &c
 #if defined(__ANDROID__)
         void load_shortcuts( std::istream &fin );
@@ -741,13 +771,14 @@ class game
 
         //private save functions.
         // returns false if saving failed for whatever reason
-        bool save_factions_missions_npcs();
+        // background: queue the file to the background saver instead of writing it right away
+        bool save_factions_missions_npcs( bool background = false );
         void reset_npc_dispositions();
         void serialize_master( std::ostream &fout );
         // returns false if saving failed for whatever reason
         bool save_artifacts();
         // returns false if saving failed for whatever reason
-        bool save_maps();
+        bool save_maps( bool background = false );
 #if defined(__ANDROID__)
         void save_shortcuts( std::ostream &fout );
 #endif
@@ -862,7 +893,6 @@ class game
         void perhaps_add_random_npc();
 
         // Routine loop functions, approximately in order of execution
-        void monmove();          // Monster movement
         void overmap_npc_move(); // NPC overmap movement
         void process_voluntary_act_interrupt(); // Process
         void process_activity(); // Processes and enacts the player's activity
@@ -886,7 +916,7 @@ class game
         //  int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
         void autosave();         // automatic quicksaves - Performs some checks before calling quicksave()
     public:
-        void quicksave();        // Saves the game without quitting
+        void quicksave( bool background = false ); // Saves the game without quitting
         void disp_NPCs();        // Currently for debug use.  Lists global NPCs.
 
         void list_missions();       // Listed current, completed and failed missions (mission_ui.cpp)
@@ -927,7 +957,7 @@ class game
         Creature *is_hostile_within( int distance );
 
         void move_save_to_graveyard( const std::string &dirname );
-        bool save_player_data();
+        bool save_player_data( bool background = false );
         // ########################## DATA ################################
     private:
         // May be a bit hacky, but it's probably better than the header spaghetti
@@ -944,6 +974,7 @@ class game
         pimpl<memorial_logger> memorial_logger_ptr;
         pimpl<spell_events> spell_events_ptr;
         pimpl<distribution_grid_tracker> grid_tracker_ptr;
+        pimpl<simulation_areas> simulation_areas_ptr;
         pimpl<weather_manager> weather_manager_ptr;
 
     public:
@@ -1037,6 +1068,15 @@ class game
         bool critter_died = false;
         /** Is this the first redraw since waiting (sleeping or activity) started */
         bool first_redraw_since_waiting_started = true;
+        /** Whether this turn is fast-forwarded, see @ref can_fast_forward. */
+        bool fast_forwarding = false;
+        /** Whether the map caches were last built some turns ago, by fast-forward or travel. */
+        bool map_cache_stale = false;
+        /** When the screen was last redrawn while waiting or travelling. */
+        std::chrono::steady_clock::time_point last_wait_redraw;
+        /** Where update_overmap_seen last looked from and how far, to skip repeating it. */
+        tripoint_abs_omt overmap_seen_origin;
+        int overmap_seen_range = -1;
         /** Is Zone manager open or not - changes graphics of some zone tiles */
         bool zones_manager_open = false;
 
@@ -29,6 +29,10 @@ class game_object
         friend location_visitable<location_inventory>;
         template<typename U>
         friend void ::std::swap( location_vector<U> &, location_vector<U> & ) noexcept ;
+        friend safe_reference<T>;
+
+        /** The record of the safe references to this object, null until one is taken. */
+        typename safe_reference<T>::record *safe_ref_record = nullptr;
     protected:
         location<T> *saved_loc = nullptr;
         location<T> *loc = nullptr;
@@ -36,6 +40,10 @@ class game_object
         game_object() = default;
 
         game_object( const game_object & ) {}
+        // Like a copy, the object keeps its own location and safe references
+        game_object &operator=( const game_object & ) {
+            return *this;
+        }
 
         void destroy();
         void destroy_in_place();
@@ -48,7 +56,12 @@ class game_object
 
     public:
 
-        virtual ~game_object() = default;
+        virtual ~game_object() {
+            // References left to this object must not see it any more
+            if( safe_ref_record != nullptr ) {
+                safe_ref_record->target.p = nullptr;
+            }
+        }
 
         detached_ptr<T> detach();
 
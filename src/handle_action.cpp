@@ -71,6 +71,7 @@
 #include "output.h"
 #include "overmap_ui.h"
 #include "panels.h"
+#include "pathfinding_stats.h"
 #include "player.h"
 #include "player_activity.h"
 #include "popup.h"
@@ -821,7 +822,7 @@ static void smash()
             }
         }
 
-        if( !here.has_floor_or_support( u.pos() ) && !here.has_flag_ter( "GOES_DOWN", u.pos() ) ) {
+        if( !here.has_floor_or_support( u.pos() ) && !here.has_flag_ter( TFLAG_GOES_DOWN, u.pos() ) ) {
             std::optional<tripoint> to_safety;
             while( true ) {
                 to_safety = choose_direction( _( "Floor below destroyed!  Move where?" ) );
@@ -1532,6 +1533,7 @@ void game::open_consume_item_menu()
 
 bool game::handle_action()
 {
+    const pathfinding_stats::caller_scope tag( route_caller::player );
     std::string action;
     input_context ctxt;
     action_id act = ACTION_NULL;
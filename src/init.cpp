@@ -1,14 +1,20 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <exception>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "achievement.h"
@@ -21,6 +27,7 @@
 #include "behavior.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "catalua.h"
 #include "cata_utility.h"
 #include "clothing_mod.h"
@@ -42,6 +49,7 @@
 #include "faction.h"
 #include "fault.h"
 #include "field_type.h"
+#include "file_prefetcher.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
 #include "flag.h"
@@ -82,6 +90,7 @@
 #include "overmap_location.h"
 #include "overmap_special.h"
 #include "profession.h"
+#include "profile.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
 #include "regional_settings.h"
@@ -95,6 +104,7 @@
 #include "sounds.h"
 #include "speech.h"
 #include "start_location.h"
+#include "startup_timings.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
 #include "translations.h"
@@ -133,6 +143,7 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     if( it == type_function_map.end() ) {
         jo.throw_error( "unrecognized JSON object", "type" );
     }
+    startup_timings::timer timing( "loader", type );
     it->second( jo, src, base_path, full_path );
 }
 
@@ -140,6 +151,63 @@ struct DynamicDataLoader::cached_streams {
     lru_cache<std::string, shared_ptr_fast<std::istringstream>> cache;
 };
 
+namespace
+{
+
+/** A data file's contents, and the size and modification time of the file when it was read. */
+struct kept_data_file {
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size = 0;
+    std::string contents;
+};
+
+// The data files read by the last load, and the ones read so far by the current one.
+// Loading the same mods again, e.g. for another world using them, only has to read
+// the files that changed since.
+std::unordered_map<std::string, kept_data_file> previous_data_files;
+std::unordered_map<std::string, kept_data_file> current_data_files;
+int data_files_kept = 0;
+int data_files_read = 0;
+
+std::optional<kept_data_file> stat_data_file( const std::string &file )
+{
+    const std::filesystem::path path( file );
+    std::error_code ec;
+    kept_data_file ret;
+    ret.mtime = std::filesystem::last_write_time( path, ec );
+    if( !ec ) {
+        ret.size = std::filesystem::file_size( path, ec );
+    }
+    if( ec ) {
+        return std::nullopt;
+    }
+    return ret;
+}
+
+/** Whether @p file is kept from the last load unchanged, moving it to the current load's files. */
+bool keep_data_file( const std::string &file, const std::optional<kept_data_file> &stat )
+{
+    if( !stat ) {
+        return false;
+    }
+    const auto is_current = [&]( const kept_data_file & kept ) {
+        return kept.mtime == stat->mtime && kept.size == stat->size;
+    };
+    const auto current = current_data_files.find( file );
+    if( current != current_data_files.end() && is_current( current->second ) ) {
+        return true;
+    }
+    const auto previous = previous_data_files.find( file );
+    if( previous == previous_data_files.end() || !is_current( previous->second ) ) {
+        return false;
+    }
+    current_data_files[file] = std::move( previous->second );
+    previous_data_files.erase( previous );
+    return true;
+}
+
+} // namespace
+
 shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::string &path )
 {
     assert( !finalized && "Cannot open data file after finalization." );
@@ -149,7 +217,9 @@ shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::s
     // using the previous stream (in such case, `cached` and `stream_cache` have
     // two references to the stream, hence the test for > 2).
     if( !cached ) {
-        cached = make_shared_fast<std::istringstream>( read_entire_file( path ) );
+        const auto kept = current_data_files.find( path );
+        cached = make_shared_fast<std::istringstream>( kept != current_data_files.end() ?
+                 kept->second.contents : read_entire_file( path ) );
     } else if( cached.use_count() > 2 ) {
         cached = make_shared_fast<std::istringstream>( cached->str() );
     }
@@ -471,6 +541,8 @@ void DynamicDataLoader::initialize()
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
+    ZoneScoped;
+    ZoneText( path.c_str(), path.size() );
     assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
     // and all the previously loaded folders.
@@ -488,19 +560,48 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    std::vector<std::optional<kept_data_file>> stats;
+    std::vector<bool> kept;
+    std::vector<size_t> to_read;
+    for( size_t i = 0; i < files.size(); i++ ) {
+        stats.push_back( stat_data_file( files[i] ) );
+        kept.push_back( keep_data_file( files[i], stats.back() ) );
+        if( !kept.back() ) {
+            to_read.push_back( i );
+        }
+    }
+    // Read the next few files on a worker thread while this one is parsed and loaded.
+    // They are still loaded one at a time in order, later definitions can depend on
+    // earlier ones.
+    static constexpr size_t files_read_ahead = 16;
+    file_prefetcher prefetcher;
+    size_t next_request = 0;
     // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    for( size_t i = 0; i < files.size(); i++ ) {
+        const std::string &file = files[i];
+        for( ; next_request < to_read.size() && to_read[next_request] < i + files_read_ahead;
+             next_request++ ) {
+            prefetcher.request( files[to_read[next_request]] );
+        }
+        std::string data;
+        if( kept[i] ) {
+            data = current_data_files[file].contents;
+            data_files_kept++;
+        } else {
+            std::optional<std::string> read = prefetcher.take( file );
+            // stuff it into ram
+            data = read ? std::move( *read ) : read_entire_file( file );
+            data_files_read++;
+            if( stats[i] ) {
+                kept_data_file &keep = current_data_files[file];
+                keep.mtime = stats[i]->mtime;
+                keep.size = stats[i]->size;
+                keep.contents = data;
+            }
+        }
+        std::istringstream iss( std::move( data ) );
         try {
+            startup_timings::timer timing( "json file", file );
             // parse it
             JsonIn jsin( iss, file );
             load_all_from_json( jsin, src, ui, path, file );
@@ -513,6 +614,8 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
 void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
         const std::string &base_path, const std::string &full_path )
 {
+    ZoneScoped;
+    ZoneText( full_path.c_str(), full_path.size() );
     // TEMPORARY until 0.G: Remove single object support for consistency
     if( jsin.test_object() ) {
         // find type and dispatch single object
@@ -543,6 +646,11 @@ void DynamicDataLoader::unload_data()
 {
     finalized = false;
 
+    previous_data_files = std::move( current_data_files );
+    current_data_files.clear();
+    data_files_kept = 0;
+    data_files_read = 0;
+
     //Moved to the top as a temp hack until vehicles are made into game objects
     vehicle_prototype::reset();
     cleanup_arenas();
@@ -645,8 +753,31 @@ void DynamicDataLoader::unload_data()
     lua.reset();
 }
 
+static long long ms_since( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start ).count();
+}
+
+/** Runs the steps of a loading stage in order, logging how long each of them took. */
+static void run_timed_entries( loading_ui &ui, const std::string &stage,
+                               const std::vector<std::pair<std::string, std::function<void()>>> &entries )
+{
+    const auto stage_start = std::chrono::steady_clock::now();
+    for( const std::pair<std::string, std::function<void()>> &e : entries ) {
+        const auto start = std::chrono::steady_clock::now();
+        e.second();
+        DebugLog( DL::Info, DC::Main ) << stage << " " << e.first << ": " << ms_since( start ) << " ms";
+        startup_timings::add( stage, e.first, std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::steady_clock::now() - start ).count() );
+        ui.proceed();
+    }
+    DebugLog( DL::Info, DC::Main ) << stage << " took " << ms_since( stage_start ) << " ms";
+}
+
 void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 {
+    ZoneScoped;
     assert( !finalized && "Can't finalize the data twice." );
     assert( !stream_cache && "Expected stream cache to be null before finalization" );
 
@@ -726,14 +857,25 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
     }
 
     ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_timed_entries( ui, "finalize", entries );
+
+    // Whatever wasn't loaded again by now belongs to mods that aren't loaded any more
+    previous_data_files.clear();
+    DebugLog( DL::Info, DC::Main ) << "Read " << data_files_read << " data files, " <<
+                                   data_files_kept << " were unchanged since the last load";
 }
 
+bool init::skip_consistency_checks = false;
+
 void DynamicDataLoader::check_consistency( loading_ui &ui )
 {
+    ZoneScoped;
+    if( init::skip_consistency_checks && !test_mode ) {
+        DebugLog( DL::Info, DC::Main ) << "Skipped verifying the loaded data";
+        finalized = true;
+        return;
+    }
+
     ui.new_context( _( "Verifying" ) );
 
     using named_entry = std::pair<std::string, std::function<void()>>;
@@ -772,7 +914,7 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
             { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions },
             { _( "Furniture and terrain" ), &check_furniture_and_terrain },
             { _( "Constructions" ), &constructions::check_consistency },
-            { _( "Construction sequences" ), &constructions::check_consistency },
+            { _( "Construction sequences" ), &construction_sequences::check_consistency },
             { _( "Professions" ), &profession::check_definitions },
             { _( "Scenarios" ), &scenario::check_definitions },
             { _( "Martial arts" ), &check_martialarts },
@@ -821,10 +963,7 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
     }
 
     ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_timed_entries( ui, "verify", entries );
 
     finalized = true;
 }
@@ -881,6 +1020,7 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
                 );
             }
             cata::set_mod_being_loaded( *loader.lua, mod );
+            startup_timings::timer timing( "lua preload script", mod.str() );
             cata::run_mod_preload_script( *loader.lua, mod );
         }
     }
@@ -888,7 +1028,10 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
     cata::reg_lua_iuse_actors( *loader.lua, *item_controller );
 
     for( const mod_id &mod : available ) {
+        startup_timings::timer timing( "content pack", mod.str() );
+        const auto start = std::chrono::steady_clock::now();
         loader.load_data_from_path( mod->path, mod.str(), ui );
+        DebugLog( DL::Info, DC::Main ) << "Loading " << mod.str() << ": " << ms_since( start ) << " ms";
         ui.proceed();
     }
 
@@ -898,6 +1041,7 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
         for( const mod_id &mod : available ) {
             if( mod->lua_api_version ) {
                 cata::set_mod_being_loaded( *loader.lua, mod );
+                startup_timings::timer timing( "lua finalize script", mod.str() );
                 cata::run_mod_finalize_script( *loader.lua, mod );
             }
         }
@@ -916,6 +1060,7 @@ void init::load_main_lua_scripts( cata::lua_state &state, const std::vector<mod_
     for( const mod_id &mod : packs ) {
         if( mod.is_valid() && mod->lua_api_version ) {
             cata::set_mod_being_loaded( state, mod );
+            startup_timings::timer timing( "lua main script", mod.str() );
             cata::run_mod_main_script( state, mod );
         }
     }
@@ -1062,5 +1207,6 @@ void init::load_soundpack_files( const std::string &soundpack_path )
     // It's not a mod, so we avoid the regular mod loading routines.
     // clear_loaded_data() is not needed here, tileset gets loaded on game init before any mods
     loading_ui ui( false );
+    startup_timings::timer timing( "soundpack", soundpack_path );
     DynamicDataLoader::get_instance().load_data_from_path( soundpack_path, "sound_core", ui );
 }
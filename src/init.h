@@ -181,6 +181,12 @@ class DynamicDataLoader
 namespace init
 {
 
+/**
+ * Skip @ref DynamicDataLoader::check_consistency when loading game data, for data
+ * already known to be valid. Ignored in test mode, which includes checking mods.
+ */
+extern bool skip_consistency_checks;
+
 /** Load (or reload) mods' main Lua scripts. */
 void load_main_lua_scripts( cata::lua_state &state, const std::vector<mod_id> &packs );
 
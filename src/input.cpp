@@ -22,6 +22,7 @@
 #include "game.h"
 #include "help.h"
 #include "ime.h"
+#include "input_recorder.h"
 #include "json.h"
 #include "options.h"
 #include "output.h"
@@ -1410,6 +1411,23 @@ input_event input_context::get_raw_input()
     return next_action;
 }
 
+input_event input_manager::get_input_event()
+{
+    if( std::optional<input_event> replayed = input_recorder::next_replayed() ) {
+        // Still draw the screen and handle window events, but the keyboard is ignored
+        const int old_timeout = input_timeout;
+        set_timeout( 0 );
+        get_device_input_event();
+        set_timeout( old_timeout );
+        previously_pressed_key = replayed->type == input_event_t::keyboard ?
+                                 replayed->get_first_input() : 0;
+        return *replayed;
+    }
+    input_event evt = get_device_input_event();
+    input_recorder::record( evt );
+    return evt;
+}
+
 int input_manager::get_previously_pressed_key() const
 {
     return previously_pressed_key;
@@ -280,9 +280,16 @@ class input_manager
         /**
          * curses getch() replacement.
          *
-         * Defined in the respective platform wrapper, e.g. sdlcurse.cpp
+         * Reads @ref get_device_input_event, or hands back the events of an input
+         * recording being replayed (see input_recorder.h).
          */
         input_event get_input_event();
+        /**
+         * Waits for the next event from the keyboard, mouse or gamepad.
+         *
+         * Defined in the respective platform wrapper, e.g. sdlcurse.cpp
+         */
+        input_event get_device_input_event();
         /**
          * Resize & refresh if necessary, process all pending window events, and ignore keypresses
          */
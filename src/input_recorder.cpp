@@ -0,0 +1,188 @@
+#include "input_recorder.h"
+
+#include <deque>
+#include <exception>
+#include <istream>
+#include <sstream>
+#include <utility>
+
+#include "debug.h"
+#include "fstream_utils.h"
+#include "input.h"
+#include "json.h"
+#include "point.h"
+
+namespace input_recorder
+{
+
+namespace
+{
+
+struct recorder_state {
+    // Open while recording
+    cata_ofstream recording;
+    bool replaying = false;
+    std::deque<input_event> replay;
+};
+
+recorder_state &get_state()
+{
+    static recorder_state state;
+    return state;
+}
+
+// Every entry is one JSON object on its own line, written out right away so the
+// recording survives the game crashing or being killed
+template<typename Writer>
+void write_entry( const Writer &writer )
+{
+    cata_ofstream &out = get_state().recording;
+    if( !out.is_open() ) {
+        return;
+    }
+    JsonOut jsout( *out );
+    jsout.start_object();
+    writer( jsout );
+    jsout.end_object();
+    *out << '\n';
+    out.flush();
+}
+
+void serialize_event( const input_event &evt, JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "type", static_cast<int>( evt.type ) );
+    if( !evt.modifiers.empty() ) {
+        jsout.member( "modifiers", evt.modifiers );
+    }
+    if( !evt.sequence.empty() ) {
+        jsout.member( "sequence", evt.sequence );
+    }
+    if( evt.type == input_event_t::mouse ) {
+        jsout.member( "mouse_pos", evt.mouse_pos );
+    }
+    if( !evt.text.empty() ) {
+        jsout.member( "text", evt.text );
+    }
+    if( !evt.edit.empty() ) {
+        jsout.member( "edit", evt.edit );
+    }
+    if( evt.edit_refresh ) {
+        jsout.member( "edit_refresh", evt.edit_refresh );
+    }
+    jsout.end_object();
+}
+
+input_event deserialize_event( const JsonObject &jo )
+{
+    input_event evt;
+    evt.type = static_cast<input_event_t>( jo.get_int( "type" ) );
+    jo.read( "modifiers", evt.modifiers );
+    jo.read( "sequence", evt.sequence );
+    jo.read( "mouse_pos", evt.mouse_pos );
+    jo.read( "text", evt.text );
+    jo.read( "edit", evt.edit );
+    jo.read( "edit_refresh", evt.edit_refresh );
+    return evt;
+}
+
+} // namespace
+
+void start_recording( const std::string &path, int seed )
+{
+    cata_ofstream &out = get_state().recording;
+    out.open( path );
+    if( !out.is_open() ) {
+        DebugLog( DL::Error, DC::Main ) << "Could not open " << path << " to record the input";
+        return;
+    }
+    write_entry( [&]( JsonOut & jsout ) {
+        jsout.member( "seed", seed );
+    } );
+}
+
+std::optional<int> start_replay( const std::string &path )
+{
+    recorder_state &state = get_state();
+    std::optional<int> seed;
+    std::deque<input_event> replay;
+    const bool read = read_from_file( path, [&]( std::istream & fin ) {
+        std::string line;
+        while( std::getline( fin, line ) ) {
+            if( line.empty() ) {
+                continue;
+            }
+            std::istringstream line_stream( line );
+            JsonIn jsin( line_stream );
+            JsonObject jo = jsin.get_object();
+            jo.allow_omitted_members();
+            if( jo.has_member( "seed" ) ) {
+                seed = jo.get_int( "seed" );
+            } else if( jo.has_object( "input" ) ) {
+                replay.push_back( deserialize_event( jo.get_object( "input" ) ) );
+            } else if( jo.has_object( "load" ) ) {
+                JsonObject load = jo.get_object( "load" );
+                const std::string save = load.get_string( "save" );
+                const std::string world = load.get_string( "world" );
+                DebugLog( DL::Info, DC::Main ) << "Replay loads save " << save << " of world " <<
+                                               world;
+            }
+        }
+    } );
+    if( !read || !seed ) {
+        DebugLog( DL::Error, DC::Main ) << "Could not read the input recording " << path;
+        return std::nullopt;
+    }
+    state.replaying = true;
+    state.replay = std::move( replay );
+    DebugLog( DL::Info, DC::Main ) << "Replaying " << state.replay.size() <<
+                                   " input events from " << path;
+    return seed;
+}
+
+bool recording()
+{
+    return get_state().recording.is_open();
+}
+
+bool replaying()
+{
+    return get_state().replaying;
+}
+
+void record( const input_event &evt )
+{
+    write_entry( [&]( JsonOut & jsout ) {
+        jsout.member( "input" );
+        serialize_event( evt, jsout );
+    } );
+}
+
+void record_load( const std::string &world, const std::string &save )
+{
+    write_entry( [&]( JsonOut & jsout ) {
+        jsout.member( "load" );
+        jsout.start_object();
+        jsout.member( "world", world );
+        jsout.member( "save", save );
+        jsout.end_object();
+    } );
+}
+
+std::optional<input_event> next_replayed()
+{
+    recorder_state &state = get_state();
+    if( !state.replaying ) {
+        return std::nullopt;
+    }
+    if( state.replay.empty() ) {
+        state.replaying = false;
+        DebugLog( DL::Info, DC::Main ) << "The input recording has run out, reading the keyboard";
+        return std::nullopt;
+    }
+    input_event evt = std::move( state.replay.front() );
+    state.replay.pop_front();
+    return evt;
+}
+
+} // namespace input_recorder
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef CATA_SRC_INPUT_RECORDER_H
+#define CATA_SRC_INPUT_RECORDER_H
+
+#include <optional>
+#include <string>
+
+struct input_event;
+
+/**
+ * Recording of a play session so it can be played again, e.g. under a profiler.
+ * A recording holds the random seed and every input event the game read, in order,
+ * together with the world and save that were loaded. Replaying it seeds the random
+ * number generator the same way and hands the recorded events back to the game
+ * instead of reading the keyboard, so it only repeats the session when it starts
+ * from a copy of the same save. Once the recording runs out the game reads the
+ * keyboard again.
+ *
+ * The --record-input and --replay-input command-line flags start these.
+ */
+namespace input_recorder
+{
+
+/** Start writing the seed and the input events to the file at `path`. */
+void start_recording( const std::string &path, int seed );
+/**
+ * Read the recording at `path` to replay it.
+ * @return The seed it was made with, or nothing if it could not be read.
+ */
+std::optional<int> start_replay( const std::string &path );
+
+bool recording();
+bool replaying();
+
+/** Adds an event read from the keyboard to the recording, if there is one. */
+void record( const input_event &evt );
+/** Notes the world and save being loaded, so the replay can start from a copy of them. */
+void record_load( const std::string &world, const std::string &save );
+/** The next event of the replay, or nothing once it has run out. */
+std::optional<input_event> next_replayed();
+
+} // namespace input_recorder
+
+#endif // CATA_SRC_INPUT_RECORDER_H
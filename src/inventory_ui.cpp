@@ -22,6 +22,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_input_popup.h"
+#include "string_utils.h"
 #include "translations.h"
 #include "type_id.h"
 #include "ui_manager.h"
@@ -186,6 +187,7 @@ nc_color inventory_entry::get_invlet_color() const
 void inventory_entry::update_cache()
 {
     cached_name = any_item()->tname( 1 );
+    cached_lowercase_name = to_lower_case( cached_name );
 }
 
 const item_category *inventory_entry::get_category_ptr() const
@@ -256,6 +258,16 @@ nc_color inventory_selector_preset::get_color( const inventory_entry &entry ) co
 std::function<bool( const inventory_entry & )> inventory_selector_preset::get_filter(
     const std::string &filter ) const
 {
+    if( filter.find( ':' ) == std::string::npos ) {
+        // Plain names are matched against the names cached by the column
+        const std::string needle = to_lower_case( filter );
+        return [needle]( const inventory_entry & e ) {
+            if( e.cached_name.empty() ) {
+                return lcmatch( e.any_item()->tname(), needle );
+            }
+            return e.cached_lowercase_name.find( needle ) != std::string::npos;
+        };
+    }
     auto item_filter = basic_item_filter( filter );
 
     return [item_filter]( const inventory_entry & e ) {
@@ -764,6 +776,12 @@ void inventory_column::prepare_paging( const std::string &filter )
         return preset.get_filter( filter );
     } );
 
+    // Names are the sort keys and are matched by the filter, they are only made once per entry
+    for( inventory_entry &entry : entries ) {
+        if( entry.is_item() && entry.cached_name.empty() ) {
+            entry.update_cache();
+        }
+    }
     // FIXME: toggled status of multiselect menu resets when filtering the menu
     // First, remove all non-items
     const auto new_end = std::remove_if( entries.begin(),
@@ -776,16 +794,18 @@ void inventory_column::prepare_paging( const std::string &filter )
     while( from != entries.end() ) {
         auto to = std::next( from );
         while( to != entries.end() && from->get_category_ptr() == to->get_category_ptr() ) {
-            to->update_cache();
             std::advance( to, 1 );
         }
-        if( !ordered_categories.contains( from->get_category_ptr()->get_id().c_str() ) ) {
-            std::sort( from, to, [ this ]( const inventory_entry & lhs, const inventory_entry & rhs ) {
-                if( lhs.is_selectable() != rhs.is_selectable() ) {
-                    return lhs.is_selectable(); // Disabled items always go last
-                }
-                return preset.sort_compare( lhs, rhs );
-            } );
+        const auto compare = [ this ]( const inventory_entry & lhs, const inventory_entry & rhs ) {
+            if( lhs.is_selectable() != rhs.is_selectable() ) {
+                return lhs.is_selectable(); // Disabled items always go last
+            }
+            return preset.sort_compare( lhs, rhs );
+        };
+        // Filtering keeps the order of the sorted unfiltered entries
+        if( !ordered_categories.contains( from->get_category_ptr()->get_id().c_str() ) &&
+            !std::is_sorted( from, to, compare ) ) {
+            std::sort( from, to, compare );
         }
         from = to;
     }
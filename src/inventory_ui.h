@@ -54,7 +54,10 @@ class inventory_entry
 
         size_t chosen_count = 0;
         int custom_invlet = INT_MIN;
+        /** Name of the item, set once by @ref update_cache and used for sorting. */
         std::string cached_name;
+        /** @ref cached_name in lower case, for filtering by name. */
+        std::string cached_lowercase_name;
 
         inventory_entry() = default;
 
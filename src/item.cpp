@@ -5,16 +5,19 @@
 #include <cassert>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <iomanip>
 #include <iterator>
 #include <limits>
 #include <locale>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "advanced_inv.h"
@@ -95,6 +98,7 @@
 #include "rng.h"
 #include "scores_ui.h"
 #include "skill.h"
+#include "slab_allocator.h"
 #include "stomach.h"
 #include "string_formatter.h"
 #include "string_id_utils.h"
@@ -511,6 +515,23 @@ void item::on_destroy()
 
 item::~item() = default;
 
+void *item::operator new( std::size_t size )
+{
+    if( size != sizeof( item ) ) {
+        return ::operator new( size );
+    }
+    return slab_allocator<item>().allocate( 1 );
+}
+
+void item::operator delete( void *ptr, std::size_t size )
+{
+    if( size != sizeof( item ) ) {
+        ::operator delete( ptr );
+        return;
+    }
+    slab_allocator<item>().deallocate( static_cast<item *>( ptr ), 1 );
+}
+
 detached_ptr<item> item::make_corpse( const mtype_id &mt, time_point turn, const std::string &name,
                                       const int upgrade_time )
 {
@@ -4745,7 +4766,42 @@ void item::on_damage( int qty, damage_type )
     }
 }
 
+namespace item_internal
+{
+static int name_cache_depth = 0;
+static std::map<std::tuple<const item *, unsigned int, bool, unsigned int>, std::string>
+name_cache;
+} // namespace item_internal
+
+scoped_item_name_cache::scoped_item_name_cache()
+{
+    item_internal::name_cache_depth++;
+}
+
+scoped_item_name_cache::~scoped_item_name_cache()
+{
+    if( --item_internal::name_cache_depth == 0 ) {
+        item_internal::name_cache.clear();
+    }
+}
+
 std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int truncate ) const
+{
+    if( item_internal::name_cache_depth == 0 ) {
+        return tname_uncached( quantity, with_prefix, truncate );
+    }
+    const auto key = std::make_tuple( this, quantity, with_prefix, truncate );
+    const auto found = item_internal::name_cache.find( key );
+    if( found != item_internal::name_cache.end() ) {
+        return found->second;
+    }
+    std::string ret = tname_uncached( quantity, with_prefix, truncate );
+    item_internal::name_cache.emplace( key, ret );
+    return ret;
+}
+
+std::string item::tname_uncached( unsigned int quantity, bool with_prefix,
+                                  unsigned int truncate ) const
 {
     int dirt_level = get_var( "dirt", 0 ) / 2000;
     std::string dirt_symbol;
@@ -5178,7 +5234,49 @@ int item::price( bool practical ) const
 }
 
 // TODO: MATERIALS add a density field to materials.json
+namespace item_internal
+{
+static int measure_cache_depth = 0;
+// Keyed by the item's address with the flags of the call in its low bits
+static std::unordered_map<std::uintptr_t, units::mass> weight_cache;
+static std::unordered_map<std::uintptr_t, units::volume> volume_cache;
+
+inline std::uintptr_t measure_cache_key( const item *it, bool first, bool second )
+{
+    static_assert( alignof( item ) >= 4, "the flags need the low bits of the address" );
+    return reinterpret_cast<std::uintptr_t>( it ) | ( first ? 1 : 0 ) | ( second ? 2 : 0 );
+}
+} // namespace item_internal
+
+scoped_item_measure_cache::scoped_item_measure_cache()
+{
+    item_internal::measure_cache_depth++;
+}
+
+scoped_item_measure_cache::~scoped_item_measure_cache()
+{
+    if( --item_internal::measure_cache_depth == 0 ) {
+        item_internal::weight_cache.clear();
+        item_internal::volume_cache.clear();
+    }
+}
+
 units::mass item::weight( bool include_contents, bool integral ) const
+{
+    if( item_internal::measure_cache_depth == 0 ) {
+        return weight_uncached( include_contents, integral );
+    }
+    const std::uintptr_t key = item_internal::measure_cache_key( this, include_contents, integral );
+    const auto found = item_internal::weight_cache.find( key );
+    if( found != item_internal::weight_cache.end() ) {
+        return found->second;
+    }
+    const units::mass ret = weight_uncached( include_contents, integral );
+    item_internal::weight_cache.emplace( key, ret );
+    return ret;
+}
+
+units::mass item::weight_uncached( bool include_contents, bool integral ) const
 {
     if( is_null() ) {
         return 0_gram;
@@ -5328,6 +5426,21 @@ units::volume item::base_volume() const
 }
 
 units::volume item::volume( bool integral ) const
+{
+    if( item_internal::measure_cache_depth == 0 ) {
+        return volume_uncached( integral );
+    }
+    const std::uintptr_t key = item_internal::measure_cache_key( this, integral, false );
+    const auto found = item_internal::volume_cache.find( key );
+    if( found != item_internal::volume_cache.end() ) {
+        return found->second;
+    }
+    const units::volume ret = volume_uncached( integral );
+    item_internal::volume_cache.emplace( key, ret );
+    return ret;
+}
+
+units::volume item::volume_uncached( bool integral ) const
 {
     if( is_null() ) {
         return 0_ml;
@@ -5628,6 +5741,9 @@ bool item::can_shatter() const
 
 void item::unset_flags()
 {
+    if( !item_tags.empty() ) {
+        encumbrance_update_ = true;
+    }
     item_tags.clear();
 }
 
@@ -5671,7 +5787,10 @@ bool item::has_flag( const flag_id &f ) const
 void item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
-        item_tags.insert( flag );
+        // Fit and size flags change the encumbrance of worn items
+        if( item_tags.insert( flag ).second ) {
+            encumbrance_update_ = true;
+        }
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -5679,7 +5798,9 @@ void item::set_flag( const flag_id &flag )
 
 void item::unset_flag( const flag_id &flag )
 {
-    item_tags.erase( flag );
+    if( item_tags.erase( flag ) > 0 ) {
+        encumbrance_update_ = true;
+    }
 }
 
 void item::set_flag_recursive( const flag_id &flag )
@@ -8746,7 +8867,7 @@ bool item::burn( fire_data &frd )
 
 bool item::flammable( int threshold ) const
 {
-    const std::vector<const material_type *> &mats = made_of_types();
+    const std::vector<material_id> &mats = made_of();
     if( mats.empty() ) {
         // Don't know how to burn down something made of nothing.
         return false;
@@ -8754,8 +8875,8 @@ bool item::flammable( int threshold ) const
 
     int flammability = 0;
     units::volume volume_per_turn = 0_ml;
-    for( const material_type *m : mats ) {
-        const mat_burn_data &bd = m->burn_data( 1 );
+    for( const material_id &m : mats ) {
+        const mat_burn_data &bd = m.obj().burn_data( 1 );
         if( bd.immune ) {
             // Made to protect from fire
             return false;
@@ -9396,6 +9517,44 @@ static units::temperature clip_by_temperature_flag( units::temperature temperatu
     return temperature;
 }
 
+namespace
+{
+
+// Items catching up on rot together are mostly in piles and containers on the same tile,
+// and they were usually last checked at the same time, so they'd work out the same
+// weather again for each hour they missed. This remembers it until the turn is over,
+// for every tile, as the items of neighbouring tiles are processed in no particular order.
+struct past_weather_memo {
+    std::optional<time_point> turn;
+    const weather_generator *wgen = nullptr;
+    unsigned int seed = 0;
+    // By location, then by turn
+    std::unordered_map<point_abs_ms, std::unordered_map<int, units::temperature>> temperatures;
+
+    units::temperature get( const weather_generator &gen, const tripoint_abs_ms &where,
+                            const time_point &time, unsigned int gen_seed ) {
+        if( turn != calendar::turn || wgen != &gen || seed != gen_seed ) {
+            turn = calendar::turn;
+            wgen = &gen;
+            seed = gen_seed;
+            temperatures.clear();
+        }
+        std::unordered_map<int, units::temperature> &here = temperatures[where.xy()];
+        const auto found = here.find( to_turn<int>( time ) );
+        if( found != here.end() ) {
+            return found->second;
+        }
+        const units::temperature ret = gen.get_weather_temperature( where, time, calendar::config,
+                                       gen_seed );
+        here.emplace( to_turn<int>( time ), ret );
+        return ret;
+    }
+};
+
+past_weather_memo past_weather;
+
+} // namespace
+
 detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool seals,
                                        const tripoint &pos,
                                        player *carrier, const temperature_flag flag,
@@ -9433,8 +9592,55 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
                                        ? 0
                                        : get_map().get_temperature( pos ) ) - 0_f;
 
+        // Below ground and in root cellars every hour is as warm as the last, so each full hour
+        // adds the same rot until the item rots away or stops rotting
+        const bool constant_temperature = pos.z < 0 || flag == temperature_flag::TEMP_ROOT_CELLAR;
+
         // Process the past of this item since the last time it was processed
         while( now - time > 1_hours ) {
+            // Starting rot variation is only rolled for the first check after the cataclysm
+            if( constant_temperature && now - time >= 2_hours &&
+                self->last_rot_check > calendar::start_of_cataclysm ) {
+                const units::temperature env_temperature = clip_by_temperature_flag(
+                            temperatures::annual_average + local_mod, flag );
+                const time_duration hourly_rot = self->calc_rot( time + 1_hours, env_temperature );
+                if( hourly_rot >= 0_turns ) {
+                    const int full_hours = to_hours<int>( now - time - 1_hours );
+                    const time_duration rot_before = self->rot;
+                    const auto rots_away_after = [&]( int hours ) {
+                        self->rot = rot_before + hourly_rot * hours;
+                        return self->has_rotten_away() && carrier == nullptr && !seals;
+                    };
+                    const auto stops_after = [&]( int hours ) {
+                        return rots_away_after( hours ) ||
+                               ( !self->is_corpse() && self->get_relative_rot() > 2.0 );
+                    };
+                    int hours = full_hours;
+                    if( hourly_rot == 0_turns ) {
+                        if( rots_away_after( 1 ) ) {
+                            hours = 1;
+                        }
+                    } else if( stops_after( full_hours ) ) {
+                        // Find the first hour after which it rots away or stops rotting
+                        int lo = 1;
+                        while( lo < hours ) {
+                            const int mid = lo + ( hours - lo ) / 2;
+                            if( stops_after( mid ) ) {
+                                hours = mid;
+                            } else {
+                                lo = mid + 1;
+                            }
+                        }
+                    }
+                    time += hours * 1_hours;
+                    self->last_rot_check = time;
+                    if( rots_away_after( hours ) ) {
+                        return detached_ptr<item>();
+                    }
+                    continue;
+                }
+            }
+
             // Get the environment temperature
             time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
             time += time_delta;
@@ -9443,8 +9649,7 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
             units::temperature env_temperature_raw;
             if( pos.z >= 0 ) {
                 tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
-                units::temperature weather_temperature = wgen.get_weather_temperature( location, time,
-                        calendar::config, seed );
+                units::temperature weather_temperature = past_weather.get( wgen, location, time, seed );
                 env_temperature_raw = weather_temperature + local_mod;
             } else {
                 env_temperature_raw = temperatures::annual_average + local_mod;
@@ -10687,6 +10892,8 @@ void item::update_clothing_mod_val()
         }
         set_var( get_clothing_mod_val_key( type ), tmp );
     }
+    // Clothing mods change warmth and encumbrance
+    encumbrance_update_ = true;
 }
 
 item_location_type item::where() const
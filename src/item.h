@@ -3,6 +3,7 @@
 #define CATA_SRC_ITEM_H
 
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -273,6 +274,10 @@ class item : public location_visitable<item>, public game_object<item>
         ~item();
         void on_destroy();
 
+        /** Items come from slabs, as many of them are made and destroyed at once. */
+        static void *operator new( std::size_t size );
+        static void operator delete( void *ptr, std::size_t size );
+
         inline static detached_ptr<item> spawn( JsonIn &jsin ) {
             detached_ptr<item> p = spawn();
             p->deserialize( jsin );
@@ -2262,6 +2267,10 @@ class item : public location_visitable<item>, public game_object<item>
         const std::vector<relic_recharge> &get_relic_recharge_scheme() const;
 
     private:
+        units::mass weight_uncached( bool include_contents, bool integral ) const;
+        units::volume volume_uncached( bool integral ) const;
+        std::string tname_uncached( unsigned int quantity, bool with_prefix,
+                                    unsigned int truncate ) const;
         const use_function *get_use_internal( const std::string &use_name ) const;
         static detached_ptr<item> process_internal( detached_ptr<item> &&self, player *carrier,
                 const tripoint &pos, bool activate,
@@ -2387,8 +2396,8 @@ class item : public location_visitable<item>, public game_object<item>
         int mission_id = -1;       // Refers to a mission in game's master list
         int player_id = -1;        // Only give a mission to the right player!
 
-        // Set when the item / its content changes. Used for worn item with
-        // encumbrance depending on their content.
+        // Set when the item / its content, flags or clothing mods change. Used for worn
+        // items with encumbrance or warmth depending on them.
         // This not part serialized or compared on purpose!
         bool encumbrance_update_ = false;
 
@@ -2447,6 +2456,34 @@ class item : public location_visitable<item>, public game_object<item>
         int kill_count();
 };
 
+/**
+ * While one of these lives, item::weight() and item::volume() remember what they returned
+ * for each item, so containers full of things are only added up once. For code that asks
+ * about the same items many times without changing them, like working out encumbrance.
+ */
+class scoped_item_measure_cache
+{
+    public:
+        scoped_item_measure_cache();
+        ~scoped_item_measure_cache();
+        scoped_item_measure_cache( const scoped_item_measure_cache & ) = delete;
+        scoped_item_measure_cache &operator=( const scoped_item_measure_cache & ) = delete;
+};
+
+/**
+ * While one of these lives, item::tname() remembers the names it made for each item, so
+ * screens that list the same items several times while building and drawing don't make
+ * every name again. The items must not change meanwhile.
+ */
+class scoped_item_name_cache
+{
+    public:
+        scoped_item_name_cache();
+        ~scoped_item_name_cache();
+        scoped_item_name_cache( const scoped_item_name_cache & ) = delete;
+        scoped_item_name_cache &operator=( const scoped_item_name_cache & ) = delete;
+};
+
 bool item_compare_by_charges( const item &left, const item &right );
 bool item_ptr_compare_by_charges( const item *left, const item *right );
 
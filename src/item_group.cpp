@@ -466,6 +466,7 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         ptr->probability = std::min( 100, ptr->probability );
     }
     sum_prob += ptr->probability;
+    cumulative_prob.push_back( sum_prob );
 
     // Make the ammo and magazine probabilities from the outer entity apply to the nested entity:
     // If ptr is an Item_group, it already inherited its parent's ammo/magazine chances in its constructor.
@@ -490,16 +491,9 @@ std::vector<detached_ptr<item>> Item_group::create( const time_point &birthday,
                            std::make_move_iterator( tmp.end() ) );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            p -= ( elem )->probability;
-            if( p >= 0 ) {
-                continue;
-            }
-            std::vector<detached_ptr<item>> tmp = ( elem )->create( birthday, rec );
-            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
-                           std::make_move_iterator( tmp.end() ) );
-            break;
+        const int p = rng( 0, sum_prob - 1 );
+        if( !items.empty() ) {
+            result = rolled_entry( p ).create( birthday, rec );
         }
     }
 
@@ -516,18 +510,20 @@ detached_ptr<item> Item_group::create_single( const time_point &birthday, Recurs
             return ( elem )->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            p -= ( elem )->probability;
-            if( p >= 0 ) {
-                continue;
-            }
-            return ( elem )->create_single( birthday, rec );
+        const int p = rng( 0, sum_prob - 1 );
+        if( !items.empty() ) {
+            return rolled_entry( p ).create_single( birthday, rec );
         }
     }
     return detached_ptr<item>();
 }
 
+const Item_spawn_data &Item_group::rolled_entry( int roll ) const
+{
+    const auto found = std::upper_bound( cumulative_prob.begin(), cumulative_prob.end(), roll );
+    return *items[std::min<size_t>( found - cumulative_prob.begin(), items.size() - 1 )];
+}
+
 void Item_group::check_consistency( const std::string &context ) const
 {
     for( const auto &elem : items ) {
@@ -545,6 +541,12 @@ bool Item_group::remove_item( const itype_id &itemid )
             ++a;
         }
     }
+    cumulative_prob.clear();
+    int prob = 0;
+    for( const std::unique_ptr<Item_spawn_data> &elem : items ) {
+        prob += elem->probability;
+        cumulative_prob.push_back( prob );
+    }
     return items.empty();
 }
 
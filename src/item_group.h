@@ -322,10 +322,18 @@ class Item_group : public Item_spawn_data
          * that this group contains.
          */
         int sum_prob;
+        /**
+         * For G_DISTRIBUTION, the sum of the probabilities of the entries up to and
+         * including each one, so a roll finds its entry with a binary search.
+         */
+        std::vector<int> cumulative_prob;
         /**
          * Links to the entries in this group.
          */
         prop_list items;
+
+        /** Entry that a roll in [0, sum_prob) of a G_DISTRIBUTION lands on. */
+        const Item_spawn_data &rolled_entry( int roll ) const;
 };
 
 #endif // CATA_SRC_ITEM_GROUP_H
@@ -25,41 +25,44 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             filter = filter.substr( colon + 1 );
         }
     }
+    const lcmatcher match( filter );
     switch( flag ) {
         // category
         case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category().name(), filter );
+            return [match]( const item & i ) {
+                return match( i.get_category().name() );
             };
         // material
         case 'm':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const material_id & mat ) {
-                    return lcmatch( mat->name(), filter );
+                [&match]( const material_id & mat ) {
+                    return match( mat->name() );
                 } );
             };
         // qualities
         case 'q':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 return std::any_of( i.quality_of().begin(), i.quality_of().end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, filter );
+                [&match]( const std::pair<quality_id, int> &e ) {
+                    return match( e.first->name );
                 } );
             };
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const auto pair = get_both( filter );
+            const auto first = item_filter_from_string( pair.first );
+            const auto second = item_filter_from_string( pair.second );
+            return [first, second]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( auto &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( match( component.to_string() ) ) {
                         return true;
                     }
                 }
@@ -67,27 +70,48 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && match( note );
             };
         // skill taught
         case 'k':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 if( i.is_book() ) {
                     const islot_book &book = *i.type->book;
-                    return lcmatch( book.skill->name(), filter );
+                    return match( book.skill->name() );
                 }
                 return false;
             };
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( a.tname(), filter );
+            return [match]( const item & a ) {
+                return match( a.tname() );
             };
     }
 }
 
+int filter_cost( const std::string &filter )
+{
+    const size_t colon = filter.find( ':' );
+    if( colon == std::string::npos || colon == 0 ) {
+        // Making the name of an item takes a while
+        return 1;
+    }
+    switch( filter[colon - 1] ) {
+        case 'c':
+        case 'n':
+        case 'k':
+            return 0;
+        case 'b':
+            return 2;
+        case 'd':
+            return 3;
+        default:
+            return 1;
+    }
+}
+
 std::function<bool( const item & )> item_filter_from_string( const std::string &filter )
 {
     return filter_from_string<item>( filter, basic_item_filter );
@@ -6,10 +6,17 @@
 #include <algorithm>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "string_utils.h"
 
+/**
+ * Rough cost of testing an item against one basic query, by its prefix, so the cheap parts
+ * of a query with several of them are tested first.
+ */
+int filter_cost( const std::string &filter );
+
 /**
  * Get a function that returns true if the value matches the query.
  */
@@ -32,19 +39,21 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
         filter.erase( std::remove( filter.begin(), filter.end(), '}' ), filter.end() );
     }
     if( filter.find( ',' ) != std::string::npos ) {
+        using cost_and_function = std::pair<int, std::function<bool( const T & )>>;
         // functions which only one of which must return true
-        std::vector<std::function<bool( const T & )> > functions;
+        std::vector<cost_and_function> functions;
         // Functions that must all return true
-        std::vector<std::function<bool( const T & )> > inv_functions;
+        std::vector<cost_and_function> inv_functions;
         size_t comma = filter.find( ',' );
         while( !filter.empty() ) {
             const auto &current_filter = trim( filter.substr( 0, comma ) );
             if( !current_filter.empty() ) {
                 auto current_func = filter_from_string( current_filter, basic_filter );
                 if( current_filter[0] == '-' ) {
-                    inv_functions.push_back( current_func );
+                    inv_functions.emplace_back( filter_cost( current_filter.substr( 1 ) ),
+                                                current_func );
                 } else {
-                    functions.push_back( current_func );
+                    functions.emplace_back( filter_cost( current_filter ), current_func );
                 }
             }
             if( comma != std::string::npos ) {
@@ -54,30 +63,31 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
                 break;
             }
         }
+        // The result doesn't depend on the order, so the cheap ones get to decide first
+        const auto by_cost = []( const cost_and_function & lhs, const cost_and_function & rhs ) {
+            return lhs.first < rhs.first;
+        };
+        std::stable_sort( functions.begin(), functions.end(), by_cost );
+        std::stable_sort( inv_functions.begin(), inv_functions.end(), by_cost );
 
         return [functions, inv_functions]( const T & it ) {
-            auto apply = [&]( const std::function<bool( const T & )> &func ) {
-                return func( it );
+            auto apply = [&]( const cost_and_function & func ) {
+                return func.second( it );
             };
-            const bool p_result = std::any_of( functions.begin(), functions.end(),
-                                               apply );
-            const bool n_result = std::all_of(
-                                      inv_functions.begin(),
-                                      inv_functions.end(),
-                                      apply );
-            if( !functions.empty() && inv_functions.empty() ) {
-                return p_result;
+            if( !std::all_of( inv_functions.begin(), inv_functions.end(), apply ) ) {
+                return false;
             }
-            if( functions.empty() && !inv_functions.empty() ) {
-                return n_result;
+            if( functions.empty() ) {
+                return !inv_functions.empty();
             }
-            return p_result && n_result;
+            return std::any_of( functions.begin(), functions.end(), apply );
         };
     }
     const bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter, basic_filter]( const T & i ) {
-            return !filter_from_string( filter.substr( 1 ), basic_filter )( i );
+        const auto included = filter_from_string( filter.substr( 1 ), basic_filter );
+        return [included]( const T & i ) {
+            return !included( i );
         };
     }
 
@@ -1753,7 +1753,7 @@ static bool good_fishing_spot( tripoint pos )
     const oter_id &cur_omt =
         overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( pos ) ) ) );
     std::string om_id = cur_omt.id().c_str();
-    if( fishables.empty() && !g->m.has_flag( "CURRENT", pos ) &&
+    if( fishables.empty() && !g->m.has_flag( TFLAG_CURRENT, pos ) &&
         om_id.find( "river_" ) == std::string::npos && !cur_omt->is_lake() && !cur_omt->is_lake_shore() ) {
         g->u.add_msg_if_player( m_info, _( "You doubt you will have much luck catching fish here" ) );
         return false;
@@ -2607,7 +2607,7 @@ int iuse::dig( player *p, item *it, bool t, const tripoint & )
     }
     const tripoint dig_point = p->pos();
 
-    const bool can_dig_here = g->m.has_flag( "DIGGABLE", dig_point ) &&
+    const bool can_dig_here = g->m.has_flag( TFLAG_DIGGABLE, dig_point ) &&
                               !g->m.has_furn( dig_point ) &&
                               g->m.tr_at( dig_point ).is_null() &&
                               ( g->m.ter( dig_point ) == t_grave_new || g->m.i_at( dig_point ).empty() ) &&
@@ -2944,7 +2944,7 @@ int iuse::jackhammer( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( TFLAG_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't drill there." ) );
         return 0;
     }
@@ -3036,7 +3036,7 @@ int iuse::pickaxe( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( TFLAG_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't mine there." ) );
         return 0;
     }
@@ -3091,7 +3091,7 @@ int iuse::burrow( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( TFLAG_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't burrow there." ) );
         return 0;
     }
@@ -4552,7 +4552,7 @@ int iuse::chop_tree( player *p, item *it, bool t, const tripoint & )
         if( pnt == g->u.pos() ) {
             return false;
         }
-        return g->m.has_flag( "TREE", pnt );
+        return g->m.has_flag( TFLAG_TREE, pnt );
     };
 
     const std::optional<tripoint> pnt_ = choose_adjacent_highlight(
@@ -7422,7 +7422,7 @@ int iuse::ehandcuffs( player *p, item *it, bool t, const tripoint &pos )
 
     if( t ) {
 
-        if( g->m.has_flag( "SWIMMABLE", pos.xy() ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, pos.xy() ) ) {
             it->unset_flag( flag_NO_UNWIELD );
             it->ammo_unset();
             it->deactivate();
@@ -8876,7 +8876,7 @@ int iuse::capture_monster_veh( player *p, item *it, bool, const tripoint &pos )
 
 bool item::release_monster( const tripoint &target, const int radius )
 {
-    shared_ptr_fast<monster> new_monster = make_shared_fast<monster>();
+    shared_ptr_fast<monster> new_monster = make_shared_pooled<monster>();
     try {
         ::deserialize( *new_monster, get_var( "contained_json", "" ) );
     } catch( const std::exception &e ) {
@@ -9534,7 +9534,7 @@ int iuse::amputate( player *, item *it, bool, const tripoint &pos )
     auto bp_iter = std::next( body.begin(), bp_menu.ret );
     // Prepare for bugs!
     add_msg( m_bad, _( "Body part removed: %s" ), bp_iter->first->name_as_heading.translated() );
-    body.erase( bp_iter );
+    patient->remove_body_part( bp_iter->first );
 
     return it->type->charges_to_use();
 }
@@ -831,6 +831,13 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( stream->good() ) {
+        // Straight from the buffer, skipping the stream's checks for every character
+        std::streambuf &buf = *stream->rdbuf();
+        while( is_whitespace( static_cast<char>( buf.sgetc() ) ) ) {
+            buf.sbumpc();
+        }
+    }
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -917,6 +924,13 @@ void JsonIn::skip_string()
         err << "expecting string but found '" << ch << "'";
         error( err.str(), -1 );
     }
+    if( stream->good() ) {
+        // Run past the characters that need no checks straight from the buffer
+        std::streambuf &buf = *stream->rdbuf();
+        for( int c = buf.sgetc(); c != EOF && c != '\\' && c != '"' && c != '\r' && c != '\n';
+             c = buf.snextc() ) {
+        }
+    }
     while( stream->good() ) {
         stream->get( ch );
         if( ch == '\\' ) {
@@ -1195,8 +1209,14 @@ std::string JsonIn::get_string()
             err = "expected string but got '" + std::string( 1, ch ) + "'";
             break;
         }
+        std::streambuf &buf = *stream->rdbuf();
         // add chars to the string, one at a time
         do {
+            // Printable ASCII needs no decoding, copy it straight from the buffer
+            for( int c = buf.sgetc(); c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+                 c = buf.snextc() ) {
+                s += static_cast<char>( c );
+            }
             ch = stream->peek();
             if( !stream->good() ) {
                 err = "read operation failed";
@@ -153,6 +153,12 @@ void kill_tracker::notify( const cata::event &e )
     }
 }
 
+bool kill_tracker::wants( event_type type ) const
+{
+    return type == event_type::character_kills_monster ||
+           type == event_type::character_kills_character;
+}
+
 void kill_tracker::add_monster( mtype_id victim )
 {
     kills[victim]++;
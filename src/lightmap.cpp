@@ -1,23 +1,34 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_unreachable.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "character.h"
 #include "cuboid_rectangle.h"
+#include "debug.h"
 #include "field.h"
 #include "fragment_cloud.h" // IWYU pragma: keep
 #include "game.h"
+#include "hash_utils.h"
 #include "int_id.h"
 #include "item.h"
 #include "item_stack.h"
@@ -29,11 +40,13 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "player.h"
 #include "point.h"
 #include "profile.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "type_id.h"
 #include "veh_type.h"
@@ -101,9 +114,92 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
     }
 }
 
+// Nudge things towards the shadowcasting fast paths
+static void snap_to_lookup_transparency( float *values, int count )
+{
+    const float openair = openair_transparency_lookup.transparency;
+    const float weather = weather_transparency_lookup.transparency;
+    for( int i = 0; i < count; ++i ) {
+        const float v = values[i];
+        values[i] = std::fabs( v - openair ) <= 0.0001f ? openair :
+                    std::fabs( v - weather ) <= 0.0001f ? weather : v;
+    }
+}
+
+// Transparency of a single tile of a submap, sp is the position on it, p in map local coords
+static float tile_transparency( const submap &sm, point sp, point p,
+                                const bool ( &outside_cache )[MAPSIZE_X][MAPSIZE_Y], float sight_penalty )
+{
+    if( !( sm.get_ter( sp ).obj().transparent && sm.get_furn( sp ).obj().transparent ) ) {
+        return LIGHT_TRANSPARENCY_SOLID;
+    }
+    float value = LIGHT_TRANSPARENCY_OPEN_AIR;
+    if( outside_cache[p.x][p.y] ) {
+        // FIXME: Places inside vehicles haven't been marked as
+        // inside yet so this is incorrectly penalising for
+        // weather in vehicles.
+        value *= sight_penalty;
+    }
+    for( const auto &fld : sm.get_field( sp ) ) {
+        const field_entry &cur = fld.second;
+        if( cur.is_transparent() ) {
+            continue;
+        }
+        // Fields are either transparent or not, however we want some to be translucent
+        value = value * cur.translucency();
+    }
+    // TODO: [lightmap] Have glass reduce light as well
+    return value;
+}
+
+/**
+ * Fill the SEEX x SEEY block of the transparency cache covered by one non-uniform submap.
+ * Works column by column over the contiguous y runs of both caches: the weather pass is
+ * a plain select/multiply the compiler vectorizes, only solid tiles and fields need lookups.
+ */
+static void build_submap_transparency( const submap &sm, point sm_offset,
+                                       const bool ( &outside_cache )[MAPSIZE_X][MAPSIZE_Y], float sight_penalty,
+                                       float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] )
+{
+    const float outside_value = LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty;
+    for( int sx = 0; sx < SEEX; ++sx ) {
+        const int x = sx + sm_offset.x;
+        float *column = &transparency_cache[x][sm_offset.y];
+        const bool *outside = &outside_cache[x][sm_offset.y];
+        for( int sy = 0; sy < SEEY; ++sy ) {
+            column[sy] = outside[sy] ? outside_value : LIGHT_TRANSPARENCY_OPEN_AIR;
+        }
+        for( int sy = 0; sy < SEEY; ++sy ) {
+            const point sp( sx, sy );
+            if( !( sm.get_ter( sp ).obj().transparent && sm.get_furn( sp ).obj().transparent ) ) {
+                column[sy] = LIGHT_TRANSPARENCY_SOLID;
+                continue;
+            }
+            for( const auto &fld : sm.get_field( sp ) ) {
+                const field_entry &cur = fld.second;
+                if( !cur.is_transparent() ) {
+                    column[sy] *= cur.translucency();
+                }
+            }
+        }
+        snap_to_lookup_transparency( column, SEEY );
+    }
+}
+
+void map::update_weather_transparency()
+{
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+}
+
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
-bool map::build_transparency_cache( const int zlev )
+bool map::build_transparency_cache( const int zlev, float sight_penalty )
 {
+    ZoneScoped;
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
     auto &outside_cache = map_cache.outside_cache;
@@ -112,8 +208,6 @@ bool map::build_transparency_cache( const int zlev )
         return false;
     }
 
-    std::set<tripoint> vehicles_processed;
-
     // if true, all submaps are invalid (can use batch init)
     bool rebuild_all = map_cache.transparency_cache_dirty.all();
 
@@ -123,54 +217,19 @@ bool map::build_transparency_cache( const int zlev )
                                    static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
     }
 
-    const float sight_penalty = get_weather().weather_id->sight_penalty;
-
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
-
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            const auto cur_submap = get_submap_at_grid( {smx, smy, zlev} );
-
-            const point sm_offset = sm_to_ms_copy( point( smx, smy ) );
-
             if( !rebuild_all && !map_cache.transparency_cache_dirty[smx * MAPSIZE + smy] ) {
                 continue;
             }
 
-            // calculates transparency of a single tile
-            // x,y - coords in map local coords
-            auto calc_transp = [&]( point  p ) {
-                const point sp = p - sm_offset;
-                float value = LIGHT_TRANSPARENCY_OPEN_AIR;
-
-                if( !( cur_submap->get_ter( sp ).obj().transparent &&
-                       cur_submap->get_furn( sp ).obj().transparent ) ) {
-                    return LIGHT_TRANSPARENCY_SOLID;
-                }
-                if( outside_cache[p.x][p.y] ) {
-                    // FIXME: Places inside vehicles haven't been marked as
-                    // inside yet so this is incorrectly penalising for
-                    // weather in vehicles.
-                    value *= sight_penalty;
-                }
-                for( const auto &fld : cur_submap->get_field( sp ) ) {
-                    const field_entry &cur = fld.second;
-                    if( cur.is_transparent() ) {
-                        continue;
-                    }
-                    // Fields are either transparent or not, however we want some to be translucent
-                    value = value * cur.translucency();
-                }
-                // TODO: [lightmap] Have glass reduce light as well
-                return value;
-            };
+            const submap *cur_submap = get_submap_at_grid( {smx, smy, zlev} );
+            const point sm_offset = sm_to_ms_copy( point( smx, smy ) );
 
             if( cur_submap->is_uniform ) {
-                float value = calc_transp( sm_offset );
+                float value = tile_transparency( *cur_submap, point_zero, sm_offset, outside_cache,
+                                                 sight_penalty );
                 // if rebuild_all==true all values were already set to LIGHT_TRANSPARENCY_OPEN_AIR
                 if( !rebuild_all || value != LIGHT_TRANSPARENCY_OPEN_AIR ) {
                     for( int sx = 0; sx < SEEX; ++sx ) {
@@ -179,21 +238,8 @@ bool map::build_transparency_cache( const int zlev )
                     }
                 }
             } else {
-                for( int sx = 0; sx < SEEX; ++sx ) {
-                    const int x = sx + sm_offset.x;
-                    for( int sy = 0; sy < SEEY; ++sy ) {
-                        const int y = sy + sm_offset.y;
-                        transparency_cache[x][y] = calc_transp( { x, y } );
-
-                        //Nudge things towards fast paths
-                        if( std::fabs( transparency_cache[x][y] - openair_transparency_lookup.transparency ) <= 0.0001 ) {
-                            transparency_cache[x][y] = openair_transparency_lookup.transparency;
-                        } else if( std::fabs( transparency_cache[x][y] - weather_transparency_lookup.transparency ) <=
-                                   0.0001 ) {
-                            transparency_cache[x][y] = weather_transparency_lookup.transparency;
-                        }
-                    }
-                }
+                build_submap_transparency( *cur_submap, sm_offset, outside_cache, sight_penalty,
+                                           transparency_cache );
             }
         }
     }
@@ -203,6 +249,7 @@ bool map::build_transparency_cache( const int zlev )
 
 bool map::build_vision_transparency_cache( const Character &player )
 {
+    ZoneScoped;
     const tripoint &p = player.pos();
 
     bool dirty = false;
@@ -273,17 +320,86 @@ void map::apply_character_light( Character &p )
         apply_light_source( p.pos(), held_luminance );
     }
 
+    if( recorded_lights ) {
+        // Checked by generate_lightmap once the light up to this point is known
+        recorded_lights->push_back( { light_op::kind::character, p.pos(), held_luminance,
+                                      0_degrees, 0_degrees, 0, &p } );
+        return;
+    }
+
     if( held_luminance >= 4 && held_luminance > ambient_light_at( p.pos() ) - 0.5f ) {
         p.add_effect( effect_haslight, 1_turns );
     }
 }
 
+// Sunlight reaching p from the level above, which has already been cast.
+// sunlit is set if any of that light is brighter than inside_light_level.
+static four_quadrants sunlight_from_above( point p, const level_cache &above, bool outside,
+        float sight_penalty, float inside_light_level, bool &sunlit )
+{
+    // TODO: Replace these with a lookup inside the four_quadrants class.
+    constexpr std::array<point, 5> cardinals = {
+        {point_zero, point_north, point_west, point_east, point_south}
+    };
+    constexpr std::array<std::array<quadrant, 2>, 5> dir_quadrants = {{
+            {{quadrant::NE, quadrant::NW}},
+            {{quadrant::NE, quadrant::NW}},
+            {{quadrant::SW, quadrant::NW}},
+            {{quadrant::SE, quadrant::NE}},
+            {{quadrant::SE, quadrant::SW}},
+        }
+    };
+
+    // Fall back to minimal light level if we don't find anything.
+    four_quadrants result( inside_light_level );
+    // Check center, then four adjacent cardinals.
+    for( int i = 0; i < 5; ++i ) {
+        const point prev = p + cardinals[i];
+        bool inbounds = prev.x >= 0 && prev.x < MAPSIZE_X &&
+                        prev.y >= 0 && prev.y < MAPSIZE_Y;
+
+        if( !inbounds ) {
+            continue;
+        }
+
+        float prev_light_max;
+        float prev_transparency = above.transparency_cache[prev.x][prev.y];
+        // This is pretty gross, this cancels out the per-tile transparency effect
+        // derived from weather.
+        if( outside ) {
+            prev_transparency /= sight_penalty;
+        }
+
+        if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
+            !above.floor_cache[prev.x][prev.y] &&
+            ( prev_light_max = above.sunlight_cache[prev.x][prev.y].max() ) > 0.0 ) {
+            const float light_level = clamp( prev_light_max * LIGHT_TRANSPARENCY_OPEN_AIR / prev_transparency,
+                                             inside_light_level, prev_light_max );
+
+            sunlit = sunlit || light_level > inside_light_level;
+            if( i == 0 ) {
+                result.fill( light_level );
+                break;
+            } else {
+                result[dir_quadrants[i][0]] = light_level;
+                result[dir_quadrants[i][1]] = light_level;
+            }
+        }
+    }
+    return result;
+}
+
 // This function raytraces starting at the upper limit of the simulated area descending
 // toward the lower limit. Since it's sunlight, the rays are parallel.
 // Each layer consults the next layer up to determine the intensity of the light that reaches it.
 // Once this is complete, additional operations add more dynamic lighting.
+//
+// Every level keeps its sunlight and the inputs it was cast from, so when those are unchanged
+// only tiles below a changed tile are cast again: a tile only sees its own column and the four
+// columns next to it on the level above.
 void map::build_sunlight_cache( int pzlev )
 {
+    ZoneScoped;
     const int zlev_min = zlevels ? -OVERMAP_DEPTH : pzlev;
     // Start at the topmost populated zlevel to avoid unnecessary raycasting
     // Plus one zlevel to prevent clipping inside structures
@@ -292,6 +408,14 @@ void map::build_sunlight_cache( int pzlev )
                                   std::min( OVERMAP_HEIGHT, pzlev + 1 ),
                                   OVERMAP_HEIGHT )
                          : pzlev;
+    // Grab illumination at ground level.
+    const float outside_light_level = g->natural_light_level( 0 );
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    const std::tuple<int, float, float> inputs( zlev_max, outside_light_level, sight_penalty );
+    const bool reuse = zlevels && sunlight_valid && inputs == last_sunlight_inputs;
+    last_sunlight_inputs = inputs;
+    sunlight_valid = zlevels;
 
     // true if all previous z-levels are fully transparent to light (no floors, transparency >= air)
     bool fully_outside = true;
@@ -306,13 +430,16 @@ void map::build_sunlight_cache( int pzlev )
     //    ↓
     // when fully below ground: fully_outside=false, fully_inside=true  (fast fill)
 
+    // Tiles of the level above whose sunlight, transparency or floor changed since the last build
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> changed_above;
+
     // Iterate top to bottom because sunlight cache needs to construct in that order.
     for( int zlev = zlev_max; zlev >= zlev_min; zlev-- ) {
 
         level_cache &map_cache = get_cache( zlev );
         auto &lm = map_cache.lm;
-        // Grab illumination at ground level.
-        const float outside_light_level = g->natural_light_level( 0 );
+        const std::bitset<MAPSIZE_X *MAPSIZE_Y> stale = map_cache.sunlight_stale;
+        map_cache.sunlight_stale.reset();
         // TODO: if zlev < 0 is open to sunlight, this won't calculate correct light, but neither does g->natural_light_level()
         const float inside_light_level = ( zlev >= 0 && outside_light_level > LIGHT_SOURCE_BRIGHT ) ?
                                          LIGHT_AMBIENT_DIM * 0.8 : LIGHT_AMBIENT_LOW;
@@ -331,20 +458,54 @@ void map::build_sunlight_cache( int pzlev )
             continue;
         }
 
-        // all light was blocked before
-        if( fully_inside ) {
-            std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
-            continue;
+        auto &sunlight = map_cache.sunlight_cache;
+        const auto &this_floor_cache = map_cache.floor_cache;
+        const auto &this_transparency_cache = map_cache.transparency_cache;
+        const auto &outside_cache = map_cache.outside_cache;
+
+        // What changed on this level since it was last cast
+        std::bitset<MAPSIZE_X *MAPSIZE_Y> inputs_changed;
+        std::bitset<MAPSIZE_X *MAPSIZE_Y> outside_changed;
+        std::bitset<MAPSIZE_X *MAPSIZE_Y> changed;
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                const std::size_t i = level_cache::veh_exists_index( point( x, y ) );
+                inputs_changed[i] = this_transparency_cache[x][y] != map_cache.sunlight_transparency[x][y] ||
+                                    this_floor_cache[x][y] != map_cache.sunlight_floor[x][y];
+                outside_changed[i] = outside_cache[x][y] != map_cache.sunlight_outside[x][y];
+            }
+        }
+        std::copy_n( &this_transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
+                     &map_cache.sunlight_transparency[0][0] );
+        std::copy_n( &this_floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, &map_cache.sunlight_floor[0][0] );
+        std::copy_n( &outside_cache[0][0], MAPSIZE_X * MAPSIZE_Y, &map_cache.sunlight_outside[0][0] );
+        if( !reuse ) {
+            inputs_changed.set();
+            outside_changed.set();
+        } else {
+            // The shifted in inputs could happen to match what the shift left there
+            inputs_changed |= stale;
+            outside_changed |= stale;
         }
 
-        // If there were no obstacles before this level, just apply weather illumination since there's no opportunity
-        // for light to be blocked.
-        if( fully_outside ) {
-            //fill with full light
-            std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( outside_light_level ) );
+        // all light was blocked before, or if there were no obstacles before this level,
+        // just apply weather illumination since there's no opportunity for light to be blocked.
+        if( fully_inside || fully_outside ) {
+            const four_quadrants fill( fully_inside ? inside_light_level : outside_light_level );
+            for( int x = 0; x < MAPSIZE_X; ++x ) {
+                for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                    if( sunlight[x][y].values != fill.values ) {
+                        changed.set( level_cache::veh_exists_index( point( x, y ) ) );
+                        sunlight[x][y] = fill;
+                    }
+                }
+            }
+            map_cache.sunlight_cast = false;
+        }
 
-            const auto &this_floor_cache = map_cache.floor_cache;
-            const auto &this_transparency_cache = map_cache.transparency_cache;
+        if( fully_inside ) {
+            // stays fully inside
+        } else if( fully_outside ) {
             fully_inside = true; // recalculate
 
             for( int x = 0; x < MAPSIZE_X; ++x ) {
@@ -359,129 +520,137 @@ void map::build_sunlight_cache( int pzlev )
                                                      this_floor_cache[x][y] );
                 }
             }
-            continue;
-        }
-
-        // Replace this with a calculated shift based on time of day and date.
-        // At first compress the angle such that it takes no more than one tile of shift per level.
-        // To exceed that, we'll have to handle casting light from the side instead of the top.
-        point offset;
-        const level_cache &prev_map_cache = get_cache_ref( zlev + 1 );
-        const auto &prev_lm = prev_map_cache.lm;
-        const auto &prev_transparency_cache = prev_map_cache.transparency_cache;
-        const auto &prev_floor_cache = prev_map_cache.floor_cache;
-        const auto &outside_cache = map_cache.outside_cache;
-        const float sight_penalty = get_weather().weather_id->sight_penalty;
-        // TODO: Replace these with a lookup inside the four_quadrants class.
-        constexpr std::array<point, 5> cardinals = {
-            {point_zero, point_north, point_west, point_east, point_south}
-        };
-        constexpr std::array<std::array<quadrant, 2>, 5> dir_quadrants = {{
-                {{quadrant::NE, quadrant::NW}},
-                {{quadrant::NE, quadrant::NW}},
-                {{quadrant::SW, quadrant::NW}},
-                {{quadrant::SE, quadrant::NE}},
-                {{quadrant::SE, quadrant::SW}},
+        } else {
+            // A tile needs casting if its own outside flag changed, or anything it sees above did
+            std::bitset<MAPSIZE_X *MAPSIZE_Y> dirty;
+            if( reuse && map_cache.sunlight_cast ) {
+                // Shifting across a row end only marks a few extra tiles
+                dirty = outside_changed | changed_above | changed_above << 1 | changed_above >> 1 |
+                        changed_above << MAPSIZE_X | changed_above >> MAPSIZE_X;
+            } else {
+                dirty.set();
             }
-        };
-
-        fully_inside = true; // recalculate
 
-        // Fall back to minimal light level if we don't find anything.
-        std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
-
-        for( int x = 0; x < MAPSIZE_X; ++x ) {
-            for( int y = 0; y < MAPSIZE_Y; ++y ) {
-                // Check center, then four adjacent cardinals.
-                for( int i = 0; i < 5; ++i ) {
-                    int prev_x = x + offset.x + cardinals[i].x;
-                    int prev_y = y + offset.y + cardinals[i].y;
-                    bool inbounds = prev_x >= 0 && prev_x < MAPSIZE_X &&
-                                    prev_y >= 0 && prev_y < MAPSIZE_Y;
-
-                    if( !inbounds ) {
+            const level_cache &prev_map_cache = get_cache_ref( zlev + 1 );
+            for( int x = 0; x < MAPSIZE_X; ++x ) {
+                for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                    const std::size_t i = level_cache::veh_exists_index( point( x, y ) );
+                    if( !dirty[i] ) {
                         continue;
                     }
-
-                    float prev_light_max;
-                    float prev_transparency = prev_transparency_cache[prev_x][prev_y];
-                    // This is pretty gross, this cancels out the per-tile transparency effect
-                    // derived from weather.
-                    if( outside_cache[x][y] ) {
-                        prev_transparency /= sight_penalty;
-                    }
-
-                    if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
-                        !prev_floor_cache[prev_x][prev_y] &&
-                        ( prev_light_max = prev_lm[prev_x][prev_y].max() ) > 0.0 ) {
-                        const float light_level = clamp( prev_light_max * LIGHT_TRANSPARENCY_OPEN_AIR / prev_transparency,
-                                                         inside_light_level, prev_light_max );
-
-                        if( i == 0 ) {
-                            lm[x][y].fill( light_level );
-                            fully_inside &= light_level <= inside_light_level;
-                            break;
-                        } else {
-                            fully_inside &= light_level <= inside_light_level;
-                            lm[x][y][dir_quadrants[i][0]] = light_level;
-                            lm[x][y][dir_quadrants[i][1]] = light_level;
-                        }
+                    bool sunlit = false;
+                    const four_quadrants light = sunlight_from_above( point( x, y ), prev_map_cache,
+                                                 outside_cache[x][y], sight_penalty, inside_light_level, sunlit );
+                    map_cache.sunlit[i] = sunlit;
+                    if( sunlight[x][y].values != light.values ) {
+                        changed.set( i );
+                        sunlight[x][y] = light;
                     }
                 }
             }
+            map_cache.sunlight_cast = true;
+            fully_inside = map_cache.sunlit.none();
         }
+
+        std::copy_n( &sunlight[0][0], MAPSIZE_X * MAPSIZE_Y, &lm[0][0] );
+        changed_above = changed | inputs_changed;
     }
 }
 
+static constexpr std::array<int, 4> dir_x = { {  0, -1, 1, 0 } };    //    [0]
+static constexpr std::array<int, 4> dir_y = { { -1,  0, 0, 1 } };    // [1][X][2]
+static constexpr std::array<int, 4> dir_d = { { 90, 0, 180, 270 } }; //    [3]
+static constexpr std::array<std::array<quadrant, 2>, 4> dir_quadrants = { {
+        {{ quadrant::NE, quadrant::NW }},
+        {{ quadrant::SW, quadrant::NW }},
+        {{ quadrant::SE, quadrant::NE }},
+        {{ quadrant::SE, quadrant::SW }},
+    }
+};
+
+// Hashes a word at a time, the caches checked every turn add up to a few megabytes
+static void hash_bytes( std::size_t &seed, const void *data, std::size_t size )
+{
+    constexpr std::uint64_t prime = 0x100000001b3ULL;
+    const unsigned char *bytes = static_cast<const unsigned char *>( data );
+    std::uint64_t hash = seed;
+    std::size_t i = 0;
+    for( ; i + sizeof( std::uint64_t ) <= size; i += sizeof( std::uint64_t ) ) {
+        std::uint64_t word;
+        std::memcpy( &word, bytes + i, sizeof( word ) );
+        hash = ( hash ^ word ) * prime;
+    }
+    for( ; i < size; ++i ) {
+        hash = ( hash ^ bytes[i] ) * prime;
+    }
+    seed = static_cast<std::size_t>( hash ^ ( hash >> 32 ) );
+}
+
 void map::generate_lightmap( const int zlev )
 {
     ZoneScoped;
-    auto &map_cache = get_cache( zlev );
-    auto &lm = map_cache.lm;
-    auto &sm = map_cache.sm;
-    auto &outside_cache = map_cache.outside_cache;
-    auto &prev_floor_cache = get_cache( clamp( zlev + 1, -OVERMAP_DEPTH, OVERMAP_DEPTH ) ).floor_cache;
-    bool top_floor = zlev == OVERMAP_DEPTH;
-    std::memset( lm, 0, sizeof( lm ) );
-    std::memset( sm, 0, sizeof( sm ) );
+    std::vector<light_op> ops;
+    std::vector<std::pair<tripoint, float>> lm_override;
+    collect_lights( zlev, ops, lm_override );
+    const std::size_t inputs = lightmap_inputs_hash( zlev, ops, lm_override );
 
-    /* Bulk light sources wastefully cast rays into neighbors; a burning hospital can produce
-         significant slowdown, so for stuff like fire and lava:
-     * Step 1: Store the position and luminance in buffer via add_light_source, for efficient
-         checking of neighbors.
-     * Step 2: After everything else, iterate buffer and apply_light_source only in non-redundant
-         directions
-     * Step 3: ????
-     * Step 4: Profit!
-     */
-    auto &light_source_buffer = map_cache.light_source_buffer;
-    std::memset( light_source_buffer, 0, sizeof( light_source_buffer ) );
+    if( !lightmap_valid || inputs != last_lightmap_inputs || ops.size() != last_light_ops.size() ) {
+        apply_lights( zlev, ops, lm_override );
+    } else {
+        // Same lights on the same map as last time, the lightmap is still what a rebuild would produce
+        for( size_t i = 0; i < ops.size(); ++i ) {
+            ops[i].ambient = last_light_ops[i].ambient;
+        }
+        if( get_option<bool>( "VERIFY_LIGHTMAP" ) ) {
+            const level_cache &map_cache = get_cache_ref( zlev );
+            const std::vector<four_quadrants> kept_lm( &map_cache.lm[0][0],
+                    &map_cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+            const std::vector<float> kept_sm( &map_cache.sm[0][0],
+                                              &map_cache.sm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+            apply_lights( zlev, ops, lm_override );
+            if( std::memcmp( kept_lm.data(), map_cache.lm, sizeof( map_cache.lm ) ) != 0 ||
+                std::memcmp( kept_sm.data(), map_cache.sm, sizeof( map_cache.sm ) ) != 0 ) {
+                debugmsg( "Kept lightmap of z-level %d differs from a full rebuild", zlev );
+            }
+        }
+    }
 
-    constexpr std::array<int, 4> dir_x = { {  0, -1, 1, 0 } };    //    [0]
-    constexpr std::array<int, 4> dir_y = { { -1,  0, 0, 1 } };    // [1][X][2]
-    constexpr std::array<int, 4> dir_d = { { 90, 0, 180, 270 } }; //    [3]
-    constexpr std::array<std::array<quadrant, 2>, 4> dir_quadrants = { {
-            {{ quadrant::NE, quadrant::NW }},
-            {{ quadrant::SW, quadrant::NW }},
-            {{ quadrant::SE, quadrant::NE }},
-            {{ quadrant::SE, quadrant::SW }},
+    for( const light_op &op : ops ) {
+        if( op.type == light_op::kind::character && op.luminance >= 4 &&
+            op.luminance > op.ambient - 0.5f ) {
+            op.who->add_effect( effect_haslight, 1_turns );
         }
-    };
+    }
 
-    const float natural_light = g->natural_light_level( zlev );
+    last_light_ops = std::move( ops );
+    last_lightmap_inputs = inputs;
+    lightmap_valid = true;
+}
 
-    build_sunlight_cache( zlev );
+void map::collect_lights( const int zlev, std::vector<light_op> &ops,
+                          std::vector<std::pair<tripoint, float>> &lm_override )
+{
+    ZoneScoped;
+    auto &map_cache = get_cache( zlev );
+    auto &outside_cache = map_cache.outside_cache;
+    auto &prev_floor_cache = get_cache( clamp( zlev + 1, -OVERMAP_DEPTH, OVERMAP_DEPTH ) ).floor_cache;
+    bool top_floor = zlev == OVERMAP_DEPTH;
+
+    restore_on_out_of_scope<std::vector<light_op> *> restore_recording( recorded_lights );
+    recorded_lights = &ops;
 
     apply_character_light( get_player_character() );
     for( npc &guy : g->all_npcs() ) {
         apply_character_light( guy );
     }
 
-    std::vector<std::pair<tripoint, float>> lm_override;
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
+            // Sorted the same way as this loop, so it's enough to look at the next one
+            const std::vector<point> &emitters = cur_submap->get_light_emitters();
+            auto next_emitter = emitters.begin();
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -497,22 +666,17 @@ void map::generate_lightmap( const int zlev )
                                 && outside_cache[neighbour.x][neighbour.y] &&
                                 ( top_floor || !prev_floor_cache[neighbour.x][neighbour.y] )
                               ) {
-                                const float source_light =
-                                    std::min( natural_light, lm[neighbour.x][neighbour.y].max() );
-                                if( light_transparency( p ) > LIGHT_TRANSPARENCY_SOLID ) {
-                                    update_light_quadrants( lm[p.x][p.y], source_light, quadrant::default_ );
-                                    apply_directional_light( p, dir_d[i], source_light );
-                                } else {
-                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][0] );
-                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][1] );
-                                }
+                                ops.push_back( { light_op::kind::opening, p, 0.0f, 0_degrees, 0_degrees, i } );
                             }
                         }
                     }
 
-                    if( cur_submap->get_lum( { sx, sy } ) && has_items( p ) ) {
-                        auto items = i_at( p );
-                        add_light_from_items( p, items.begin(), items.end() );
+                    if( next_emitter != emitters.end() && *next_emitter == point( sx, sy ) ) {
+                        ++next_emitter;
+                        if( has_items( p ) ) {
+                            auto items = i_at( p );
+                            add_light_from_items( p, items.begin(), items.end() );
+                        }
                     }
 
                     const ter_id terrain = cur_submap->get_ter( { sx, sy } );
@@ -629,6 +793,101 @@ void map::generate_lightmap( const int zlev )
             }
         }
     }
+}
+
+std::size_t map::lightmap_inputs_hash( const int zlev, const std::vector<light_op> &ops,
+                                      const std::vector<std::pair<tripoint, float>> &lm_override )
+{
+    std::size_t seed = ops.size();
+    cata::hash_combine( seed, zlev );
+    cata::hash_combine( seed, zlevels );
+    cata::hash_combine( seed, trigdist );
+    cata::hash_combine( seed, calc_max_populated_zlev() );
+    cata::hash_combine( seed, g->natural_light_level( 0 ) );
+    cata::hash_combine( seed, g->natural_light_level( zlev ) );
+    cata::hash_combine( seed, get_weather().weather_id->sight_penalty );
+    for( const light_op &op : ops ) {
+        cata::hash_combine( seed, static_cast<int>( op.type ) );
+        cata::hash_combine( seed, op.p );
+        cata::hash_combine( seed, op.luminance );
+        cata::hash_combine( seed, op.angle.value() );
+        cata::hash_combine( seed, op.width.value() );
+        cata::hash_combine( seed, op.direction );
+    }
+    for( const std::pair<tripoint, float> &elem : lm_override ) {
+        cata::hash_combine( seed, elem.first );
+        cata::hash_combine( seed, elem.second );
+    }
+    // Sunlight is cast through every z-level, the lights themselves read this level's caches
+    const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
+    const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
+    for( int z = minz; z <= maxz; z++ ) {
+        const level_cache &ch = get_cache_ref( z );
+        hash_bytes( seed, ch.transparency_cache, sizeof( ch.transparency_cache ) );
+        hash_bytes( seed, ch.floor_cache, sizeof( ch.floor_cache ) );
+        hash_bytes( seed, ch.outside_cache, sizeof( ch.outside_cache ) );
+        hash_bytes( seed, ch.vehicle_obscured_cache, sizeof( ch.vehicle_obscured_cache ) );
+    }
+    return seed;
+}
+
+void map::apply_lights( const int zlev, std::vector<light_op> &ops,
+                        const std::vector<std::pair<tripoint, float>> &lm_override )
+{
+    ZoneScoped;
+    auto &map_cache = get_cache( zlev );
+    auto &lm = map_cache.lm;
+    auto &sm = map_cache.sm;
+    std::memset( lm, 0, sizeof( lm ) );
+    std::memset( sm, 0, sizeof( sm ) );
+
+    /* Bulk light sources wastefully cast rays into neighbors; a burning hospital can produce
+         significant slowdown, so for stuff like fire and lava:
+     * Step 1: Store the position and luminance in buffer via add_light_source, for efficient
+         checking of neighbors.
+     * Step 2: After everything else, iterate buffer and apply_light_source only in non-redundant
+         directions
+     * Step 3: ????
+     * Step 4: Profit!
+     */
+    auto &light_source_buffer = map_cache.light_source_buffer;
+    std::memset( light_source_buffer, 0, sizeof( light_source_buffer ) );
+
+    const float natural_light = g->natural_light_level( zlev );
+
+    build_sunlight_cache( zlev );
+
+    // Same order they were recorded in, light sources check the buffer filled so far
+    for( light_op &op : ops ) {
+        switch( op.type ) {
+            case light_op::kind::source:
+                apply_light_source( op.p, op.luminance );
+                break;
+            case light_op::kind::buffered:
+                add_light_source( op.p, op.luminance );
+                break;
+            case light_op::kind::arc:
+                apply_light_arc( op.p, op.angle, op.luminance, op.width );
+                break;
+            case light_op::kind::opening: {
+                const int i = op.direction;
+                const point neighbour = op.p.xy() + point( dir_x[i], dir_y[i] );
+                const float source_light =
+                    std::min( natural_light, lm[neighbour.x][neighbour.y].max() );
+                if( light_transparency( op.p ) > LIGHT_TRANSPARENCY_SOLID ) {
+                    update_light_quadrants( lm[op.p.x][op.p.y], source_light, quadrant::default_ );
+                    apply_directional_light( op.p, dir_d[i], source_light );
+                } else {
+                    update_light_quadrants( lm[op.p.x][op.p.y], source_light, dir_quadrants[i][0] );
+                    update_light_quadrants( lm[op.p.x][op.p.y], source_light, dir_quadrants[i][1] );
+                }
+                break;
+            }
+            case light_op::kind::character:
+                op.ambient = ambient_light_at( op.p );
+                break;
+        }
+    }
 
     /* Now that we have position and intensity of all bulk light sources, apply_ them
       This may seem like extra work, but take a 12x12 raging inferno:
@@ -649,6 +908,10 @@ void map::generate_lightmap( const int zlev )
 
 void map::add_light_source( const tripoint &p, float luminance )
 {
+    if( recorded_lights ) {
+        recorded_lights->push_back( { light_op::kind::buffered, p, luminance } );
+        return;
+    }
     auto &light_source_buffer = get_cache( p.z ).light_source_buffer;
     light_source_buffer[p.x][p.y] = std::max( luminance, light_source_buffer[p.x][p.y] );
 }
@@ -871,6 +1134,189 @@ static inline int fast_rl_dist( tripoint to )
     return a;
 }
 
+// Shadowcasts from closer than this to the edge of their range are cast serially,
+// handing them to the thread pool would cost more than casting them.
+static constexpr int min_parallel_cast_radius = 16;
+
+// An octant as passed to castLight, which covers delta x in [-distance, 0] and delta y = -distance
+struct octant_transform {
+    int xx;
+    int xy;
+    int yx;
+    int yy;
+};
+
+// Part of the map an octant cast from offset can reach
+static half_open_rectangle<point> octant_bounds( const octant_transform &o, point offset,
+        int radius )
+{
+    point lo = offset;
+    point hi = offset;
+    for( int dx : { -radius, 0 } ) {
+        for( int dy : { -radius, -1 } ) {
+            const point p( offset.x + dx * o.xx + dy * o.xy, offset.y + dx * o.yx + dy * o.yy );
+            lo = point( std::min( lo.x, p.x ), std::min( lo.y, p.y ) );
+            hi = point( std::max( hi.x, p.x ), std::max( hi.y, p.y ) );
+        }
+    }
+    return half_open_rectangle<point>(
+               point( clamp( lo.x, 0, MAPSIZE_X ), clamp( lo.y, 0, MAPSIZE_Y ) ),
+               point( clamp( hi.x + 1, 0, MAPSIZE_X ), clamp( hi.y + 1, 0, MAPSIZE_Y ) ) );
+}
+
+static half_open_rectangle<point> octant_bounds( const std::array<octant_transform, 2> &octants,
+        point offset, int radius )
+{
+    const half_open_rectangle<point> a = octant_bounds( octants[0], offset, radius );
+    const half_open_rectangle<point> b = octant_bounds( octants[1], offset, radius );
+    return half_open_rectangle<point>(
+               point( std::min( a.p_min.x, b.p_min.x ), std::min( a.p_min.y, b.p_min.y ) ),
+               point( std::max( a.p_max.x, b.p_max.x ), std::max( a.p_max.y, b.p_max.y ) ) );
+}
+
+template<typename Out>
+struct shadowcast_grid {
+    Out cells[MAPSIZE_X][MAPSIZE_Y];
+};
+
+// Scratch grids for casts split over the thread pool, owned by the thread that started the cast
+template<typename Out>
+static Out( &shadowcast_scratch( size_t index ) )[MAPSIZE_X][MAPSIZE_Y]
+{
+    thread_local std::vector<std::unique_ptr<shadowcast_grid<Out>>> grids;
+    if( grids.size() <= index ) {
+        grids.resize( index + 1 );
+    }
+    if( !grids[index] ) {
+        grids[index] = std::make_unique<shadowcast_grid<Out>>();
+    }
+    return grids[index]->cells;
+}
+
+static void merge_cast( float &out, const float &in )
+{
+    if( out < in ) {
+        out = in;
+    }
+}
+
+static void merge_cast( four_quadrants &out, const four_quadrants &in )
+{
+    out = elementwise_max( out, in );
+}
+
+// Fills the box with a value every update raises
+template<typename Out>
+static void clear_cast( Out( &grid )[MAPSIZE_X][MAPSIZE_Y], const half_open_rectangle<point> &box )
+{
+    const Out lowest( std::numeric_limits<float>::lowest() );
+    for( int x = box.p_min.x; x < box.p_max.x; ++x ) {
+        std::fill( &grid[x][box.p_min.y], &grid[x][std::max( box.p_min.y, box.p_max.y )], lowest );
+    }
+}
+
+template<typename Out>
+static void merge_cast( Out( &output )[MAPSIZE_X][MAPSIZE_Y],
+                        const Out( &grid )[MAPSIZE_X][MAPSIZE_Y], const half_open_rectangle<point> &box )
+{
+    for( int x = box.p_min.x; x < box.p_max.x; ++x ) {
+        for( int y = box.p_min.y; y < box.p_max.y; ++y ) {
+            merge_cast( output[x][y], grid[x][y] );
+        }
+    }
+}
+
+// Two octants cast by one task
+template<typename Out>
+struct octant_pair_cast {
+    std::array<octant_transform, 2> octants;
+    std::function<void( Out( & )[MAPSIZE_X][MAPSIZE_Y] )> cast;
+};
+
+/**
+ * Casts the octant pairs, on the thread pool if the cast is big enough.
+ * Octants share the cells along their edges and every output update is a max, so each task
+ * casts into its own grid and the grids are max-merged into the output, which gives the
+ * same result as casting them one after another.
+ */
+template<typename Out>
+static void cast_octant_pairs( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y], point offset,
+                               int offset_distance, const std::vector<octant_pair_cast<Out>> &casts )
+{
+    const int radius = 60 - offset_distance;
+    thread_pool &pool = get_thread_pool();
+    if( radius < min_parallel_cast_radius || pool.concurrency() == 1 || casts.size() < 2 ) {
+        for( const octant_pair_cast<Out> &c : casts ) {
+            c.cast( output_cache );
+        }
+        return;
+    }
+
+    std::vector<Out( * )[MAPSIZE_X][MAPSIZE_Y]> grids;
+    std::vector<half_open_rectangle<point>> boxes;
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        grids.push_back( &shadowcast_scratch<Out>( i ) );
+        boxes.push_back( octant_bounds( casts[i].octants, offset, radius ) );
+    }
+    pool.parallel_for( 0, static_cast<int>( casts.size() ), [&]( int i ) {
+        clear_cast( *grids[i], boxes[i] );
+        casts[i].cast( *grids[i] );
+    } );
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        merge_cast( output_cache, *grids[i], boxes[i] );
+    }
+}
+
+// Two cast_zlight segments cast by one task, octants as castLight would see them
+template<typename T>
+struct zlight_pair_cast {
+    std::array<octant_transform, 2> octants;
+    int zz;
+    std::function<void( const array_of_grids_of<T> & )> cast;
+};
+
+// Like cast_octant_pairs, with a grid for each z-level a task can reach
+template<typename T>
+static void cast_zlight_pairs( const array_of_grids_of<T> &output_caches, const tripoint &origin,
+                               int offset_distance, const std::vector<zlight_pair_cast<T>> &casts )
+{
+    const int radius = 60 - offset_distance;
+    thread_pool &pool = get_thread_pool();
+    if( radius < min_parallel_cast_radius || pool.concurrency() == 1 ) {
+        for( const zlight_pair_cast<T> &c : casts ) {
+            c.cast( output_caches );
+        }
+        return;
+    }
+
+    std::vector<array_of_grids_of<T>> grids( casts.size() );
+    std::vector<half_open_rectangle<point>> boxes;
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        boxes.push_back( octant_bounds( casts[i].octants, origin.xy(), radius ) );
+        for( int dz = 0; dz <= fov_3d_z_range; ++dz ) {
+            const int z = origin.z + dz * casts[i].zz;
+            if( z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT ) {
+                grids[i][z + OVERMAP_DEPTH] = &shadowcast_scratch<T>( i * OVERMAP_LAYERS + z + OVERMAP_DEPTH );
+            }
+        }
+    }
+    pool.parallel_for( 0, static_cast<int>( casts.size() ), [&]( int i ) {
+        for( T( *grid )[MAPSIZE_X][MAPSIZE_Y] : grids[i] ) {
+            if( grid != nullptr ) {
+                clear_cast( *grid, boxes[i] );
+            }
+        }
+        casts[i].cast( grids[i] );
+    } );
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            if( grids[i][z] != nullptr ) {
+                merge_cast( *output_caches[z], *grids[i][z], boxes[i] );
+            }
+        }
+    }
+}
+
 // For a direction vector defined by x, y, return the quadrant that's the
 // source of that direction.  Assumes x != 0 && y != 0
 // NOLINTNEXTLINE(cata-xy)
@@ -1122,47 +1568,77 @@ void cast_zlight(
     const array_of_grids_of < const diagonal_blocks > &blocked_caches,
     const tripoint &origin, const int offset_distance, const T numerator )
 {
-    // Down
-    cast_zlight_segment < 0, 1, 0, 1, 0, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < 1, 0, 0, 0, 1, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, -1, 0, 1, 0, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < -1, 0, 0, 0, 1, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, 1, 0, -1, 0, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < 1, 0, 0, 0, -1, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, -1, 0, -1, 0, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < -1, 0, 0, 0, -1, 0, -1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    // Up
-    cast_zlight_segment<0, 1, 0, 1, 0, 0, 1, T, calc, check, accumulate>(
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment<1, 0, 0, 0, 1, 0, 1, T, calc, check, accumulate>(
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, -1, 0, 1, 0, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < -1, 0, 0, 0, 1, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, 1, 0, -1, 0, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < 1, 0, 0, 0, -1, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-
-    cast_zlight_segment < 0, -1, 0, -1, 0, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
-    cast_zlight_segment < -1, 0, 0, 0, -1, 0, 1, T, calc, check, accumulate > (
-        output_caches, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+    ZoneScoped;
+    // Octants as castLight would see them, a segment runs outward from the origin
+    const std::vector<zlight_pair_cast<T>> casts = {
+        // Down
+        {
+            {{ { 0, -1, -1, 0 }, { -1, 0, 0, -1 } }}, -1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, 1, 0, 1, 0, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < 1, 0, 0, 0, 1, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, -1, 0 }, { 1, 0, 0, -1 } }}, -1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, -1, 0, 1, 0, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < -1, 0, 0, 0, 1, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, 1, 0 }, { -1, 0, 0, 1 } }}, -1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, 1, 0, -1, 0, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < 1, 0, 0, 0, -1, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, 1, 0 }, { 1, 0, 0, 1 } }}, -1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, -1, 0, -1, 0, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < -1, 0, 0, 0, -1, 0, -1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        // Up
+        {
+            {{ { 0, -1, -1, 0 }, { -1, 0, 0, -1 } }}, 1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment<0, 1, 0, 1, 0, 0, 1, T, calc, check, accumulate>(
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment<1, 0, 0, 0, 1, 0, 1, T, calc, check, accumulate>(
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, -1, 0 }, { 1, 0, 0, -1 } }}, 1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, -1, 0, 1, 0, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < -1, 0, 0, 0, 1, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, 1, 0 }, { -1, 0, 0, 1 } }}, 1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, 1, 0, -1, 0, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < 1, 0, 0, 0, -1, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, 1, 0 }, { 1, 0, 0, 1 } }}, 1, [&]( const array_of_grids_of<T> &outputs ) {
+                cast_zlight_segment < 0, -1, 0, -1, 0, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+                cast_zlight_segment < -1, 0, 0, 0, -1, 0, 1, T, calc, check, accumulate > (
+                    outputs, input_arrays, floor_caches, blocked_caches, origin, offset_distance, numerator );
+            }
+        },
+    };
+    cast_zlight_pairs( output_caches, origin, offset_distance, casts );
 }
 
 // I can't figure out how to make implicit instantiation work when the parameters of
@@ -1427,25 +1903,41 @@ void castLightAll( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                    const diagonal_blocks( &blocked_array )[MAPSIZE_X][MAPSIZE_Y],
                    point offset, int offsetDistance, T numerator )
 {
-    castLight< 0, 1, 1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr>(
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLight< 1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr>(
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLight < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLight < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLight < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLight < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLight < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLight < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
+    const std::vector<octant_pair_cast<Out>> casts = {
+        {
+            {{ { 0, 1, 1, 0 }, { 1, 0, 0, 1 } }}, [&]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLight<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr>(
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLight<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr>(
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, 1, 0 }, { -1, 0, 0, 1 } }}, [&]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLight < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLight < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, -1, 0 }, { 1, 0, 0, -1 } }}, [&]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLight < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLight < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, -1, 0 }, { -1, 0, 0, -1 } }}, [&]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLight < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLight < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, nullptr, nullptr > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+    };
+    cast_octant_pairs( output_cache, offset, offsetDistance, casts );
 }
 
 template void castLightAll<float, four_quadrants, sight_calc, sight_check,
@@ -1532,6 +2024,53 @@ void map::restore_vision_transparency_cache( const tripoint &center, int target_
     transparency_cache[center.x][center.y] = vision_restore_cache[8];
 }
 
+// The octants cast by castLightAllWithLookup, in the pairs one task casts
+template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( Out &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & ),
+         T( *lookup_calc )( const T &, const T &, const int & )>
+static std::vector<octant_pair_cast<Out>> lookup_octant_pairs(
+        const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+        const diagonal_blocks( &blocked_array )[MAPSIZE_X][MAPSIZE_Y],
+        point offset, int offsetDistance, T numerator )
+{
+    return {
+        {
+            {{ { 0, 1, 1, 0 }, { 1, 0, 0, 1 } }}, [ =, &input_array, &blocked_array]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLightWithLookup<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc>(
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLightWithLookup<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, lookup_calc>(
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, 1, 0 }, { -1, 0, 0, 1 } }}, [ =, &input_array, &blocked_array]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLightWithLookup < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLightWithLookup < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, 1, -1, 0 }, { 1, 0, 0, -1 } }}, [ =, &input_array, &blocked_array]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLightWithLookup < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLightWithLookup < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+        {
+            {{ { 0, -1, -1, 0 }, { -1, 0, 0, -1 } }}, [ =, &input_array, &blocked_array]( Out( &out )[MAPSIZE_X][MAPSIZE_Y] ) {
+                castLightWithLookup < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+                castLightWithLookup < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
+                    out, input_array, blocked_array, offset, offsetDistance, numerator );
+            }
+        },
+    };
+}
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
@@ -1542,25 +2081,9 @@ void castLightAllWithLookup( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                              const diagonal_blocks( &blocked_array )[MAPSIZE_X][MAPSIZE_Y],
                              const point &offset, int offsetDistance, T numerator )
 {
-    castLightWithLookup< 0, 1, 1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc>(
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLightWithLookup< 1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, lookup_calc>(
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLightWithLookup < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLightWithLookup < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLightWithLookup < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLightWithLookup < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-
-    castLightWithLookup < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
-    castLightWithLookup < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate, lookup_calc > (
-        output_cache, input_array, blocked_array, offset, offsetDistance, numerator );
+    cast_octant_pairs( output_cache, offset, offsetDistance,
+                       lookup_octant_pairs<T, Out, calc, check, update_output, accumulate, lookup_calc>(
+                           input_array, blocked_array, offset, offsetDistance, numerator ) );
 }
 
 template void castLightAllWithLookup<float, float, sight_calc, sight_check,
@@ -1578,6 +2101,58 @@ template void castLightAllWithLookup<float, four_quadrants, sight_calc, sight_ch
                                              const point &offset, int offsetDistance, float numerator );
 
 
+// The eight octants of a seen cache cast one after another into output
+static void cast_seen_octants( float ( &output )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &transparency )[MAPSIZE_X][MAPSIZE_Y],
+                               const diagonal_blocks( &blocked )[MAPSIZE_X][MAPSIZE_Y], point offset, int offset_distance )
+{
+    for( const octant_pair_cast<float> &c :
+         lookup_octant_pairs<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+         ( transparency, blocked, offset, offset_distance, VISIBILITY_FULL ) ) {
+        c.cast( output );
+    }
+}
+
+/**
+ * Casts the seen cache of every mirror and camera viewpoint into output, keyed on the position
+ * with the distance light already traveled to get there.
+ * Every update is a max, so on the thread pool each viewpoint is cast into its own grid and
+ * the grids are max-merged, which gives the same result as casting them one after another.
+ */
+static void cast_viewpoints( float ( &output )[MAPSIZE_X][MAPSIZE_Y],
+                             const float ( &transparency )[MAPSIZE_X][MAPSIZE_Y],
+                             const diagonal_blocks( &blocked )[MAPSIZE_X][MAPSIZE_Y],
+                             const std::map<point, int> &viewpoints )
+{
+    thread_pool &pool = get_thread_pool();
+    if( pool.concurrency() == 1 || viewpoints.size() < 2 ) {
+        for( const std::pair<const point, int> &vp : viewpoints ) {
+            castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+            ( output, transparency, blocked, vp.first, vp.second );
+        }
+        return;
+    }
+
+    std::vector<std::pair<point, int>> casts( viewpoints.begin(), viewpoints.end() );
+    std::vector<float( * )[MAPSIZE_X][MAPSIZE_Y]> grids;
+    std::vector<half_open_rectangle<point>> boxes;
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        const point offset = casts[i].first;
+        const int radius = std::max( 60 - casts[i].second, 0 );
+        grids.push_back( &shadowcast_scratch<float>( i ) );
+        boxes.emplace_back(
+            point( clamp( offset.x - radius, 0, MAPSIZE_X ), clamp( offset.y - radius, 0, MAPSIZE_Y ) ),
+            point( clamp( offset.x + radius + 1, 0, MAPSIZE_X ), clamp( offset.y + radius + 1, 0, MAPSIZE_Y ) ) );
+    }
+    pool.parallel_for( 0, static_cast<int>( casts.size() ), [&]( int i ) {
+        clear_cast( *grids[i], boxes[i] );
+        cast_seen_octants( *grids[i], transparency, blocked, casts[i].first, casts[i].second );
+    } );
+    for( size_t i = 0; i < casts.size(); ++i ) {
+        merge_cast( output, *grids[i], boxes[i] );
+    }
+}
+
 /**
  * Calculates the Field Of View for the provided map from the given x, y
  * coordinates. Returns a lightmap for a result where the values represent a
@@ -1592,6 +2167,7 @@ template void castLightAllWithLookup<float, four_quadrants, sight_calc, sight_ch
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    ZoneScoped;
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
@@ -1682,6 +2258,8 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
         }
     }
 
+    // A viewpoint closer to the player sees everything a farther one on the same square does
+    std::map<point, int> viewpoints;
     for( int mirror : mirrors ) {
         bool is_camera = veh->part_info( mirror ).has_flag( "CAMERA" );
         if( is_camera && cam_control < 0 ) {
@@ -1701,15 +2279,18 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
             camera_cache[mirror_pos.x][mirror_pos.y] = LIGHT_TRANSPARENCY_OPEN_AIR;
         }
 
-        // TODO: Factor in the mirror facing and only cast in the
-        // directions the player's line of sight reflects to.
-        //
-        // The naive solution of making the mirrors act like a second player
-        // at an offset appears to give reasonable results though.
-        castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
-        (
-            camera_cache, transparency_cache, blocked_cache, mirror_pos.xy(), offsetDistance );
+        const auto inserted = viewpoints.emplace( mirror_pos.xy(), offsetDistance );
+        if( !inserted.second ) {
+            inserted.first->second = std::min( inserted.first->second, offsetDistance );
+        }
     }
+
+    // TODO: Factor in the mirror facing and only cast in the
+    // directions the player's line of sight reflects to.
+    //
+    // The naive solution of making the mirrors act like a second player
+    // at an offset appears to give reasonable results though.
+    cast_viewpoints( camera_cache, transparency_cache, blocked_cache, viewpoints );
 }
 
 //Schraudolph's algorithm with John's constants
@@ -1750,6 +2331,10 @@ static float light_from_lookup( const float &numerator, const float &transparenc
 
 void map::apply_light_source( const tripoint &p, float luminance )
 {
+    if( recorded_lights ) {
+        recorded_lights->push_back( { light_op::kind::source, p, luminance } );
+        return;
+    }
     auto &cache = get_cache( p.z );
     four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
     float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
@@ -1875,6 +2460,10 @@ void map::apply_light_arc( const tripoint &p, units::angle angle, float luminanc
     if( luminance <= LIGHT_SOURCE_LOCAL ) {
         return;
     }
+    if( recorded_lights ) {
+        recorded_lights->push_back( { light_op::kind::arc, p, luminance, angle, wideangle } );
+        return;
+    }
 
     bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
 
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef CATA_SRC_LINE_MEMO_H
+#define CATA_SRC_LINE_MEMO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "game_constants.h"
+#include "point.h"
+
+/**
+ * Remembers the results of line checks between map squares, like map::sees.
+ *
+ * Direct mapped, a query that lands on a used slot replaces the older result.
+ * Clearing only bumps a generation, so it can be done whenever the checked map data changes.
+ * Counts hits and misses so its effectiveness can be checked from the debug menu.
+ */
+class line_memo
+{
+    public:
+        /** Packs two points in local map coordinates and two small values, nullopt if they don't fit. */
+        static std::optional<std::uint64_t> key( const tripoint &a, const tripoint &b, int c = 0,
+                int d = 0 ) {
+            if( !fits( a ) || !fits( b ) || c < 0 || c > 0xFF || d < 0 || d > 0xFF ) {
+                return std::nullopt;
+            }
+            return pack( a ) | pack( b ) << 21 | static_cast<std::uint64_t>( c ) << 42 |
+                   static_cast<std::uint64_t>( d ) << 50;
+        }
+
+        /** 1 or 0 for a remembered result, -1 if there is none. */
+        int get( std::uint64_t key ) const {
+            if( entries.empty() ) {
+                miss_count++;
+                return -1;
+            }
+            const entry &e = entries[slot( key )];
+            if( e.generation == generation && e.key == key ) {
+                hit_count++;
+                return e.value;
+            }
+            miss_count++;
+            return -1;
+        }
+
+        void insert( std::uint64_t key, bool value ) {
+            if( entries.empty() ) {
+                entries.resize( size );
+            }
+            entries[slot( key )] = { key, generation, value };
+        }
+
+        void clear() {
+            if( ++generation == 0 ) {
+                // Wrapped around, old entries could look current again
+                entries.clear();
+                generation = 1;
+            }
+        }
+
+        std::uint64_t hits() const {
+            return hit_count;
+        }
+        std::uint64_t misses() const {
+            return miss_count;
+        }
+        void reset_stats() {
+            hit_count = 0;
+            miss_count = 0;
+        }
+
+    private:
+        static constexpr int size_bits = 16;
+        static constexpr std::size_t size = std::size_t( 1 ) << size_bits;
+
+        struct entry {
+            std::uint64_t key = 0;
+            std::uint32_t generation = 0;
+            bool value = false;
+        };
+
+        static bool fits( const tripoint &p ) {
+            return p.x >= 0 && p.x <= 0xFF && p.y >= 0 && p.y <= 0xFF &&
+                   p.z >= -OVERMAP_DEPTH && p.z <= OVERMAP_HEIGHT;
+        }
+        static std::uint64_t pack( const tripoint &p ) {
+            return static_cast<std::uint64_t>( p.x ) | static_cast<std::uint64_t>( p.y ) << 8 |
+                   static_cast<std::uint64_t>( p.z + OVERMAP_DEPTH ) << 16;
+        }
+        static std::size_t slot( std::uint64_t key ) {
+            return static_cast<std::size_t>( ( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - size_bits ) );
+        }
+
+        std::vector<entry> entries;
+        std::uint32_t generation = 1;
+        mutable std::uint64_t hit_count = 0;
+        mutable std::uint64_t miss_count = 0;
+};
+
+#endif // CATA_SRC_LINE_MEMO_H
@@ -1,5 +1,6 @@
 #include "loading_ui.h"
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -36,6 +37,7 @@ void loading_ui::new_context( const std::string &desc )
         menu->settext( desc );
         ui = nullptr;
         ui_background = nullptr;
+        last_shown = {};
     }
 }
 
@@ -78,8 +80,15 @@ void loading_ui::show()
     init();
 
     if( menu != nullptr ) {
-        ui_manager::redraw();
-        refresh_display();
+        // Most steps take far less than a frame, drawing and presenting each of them
+        // made loading wait on the screen
+        constexpr std::chrono::milliseconds frame_time( 1000 / 60 );
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if( now - last_shown >= frame_time ) {
+            last_shown = now;
+            ui_manager::redraw();
+            refresh_display();
+        }
         inp_mngr.pump_events();
     }
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_LOADING_UI_H
 #define CATA_SRC_LOADING_UI_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,8 @@ class loading_ui
         std::unique_ptr<uilist> menu;
         std::unique_ptr<ui_adaptor> ui;
         std::unique_ptr<background_pane> ui_background;
+        // When the menu was last drawn, to draw it at most once a frame
+        std::chrono::steady_clock::time_point last_shown;
 
         void init();
     public:
@@ -36,6 +39,8 @@ class loading_ui
         void proceed();
         /**
          * Place the UI onto UI stack and redraw it on the screen (if display is enabled).
+         * Calls coming quicker than a frame apart after the first one of a context only
+         * handle pending events, the next call after that draws the current progress.
          */
         void show();
 };
@@ -0,0 +1,21 @@
+#include "lua_stats.h"
+
+namespace lua_stats
+{
+
+const char *kind_name( lua_call_kind kind )
+{
+    switch( kind ) {
+        case lua_call_kind::hook:
+            return "hook";
+        case lua_call_kind::every_x:
+            return "every_x";
+        case lua_call_kind::iuse:
+            return "iuse";
+        case lua_call_kind::num_lua_call_kinds:
+            break;
+    }
+    return "invalid";
+}
+
+} // namespace lua_stats
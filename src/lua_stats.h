@@ -0,0 +1,61 @@
+#pragma once
+#ifndef CATA_SRC_LUA_STATS_H
+#define CATA_SRC_LUA_STATS_H
+
+#include <cstdint>
+#include <string>
+
+#include "phase_stats.h"
+
+/** How the game called into a piece of mod Lua code. */
+enum class lua_call_kind : int {
+    /** A function in one of the game.hooks lists. */
+    hook,
+    /** A function registered to run every so often, see game.add_on_every_x_hook. */
+    every_x,
+    /** A function from game.iuse_functions, used by an item. */
+    iuse,
+    num_lua_call_kinds
+};
+
+/**
+ * Wall time and call counts of mod Lua functions, by how they were called and by
+ * where they were defined, so the mod they came from shows in the id.
+ */
+namespace lua_stats
+{
+
+const char *kind_name( lua_call_kind kind );
+
+using stats = phase_stats::per_id<lua_call_kind, kind_name>;
+/** Adds the time from its creation to its end to the totals of `id`. */
+using timer = stats::timer;
+
+/** How many times `id` was timed as `kind` since the last reset. */
+inline std::uint64_t count( lua_call_kind kind, const std::string &id )
+{
+    return stats::count( kind, id );
+}
+inline std::uint64_t microseconds( lua_call_kind kind, const std::string &id )
+{
+    return stats::microseconds( kind, id );
+}
+
+inline void reset()
+{
+    stats::reset();
+}
+/** One line for each of the `max_lines` ids that took the longest since the last reset. */
+inline std::string report( int max_lines )
+{
+    return stats::report( max_lines );
+}
+/** All the totals since the last reset, one row for each kind and id, longest first. */
+inline std::string csv()
+{
+    return stats::csv();
+}
+
+} // namespace lua_stats
+
+#endif // CATA_SRC_LUA_STATS_H
@@ -2149,6 +2149,11 @@ bool fake_spell::operator==( const fake_spell &rhs ) const
            npc_trigger_message == rhs.npc_trigger_message;
 }
 
+bool spell_events::wants( event_type type ) const
+{
+    return type == event_type::player_levels_spell;
+}
+
 void spell_events::notify( const cata::event &e )
 {
     switch( e.type() ) {
@@ -163,10 +163,11 @@ void enchantment::reset()
 
 bool enchantment::is_active( const Character &guy, const item &parent ) const
 {
-    if( !guy.has_item( parent ) ) {
-        return false;
-    }
+    return guy.has_item( parent ) && is_active_carried( guy, parent );
+}
 
+bool enchantment::is_active_carried( const Character &guy, const item &parent ) const
+{
     if( active_conditions.first == has::WIELD && !guy.is_wielding( parent ) ) {
         return false;
     }
@@ -522,7 +523,7 @@ bool enchantment::operator==( const enchantment &rhs ) const
            values_add == rhs.values_add &&
            hit_me_effect == rhs.hit_me_effect &&
            hit_you_effect == rhs.hit_you_effect &&
-           intermittent_activation == intermittent_activation &&
+           intermittent_activation == rhs.intermittent_activation &&
            active_conditions == rhs.active_conditions;
 }
 
@@ -109,6 +109,8 @@ class enchantment
 
         // this enchantment has a valid condition and is in the right location
         bool is_active( const Character &guy, const item &parent ) const;
+        // same as above, for a parent already known to be carried by guy
+        bool is_active_carried( const Character &guy, const item &parent ) const;
 
         // @active means the container for the enchantment is active, for comparison to active flag.
         bool is_active( const Character &guy, bool active ) const;
@@ -174,7 +174,7 @@ static bool in_spell_aoe( const tripoint &start, const tripoint &end, const int
     const std::vector<tripoint> trajectory = line_to( start, end );
     tripoint last_point = start;
     for( const tripoint &pt : trajectory ) {
-        if( ( here.impassable( pt ) && !here.has_flag( "THIN_OBSTACLE", pt ) ) ||
+        if( ( here.impassable( pt ) && !here.has_flag( TFLAG_THIN_OBSTACLE, pt ) ) ||
             here.obstructed_by_vehicle_rotation( pt, last_point ) ) {
             return false;
         }
@@ -216,7 +216,7 @@ static std::set<tripoint> spell_effect_cone_range_override( const tripoint &sour
         tripoint last_point = source;
         for( const tripoint &tp : trajectory ) {
             if( ignore_walls || ( !here.obstructed_by_vehicle_rotation( tp, last_point ) &&
-                                  ( here.passable( tp ) || here.has_flag( "THIN_OBSTACLE", tp ) ) ) ) {
+                                  ( here.passable( tp ) || here.has_flag( TFLAG_THIN_OBSTACLE, tp ) ) ) ) {
                 targets.emplace( tp );
             } else {
                 break;
@@ -245,7 +245,7 @@ static bool test_passable( const tripoint &p, const tripoint &prev )
 {
     map &here = get_map();
     return ( !here.obstructed_by_vehicle_rotation( prev, p ) && ( here.passable( p ) ||
-             here.has_flag( "THIN_OBSTACLE", p ) ) );
+             here.has_flag( TFLAG_THIN_OBSTACLE, p ) ) );
 }
 
 std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoint &source,
@@ -524,7 +524,7 @@ void spell_effect::projectile_attack( const spell &sp, Creature &caster,
     tripoint prev_point = caster.pos();
     map &here = get_map();
     for( std::vector<tripoint>::iterator iter = trajectory.begin(); iter != trajectory.end(); iter++ ) {
-        if( ( here.impassable( *iter ) && !here.has_flag( "THIN_OBSTACLE", *iter ) ) ||
+        if( ( here.impassable( *iter ) && !here.has_flag( TFLAG_THIN_OBSTACLE, *iter ) ) ||
             here.obstructed_by_vehicle_rotation( prev_point, *iter ) ) {
             if( iter != trajectory.begin() ) {
                 target_attack( sp, caster, *( iter - 1 ) );
@@ -613,7 +613,7 @@ int area_expander::run( const tripoint &center )
         for( size_t i = 0; i < 8; i++ ) {
             tripoint pt = best.position + point( x_offset[ i ], y_offset[ i ] );
 
-            if( ( here.impassable( pt ) && !here.has_flag( "THIN_OBSTACLE", pt ) ) ||
+            if( ( here.impassable( pt ) && !here.has_flag( TFLAG_THIN_OBSTACLE, pt ) ) ||
                 here.obstructed_by_vehicle_rotation( best.position, pt ) ) {
                 continue;
             }
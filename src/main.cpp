@@ -13,6 +13,7 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <filesystem>
@@ -32,6 +33,7 @@
 #include "game_ui.h"
 #include "init.h"
 #include "input.h"
+#include "input_recorder.h"
 #include "language.h"
 #include "loading_ui.h"
 #include "runtime_handlers.h"
@@ -42,6 +44,7 @@
 #include "output.h"
 #include "path_info.h"
 #include "rng.h"
+#include "startup_timings.h"
 #include "type_id.h"
 #include "ui_manager.h"
 #include "path_display.h"
@@ -206,6 +209,8 @@ int main( int argc, char *argv[] )
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string record_input_path;
+    std::string replay_input_path;
 
 #if defined(__ANDROID__)
     // Start the standard output logging redirector
@@ -241,7 +246,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 14> first_pass_arguments = {{
+        const std::array<arg_handler, 18> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -420,6 +425,28 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--skip-data-checks", nullptr,
+                    "If set, the loaded game data is not checked for errors",
+                    section_default,
+                    []( int, const char ** ) -> int {
+                        init::skip_consistency_checks = true;
+                        return 0;
+                    }
+                },
+                {
+                    "--startup-report", "<file>",
+                    "Writes how long each step of loading the game took to the file, as CSV",
+                    section_default,
+                    []( int num_args, const char **params ) -> int {
+                        if( num_args < 1 )
+                        {
+                            return -1;
+                        }
+                        startup_timings::enable( params[0] );
+                        return 1;
+                    }
+                },
                 {
                     "--lua-doc", nullptr,
                     "If set, will generate Lua docs and exit",
@@ -429,6 +456,32 @@ int main( int argc, char *argv[] )
                         lua_doc_mode = true;
                         return 0;
                     }
+                },
+                {
+                    "--record-input", "<file>",
+                    "Writes the random seed and every input to the file, to replay the session later",
+                    section_default,
+                    [&record_input_path]( int num_args, const char **params ) -> int {
+                        if( num_args < 1 )
+                        {
+                            return -1;
+                        }
+                        record_input_path = params[0];
+                        return 1;
+                    }
+                },
+                {
+                    "--replay-input", "<file>",
+                    "Plays a session written with --record-input back, from a copy of the same save",
+                    section_default,
+                    [&replay_input_path]( int num_args, const char **params ) -> int {
+                        if( num_args < 1 )
+                        {
+                            return -1;
+                        }
+                        replay_input_path = params[0];
+                        return 1;
+                    }
                 }
             }
         };
@@ -707,13 +760,25 @@ int main( int argc, char *argv[] )
     set_language();
 #endif
 
+    if( !replay_input_path.empty() ) {
+        // The replay needs the seed of the recorded session
+        if( std::optional<int> recorded_seed = input_recorder::start_replay( replay_input_path ) ) {
+            seed = *recorded_seed;
+        }
+    }
+    if( !record_input_path.empty() ) {
+        input_recorder::start_recording( record_input_path, seed );
+    }
     rng_set_engine_seed( seed );
 
     g = std::make_unique<game>();
     // First load and initialize everything that does not
     // depend on the mods.
     try {
-        g->load_static_data();
+        {
+            startup_timings::timer timing( "startup", "static data" );
+            g->load_static_data();
+        }
         if( verifyexit ) {
             exit_handler( 0 );
         }
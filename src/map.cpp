@@ -4,6 +4,7 @@
 #include <array>
 #include <cassert>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
@@ -12,6 +13,7 @@
 #include <queue>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "active_item_cache.h"
 #include "ammo.h"
@@ -86,6 +88,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
@@ -95,6 +98,7 @@
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
+#include "vehicle_turn_stats.h"
 #include "visitable.h"
 #include "vpart_position.h"
 #include "vpart_range.h"
@@ -186,10 +190,6 @@ map::map( int mapsize, bool zlev )
         grid.resize( static_cast<size_t>( my_MAPSIZE * my_MAPSIZE ), nullptr );
     }
 
-    for( auto &ptr : caches ) {
-        ptr = std::make_unique<level_cache>();
-    }
-
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
@@ -203,6 +203,8 @@ map &map::operator=( map && )  noexcept = default;
 
 void map::set_transparency_cache_dirty( const int zlev )
 {
+    // Opening a vehicle door only marks transparency dirty
+    clear_path_cache.clear();
     if( inbounds_z( zlev ) ) {
         get_cache( zlev ).transparency_cache_dirty.set();
     }
@@ -253,6 +255,7 @@ void map::set_seen_cache_dirty( const int zlevel )
 
 void map::set_transparency_cache_dirty( const tripoint &p )
 {
+    clear_path_cache.clear();
     if( inbounds( p ) ) {
         const tripoint smp = ms_to_sm_copy( p );
         get_cache( smp.z ).transparency_cache_dirty.set( smp.x * MAPSIZE + smp.y );
@@ -348,11 +351,12 @@ void map::add_vehicle_to_cache( vehicle *veh )
         ch.veh_in_active_range = true;
         ch.veh_cached_parts[p] = std::make_pair( veh,  static_cast<int>( vpr.part_index() ) );
         if( inbounds( p ) ) {
-            ch.veh_exists_at[p.x][p.y] = true;
+            ch.veh_exists_at.set( level_cache::veh_exists_index( p.xy() ) );
         }
     }
 
     last_full_vehicle_list_dirty = true;
+    clear_path_cache.clear();
 }
 
 void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
@@ -364,13 +368,13 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
 
     level_cache &ch = get_cache( pt.z );
     if( inbounds( pt ) ) {
-        ch.veh_exists_at[pt.x][pt.y] = false;
+        ch.veh_exists_at.reset( level_cache::veh_exists_index( pt.xy() ) );
     }
     auto it = ch.veh_cached_parts.find( pt );
     if( it != ch.veh_cached_parts.end() && it->second.first == veh ) {
         ch.veh_cached_parts.erase( it );
     }
-
+    clear_path_cache.clear();
 }
 
 void map::clear_vehicle_cache( )
@@ -379,16 +383,16 @@ void map::clear_vehicle_cache( )
     const int zmax = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int zlev = zmin; zlev <= zmax; zlev++ ) {
         level_cache &ch = get_cache( zlev );
-        while( !ch.veh_cached_parts.empty() ) {
-            const auto part = ch.veh_cached_parts.begin();
-            const auto &p = part->first;
+        for( const auto &part : ch.veh_cached_parts ) {
+            const tripoint &p = part.first;
             if( inbounds( p ) ) {
-                ch.veh_exists_at[p.x][p.y] = false;
+                ch.veh_exists_at.reset( level_cache::veh_exists_index( p.xy() ) );
             }
-            ch.veh_cached_parts.erase( part );
         }
+        ch.veh_cached_parts.clear();
         ch.veh_in_active_range = false;
     }
+    clear_path_cache.clear();
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -446,6 +450,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             reset_vehicle_cache( );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_modified();
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
@@ -473,12 +478,12 @@ void map::on_vehicle_moved( const int smz )
     set_transparency_cache_dirty( smz );
     set_floor_cache_dirty( smz );
     set_floor_cache_dirty( smz + 1 );
-    set_pathfinding_cache_dirty( smz );
 }
 
 void map::vehmove()
 {
     ZoneScoped;
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::move );
 
     // give vehicles movement points
     VehicleList vehicle_list;
@@ -528,6 +533,7 @@ void map::vehmove()
 
 bool map::vehproceed( VehicleList &vehicle_list )
 {
+    ZoneScoped;
     wrapped_vehicle *cur_veh = nullptr;
     float max_of_turn = 0;
     // First horizontal movement
@@ -564,13 +570,7 @@ bool map::vehproceed( VehicleList &vehicle_list )
         level_cache &cache = get_cache( zlev );
 
         // Check if any vehicles exist in the active range for this z-level
-        cache.veh_in_active_range = cache.veh_in_active_range &&
-                                    std::any_of( std::begin( cache.veh_exists_at ),
-        std::end( cache.veh_exists_at ), []( const auto & row ) {
-            return std::any_of( std::begin( row ), std::end( row ), []( bool veh_exists ) {
-                return veh_exists;
-            } );
-        } );
+        cache.veh_in_active_range = cache.veh_in_active_range && cache.veh_exists_at.any();
     }
 
     return true;
@@ -791,7 +791,7 @@ vehicle *map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &fac
             }
 
             veh.handle_trap( wheel_p, w );
-            if( !has_flag( "SEALED", wheel_p ) ) {
+            if( !has_flag( TFLAG_SEALED, wheel_p ) ) {
                 const float wheel_area =  veh.part( w ).wheel_area();
 
                 // Damage is calculated based on the weight of the vehicle,
@@ -1097,7 +1097,7 @@ const vehicle *map::veh_at_internal( const tripoint &p, int &part_num ) const
 {
     // This function is called A LOT. Move as much out of here as possible.
     const level_cache &ch = get_cache( p.z );
-    if( !ch.veh_in_active_range || !ch.veh_exists_at[p.x][p.y] ) {
+    if( !ch.veh_in_active_range || !ch.veh_exists_at.test( level_cache::veh_exists_index( p.xy() ) ) ) {
         part_num = -1;
         return nullptr; // Clear cache indicates no vehicle. This should optimize a great deal.
     }
@@ -1190,6 +1190,7 @@ void map::unboard_vehicle( const tripoint &p, bool dead_passenger )
 
 bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
 {
+    ZoneScoped;
     const tripoint src = veh.global_pos3();
 
     tripoint dst = src + dp;
@@ -1297,12 +1298,18 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
     }
 
     veh.shed_loose_parts();
+    // Tiles the vehicle leaves, those it enters are marked below
+    for( int i = 0; i < veh.part_count(); i++ ) {
+        set_pathfinding_cache_dirty( veh.global_part_pos3( i ) );
+    }
     smzs = veh.advance_precalc_mounts( dst_offset, src );
     if( src_submap != dst_submap ) {
         veh.set_submap_moved( tripoint( dst.x / SEEX, dst.y / SEEY, dst.z ) );
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_modified();
+        dst_submap->mark_modified();
         dst_submap->is_uniform = false;
         invalidate_max_populated_zlev( dst.z );
     }
@@ -1345,13 +1352,24 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
     for( int vsmz : smzs ) {
         on_vehicle_moved( dst.z + vsmz );
     }
+    if( need_update || z_change || src.z != dst.z ) {
+        // Shifted map or other z-levels, not worth tracking tile by tile
+        for( int vsmz : smzs ) {
+            set_pathfinding_cache_dirty( dst.z + vsmz );
+        }
+        set_pathfinding_cache_dirty( src.z );
+    } else {
+        for( int i = 0; i < veh.part_count(); i++ ) {
+            set_pathfinding_cache_dirty( veh.global_part_pos3( i ) );
+        }
+    }
     return true;
 }
 
 bool map::displace_water( const tripoint &p )
 {
     // Check for shallow water
-    if( has_flag( "SWIMMABLE", p ) && !has_flag( TFLAG_DEEP_WATER, p ) ) {
+    if( has_flag( TFLAG_SWIMMABLE, p ) && !has_flag( TFLAG_DEEP_WATER, p ) ) {
         int dis_places = 0;
         int sel_place = 0;
         for( int pass = 0; pass < 2; pass++ ) {
@@ -1488,7 +1506,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1770,7 +1788,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -1802,12 +1820,12 @@ std::string map::features( const tripoint &p )
     // to take up one line.  So, make sure it does that.
     // FIXME: can't control length of localized text.
     add_if( is_bashable( p ), _( "Smashable." ) );
-    add_if( has_flag( "DIGGABLE", p ), _( "Diggable." ) );
+    add_if( has_flag( TFLAG_DIGGABLE, p ), _( "Diggable." ) );
     add_if( has_flag( "PLOWABLE", p ), _( "Plowable." ) );
-    add_if( has_flag( "ROUGH", p ), _( "Rough." ) );
-    add_if( has_flag( "UNSTABLE", p ), _( "Unstable." ) );
-    add_if( has_flag( "SHARP", p ), _( "Sharp." ) );
-    add_if( has_flag( "FLAT", p ), _( "Flat." ) );
+    add_if( has_flag( TFLAG_ROUGH, p ), _( "Rough." ) );
+    add_if( has_flag( TFLAG_UNSTABLE, p ), _( "Unstable." ) );
+    add_if( has_flag( TFLAG_SHARP, p ), _( "Sharp." ) );
+    add_if( has_flag( TFLAG_FLAT, p ), _( "Flat." ) );
     add_if( has_flag( "ROOF", p ), _( "Roof." ) );
     add_if( has_flag( "EASY_DECONSTRUCT", p ), _( "Simple." ) );
     add_if( has_flag( "MOUNTABLE", p ), _( "Mountable." ) );
@@ -2069,7 +2087,7 @@ int map::climb_difficulty( const tripoint &p ) const
             best_difficulty = std::min( best_difficulty, 7 );
         }
 
-        if( best_difficulty > 5 && has_flag( "CLIMBABLE", pt ) ) {
+        if( best_difficulty > 5 && has_flag( TFLAG_CLIMBABLE, pt ) ) {
             best_difficulty = 5;
         }
     }
@@ -2136,7 +2154,7 @@ bool map::has_floor_or_support( const tripoint &p ) const
 void map::drop_everything( const tripoint &p )
 {
     //Do a suspension check so that there won't be a floor there for the rest of this check.
-    if( has_flag( "SUSPENDED", p ) ) {
+    if( has_flag( TFLAG_SUSPENDED, p ) ) {
         collapse_invalid_suspension( p );
     }
     if( has_floor( p ) ) {
@@ -2394,7 +2412,7 @@ bool map::can_put_items( const tripoint &p ) const
 
 bool map::can_put_items_ter_furn( const tripoint &p ) const
 {
-    return !has_flag( "NOITEM", p ) && !has_flag( "SEALED", p );
+    return !has_flag( TFLAG_NOITEM, p ) && !has_flag( TFLAG_SEALED, p );
 }
 
 bool map::has_flag_ter( const std::string &flag, const tripoint &p ) const
@@ -2621,12 +2639,12 @@ void map::make_rubble( const tripoint &p, const furn_id &rubble_type,
 
 bool map::is_water_shallow_current( const tripoint &p ) const
 {
-    return has_flag( "CURRENT", p ) && !has_flag( TFLAG_DEEP_WATER, p );
+    return has_flag( TFLAG_CURRENT, p ) && !has_flag( TFLAG_DEEP_WATER, p );
 }
 
 bool map::is_divable( const tripoint &p ) const
 {
-    return has_flag( "SWIMMABLE", p ) && has_flag( TFLAG_DEEP_WATER, p );
+    return has_flag( TFLAG_SWIMMABLE, p ) && has_flag( TFLAG_DEEP_WATER, p );
 }
 
 bool map::is_outside( const tripoint &p ) const
@@ -2669,9 +2687,9 @@ bool map::is_last_ter_wall( const bool no_furn, point p,
         if( no_furn && has_furn( p2 ) ) {
             loop = false;
             result = false;
-        } else if( !has_flag_ter( "FLAT", p2 ) ) {
+        } else if( !has_flag_ter( TFLAG_FLAT, p2 ) ) {
             loop = false;
-            if( !has_flag_ter( "WALL", p2 ) ) {
+            if( !has_flag_ter( TFLAG_WALL, p2 ) ) {
                 result = false;
             }
         }
@@ -2714,11 +2732,11 @@ bool map::is_flammable( const tripoint &p )
         return true;
     }
 
-    if( has_flag( "FLAMMABLE", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE, p ) ) {
         return true;
     }
 
-    if( has_flag( "FLAMMABLE_ASH", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE_ASH, p ) ) {
         return true;
     }
 
@@ -2864,7 +2882,7 @@ bool map::mop_spills( const tripoint &p )
 {
     bool retval = false;
 
-    if( !has_flag( "LIQUIDCONT", p ) && !has_flag( "SEALED", p ) ) {
+    if( !has_flag( "LIQUIDCONT", p ) && !has_flag( TFLAG_SEALED, p ) ) {
         auto items = i_at( p );
 
         items.remove_top_items_with( [&retval]( detached_ptr<item> &&e ) {
@@ -2923,21 +2941,19 @@ int map::collapse_check( const tripoint &p )
 
     int num_supports = p.z == -OVERMAP_DEPTH ? 0 : -5;
     // if there's support below, things are less likely to collapse
+    // Only the tile right below is looked at, once for each tile around it
     if( p.z > -OVERMAP_DEPTH ) {
-        const tripoint &pbelow = tripoint( p.xy(), p.z - 1 );
-        for( const tripoint &tbelow : points_in_radius( pbelow, 1 ) ) {
-            if( has_flag( TFLAG_SUPPORTS_ROOF, pbelow ) ) {
-                num_supports += 1;
-                if( has_flag( TFLAG_WALL, pbelow ) ) {
-                    num_supports += 2;
-                }
-                if( tbelow == pbelow ) {
-                    num_supports += 2;
-                }
-            }
+        const tripoint pbelow( p.xy(), p.z - 1 );
+        if( has_flag( TFLAG_SUPPORTS_ROOF, pbelow ) ) {
+            const int around = points_in_radius( pbelow, 1 ).size();
+            num_supports += around * ( has_flag( TFLAG_WALL, pbelow ) ? 3 : 1 ) + 2;
         }
     }
 
+    if( !collapses && !supports_roof ) {
+        return 1.7 * num_supports;
+    }
+
     for( const tripoint &t : points_in_radius( p, 1 ) ) {
         if( p == t ) {
             continue;
@@ -3267,7 +3283,7 @@ bash_results map::bash_ter_success( const tripoint &p, const bash_params &params
     result.success = true;
     const ter_t &ter_before = ter( p ).obj();
     const map_bash_info &bash = ter_before.bash;
-    if( has_flag_ter( "FUNGUS", p ) ) {
+    if( has_flag_ter( TFLAG_FUNGUS, p ) ) {
         fungal_effects( *g, *this ).create_spores( p );
     }
     const std::string soundfxvariant = ter_before.id.str();
@@ -3398,7 +3414,7 @@ bash_results map::bash_furn_success( const tripoint &p, const bash_params &param
     const map_bash_info &bash = furnid.bash;
 
 
-    if( has_flag_furn( "FUNGUS", p ) ) {
+    if( has_flag_furn( TFLAG_FUNGUS, p ) ) {
         fungal_effects( *g, *this ).create_spores( p );
     }
     if( has_flag_furn( "MIGO_NERVE", p ) ) {
@@ -3628,7 +3644,7 @@ bash_results map::bash( const tripoint &p, const int str,
     }
 
     bool bashed_sealed = false;
-    if( has_flag( "SEALED", p ) ) {
+    if( has_flag( TFLAG_SEALED, p ) ) {
         result |= bash_ter_furn( p, bsh );
         bashed_sealed = true;
     }
@@ -4011,7 +4027,7 @@ bool map::hit_with_fire( const tripoint &p )
     }
 
     // non passable but flammable terrain, set it on fire
-    if( has_flag( "FLAMMABLE", p ) || has_flag( "FLAMMABLE_ASH", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE, p ) || has_flag( TFLAG_FLAMMABLE_ASH, p ) ) {
         add_field( p, fd_fire, 3 );
     }
     return true;
@@ -4100,11 +4116,13 @@ void map::translate( const ter_id &from, const ter_id &to )
                   from.obj().name() );
         return;
     }
-    for( const tripoint &p : points_on_zlevel() ) {
-        if( ter( p ) == from ) {
+    const tripoint map_max( SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, abs_sub.z );
+    for_each_tile( tripoint( 0, 0, abs_sub.z ), map_max,
+    [&]( const submap & sm, point l, const tripoint & p ) {
+        if( sm.get_ter( l ) == from ) {
             ter_set( p, to );
         }
-    }
+    } );
 }
 
 //This function performs the translate function within a given radius of the player.
@@ -4117,20 +4135,20 @@ void map::translate_radius( const ter_id &from, const ter_id &to, float radi, co
     }
 
     const tripoint abs_omt_p = ms_to_omt_copy( getabs( p ) );
-    for( const tripoint &t : points_on_zlevel() ) {
-        const tripoint abs_omt_t = ms_to_omt_copy( getabs( t ) );
-        const float radiX = trig_dist( p, t );
-        if( ter( t ) == from ) {
-            // within distance, and either no submap limitation or same overmap coords.
-            if( radiX <= radi && ( !same_submap || abs_omt_t == abs_omt_p ) ) {
-                ter_set( t, to );
-            }
-        } else if( toggle_between && ter( t ) == to ) {
-            if( radiX <= radi && ( !same_submap || abs_omt_t == abs_omt_p ) ) {
-                ter_set( t, from );
-            }
+    const tripoint map_max( SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, abs_sub.z );
+    for_each_tile( tripoint( 0, 0, abs_sub.z ), map_max,
+    [&]( const submap & sm, point l, const tripoint & t ) {
+        const ter_id here = sm.get_ter( l );
+        if( here != from && ( !toggle_between || here != to ) ) {
+            return;
         }
-    }
+        // within distance, and either no submap limitation or same overmap coords.
+        if( trig_dist( p, t ) > radi ||
+            ( same_submap && ms_to_omt_copy( getabs( t ) ) != abs_omt_p ) ) {
+            return;
+        }
+        ter_set( t, here == from ? to : from );
+    } );
 }
 
 bool map::close_door( const tripoint &p, const bool inside, const bool check_only )
@@ -4322,8 +4340,8 @@ detached_ptr<item> map::spawn_an_item( const tripoint &p, detached_ptr<item> &&n
         new_item->charges = charges;
     }
     detached_ptr<item> spawned_item = item::in_its_container( std::move( new_item ) );
-    if( ( spawned_item->made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) ||
-        has_flag( "DESTROY_ITEM", p ) ) {
+    if( ( spawned_item->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, p ) ) ||
+        has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return detached_ptr<item>();
     }
 
@@ -4336,10 +4354,10 @@ std::vector<detached_ptr<item>> map::spawn_items( const tripoint &p,
                              std::vector<detached_ptr<item>> new_items )
 {
     std::vector<detached_ptr<item>> ret;
-    if( !inbounds( p ) || has_flag( "DESTROY_ITEM", p ) ) {
+    if( !inbounds( p ) || has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return ret;
     }
-    const bool swimmable = has_flag( "SWIMMABLE", p );
+    const bool swimmable = has_flag( TFLAG_SWIMMABLE, p );
     for( detached_ptr<item> &new_item : new_items ) {
         if( new_item->made_of( LIQUID ) && swimmable ) {
             continue;
@@ -4421,12 +4439,12 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
         }
 
         // Some tiles destroy items (e.g. lava)
-        if( has_flag( "DESTROY_ITEM", e ) ) {
+        if( has_flag( TFLAG_DESTROY_ITEM, e ) ) {
             return false;
         }
 
         // Cannot drop liquids into tiles that are comprised of liquid
-        if( obj->made_of( LIQUID ) && has_flag( "SWIMMABLE", e ) ) {
+        if( obj->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, e ) ) {
             return false;
         }
 
@@ -4463,7 +4481,7 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
         return std::move( obj );
     }
 
-    if( ( !has_flag( "NOITEM", pos ) || ( has_flag( "LIQUIDCONT", pos ) && obj->made_of( LIQUID ) ) )
+    if( ( !has_flag( TFLAG_NOITEM, pos ) || ( has_flag( "LIQUIDCONT", pos ) && obj->made_of( LIQUID ) ) )
         && valid_limits( pos ) ) {
         // Pass map into on_drop, because this map may not be the global map object (in mapgen, for instance).
         if( obj->made_of( LIQUID ) || !obj->has_flag( flag_DROP_ACTION_ONLY_IF_LIQUID ) ) {
@@ -4499,7 +4517,7 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
             }
 
             if( !valid_tile( e ) || !valid_limits( e ) ||
-                has_flag( "NOITEM", e ) || has_flag( "SEALED", e ) ) {
+                has_flag( TFLAG_NOITEM, e ) || has_flag( TFLAG_SEALED, e ) ) {
                 continue;
             }
             place_item( e );
@@ -4528,11 +4546,11 @@ void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
         }
     }
 
-    if( new_item->made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) {
+    if( new_item->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, p ) ) {
         return;
     }
 
-    if( has_flag( "DESTROY_ITEM", p ) ) {
+    if( has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return;
     }
 
@@ -4774,6 +4792,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    ZoneScoped;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -4791,6 +4810,13 @@ void map::process_items()
     }
     // Making a copy, in case the original variable gets modified during `process_items_in_submap`
     const std::set<tripoint> submaps_with_active_items_copy = submaps_with_active_items;
+#if defined(USE_TRACY)
+    std::size_t active_item_count = 0;
+    for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
+        active_item_count += get_submap_at_grid( abs_pos - abs_sub.xy() )->active_items.size();
+    }
+    TracyPlot( "Active items", static_cast<int64_t>( active_item_count ) );
+#endif
     for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
         const tripoint local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
@@ -4815,12 +4841,31 @@ static temperature_flag temperature_flag_at_point( const map &m, const tripoint
     return temperature_flag::TEMP_NORMAL;
 }
 
+// Same as above, for a tile that's known to be on @p sm
+static temperature_flag temperature_flag_at_tile( const submap &sm, point l )
+{
+    if( sm.get_ter( l ) == t_rootcellar ) {
+        return temperature_flag::TEMP_ROOT_CELLAR;
+    }
+    const furn_t &furn = sm.get_furn( l ).obj();
+    if( furn.has_flag( TFLAG_FRIDGE ) ) {
+        return temperature_flag::TEMP_FRIDGE;
+    }
+    if( furn.has_flag( TFLAG_FREEZER ) ) {
+        return temperature_flag::TEMP_FREEZER;
+    }
+
+    return temperature_flag::TEMP_NORMAL;
+}
+
 void map::process_items_in_submap( submap &current_submap, const tripoint &gridp )
 {
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
     std::vector<item *> active_items = current_submap.active_items.get_for_processing();
+    ZoneScoped;
+    ZoneValue( active_items.size() );
     const point grid_offset( gridp.x * SEEX, gridp.y * SEEY );
     for( item *&active_item_ref : active_items ) {
         if( !active_item_ref || !active_item_ref->is_loaded() ) {
@@ -4829,13 +4874,19 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
         }
 
         const tripoint map_location = active_item_ref->position();
-        temperature_flag flag = temperature_flag_at_point( *this, map_location );
+        // Nearly all of them are on this submap, no need to look it up again for those
+        const point l = map_location.xy() - grid_offset;
+        const bool on_submap = map_location.z == gridp.z && l.x >= 0 && l.x < SEEX &&
+                               l.y >= 0 && l.y < SEEY;
+        const temperature_flag flag = on_submap ? temperature_flag_at_tile( current_submap, l ) :
+                                      temperature_flag_at_point( *this, map_location );
         process_map_items( active_item_ref, map_location, flag );
     }
 }
 
 void map::process_items_in_vehicles( submap &current_submap )
 {
+    ZoneScoped;
     // a copy, important if the vehicle list changes because a
     // vehicle got destroyed by a bomb (an active item!), this list
     // won't change, but veh_in_nonant will change.
@@ -4856,13 +4907,27 @@ void map::process_items_in_vehicles( submap &current_submap )
     }
 }
 
+// Whether any cargo part could wash or recharge the items in it, the only things
+// process_vehicle_items does to items that aren't active
+static bool has_cargo_machines( const vehicle &cur_veh )
+{
+    return !cur_veh.parts_with_type_feature( VPFLAG_WASHING_MACHINE ).empty() ||
+           !cur_veh.parts_with_type_feature( VPFLAG_DISHWASHER ).empty() ||
+           !cur_veh.parts_with_type_feature( VPFLAG_RECHARGE ).empty();
+}
+
 void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
 {
-    const bool engine_heater_is_on = cur_veh.has_part( "E_HEATER", true ) && cur_veh.engine_on;
+    const bool engine_heater_is_on = cur_veh.engine_on && cur_veh.has_part( "E_HEATER", true );
     for( const vpart_reference &vp : cur_veh.get_any_parts( VPFLAG_FLUIDTANK ) ) {
         vp.part().process_contents( vp.pos(), engine_heater_is_on );
     }
 
+    if( cur_veh.active_items.empty() && !has_cargo_machines( cur_veh ) ) {
+        // Nothing in the cargo can change, so don't look through it
+        return;
+    }
+
     auto cargo_parts = cur_veh.get_parts_including_carried( VPFLAG_CARGO );
     for( const vpart_reference &vp : cargo_parts ) {
         process_vehicle_items( cur_veh, vp.part_index() );
@@ -5378,6 +5443,7 @@ void map::partial_con_remove( const tripoint &p )
     point l;
     submap *const current_submap = get_submap_at( p, l );
     current_submap->partial_constructions.erase( tripoint( l, p.z ) );
+    current_submap->mark_modified();
 }
 
 void map::partial_con_set( const tripoint &p, std::unique_ptr<partial_con> con )
@@ -5387,6 +5453,7 @@ void map::partial_con_set( const tripoint &p, std::unique_ptr<partial_con> con )
     }
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    current_submap->mark_modified();
     if( !current_submap->partial_constructions.emplace( tripoint( l, p.z ),
             std::move( con ) ).second ) {
         debugmsg( "set partial con on top of terrain which already has a partial con" );
@@ -5642,6 +5709,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     current_submap->is_uniform = false;
     invalidate_max_populated_zlev( p.z );
 
+    current_submap->mark_field_tile( l );
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -5665,7 +5733,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5697,7 +5765,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -6339,16 +6407,63 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
     // Cannonicalize the order of the tripoints so the cache is reflexive.
     const tripoint &min = F < T ? F : T;
     const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
-    char cached = skew_vision_cache.get( key, -1 );
-    if( cached >= 0 ) {
-        return cached > 0;
+    const std::optional<std::uint64_t> key = line_memo::key( min, max );
+    if( key ) {
+        const int cached = skew_vision_cache.get( *key );
+        if( cached >= 0 ) {
+            return cached > 0;
+        }
+    }
+
+    const bool visible = sight_line_clear( F, T, bresenham_slope );
+    if( key ) {
+        skew_vision_cache.insert( *key, visible );
     }
+    return visible;
+}
+
+void map::sees_batch( const std::vector<std::pair<tripoint, tripoint>> &lines ) const
+{
+    ZoneScoped;
+
+    std::vector<std::uint64_t> keys;
+    std::unordered_set<std::uint64_t> seen_keys;
+    std::vector<const std::pair<tripoint, tripoint> *> unknown;
+    int minz = OVERMAP_HEIGHT;
+    int maxz = -OVERMAP_DEPTH;
+    for( const std::pair<tripoint, tripoint> &line : lines ) {
+        const tripoint &F = line.first;
+        const tripoint &T = line.second;
+        if( F.z != T.z || !inbounds( F ) || !inbounds( T ) ) {
+            continue;
+        }
+        const std::optional<std::uint64_t> key = line_memo::key( F < T ? F : T, !( F < T ) ? F : T );
+        if( !key || skew_vision_cache.get( *key ) >= 0 || !seen_keys.insert( *key ).second ) {
+            continue;
+        }
+        keys.push_back( *key );
+        unknown.push_back( &line );
+        minz = std::min( minz, F.z );
+        maxz = std::max( maxz, F.z );
+    }
+    if( unknown.empty() ) {
+        return;
+    }
+    allocate_caches( minz, maxz );
+
+    std::vector<char> visible( unknown.size() );
+    get_thread_pool().parallel_for( 0, static_cast<int>( unknown.size() ), [&]( int i ) {
+        int slope = 0;
+        visible[i] = sight_line_clear( unknown[i]->first, unknown[i]->second, slope );
+    } );
+    // In order of the lines, so what gets remembered doesn't depend on how the work was split
+    for( size_t i = 0; i < unknown.size(); i++ ) {
+        skew_vision_cache.insert( keys[i], visible[i] != 0 );
+    }
+}
 
+bool map::sight_line_clear( const tripoint &F, const tripoint &T, int &bresenham_slope ) const
+{
     bool visible = true;
 
     // Ugly `if` for now
@@ -6369,7 +6484,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
         return visible;
     }
 
@@ -6402,7 +6516,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
     return visible;
 }
 
@@ -6592,11 +6705,29 @@ bool map::clear_path( const tripoint &f, const tripoint &t, const int range,
         return false;
     }
 
-    if( f.z == t.z ) {
-        if( ( range >= 0 && range < rl_dist( f.xy(), t.xy() ) ) ||
-            !inbounds( t ) ) {
-            return false; // Out of range!
+    if( ( range >= 0 && range < rl_dist( f, t ) ) ||
+        !inbounds( t ) ) {
+        return false; // Out of range!
+    }
+
+    const std::optional<std::uint64_t> key = line_memo::key( f, t, cost_min, cost_max );
+    if( key ) {
+        const int cached = clear_path_cache.get( *key );
+        if( cached >= 0 ) {
+            return cached > 0;
         }
+    }
+    const bool is_clear = trace_clear_path( f, t, cost_min, cost_max );
+    if( key ) {
+        clear_path_cache.insert( *key, is_clear );
+    }
+    return is_clear;
+}
+
+bool map::trace_clear_path( const tripoint &f, const tripoint &t, const int cost_min,
+                            const int cost_max ) const
+{
+    if( f.z == t.z ) {
         bool is_clear = true;
         point last_point = f.xy();
         bresenham( f.xy(), t.xy(), 0,
@@ -6620,10 +6751,6 @@ bool map::clear_path( const tripoint &f, const tripoint &t, const int range,
         return is_clear;
     }
 
-    if( ( range >= 0 && range < rl_dist( f, t ) ) ||
-        !inbounds( t ) ) {
-        return false; // Out of range!
-    }
     bool is_clear = true;
     tripoint last_point = f;
     bresenham( f, t, 0, 0,
@@ -6747,7 +6874,7 @@ bool map::obscured_by_vehicle_rotation( const tripoint &from, const tripoint &to
 
 bool map::accessible_items( const tripoint &t ) const
 {
-    return !has_flag( "SEALED", t ) || has_flag( "LIQUIDCONT", t );
+    return !has_flag( TFLAG_SEALED, t ) || has_flag( "LIQUIDCONT", t );
 }
 
 std::vector<tripoint> map::get_dir_circle( const tripoint &f, const tripoint &t ) const
@@ -6786,6 +6913,7 @@ std::vector<tripoint> map::get_dir_circle( const tripoint &f, const tripoint &t
 
 void map::save()
 {
+    ZoneScoped;
     for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
         for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
             if( zlevels ) {
@@ -6801,6 +6929,7 @@ void map::save()
 
 void map::load( const tripoint &w, const bool update_vehicle, const bool pump_events )
 {
+    ZoneScoped;
     for( auto &traps : traplocs ) {
         traps.clear();
     }
@@ -6883,6 +7012,91 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, point s );
 
+// Moves the values of a per-tile cache by whole submaps, as map::shift moves the submaps.
+// The tiles of the submaps shifted in keep whatever they had, they have to be rebuilt.
+template<typename T>
+static void shift_tile_cache( T ( &cache )[MAPSIZE_X][MAPSIZE_Y], point s )
+{
+    static_assert( std::is_trivially_copyable_v<T> );
+    const int dx = s.x * SEEX;
+    const int dy = s.y * SEEY;
+    const int width = MAPSIZE_X - std::abs( dx );
+    const size_t column_bytes = ( MAPSIZE_Y - std::abs( dy ) ) * sizeof( T );
+    // Columns are contiguous, each moves in one go, in the order that reads a column before
+    // it's overwritten
+    const auto move_column = [&]( int x ) {
+        std::memmove( &cache[x][std::max( -dy, 0 )], &cache[x + dx][std::max( dy, 0 )],
+                      column_bytes );
+    };
+    if( dx >= 0 ) {
+        for( int x = 0; x < width; x++ ) {
+            move_column( x );
+        }
+    } else {
+        for( int x = MAPSIZE_X - 1; x >= MAPSIZE_X - width; x-- ) {
+            move_column( x );
+        }
+    }
+}
+
+// The submaps map::shift loads at one edge and the tiles that end up at the opposite edge,
+// where nothing is next to them anymore
+static std::bitset<MAPSIZE_X *MAPSIZE_Y> shifted_in_tiles( point s )
+{
+    const auto shifted_in = []( int v, int shift, int size, int sm_size ) {
+        return shift > 0 ? v >= size - sm_size || v == 0 :
+               shift < 0 ? v < sm_size || v == size - 1 : false;
+    };
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> ret;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( shifted_in( x, s.x, MAPSIZE_X, SEEX ) || shifted_in( y, s.y, MAPSIZE_Y, SEEY ) ) {
+                ret.set( level_cache::veh_exists_index( point( x, y ) ) );
+            }
+        }
+    }
+    return ret;
+}
+
+void map::shift_level_caches( const int zlev, point s,
+                              const std::bitset<MAPSIZE_X *MAPSIZE_Y> &shifted_in )
+{
+    level_cache &ch = get_cache( zlev );
+    // Indexed by smx * MAPSIZE + smy, the other way around from the field cache
+    const point transposed( s.y, s.x );
+
+    shift_tile_cache( ch.transparency_cache, s );
+    shift_bitset_cache<MAPSIZE, 1>( ch.transparency_cache_dirty, transposed );
+    // The tiles at the opposite edge lose their neighbours, which can make them outside.
+    // The submaps next to the loaded ones are marked in loadn.
+    for( int i = 0; i < my_MAPSIZE; i++ ) {
+        if( s.x != 0 ) {
+            ch.transparency_cache_dirty.set( ( s.x > 0 ? 0 : my_MAPSIZE - 1 ) * MAPSIZE + i );
+        }
+        if( s.y != 0 ) {
+            ch.transparency_cache_dirty.set( i * MAPSIZE + ( s.y > 0 ? 0 : my_MAPSIZE - 1 ) );
+        }
+    }
+
+    shift_tile_cache( ch.sunlight_cache, s );
+    shift_tile_cache( ch.sunlight_transparency, s );
+    shift_tile_cache( ch.sunlight_floor, s );
+    shift_tile_cache( ch.sunlight_outside, s );
+    shift_bitset_cache<MAPSIZE_X, SEEX>( ch.sunlit, s );
+    ch.sunlight_stale |= shifted_in;
+
+    pathfinding_cache &pf = get_pathfinding_cache( zlev );
+    if( !pf.dirty ) {
+        shift_tile_cache( pf.special, s );
+        shift_tile_cache( pf.area, s );
+        shift_bitset_cache<MAPSIZE, 1>( pf.dirty_submaps, transposed );
+        // Remembered routes are in local coordinates, this makes them all out of date
+        pf.generation++;
+        pf.submap_generation.fill( pf.generation );
+        pf.route_fields.clear();
+    }
+}
+
 static inline void shift_tripoint_set( std::set<tripoint> &set, point offset,
                                        const half_open_rectangle<point> &boundaries )
 {
@@ -6940,6 +7154,8 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
     auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
     dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
     src_submap->vehicles.erase( src_submap_veh_it );
+    src_submap->mark_modified();
+    dst_submap->mark_modified();
     dst_submap->is_uniform = false;
     invalidate_max_populated_zlev( dst.z );
 
@@ -6996,6 +7212,8 @@ void map::shift( point sp )
 
     // Clear vehicle list and rebuild after shift
     clear_vehicle_cache( );
+    const std::bitset<MAPSIZE_X *MAPSIZE_Y> shifted_in = shifted_in_tiles( sp );
+    lightmap_valid = false;
     // Shift the map sx submaps to the right and sy submaps down.
     // sx and sy should never be bigger than +/-1.
     // absx and absy are our position in the world, for saving/loading purposes.
@@ -7003,6 +7221,7 @@ void map::shift( point sp )
         clear_vehicle_list( gridz );
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
+        shift_level_caches( gridz, sp, shifted_in );
         if( sp.x >= 0 ) {
             for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
                 if( sp.y >= 0 ) {
@@ -7159,6 +7378,11 @@ void map::saven( const tripoint &grid )
         }
     }
 
+    // Only last_touched changes for otherwise untouched submaps. Leaving the old value on disk
+    // is fine, the next actualize just catches up over a slightly longer period.
+    if( submap_to_save->has_live_contents() ) {
+        submap_to_save->mark_modified();
+    }
     submap_to_save->last_touched = calendar::turn;
     MAPBUFFER.add_submap( abs, submap_to_save );
 }
@@ -7182,12 +7406,130 @@ static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
     }
 }
 
-void map::loadn( const tripoint &grid, const bool update_vehicles )
+// Whether the quad containing @p grid_abs_sub can be made by generate_uniform
+static bool is_uniform_quad( const tripoint &grid_abs_sub )
 {
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
+    // TODO: fix point types
+    const oter_id terrain_type = overmap_buffer.ter( tripoint_abs_omt( sm_to_omt_copy(
+                                     grid_abs_sub ) ) );
+    return terrain_type == air || terrain_type == rock;
+}
+
+// Generate the quad containing @p grid_abs_sub and store it in the mapbuffer
+static void generate_quad( const tripoint &grid_abs_sub )
+{
+    // Cache empty overmap types
+    static const oter_id rock( "empty_rock" );
+    static const oter_id air( "open_air" );
+
+    // Each overmap square is two nonants; to prevent overlap, generate only at
+    //  squares divisible by 2.
+    // TODO: fix point types
+    const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
+    const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
+
+    const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
+
+    // Short-circuit if the map tile is uniform
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == air ) {
+        generate_uniform( grid_abs_sub_rounded, t_open_air );
+    } else if( terrain_type == rock ) {
+        generate_uniform( grid_abs_sub_rounded, t_rock );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
+    }
+}
+
+void map::prefetch_submaps_ahead( const vehicle &veh )
+{
+    // Slower vehicles don't cross submap borders often enough for loading to matter
+    static constexpr int min_velocity = 1000;
+    // Full mapgen is expensive, don't make a single turn take that much longer
+    static constexpr int max_mapgen_per_turn = 1;
+
+    if( std::abs( veh.velocity ) < min_velocity ) {
+        return;
+    }
+    const units::angle dir = veh.velocity > 0 ? veh.move.dir() : veh.move.dir() + 180_degrees;
+    // Anything within 22.5 degrees of an axis counts as going straight along it
+    static constexpr double axis_threshold = 0.38;
+    const double dir_x = units::cos( dir );
+    const double dir_y = units::sin( dir );
+    const point ahead( dir_x > axis_threshold ? 1 : dir_x < -axis_threshold ? -1 : 0,
+                       dir_y > axis_threshold ? 1 : dir_y < -axis_threshold ? -1 : 0 );
+    prefetch_submaps_ahead( ahead, max_mapgen_per_turn );
+}
+
+void map::prefetch_submaps_ahead( const tripoint &pos )
+{
+    // The map shifts once the position leaves the center submap, start on the submaps
+    // beyond the edge it is closest to once it's in the outer quarter of it
+    static constexpr int margin_x = SEEX / 4;
+    static constexpr int margin_y = SEEY / 4;
+    // Walking gives a dozen turns or more between shifts, one quad a turn keeps up with it
+    static constexpr int max_mapgen_per_turn = 1;
+
+    const point ahead( pos.x >= HALF_MAPSIZE_X + SEEX - margin_x ? 1 :
+                       pos.x < HALF_MAPSIZE_X + margin_x ? -1 : 0,
+                       pos.y >= HALF_MAPSIZE_Y + SEEY - margin_y ? 1 :
+                       pos.y < HALF_MAPSIZE_Y + margin_y ? -1 : 0 );
+    if( ahead == point_zero ) {
+        return;
+    }
+    prefetch_submaps_ahead( ahead, max_mapgen_per_turn );
+}
+
+void map::prefetch_submaps_ahead( const point &ahead, const int max_mapgen_per_turn )
+{
+    // How many submaps beyond the edge of the map are loaded
+    static constexpr int prefetch_distance = 2;
+
+    const tripoint abs = get_abs_sub();
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    int mapgen_runs = 0;
+    // Closest submaps first, they are needed first
+    for( int dist = 1; dist <= prefetch_distance; dist++ ) {
+        for( int gridx = -dist; gridx < my_MAPSIZE + dist; gridx++ ) {
+            for( int gridy = -dist; gridy < my_MAPSIZE + dist; gridy++ ) {
+                const int out_x = gridx < 0 ? -gridx : std::max( gridx - my_MAPSIZE + 1, 0 );
+                const int out_y = gridy < 0 ? -gridy : std::max( gridy - my_MAPSIZE + 1, 0 );
+                if( std::max( out_x, out_y ) != dist ) {
+                    continue;
+                }
+                const bool is_ahead = ( ahead.x > 0 && gridx >= my_MAPSIZE ) || ( ahead.x < 0 && gridx < 0 ) ||
+                                      ( ahead.y > 0 && gridy >= my_MAPSIZE ) || ( ahead.y < 0 && gridy < 0 );
+                if( !is_ahead ) {
+                    continue;
+                }
+                for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+                    const tripoint grid_abs_sub( abs.xy() + point( gridx, gridy ), gridz );
+                    if( MAPBUFFER.prefetch( grid_abs_sub ) ) {
+                        continue;
+                    }
+                    const bool uniform = is_uniform_quad( grid_abs_sub );
+                    if( !uniform && mapgen_runs >= max_mapgen_per_turn ) {
+                        continue;
+                    }
+                    generate_quad( grid_abs_sub );
+                    if( !uniform ) {
+                        mapgen_runs++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void map::loadn( const tripoint &grid, const bool update_vehicles )
+{
+    ZoneScoped;
     const tripoint grid_abs_sub = abs_sub.xy() + grid;
     const size_t gridn = get_nonant( grid );
 
@@ -7198,25 +7540,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     if( tmpsub == nullptr ) {
         // It doesn't exist; we must generate it!
         dbg( DL::Info ) << "map::loadn: Missing mapbuffer data.  Regenerating.";
-
-        // Each overmap square is two nonants; to prevent overlap, generate only at
-        //  squares divisible by 2.
-        // TODO: fix point types
-        const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
-        const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
-
-        const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
-
-        // Short-circuit if the map tile is uniform
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == air ) {
-            generate_uniform( grid_abs_sub_rounded, t_open_air );
-        } else if( terrain_type == rock ) {
-            generate_uniform( grid_abs_sub_rounded, t_rock );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
-        }
+        generate_quad( grid_abs_sub );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
@@ -7226,12 +7550,20 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
         }
     }
 
-    // New submap changes the content of the map and all caches must be recalculated
-    set_transparency_cache_dirty( grid.z );
+    // New submap changes the content of the map and all caches must be recalculated, those that
+    // keep track of their submaps only here and, for the outside flags, next to it
+    clear_path_cache.clear();
+    level_cache &ch = get_cache( grid.z );
+    const int last = my_MAPSIZE - 1;
+    for( int smx = std::max( grid.x - 1, 0 ); smx <= std::min( grid.x + 1, last ); smx++ ) {
+        for( int smy = std::max( grid.y - 1, 0 ); smy <= std::min( grid.y + 1, last ); smy++ ) {
+            ch.transparency_cache_dirty.set( smx * MAPSIZE + smy );
+        }
+    }
     set_seen_cache_dirty( grid.z );
     set_outside_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
-    set_pathfinding_cache_dirty( grid.z );
+    set_pathfinding_cache_dirty( tripoint( sm_to_ms_copy( grid.xy() ), grid.z ) );
     set_suspension_cache_dirty( grid.z );
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
@@ -7704,7 +8036,7 @@ void map::actualize( const tripoint &grid )
                 field_furn_locs.push_back( pnt );
             }
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+            if( !tmpsub->get_items( p ).empty() && !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
                 temperature_flag temperature = temperature_flag_at_point( *this, pnt );
                 remove_rotten_items( tmpsub->get_items( { x, y } ), pnt, temperature );
             }
@@ -7917,7 +8249,7 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool
                          tmp.wander_pos.x, tmp.wander_pos.y, tmp.wander_pos.z );
             }
 
-            monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ), p );
+            monster *const placed = g->place_critter_at( make_shared_pooled<monster>( tmp ), p );
             if( placed ) {
                 placed->on_load();
             }
@@ -7965,7 +8297,7 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
             };
 
             const auto place_it = [&]( const tripoint & p ) {
-                monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ), p );
+                monster *const placed = g->place_critter_at( make_shared_pooled<monster>( tmp ), p );
                 if( placed ) {
                     placed->on_load();
                     if( i.disposition == spawn_disposition::SpawnDisp_Pet ) {
@@ -7983,7 +8315,10 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->spawns.clear();
+        current_submap->mark_modified();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight )
@@ -8006,7 +8341,10 @@ void map::spawn_monsters( bool ignore_sight )
 void map::clear_spawns()
 {
     for( auto &smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->mark_modified();
+        }
     }
 }
 
@@ -8182,6 +8520,7 @@ int map::determine_wall_corner( const tripoint &p ) const
 
 void map::build_outside_cache( const int zlev )
 {
+    ZoneScoped;
     auto &ch = get_cache( zlev );
     if( !ch.outside_cache_dirty ) {
         return;
@@ -8207,6 +8546,18 @@ void map::build_outside_cache( const int zlev )
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
 
+            if( cur_submap->is_uniform ) {
+                // Either every tile is indoors or none is, the first one answers for all
+                if( cur_submap->get_ter( point_zero ).obj().has_flag( TFLAG_INDOORS ) ||
+                    cur_submap->get_furn( point_zero ).obj().has_flag( TFLAG_INDOORS ) ) {
+                    // The submap and the ring of tiles around it, as in the padded cache
+                    for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX + 2; x++ ) {
+                        std::fill_n( &padded_cache[x][smy * SEEY], SEEY + 2, false );
+                    }
+                }
+                continue;
+            }
+
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     point sp( sx, sy );
@@ -8248,20 +8599,25 @@ void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
     for( int smx = min_submap.x; smx <= max_submap.x; ++smx ) {
         for( int smy = min_submap.y; smy <= max_submap.y; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, start.z } );
+            const auto obstacle_at = [cur_submap]( const point & sp ) {
+                const int ter_move = cur_submap->get_ter( sp ).obj().movecost;
+                const int furn_move = cur_submap->get_furn( sp ).obj().movecost;
+                return ter_move == 0 || furn_move < 0 || ter_move + furn_move == 0 ? 1000.0f : 0.0f;
+            };
+
+            if( cur_submap->is_uniform ) {
+                const float value = obstacle_at( point_zero );
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    std::fill_n( &obstacle_cache[sx + smx * SEEX][smy * SEEY], SEEY, value );
+                }
+                continue;
+            }
 
             // TODO: Init indices to prevent iterating over unused submap sections.
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
-                    const point sp( sx, sy );
-                    int ter_move = cur_submap->get_ter( sp ).obj().movecost;
-                    int furn_move = cur_submap->get_furn( sp ).obj().movecost;
-                    const int x = sx + smx * SEEX;
-                    const int y = sy + smy * SEEY;
-                    if( ter_move == 0 || furn_move < 0 || ter_move + furn_move == 0 ) {
-                        obstacle_cache[x][y] = 1000.0f;
-                    } else {
-                        obstacle_cache[x][y] = 0.0f;
-                    }
+                    obstacle_cache[sx + smx * SEEX][sy + smy * SEEY] =
+                        obstacle_at( point( sx, sy ) );
                 }
             }
         }
@@ -8287,14 +8643,9 @@ void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
 
 }
 
-bool map::build_floor_cache( const int zlev )
+void map::fill_floor_cache( const int zlev, std::vector<tripoint> &missing ) const
 {
-    auto &ch = get_cache( zlev );
-    if( !ch.floor_cache_dirty ) {
-        return false;
-    }
-
-    auto &floor_cache = ch.floor_cache;
+    auto &floor_cache = get_cache( zlev ).floor_cache;
     std::uninitialized_fill_n(
         &floor_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), true );
 
@@ -8305,16 +8656,35 @@ bool map::build_floor_cache( const int zlev )
             const submap *below_submap = !lowest_z_lev ? get_submap_at_grid( { smx, smy, zlev - 1 } ) : nullptr;
 
             if( cur_submap == nullptr ) {
-                debugmsg( "Tried to build floor cache at (%d,%d,%d) but the submap is not loaded", smx, smy, zlev );
+                missing.emplace_back( smx, smy, zlev );
                 continue;
             }
             if( !lowest_z_lev && below_submap == nullptr ) {
-                debugmsg( "Tried to build floor cache at (%d,%d,%d) but the submap is not loaded", smx, smy,
-                          zlev - 1 );
+                missing.emplace_back( smx, smy, zlev - 1 );
                 continue;
             }
 
+            const int x0 = smx * SEEX;
+            const int y0 = smy * SEEY;
+            if( cur_submap->is_uniform ) {
+                // Either no tile has a floor or all of them do
+                if( !cur_submap->get_ter( point_zero ).obj().has_flag( TFLAG_NO_FLOOR ) ) {
+                    continue;
+                }
+                if( below_submap == nullptr || below_submap->is_uniform ) {
+                    const bool roof_below = below_submap &&
+                                            below_submap->get_furn( point_zero ).obj().has_flag( TFLAG_SUN_ROOF_ABOVE );
+                    if( !roof_below ) {
+                        for( int sx = 0; sx < SEEX; ++sx ) {
+                            std::fill_n( &floor_cache[x0 + sx][y0], SEEY, false );
+                        }
+                    }
+                    continue;
+                }
+            }
+
             for( int sx = 0; sx < SEEX; ++sx ) {
+                bool *column = &floor_cache[x0 + sx][y0];
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     point sp( sx, sy );
                     const ter_t &terrain = cur_submap->get_ter( sp ).obj();
@@ -8322,17 +8692,42 @@ bool map::build_floor_cache( const int zlev )
                         if( below_submap && ( below_submap->get_furn( sp ).obj().has_flag( TFLAG_SUN_ROOF_ABOVE ) ) ) {
                             continue;
                         }
-                        const int x = sx + smx * SEEX;
-                        const int y = sy + smy * SEEY;
-                        floor_cache[x][y] = false;
+                        column[sy] = false;
                     }
                 }
             }
         }
     }
+}
+
+bool map::build_floor_cache( const int zlev )
+{
+    ZoneScoped;
+    return rebuild_floor_caches( zlev, zlev )[zlev + OVERMAP_DEPTH];
+}
+
+std::array<bool, OVERMAP_LAYERS> map::rebuild_floor_caches( const int minz, const int maxz )
+{
+    std::array<bool, OVERMAP_LAYERS> rebuilt{};
+    std::array<std::vector<tripoint>, OVERMAP_LAYERS> missing;
+    allocate_caches( minz, maxz );
+    get_thread_pool().parallel_for( minz, maxz + 1, [&]( int z ) {
+        if( get_cache( z ).floor_cache_dirty ) {
+            fill_floor_cache( z, missing[z + OVERMAP_DEPTH] );
+            rebuilt[z + OVERMAP_DEPTH] = true;
+        }
+    } );
 
-    ch.floor_cache_dirty = false;
-    return zlevels;
+    for( int z = minz; z <= maxz; z++ ) {
+        for( const tripoint &p : missing[z + OVERMAP_DEPTH] ) {
+            debugmsg( "Tried to build floor cache at (%d,%d,%d) but the submap is not loaded", p.x, p.y, p.z );
+        }
+        if( rebuilt[z + OVERMAP_DEPTH] ) {
+            get_cache( z ).floor_cache_dirty = false;
+            rebuilt[z + OVERMAP_DEPTH] = zlevels;
+        }
+    }
+    return rebuilt;
 }
 
 void map::build_floor_caches()
@@ -8341,9 +8736,7 @@ void map::build_floor_caches()
 
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
-    for( int z = minz; z <= maxz; z++ ) {
-        build_floor_cache( z );
-    }
+    rebuild_floor_caches( minz, maxz );
 }
 
 void map::update_suspension_cache( const int &z )
@@ -8363,6 +8756,10 @@ void map::update_suspension_cache( const int &z )
                               z );
                     continue;
                 }
+                if( cur_submap->is_uniform &&
+                    !cur_submap->get_ter( point_zero ).obj().has_flag( TFLAG_SUSPENDED ) ) {
+                    continue;
+                }
 
                 for( int sx = 0; sx < SEEX; ++sx ) {
                     for( int sy = 0; sy < SEEY; ++sy ) {
@@ -8509,13 +8906,22 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
+    // These only read the submaps and each writes the caches of its own z-level
+    update_weather_transparency();
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+    allocate_caches( minz, maxz );
+    get_thread_pool().parallel_for( minz, maxz + 1, [&]( int z ) {
+        build_outside_cache( z );
+        build_transparency_cache( z, sight_penalty );
+    } );
+    for( int z = minz; z <= maxz; z++ ) {
+        update_suspension_cache( z );
+    }
+    const std::array<bool, OVERMAP_LAYERS> floor_rebuilt = rebuild_floor_caches( minz, maxz );
     for( int z = minz; z <= maxz; z++ ) {
         // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
         const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
-        update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
+        seen_cache_dirty |= ( floor_rebuilt[z + OVERMAP_DEPTH] && affects_seen_cache );
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
         diagonal_blocks fill = {false, false};
         std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
@@ -8534,6 +8940,8 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
     }
+    // Vehicles moved and got damaged since the last turn
+    clear_path_cache.clear();
     // Initial value is illegal player position.
     const tripoint &p = g->u.pos();
     static tripoint player_prev_pos;
@@ -8789,82 +9197,23 @@ void map::creature_on_trap( Creature &c, const bool may_avoid )
     tr.trigger( c.pos(), &c );
 }
 
-template<typename Functor>
-void map::function_over( const tripoint &start, const tripoint &end, Functor fun ) const
-{
-    // start and end are just two points, end can be "before" start
-    // Also clip the area to map area
-    const tripoint min( std::max( std::min( start.x, end.x ), 0 ), std::max( std::min( start.y, end.y ),
-                        0 ), std::max( std::min( start.z, end.z ), -OVERMAP_DEPTH ) );
-    const tripoint max( std::min( std::max( start.x, end.x ), SEEX * my_MAPSIZE - 1 ),
-                        std::min( std::max( start.y, end.y ), SEEY * my_MAPSIZE - 1 ), std::min( std::max( start.z, end.z ),
-                                OVERMAP_HEIGHT ) );
-
-    // Submaps that contain the bounding points
-    const point min_sm( min.x / SEEX, min.y / SEEY );
-    const point max_sm( max.x / SEEX, max.y / SEEY );
-    // Z outermost, because submaps are flat
-    tripoint gp;
-    int &z = gp.z;
-    int &smx = gp.x;
-    int &smy = gp.y;
-    for( z = min.z; z <= max.z; z++ ) {
-        for( smx = min_sm.x; smx <= max_sm.x; smx++ ) {
-            for( smy = min_sm.y; smy <= max_sm.y; smy++ ) {
-                submap const *cur_submap = get_submap_at_grid( { smx, smy, z } );
-                // Bounds on the submap coordinates
-                const point sm_min( smx > min_sm.x ? 0 : min.x % SEEX, smy > min_sm.y ? 0 : min.y % SEEY );
-                const point sm_max( smx < max_sm.x ? SEEX - 1 : max.x % SEEX,
-                                    smy < max_sm.y ? SEEY - 1 : max.y % SEEY );
-
-                point lp;
-                int &sx = lp.x;
-                int &sy = lp.y;
-                for( sx = sm_min.x; sx <= sm_max.x; ++sx ) {
-                    for( sy = sm_min.y; sy <= sm_max.y; ++sy ) {
-                        const iteration_state rval = fun( gp, cur_submap, lp );
-                        if( rval != ITER_CONTINUE ) {
-                            switch( rval ) {
-                                case ITER_SKIP_ZLEVEL:
-                                    smx = my_MAPSIZE + 1;
-                                    smy = my_MAPSIZE + 1;
-                                // Fall through
-                                case ITER_SKIP_SUBMAP:
-                                    sx = SEEX;
-                                    sy = SEEY;
-                                    break;
-                                default:
-                                    return;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
 void map::scent_blockers( std::array<std::array<char, MAPSIZE_X>, MAPSIZE_Y> &scent_transfer,
                           point min, point max )
 {
     auto reduce = TFLAG_REDUCE_SCENT;
     auto block = TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint & gp, const submap * sm, point  lp ) {
-        // We need to generate the x/y coordinates, because we can't get them "for free"
-        const point p = lp + sm_to_ms_copy( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
+    auto fill_values = [&]( const submap & sm, point lp, const tripoint & p ) {
+        const ter_t &ter = sm.get_ter( lp ).obj();
+        if( ter.has_flag( block ) ) {
             scent_transfer[p.x][p.y] = 0;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
+        } else if( ter.has_flag( reduce ) || sm.get_furn( lp ).obj().has_flag( reduce ) ) {
             scent_transfer[p.x][p.y] = 1;
         } else {
             scent_transfer[p.x][p.y] = 5;
         }
-
-        return ITER_CONTINUE;
     };
 
-    function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+    for_each_tile( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
 
     const inclusive_rectangle<point> local_bounds( min, max );
 
@@ -9033,7 +9382,7 @@ std::list<Creature *> map::get_creatures_in_radius( const tripoint &center, size
 level_cache &map::access_cache( int zlev )
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
@@ -9043,7 +9392,7 @@ level_cache &map::access_cache( int zlev )
 const level_cache &map::access_cache( int zlev ) const
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
@@ -9063,6 +9412,10 @@ level_cache::level_cache()
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
+    std::fill_n( &sunlight_cache[0][0], map_dimensions, four_quadrants( 0.0f ) );
+    std::fill_n( &sunlight_transparency[0][0], map_dimensions, 0.0f );
+    std::fill_n( &sunlight_floor[0][0], map_dimensions, false );
+    std::fill_n( &sunlight_outside[0][0], map_dimensions, false );
     diagonal_blocks fill = {false, false};
     std::fill_n( &vehicle_obscured_cache[0][0], map_dimensions, fill );
     std::fill_n( &vehicle_obstructed_cache[0][0], map_dimensions, fill );
@@ -9070,7 +9423,13 @@ level_cache::level_cache()
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, lit_level::DARK );
     veh_in_active_range = false;
-    std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
+}
+
+void map::allocate_caches( const int minz, const int maxz ) const
+{
+    for( int z = minz; z <= maxz; z++ ) {
+        get_cache( z );
+    }
 }
 
 pathfinding_cache::pathfinding_cache()
@@ -9080,6 +9439,22 @@ pathfinding_cache::pathfinding_cache()
 
 
 
+std::size_t map::cache_memory_usage() const
+{
+    std::size_t bytes = 0;
+    for( const std::unique_ptr<level_cache> &cache : caches ) {
+        if( cache != nullptr ) {
+            bytes += sizeof( level_cache ) + cache->vehicle_list.size() * sizeof( vehicle * );
+        }
+    }
+    for( const std::unique_ptr<pathfinding_cache> &cache : pathfinding_caches ) {
+        if( cache != nullptr ) {
+            bytes += sizeof( pathfinding_cache );
+        }
+    }
+    return bytes;
+}
+
 pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 {
     return *pathfinding_caches[zlev + OVERMAP_DEPTH];
@@ -9087,8 +9462,45 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
+    clear_path_cache.clear();
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
+        forget_monster_moves( zlev );
+    }
+}
+
+route_memo &map::get_route_cache( const int zlev ) const
+{
+    return get_pathfinding_cache( zlev ).routes;
+}
+
+move_memo &map::get_monster_move_cache( const int zlev ) const
+{
+    return get_pathfinding_cache( zlev ).monster_moves;
+}
+
+void map::clear_monster_move_caches() const
+{
+    for( const std::unique_ptr<pathfinding_cache> &cache : pathfinding_caches ) {
+        cache->monster_moves.clear();
+    }
+}
+
+void map::forget_monster_moves( const int zlev ) const
+{
+    // Monsters climbing out of the level below look at the floor of this one
+    get_pathfinding_cache( zlev ).monster_moves.clear();
+    if( inbounds_z( zlev - 1 ) ) {
+        get_pathfinding_cache( zlev - 1 ).monster_moves.clear();
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    clear_path_cache.clear();
+    if( inbounds( p ) ) {
+        get_pathfinding_cache( p.z ).dirty_submaps.set( ( p.x / SEEX ) * MAPSIZE + p.y / SEEY );
+        forget_monster_moves( p.z );
     }
 }
 
@@ -9120,6 +9532,8 @@ void map::invalidate_map_cache( const int zlev )
         ch.outside_cache_dirty = true;
         ch.suspension_cache_dirty = true;
     }
+    lightmap_valid = false;
+    sunlight_valid = false;
 }
 
 void map::set_memory_seen_cache_dirty( const tripoint &p )
@@ -9137,7 +9551,7 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
         return *pathfinding_caches[ OVERMAP_DEPTH ];
     }
     auto &cache = get_pathfinding_cache( zlev );
-    if( cache.dirty ) {
+    if( cache.dirty || cache.dirty_submaps.any() ) {
         update_pathfinding_cache( zlev );
     }
 
@@ -9147,16 +9561,45 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
 void map::update_pathfinding_cache( int zlev ) const
 {
     auto &cache = get_pathfinding_cache( zlev );
-    if( !cache.dirty ) {
+    if( !cache.dirty && cache.dirty_submaps.none() ) {
         return;
     }
 
-    std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    if( cache.dirty ) {
+        std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+        std::uninitialized_fill_n( &cache.area[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
+    }
+    cache.route_fields.clear();
+    cache.generation++;
+    // Everything worked out from the whole level once its tiles are up to date
+    const auto index_level = [&]() {
+        cache.update_areas();
+        cache.stairs_up.clear();
+        cache.stairs_down.clear();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                if( cache.special[x][y] & PF_UPDOWN ) {
+                    const tripoint p( x, y, zlev );
+                    if( has_flag( TFLAG_GOES_UP, p ) ) {
+                        cache.stairs_up.emplace_back( x, y );
+                    }
+                    if( has_flag( TFLAG_GOES_DOWN, p ) ) {
+                        cache.stairs_down.emplace_back( x, y );
+                    }
+                }
+            }
+        }
+    };
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !cache.dirty && !cache.dirty_submaps.test( smx * MAPSIZE + smy ) ) {
+                continue;
+            }
+            cache.submap_generation[smx * MAPSIZE + smy] = cache.generation;
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
             if( !cur_submap ) {
+                index_level();
                 return;
             }
 
@@ -9215,12 +9658,17 @@ void map::update_pathfinding_cache( int zlev ) const
                     }
 
                     cache.special[p.x][p.y] = cur_value;
+                    // Anything a route could get through without bashing
+                    cache.area[p.x][p.y] = !( cur_value & PF_WALL ) || cur_value & ( PF_CLIMBABLE | PF_VEHICLE ) ||
+                                           terrain.open || furniture.open;
                 }
             }
         }
     }
 
+    index_level();
     cache.dirty = false;
+    cache.dirty_submaps.reset();
 }
 
 void map::clip_to_bounds( tripoint &p ) const
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_MAP_H
 #define CATA_SRC_MAP_H
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <climits>
@@ -28,11 +29,12 @@
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
+#include "line_memo.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "shadowcasting.h"
+#include "tripoint_map.h"
 #include "type_id.h"
 #include "units.h"
 
@@ -85,6 +87,11 @@ class map;
 
 enum ter_bitflags : int;
 struct pathfinding_cache;
+struct route_field;
+class route_memo;
+class move_memo;
+struct pathfinder;
+struct route_request;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
@@ -296,11 +303,36 @@ struct diagonal_blocks {
     bool ne;
 };
 
+// A light applied by map::generate_lightmap, recorded before anything is cast
+// so that a turn with the same lights as the last one can keep the old lightmap.
+struct light_op {
+    enum class kind : int {
+        source,     // map::apply_light_source
+        buffered,   // map::add_light_source
+        arc,        // map::apply_light_arc
+        opening,    // sunlight leaking through the side of a building, direction indexes the neighbour
+        character,  // checks whether the character counts as lit, not part of the lightmap inputs
+    };
+    kind type = kind::source;
+    tripoint p;
+    float luminance = 0.0f;
+    units::angle angle = 0_degrees;
+    units::angle width = 0_degrees;
+    int direction = 0;
+    Character *who = nullptr;
+    // Light at p when a character op was reached
+    float ambient = 0.0f;
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
     level_cache( const level_cache &other ) = default;
 
+    static constexpr std::size_t veh_exists_index( point p ) {
+        return static_cast<std::size_t>( p.x + p.y * MAPSIZE_X );
+    }
+
     std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
     bool outside_cache_dirty = false;
     bool floor_cache_dirty = false;
@@ -315,6 +347,19 @@ struct level_cache {
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
 
+    // Sunlight cast by map::build_sunlight_cache before other lights are added to lm,
+    // along with the inputs it was cast from, so that unchanged tiles can be skipped next time.
+    four_quadrants sunlight_cache[MAPSIZE_X][MAPSIZE_Y];
+    float sunlight_transparency[MAPSIZE_X][MAPSIZE_Y];
+    bool sunlight_floor[MAPSIZE_X][MAPSIZE_Y];
+    bool sunlight_outside[MAPSIZE_X][MAPSIZE_Y];
+    // Tiles that got light from above brighter than the inside level, indexed by veh_exists_index
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> sunlit;
+    // true if sunlight_cache was cast tile by tile rather than filled
+    bool sunlight_cast = false;
+    // Tiles map::shift moved in or to the edge, cast again whatever the inputs above say
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> sunlight_stale;
+
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
     bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -350,8 +395,9 @@ struct level_cache {
     std::bitset<MAPSIZE *MAPSIZE> field_cache;
 
     bool veh_in_active_range;
-    bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
-    std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
+    // Indexed by veh_exists_index
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> veh_exists_at;
+    cata::tripoint_map<std::pair<vehicle *, int>> veh_cached_parts;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
 
@@ -422,6 +468,10 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+        /** Bytes taken by the level and pathfinding caches of all z-levels. */
+        std::size_t cache_memory_usage() const;
+        // Only the submap containing the tile
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -515,6 +565,16 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( point s );
+        /**
+         * Load or generate the submaps the vehicle is about to drive into,
+         * so @ref shift doesn't have to wait for them.
+         */
+        void prefetch_submaps_ahead( const vehicle &veh );
+        /**
+         * Load or generate the submaps beyond the map edge that a creature at @p pos
+         * (in local coordinates) is about to bring into the map.
+         */
+        void prefetch_submaps_ahead( const tripoint &pos );
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -540,6 +600,8 @@ class map
         bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
         int burn_body_part( player &u, field_entry &cur, body_part bp, int scale );
+        // Loads the submaps beyond the map edges in the direction of @p ahead
+        void prefetch_submaps_ahead( const point &ahead, int max_mapgen_per_turn );
     public:
 
         // Movement and LOS
@@ -610,6 +672,11 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Checks the lines between each pair of points on the thread pool and remembers them,
+         * so sees() calls for them afterwards are cheap. Only lines within a z-level are checked.
+         */
+        void sees_batch( const std::vector<std::pair<tripoint, tripoint>> &lines ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -622,6 +689,8 @@ class map
          * Set to zero if the function returns false.
         **/
         bool sees( const tripoint &F, const tripoint &T, int range, int &bresenham_slope ) const;
+        /** Whether the line from `F` to `T` is clear, ignoring range and the remembered results. */
+        bool sight_line_clear( const tripoint &F, const tripoint &T, int &bresenham_slope ) const;
     public:
         /**
         * Returns coverage of target in relation to the observer. Target is loc2, observer is loc1.
@@ -644,6 +713,9 @@ class map
          */
         bool clear_path( const tripoint &f, const tripoint &t, int range,
                          int cost_min, int cost_max ) const;
+    private:
+        bool trace_clear_path( const tripoint &f, const tripoint &t, int cost_min, int cost_max ) const;
+    public:
 
         /**
          * Checks if a rotated vehicle is blocking diagonal movement, tripoints must be adjacent
@@ -698,6 +770,20 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Results of route() for each of the requests, searched for at the same time on the thread pool.
+         * They are also remembered, so route() calls with the same arguments afterwards are cheap.
+         */
+        std::vector<std::vector<tripoint>> route_batch( const std::vector<route_request> &requests ) const;
+        /**
+         * Like route() for creatures that avoid nothing in particular.
+         * Once a few of them head for the same target with the same settings, routes to it
+         * are read off a cost field shared between them until the terrain changes.
+         */
+        std::vector<tripoint> route_shared( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings ) const;
+        /** Submaps a route may pass through, indexed by `smx * MAPSIZE + smy`. */
+        using route_corridor = std::bitset<MAPSIZE *MAPSIZE>;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1763,6 +1849,14 @@ class map
          * @param shift The amount shifting in submap, the same as go into @ref shift.
          */
         void shift_traps( const tripoint &shift );
+        /**
+         * As part of the map shifting, moves the transparency, sunlight and pathfinding caches
+         * of one z-level along with the submaps, instead of building them again. What the
+         * newly loaded submaps change is marked as they're loaded, see @ref loadn.
+         * @param shifted_in The tiles whose sunlight has to be cast again.
+         */
+        void shift_level_caches( int zlev, point shift,
+                                 const std::bitset<MAPSIZE_X *MAPSIZE_Y> &shifted_in );
 
         void copy_grid( const tripoint &to, const tripoint &from );
         void draw_map( mapgendata &dat );
@@ -1776,7 +1870,11 @@ class map
 
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
-        bool build_transparency_cache( int zlev );
+        // Only reads shared state, so different z-levels can be built at the same time.
+        bool build_transparency_cache( int zlev, float sight_penalty );
+        // Updates the shadowcasting lookup for the current weather, call before building
+        // transparency caches.
+        void update_weather_transparency();
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1786,11 +1884,31 @@ class map
         // Used to determine if seen cache should be rebuilt.
         bool build_floor_cache( int zlev );
         // We want this visible in `game`, because we want it built earlier in the turn than the rest
+        // Builds all z-levels in parallel.
         void build_floor_caches();
+    private:
+        // Floor cache of one z-level without reporting errors, safe to run on the thread pool.
+        // Grid positions of submaps that aren't loaded are added to missing.
+        void fill_floor_cache( int zlev, std::vector<tripoint> &missing ) const;
+        // Runs fill_floor_cache on the pool for every dirty z-level in [minz, maxz].
+        // Returns which levels were rebuilt, indexed by z + OVERMAP_DEPTH.
+        std::array<bool, OVERMAP_LAYERS> rebuild_floor_caches( int minz, int maxz );
+    public:
         // Checks all suspended tiles on a z level and adds those that are invalid to the support_dirty_cache */
         void update_suspension_cache( const int &z );
     protected:
         void generate_lightmap( int zlev );
+    private:
+        // Records the lights generate_lightmap would apply on zlev without casting any of them
+        void collect_lights( int zlev, std::vector<light_op> &ops,
+                             std::vector<std::pair<tripoint, float>> &lm_override );
+        // Hash of the recorded lights and every cache the lightmap of zlev is built from
+        std::size_t lightmap_inputs_hash( int zlev, const std::vector<light_op> &ops,
+                                          const std::vector<std::pair<tripoint, float>> &lm_override );
+        // Full rebuild of the lightmap from recorded lights, fills in the ambient light of character ops
+        void apply_lights( int zlev, std::vector<light_op> &ops,
+                           const std::vector<std::pair<tripoint, float>> &lm_override );
+    protected:
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1946,26 +2064,39 @@ class map
         void process_items_in_vehicles( submap &current_submap );
         void process_items_in_vehicle( vehicle &cur_veh, submap &current_submap );
 
-        /** Enum used by functors in `function_over` to control execution. */
-        enum iteration_state {
-            ITER_CONTINUE = 0,  // Keep iterating
-            ITER_SKIP_SUBMAP,   // Skip the rest of this submap
-            ITER_SKIP_ZLEVEL,   // Skip the rest of this z-level
-            ITER_FINISH         // End iteration
-        };
-        /**
-        * Runs a functor over given submaps
-        * over submaps in the area, getting next submap only when the current one "runs out" rather than every time.
-        * gp in the functor is Grid (like `get_submap_at_grid`) coordinate of the submap,
-        * Will silently clip the area to map bounds.
-        * @param start Starting point for function
-        * @param end End point for function
-        * @param fun Function to run
-        */
-        /*@{*/
-        template<typename Functor>
-        void function_over( const tripoint &start, const tripoint &end, Functor fun ) const;
-        /*@}*/
+        /** Backs both @ref for_each_tile, @p Submap is `submap` or `const submap`. */
+        template<typename Submap, typename Functor>
+        void for_each_tile_on( const tripoint &from, const tripoint &to, Functor &fun ) const {
+            const int min_z = std::max( std::min( from.z, to.z ),
+                                        zlevels ? -OVERMAP_DEPTH : abs_sub.z );
+            const int max_z = std::min( std::max( from.z, to.z ),
+                                        zlevels ? OVERMAP_HEIGHT : abs_sub.z );
+            const point min( std::max( std::min( from.x, to.x ), 0 ),
+                             std::max( std::min( from.y, to.y ), 0 ) );
+            const point max( std::min( std::max( from.x, to.x ), SEEX * my_MAPSIZE - 1 ),
+                             std::min( std::max( from.y, to.y ), SEEY * my_MAPSIZE - 1 ) );
+            if( min.x > max.x || min.y > max.y ) {
+                return;
+            }
+            for( int z = min_z; z <= max_z; z++ ) {
+                for( int smx = min.x / SEEX; smx <= max.x / SEEX; smx++ ) {
+                    for( int smy = min.y / SEEY; smy <= max.y / SEEY; smy++ ) {
+                        Submap &sm = *get_submap_at_grid( tripoint( smx, smy, z ) );
+                        const point origin( smx * SEEX, smy * SEEY );
+                        const point l_min( std::max( min.x - origin.x, 0 ),
+                                           std::max( min.y - origin.y, 0 ) );
+                        const point l_max( std::min( max.x - origin.x, SEEX - 1 ),
+                                           std::min( max.y - origin.y, SEEY - 1 ) );
+                        for( int lx = l_min.x; lx <= l_max.x; lx++ ) {
+                            for( int ly = l_min.y; ly <= l_max.y; ly++ ) {
+                                const point l( lx, ly );
+                                fun( sm, l, tripoint( origin + l, z ) );
+                            }
+                        }
+                    }
+                }
+            }
+        }
 
         /**
          * The list of currently loaded submaps. The size of this should not be changed.
@@ -1985,9 +2116,10 @@ class map
          */
         std::vector<tripoint> field_furn_locs;
         /**
-         * Holds caches for visibility, light, transparency and vehicles
+         * Holds caches for visibility, light, transparency and vehicles.
+         * Allocated on first access, so z-levels that are never used cost nothing.
          */
-        std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
+        mutable std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
         /**
@@ -1998,7 +2130,28 @@ class map
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable line_memo skew_vision_cache;
+        /**
+         * Same for clear_path, cleared whenever move costs may have changed.
+         */
+        mutable line_memo clear_path_cache;
+
+        /**
+         * Lights applied by the last generate_lightmap and the hash of its inputs.
+         * The lightmap is only rebuilt when the hash changes.
+         */
+        std::vector<light_op> last_light_ops;
+        std::size_t last_lightmap_inputs = 0;
+        bool lightmap_valid = false;
+        // Set while collect_lights runs, light functions record themselves here instead of casting
+        std::vector<light_op> *recorded_lights = nullptr;
+
+        /**
+         * Highest z-level, natural light and sight penalty of the last build_sunlight_cache.
+         * The per-level sunlight is only reused when these match.
+         */
+        std::tuple<int, float, float> last_sunlight_inputs;
+        bool sunlight_valid = false;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
@@ -2008,10 +2161,47 @@ class map
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
-            return *caches[zlev + OVERMAP_DEPTH];
+            std::unique_ptr<level_cache> &cache = caches[zlev + OVERMAP_DEPTH];
+            if( !cache ) {
+                cache = std::make_unique<level_cache>();
+            }
+            return *cache;
         }
+        // Allocates the caches of these z-levels, must be done before touching them from the thread pool
+        void allocate_caches( int minz, int maxz ) const;
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
+        // Forgets the monster moves on the level and the one below, after the level changed
+        void forget_monster_moves( int zlev ) const;
+        struct route_step {
+            // -1 if the step can't be taken
+            int cost = -1;
+            // The tile can't be stepped on from anywhere else either
+            bool close = false;
+            // The tile is a ledge a route could drop down from
+            bool ledge = false;
+        };
+        // Cost of a route stepping from `cur` onto the neighbouring `p`, `cur_veh` is the vehicle at `cur`
+        route_step route_step_cost( const tripoint &cur, const vehicle *cur_veh, const tripoint &p,
+                                    const pathfinding_settings &settings ) const;
+        void build_route_field( route_field &field ) const;
+        // route() without the route cache if `searched` isn't null, the submaps a search reached are added to it instead
+        std::vector<tripoint> find_route( const tripoint &f, const tripoint &t,
+                                          const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                          route_corridor *searched ) const;
+        // Route between z-levels through the stairs of each level in turn, empty if there is none
+        std::vector<tripoint> route_by_stairs( const tripoint &f, const tripoint &t,
+                                               const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                               route_corridor *searched ) const;
+        // Same level A* that jumps over open ground, for route_within
+        std::vector<tripoint> jump_route( const tripoint &f, const tripoint &t,
+                                          const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                          pathfinder &pf, point min, point max, const route_corridor *corridor ) const;
+        // A* search of route(), within the corridor or a box around the ends if it's null
+        // Adds the submaps it could reach to `searched`
+        std::vector<tripoint> route_within( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                            const route_corridor *corridor, route_corridor &searched ) const;
 
         visibility_variables visibility_variables_cache;
 
@@ -2021,7 +2211,7 @@ class map
 
     public:
         const level_cache &get_cache_ref( int zlev ) const {
-            return *caches[zlev + OVERMAP_DEPTH];
+            return get_cache( zlev );
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
@@ -2031,6 +2221,21 @@ class map
         void update_visibility_cache( int zlev );
         const visibility_variables &get_visibility_variables_cache() const;
 
+        /**
+         * Line of sight results, keyed on the two squares only, so they are shared by every
+         * observer looking from the same square whatever its vision range.
+         */
+        line_memo &get_sees_cache() const {
+            return skew_vision_cache;
+        }
+        line_memo &get_clear_path_cache() const {
+            return clear_path_cache;
+        }
+        route_memo &get_route_cache( int zlev ) const;
+        move_memo &get_monster_move_cache( int zlev ) const;
+        /** Forgets what monsters decided about tiles, for a new turn. */
+        void clear_monster_move_caches() const;
+
         void update_submap_active_item_status( const tripoint &p );
 
         // Just exposed for unit test introspection.
@@ -2051,6 +2256,24 @@ class map
         /// returns an empty range.
         tripoint_range<tripoint> points_on_zlevel( int z ) const;
 
+        /**
+         * Calls `fun( submap &sm, point l, const tripoint &p )` for every tile from @p from to
+         * @p to, clipped to map bounds like @ref points_in_rectangle. @p l is the tile on @p sm,
+         * @p p the same tile on the map. It goes submap by submap, so unlike @ref ter and the
+         * like there's no bounds check and submap lookup for each tile.
+         * Don't load or shift the map from @p fun.
+         */
+        /*@{*/
+        template<typename Functor>
+        void for_each_tile( const tripoint &from, const tripoint &to, Functor fun ) {
+            for_each_tile_on<submap>( from, to, fun );
+        }
+        template<typename Functor>
+        void for_each_tile( const tripoint &from, const tripoint &to, Functor fun ) const {
+            for_each_tile_on<const submap>( from, to, fun );
+        }
+        /*@}*/
+
         std::vector<item *> get_active_items_in_radius( const tripoint &center, int radius ) const;
         std::vector<item *> get_active_items_in_radius( const tripoint &center, int radius,
                 special_item_type type ) const;
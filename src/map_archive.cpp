@@ -0,0 +1,252 @@
+#include "map_archive.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+#include "binary_io.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "string_formatter.h"
+
+static constexpr char archive_magic[4] = { 'C', 'B', 'S', 'A' };
+static constexpr std::uint32_t archive_version = 1;
+// magic, version, end of indexed records, number of index entries
+static constexpr std::uint64_t header_fixed_size = 4 + 4 + 8 + 4;
+// address, offset, length, format
+static constexpr std::uint64_t index_entry_size = 12 + 8 + 4 + 1;
+// address, format, length
+static constexpr std::uint64_t record_header_size = 12 + 1 + 4;
+// Don't bother compacting small files
+static constexpr std::uint64_t min_compaction_size = 64 * 1024;
+
+static void write_record_header( binary_out &out, const tripoint &om_addr,
+                                 segment_archive::record_format format, std::uint32_t length )
+{
+    out.write<std::int32_t>( om_addr.x );
+    out.write<std::int32_t>( om_addr.y );
+    out.write<std::int32_t>( om_addr.z );
+    out.write( static_cast<std::uint8_t>( format ) );
+    out.write( length );
+}
+
+segment_archive::segment_archive( const std::string &path ) : path( path )
+{
+    load_index();
+}
+
+void segment_archive::load_index()
+{
+    index.clear();
+    file_size = 0;
+    live_bytes = 0;
+    damaged = false;
+    if( !file_exist( path ) ) {
+        return;
+    }
+    const bool ok = read_from_file( path, [&]( std::istream & fin ) {
+        fin.seekg( 0, std::ios::end );
+        file_size = static_cast<std::uint64_t>( fin.tellg() );
+        fin.seekg( 0 );
+
+        binary_in in( fin );
+        char magic[sizeof( archive_magic )];
+        in.read_raw( magic, sizeof( magic ) );
+        if( !std::equal( std::begin( magic ), std::end( magic ), std::begin( archive_magic ) ) ) {
+            throw binary_error( "not a map segment archive" );
+        }
+        const std::uint32_t version = in.read<std::uint32_t>();
+        if( version > archive_version ) {
+            throw binary_error( string_format( "map segment archive version %d is newer than supported %d",
+                                               version, archive_version ) );
+        }
+        const std::uint64_t indexed_end = in.read<std::uint64_t>();
+        const std::uint32_t count = in.read<std::uint32_t>();
+        for( std::uint32_t i = 0; i < count; ++i ) {
+            tripoint om_addr;
+            om_addr.x = in.read<std::int32_t>();
+            om_addr.y = in.read<std::int32_t>();
+            om_addr.z = in.read<std::int32_t>();
+            entry e;
+            e.offset = in.read<std::uint64_t>();
+            e.length = in.read<std::uint32_t>();
+            e.format = static_cast<record_format>( in.read<std::uint8_t>() );
+            index[om_addr] = e;
+        }
+
+        // Records appended since the last compaction aren't in the header index
+        std::uint64_t pos = indexed_end;
+        fin.seekg( pos );
+        while( pos + record_header_size <= file_size ) {
+            tripoint om_addr;
+            om_addr.x = in.read<std::int32_t>();
+            om_addr.y = in.read<std::int32_t>();
+            om_addr.z = in.read<std::int32_t>();
+            entry e;
+            e.format = static_cast<record_format>( in.read<std::uint8_t>() );
+            e.length = in.read<std::uint32_t>();
+            e.offset = pos;
+            if( pos + record_header_size + e.length > file_size ) {
+                break;
+            }
+            index[om_addr] = e;
+            pos += record_header_size + e.length;
+            fin.seekg( pos );
+        }
+        if( pos != file_size ) {
+            // Most likely the game was killed in the middle of appending
+            debugmsg( "Map segment archive %s has a truncated record, it will be rebuilt", path );
+            damaged = true;
+        }
+    } );
+    if( !ok ) {
+        // Keep whatever could be read, the rest is dropped by the next compaction
+        damaged = true;
+    }
+
+    for( const auto &pr : index ) {
+        live_bytes += record_header_size + pr.second.length;
+    }
+}
+
+bool segment_archive::contains( const tripoint &om_addr ) const
+{
+    return index.contains( om_addr );
+}
+
+std::optional<segment_archive::record> segment_archive::read( const tripoint &om_addr ) const
+{
+    const auto iter = index.find( om_addr );
+    if( iter == index.end() ) {
+        return std::nullopt;
+    }
+    record result;
+    result.om_addr = om_addr;
+    result.format = iter->second.format;
+    result.data.resize( iter->second.length );
+    const bool ok = read_from_file( path, [&]( std::istream & fin ) {
+        fin.seekg( iter->second.offset + record_header_size );
+        binary_in( fin ).read_raw( result.data.data(), result.data.size() );
+    } );
+    if( !ok ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::vector<tripoint> segment_archive::quads() const
+{
+    std::vector<tripoint> result;
+    result.reserve( index.size() );
+    for( const auto &elem : index ) {
+        result.push_back( elem.first );
+    }
+    return result;
+}
+
+void segment_archive::append( const std::vector<record> &records )
+{
+    if( damaged ) {
+        // Appending after garbage would make the new records unreadable
+        compact();
+    }
+    if( file_size == 0 ) {
+        write_to_file( path, [&]( std::ostream & fout ) {
+            binary_out out( fout );
+            out.write_raw( archive_magic, sizeof( archive_magic ) );
+            out.write( archive_version );
+            out.write<std::uint64_t>( header_fixed_size );
+            out.write<std::uint32_t>( 0 );
+        } );
+        file_size = header_fixed_size;
+    }
+
+    cata_ofstream fout = std::move( cata_ofstream().mode( static_cast<cata_ios_mode>(
+                                        static_cast<int>( cata_ios_mode::app ) |
+                                        static_cast<int>( cata_ios_mode::binary ) ) ).open( path ) );
+    if( !fout.is_open() ) {
+        throw std::runtime_error( "opening map segment archive failed" );
+    }
+    binary_out out( *fout );
+    std::uint64_t pos = file_size;
+    for( const record &rec : records ) {
+        write_record_header( out, rec.om_addr, rec.format, rec.data.size() );
+        out.write_raw( rec.data.data(), rec.data.size() );
+
+        const auto old = index.find( rec.om_addr );
+        if( old != index.end() ) {
+            live_bytes -= record_header_size + old->second.length;
+        }
+        entry &e = index[rec.om_addr];
+        e.offset = pos;
+        e.length = rec.data.size();
+        e.format = rec.format;
+        live_bytes += record_header_size + e.length;
+        pos += record_header_size + e.length;
+    }
+    fout.flush();
+    const bool failed = fout.fail();
+    fout.close();
+    if( failed ) {
+        // The partially written records are detected when the archive is opened again
+        throw std::runtime_error( "writing to map segment archive failed" );
+    }
+    file_size = pos;
+}
+
+bool segment_archive::needs_compaction() const
+{
+    return damaged || ( file_size > min_compaction_size && live_bytes * 2 < file_size );
+}
+
+void segment_archive::compact()
+{
+    std::vector<record> records;
+    records.reserve( index.size() );
+    for( const auto &pr : index ) {
+        std::optional<record> rec = read( pr.first );
+        if( rec ) {
+            records.push_back( std::move( *rec ) );
+        }
+    }
+
+    const std::uint64_t records_start = header_fixed_size + index_entry_size * records.size();
+    std::map<tripoint, entry> new_index;
+    std::uint64_t pos = records_start;
+    for( const record &rec : records ) {
+        entry &e = new_index[rec.om_addr];
+        e.offset = pos;
+        e.length = rec.data.size();
+        e.format = rec.format;
+        pos += record_header_size + e.length;
+    }
+
+    write_to_file( path, [&]( std::ostream & fout ) {
+        binary_out out( fout );
+        out.write_raw( archive_magic, sizeof( archive_magic ) );
+        out.write( archive_version );
+        out.write<std::uint64_t>( pos );
+        out.write<std::uint32_t>( new_index.size() );
+        for( const auto &pr : new_index ) {
+            out.write<std::int32_t>( pr.first.x );
+            out.write<std::int32_t>( pr.first.y );
+            out.write<std::int32_t>( pr.first.z );
+            out.write( pr.second.offset );
+            out.write( pr.second.length );
+            out.write( static_cast<std::uint8_t>( pr.second.format ) );
+        }
+        // std::map iteration order matches new_index, so offsets line up
+        for( const record &rec : records ) {
+            write_record_header( out, rec.om_addr, rec.format, rec.data.size() );
+            out.write_raw( rec.data.data(), rec.data.size() );
+        }
+    } );
+
+    index = std::move( new_index );
+    file_size = pos;
+    live_bytes = pos - records_start;
+    damaged = false;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef CATA_SRC_MAP_ARCHIVE_H
+#define CATA_SRC_MAP_ARCHIVE_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "point.h"
+
+/**
+ * Container file holding all map quads of one segment (32x32 overmap terrains on one z-level).
+ *
+ * Replaces the one-file-per-quad layout, which ends up with hundreds of thousands of small
+ * files on old worlds. Layout:
+ *
+ *   header: magic, version, index (quad address, offset, length, format of each record)
+ *   records: address, format, length, payload
+ *
+ * The header index covers the records written by the last compaction. New versions of
+ * quads are appended to the end of the file without touching the header, later records
+ * override earlier ones when the file is opened. @ref compact rewrites the file with only
+ * the latest version of each quad once enough of it is dead data.
+ *
+ * Appends don't go through the @ref save_journal, so an archive is not crash consistent
+ * with the rest of a save: a crash keeps the records appended before it and loses a torn
+ * last one.
+ *
+ * The payload of a record is exactly what a standalone quad file would contain.
+ */
+class segment_archive
+{
+    public:
+        enum class record_format : std::uint8_t {
+            json = 0,
+            binary = 1,
+        };
+
+        struct record {
+            tripoint om_addr;
+            record_format format = record_format::json;
+            std::string data;
+        };
+
+        explicit segment_archive( const std::string &path );
+
+        /** Whether the archive has a record for the quad at @p om_addr. */
+        bool contains( const tripoint &om_addr ) const;
+        /** Reads the latest record of the quad at @p om_addr, if there is one. */
+        std::optional<record> read( const tripoint &om_addr ) const;
+        /** Addresses of all quads stored in the archive. */
+        std::vector<tripoint> quads() const;
+        /** Appends records to the end of the file. Throws on I/O errors. */
+        void append( const std::vector<record> &records );
+
+        /** Whether enough of the file is outdated records to make @ref compact worth it. */
+        bool needs_compaction() const;
+        /** Rewrites the file with only the latest records and an up to date header index. */
+        void compact();
+
+    private:
+        struct entry {
+            std::uint64_t offset = 0;
+            std::uint32_t length = 0;
+            record_format format = record_format::json;
+        };
+
+        void load_index();
+
+        std::string path;
+        std::map<tripoint, entry> index;
+        std::uint64_t file_size = 0;
+        std::uint64_t live_bytes = 0;
+        // File ends in a partially written record
+        bool damaged = false;
+};
+
+#endif // CATA_SRC_MAP_ARCHIVE_H
@@ -96,18 +96,19 @@ static const trait_id trait_WEB_WALKER( "WEB_WALKER" );
 void map::create_burnproducts( std::vector < detached_ptr<item>> &out, const item &fuel,
                                const units::mass &burned_mass )
 {
-    std::vector<material_id> all_mats = fuel.made_of();
+    const std::vector<material_id> &all_mats = fuel.made_of();
     if( all_mats.empty() ) {
         return;
     }
     // Items that are multiple materials are assumed to be equal parts each.
     const units::mass by_weight = burned_mass / all_mats.size();
-    for( material_id &mat : all_mats ) {
-        for( auto &bp : mat->burn_products() ) {
-            itype_id id = bp.first;
+    const itype_id &fuel_id = fuel.typeId();
+    for( const material_id &mat : all_mats ) {
+        for( const std::pair<itype_id, float> &bp : mat->burn_products() ) {
+            const itype_id &id = bp.first;
             // Spawning the same item as the one that was just burned is pointless
             // and leads to infinite recursion.
-            if( fuel.typeId() == id ) {
+            if( fuel_id == id ) {
                 continue;
             }
             const float eff = bp.second;
@@ -255,16 +256,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p )
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk )
 {
-    map &here = get_map();
-    // TODO: fix point types
-    const oter_id &cur_om_ter =
-        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
-    const bool sheltered = g->is_sheltered( p );
-    const weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, cur_om_ter, p, winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -284,8 +275,24 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Bail out if we don't meet the required intensity, before looking up the wind,
+    // most of a gas cloud is too thin to spread.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    map &here = get_map();
+    // TODO: fix point types
+    const oter_id &cur_om_ter =
+        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
+    const bool sheltered = g->is_sheltered( p );
+    const weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, cur_om_ter, p, winddirection,
+                          sheltered );
+
+    // Or the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -302,8 +309,9 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
 
     auto neighs = get_neighbors( p );
     size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-    std::vector<size_t> spread;
-    std::vector<size_t> neighbour_vec;
+    // Indices into neighs, at most one of each
+    std::array<size_t, 8> spread;
+    size_t spread_count = 0;
     // Then, spread to a nearby point.
     // If not possible (or randomly), try to spread up
     // Wind direction will block the field spreading into the wind.
@@ -313,20 +321,22 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
          i = ( i + 1 ) % neighs.size(), count++ ) {
         const auto &neigh = neighs[i];
         if( gas_can_spread_to( cur, p, neigh.first ) ) {
-            spread.push_back( i );
+            spread[spread_count++] = i;
         }
     }
-    auto maptiles = get_wind_blockers( winddirection, p );
-    // Three map tiles that are facing the wind direction.
-    const maptile remove_tile = std::get<0>( maptiles );
-    const maptile remove_tile2 = std::get<1>( maptiles );
-    const maptile remove_tile3 = std::get<2>( maptiles );
-    if( !spread.empty() && ( !zlevels || one_in( spread.size() ) ) ) {
+    if( spread_count > 0 && ( !zlevels || one_in( spread_count ) ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
-            std::pair<tripoint, maptile> &n = neighs[ random_entry( spread ) ];
+        if( sheltered || windpower < 5 ) {
+            std::pair<tripoint, maptile> &n = neighs[spread[rng( 0, spread_count - 1 )]];
             gas_spread_to( cur, n.second, n.first );
         } else {
+            auto maptiles = get_wind_blockers( winddirection, p );
+            // Three map tiles that are facing the wind direction.
+            const maptile remove_tile = std::get<0>( maptiles );
+            const maptile remove_tile2 = std::get<1>( maptiles );
+            const maptile remove_tile3 = std::get<2>( maptiles );
+            std::array<size_t, 8> neighbour_vec;
+            size_t neighbour_count = 0;
             end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
             // Start at end_it + 1, then wrap around until all elements have been processed.
             for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
@@ -336,13 +346,13 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                 if( ( neigh.pos_.x != remove_tile.pos_.x && neigh.pos_.y != remove_tile.pos_.y ) ||
                     ( neigh.pos_.x != remove_tile2.pos_.x && neigh.pos_.y != remove_tile2.pos_.y ) ||
                     ( neigh.pos_.x != remove_tile3.pos_.x && neigh.pos_.y != remove_tile3.pos_.y ) ) {
-                    neighbour_vec.push_back( i );
+                    neighbour_vec[neighbour_count++] = i;
                 } else if( x_in_y( 1, std::max( 2, windpower ) ) ) {
-                    neighbour_vec.push_back( i );
+                    neighbour_vec[neighbour_count++] = i;
                 }
             }
-            if( !neighbour_vec.empty() ) {
-                std::pair<tripoint, maptile> &n = neighs[neighbour_vec[rng( 0, neighbour_vec.size() - 1 )]];
+            if( neighbour_count > 0 ) {
+                std::pair<tripoint, maptile> &n = neighs[neighbour_vec[rng( 0, neighbour_count - 1 )]];
                 gas_spread_to( cur, n.second, n.first );
             }
         }
@@ -400,6 +410,7 @@ If you need to insert a new field behavior per unit time add a case statement in
 void map::process_fields_in_submap( submap *const current_submap,
                                     const tripoint &submap )
 {
+    ZoneScoped;
     scent_block sblk( submap, g->scent );
 
     // Holds m.field_at(x,y).find_field(fd_some_field) type returns.
@@ -416,9 +427,15 @@ void map::process_fields_in_submap( submap *const current_submap,
     int &locy = map_tile.pos_.y;
     const point sm_offset( submap.x * SEEX, submap.y * SEEY );
 
-    // Loop through all tiles in this submap indicated by current_submap
+    // Loop through the tiles of this submap that may have fields, in the same order as
+    // all of them. Tiles they spread to get marked as they go, and are visited if later.
+    std::bitset<SEEX * SEEY> &field_tiles = current_submap->field_tiles;
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            const size_t tile_index = locx * SEEY + locy;
+            if( !field_tiles[tile_index] ) {
+                continue;
+            }
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->get_field( { locx, locy } );
@@ -426,6 +443,7 @@ void map::process_fields_in_submap( submap *const current_submap,
             // when displayed_field_type == fd_null it means that `curfield` has no fields inside
             // avoids instantiating (relatively) expensive map iterator
             if( !curfield.displayed_field_type() ) {
+                field_tiles.reset( tile_index );
                 continue;
             }
 
@@ -1,11 +1,17 @@
 #include "map_memory.h"
 
+#include <algorithm>
+#include <deque>
+#include <tuple>
+
+#include "background_saver.h"
 #include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
 #include "debug.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
 #include "game.h"
+#include "hash_utils.h"
 #include "line.h"
 #include "translations.h"
 #include "map.h"
@@ -44,8 +50,75 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+
+/**
+ * All distinct memorized tiles. Only ever grows, but there is just one entry per
+ * tileset id, subtile and rotation actually seen, which is a tiny number
+ * compared to the amount of memorized tiles.
+ */
+struct tile_palette {
+    // Deque so references handed out by lookup stay valid
+    std::deque<memorized_terrain_tile> tiles;
+    std::unordered_map<std::tuple<std::string, int, int>, mm_submap::tile_index, cata::tuple_hash>
+    indices;
+
+    tile_palette() {
+        // Can't use mm_submap::default_tile, it may not be initialized yet
+        tiles.push_back( memorized_terrain_tile{ "", 0, 0 } );
+        indices.emplace( std::make_tuple( std::string(), 0, 0 ), 0 );
+    }
+};
+
+tile_palette &get_tile_palette()
+{
+    static tile_palette palette;
+    return palette;
+}
+
+} // namespace
+
 mm_submap::mm_submap() = default;
 
+mm_submap::tile_index mm_submap::intern_tile( const memorized_terrain_tile &tile )
+{
+    tile_palette &palette = get_tile_palette();
+    const auto inserted = palette.indices.emplace( std::make_tuple( tile.tile, tile.subtile,
+                          tile.rotation ), palette.tiles.size() );
+    if( inserted.second ) {
+        palette.tiles.push_back( tile );
+    }
+    return inserted.first->second;
+}
+
+const memorized_terrain_tile &mm_submap::lookup_tile( tile_index idx )
+{
+    return get_tile_palette().tiles[idx];
+}
+
+void mm_submap::shrink()
+{
+    if( !tiles.empty() && std::all_of( tiles.begin(), tiles.end(), [&]( tile_index idx ) {
+    return idx == tiles.front();
+    } ) ) {
+        uniform_tile = tiles.front();
+        tiles = std::vector<tile_index>();
+    }
+    if( !symbols.empty() && std::all_of( symbols.begin(), symbols.end(), [&]( int sym ) {
+    return sym == symbols.front();
+    } ) ) {
+        uniform_symbol = symbols.front();
+        symbols = std::vector<int>();
+    }
+}
+
+std::size_t mm_submap::memory_usage() const
+{
+    return sizeof( mm_submap ) + tiles.capacity() * sizeof( tile_index ) +
+           symbols.capacity() * sizeof( int );
+}
+
 mm_region::mm_region() : submaps {{ nullptr }} {}
 
 bool mm_region::is_empty() const
@@ -60,6 +133,18 @@ bool mm_region::is_empty() const
     return true;
 }
 
+bool mm_region::is_dirty() const
+{
+    for( const auto &itt : submaps ) {
+        for( const shared_ptr_fast<mm_submap> &it : itt ) {
+            if( it->is_dirty() ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 map_memory::coord_pair::coord_pair( const tripoint &p ) : loc( p.xy() )
 {
     sm = tripoint( ms_to_sm_remain( loc.x, loc.y ), p.z );
@@ -97,7 +182,11 @@ void map_memory::memorize_tile( const tripoint &pos, const std::string &ter,
 {
     coord_pair p( pos );
     mm_submap &sm = get_submap( p.sm );
-    sm.set_tile( p.loc, memorized_terrain_tile{ ter, subtile, rotation } );
+    const memorized_terrain_tile tile{ ter, subtile, rotation };
+    // Most of the time the memory is just refreshed with what it already holds
+    if( sm.tile( p.loc ) != tile ) {
+        sm.set_tile( p.loc, tile );
+    }
 }
 
 int map_memory::get_symbol( const tripoint &pos )
@@ -122,6 +211,17 @@ void map_memory::clear_memorized_tile( const tripoint &pos )
     sm.set_tile( p.loc, mm_submap::default_tile );
 }
 
+std::size_t map_memory::memory_usage() const
+{
+    std::size_t bytes = sizeof( map_memory ) + cached.capacity() * sizeof( cached[0] );
+    for( const auto &entry : submaps ) {
+        if( entry.second ) {
+            bytes += entry.second->memory_usage();
+        }
+    }
+    return bytes;
+}
+
 bool map_memory::prepare_region( const tripoint &p1, const tripoint &p2 )
 {
     assert( p1.z == p2.z );
@@ -243,6 +343,10 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint &sm_pos )
         // Old saves don't have [plname].mm1 folder
         return nullptr;
     }
+    if( get_background_saver().is_pending( path ) ) {
+        // Dropped after a background save that hasn't reached the disk yet
+        get_background_saver().wait();
+    }
 
     mm_region mmr;
     const auto loader = [&]( JsonIn & jsin ) {
@@ -271,6 +375,8 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint &sm_pos )
             if( pos == sm_pos ) {
                 ret = sm;
             }
+            // Reading the region file filled it through the setters
+            sm->dirty = false;
 
             temp_remove_open_air( mmr.submaps[x][y] );
 
@@ -330,7 +436,7 @@ void map_memory::load( const tripoint &pos )
     dbg( DL::Info ) << "[LOAD] Done.";
 }
 
-bool map_memory::save( const tripoint &pos )
+bool map_memory::save( const tripoint &pos, const bool background )
 {
     tripoint sm_center = coord_pair( pos ).sm;
     const std::string dirname = find_mm_dir();
@@ -344,6 +450,8 @@ bool map_memory::save( const tripoint &pos )
     // we are certain that each region will be filled.
     std::map<tripoint, mm_region> regions;
     for( auto &it : submaps ) {
+        // Cheap compared to writing the file, and keeps the kept submaps small
+        it.second->shrink();
         const reg_coord_pair p( it.first );
         regions[p.reg].submaps[p.sm_loc.x][p.sm_loc.y] = it.second;
     }
@@ -360,22 +468,29 @@ bool map_memory::save( const tripoint &pos )
     for( auto &it : regions ) {
         const tripoint &regp = it.first;
         mm_region &reg = it.second;
-        if( !reg.is_empty() ) {
+        // Regions read back from disk and not changed since are already there as they are
+        if( !reg.is_empty() && reg.is_dirty() ) {
             const std::string path = find_region_path( dirname, regp );
-            const std::string descr = string_format(
-                                          _( "memory map region for (%d,%d,%d)" ),
-                                          regp.x, regp.y, regp.z
-                                      );
-
-            const auto writer = [&]( std::ostream & fout ) -> void {
-                fout << serialize_wrapper( [&]( JsonOut & jsout )
-                {
-                    reg.serialize( jsout );
-                } );
-            };
-
-            const bool res = write_to_file( path, writer, descr.c_str() );
-            result = result & res;
+            const std::string data = serialize_wrapper( [&]( JsonOut & jsout ) {
+                reg.serialize( jsout );
+            } );
+            if( background ) {
+                get_background_saver().write( path, data );
+            } else {
+                const std::string descr = string_format(
+                                              _( "memory map region for (%d,%d,%d)" ),
+                                              regp.x, regp.y, regp.z
+                                          );
+                const bool res = write_to_file( path, [&]( std::ostream & fout ) {
+                    fout << data;
+                }, descr.c_str() );
+                result = result & res;
+            }
+            for( auto &itt : reg.submaps ) {
+                for( shared_ptr_fast<mm_submap> &sm : itt ) {
+                    sm->dirty = false;
+                }
+            }
         }
         tripoint regp_sm = mmr_to_sm_copy( regp );
         half_open_rectangle<point> rect_reg(
@@ -2,8 +2,12 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -30,6 +34,11 @@ struct memorized_terrain_tile {
 struct mm_submap {
     public:
         friend class map_memory;
+        /**
+         * Memorized tiles are interned, submaps only hold indices into a shared palette.
+         * Index 0 is always @ref default_tile.
+         */
+        using tile_index = std::uint32_t;
         static const memorized_terrain_tile default_tile;
         static const int default_symbol;
 
@@ -37,29 +46,50 @@ struct mm_submap {
 
         /** Whether this mm_submap is empty. Empty submaps are skipped during saving. */
         bool is_empty() const {
-            return tiles.empty() && symbols.empty();
+            return tiles.empty() && symbols.empty() &&
+                   uniform_tile == 0 && uniform_symbol == default_symbol;
+        }
+
+        /** Whether this mm_submap changed since it was last loaded or saved. */
+        bool is_dirty() const {
+            return dirty;
         }
 
         const memorized_terrain_tile &tile( point p ) const {
+            return lookup_tile( tile_index_at( p ) );
+        }
+
+        tile_index tile_index_at( point p ) const {
             if( tiles.empty() ) {
-                return default_tile;
+                return uniform_tile;
             } else {
                 return tiles[p.y * SEEX + p.x];
             }
         }
 
         void set_tile( point p, const memorized_terrain_tile &value ) {
+            set_tile_index( p, intern_tile( value ) );
+        }
+
+        void set_tile_index( point p, tile_index value ) {
             if( tiles.empty() ) {
+                if( value == uniform_tile ) {
+                    return;
+                }
                 // call 'reserve' first to force allocation of exact size
                 tiles.reserve( SEEX * SEEY );
-                tiles.resize( SEEX * SEEY, default_tile );
+                tiles.resize( SEEX * SEEY, uniform_tile );
+            }
+            tile_index &tile = tiles[p.y * SEEX + p.x];
+            if( tile != value ) {
+                tile = value;
+                dirty = true;
             }
-            tiles[p.y * SEEX + p.x] = value;
         }
 
         int symbol( point p ) const {
             if( symbols.empty() ) {
-                return default_symbol;
+                return uniform_symbol;
             } else {
                 return symbols[p.y * SEEX + p.x];
             }
@@ -67,20 +97,44 @@ struct mm_submap {
 
         void set_symbol( point p, int value ) {
             if( symbols.empty() ) {
+                if( value == uniform_symbol ) {
+                    return;
+                }
                 // call 'reserve' first to force allocation of exact size
                 symbols.reserve( SEEX * SEEY );
-                symbols.resize( SEEX * SEEY, default_symbol );
+                symbols.resize( SEEX * SEEY, uniform_symbol );
+            }
+            int &symbol = symbols[p.y * SEEX + p.x];
+            if( symbol != value ) {
+                symbol = value;
+                dirty = true;
             }
-            symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( JsonIn &jsin );
+        /** Drop the per-tile arrays of parts where all tiles are the same. */
+        void shrink();
+        /** Bytes taken by the submap and its per-tile arrays. */
+        std::size_t memory_usage() const;
+
+        /** Get the index of @p tile in the shared palette, adding it if needed. */
+        static tile_index intern_tile( const memorized_terrain_tile &tile );
+        static const memorized_terrain_tile &lookup_tile( tile_index idx );
+
+        /** Write runs of tiles, using @p palette to map interned tiles to indices in the file. */
+        void serialize( JsonOut &jsout, const std::unordered_map<tile_index, int> &palette ) const;
+        /** Read runs of tiles, @p palette maps indices in the file to interned tiles. */
+        void deserialize( JsonIn &jsin, const std::vector<tile_index> &palette );
+        /** Read the format used before palettes were introduced. */
+        void deserialize_legacy( JsonIn &jsin );
 
     private:
-        std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
+        std::vector<tile_index> tiles; // holds either 0 or SEEX*SEEY elements
         std::vector<int> symbols; // holds either 0 or SEEX*SEEY elements
+        // Value of all tiles / symbols while the arrays above are empty
+        tile_index uniform_tile = 0;
+        int uniform_symbol = 0;
         bool valid = true;
+        bool dirty = false;
 };
 
 /**
@@ -94,6 +148,8 @@ struct mm_region {
     mm_region();
 
     bool is_empty() const;
+    /** Whether any of the submaps differs from the region file. */
+    bool is_dirty() const;
 
     void serialize( JsonOut &jsout ) const;
     void deserialize( JsonIn &jsin );
@@ -129,8 +185,11 @@ class map_memory
         /** Load legacy memory file. TODO: remove after 0.F (or whatever BN will have instead). */
         void load_legacy( JsonIn &jsin );
 
-        /** Save memorized submaps to disk, drop ones far from given global map square pos. */
-        bool save( const tripoint &pos );
+        /**
+         * Save changed memorized submaps to disk, drop ones far from given global map square pos.
+         * With @p background the region files are queued on the background saver.
+         */
+        bool save( const tripoint &pos, bool background = false );
 
         /**
          * Prepares map memory for optimized rendering and/or memorization of given region.
@@ -178,6 +237,9 @@ class map_memory
          */
         void clear_memorized_tile( const tripoint &pos );
 
+        /** Approximate bytes taken by the memorized submaps, the shared tile palette left out. */
+        std::size_t memory_usage() const;
+
     private:
         std::map<tripoint, shared_ptr_fast<mm_submap>> submaps;
 
@@ -3,23 +3,30 @@
 #include <algorithm>
 #include <exception>
 #include <functional>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <utility>
 #include <vector>
 
+#include "background_saver.h"
+#include "binary_io.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
 #include "distribution_grid.h"
+#include "file_prefetcher.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
 #include "game.h"
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
+#include "profile.h"
+#include "simulation_area.h"
 #include "string_formatter.h"
 #include "submap.h"
 #include "translations.h"
@@ -30,6 +37,38 @@ static std::string find_quad_path( const std::string &dirname, const tripoint &o
     return string_format( "%s/%d.%d.%d.map", dirname, om_addr.x, om_addr.y, om_addr.z );
 }
 
+static std::string find_binary_quad_path( const std::string &dirname, const tripoint &om_addr )
+{
+    return string_format( "%s/%d.%d.%d.mapb", dirname, om_addr.x, om_addr.y, om_addr.z );
+}
+
+// Binary quad files start with this magic followed by the binary format version.
+static constexpr char binary_quad_magic[4] = { 'C', 'B', 'S', 'M' };
+static constexpr std::uint32_t binary_quad_version = 1;
+
+static bool use_binary_storage()
+{
+    return get_option<std::string>( "MAP_STORAGE_FORMAT" ) == "binary";
+}
+
+static bool use_segment_archives()
+{
+    return get_option<std::string>( "MAP_STORAGE_LAYOUT" ) == "segments";
+}
+
+// Either write the file right away or hand a serialized snapshot to the background saver.
+static void write_quad_file( const std::string &path, bool background,
+                             const std::function<void( std::ostream & )> &writer )
+{
+    if( !background ) {
+        write_to_file( path, writer );
+        return;
+    }
+    std::ostringstream buffer;
+    writer( buffer );
+    get_background_saver().write( path, buffer.str() );
+}
+
 static std::string find_dirname( const tripoint &om_addr )
 {
     const tripoint segment_addr = omt_to_seg_copy( om_addr );
@@ -37,14 +76,27 @@ static std::string find_dirname( const tripoint &om_addr )
                           segment_addr.y, segment_addr.z );
 }
 
+static std::string find_archive_path( const tripoint &segment_addr )
+{
+    return string_format( "%s/maps/%d.%d.%d.seg", g->get_world_base_save_path(), segment_addr.x,
+                          segment_addr.y, segment_addr.z );
+}
+
 mapbuffer MAPBUFFER;
 
-mapbuffer::mapbuffer() = default;
+mapbuffer::mapbuffer() : prefetcher( std::make_unique<file_prefetcher>() ) {}
 mapbuffer::~mapbuffer() = default;
 
 void mapbuffer::clear()
 {
+    // Submaps will be read back from disk from now on
+    get_background_saver().wait();
+    prefetcher->clear();
     submaps.clear();
+    quad_lru.clear();
+    quad_lru_pos.clear();
+    archives.clear();
+    archive_batch.clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
@@ -54,6 +106,7 @@ bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
     }
 
     submaps[p] = std::move( sm );
+    touch_quad( sm_to_omt_copy( p ) );
 
     return true;
 }
@@ -78,6 +131,23 @@ void mapbuffer::remove_submap( tripoint addr )
         return;
     }
     submaps.erase( m_target );
+    // Quads are dropped as a whole, a leftover member is tracked again once it's used
+    const auto lru_iter = quad_lru_pos.find( sm_to_omt_copy( addr ) );
+    if( lru_iter != quad_lru_pos.end() ) {
+        quad_lru.erase( lru_iter->second );
+        quad_lru_pos.erase( lru_iter );
+    }
+}
+
+void mapbuffer::touch_quad( const tripoint &om_addr )
+{
+    const auto iter = quad_lru_pos.find( om_addr );
+    if( iter == quad_lru_pos.end() ) {
+        quad_lru.push_front( om_addr );
+        quad_lru_pos.emplace( om_addr, quad_lru.begin() );
+    } else if( iter->second != quad_lru.begin() ) {
+        quad_lru.splice( quad_lru.begin(), quad_lru, iter->second );
+    }
 }
 
 submap *mapbuffer::lookup_submap( const tripoint &p )
@@ -92,11 +162,42 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
+    touch_quad( sm_to_omt_copy( p ) );
     return iter->second.get();
 }
 
-void mapbuffer::save( bool delete_after_save )
+bool mapbuffer::prefetch( const tripoint &p )
+{
+    if( submaps.contains( p ) ) {
+        return true;
+    }
+    const tripoint om_addr = sm_to_omt_copy( p );
+    const segment_archive &archive = get_archive( omt_to_seg_copy( om_addr ) );
+    // Archived quads are a single read from an already opened file, not worth doing in the background
+    if( use_segment_archives() && archive.contains( om_addr ) ) {
+        return true;
+    }
+    const std::string dirname = find_dirname( om_addr );
+    for( const std::string &path : {
+             find_binary_quad_path( dirname, om_addr ), find_quad_path( dirname, om_addr )
+         } ) {
+        if( prefetcher->is_requested( path ) ) {
+            return true;
+        }
+        if( file_exist( path ) ) {
+            // Files still being saved are read normally once the save is done
+            if( !get_background_saver().is_pending( path ) ) {
+                prefetcher->request( path );
+            }
+            return true;
+        }
+    }
+    return archive.contains( om_addr );
+}
+
+void mapbuffer::save( bool delete_after_save, bool background )
 {
+    ZoneScoped;
     assure_dir_exist( g->get_world_base_save_path() + "/maps" );
 
     int num_saved_submaps = 0;
@@ -105,6 +206,11 @@ void mapbuffer::save( bool delete_after_save )
     map &here = get_map();
     const tripoint map_origin = sm_to_omt_copy( here.get_abs_sub() );
     const bool map_has_zlevels = g != nullptr && here.has_zlevels();
+    const simulation_areas &areas = get_simulation_areas();
+    save_options opts;
+    opts.binary = use_binary_storage();
+    opts.background = background;
+    opts.archive = use_segment_archives();
 
     static_popup popup;
 
@@ -139,28 +245,117 @@ void mapbuffer::save( bool delete_after_save )
         // We're breaking them into subdirectories so there aren't too many files per directory.
         // Might want to make a set for this one too so it's only checked once per save().
         const std::string dirname = find_dirname( om_addr );
-        const std::string quad_path = find_quad_path( dirname, om_addr );
+        const std::string quad_path = opts.binary ? find_binary_quad_path( dirname, om_addr ) :
+                                      find_quad_path( dirname, om_addr );
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
+        const bool outside_map = om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
+                                 om_addr.x > map_origin.x + HALF_MAPSIZE ||
+                                 om_addr.y > map_origin.y + HALF_MAPSIZE;
+        save_quad( dirname, quad_path, om_addr, submaps_to_delete, opts,
                    delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+                   ( outside_map && !areas.contains( tripoint_abs_omt( om_addr ) ) ) );
         num_saved_submaps += 4;
     }
+    flush_archive_batch();
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
 
-    get_distribution_grid_tracker().on_saved();
+    if( background ) {
+        get_background_saver().on_written( []() {
+            get_distribution_grid_tracker().on_saved();
+        } );
+    } else {
+        get_distribution_grid_tracker().on_saved();
+    }
+}
+
+int mapbuffer::evict_least_recently_used( std::size_t max_submaps )
+{
+    if( submaps.size() <= max_submaps ) {
+        return 0;
+    }
+
+    map &here = get_map();
+    const tripoint map_origin = sm_to_omt_copy( here.get_abs_sub() );
+    const distribution_grid_tracker &grid_tracker = get_distribution_grid_tracker();
+    const simulation_areas &areas = get_simulation_areas();
+    save_options opts;
+    opts.binary = use_binary_storage();
+    // Queued behind any pending autosave so an older snapshot can't overwrite the evicted quad
+    opts.background = true;
+    opts.archive = use_segment_archives();
+
+    const auto must_stay = [&]( const tripoint & om_addr ) {
+        // Same area that mapbuffer::save keeps around the map
+        if( om_addr.x >= map_origin.x && om_addr.y >= map_origin.y &&
+            om_addr.x <= map_origin.x + HALF_MAPSIZE && om_addr.y <= map_origin.y + HALF_MAPSIZE ) {
+            return true;
+        }
+        if( areas.contains( tripoint_abs_omt( om_addr ) ) ) {
+            return true;
+        }
+        const tripoint sm_addr = omt_to_sm_copy( om_addr );
+        for( const point &offset : {
+                 point_zero, point_south, point_east, point_south_east
+             } ) {
+            if( grid_tracker.uses_submap( tripoint_abs_sm( sm_addr + offset ) ) ) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::list<tripoint> submaps_to_delete;
+    std::size_t remaining = submaps.size();
+    for( auto iter = quad_lru.rbegin(); iter != quad_lru.rend() && remaining > max_submaps; ++iter ) {
+        const tripoint &om_addr = *iter;
+        if( must_stay( om_addr ) ) {
+            continue;
+        }
+        const std::size_t queued = submaps_to_delete.size();
+        const std::string dirname = find_dirname( om_addr );
+        const std::string quad_path = opts.binary ? find_binary_quad_path( dirname, om_addr ) :
+                                      find_quad_path( dirname, om_addr );
+        save_quad( dirname, quad_path, om_addr, submaps_to_delete, opts, true );
+        remaining -= submaps_to_delete.size() - queued;
+    }
+    flush_archive_batch();
+    for( const tripoint &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    return submaps_to_delete.size();
+}
+
+std::size_t mapbuffer::memory_usage() const
+{
+    std::size_t bytes = 0;
+    for( const auto &entry : submaps ) {
+        if( entry.second != nullptr ) {
+            bytes += entry.second->memory_usage();
+        }
+    }
+    return bytes;
+}
+
+void mapbuffer::enforce_memory_budget()
+{
+    const int budget_mb = get_option<int>( "MAP_MEMORY_BUDGET" );
+    if( budget_mb <= 0 ) {
+        return;
+    }
+    // Only the fixed part of a submap is counted, items and vehicles vary too much to estimate cheaply
+    const std::size_t max_submaps = static_cast<std::size_t>( budget_mb ) * 1024 * 1024 /
+                                    sizeof( submap );
+    evict_least_recently_used( max_submaps );
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           const save_options &opts, bool delete_after_save )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -170,6 +365,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     offsets.push_back( point_south_east );
 
     bool all_uniform = true;
+    bool any_modified = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
@@ -179,10 +375,15 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && sm->is_modified() ) {
+            any_modified = true;
+        }
     }
 
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
+    // Uniform quads will be regenerated faster than they would be re-read,
+    // unmodified ones are identical to what is already on disk.
+    if( all_uniform || !any_modified ) {
+        // Nothing to save
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
                 if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
@@ -198,9 +399,25 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    if( !opts.archive ) {
+        // Don't create the directory if it would be empty
+        assure_dir_exist( dirname );
+
+        // A quad is stored in exactly one format, drop the copy in the other format
+        // so a stale file can't shadow the new one after switching formats.
+        const std::string other_path = opts.binary ? find_quad_path( dirname, om_addr ) :
+                                       find_binary_quad_path( dirname, om_addr );
+        if( file_exist( other_path ) ) {
+            remove_file( other_path );
+        }
+    }
+
+    if( opts.binary ) {
+        save_quad_binary( filename, om_addr, submap_addrs, submaps_to_delete, opts, delete_after_save );
+        return;
+    }
+
+    write_quad( filename, om_addr, opts, [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
@@ -226,6 +443,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             jsout.end_array();
 
             sm->store( jsout );
+            sm->clear_modified();
 
             jsout.end_object();
 
@@ -238,13 +456,214 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     } );
 }
 
+void mapbuffer::save_quad_binary( const std::string &filename, const tripoint &om_addr,
+                                  const std::vector<tripoint> &submap_addrs,
+                                  std::list<tripoint> &submaps_to_delete, const save_options &opts,
+                                  bool delete_after_save )
+{
+    std::vector<std::pair<tripoint, const submap *>> to_write;
+    for( const tripoint &submap_addr : submap_addrs ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr ) {
+            to_write.emplace_back( submap_addr, iter->second.get() );
+        }
+    }
+
+    write_quad( filename, om_addr, opts, [&]( std::ostream & fout ) {
+        binary_out out( fout );
+        out.write_raw( binary_quad_magic, sizeof( binary_quad_magic ) );
+        out.write( binary_quad_version );
+        out.write<std::uint8_t>( to_write.size() );
+        for( const auto &entry : to_write ) {
+            out.write<std::int32_t>( savegame_version );
+            out.write<std::int32_t>( entry.first.x );
+            out.write<std::int32_t>( entry.first.y );
+            out.write<std::int32_t>( entry.first.z );
+            entry.second->store_binary( out );
+        }
+    } );
+    for( const auto &entry : to_write ) {
+        submaps.at( entry.first )->clear_modified();
+    }
+
+    if( delete_after_save ) {
+        for( const auto &entry : to_write ) {
+            submaps_to_delete.push_back( entry.first );
+        }
+    }
+}
+
+void mapbuffer::write_quad( const std::string &filename, const tripoint &om_addr,
+                            const save_options &opts, const std::function<void( std::ostream & )> &writer )
+{
+    if( !opts.archive ) {
+        write_quad_file( filename, opts.background, writer );
+        return;
+    }
+    std::ostringstream buffer;
+    writer( buffer );
+    segment_archive::record rec;
+    rec.om_addr = om_addr;
+    rec.format = opts.binary ? segment_archive::record_format::binary :
+                 segment_archive::record_format::json;
+    rec.data = buffer.str();
+    archive_batch[omt_to_seg_copy( om_addr )].push_back( std::move( rec ) );
+}
+
+segment_archive &mapbuffer::get_archive( const tripoint &segment_addr )
+{
+    std::unique_ptr<segment_archive> &archive = archives[segment_addr];
+    if( !archive ) {
+        archive = std::make_unique<segment_archive>( find_archive_path( segment_addr ) );
+    }
+    return *archive;
+}
+
+void mapbuffer::flush_archive_batch()
+{
+    // Appending is a single sequential write per segment, so unlike loose files
+    // it is done right away even when saving in the background.
+    // It's not journaled either, so archives are not crash consistent with the rest of the
+    // save: after a crash they keep what was appended before it, and drop a torn last record
+    // when they are opened.
+    for( auto &elem : archive_batch ) {
+        segment_archive &archive = get_archive( elem.first );
+        archive.append( elem.second );
+        if( archive.needs_compaction() ) {
+            archive.compact();
+        }
+        // The quads have been migrated, loose files would only waste space now
+        for( const segment_archive::record &rec : elem.second ) {
+            const std::string dirname = find_dirname( rec.om_addr );
+            for( const std::string &path : {
+                     find_quad_path( dirname, rec.om_addr ), find_binary_quad_path( dirname, rec.om_addr )
+                 } ) {
+                if( file_exist( path ) ) {
+                    remove_file( path );
+                }
+            }
+        }
+    }
+    archive_batch.clear();
+}
+
+void mapbuffer::deserialize_record( const segment_archive::record &rec )
+{
+    std::istringstream fin( rec.data );
+    if( rec.format == segment_archive::record_format::binary ) {
+        deserialize_binary( fin );
+    } else {
+        JsonIn jsin( fin );
+        deserialize( jsin );
+    }
+}
+
+void mapbuffer::deserialize_binary( std::istream &fin )
+{
+    binary_in in( fin );
+    char magic[sizeof( binary_quad_magic )];
+    in.read_raw( magic, sizeof( magic ) );
+    if( !std::equal( std::begin( magic ), std::end( magic ), std::begin( binary_quad_magic ) ) ) {
+        throw binary_error( "not a binary submap file" );
+    }
+    const std::uint32_t format_version = in.read<std::uint32_t>();
+    if( format_version > binary_quad_version ) {
+        throw binary_error( string_format( "binary submap format %d is newer than supported %d",
+                                           format_version, binary_quad_version ) );
+    }
+    const int num_submaps = in.read<std::uint8_t>();
+    for( int n = 0; n < num_submaps; ++n ) {
+        const int version = in.read<std::int32_t>();
+        tripoint submap_coordinates;
+        submap_coordinates.x = in.read<std::int32_t>();
+        submap_coordinates.y = in.read<std::int32_t>();
+        submap_coordinates.z = in.read<std::int32_t>();
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( submap_coordinates ) );
+        sm->load_binary( in, version, multiply_xy( submap_coordinates, 12 ) );
+        // Loading goes through the mutators, but it matches the file
+        sm->clear_modified();
+        if( !add_submap( submap_coordinates, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
+                      submap_coordinates.z );
+        }
+    }
+}
+
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
+    ZoneScoped;
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
     const std::string dirname = find_dirname( om_addr );
+
+    const bool archive_layout = use_segment_archives();
+    segment_archive &archive = get_archive( omt_to_seg_copy( om_addr ) );
+    // Loose files are only left behind when switching layouts, whatever the world
+    // currently uses was written last and wins.
+    if( archive_layout || ( !file_exist( find_binary_quad_path( dirname, om_addr ) ) &&
+                            !file_exist( find_quad_path( dirname, om_addr ) ) ) ) {
+        if( const std::optional<segment_archive::record> rec = archive.read( om_addr ) ) {
+            deserialize_record( *rec );
+            if( !submaps.contains( p ) ) {
+                debugmsg( "segment archive did not contain the expected submap %d,%d,%d", p.x, p.y, p.z );
+                return nullptr;
+            }
+            return submaps[ p ].get();
+        }
+    }
+
+    submap *result = unserialize_loose_submaps( p );
+    if( result != nullptr && archive_layout ) {
+        // Move the quad into the archive on the next save
+        for( int x = 0; x < 2; ++x ) {
+            for( int y = 0; y < 2; ++y ) {
+                const auto iter = submaps.find( omt_to_sm_copy( om_addr ) + tripoint( x, y, 0 ) );
+                if( iter != submaps.end() && iter->second != nullptr ) {
+                    iter->second->mark_modified();
+                }
+            }
+        }
+    }
+    return result;
+}
+
+submap *mapbuffer::unserialize_loose_submaps( const tripoint &p )
+{
+    const tripoint om_addr = sm_to_omt_copy( p );
+    const std::string dirname = find_dirname( om_addr );
+
+    background_saver &saver = get_background_saver();
+    if( saver.busy() && ( saver.is_pending( find_binary_quad_path( dirname, om_addr ) ) ||
+                          saver.is_pending( find_quad_path( dirname, om_addr ) ) ) ) {
+        // The file on disk is outdated until the background save catches up.
+        saver.wait();
+    }
+
+    // Quads may exist in either format regardless of the current world setting,
+    // they get converted to the selected one the next time they are saved.
+    const std::string binary_path = find_binary_quad_path( dirname, om_addr );
+    const std::optional<std::string> prefetched_binary = prefetcher->take( binary_path );
+    if( prefetched_binary || file_exist( binary_path ) ) {
+        if( prefetched_binary ) {
+            std::istringstream fin( *prefetched_binary );
+            deserialize_binary( fin );
+        } else {
+            using namespace std::placeholders;
+            if( !read_from_file_optional( binary_path, std::bind( &mapbuffer::deserialize_binary, this,
+                                          _1 ) ) ) {
+                return nullptr;
+            }
+        }
+        if( !submaps.contains( p ) ) {
+            debugmsg( "file %s did not contain the expected submap %d,%d,%d",
+                      binary_path, p.x, p.y, p.z );
+            return nullptr;
+        }
+        return submaps[ p ].get();
+    }
+
     std::string quad_path = find_quad_path( dirname, om_addr );
 
     if( !file_exist( quad_path ) ) {
@@ -259,10 +678,16 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         }
     }
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
-        // If it doesn't exist, trigger generating it.
-        return nullptr;
+    if( const std::optional<std::string> prefetched = prefetcher->take( quad_path ) ) {
+        std::istringstream fin( *prefetched );
+        JsonIn jsin( fin, quad_path );
+        deserialize( jsin );
+    } else {
+        using namespace std::placeholders;
+        if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+            // If it doesn't exist, trigger generating it.
+            return nullptr;
+        }
     }
     if( !submaps.contains( p ) ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
@@ -301,6 +726,10 @@ void mapbuffer::deserialize( JsonIn &jsin )
             }
         }
 
+        if( sm ) {
+            // Loading goes through the mutators, but it matches the file
+            sm->clear_modified();
+        }
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
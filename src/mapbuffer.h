@@ -2,14 +2,21 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "coordinates.h"
+#include "map_archive.h"
 #include "point.h"
 
+class file_prefetcher;
 class submap;
 class JsonIn;
 
@@ -25,8 +32,10 @@ class mapbuffer
         /** Store all submaps in this instance into savefiles.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * @param background If true, the files are written by @ref background_saver
+         * and the distribution grid hook runs once they are on disk.
          **/
-        void save( bool delete_after_save = false );
+        void save( bool delete_after_save = false, bool background = false );
 
         /** Delete all buffered submaps. **/
         void clear();
@@ -58,6 +67,23 @@ class mapbuffer
             return lookup_submap( p.raw() );
         }
 
+        /**
+         * Start reading the quad containing submap @p p from disk in the background,
+         * so a later @ref lookup_submap doesn't have to wait for the disk.
+         * @return false if the submap is neither loaded nor saved and has to be generated.
+         */
+        bool prefetch( const tripoint &p );
+
+        /**
+         * Write back and drop the least recently used quads until at most @p max_submaps
+         * submaps are buffered. Quads in the reality bubble or covered by a distribution
+         * grid with active tiles are never dropped.
+         * @return Number of submaps dropped.
+         */
+        int evict_least_recently_used( std::size_t max_submaps );
+        /** Evict quads until the buffered submaps fit into the MAP_MEMORY_BUDGET option. */
+        void enforce_memory_budget();
+
     private:
         using submap_map_t = std::map<tripoint, std::unique_ptr<submap>>;
 
@@ -72,17 +98,52 @@ class mapbuffer
         bool is_submap_loaded( const tripoint &p ) const {
             return submaps.contains( p );
         }
+        /** Number of submaps buffered. */
+        std::size_t size() const {
+            return submaps.size();
+        }
+        /** Approximate bytes taken by the buffered submaps, see @ref submap::memory_usage. */
+        std::size_t memory_usage() const;
 
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
+        submap *unserialize_loose_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
+        void deserialize_binary( std::istream &fin );
+        void deserialize_record( const segment_archive::record &rec );
+
+        struct save_options {
+            bool binary = false;
+            bool background = false;
+            // Collect quads in @ref archive_batch instead of writing them to their own files
+            bool archive = false;
+        };
+
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+                        const save_options &opts, bool delete_after_save );
+        void save_quad_binary( const std::string &filename, const tripoint &om_addr,
+                               const std::vector<tripoint> &submap_addrs,
+                               std::list<tripoint> &submaps_to_delete, const save_options &opts,
+                               bool delete_after_save );
+        void write_quad( const std::string &filename, const tripoint &om_addr,
+                         const save_options &opts, const std::function<void( std::ostream & )> &writer );
+        void flush_archive_batch();
+        segment_archive &get_archive( const tripoint &segment_addr );
+        void touch_quad( const tripoint &om_addr );
+
         submap_map_t submaps;
+        // Opened archives by segment address, the index is kept in memory
+        std::map<tripoint, std::unique_ptr<segment_archive>> archives;
+        // Serialized quads waiting to be appended to their segment archive
+        std::map<tripoint, std::vector<segment_archive::record>> archive_batch;
+        std::unique_ptr<file_prefetcher> prefetcher;
+        // Buffered quads by last access, most recent first
+        std::list<tripoint> quad_lru;
+        std::unordered_map<tripoint, std::list<tripoint>::iterator> quad_lru_pos;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -45,6 +45,7 @@
 #include "map_iterator.h"
 #include "mapdata.h"
 #include "mapgen_functions.h"
+#include "mapgen_stats.h"
 #include "mapgendata.h"
 #include "mapgenformat.h"
 #include "memory_fast.h"
@@ -60,6 +61,7 @@
 #include "player.h"
 #include "point.h"
 #include "point_float.h"
+#include "profile.h"
 #include "rng.h"
 #include "string_formatter.h"
 #include "string_id.h"
@@ -109,6 +111,7 @@ static void science_room( map *m, const point &p1, const point &p2, int z, int r
 // x%2 and y%2 must be 0!
 void map::generate( const tripoint &p, const time_point &when )
 {
+    ZoneScoped;
     dbg( DL::Info ) << "map::generate( g[" << g.get() << "], p[" << p <<
                     "], when[" << to_string( when ) << "] )";
 
@@ -253,8 +256,9 @@ class mapgen_basic_container
          * the list of mapgen functions is effectively empty.
          * @p hardcoded_weight Weight for an additional entry. If that entry is chosen,
          * false is returned. If unsure, just use 0 for it.
+         * @p key The id the functions are registered under, for @ref mapgen_stats.
          */
-        bool generate( mapgendata &dat, const int hardcoded_weight ) const {
+        bool generate( mapgendata &dat, const std::string &key, const int hardcoded_weight ) const {
             if( hardcoded_weight > 0 &&
                 rng( 1, weights_.get_weight() + hardcoded_weight ) > weights_.get_weight() ) {
                 return false;
@@ -264,6 +268,10 @@ class mapgen_basic_container
                 return false;
             }
             assert( *ptr );
+            const bool builtin = dynamic_cast<const mapgen_function_builtin *>( ptr->get() ) != nullptr;
+            const mapgen_stats::timer timer( builtin ? mapgen_kind::builtin : mapgen_kind::json, key );
+            ZoneScopedN( "mapgen_function" );
+            ZoneText( key.c_str(), key.size() );
             ( *ptr )->generate( dat );
             return true;
         }
@@ -378,7 +386,7 @@ class mapgen_factory
             if( iter == mapgens_.end() ) {
                 return false;
             }
-            return iter->second.generate( dat, hardcoded_weight );
+            return iter->second.generate( dat, iter->first, hardcoded_weight );
         }
 
         mapgen_parameters get_map_special_params( const std::string &key ) const {
@@ -1294,6 +1302,14 @@ class mapgen_value
             return is_null_;
         }
 
+        /** The value if it is the same for every instance of the mapgen */
+        std::optional<Id> constant() const {
+            if( const id_source *s = dynamic_cast<const id_source *>( source_.get() ) ) {
+                return s->id;
+            }
+            return std::nullopt;
+        }
+
         void check( const std::string &context, const mapgen_parameters &params ) const {
             source_->check( context, params );
         }
@@ -2151,6 +2167,7 @@ class jmapgen_vehicle : public jmapgen_piece
             if( chosen_id.is_null() ) {
                 return;
             }
+            const mapgen_stats::timer timer( mapgen_kind::vehicle, chosen_id.str() );
             dat.m.add_vehicle( chosen_id, point( x.get(), y.get() ), random_entry( rotation ),
                                fuel, status );
         }
@@ -2285,6 +2302,16 @@ class jmapgen_furniture : public jmapgen_piece
             }
             dat.m.furn_set( point( x.get(), y.get() ), chosen_id );
         }
+        bool add_to_stamp( jmapgen_stamp &stamp, const point &p ) const override {
+            const std::optional<furn_id> chosen_id = id.constant();
+            if( !chosen_id ) {
+                return false;
+            }
+            if( !chosen_id->id().is_null() ) {
+                stamp.entries.push_back( { p, false, ter_id(), *chosen_id } );
+            }
+            return true;
+        }
         bool has_vehicle_collision( const mapgendata &dat, const point &p ) const override {
             return dat.m.veh_at( tripoint( p, dat.zlevel() ) ).has_value();
         }
@@ -2318,13 +2345,26 @@ class jmapgen_terrain : public jmapgen_piece
             if( chosen_id.id().is_null() ) {
                 return;
             }
-            dat.m.ter_set( point( x.get(), y.get() ), chosen_id );
+            place_terrain( dat, point( x.get(), y.get() ), chosen_id );
+        }
+        bool add_to_stamp( jmapgen_stamp &stamp, const point &p ) const override {
+            const std::optional<ter_id> chosen_id = id.constant();
+            if( !chosen_id ) {
+                return false;
+            }
+            if( !chosen_id->id().is_null() ) {
+                stamp.entries.push_back( { p, true, *chosen_id, furn_id() } );
+            }
+            return true;
+        }
+        static void place_terrain( const mapgendata &dat, const point &p, const ter_id &id ) {
+            dat.m.ter_set( p, id );
             // Delete furniture if a wall was just placed over it. TODO: need to do anything for fluid, monsters?
-            if( dat.m.has_flag_ter( "WALL", point( x.get(), y.get() ) ) ) {
-                dat.m.furn_set( point( x.get(), y.get() ), f_null );
+            if( dat.m.has_flag_ter( TFLAG_WALL, p ) ) {
+                dat.m.furn_set( p, f_null );
                 // and items, unless the wall has PLACE_ITEM flag indicating it stores things.
-                if( !dat.m.has_flag_ter( "PLACE_ITEM", point( x.get(), y.get() ) ) ) {
-                    dat.m.i_clear( tripoint( x.get(), y.get(), dat.m.get_abs_sub().z ) );
+                if( !dat.m.has_flag_ter( "PLACE_ITEM", p ) ) {
+                    dat.m.i_clear( tripoint( p, dat.m.get_abs_sub().z ) );
                 }
             }
         }
@@ -2870,6 +2910,9 @@ class jmapgen_nested : public jmapgen_piece
                 return;
             }
 
+            const mapgen_stats::timer timer( mapgen_kind::nested, *res );
+            ZoneScopedN( "nested_mapgen" );
+            ZoneText( res->c_str(), res->size() );
             ( *ptr )->nest( dat, point( x.get(), y.get() ) );
         }
 
@@ -3652,6 +3695,41 @@ void jmapgen_objects::finalize()
     []( const jmapgen_obj & l, const jmapgen_obj & r ) {
         return l.second->phase() < r.second->phase();
     } );
+
+    // Rows of fixed terrain and furniture come first and use no RNG, so placing them from
+    // a stamp leaves the map and the RNG exactly as the pieces would have.
+    stamp.entries.clear();
+    stamp_end = 0;
+    for( const jmapgen_obj &obj : objects ) {
+        const jmapgen_place &where = obj.first;
+        const jmapgen_piece &what = *obj.second;
+        if( where.x.val != where.x.valmax || where.y.val != where.y.valmax ||
+            where.repeat.val != where.repeat.valmax || what.repeat.val != what.repeat.valmax ) {
+            break;
+        }
+        const int repeat = std::max( where.repeat.val, what.repeat.val );
+        const point p( where.x.val, where.y.val );
+        bool added = true;
+        for( int i = 0; added && i < repeat; i++ ) {
+            added = what.add_to_stamp( stamp, p );
+        }
+        if( !added ) {
+            break;
+        }
+        stamp_end++;
+    }
+}
+
+void jmapgen_stamp::apply( const mapgendata &dat, const point &offset ) const
+{
+    for( const entry &e : entries ) {
+        const point p = e.p + offset;
+        if( e.is_terrain ) {
+            jmapgen_terrain::place_terrain( dat, p, e.ter );
+        } else {
+            dat.m.furn_set( p, e.furn );
+        }
+    }
 }
 
 void jmapgen_objects::check( const std::string &oter_name,
@@ -3912,7 +3990,9 @@ void mapgen_function_json_nested::nest( const mapgendata &md, const point &offse
  */
 void jmapgen_objects::apply( const mapgendata &dat ) const
 {
-    for( auto &obj : objects ) {
+    stamp.apply( dat, point_zero );
+    for( auto it = objects.begin() + stamp_end; it != objects.end(); ++it ) {
+        const auto &obj = *it;
         const auto &where = obj.first;
         const auto &what = *obj.second;
         // The user will only specify repeat once in JSON, but it may get loaded both
@@ -3932,7 +4012,9 @@ void jmapgen_objects::apply( const mapgendata &dat, const point &offset ) const
         return;
     }
 
-    for( auto &obj : objects ) {
+    stamp.apply( dat, offset );
+    for( auto it = objects.begin() + stamp_end; it != objects.end(); ++it ) {
+        const auto &obj = *it;
         auto where = obj.first;
         where.offset( -offset );
 
@@ -4769,7 +4851,7 @@ void map::draw_lab( mapgendata &dat )
                     // We determine if a border isn't handled by checking the east-facing
                     // border space where the door normally is -- it should be a wall or door.
                     tripoint east_border( 23, 11, abs_sub.z );
-                    if( !has_flag_ter( "WALL", east_border ) &&
+                    if( !has_flag_ter( TFLAG_WALL, east_border ) &&
                         !has_flag_ter( "DOOR", east_border ) ) {
                         // TODO: create a ter_reset function that does ter_set,
                         // furn_set, and i_clear?
@@ -5021,7 +5103,7 @@ void map::draw_lab( mapgendata &dat )
                     if( i + j > 10 && i + j < 36 && std::abs( i - j ) < 13 ) {
                         // Doors and walls get sometimes destroyed:
                         // 100% at the edge, usually in a central cross, occasionally elsewhere.
-                        if( ( has_flag_ter( "DOOR", point( i, j ) ) || has_flag_ter( "WALL", point( i, j ) ) ) ) {
+                        if( ( has_flag_ter( "DOOR", point( i, j ) ) || has_flag_ter( TFLAG_WALL, point( i, j ) ) ) ) {
                             if( ( i == 0 || j == 0 || i == 23 || j == 23 ) ||
                                 ( !one_in( 3 ) && ( i == 11 || i == 12 || j == 11 || j == 12 ) ) ||
                                 one_in( 4 ) ) {
@@ -5034,8 +5116,8 @@ void map::draw_lab( mapgendata &dat )
                             }
                             // and then randomly destroy 5% of the remaining nonstairs.
                         } else if( one_in( 20 ) &&
-                                   !has_flag_ter( "GOES_DOWN", p2 ) &&
-                                   !has_flag_ter( "GOES_UP", p2 ) ) {
+                                   !has_flag_ter( TFLAG_GOES_DOWN, p2 ) &&
+                                   !has_flag_ter( TFLAG_GOES_UP, p2 ) ) {
                             destroy( { i, j, abs_sub.z } );
                             // bashed squares can create dirt & floors, but we want rock floors.
                             if( t_dirt == ter( point( i, j ) ) || t_floor == ter( point( i, j ) ) ) {
@@ -5178,8 +5260,8 @@ void map::draw_lab( mapgendata &dat )
                         ARTPROP_GLOWING
                     };
                     draw_rough_circle( [this]( point  p ) {
-                        if( has_flag_ter( "GOES_DOWN", p ) ||
-                            has_flag_ter( "GOES_UP", p ) ||
+                        if( has_flag_ter( TFLAG_GOES_DOWN, p ) ||
+                            has_flag_ter( TFLAG_GOES_UP, p ) ||
                             has_flag_ter( "CONSOLE", p ) ) {
                             return; // spare stairs and consoles.
                         }
@@ -5194,7 +5276,7 @@ void map::draw_lab( mapgendata &dat )
                 // radioactive accident.
                 case 6: {
                     tripoint center( rng( 6, SEEX * 2 - 7 ), rng( 6, SEEY * 2 - 7 ), abs_sub.z );
-                    if( has_flag_ter( "WALL", center.xy() ) ) {
+                    if( has_flag_ter( TFLAG_WALL, center.xy() ) ) {
                         // just skip it, we don't want to risk embedding radiation out of sight.
                         break;
                     }
@@ -5211,8 +5293,8 @@ void map::draw_lab( mapgendata &dat )
                         set_radiation( p, 50 );
                     }, center.xy(), 1 );
                     draw_circle( [this]( point  p ) {
-                        if( has_flag_ter( "GOES_DOWN", p ) ||
-                            has_flag_ter( "GOES_UP", p ) ||
+                        if( has_flag_ter( TFLAG_GOES_DOWN, p ) ||
+                            has_flag_ter( TFLAG_GOES_UP, p ) ||
                             has_flag_ter( "CONSOLE", p ) ) {
                             return; // spare stairs and consoles.
                         }
@@ -5245,14 +5327,14 @@ void map::draw_lab( mapgendata &dat )
                     for( int i = 0; i < EAST_EDGE; i++ ) {
                         for( int j = 0; j < SOUTH_EDGE; j++ ) {
                             // Create a mostly spread fungal area throughout entire lab.
-                            if( !one_in( 5 ) && ( has_flag( "FLAT", point( i, j ) ) ) ) {
+                            if( !one_in( 5 ) && ( has_flag( TFLAG_FLAT, point( i, j ) ) ) ) {
                                 ter_set( point( i, j ), t_fungus_floor_in );
-                                if( has_flag_furn( "ORGANIC", point( i, j ) ) ) {
+                                if( has_flag_furn( TFLAG_ORGANIC, point( i, j ) ) ) {
                                     furn_set( point( i, j ), f_fungal_clump );
                                 }
                             } else if( has_flag_ter( "DOOR", point( i, j ) ) && !one_in( 5 ) ) {
                                 ter_set( point( i, j ), t_fungus_floor_in );
-                            } else if( has_flag_ter( "WALL", point( i, j ) ) && one_in( 3 ) ) {
+                            } else if( has_flag_ter( TFLAG_WALL, point( i, j ) ) && one_in( 3 ) ) {
                                 ter_set( point( i, j ), t_fungus_wall );
                             }
                         }
@@ -5261,12 +5343,12 @@ void map::draw_lab( mapgendata &dat )
 
                     // Make a portal surrounded by more dense fungal stuff and a fungaloid.
                     draw_rough_circle( [this]( point  p ) {
-                        if( has_flag_ter( "GOES_DOWN", p ) ||
-                            has_flag_ter( "GOES_UP", p ) ||
+                        if( has_flag_ter( TFLAG_GOES_DOWN, p ) ||
+                            has_flag_ter( TFLAG_GOES_UP, p ) ||
                             has_flag_ter( "CONSOLE", p ) ) {
                             return; // spare stairs and consoles.
                         }
-                        if( has_flag_ter( "WALL", p ) ) {
+                        if( has_flag_ter( TFLAG_WALL, p ) ) {
                             ter_set( p, t_fungus_wall );
                         } else {
                             ter_set( p, t_fungus_floor_in );
@@ -5314,7 +5396,7 @@ void map::draw_lab( mapgendata &dat )
             // We determine if a border isn't handled by checking the east-facing
             // border space where the door normally is -- it should be a wall or door.
             tripoint east_border( 23, 11, abs_sub.z );
-            if( !has_flag_ter( "WALL", east_border ) && !has_flag_ter( "DOOR", east_border ) ) {
+            if( !has_flag_ter( TFLAG_WALL, east_border ) && !has_flag_ter( "DOOR", east_border ) ) {
                 // TODO: create a ter_reset function that does ter_set, furn_set, and i_clear?
                 ter_id lw_type = tower_lab ? t_reinforced_glass : t_concrete_wall;
                 ter_id tw_type = tower_lab ? t_reinforced_glass : t_concrete_wall;
@@ -6246,6 +6328,9 @@ std::vector<item *> map::place_items( const item_group_id &loc, const int chance
         return res;
     }
 
+    const mapgen_stats::timer timer( mapgen_kind::items, loc.str() );
+    ZoneScopedN( "place_items" );
+    ZoneText( loc.c_str(), loc.str().size() );
     const float spawn_rate = get_option<float>( "ITEM_SPAWNRATE" );
     int spawn_count = roll_remainder( chance * spawn_rate / 100.0f );
     for( int i = 0; i < spawn_count; i++ ) {
@@ -6375,6 +6460,7 @@ vehicle *map::add_vehicle( const vproto_id &type, const tripoint &p, const units
     if( placed_vehicle != nullptr ) {
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->sm_pos );
         place_on_submap->vehicles.push_back( std::move( placed_vehicle_up ) );
+        place_on_submap->mark_modified();
         place_on_submap->is_uniform = false;
         invalidate_max_populated_zlev( p.z );
 
@@ -7352,6 +7438,9 @@ bool run_mapgen_update_func( const std::string &update_mapgen_id, const tripoint
     if( update_function == update_mapgen.end() || update_function->second.empty() ) {
         return false;
     }
+    const mapgen_stats::timer timer( mapgen_kind::update, update_mapgen_id );
+    ZoneScopedN( "update_mapgen" );
+    ZoneText( update_mapgen_id.c_str(), update_mapgen_id.size() );
     return update_function->second[0]->update_map( omt_pos, point_zero, miss, cancel_on_collision );
 }
 
@@ -7362,6 +7451,9 @@ bool run_mapgen_update_func( const std::string &update_mapgen_id, mapgendata &da
     if( update_function == update_mapgen.end() || update_function->second.empty() ) {
         return false;
     }
+    const mapgen_stats::timer timer( mapgen_kind::update, update_mapgen_id );
+    ZoneScopedN( "update_mapgen" );
+    ZoneText( update_mapgen_id.c_str(), update_mapgen_id.size() );
     return update_function->second[0]->update_map( dat, point_zero, cancel_on_collision );
 }
 
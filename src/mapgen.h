@@ -181,6 +181,23 @@ inline bool operator<( const mapgen_phase l, const mapgen_phase r )
  * For actual examples look at the commits that introduced the load_objects/load_place_mapings
  * lines (ignore the changes to the json files).
  */
+/**
+ * Terrain and furniture that a mapgen always places on the same squares, in the order
+ * the pieces would place them, resolved once so they are copied onto the map directly.
+ */
+struct jmapgen_stamp {
+    struct entry {
+        point p;
+        // Which of ter and furn gets placed
+        bool is_terrain;
+        ter_id ter;
+        furn_id furn;
+    };
+    std::vector<entry> entries;
+
+    void apply( const mapgendata &dat, const point &offset ) const;
+};
+
 class jmapgen_piece
 {
     protected:
@@ -201,6 +218,13 @@ class jmapgen_piece
         /** Place something on the map from mapgendata &dat, at (x,y). */
         virtual void apply( const mapgendata &dat, const jmapgen_int &x, const jmapgen_int &y
                           ) const = 0;
+        /**
+         * Adds what this piece places at p to the stamp, if it places the same thing
+         * every time. Returns false, leaving the stamp untouched, when it does not.
+         */
+        virtual bool add_to_stamp( jmapgen_stamp &, const point &/*p*/ ) const {
+            return false;
+        }
         virtual ~jmapgen_piece() = default;
         jmapgen_int repeat;
         virtual bool has_vehicle_collision( const mapgendata &, const point &/*offset*/ ) const {
@@ -386,6 +410,9 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, shared_ptr_fast<const jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+        /** What the first @ref stamp_end objects place, see @ref finalize */
+        jmapgen_stamp stamp;
+        size_t stamp_end = 0;
         point m_offset;
         point mapgensize;
         point total_size;
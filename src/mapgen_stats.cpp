@@ -0,0 +1,27 @@
+#include "mapgen_stats.h"
+
+namespace mapgen_stats
+{
+
+const char *kind_name( mapgen_kind kind )
+{
+    switch( kind ) {
+        case mapgen_kind::builtin:
+            return "builtin";
+        case mapgen_kind::json:
+            return "json";
+        case mapgen_kind::nested:
+            return "nested";
+        case mapgen_kind::update:
+            return "update";
+        case mapgen_kind::items:
+            return "items";
+        case mapgen_kind::vehicle:
+            return "vehicle";
+        case mapgen_kind::num_mapgen_kinds:
+            break;
+    }
+    return "invalid";
+}
+
+} // namespace mapgen_stats
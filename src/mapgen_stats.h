@@ -0,0 +1,68 @@
+#pragma once
+#ifndef CATA_SRC_MAPGEN_STATS_H
+#define CATA_SRC_MAPGEN_STATS_H
+
+#include <cstdint>
+#include <string>
+
+#include "phase_stats.h"
+
+/** What a timed piece of map generation is, so the same id can show up as several kinds. */
+enum class mapgen_kind : int {
+    /** A mapgen function written in C++. */
+    builtin,
+    /** A mapgen function loaded from JSON. */
+    json,
+    /** A nested chunk placed by another mapgen. */
+    nested,
+    /** An update mapgen applied to already generated terrain. */
+    update,
+    /** Items placed from an item group, @ref map::place_items. */
+    items,
+    /** A vehicle placed from a vehicle group. */
+    vehicle,
+    num_mapgen_kinds
+};
+
+/**
+ * Wall time and invocation counts of map generation, by kind and mapgen id.
+ * Time spent in nested chunks, items and vehicles also counts towards the mapgen
+ * that placed them.
+ */
+namespace mapgen_stats
+{
+
+const char *kind_name( mapgen_kind kind );
+
+using stats = phase_stats::per_id<mapgen_kind, kind_name>;
+/** Adds the time from its creation to its end to the totals of `id`. */
+using timer = stats::timer;
+
+/** How many times `id` was timed as `kind` since the last reset. */
+inline std::uint64_t count( mapgen_kind kind, const std::string &id )
+{
+    return stats::count( kind, id );
+}
+inline std::uint64_t microseconds( mapgen_kind kind, const std::string &id )
+{
+    return stats::microseconds( kind, id );
+}
+
+inline void reset()
+{
+    stats::reset();
+}
+/** One line for each of the `max_lines` ids that took the longest since the last reset. */
+inline std::string report( int max_lines )
+{
+    return stats::report( max_lines );
+}
+/** All the totals since the last reset, one row for each kind and id, longest first. */
+inline std::string csv()
+{
+    return stats::csv();
+}
+
+} // namespace mapgen_stats
+
+#endif // CATA_SRC_MAPGEN_STATS_H
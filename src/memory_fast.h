@@ -3,6 +3,9 @@
 #define CATA_SRC_MEMORY_FAST_H
 
 #include <memory>
+#include <utility>
+
+#include "slab_allocator.h"
 
 #if __GLIBCXX__
 template<typename T> using shared_ptr_fast = std::__shared_ptr<T, __gnu_cxx::_S_single>;
@@ -10,7 +13,14 @@ template<typename T> using weak_ptr_fast = std::__weak_ptr<T, __gnu_cxx::_S_sing
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
     Args &&... args )
 {
-    return std::__make_shared<T, __gnu_cxx::_S_single>( args... );
+    return std::__make_shared<T, __gnu_cxx::_S_single>( std::forward<Args>( args )... );
+}
+/** Like @ref make_shared_fast, from a @ref slab_allocator so objects made together stay close. */
+template<typename T, typename... Args> shared_ptr_fast<T> make_shared_pooled(
+    Args &&... args )
+{
+    return std::__allocate_shared<T, __gnu_cxx::_S_single>( slab_allocator<T>(),
+            std::forward<Args>( args )... );
 }
 #else
 template<typename T> using shared_ptr_fast = std::shared_ptr<T>;
@@ -18,7 +28,12 @@ template<typename T> using weak_ptr_fast = std::weak_ptr<T>;
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
     Args &&... args )
 {
-    return std::make_shared<T>( args... );
+    return std::make_shared<T>( std::forward<Args>( args )... );
+}
+template<typename T, typename... Args> shared_ptr_fast<T> make_shared_pooled(
+    Args &&... args )
+{
+    return std::allocate_shared<T>( slab_allocator<T>(), std::forward<Args>( args )... );
 }
 #endif
 
@@ -0,0 +1,113 @@
+#include "memory_stats.h"
+
+#include <memory>
+
+#include "avatar.h"
+#include "catalua.h"
+#include "game.h"
+#include "init.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "monster.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "slab_allocator.h"
+#include "string_formatter.h"
+#if defined(TILES)
+#   include "cata_tiles.h"
+#   include "sdltiles.h"
+#endif
+
+namespace memory_stats
+{
+
+std::vector<owner_usage> collect_owners()
+{
+    std::vector<owner_usage> ret;
+    ret.push_back( { "mapbuffer submaps", MAPBUFFER.memory_usage(), MAPBUFFER.size() } );
+    ret.push_back( { "items", slab_allocator<item>::live_count() * sizeof( item ),
+                     slab_allocator<item>::live_count() } );
+    ret.push_back( { "overmaps", overmap_buffer.memory_usage(), overmap_buffer.size() } );
+    if( g != nullptr ) {
+        ret.push_back( { "map caches", g->m.cache_memory_usage(), 0 } );
+        ret.push_back( { "map memory", g->u.map_memory_usage(), 0 } );
+        owner_usage monsters{ "monsters" };
+        for( const monster &critter : g->all_monsters() ) {
+            monsters.bytes += sizeof( critter );
+            monsters.count++;
+        }
+        ret.push_back( monsters );
+        owner_usage npcs{ "npcs" };
+        for( const npc &guy : g->all_npcs() ) {
+            npcs.bytes += sizeof( guy );
+            npcs.count++;
+        }
+        ret.push_back( npcs );
+    }
+#if defined(TILES)
+    if( tilecontext ) {
+        ret.push_back( { "tileset textures", tilecontext->texture_memory_usage(), 0 } );
+    }
+#endif
+    const auto &lua = DynamicDataLoader::get_instance().lua;
+    if( cata::has_lua() && lua ) {
+        ret.push_back( { "lua", cata::lua_memory_usage( *lua ), 0 } );
+    }
+    return ret;
+}
+
+std::vector<type_allocations> collect_types()
+{
+    return {
+        {
+            "item", sizeof( item ), slab_allocator<item>::live_count(),
+            slab_allocator<item>::allocation_count()
+        },
+    };
+}
+
+std::string report()
+{
+    std::string ret;
+    for( const owner_usage &usage : collect_owners() ) {
+        ret += string_format( "%s: %.2f MiB", usage.owner, usage.bytes / ( 1024.0 * 1024.0 ) );
+        if( usage.count > 0 ) {
+            ret += string_format( " in %d", usage.count );
+        }
+        ret += "\n";
+    }
+    for( const type_allocations &type : collect_types() ) {
+        ret += string_format( "%s objects (%d bytes): %d live, %d allocated in total\n", type.type,
+                              type.object_size, type.live, type.total );
+    }
+    return ret;
+}
+
+void serialize( JsonOut &jsout )
+{
+    jsout.member( "memory_owners" );
+    jsout.start_array();
+    for( const owner_usage &usage : collect_owners() ) {
+        jsout.start_object();
+        jsout.member( "owner", usage.owner );
+        jsout.member( "bytes", usage.bytes );
+        jsout.member( "count", usage.count );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.member( "allocations" );
+    jsout.start_array();
+    for( const type_allocations &type : collect_types() ) {
+        jsout.start_object();
+        jsout.member( "type", type.type );
+        jsout.member( "object_size", type.object_size );
+        jsout.member( "live", type.live );
+        jsout.member( "total", type.total );
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+} // namespace memory_stats
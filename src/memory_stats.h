@@ -0,0 +1,45 @@
+#pragma once
+#ifndef CATA_SRC_MEMORY_STATS_H
+#define CATA_SRC_MEMORY_STATS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class JsonOut;
+
+/**
+ * Approximate memory taken by the big owners of game state, as each of them reports it.
+ * The sizes leave out allocator overhead and most small members, they are meant to show
+ * which owner grows, not to add up to the resident size of the process.
+ */
+namespace memory_stats
+{
+
+struct owner_usage {
+    std::string owner;
+    std::size_t bytes = 0;
+    /** Submaps, overmaps, items etc. the owner holds, 0 where that doesn't apply. */
+    std::size_t count = 0;
+};
+
+/** Objects of one type handed out by their allocator, see @ref slab_allocator. */
+struct type_allocations {
+    std::string type;
+    std::size_t object_size = 0;
+    std::size_t live = 0;
+    /** Allocated since the start, freed ones included. */
+    std::size_t total = 0;
+};
+
+std::vector<owner_usage> collect_owners();
+std::vector<type_allocations> collect_types();
+
+/** One line for each owner and each type. */
+std::string report();
+/** Writes both lists as members of the object being written. */
+void serialize( JsonOut &jsout );
+
+} // namespace memory_stats
+
+#endif // CATA_SRC_MEMORY_STATS_H
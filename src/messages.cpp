@@ -28,6 +28,7 @@
 #include <deque>
 #include <iterator>
 #include <memory>
+#include <unordered_map>
 namespace
 {
 
@@ -113,7 +114,8 @@ class messages_impl
 {
     public:
         std::deque<game_message> messages;   // Messages to be printed
-        std::vector<game_message> cooldown_templates; // Message cooldown
+        // Message cooldown, by message string
+        std::unordered_map<std::string, game_message> cooldown_templates;
         time_point curmes = calendar::turn_zero; // The last-seen message.
         bool active = true;
 
@@ -141,12 +143,9 @@ class messages_impl
             }
 
             // update the cooldown message timer due to coalescing
-            const auto cooldown_it = std::find_if( cooldown_templates.begin(), cooldown_templates.end(),
-            [&m]( game_message & am ) -> bool {
-                return m.message == am.message;
-            } );
+            const auto cooldown_it = cooldown_templates.find( m.message );
             if( cooldown_it != cooldown_templates.end() ) {
-                cooldown_it->timestamp_in_turns = calendar::turn;
+                cooldown_it->second.timestamp_in_turns = calendar::turn;
             }
 
             // coalesce messages
@@ -194,7 +193,7 @@ class messages_impl
                 messages.pop_front();
             }
 
-            messages.emplace_back( m );
+            messages.emplace_back( std::move( m ) );
         }
 
         /** Check if the current message needs to be prevented (hidden) or not from being displayed in the side bar.
@@ -209,14 +208,12 @@ class messages_impl
 
             // We look for **exactly the same** message string in the cooldown templates
             // If there is one, this means the same message was already displayed.
-            const auto cooldown_it = std::find_if( cooldown_templates.begin(), cooldown_templates.end(),
-            [&message]( game_message & m_cooldown ) -> bool {
-                return m_cooldown.message == message.message;
-            } );
-            if( cooldown_it == cooldown_templates.end() ) {
+            const auto found = cooldown_templates.find( message.message );
+            if( found == cooldown_templates.end() ) {
                 // nothing found, not in cooldown.
                 return;
             }
+            const game_message *cooldown_it = &found->second;
 
             // note: from this point the current message (`message`) has the same string than one of the active cooldown template messages (`cooldown_it`).
 
@@ -272,7 +269,7 @@ class messages_impl
             const auto now = calendar::turn;
             for( auto it = cooldown_templates.begin(); it != cooldown_templates.end(); ) {
                 // number of turns elapsed since the cooldown started.
-                const auto turns = to_turns<int>( now - it->turn() );
+                const auto turns = to_turns<int>( now - it->second.turn() );
                 if( turns >= message_cooldown ) {
                     // time elapsed! remove it.
                     it = cooldown_templates.erase( it );
@@ -288,16 +285,13 @@ class messages_impl
 
             // Is the message string already in the cooldown queue?
             // If it's not we must put it in the cooldown queue now, otherwise just increment the number of times we have seen it.
-            const auto cooldown_message_it = std::find_if( cooldown_templates.begin(),
-            cooldown_templates.end(), [&message]( game_message & cooldown_message ) -> bool {
-                return cooldown_message.message == message.message;
-            } );
+            const auto cooldown_message_it = cooldown_templates.find( message.message );
             if( cooldown_message_it == cooldown_templates.end() ) {
                 // push current message to cooldown message templates.
-                cooldown_templates.emplace_back( message );
+                cooldown_templates.emplace( message.message, message );
             } else {
                 // increment the number of time we have seen this message.
-                cooldown_message_it->cooldown_seen++;
+                cooldown_message_it->second.cooldown_seen++;
             }
         }
 };
@@ -7,6 +7,7 @@
 #include <list>
 #include <memory>
 #include <numeric>
+#include <set>
 #include <unordered_map>
 #include <utility>
 
@@ -60,6 +61,9 @@ std::string mission_type::tname() const
 }
 
 static std::unordered_map<int, mission> world_missions;
+// Uids of the missions that were in progress when last seen, the only ones process_all looks at.
+// Only starting and loading put a mission in progress, the rest of the statuses are checked for.
+static std::set<int> missions_in_progress;
 
 mission *mission::reserve_new( const mission_type_id &type, const character_id &npc_id )
 {
@@ -93,12 +97,25 @@ std::vector<mission *> mission::get_all_active()
 void mission::add_existing( const mission &m )
 {
     world_missions[ m.uid ] = m;
+    if( m.in_progress() ) {
+        missions_in_progress.insert( m.uid );
+    }
 }
 
 void mission::process_all()
 {
-    for( auto &e : world_missions ) {
-        e.second.process();
+    // Copied, processing may start, end or create missions
+    const std::vector<int> uids( missions_in_progress.begin(), missions_in_progress.end() );
+    for( const int uid : uids ) {
+        const auto iter = world_missions.find( uid );
+        if( iter == world_missions.end() || !iter->second.in_progress() ) {
+            missions_in_progress.erase( uid );
+            continue;
+        }
+        iter->second.process();
+        if( !iter->second.in_progress() ) {
+            missions_in_progress.erase( uid );
+        }
     }
 }
 
@@ -127,6 +144,7 @@ std::vector<int> mission::to_uid_vector( const std::vector<mission *> &vec )
 void mission::clear_all()
 {
     world_missions.clear();
+    missions_in_progress.clear();
 }
 
 void mission::on_creature_death( Creature &poor_dead_dude )
@@ -234,6 +252,7 @@ void mission::assign( avatar &u )
         }
         type->start( this );
         status = mission_status::in_progress;
+        missions_in_progress.insert( uid );
     }
 }
 
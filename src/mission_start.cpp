@@ -155,7 +155,7 @@ static tripoint find_potential_computer_point( const tinymap &compmap )
             }
             int wall = 0;
             for( const tripoint &p2 : compmap.points_in_radius( p, 1 ) ) {
-                if( compmap.has_flag_ter( "WALL", p2 ) ) {
+                if( compmap.has_flag_ter( TFLAG_WALL, p2 ) ) {
                     wall++;
                 }
             }
@@ -333,7 +333,7 @@ bool mattack::none( monster * )
 bool mattack::eat_crop( monster *z )
 {
     for( const auto &p : g->m.points_in_radius( z->pos(), 1 ) ) {
-        if( g->m.has_flag( "PLANT", p ) && one_in( 4 ) ) {
+        if( g->m.has_flag( TFLAG_PLANT, p ) && one_in( 4 ) ) {
             g->m.furn_set( p, furn_str_id( g->m.furn( p )->plant->base ) );
             g->m.i_clear( p );
             return true;
@@ -346,7 +346,7 @@ bool mattack::eat_food( monster *z )
 {
     for( const auto &p : g->m.points_in_radius( z->pos(), 1 ) ) {
         //Protect crop seeds from carnivores, give omnivores eat_crop special also
-        if( g->m.has_flag( "PLANT", p ) ) {
+        if( g->m.has_flag( TFLAG_PLANT, p ) ) {
             continue;
         }
         // Don't snap up food RIGHT under the player's nose.
@@ -1446,8 +1446,8 @@ bool mattack::growplants( monster *z )
     for( const auto &p : g->m.points_in_radius( z->pos(), 3 ) ) {
 
         // Only affect natural, dirtlike terrain or trees.
-        if( !( g->m.has_flag_ter( "DIGGABLE", p ) ||
-               g->m.has_flag_ter( "TREE", p ) ||
+        if( !( g->m.has_flag_ter( TFLAG_DIGGABLE, p ) ||
+               g->m.has_flag_ter( TFLAG_TREE, p ) ||
                g->m.ter( p ) == t_tree_young ) ) {
             continue;
         }
@@ -1707,7 +1707,7 @@ bool mattack::fungus( monster *z )
         add_msg( m_warning, _( "Spores are released from the %s!" ), z->name() );
     }
 
-    bool on_fungus = g->m.has_flag_ter( "FUNGUS", z->pos() );
+    bool on_fungus = g->m.has_flag_ter( TFLAG_FUNGUS, z->pos() );
     int radius = one_in( 4 ) ? 2 : 1;
     double spore_chance = ( on_fungus ? 0.5f : 0.2f ) / ( ( radius + 1 ) * ( radius + 1 ) );
     fungal_effects fe( *g, g->m );
@@ -5175,10 +5175,9 @@ bool mattack::mon_leech_evolution( monster *z )
     const bool u_see = g->u.sees( *z );
     const bool is_queen = z->has_flag( MF_QUEEN );
     std::list<monster *> queens;
-    for( monster &candidate : g->all_monsters() ) {
-        if( candidate.in_species( LEECH_PLANT ) && candidate.has_flag( MF_QUEEN ) &&
-            rl_dist( z->pos(), candidate.pos() ) < 45 ) {
-            queens.push_back( &candidate );
+    for( monster *candidate : g->get_monsters_in_radius( z->pos(), 44 ) ) {
+        if( candidate->in_species( LEECH_PLANT ) && candidate->has_flag( MF_QUEEN ) ) {
+            queens.push_back( candidate );
         }
     }
     if( !is_queen ) {
@@ -5,16 +5,19 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <unordered_map>
 
 #include "avatar.h"
 #include "behavior.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "creature_tracker.h"
 #include "debug.h"
@@ -32,6 +35,7 @@
 #include "messages.h"
 #include "monfaction.h"
 #include "monster_oracle.h"
+#include "monster_turn_stats.h"
 #include "mtype.h"
 #include "npc.h"
 #include "pathfinding.h"
@@ -86,6 +90,59 @@ bool monster::wander()
     return ( goal == pos() );
 }
 
+std::optional<route_request> monster::expected_route_request() const
+{
+    if( goal == pos() ) {
+        return std::nullopt;
+    }
+    const pathfinding_settings &pf_settings = get_pathfinding_settings();
+    if( pf_settings.max_dist < rl_dist( pos(), goal ) ) {
+        return std::nullopt;
+    }
+    // Same test as move()
+    const auto next = std::find_if( path.begin(), path.end(), [this]( const tripoint & p ) {
+        return p != pos();
+    } );
+    if( next != path.end() && rl_dist( pos(), *next ) < 2 && path.back() == goal ) {
+        return std::nullopt;
+    }
+    return route_request{ pos(), goal, pf_settings, get_path_avoid() };
+}
+
+void monster::expected_sight_lines( std::vector<std::pair<tripoint, tripoint>> &lines ) const
+{
+    if( has_effect( effect_ai_waiting ) || ( friendly != 0 && has_effect( effect_docile ) ) ) {
+        return;
+    }
+    // Same targets as plan(), adjacent ones are seen without a line
+    const int max_sight_range = std::max( type->vision_day, type->vision_night );
+    const std::vector<Creature *> targets = g->get_creatures_in_radius( pos(), max_sight_range,
+    [this]( const Creature & c ) {
+        if( &c == this || c.is_hallucination() || c.posz() != posz() || rl_dist( pos(), c.pos() ) <= 1 ) {
+            return false;
+        }
+        if( c.is_avatar() ) {
+            return friendly == 0;
+        }
+        if( const npc *who = c.as_npc() ) {
+            const mf_attitude att = faction.obj().attitude( who->get_monster_faction() );
+            return att != MFA_NEUTRAL && att != MFA_FRIENDLY;
+        }
+        const monster *mon = c.as_monster();
+        if( mon == nullptr ) {
+            return false;
+        }
+        if( friendly != 0 ) {
+            return mon->friendly == 0;
+        }
+        const mf_attitude att = faction.obj().attitude( mon->faction );
+        return att != MFA_NEUTRAL && att != MFA_FRIENDLY;
+    } );
+    for( const Creature *c : targets ) {
+        lines.emplace_back( pos(), c->pos() );
+    }
+}
+
 bool monster::is_immune_field( const field_type_id &fid ) const
 {
     if( fid == fd_fungal_haze ) {
@@ -122,7 +179,53 @@ static bool z_is_valid( int z )
     return z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT;
 }
 
+std::optional<std::uint32_t> monster::move_mode() const
+{
+    // Which fields are dangerous depends on the monster's immunities
+    if( has_flag( MF_AVOID_DANGER_2 ) ) {
+        return std::nullopt;
+    }
+    const bool avoid_simple = has_flag( MF_AVOID_DANGER_1 );
+    std::uint32_t mode = 0;
+    int bit = 0;
+    const auto add = [&]( bool trait ) {
+        mode |= static_cast<std::uint32_t>( trait ) << bit++;
+    };
+    add( digging() );
+    add( can_climb() );
+    add( can_submerge() );
+    add( flies() );
+    add( digs() );
+    add( has_flag( MF_AQUATIC ) );
+    add( has_flag( MF_SUNDEATH ) );
+    add( get_size() > creature_size::medium );
+    add( type->size == creature_size::tiny );
+    add( has_flag( MF_AVOID_FIRE ) || avoid_simple );
+    add( has_flag( MF_AVOID_FALL ) || avoid_simple );
+    add( avoid_simple );
+    add( avoid_simple && attitude( &g->u ) != MATT_ATTACK );
+    return mode;
+}
+
 bool monster::will_move_to( const tripoint &p ) const
+{
+    // Monsters of the same kind ask about the same tiles many times a turn
+    map &here = get_map();
+    const std::optional<std::uint32_t> mode = move_mode();
+    if( !mode || !here.inbounds( p ) ) {
+        return decide_move_to( p );
+    }
+    move_memo &memo = here.get_monster_move_cache( p.z );
+    const int known = memo.get( p.xy(), *mode );
+    if( known >= 0 ) {
+        return known > 0;
+    }
+    const bool allowed = decide_move_to( p );
+    memo.insert( p.xy(), *mode, allowed );
+    return allowed;
+}
+
+bool monster::decide_move_to( const tripoint &p ) const
 {
     if( g->m.impassable( p ) ) {
         tripoint above_p = p + tripoint_above;
@@ -130,7 +233,7 @@ bool monster::will_move_to( const tripoint &p ) const
             if( !g->m.has_flag( "BURROWABLE", p ) ) {
                 return false;
             }
-        } else if( !( can_climb() && g->m.has_flag( "CLIMBABLE", p ) &&
+        } else if( !( can_climb() && g->m.has_flag( TFLAG_CLIMBABLE, p ) &&
                       !g->m.has_floor_or_support( above_p ) ) ) {
             return false;
         }
@@ -140,11 +243,11 @@ bool monster::will_move_to( const tripoint &p ) const
         return false;
     }
 
-    if( digs() && !g->m.has_flag( "DIGGABLE", p ) && !g->m.has_flag( "BURROWABLE", p ) ) {
+    if( digs() && !g->m.has_flag( TFLAG_DIGGABLE, p ) && !g->m.has_flag( "BURROWABLE", p ) ) {
         return false;
     }
 
-    if( has_flag( MF_AQUATIC ) && !g->m.has_flag( "SWIMMABLE", p ) ) {
+    if( has_flag( MF_AQUATIC ) && !g->m.has_flag( TFLAG_SWIMMABLE, p ) ) {
         return false;
     }
 
@@ -202,7 +305,7 @@ bool monster::will_move_to( const tripoint &p ) const
         // Some things are only avoided if we're not attacking
         if( attitude( &g->u ) != MATT_ATTACK ) {
             // Sharp terrain is ignored while attacking
-            if( avoid_simple && g->m.has_flag( "SHARP", p ) &&
+            if( avoid_simple && g->m.has_flag( TFLAG_SHARP, p ) &&
                 !( type->size == creature_size::tiny || flies() ) ) {
                 return false;
             }
@@ -451,33 +554,46 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
+        const auto consider = [&]( monster & mon ) {
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = &mon;
+                }
             }
-
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
+        };
+        if( !smart_planning && dist < FLT_MAX ) {
+            // Monsters not closer than the current target rate FLT_MAX and change nothing,
+            // so only the ones in the box around us need to be looked at
+            const int range = std::ceil( dist );
+            const tripoint reach( range, range, fov_3d || debug_mode ? range : 0 );
+            for( const shared_ptr_fast<monster> &shared : g->critter_tracker->find_hostiles_in_rect( faction,
+                    pos() - reach, pos() + reach ) ) {
+                consider( *shared );
+            }
+        } else {
+            for( const auto &fac : factions ) {
+                auto faction_att = g->critter_tracker->attitude( faction, fac.first );
+                if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                     continue;
                 }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
+
+                for( const weak_ptr_fast<monster> &weak : fac.second ) {
+                    const shared_ptr_fast<monster> shared = weak.lock();
+                    if( !shared ) {
+                        continue;
                     }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+                    consider( *shared );
                 }
             }
         }
@@ -687,6 +803,7 @@ bool monster::die_if_drowning( const tripoint &at_pos, const int chance )
 // 4) Sound-based tracking
 void monster::move()
 {
+    ZoneScoped;
     // We decrement wandf no matter what.  We'll save our wander_to plans until
     // after we finish out set_dest plans, UNLESS they time out first.
     if( wandf > 0 ) {
@@ -763,6 +880,7 @@ void monster::move()
         // Cooldowns are decremented in monster::process_turn
 
         if( local_attack_data.cooldown == 0 && !pacified && !is_hallucination() ) {
+            const monster_turn_stats::phase_timer timer( monster_phase::attack );
             if( !sp_type.second->call( *this ) ) {
                 continue;
             }
@@ -884,7 +1002,10 @@ void monster::move()
             if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
                 ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
                 // We need a new path
-                path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+                const std::set<tripoint> avoid = get_path_avoid();
+                // Hordes chasing one target share the work
+                path = avoid.empty() ? g->m.route_shared( pos(), goal, pf_settings ) :
+                       g->m.route( pos(), goal, pf_settings, avoid );
             }
 
             // Try to respect old paths, even if we can't pathfind at the moment
@@ -1325,40 +1446,40 @@ int monster::calc_movecost( const tripoint &f, const tripoint &t ) const
     const int source_cost = g->m.move_cost( f );
     const int dest_cost = g->m.move_cost( t );
     // Digging and flying monsters ignore terrain cost
-    if( flies() || ( digging() && g->m.has_flag( "DIGGABLE", t ) ) ) {
+    if( flies() || ( digging() && g->m.has_flag( TFLAG_DIGGABLE, t ) ) ) {
         movecost = 100;
         // Swimming monsters move super fast in water
     } else if( swims() ) {
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, f ) ) {
             movecost += 25;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, t ) ) {
             movecost += 25;
         } else {
             movecost += 50 * g->m.move_cost( t );
         }
     } else if( can_submerge() ) {
         // No-breathe monsters have to walk underwater slowly
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, f ) ) {
             movecost += 250;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, t ) ) {
             movecost += 250;
         } else {
             movecost += 50 * g->m.move_cost( t );
         }
         movecost /= 2;
     } else if( climbs() ) {
-        if( g->m.has_flag( "CLIMBABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_CLIMBABLE, f ) ) {
             movecost += 150;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "CLIMBABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_CLIMBABLE, t ) ) {
             movecost += 150;
         } else {
             movecost += 50 * g->m.move_cost( t );
@@ -1453,7 +1574,7 @@ bool monster::bash_at( const tripoint &p )
         return false;
     }
 
-    bool flat_ground = g->m.has_flag( "ROAD", p ) || g->m.has_flag( "FLAT", p );
+    bool flat_ground = g->m.has_flag( "ROAD", p ) || g->m.has_flag( TFLAG_FLAT, p );
     if( flat_ground && !g->m.is_bashable_furn( p ) ) {
         bool can_bash_ter = g->m.is_bashable_ter( p );
         bool try_bash_ter = one_in( 50 );
@@ -1614,7 +1735,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
 
     // Allows climbing monsters to move on terrain with movecost <= 0
     Creature *critter = g->critter_at( destination, is_hallucination() );
-    if( g->m.has_flag( "CLIMBABLE", destination ) ) {
+    if( g->m.has_flag( TFLAG_CLIMBABLE, destination ) ) {
         tripoint above_dest = destination + tripoint_above;
         if( g->m.impassable( destination ) && critter == nullptr &&
             !g->m.has_floor_or_support( above_dest ) ) {
@@ -1623,7 +1744,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
                 force = true;
                 if( g->u.sees( *this ) ) {
                     add_msg( _( "The %1$s flies over the %2$s." ), name(),
-                             g->m.has_flag_furn( "CLIMBABLE", p ) ? g->m.furnname( p ) :
+                             g->m.has_flag_furn( TFLAG_CLIMBABLE, p ) ? g->m.furnname( p ) :
                              g->m.tername( p ) );
                 }
             } else if( climbs() ) {
@@ -1631,7 +1752,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
                 force = true;
                 if( g->u.sees( *this ) ) {
                     add_msg( _( "The %1$s climbs over the %2$s." ), name(),
-                             g->m.has_flag_furn( "CLIMBABLE", p ) ? g->m.furnname( p ) :
+                             g->m.has_flag_furn( TFLAG_CLIMBABLE, p ) ? g->m.furnname( p ) :
                              g->m.tername( p ) );
                 }
             }
@@ -1702,17 +1823,17 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
     if( type->size != creature_size::tiny && on_ground ) {
         const int sharp_damage = rng( 1, 10 );
         const int rough_damage = rng( 1, 2 );
-        if( g->m.has_flag( "SHARP", pos() ) && !one_in( 4 ) &&
+        if( g->m.has_flag( TFLAG_SHARP, pos() ) && !one_in( 4 ) &&
             get_armor_cut( bodypart_id( "torso" ) ) < sharp_damage ) {
             apply_damage( nullptr, bodypart_id( "torso" ), sharp_damage );
         }
-        if( g->m.has_flag( "ROUGH", pos() ) && one_in( 6 ) &&
+        if( g->m.has_flag( TFLAG_ROUGH, pos() ) && one_in( 6 ) &&
             get_armor_cut( bodypart_id( "torso" ) ) < rough_damage ) {
             apply_damage( nullptr, bodypart_id( "torso" ), rough_damage );
         }
     }
 
-    if( g->m.has_flag( "UNSTABLE", destination ) && on_ground ) {
+    if( g->m.has_flag( TFLAG_UNSTABLE, destination ) && on_ground ) {
         add_effect( effect_bouldering, 1_turns, num_bp );
     } else if( has_effect( effect_bouldering ) ) {
         remove_effect( effect_bouldering );
@@ -1729,10 +1850,10 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
         return true;
     }
     if( !will_be_water && ( digs() || can_dig() ) ) {
-        set_underwater( g->m.has_flag( "DIGGABLE", pos() ) );
+        set_underwater( g->m.has_flag( TFLAG_DIGGABLE, pos() ) );
     }
     // Diggers turn the dirt into dirtmound
-    if( digging() && g->m.has_flag( "DIGGABLE", pos() ) ) {
+    if( digging() && g->m.has_flag( TFLAG_DIGGABLE, pos() ) ) {
         int factor = 0;
         switch( type->size ) {
             case creature_size::tiny:
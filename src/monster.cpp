@@ -43,6 +43,7 @@
 #include "mondefense.h"
 #include "monfaction.h"
 #include "mongroup.h"
+#include "monster_turn_stats.h"
 #include "morale_types.h"
 #include "mtype.h"
 #include "mutation.h"
@@ -1687,6 +1688,7 @@ void monster::melee_attack( Creature &target )
 
 void monster::melee_attack( Creature &target, float accuracy )
 {
+    const monster_turn_stats::phase_timer timer( monster_phase::attack );
     mod_moves( -type->attack_cost );
     if( type->melee_dice == 0 ) {
         // We don't attack, so just return
@@ -5,6 +5,7 @@
 #include <bitset>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <optional>
@@ -41,6 +42,7 @@ class item;
 class player;
 struct dealt_projectile_attack;
 struct pathfinding_settings;
+struct route_request;
 struct trap;
 
 template<typename T>
@@ -193,6 +195,10 @@ class monster : public Creature, public location_visitable<monster>
         void set_goal( const tripoint &p );
         // Updates current pos AND our plans
         bool wander(); // Returns true if we have no plans
+        // The route move() will ask for if the plans stay the same, nullopt if the current path does
+        std::optional<route_request> expected_route_request() const;
+        // Adds the lines of sight plan() is about to check, from us to the creatures it would target
+        void expected_sight_lines( std::vector<std::pair<tripoint, tripoint>> &lines ) const;
 
         /**
          * Checks whether we can move to/through p. This does not account for bashing.
@@ -486,6 +492,7 @@ class monster : public Creature, public location_visitable<monster>
         // TEMP VALUES
         tripoint wander_pos; // Wander destination - Just try to move in that direction
         int wandf;           // Urge to wander - Increased by sound, decrements each move
+        int distant_turns = 0; // Turns sat out while far from everyone, see game::monmove
 
 
         Character *mounted_player = nullptr; // player that is mounting this creature
@@ -596,6 +603,10 @@ class monster : public Creature, public location_visitable<monster>
         std::vector<detached_ptr<item>> remove_corpse_components();
 
     private:
+        // The traits of ours will_move_to() looks at as a mask, nullopt if it looks at more than that
+        std::optional<std::uint32_t> move_mode() const;
+        bool decide_move_to( const tripoint &p ) const;
+
         void process_trigger( mon_trigger trig, int amount );
         void process_trigger( mon_trigger trig, const std::function<int()> &amount_func );
 
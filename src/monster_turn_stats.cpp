@@ -0,0 +1,23 @@
+#include "monster_turn_stats.h"
+
+namespace monster_turn_stats
+{
+
+const char *phase_name( monster_phase phase )
+{
+    switch( phase ) {
+        case monster_phase::plan:
+            return "plan";
+        case monster_phase::move:
+            return "move";
+        case monster_phase::sees:
+            return "sees";
+        case monster_phase::attack:
+            return "attack";
+        case monster_phase::num_monster_phases:
+            break;
+    }
+    return "invalid";
+}
+
+} // namespace monster_turn_stats
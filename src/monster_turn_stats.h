@@ -0,0 +1,62 @@
+#pragma once
+#ifndef CATA_SRC_MONSTER_TURN_STATS_H
+#define CATA_SRC_MONSTER_TURN_STATS_H
+
+#include <cstdint>
+#include <string>
+
+#include "phase_stats.h"
+
+/** The parts of a monster's turn that are timed separately. */
+enum class monster_phase : int {
+    /** Choosing a target and where to go, @ref monster::plan. */
+    plan,
+    /** Taking steps, @ref monster::move, which includes its attacks and route searches. */
+    move,
+    /** Tracing the lines of sight monsters plan with, all at once at the start of the turn. */
+    sees,
+    /** Melee and special attacks made while moving. */
+    attack,
+    num_monster_phases
+};
+
+/**
+ * Wall time spent in each phase of the monsters' turns. The time spent searching for
+ * routes is kept by @ref pathfinding_stats instead.
+ */
+namespace monster_turn_stats
+{
+
+const char *phase_name( monster_phase phase );
+
+using stats = phase_stats::per_phase<monster_phase, monster_phase::num_monster_phases,
+      phase_name>;
+/**
+ * Adds the time from its creation to its end to `phase`.
+ * Timers of a phase started on the same thread while it is timed count as part of that one.
+ */
+using phase_timer = stats::timer;
+
+/** How many times the phase was timed since the last reset. */
+inline std::uint64_t count( monster_phase phase )
+{
+    return stats::count( phase );
+}
+inline std::uint64_t microseconds( monster_phase phase )
+{
+    return stats::microseconds( phase );
+}
+
+inline void reset()
+{
+    stats::reset();
+}
+/** One line for each phase that was timed since the last reset. */
+inline std::string report()
+{
+    return stats::report();
+}
+
+} // namespace monster_turn_stats
+
+#endif // CATA_SRC_MONSTER_TURN_STATS_H
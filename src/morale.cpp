@@ -523,14 +523,20 @@ int player_morale::get_level() const
 
 void player_morale::decay( const time_duration &ticks )
 {
-    const auto do_decay = [ &ticks ]( morale_point & m ) {
+    // Points only lose value after their decay start, and then in whole steps,
+    // so most calls leave the cached level as it is
+    bool changed = false;
+    for( morale_point &m : points ) {
+        const int prev_bonus = m.get_net_bonus();
         m.decay( ticks );
-    };
-
-    std::for_each( points.begin(), points.end(), do_decay );
+        changed = changed || m.get_net_bonus() != prev_bonus;
+    }
+    if( changed ) {
+        invalidate();
+    }
+    // Both invalidate the level themselves when they change it
     remove_expired();
     update_bodytemp_penalty( ticks );
-    invalidate();
 }
 
 void player_morale::display( int focus_eq, int pain_penalty, int fatigue_cap )
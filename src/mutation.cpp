@@ -100,7 +100,9 @@ std::string enum_to_string<mutagen_technique>( mutagen_technique data )
 
 bool Character::has_trait( const trait_id &b ) const
 {
-    return my_mutations.count( b ) || enchantment_cache->get_mutations().contains( b );
+    const int index = mutation_branch::get_index( b );
+    return index >= 0 && static_cast<size_t>( index ) < cached_mutation_bits.size() &&
+           cached_mutation_bits[index];
 }
 
 bool Character::has_trait_flag( const trait_flag_str_id &b ) const
@@ -549,7 +551,7 @@ void Character::activate_mutation( const trait_id &mut )
         // Check for adjacent trees.
         bool adjacent_tree = false;
         for( const tripoint &p2 : g->m.points_in_radius( pos(), 1 ) ) {
-            if( g->m.has_flag( "TREE", p2 ) ) {
+            if( g->m.has_flag( TFLAG_TREE, p2 ) ) {
                 adjacent_tree = true;
             }
         }
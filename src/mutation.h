@@ -310,6 +310,11 @@ struct mutation_branch {
          * also get by calling @ref get.
          */
         static const std::vector<mutation_branch> &get_all();
+        /**
+         * Dense index of the mutation in @ref get_all, stable once all mutations are loaded,
+         * or -1 for an invalid id.
+         */
+        static int get_index( const trait_id &mutation_id );
         // For init.cpp: reset (clear) the mutation data
         static void reset_all();
         // For init.cpp: load mutation data from json
@@ -622,6 +622,14 @@ std::string mutation_branch::get_name( const trait_id &mutation_id )
     return mutation_id->name();
 }
 
+int mutation_branch::get_index( const trait_id &mutation_id )
+{
+    if( !mutation_id.is_valid() ) {
+        return -1;
+    }
+    return trait_factory.convert( mutation_id, int_id<mutation_branch>() ).to_i();
+}
+
 const std::vector<mutation_branch> &mutation_branch::get_all()
 {
     return trait_factory.get_all();
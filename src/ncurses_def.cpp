@@ -182,7 +182,9 @@ void catacurses::wredrawln( const window &win, const int beg_line, const int num
 
 void catacurses::wclear( const window &win )
 {
-    return curses_check_result( ::wclear( win.get<::WINDOW>() ), OK, "wclear" );
+    // ::wclear would also make the next refresh repaint the whole terminal instead of
+    // sending only the cells that changed, the game only wants the window blanked
+    return curses_check_result( ::werase( win.get<::WINDOW>() ), OK, "wclear" );
 }
 
 void catacurses::curs_set( const int visibility )
@@ -282,7 +284,7 @@ void input_manager::pump_events()
     previously_pressed_key = 0;
 }
 
-input_event input_manager::get_input_event()
+input_event input_manager::get_device_input_event()
 {
     int key = ERR;
     input_event rval;
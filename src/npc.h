@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
@@ -505,6 +506,10 @@ struct npc_short_term_cache {
     // Use weak_ptr to avoid circular references between Creatures
     std::vector<weak_ptr_fast<Creature>> friends;
     std::vector<sphere> dangerous_explosives;
+    // The turn, position and count of explosives added dangerous_explosives was found for
+    int explosives_turn = -1;
+    tripoint explosives_pos;
+    std::uint64_t explosives_added = 0;
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
@@ -925,6 +930,8 @@ class npc : public player
         void regen_ai_cache();
         const Creature *current_target() const;
         Creature *current_target();
+        /** Whether it had a target, or something to run from, when it last looked around. */
+        bool in_danger() const;
         const Creature *current_ally() const;
         Creature *current_ally();
         tripoint good_escape_direction( bool include_pos = true );
@@ -1007,6 +1014,11 @@ class npc : public player
 
         // Movement; the following are defined in npcmove.cpp
         void move(); // Picks an action & a target and calls execute_action
+        /**
+         * Takes the next step of the activity or path the NPC is on, without looking around
+         * or deciding anything again. False if there is none, or it was in danger when it last did.
+         */
+        bool continue_action();
         void execute_action( npc_action action ); // Performs action
         void process_turn() override;
 
@@ -1240,6 +1252,7 @@ class npc : public player
         // Player orders a friendly NPC to move to this position
         std::optional<tripoint_abs_ms> goto_to_this_pos;
         int last_seen_player_turn = 0; // Timeout to forgetting
+        int deferred_turns = 0; // Turns its decisions were put off for, see game::monmove
         tripoint wanted_item_pos; // The square containing an item we want
         tripoint guard_pos;  // These are the local coordinates that a guard will return to inside of their goal tripoint
         tripoint chair_pos = tripoint_min; // This is the spot the NPC wants to move to to sit and relax.
@@ -1330,6 +1343,19 @@ class npc : public player
         // Copy of toggled CBM weapon for comparisons;
         location_ptr<item, false> cbm_fake_toggled;
 
+        // How good each weapon was the last time wield_better_weapon compared them
+        struct weapon_score {
+            // What the item was like when it was scored
+            std::size_t item_state = 0;
+            int last_compared = 0;
+            std::optional<double> melee;
+            std::map<gun_mode_id, double> ranged;
+        };
+        std::unordered_map<const item *, weapon_score> weapon_scores;
+        // Stats, skills and encumbrance the scores were worked out with
+        std::size_t weapon_scores_state = 0;
+        int weapon_comparisons = 0;
+
         bool dead = false;  // If true, we need to be cleaned up
 
         bool sees_dangerous_field( const tripoint &p ) const;
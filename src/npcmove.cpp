@@ -4,17 +4,21 @@
 #include <cfloat>
 #include <climits>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <tuple>
+#include <unordered_map>
 
 #include "active_item_cache.h"
 #include "activity_handlers.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "calendar.h"
 #include "cata_algo.h"
 #include "character.h"
 #include "character_functions.h"
@@ -35,6 +39,7 @@
 #include "game_constants.h"
 #include "gates.h"
 #include "gun_mode.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_contents.h"
 #include "item_functions.h"
@@ -42,6 +47,7 @@
 #include "iuse.h"
 #include "iuse_actor.h"
 #include "line.h"
+#include "line_memo.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "mapdata.h"
@@ -56,10 +62,12 @@
 #include "overmapbuffer.h"
 #include "player_activity.h"
 #include "pldata.h"
+#include "profile.h"
 #include "projectile.h"
 #include "ranged.h"
 #include "ret_val.h"
 #include "rng.h"
+#include "skill.h"
 #include "sounds.h"
 #include "stomach.h"
 #include "translations.h"
@@ -191,7 +199,7 @@ bool compare_sound_alert( const dangerous_sound &sound_a, const dangerous_sound
     return sound_a.volume < sound_b.volume;
 }
 
-static bool clear_shot_reach( const tripoint &from, const tripoint &to, bool check_ally = true )
+static bool trace_clear_shot( const tripoint &from, const tripoint &to, bool check_ally )
 {
     std::vector<tripoint> path = line_to( from, to );
     tripoint target_point = path.back();
@@ -215,6 +223,28 @@ static bool clear_shot_reach( const tripoint &from, const tripoint &to, bool che
     return !get_map().obstructed_by_vehicle_rotation( last_point, target_point );
 }
 
+static bool clear_shot_reach( const tripoint &from, const tripoint &to, bool check_ally = true )
+{
+    if( check_ally ) {
+        return trace_clear_shot( from, to, check_ally );
+    }
+    // Without creatures in the way only terrain and vehicles count, the same as for
+    // map::clear_path, so it's remembered with those. Move costs that high never reach there.
+    map &here = get_map();
+    const std::optional<std::uint64_t> key = line_memo::key( from, to, 0xFF, 0xFF );
+    if( key ) {
+        const int cached = here.get_clear_path_cache().get( *key );
+        if( cached >= 0 ) {
+            return cached > 0;
+        }
+    }
+    const bool is_clear = trace_clear_shot( from, to, check_ally );
+    if( key ) {
+        here.get_clear_path_cache().insert( *key, is_clear );
+    }
+    return is_clear;
+}
+
 tripoint npc::good_escape_direction( bool include_pos )
 {
     map &here = get_map();
@@ -624,12 +654,54 @@ void npc::assess_danger()
     ai_cache.danger_assessment = assessment;
 }
 
+namespace
+{
+
+// The parts of a character's danger that don't depend on who is looking at them
+struct character_profile {
+    const Character *who = nullptr;
+    double weapon_value = 0.0;
+    bool gun = false;
+    float dodge = 0.0f;
+    int speed = 0;
+};
+
+// Every NPC around sizes up the same characters, so that's done once a turn
+std::unordered_map<int, character_profile> character_profiles;
+std::optional<time_point> character_profiles_turn;
+
+character_profile profile_of( const Character &who )
+{
+    if( character_profiles_turn != calendar::turn ) {
+        character_profiles.clear();
+        character_profiles_turn = calendar::turn;
+    }
+    const int id = who.getID().get_value();
+    const auto found = character_profiles.find( id );
+    if( found != character_profiles.end() && found->second.who == &who ) {
+        return found->second;
+    }
+    character_profile ret;
+    ret.who = &who;
+    ret.weapon_value = npc_ai::wielded_value( who );
+    ret.gun = who.primary_weapon().is_gun();
+    ret.dodge = who.get_dodge();
+    ret.speed = who.get_speed();
+    if( who.getID().is_valid() ) {
+        character_profiles[id] = ret;
+    }
+    return ret;
+}
+
+} // namespace
+
 float npc::character_danger( const Character &u ) const
 {
     float ret = 0.0;
-    bool u_gun = u.primary_weapon().is_gun();
+    const character_profile profile = profile_of( u );
+    bool u_gun = profile.gun;
     bool my_gun = primary_weapon().is_gun();
-    double u_weap_val = npc_ai::wielded_value( u );
+    double u_weap_val = profile.weapon_value;
     const double &my_weap_val = ai_cache.my_weapon_value;
     if( u_gun && !my_gun ) {
         u_weap_val *= 1.5f;
@@ -638,9 +710,9 @@ float npc::character_danger( const Character &u ) const
 
     ret += hp_percentage() * get_hp_max( bodypart_id( "torso" ) ) / 100.0 / my_weap_val;
 
-    ret += my_gun ? u.get_dodge() / 2 : u.get_dodge();
+    ret += my_gun ? profile.dodge / 2 : profile.dodge;
 
-    ret *= std::max( 0.5, u.get_speed() / 100.0 );
+    ret *= std::max( 0.5, profile.speed / 100.0 );
 
     add_msg( m_debug, "%s danger: %1f", u.disp_name(), ret );
     return ret;
@@ -648,6 +720,7 @@ float npc::character_danger( const Character &u ) const
 
 void npc::regen_ai_cache()
 {
+    ZoneScoped;
     map &here = get_map();
     auto i = std::begin( ai_cache.sound_alerts );
     while( i != std::end( ai_cache.sound_alerts ) ) {
@@ -668,7 +741,17 @@ void npc::regen_ai_cache()
     ai_cache.danger = 0.0f;
     ai_cache.total_danger = 0.0f;
     ai_cache.my_weapon_value = npc_ai::wielded_value( *this );
-    ai_cache.dangerous_explosives = find_dangerous_explosives();
+    // Explosives only get more dangerous as time passes or the NPC moves, or when new ones
+    // are lit or thrown, so the NPC keeps what it found for the rest of its turn otherwise
+    const int turn = to_turn<int>( calendar::turn );
+    const std::uint64_t explosives_added = active_item_cache::explosives_added();
+    if( ai_cache.explosives_turn != turn || ai_cache.explosives_pos != pos() ||
+        ai_cache.explosives_added != explosives_added ) {
+        ai_cache.dangerous_explosives = find_dangerous_explosives();
+        ai_cache.explosives_turn = turn;
+        ai_cache.explosives_pos = pos();
+        ai_cache.explosives_added = explosives_added;
+    }
 
     assess_danger();
     if( old_assessment > NPC_DANGER_VERY_LOW && ai_cache.danger_assessment <= 0 ) {
@@ -700,6 +783,7 @@ void npc::regen_ai_cache()
 
 void npc::move()
 {
+    ZoneScoped;
     // don't just return from this function without doing something
     // that will eventually subtract moves, or change the NPC to a different type of action.
     // because this will result in an infinite loop
@@ -941,6 +1025,24 @@ void npc::move()
     execute_action( action );
 }
 
+bool npc::continue_action()
+{
+    if( in_danger() || !ai_cache.sound_alerts.empty() || has_effect( effect_npc_run_away ) ||
+        has_effect( effect_npc_fire_bad ) ) {
+        return false;
+    }
+    if( activity->id() == activity_id( "ACT_OPERATION" ) ||
+        ( has_player_activity() && !has_destination_activity() ) ) {
+        execute_action( npc_player_activity );
+        return true;
+    }
+    if( !path.empty() && !is_walking_with() && get_map().passable( path.front() ) ) {
+        move_to_next();
+        return true;
+    }
+    return false;
+}
+
 void npc::execute_action( npc_action action )
 {
     int oldmoves = moves;
@@ -2413,7 +2515,7 @@ void npc::move_to( const tripoint &pt, bool no_bashing, std::set<tripoint> *nomo
             moves -= 100;
             moved = true;
         }
-    } else if( get_dex() > 1 && here.has_flag_ter_or_furn( "CLIMBABLE", p ) &&
+    } else if( get_dex() > 1 && here.has_flag_ter_or_furn( TFLAG_CLIMBABLE, p ) &&
                !ceiling_blocking_climb ) {
         ///\EFFECT_DEX_NPC increases chance to climb CLIMBABLE furniture or terrain
         int climb = get_dex();
@@ -2458,7 +2560,7 @@ void npc::move_to( const tripoint &pt, bool no_bashing, std::set<tripoint> *nomo
                 here.creature_on_trap( *mounted_creature );
             }
         }
-        if( here.has_flag( "UNSTABLE", pos() ) ) {
+        if( here.has_flag( TFLAG_UNSTABLE, pos() ) ) {
             add_effect( effect_bouldering, 1_turns, bodypart_str_id::NULL_ID() );
         } else if( has_effect( effect_bouldering ) ) {
             remove_effect( effect_bouldering );
@@ -2755,22 +2857,24 @@ void npc::find_item()
         return;
     }
 
+    // Looked up once, not for every item
+    std::vector<npc *> followers;
+    for( auto &elem : g->get_follower_list() ) {
+        shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
+        if( !npc_to_get ) {
+            continue;
+        }
+        npc *npc_to_add = npc_to_get.get();
+        followers.push_back( npc_to_add );
+    }
+
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&wanted, &best_value, &followers, whitelisting, volume_allowed, weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of( LIQUID ) ) {
             // Don't even consider liquids.
             return;
         }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
         Character &player_character = get_player_character();
         for( auto &elem : followers ) {
             if( !it.is_owned_by( *this, true ) && ( player_character.sees( this->pos() ) ||
@@ -2816,14 +2920,6 @@ void npc::find_item()
     };
 
     for( const tripoint &p : closest_points_first( pos(), range ) ) {
-        // TODO: Make this sight check not overdraw nearby tiles
-        // TODO: Optimize that zone check
-        if( is_player_ally() && g->check_zone( zone_type_no_npc_pickup, p ) ) {
-            continue;
-        }
-
-        const tripoint abs_p = global_square_location() - pos() + p;
-        const int prev_num_items = ai_cache.searched_tiles.get( abs_p, -1 );
         // Prefetch the number of items present so we can bail out if we already checked here.
         const map_stack m_stack = here.i_at( p );
         int num_items = m_stack.size();
@@ -2835,6 +2931,19 @@ void npc::find_item()
                 num_items += v_stack.size();
             }
         }
+        if( num_items == 0 && !whitelisting ) {
+            // Nothing here to pick up, and plants are only picked by whitelist
+            continue;
+        }
+
+        // TODO: Make this sight check not overdraw nearby tiles
+        // TODO: Optimize that zone check
+        if( is_player_ally() && g->check_zone( zone_type_no_npc_pickup, p ) ) {
+            continue;
+        }
+
+        const tripoint abs_p = global_square_location() - pos() + p;
+        const int prev_num_items = ai_cache.searched_tiles.get( abs_p, -1 );
         if( prev_num_items == num_items ) {
             continue;
         }
@@ -3330,6 +3439,39 @@ bool npc::do_player_activity()
     return moves != old_moves;
 }
 
+// Everything about the item its weapon scores depend on
+static std::size_t weapon_state( const item &it )
+{
+    std::size_t ret = 0;
+    cata::hash_combine( ret, it.typeId() );
+    cata::hash_combine( ret, it.charges );
+    cata::hash_combine( ret, it.damage() );
+    cata::hash_combine( ret, it.ammo_remaining() );
+    cata::hash_combine( ret, it.ammo_current() );
+    // Mods and magazines
+    cata::hash_combine( ret, it.contents.num_item_stacks() );
+    return ret;
+}
+
+// Everything about the wielder weapon scores depend on
+static std::size_t wielder_state( const Character &who )
+{
+    std::size_t ret = 0;
+    cata::hash_combine( ret, who.str_cur );
+    cata::hash_combine( ret, who.dex_cur );
+    cata::hash_combine( ret, who.per_cur );
+    cata::hash_combine( ret, who.int_cur );
+    for( const Skill &sk : Skill::skills ) {
+        cata::hash_combine( ret, who.get_skill_level( sk.ident() ) );
+    }
+    for( const char *const bp : {
+             "torso", "arm_l", "arm_r", "hand_l", "hand_r"
+         } ) {
+        cata::hash_combine( ret, who.encumb( bodypart_str_id( bp ) ) );
+    }
+    return ret;
+}
+
 bool npc::wield_better_weapon()
 {
     const Creature *critter = current_target();
@@ -3354,15 +3496,41 @@ bool npc::wield_better_weapon()
     double best_dps = -1;
     std::map<itype_id, gun_mode_id> mode_pairs;
 
+    // Scores are kept until the weapon or what we can do with it changes
+    const std::size_t state = wielder_state( *this );
+    if( state != weapon_scores_state ) {
+        weapon_scores.clear();
+        weapon_scores_state = state;
+    }
+    weapon_comparisons++;
+    const auto score_of = [this]( const item & it ) -> weapon_score & {
+        const std::size_t item_state = weapon_state( it );
+        weapon_score &score = weapon_scores[&it];
+        if( score.item_state != item_state )
+        {
+            score = weapon_score();
+            score.item_state = item_state;
+        }
+        score.last_compared = weapon_comparisons;
+        return score;
+    };
+
     const auto compare_weapon =
-    [this, &best, &best_dps, can_use_gun, use_silent, dist, &mode_pairs ]( const item & it ) {
+    [this, &best, &best_dps, can_use_gun, use_silent, dist, &mode_pairs, &score_of ]( const item & it ) {
         // If dist is 1 then we're in melee range, so disallow shooting guns.
         bool gun_usable = can_use_gun && ( dist > 1 || dist == -1 ) && ( !use_silent || it.is_silent() );
         double dps = 0.0f;
         auto [mode_id, mode_] = npc_ai::best_mode_for_range( *this, it, dist );
+        weapon_score &score = score_of( it );
 
         if( mode_ && gun_usable ) {
-            dps = it.ideal_ranged_dps( *this, mode_ );
+            const auto known = score.ranged.find( mode_id );
+            if( known != score.ranged.end() ) {
+                dps = known->second;
+            } else {
+                dps = it.ideal_ranged_dps( *this, mode_ );
+                score.ranged.emplace( mode_id, dps );
+            }
             mode_pairs[it.typeId()] = mode_id;
 
             if( dps > best_dps ) {
@@ -3373,7 +3541,10 @@ bool npc::wield_better_weapon()
             if( dist > 0 && dist > it.reach_range( *this ) ) {
                 return;
             }
-            dps = npc_ai::melee_value( *this, it );
+            if( !score.melee ) {
+                score.melee = npc_ai::melee_value( *this, it );
+            }
+            dps = *score.melee;
 
             if( dps > best_dps ) {
                 if( it.is_gun() ) {
@@ -3418,6 +3589,14 @@ bool npc::wield_better_weapon()
     }
 
     set_npc_ai_info_cache( npc_ai_info::range, dist );
+    // Forget weapons we no longer have
+    for( auto it = weapon_scores.begin(); it != weapon_scores.end(); ) {
+        if( it->second.last_compared != weapon_comparisons ) {
+            it = weapon_scores.erase( it );
+        } else {
+            ++it;
+        }
+    }
 
     // TODO: Reimplement switching to empty guns
     // Needs to check reload speed, RELOAD_ONE etc.
@@ -4309,6 +4488,12 @@ Creature *npc::current_target()
     return ai_cache.target.lock().get();
 }
 
+bool npc::in_danger() const
+{
+    return ai_cache.danger > 0 || current_target() != nullptr ||
+           !ai_cache.dangerous_explosives.empty();
+}
+
 const Creature *npc::current_ally() const
 {
     // TODO: Arguably we should return a shared_ptr to ensure that the returned
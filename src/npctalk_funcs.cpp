@@ -39,6 +39,7 @@
 #include "output.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "pathfinding_stats.h"
 #include "pimpl.h"
 #include "player.h"
 #include "player_activity.h"
@@ -312,6 +313,7 @@ void talk_function::goto_location( npc &p )
         destination = g->u.global_omt_location();
     }
     p.goal = destination;
+    const pathfinding_stats::caller_scope tag( route_caller::npc );
     p.omt_path = overmap_buffer.get_travel_path( p.global_omt_location(), p.goal,
                  overmap_path_params::for_npc() );
     if( destination == tripoint_abs_omt() || destination == overmap::invalid_tripoint ||
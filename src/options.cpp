@@ -1422,6 +1422,33 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "AUTOSAVE_BACKGROUND", general, translate_marker( "Write autosaves in background" ),
+         translate_marker( "If true, autosaves write map and overmap files to disk on a background thread instead of making the game wait for them.  Manual saves and saving on exit always finish before continuing." ),
+         false
+       );
+
+    get_option( "AUTOSAVE_BACKGROUND" ).setPrerequisite( "AUTOSAVE" );
+
+    add( "WORKER_THREADS", general, translate_marker( "Worker threads" ),
+         translate_marker( "Number of threads, besides the main one, that share work like building the lighting and vision caches and searching for routes.  -1 picks a number from the cores of your processor, 0 does everything on the main thread." ),
+         -1, 64, -1
+       );
+
+    add( "FAST_FORWARD_WAITING", general, translate_marker( "Fast-forward sleep and waiting" ),
+         translate_marker( "If true, while you sleep or wait with nothing hostile nearby or after anything, the game updates lighting and vision only every few turns and lets wandering monsters think less often.  Anything that comes close goes back to full detail at once." ),
+         true
+       );
+
+    add( "FAST_FORWARD_TRAVEL", general, translate_marker( "Fast-forward travel" ),
+         translate_marker( "If true, while you travel with no creature in view distance, the game updates lighting and vision only for redraws and every few turns.  Anything that comes into view goes back to full detail at once." ),
+         true
+       );
+
+    add( "MAP_MEMORY_BUDGET", general, translate_marker( "Map memory budget (MB)" ),
+         translate_marker( "Approximate amount of memory the loaded map may use.  When it is exceeded, the least recently visited areas outside of the reality bubble are saved and unloaded.  Areas powering an electric grid stay loaded.  0 means no limit." ),
+         0, 16384, 0
+       );
+
     add_empty_line();
 
     add( "AUTO_NOTES", general, translate_marker( "Auto notes" ),
@@ -2176,6 +2203,30 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "VERIFY_LIGHTMAP", debug, translate_marker( "Verify kept lightmap" ),
+         translate_marker( "If true, the lightmap is rebuilt even on turns where no light changed and an error is shown if it differs from the kept one.  Slow." ),
+         false
+       );
+
+#if defined(LUA)
+    add_empty_line();
+
+    add( "LUA_CALL_TIME_LIMIT", debug, translate_marker( "Lua call time limit" ),
+         translate_marker( "How many milliseconds a single hook or item use written in a mod's Lua code may run before it is stopped with an error.  0 for no limit." ),
+         0, 60000, 5000
+       );
+
+    add( "LUA_TURN_TIME_LIMIT", debug, translate_marker( "Lua turn time limit" ),
+         translate_marker( "How many milliseconds all the hooks and item uses written in mods' Lua code may run for in one turn, after which they are stopped with an error.  0 for no limit." ),
+         0, 60000, 0
+       );
+#endif // LUA
+
+    add( "SLOW_TURN_LOG_THRESHOLD", debug, translate_marker( "Slow turn log threshold" ),
+         translate_marker( "Turns that take the game longer than this many milliseconds, not counting your own actions, are written to the debug log together with the time each part of the turn took.  0 to log none of them." ),
+         0, 60000, 500
+       );
+
     add_empty_line();
 
     add_option_group( debug, Group( "debug_log", to_translation( "Logging" ),
@@ -2271,6 +2322,13 @@ void options_manager::add_options_debug()
          true
        );
 
+    add( "SIMULATION_AREAS", debug, translate_marker( "Remote grids kept running" ),
+         translate_marker( "Number of electric grids away from you that keep running, for those with solar panels, chargers and the like.  What else time does to the places around them, like food rotting and plants growing, is then caught up with every hour instead of all at once when you return.  0 lets them wait for your return." ),
+         0, 16, 4
+       );
+
+    get_option( "SIMULATION_AREAS" ).setPrerequisite( "ELECTRIC_GRID" );
+
     add( "MADE_OF_EXPLODIUM", debug, translate_marker( "Made of explodium" ),
          translate_marker( "Explosive items and traps will detonate when hit by damage exceeding the threshold.  A higher number means more damage is required to detonate.  Set to 0 to disable." ),
          0, 1000, 30 );
@@ -2380,6 +2438,16 @@ void options_manager::add_options_world_default()
          1, 1000, 100, COPT_NO_HIDE, "%i%%"
        );
 
+    add( "MONSTER_DETAIL_DISTANCE", world_default, translate_marker( "Distant monster detail" ),
+         translate_marker( "Monsters farther than this from you and every NPC, and not after anything, only decide what to do every few turns and then take those turns' moves at once.  0 keeps all monsters fully detailed." ),
+         0, 200, 60
+       );
+
+    add( "NPC_AI_BUDGET", world_default, translate_marker( "NPC thinking budget" ),
+         translate_marker( "How many NPCs away from you and not fighting may decide what to do each turn.  The rest carry on with what they were doing until their turn comes, at most a few turns later.  0 lets every NPC decide every turn." ),
+         0, 1000, 20
+       );
+
     add_empty_line();
 
     add( "DEFAULT_REGION", world_default, translate_marker( "Default region type" ),
@@ -2471,6 +2539,20 @@ void options_manager::add_options_world_default()
     "any"
        );
 
+    add_empty_line();
+
+    add( "MAP_STORAGE_FORMAT", world_default, translate_marker( "Map storage format" ),
+         translate_marker( "Format used to save map data of this world.  JSON is human readable and useful for debugging, binary is smaller and much faster to save and load.  Existing map files are converted the next time they are saved." ),
+    { { "json", translate_marker( "JSON" ) }, { "binary", translate_marker( "Binary" ) } },
+    "json"
+       );
+
+    add( "MAP_STORAGE_LAYOUT", world_default, translate_marker( "Map file layout" ),
+         translate_marker( "How map data of this world is split into files.  One file per quad is the classic layout, segment archives pack each 32x32 overmap terrain area into a single file, which is much friendlier to file systems and backups on big worlds.  Existing files are moved into archives the next time they are saved." ),
+    { { "files", translate_marker( "One file per quad" ) }, { "segments", translate_marker( "Segment archives" ) } },
+    "files"
+       );
+
     add( "DISABLE_LIFTING", world_default,
          translate_marker( "Disables lifting requirements for vehicle parts." ),
          translate_marker( "If true, strength checks and/or lifting qualities no longer need to be met in order to change parts." ),
@@ -3448,6 +3530,7 @@ void options_manager::cache_to_globals()
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
+    worker_threads = ::get_option<int>( "WORKER_THREADS" );
 
     merge_comestible_mode = ( [] {
         const auto opt = ::get_option<std::string>( "MERGE_COMESTIBLES" );
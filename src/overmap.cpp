@@ -15,17 +15,20 @@
 #include <optional>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <unordered_set>
 #include <vector>
 
 #include "all_enum_values.h"
 #include "assign.h"
+#include "background_saver.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "character_id.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
 #include "distribution.h"
+#include "filesystem.h"
 #include "flood_fill.h"
 #include "fstream_utils.h"
 #include "game.h"
@@ -51,6 +54,7 @@
 #include "overmap_noise.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "profile.h"
 #include "regional_settings.h"
 #include "rng.h"
 #include "rotatable_symbols.h"
@@ -2635,10 +2639,11 @@ std::vector<overmap_special_terrain> overmap_special::preview_terrains() const
     return result;
 }
 
-std::vector<overmap_special_locations> overmap_special::required_locations() const
+const std::vector<overmap_special_locations> &overmap_special::required_locations() const
 {
-    // TODO: It's called a lot during mapgen, and should probably be cached
-    // instead of making thousands of copies
+    if( required_locations_ ) {
+        return *required_locations_;
+    }
     std::vector<overmap_special_locations> result = data_->required_locations();
 
     for( const auto &nested : get_nested_specials() ) {
@@ -2648,7 +2653,8 @@ std::vector<overmap_special_locations> overmap_special::required_locations() con
             result.push_back( rel_loc );
         }
     }
-    return result;
+    required_locations_ = std::move( result );
+    return *required_locations_;
 }
 
 
@@ -2935,11 +2941,11 @@ oter_id overmap::get_default_terrain( int z ) const
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
+        layer[k].fill_terrain( get_default_terrain( k - OVERMAP_DEPTH ) );
+        unloaded_layers[k].reset();
 
         for( int i = 0; i < OMAPX; ++i ) {
             for( int j = 0; j < OMAPY; ++j ) {
-                layer[k].terrain[i][j] = tid;
                 layer[k].visible[i][j] = false;
                 layer[k].explored[i][j] = false;
                 layer[k].path[i][j] = false;
@@ -2955,7 +2961,9 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    ensure_layer_loaded( p.z() );
+    layer[p.z() + OVERMAP_DEPTH].ter_set( p.xy().raw(), id );
+    overmap_buffer.invalidate_travel_paths();
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -2965,7 +2973,8 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
         return ot_null;
     }
 
-    return layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
+    ensure_layer_loaded( p.z() );
+    return layer[p.z() + OVERMAP_DEPTH].ter( p.xy().raw() );
 }
 
 std::string *overmap::join_used_at( const om_pos_dir &p )
@@ -3733,15 +3742,16 @@ void overmap::move_hordes()
                 mg.pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
+            // Move the group to its new location, without copying the monsters it carries
+            auto node = zg.extract( it++ );
+            node.key() = mg.pos;
+            tmpzg.insert( std::move( node ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    zg.merge( tmpzg );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -4112,9 +4122,23 @@ void overmap::place_lakes()
 {
     const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
 
-    const auto is_lake = [&]( const point_om_omt & p ) {
+    const auto noise_is_lake = [&]( const point_om_omt & p ) {
         return f.noise_at( p ) > settings->overmap_lake.noise_threshold_lake;
     };
+    // The flood fill asks about each point several times, so look up the noise
+    // for this overmap once; lakes running off the edge still ask the noise directly
+    std::vector<bool> lake_here( OMAPX * OMAPY );
+    for( int i = 0; i < OMAPX; i++ ) {
+        for( int j = 0; j < OMAPY; j++ ) {
+            lake_here[i * OMAPY + j] = noise_is_lake( point_om_omt( i, j ) );
+        }
+    }
+    const auto is_lake = [&]( const point_om_omt & p ) {
+        if( inbounds( p ) ) {
+            return static_cast<bool>( lake_here[p.x() * OMAPY + p.y()] );
+        }
+        return noise_is_lake( p );
+    };
 
     const oter_id lake_surface( "lake_surface" );
     const oter_id lake_shore( "lake_shore" );
@@ -4154,19 +4178,16 @@ void overmap::place_lakes()
             // we just found AND all of the rivers on the map, because we want our lakes to write
             // over any rivers that are placed already. Note that the assumption here is that river
             // overmap generation (e.g. place_rivers) runs BEFORE lake overmap generation.
+            // The rivers are looked up as the neighbours are, since only the lake points
+            // below are written to before then.
             std::unordered_set<point_om_omt> lake_set;
             for( auto &p : lake_points ) {
                 lake_set.emplace( p );
             }
-
-            for( int x = 0; x < OMAPX; x++ ) {
-                for( int y = 0; y < OMAPY; y++ ) {
-                    const tripoint_om_omt p( x, y, 0 );
-                    if( ter( p )->is_river() ) {
-                        lake_set.emplace( p.xy() );
-                    }
-                }
-            }
+            const auto lake_or_river = [&]( const point_om_omt & n ) {
+                return lake_set.find( n ) != lake_set.end() ||
+                       ( inbounds( n ) && ter( tripoint_om_omt( n, 0 ) )->is_river() );
+            };
 
             // Iterate through all of our lake points, rejecting the ones that are out of bounds. For
             // those that are inbounds, look at the 8 adjacent locations and see if they are also part
@@ -4183,7 +4204,7 @@ void overmap::place_lakes()
                 for( int ni = -1; ni <= 1 && !shore; ni++ ) {
                     for( int nj = -1; nj <= 1 && !shore; nj++ ) {
                         const point_om_omt n = p + point( ni, nj );
-                        if( lake_set.find( n ) == lake_set.end() ) {
+                        if( !lake_or_river( n ) ) {
                             shore = true;
                         }
                     }
@@ -4442,15 +4463,17 @@ void overmap::place_swamps()
                 continue;
             }
 
+            // Both checks below use the same noise, which is the expensive part
+            const float noise = f.noise_at( pos.xy() );
+
             // If this was a part of our buffered floodplain, and the noise here meets the threshold, and the one_in rng
             // triggers, then we should flood this location and make it a swamp.
-            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) && f.noise_at( { x, y } )
+            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) && noise
                                         > settings->overmap_forest.noise_threshold_swamp_adjacent_water );
 
             // If this location meets our isolated swamp threshold, regardless of floodplain values, we'll make it
             // into a swamp.
-            const bool should_isolated_swamp = f.noise_at( pos.xy() ) >
-                                               settings->overmap_forest.noise_threshold_swamp_isolated;
+            const bool should_isolated_swamp = noise > settings->overmap_forest.noise_threshold_swamp_isolated;
             if( should_flood || should_isolated_swamp )  {
                 ter_set( pos, forest_water );
             }
@@ -5002,11 +5025,23 @@ const std::vector<point_om_omt> &overmap_connection_cache::get_all( const overma
 std::vector<point_om_omt> overmap_connection_cache::get_closests(
     const overmap_connection_id &id, const int z, const point_om_omt &pos )
 {
-    std::vector<point_om_omt> sorted = get_all( id, z );
-    std::sort( sorted.begin(), sorted.end(), [&pos]( point_om_omt & a, point_om_omt & b ) {
-        return rl_dist( pos, a ) < rl_dist( pos, b );
+    const std::vector<point_om_omt> &all = get_all( id, z );
+    // Distances are worked out once rather than on every comparison
+    std::vector<std::pair<int, point_om_omt>> by_dist;
+    by_dist.reserve( all.size() );
+    for( const point_om_omt &p : all ) {
+        by_dist.emplace_back( rl_dist( pos, p ), p );
+    }
+    std::sort( by_dist.begin(), by_dist.end(), []( const std::pair<int, point_om_omt> &a,
+    const std::pair<int, point_om_omt> &b ) {
+        return a.first < b.first;
     } );
 
+    std::vector<point_om_omt> sorted;
+    sorted.reserve( by_dist.size() );
+    for( const std::pair<int, point_om_omt> &elem : by_dist ) {
+        sorted.push_back( elem.second );
+    }
     return sorted;
 }
 
@@ -5501,7 +5536,7 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
         return false;
     }
 
-    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
+    const std::vector<overmap_special_locations> &fixed_terrains = special.required_locations();
 
     return std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
     [&]( const overmap_special_locations & elem ) {
@@ -6078,15 +6113,35 @@ void overmap::place_radios()
     }
 }
 
+static bool use_binary_overmaps()
+{
+    return get_option<std::string>( "MAP_STORAGE_FORMAT" ) == "binary";
+}
+
+void overmap::ensure_layer_loaded( int z ) const
+{
+    if( unloaded_layers[z + OVERMAP_DEPTH] ) {
+        // Reading the layer doesn't change what the overmap looks like from the outside
+        const_cast<overmap *>( this )->load_layer( z );
+    }
+}
+
 void overmap::open( overmap_special_batch &enabled_specials )
 {
+    ZoneScoped;
     const std::string terfilename = overmapbuffer::terrain_filename( loc );
+    const std::string binfilename = overmapbuffer::binary_terrain_filename( loc );
 
     const auto ter_reader = [&]( std::istream & fin ) {
         overmap::unserialize( fin, terfilename );
     };
+    const auto bin_reader = [&]( std::istream & fin ) {
+        overmap::unserialize_binary( fin, binfilename );
+    };
 
-    if( read_from_file_optional( terfilename, ter_reader ) ) {
+    // Either format loads regardless of the world setting, it's converted on the next save
+    if( read_from_file_optional( binfilename, bin_reader ) ||
+        read_from_file_optional( terfilename, ter_reader ) ) {
         const std::string plrfilename = overmapbuffer::player_filename( loc );
         const auto plr_reader = [&]( std::istream & fin ) {
             overmap::unserialize_view( fin, plrfilename );
@@ -6108,16 +6163,57 @@ void overmap::open( overmap_special_batch &enabled_specials )
     }
 }
 
+// The terrain file in the format that is not used, removed so it can't shadow the new one
+static std::string other_terrain_filename( const point_abs_om &loc, bool binary )
+{
+    return binary ? overmapbuffer::terrain_filename( loc ) :
+           overmapbuffer::binary_terrain_filename( loc );
+}
+
 // Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
+    ZoneScoped;
     write_to_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
         serialize_view( stream );
     } );
 
-    write_to_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
-        serialize( stream );
-    } );
+    const bool binary = use_binary_overmaps();
+    if( binary ) {
+        write_to_file( overmapbuffer::binary_terrain_filename( loc ), [&]( std::ostream & stream ) {
+            serialize_binary( stream );
+        } );
+    } else {
+        write_to_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
+            serialize( stream );
+        } );
+    }
+    const std::string other = other_terrain_filename( loc, binary );
+    if( file_exist( other ) ) {
+        remove_file( other );
+    }
+}
+
+void overmap::save_in_background() const
+{
+    std::ostringstream view;
+    serialize_view( view );
+    get_background_saver().write( overmapbuffer::player_filename( loc ), view.str() );
+
+    const bool binary = use_binary_overmaps();
+    std::ostringstream terrain;
+    if( binary ) {
+        serialize_binary( terrain );
+        get_background_saver().write( overmapbuffer::binary_terrain_filename( loc ), terrain.str() );
+    } else {
+        serialize( terrain );
+        get_background_saver().write( overmapbuffer::terrain_filename( loc ), terrain.str() );
+    }
+    // Only once the new file is written, in the same transaction when there is one
+    const std::string other = other_terrain_filename( loc, binary );
+    if( file_exist( other ) || get_background_saver().is_pending( other ) ) {
+        get_background_saver().remove( other );
+    }
 }
 
 void overmap::add_mon_group( const mongroup &group )
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -36,6 +37,7 @@
 class JsonIn;
 class JsonObject;
 class JsonOut;
+class binary_in;
 class character_id;
 class map_extra;
 class monster;
@@ -106,12 +108,33 @@ struct radio_tower {
 };
 
 struct map_layer {
-    oter_id terrain[OMAPX][OMAPY];
+    /** Terrain of each tile, null while the whole layer is @ref uniform_terrain. */
+    std::unique_ptr<std::array<oter_id, OMAPX * OMAPY>> terrain;
+    /** Terrain of all tiles while @ref terrain is null. Most of the sky and deep underground. */
+    oter_id uniform_terrain;
     bool visible[OMAPX][OMAPY];
     bool explored[OMAPX][OMAPY];
     bool path[OMAPX][OMAPY];
     std::vector<om_note> notes;
     std::vector<om_map_extra> extras;
+
+    const oter_id &ter( point p ) const {
+        return terrain ? ( *terrain )[p.y * OMAPX + p.x] : uniform_terrain;
+    }
+    void ter_set( point p, const oter_id &id ) {
+        if( !terrain ) {
+            if( id == uniform_terrain ) {
+                return;
+            }
+            terrain = std::make_unique<std::array<oter_id, OMAPX * OMAPY>>();
+            terrain->fill( uniform_terrain );
+        }
+        ( *terrain )[p.y * OMAPX + p.x] = id;
+    }
+    void fill_terrain( const oter_id &id ) {
+        terrain.reset();
+        uniform_terrain = id;
+    }
 };
 
 static const std::map<std::string, oter_flags> oter_flags_map = {
@@ -210,6 +233,8 @@ class overmap
         }
 
         void save() const;
+        /** Serialize now, but leave writing the files to @ref background_saver. */
+        void save_in_background() const;
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -396,10 +421,14 @@ class overmap
 
         // parse data in an opened overmap file
         void unserialize( std::istream &fin, const std::string &file_path );
+        // parse data in an opened binary overmap file, throws on errors
+        void unserialize_binary( std::istream &fin, const std::string &file_path );
         // Parse per-player overmap view data.
         void unserialize_view( std::istream &fin, const std::string &file_path );
         // Save data in an opened overmap file
         void serialize( std::ostream &fout ) const;
+        // Save data in the binary format, see @ref unserialize_binary
+        void serialize_binary( std::ostream &fout ) const;
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
     private:
@@ -507,6 +536,23 @@ class overmap
         void load_monster_groups( JsonIn &jsin );
         void load_legacy_monstergroups( JsonIn &jsin );
         void save_monster_groups( JsonOut &jo ) const;
+
+        // Everything but the terrain layers, each written as a single json value
+        using side_table_writer = std::pair<std::string, std::function<void( JsonOut & )>>;
+        std::vector<side_table_writer> side_table_writers() const;
+        void unserialize_side_table( JsonIn &jsin, const std::string &name );
+
+        // Where to find a terrain layer of a binary overmap file that hasn't been read yet
+        struct unloaded_layer {
+            std::string path;
+            std::uint64_t offset = 0;
+            std::uint32_t length = 0;
+        };
+        std::array<std::optional<unloaded_layer>, OVERMAP_LAYERS> unloaded_layers;
+        // Read the terrain of layer @p z if it hasn't been loaded yet
+        void ensure_layer_loaded( int z ) const;
+        void load_layer( int z );
+        void read_layer_terrain( binary_in &in, int z );
     public:
         static void load_oter_id_migration( const JsonObject &jo );
         static void reset_oter_id_migrations();
@@ -119,6 +119,10 @@ bool overmap_connection::can_start_at( const oter_id &ground ) const
 
 bool overmap_connection::has( const oter_id &oter ) const
 {
+    const size_t index = oter.to_i();
+    if( index < subtype_terrains.size() ) {
+        return subtype_terrains[index];
+    }
     return std::find_if( subtypes.cbegin(), subtypes.cend(), [&oter]( const subtype & elem ) {
         return oter->type_is( elem.terrain );
     } ) != subtypes.cend();
@@ -152,7 +156,20 @@ void overmap_connection::check() const
 
 void overmap_connection::finalize()
 {
-    cached_subtypes.resize( overmap_terrains::get_all().size() );
+    const std::vector<oter_t> &all_oters = overmap_terrains::get_all();
+    cached_subtypes.resize( all_oters.size() );
+
+    subtype_terrains.assign( all_oters.size(), false );
+    for( const subtype &elem : subtypes ) {
+        if( !elem.terrain.is_valid() ) {
+            continue;
+        }
+        for( size_t i = 0; i < all_oters.size(); i++ ) {
+            if( all_oters[i].type_is( elem.terrain ) ) {
+                subtype_terrains[i] = true;
+            }
+        }
+    }
 }
 
 namespace overmap_connections
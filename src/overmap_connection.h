@@ -88,6 +88,8 @@ class overmap_connection
         overmap_connection_layout layout;
         std::list<subtype> subtypes;
         mutable std::vector<cache> cached_subtypes;
+        // Indexed by oter_id, whether it is the terrain of one of the subtypes
+        std::vector<bool> subtype_terrains;
 };
 
 namespace overmap_connections
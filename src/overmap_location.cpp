@@ -33,6 +33,10 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const oter_id &oter ) const
 {
+    const size_t index = oter.to_i();
+    if( index < matching_oters.size() ) {
+        return matching_oters[index];
+    }
     return std::any_of( terrains.cbegin(), terrains.cend(),
     [ &oter ]( const oter_type_str_id & type ) {
         return oter->type_is( type );
@@ -86,6 +90,22 @@ void overmap_location::finalize()
             }
         }
     }
+
+    std::vector<bool> matching_types;
+    for( const oter_type_str_id &elem : terrains ) {
+        if( !elem.is_valid() ) {
+            continue;
+        }
+        const size_t index = elem.id().to_i();
+        matching_types.resize( std::max( matching_types.size(), index + 1 ) );
+        matching_types[index] = true;
+    }
+    const std::vector<oter_t> &all_oters = overmap_terrains::get_all();
+    matching_oters.assign( all_oters.size(), false );
+    for( size_t i = 0; i < all_oters.size(); i++ ) {
+        const size_t type_index = all_oters[i].get_type_id().id().to_i();
+        matching_oters[i] = type_index < matching_types.size() && matching_types[type_index];
+    }
 }
 
 void overmap_locations::load( const JsonObject &jo, const std::string &src )
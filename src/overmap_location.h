@@ -28,6 +28,8 @@ struct overmap_location {
     private:
         std::vector<oter_type_str_id> terrains;
         std::vector<std::string> flags;
+        // Indexed by oter_id, whether its type is one of the terrains
+        std::vector<bool> matching_oters;
 };
 
 namespace overmap_locations
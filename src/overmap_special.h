@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <bitset>
 #include <list>
+#include <optional>
 #include <set>
 #include <vector>
 #include <array>
@@ -147,7 +148,7 @@ class overmap_special
         int longest_side() const;
         std::vector<oter_str_id> all_terrains() const;
         std::vector<overmap_special_terrain> preview_terrains() const;
-        std::vector<overmap_special_locations> required_locations() const;
+        const std::vector<overmap_special_locations> &required_locations() const;
 
         special_placement_result place(
             overmap &om, const tripoint_om_omt &origin, om_direction::type dir ) const;
@@ -181,6 +182,8 @@ class overmap_special
         cata::flat_set<overmap_location_id> default_locations_;
         mapgen_parameters mapgen_params_;
         std::unordered_map<tripoint_rel_omt, overmap_special_id> nested_;
+        // Filled on first use, after this and the nested specials are finalized
+        mutable std::optional<std::vector<overmap_special_locations>> required_locations_;
 };
 
 namespace overmap_specials
@@ -942,10 +942,12 @@ static void draw_ascii( ui_adaptor &ui,
             nc_color ter_color = c_black;
             std::string ter_sym = " ";
 
-            const bool see = has_debug_vision || overmap_buffer.seen( omp );
+            // Looked up once for all the queries below about this tile
+            const overmap_with_local_coords om_loc = overmap_buffer.get_existing_om_global( omp );
+            const bool see = has_debug_vision || ( om_loc && om_loc.om->seen( om_loc.local ) );
             if( see ) {
                 // Only load terrain if we can actually see it
-                cur_ter = overmap_buffer.ter( omp );
+                cur_ter = om_loc ? om_loc.om->ter( om_loc.local ) : overmap_buffer.ter( omp );
             }
 
             // Check if location is within player line-of-sight
@@ -975,10 +977,11 @@ static void draw_ascii( ui_adaptor &ui,
                 } else if( target.z() < center.z() ) {
                     ter_sym = "v";
                 }
-            } else if( blink && uistate.overmap_show_map_notes && overmap_buffer.has_note( omp ) ) {
+            } else if( blink && uistate.overmap_show_map_notes && om_loc &&
+                       om_loc.om->has_note( om_loc.local ) ) {
                 // Display notes in all situations, even when not seen
                 std::tie( ter_sym, ter_color, std::ignore ) =
-                    get_note_display_info( overmap_buffer.note( omp ) );
+                    get_note_display_info( om_loc.om->note( om_loc.local ) );
             } else if( !see ) {
                 // All cases above ignore the seen-status,
                 ter_color = c_dark_gray;
@@ -1000,7 +1003,7 @@ static void draw_ascii( ui_adaptor &ui,
             } else if( blink && is_npc_path ) {
                 ter_color = c_red;
                 ter_sym = "!";
-            } else if( blink && overmap_buffer.is_path( omp ) ) {
+            } else if( blink && om_loc && om_loc.om->is_path( om_loc.local ) ) {
                 ter_color = c_light_blue;
                 ter_sym = "!";
             } else if( blink && showhordes && los &&
@@ -1900,7 +1903,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
         params = overmap_path_params::for_player();
         const oter_id dest_ter = overmap_buffer.ter_existing( dest );
         // already in water or going to a water tile
-        if( here.has_flag( "SWIMMABLE", player_character.pos() ) || is_river_or_lake( dest_ter ) ) {
+        if( here.has_flag( TFLAG_SWIMMABLE, player_character.pos() ) || is_river_or_lake( dest_ter ) ) {
             params.water_cost = 100;
         }
     }
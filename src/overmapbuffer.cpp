@@ -10,12 +10,14 @@
 #include <queue>
 
 #include "avatar.h"
+#include "background_saver.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character_id.h"
 #include "color.h"
 #include "map_iterator.h"
 #include "numeric_interval.h"
+#include "pathfinding_stats.h"
 #include "coordinate_conversions.h"
 #include "coordinates.h"
 #include "debug.h"
@@ -71,6 +73,11 @@ std::string overmapbuffer::terrain_filename( const point_abs_om &p )
     return string_format( "%s/o.%d.%d", g->get_world_base_save_path(), p.x(), p.y() );
 }
 
+std::string overmapbuffer::binary_terrain_filename( const point_abs_om &p )
+{
+    return terrain_filename( p ) + ".bin";
+}
+
 std::string overmapbuffer::player_filename( const point_abs_om &p )
 {
     return string_format( "%s.seen.%d.%d", g->get_player_base_save_path(), p.x(), p.y() );
@@ -88,6 +95,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     }
 
     // That constructor loads an existing overmap or creates a new one.
+    invalidate_travel_paths();
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate();
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
@@ -107,6 +115,7 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
             last_requested_overmap = nullptr;
         }
     }
+    invalidate_travel_paths();
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate( specials );
 }
@@ -196,9 +205,14 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
     }
 }
 
-void overmapbuffer::save()
+void overmapbuffer::save( bool background )
 {
+    ZoneScoped;
     for( auto &omp : overmaps ) {
+        if( background ) {
+            omp.second->save_in_background();
+            continue;
+        }
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
     }
@@ -206,9 +220,17 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    // Overmaps will be read back from disk from now on
+    get_background_saver().wait();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
+    travel_paths.clear();
+}
+
+std::size_t overmapbuffer::memory_usage() const
+{
+    return overmaps.size() * sizeof( overmap );
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -221,6 +243,7 @@ void overmapbuffer::add_note( const tripoint_abs_omt &p, const std::string &mess
 {
     overmap_with_local_coords om_loc = get_om_global( p );
     om_loc.om->add_note( om_loc.local, message );
+    invalidate_travel_paths();
 }
 
 void overmapbuffer::delete_note( const tripoint_abs_omt &p )
@@ -228,6 +251,7 @@ void overmapbuffer::delete_note( const tripoint_abs_omt &p )
     if( has_note( p ) ) {
         overmap_with_local_coords om_loc = get_om_global( p );
         om_loc.om->delete_note( om_loc.local );
+        invalidate_travel_paths();
     }
 }
 
@@ -236,6 +260,7 @@ void overmapbuffer::mark_note_dangerous( const tripoint_abs_omt &p, int radius,
     if( has_note( p ) ) {
         overmap_with_local_coords om_loc = get_om_global( p );
         om_loc.om->mark_note_dangerous( om_loc.local, radius, is_dangerous );
+        invalidate_travel_paths();
     }
 }
 
@@ -267,7 +292,7 @@ overmap *overmapbuffer::get_existing( const point_abs_om &p )
         // checked in a previous call of this function).
         return nullptr;
     }
-    if( file_exist( terrain_filename( p ) ) ) {
+    if( file_exist( terrain_filename( p ) ) || file_exist( binary_terrain_filename( p ) ) ) {
         // File exists, load it normally (the get function
         // indirectly call overmap::open to do so).
         return &get( p );
@@ -638,7 +663,11 @@ bool overmapbuffer::seen( const tripoint_abs_omt &p )
 void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->seen( om_loc.local ) = seen;
+    bool &was_seen = om_loc.om->seen( om_loc.local );
+    if( was_seen != seen ) {
+        was_seen = seen;
+        seen_generation++;
+    }
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -835,6 +864,27 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
+    const pathfinding_stats::search_timer timer( route_scale::overmap );
+    for( const travel_path &known : travel_paths ) {
+        if( known.dest != dest || !( known.params == params ) || known.generation != travel_generation ||
+            ( params.only_known_by_player && known.seen_generation != seen_generation ) ) {
+            continue;
+        }
+        if( known.src == src ) {
+            pathfinding_stats::count_cached();
+            return known.points;
+        }
+        // The rest of a path from any tile along it is as good as a new search from there
+        const auto here = std::find( known.points.begin(), known.points.end(), src );
+        if( here != known.points.end() ) {
+            pathfinding_stats::count_cached();
+            return std::vector<tripoint_abs_omt>( known.points.begin(), std::next( here ) );
+        }
+    }
+    // Taken before searching, which may load overmaps and so make the result stale at once
+    const int generation = travel_generation;
+    const int seen_gen = seen_generation;
+
     const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
         const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
         if( cur_cost < 0 ) {
@@ -845,9 +895,18 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
     const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
+    if( travel_paths.size() >= max_travel_paths ) {
+        travel_paths.erase( travel_paths.begin() );
+    }
+    travel_paths.push_back( { src, dest, params, generation, seen_gen, path.points } );
     return path.points;
 }
 
+void overmapbuffer::invalidate_travel_paths()
+{
+    travel_generation++;
+}
+
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                                   const omt_route_params &params )
 {
@@ -966,26 +1025,53 @@ static omt_find_params assign_params(
     return params;
 }
 
-bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
-        const omt_find_params &params )
+// Searches test the same few terrains over and over, so each one is only matched against
+// the types by name once per search
+class omt_type_matches
 {
-    bool type_matches = false;
-    if( params.existing_only ) {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot_existing( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+    public:
+        explicit omt_type_matches( const omt_find_params &params ) : params( params ),
+            known( overmap_terrains::get_all().size(), match::unknown ) {}
+
+        bool test( const oter_id &oter ) {
+            const size_t index = oter.to_i();
+            if( index >= known.size() ) {
+                return matches( oter );
             }
-        }
-    } else {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+            if( known[index] == match::unknown ) {
+                known[index] = matches( oter ) ? match::yes : match::no;
             }
+            return known[index] == match::yes;
+        }
+
+    private:
+        enum class match : char {
+            unknown,
+            yes,
+            no
+        };
+
+        bool matches( const oter_id &oter ) const {
+            return std::any_of( params.types.begin(), params.types.end(),
+            [&oter]( const std::pair<std::string, ot_match_type> &elem ) {
+                return is_ot_match( elem.first, oter, elem.second );
+            } );
         }
+
+        const omt_find_params &params;
+        std::vector<match> known;
+};
+
+bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
+        const omt_find_params &params, omt_type_matches &type_matches )
+{
+    if( params.types.empty() ) {
+        return false;
     }
-    if( !type_matches ) {
+    const overmap_with_local_coords om_loc = params.existing_only ?
+            get_existing_om_global( location ) : get_om_global( location );
+    if( !om_loc || !overmap::inbounds( om_loc.local ) ||
+        !type_matches.test( om_loc.om->ter( om_loc.local ) ) ) {
         return false;
     }
 
@@ -1024,8 +1110,9 @@ tripoint_abs_omt overmapbuffer::find_closest(
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
+    omt_type_matches type_matches( params );
     // Check the origin before searching adjacent tiles!
-    if( params.min_distance == 0 && is_findable_location( origin, params ) ) {
+    if( params.min_distance == 0 && is_findable_location( origin, params, type_matches ) ) {
         return origin;
     }
 
@@ -1068,7 +1155,7 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
                 continue;
             }
 
-            if( is_findable_location( loc, params ) ) {
+            if( is_findable_location( loc, params, type_matches ) ) {
                 found_dist = dist;
                 result.push_back( loc );
             }
@@ -1095,9 +1182,10 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
 
     size_t num_overmaps = overmaps.size();
     size_t counter = 0;
+    omt_type_matches type_matches( params );
 
     for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-        if( is_findable_location( loc, params ) ) {
+        if( is_findable_location( loc, params, type_matches ) ) {
             result.push_back( loc );
         }
 
@@ -1456,7 +1544,7 @@ void overmapbuffer::spawn_monster( const tripoint_abs_sm &p )
         // The monster position must be local to the main map when added to the game
         const tripoint local = tripoint( here.getlocal( ms ), p.z() );
         assert( here.inbounds( local ) );
-        monster *const placed = g->place_critter_at( make_shared_fast<monster>( this_monster ),
+        monster *const placed = g->place_critter_at( make_shared_pooled<monster>( this_monster ),
                                 local );
         if( placed ) {
             placed->on_load();
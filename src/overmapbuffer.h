@@ -3,6 +3,7 @@
 #define CATA_SRC_OVERMAPBUFFER_H
 
 #include <array>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -56,6 +57,8 @@ struct overmap_path_params {
     bool avoid_danger = true;
     bool only_known_by_player = true;
 
+    bool operator==( const overmap_path_params & ) const = default;
+
     static constexpr int standard_cost = 10;
     static overmap_path_params for_player();
     static overmap_path_params for_npc();
@@ -119,6 +122,8 @@ struct overmap_with_local_coords {
  * @param om_special If set, the terrain must be part of the specified overmap special.
  * @param popup If set, the popup will be periodically updated to indicate ongoing search.
 */
+class omt_type_matches;
+
 struct omt_find_params {
     ~omt_find_params();
 
@@ -152,6 +157,7 @@ class overmapbuffer
         overmapbuffer();
 
         static std::string terrain_filename( const point_abs_om & );
+        static std::string binary_terrain_filename( const point_abs_om & );
         static std::string player_filename( const point_abs_om & );
 
         /**
@@ -159,8 +165,15 @@ class overmapbuffer
          * compared with the position of the overmap.
          */
         overmap &get( const point_abs_om & );
-        void save();
+        /** @param background queue the files on @ref background_saver instead of writing them. */
+        void save( bool background = false );
         void clear();
+        /** Number of overmaps loaded. */
+        std::size_t size() const {
+            return overmaps.size();
+        }
+        /** Approximate bytes taken by the loaded overmaps, their fixed size layers mostly. */
+        std::size_t memory_usage() const;
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
 
         /**
@@ -344,8 +357,15 @@ class overmapbuffer
         bool reveal( const tripoint_abs_omt &center, int radius );
         bool reveal( const tripoint_abs_omt &center, int radius,
                      const std::function<bool( const oter_id & )> &filter );
+        /**
+         * Path from src to dest, with dest at the front and src at the back.
+         * Paths are remembered until overmap terrain, notes or seen tiles change,
+         * and a remembered path that passes through src is reused for the same dest.
+         */
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
+        /** Forgets remembered travel paths, called when the overmap terrain they crossed may differ. */
+        void invalidate_travel_paths();
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            const omt_route_params &params );
         /**
@@ -505,9 +525,11 @@ class overmapbuffer
          * Common function used by the find_closest/all/random to determine if the location is
          * findable based on the specified criteria.
          * @param location Location of search
+         * @param type_matches Which terrains match params.types, shared by one search
          * see omt_find_params for definitions of the terms
          */
-        bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params,
+                                   omt_type_matches &type_matches );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -518,6 +540,22 @@ class overmapbuffer
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
 
+        struct travel_path {
+            tripoint_abs_omt src;
+            tripoint_abs_omt dest;
+            overmap_path_params params;
+            int generation;
+            int seen_generation;
+            std::vector<tripoint_abs_omt> points;
+        };
+        static constexpr size_t max_travel_paths = 32;
+        /** Results of recent get_travel_path calls, oldest first. */
+        std::vector<travel_path> travel_paths;
+        /** Bumped when overmap terrain, notes or the set of loaded overmaps change. */
+        int travel_generation = 0;
+        /** Bumped when the seen state of an overmap tile changes. */
+        int seen_generation = 0;
+
         /**
          * Get a list of notes in the (loaded) overmaps.
          * @param z only this specific z-level is search for notes.
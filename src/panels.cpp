@@ -52,6 +52,7 @@
 #include "string_id.h"
 #include "tileray.h"
 #include "translations.h"
+#include "turn_stats.h"
 #include "type_id.h"
 #include "ui_manager.h"
 #include "units.h"
@@ -1850,6 +1851,25 @@ static void draw_ai_goal( const avatar &u, const catacurses::window &w )
     wnoutrefresh( w );
 }
 
+static void draw_turn_timing( avatar &, const catacurses::window &w )
+{
+    werase( w );
+    const int width = getmaxx( w ) - 2;
+    const turn_stats::turn_record &last = turn_stats::last_turn();
+    // NOLINTNEXTLINE(cata-use-named-point-constants)
+    mvwprintz( w, point( 1, 0 ), c_light_gray, "Turn: %.2f ms", last.total_nanoseconds() / 1e6 );
+    trim_and_print( w, point_south_east, width, c_dark_gray, last.slowest_phases( 3, ", " ) );
+    std::string histogram = string_format( "Last %d (ms):", turn_stats::turns_kept() );
+    const std::array<int, turn_stats::num_buckets> buckets = turn_stats::histogram();
+    for( int b = 0; b < turn_stats::num_buckets; b++ ) {
+        if( buckets[b] > 0 ) {
+            histogram += string_format( " %s:%d", turn_stats::bucket_label( b ), buckets[b] );
+        }
+    }
+    fold_and_print( w, point( 1, 2 ), width, c_light_gray, histogram );
+    wnoutrefresh( w );
+}
+
 static void draw_location_classic( const avatar &u, const catacurses::window &w )
 {
     werase( w );
@@ -2069,6 +2089,7 @@ static std::vector<window_panel> initialize_default_classic_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_timing, "Turn Timing", 4, 44, false );
     return ret;
 }
 
@@ -2095,6 +2116,7 @@ static std::vector<window_panel> initialize_default_compact_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_timing, "Turn Timing", 4, 32, false );
 
     return ret;
 }
@@ -2127,6 +2149,7 @@ static std::vector<window_panel> initialize_default_label_narrow_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_timing, "Turn Timing", 4, 32, false );
 
     return ret;
 }
@@ -2160,6 +2183,7 @@ static std::vector<window_panel> initialize_default_label_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_timing, "Turn Timing", 4, 44, false );
 
     return ret;
 }
@@ -2221,6 +2245,15 @@ void panel_manager::init()
     update_offsets( get_current_layout().begin()->get_width() );
 }
 
+void panel_manager::forget_drawn()
+{
+    for( std::pair<const std::string, std::vector<window_panel>> &layout : layouts ) {
+        for( window_panel &panel : layout.second ) {
+            panel.drawn_key.reset();
+        }
+    }
+}
+
 void panel_manager::update_offsets( int x )
 {
     width_right = x;
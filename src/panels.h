@@ -2,23 +2,22 @@
 #ifndef CATA_SRC_PANELS_H
 #define CATA_SRC_PANELS_H
 
+#include <cstddef>
 #include <functional>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
+#include "cursesdef.h"
+#include "point.h"
 
 class JsonIn;
 class JsonOut;
 class avatar;
-struct point;
-struct tripoint;
 
-namespace catacurses
-{
-class window;
-} // namespace catacurses
 enum face_type : int {
     face_human = 0,
     face_bird,
@@ -36,6 +35,27 @@ void draw_overmap_chunk( const catacurses::window &w_minimap, const avatar &you,
 
 bool default_render();
 
+/**
+ * What the panels show depends on. While none of it changes, redrawing a panel
+ * only needs to put its window from the last drawing back on the screen.
+ */
+struct panel_change_key {
+    time_point turn;
+    int moves = 0;
+    int user_actions = 0;
+    tripoint pos;
+    tripoint view_offset;
+    int safe_mode = 0;
+    bool show_panel_adm = false;
+    size_t messages = 0;
+    bool undisplayed_messages = false;
+    // Of the panel's window
+    point origin;
+    point size;
+
+    bool operator==( const panel_change_key & ) const = default;
+};
+
 class window_panel
 {
     public:
@@ -52,6 +72,10 @@ class window_panel
         bool toggle;
         bool always_draw;
 
+        // The window the panel was last drawn on, and with what
+        catacurses::window drawn_window;
+        std::optional<panel_change_key> drawn_key;
+
     private:
         int height;
         int width;
@@ -83,6 +107,9 @@ class panel_manager
 
         void init();
 
+        // Make every panel draw again on the next redraw, for changes the keys don't cover
+        void forget_drawn();
+
     private:
         bool save();
         bool load();
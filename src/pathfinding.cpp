@@ -6,6 +6,11 @@
 #include <queue>
 #include <set>
 #include <array>
+#include <bitset>
+#include <climits>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -14,8 +19,12 @@
 #include "coordinates.h"
 #include "debug.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "mapdata.h"
+#include "pathfinding_stats.h"
+#include "profile.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "trap.h"
 #include "veh_type.h"
 #include "vehicle.h"
@@ -40,41 +49,54 @@ constexpr int flat_index( const tripoint &p )
 // Flattened 2D array representing a single z-level worth of pathfinding data
 struct path_data_layer {
     // State is accessed way more often than all other values here
+    // Only valid where `stamp` matches the search, everything else is unvisited
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
+    std::array< std::uint32_t, MAPSIZE_X *MAPSIZE_Y > stamp = {};
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
+    std::uint32_t generation = 0;
 
-    void init( point min, point max ) {
-        tripoint p;
-        for( p.x = min.x; p.x <= max.x; p.x++ ) {
-            for( p.y = min.y; p.y <= max.y; p.y++ ) {
-                const int ind = flat_index( p );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    astar_state &state_at( const int index ) {
+        if( stamp[index] != generation ) {
+            stamp[index] = generation;
+            state[index] = ASL_NONE; // Mark as unvisited
         }
+        return state[index];
     }
 };
 
+// Reused by all searches of a thread, so they don't allocate or clear their node arrays
 struct pathfinder {
-    point min;
-    point max;
-    pathfinder( point _min, point _max ) :
-        min( _min ), max( _max ) {
+    std::vector< std::pair<int, tripoint> > open;
+    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    std::uint32_t generation = 0;
+
+    static pathfinder &workspace() {
+        static thread_local pathfinder pf;
+        pf.reset();
+        return pf;
     }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    void reset() {
+        open.clear();
+        if( ++generation == 0 ) {
+            // Wrapped around, old stamps could look current again
+            for( std::unique_ptr< path_data_layer > &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->stamp.fill( 0 );
+                }
+            }
+            generation = 1;
+        }
+    }
 
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
+        ptr->generation = generation;
         return *ptr;
     }
 
@@ -83,36 +105,37 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        pathfinding_stats::count_expanded();
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        astar_state &state = layer.state_at( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        state = ASL_OPEN;
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.emplace( score, to );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_CLOSED;
+        layer.state_at( flat_index( p ) ) = ASL_CLOSED;
     }
 
     void unclose_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
-        const int index = flat_index( p );
-        layer.state[index] = ASL_NONE;
+        layer.state_at( flat_index( p ) ) = ASL_NONE;
     }
 };
 
@@ -192,9 +215,422 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+static constexpr pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+int pathfinding_cache::area_node( const point &p ) const
+{
+    if( area[p.x][p.y] == 0 ) {
+        return -1;
+    }
+    return first_node[( p.x / SEEX ) * MAPSIZE + p.y / SEEY] + area[p.x][p.y] - 1;
+}
+
+void pathfinding_cache::update_areas()
+{
+    constexpr std::uint8_t unnumbered = UINT8_MAX;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( area[x][y] != 0 ) {
+                area[x][y] = unnumbered;
+            }
+        }
+    }
+
+    constexpr std::array<point, 8> offsets{{
+            point_west, point_east, point_north, point_south,
+            point_north_east, point_south_west, point_north_west, point_south_east
+        }};
+    node_submap.clear();
+    std::vector<point> open;
+    for( int smx = 0; smx < MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < MAPSIZE; smy++ ) {
+            first_node[smx * MAPSIZE + smy] = node_submap.size();
+            const point sm_min( smx * SEEX, smy * SEEY );
+            const point sm_max = sm_min + point( SEEX, SEEY );
+            std::uint8_t count = 0;
+            for( int x = sm_min.x; x < sm_max.x; x++ ) {
+                for( int y = sm_min.y; y < sm_max.y; y++ ) {
+                    if( area[x][y] != unnumbered ) {
+                        continue;
+                    }
+                    // Flood fill a new area
+                    count++;
+                    node_submap.emplace_back( smx, smy );
+                    area[x][y] = count;
+                    open.emplace_back( x, y );
+                    while( !open.empty() ) {
+                        const point cur = open.back();
+                        open.pop_back();
+                        for( const point &offset : offsets ) {
+                            const point p = cur + offset;
+                            if( p.x >= sm_min.x && p.x < sm_max.x && p.y >= sm_min.y && p.y < sm_max.y &&
+                                area[p.x][p.y] == unnumbered ) {
+                                area[p.x][p.y] = count;
+                                open.push_back( p );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    first_node[MAPSIZE * MAPSIZE] = node_submap.size();
+
+    // Areas of neighbouring submaps are linked where their tiles touch
+    node_links.assign( node_submap.size(), {} );
+    const auto link = [this]( int a, int b ) {
+        if( std::find( node_links[a].begin(), node_links[a].end(), b ) == node_links[a].end() ) {
+            node_links[a].push_back( b );
+            node_links[b].push_back( a );
+        }
+    };
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const point p( x, y );
+            const int node = area_node( p );
+            if( node < 0 ) {
+                continue;
+            }
+            for( const point &offset : {
+                     point_east, point_south, point_south_east, point_south_west
+                 } ) {
+                const point q = p + offset;
+                if( q.x < 0 || q.x >= MAPSIZE_X || q.y >= MAPSIZE_Y ||
+                    ( q.x / SEEX == x / SEEX && q.y / SEEY == y / SEEY ) ) {
+                    continue;
+                }
+                const int other = area_node( q );
+                if( other >= 0 ) {
+                    link( node, other );
+                }
+            }
+        }
+    }
+}
+
+// Submaps around the shortest chain of linked areas from `f` to `t`, nullopt if there is none
+static std::optional<map::route_corridor> plan_corridor( const pathfinding_cache &cache,
+        const point &f, const point &t )
+{
+    const int from = cache.area_node( f );
+    const int to = cache.area_node( t );
+    if( from < 0 || to < 0 ) {
+        return std::nullopt;
+    }
+
+    std::vector<int> parent( cache.node_submap.size(), -1 );
+    parent[from] = from;
+    std::queue<int> open;
+    open.push( from );
+    while( !open.empty() && parent[to] < 0 ) {
+        const int cur = open.front();
+        open.pop();
+        for( const int next : cache.node_links[cur] ) {
+            if( parent[next] < 0 ) {
+                parent[next] = cur;
+                open.push( next );
+            }
+        }
+    }
+    if( parent[to] < 0 ) {
+        return std::nullopt;
+    }
+
+    // Neighbouring submaps too, so the route isn't forced through the node's own tiles
+    map::route_corridor corridor;
+    for( int node = to; ; node = parent[node] ) {
+        const point &sm = cache.node_submap[node];
+        for( int smx = std::max( sm.x - 1, 0 ); smx <= std::min( sm.x + 1, MAPSIZE - 1 ); smx++ ) {
+            for( int smy = std::max( sm.y - 1, 0 ); smy <= std::min( sm.y + 1, MAPSIZE - 1 ); smy++ ) {
+                corridor.set( smx * MAPSIZE + smy );
+            }
+        }
+        if( node == from ) {
+            break;
+        }
+    }
+    return corridor;
+}
+
+const std::vector<tripoint> *route_memo::find( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+        const std::array<int, MAPSIZE *MAPSIZE> &submap_generation ) const
+{
+    for( const entry &e : entries ) {
+        if( e.f != f || e.t != t || !( e.settings == settings ) || e.pre_closed != pre_closed ) {
+            continue;
+        }
+        for( int sm = 0; sm < MAPSIZE * MAPSIZE; sm++ ) {
+            if( e.searched.test( sm ) && submap_generation[sm] > e.generation ) {
+                miss_count++;
+                return nullptr;
+            }
+        }
+        hit_count++;
+        return &e.route;
+    }
+    miss_count++;
+    return nullptr;
+}
+
+void route_memo::insert( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                         const std::set<tripoint> &pre_closed, const submaps &searched, int generation,
+                         const std::vector<tripoint> &route )
+{
+    const auto iter = std::find_if( entries.begin(), entries.end(), [&]( const entry & e ) {
+        return e.f == f && e.t == t && e.settings == settings && e.pre_closed == pre_closed;
+    } );
+    if( iter != entries.end() ) {
+        entries.erase( iter );
+    } else if( entries.size() >= max_entries ) {
+        entries.erase( entries.begin() );
+    }
+    entries.push_back( { f, t, settings, pre_closed, searched, generation, route } );
+}
+
+// The straight line from `f` to `t` if it's all flat ground, empty otherwise
+// Except when the line contains a pre-closed tile - we need to do regular pathing then
+static std::vector<tripoint> flat_line_route( const map &m, const tripoint &f, const tripoint &t,
+        const std::set<tripoint> &pre_closed )
+{
+    if( f.z != t.z ) {
+        return {};
+    }
+    auto line_path = line_to( f, t );
+    const auto &pf_cache = m.get_pathfinding_cache_ref( f.z );
+    // Check all points for any special case (including just hard terrain)
+    if( !( pf_cache.special[f.x][f.y] & non_normal ) &&
+    std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+    return !( pf_cache.special[p.x][p.y] & non_normal );
+    } ) ) {
+        const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
+
+        if( is_disjoint( sorted_line, pre_closed ) ) {
+            return line_path;
+        }
+    }
+    return {};
+}
+
+map::route_step map::route_step_cost( const tripoint &cur, const vehicle *cur_veh,
+                                      const tripoint &p, const pathfinding_settings &settings ) const
+{
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+    const bool trapavoid = settings.avoid_traps;
+    const bool roughavoid = settings.avoid_rough_terrain;
+    const bool sharpavoid = settings.avoid_sharp;
+
+    route_step step;
+    int part = -1;
+    const vehicle *veh = veh_at_internal( p, part );
+    if( cur_veh &&
+        !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
+        //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
+        return step;
+    }
+
+    if( veh && veh != cur_veh &&
+        !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
+        //Same as above but moving into rather than out of a vehicle
+        return step;
+    }
+
+    // Penalize for diagonals or the path will look "unnatural"
+    int newg = ( cur.x != p.x && cur.y != p.y ) ? 1 : 0;
+
+    const auto &pf_cache = get_pathfinding_cache_ref( p.z );
+    const auto p_special = pf_cache.special[p.x][p.y];
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        step.cost = newg + 2;
+        return step;
+    }
+
+    if( roughavoid ) {
+        step.close = true; // Close all rough terrain tiles
+        return step;
+    }
+
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        step.close = true; // Close it so that next time we won't try to calculate costs
+        return step;
+    }
+
+    newg += cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            newg += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                     !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            newg += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( cur, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                newg += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->cpart( part ).hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    step.close = true;
+                    return step;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                newg += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
+                    // Won't be openable, don't try from other sides
+                    step.close = true;
+                }
+
+                return step;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            newg += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            newg += 500;
+        } else {
+            // Unbashable and unopenable from here
+            if( !doors || !terrain.open || !furniture.open ) {
+                // Or anywhere else for that matter
+                step.close = true;
+            }
+
+            return step;
+        }
+    }
+
+    if( trapavoid && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    // Close p, because we won't be walking on it
+                    step.close = true;
+                    step.ledge = true;
+                    return step;
+                }
+            } else if( trapavoid ) {
+                // Otherwise it's walkable
+                newg += 500;
+            }
+        }
+    }
+
+    if( sharpavoid && p_special & PF_SHARP ) {
+        step.close = true; // Avoid sharp things
+        return step;
+    }
+
+    step.cost = newg;
+    return step;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
+{
+    ZoneScoped;
+    ZoneText( pathfinding_stats::caller_name( pathfinding_stats::current_caller() ),
+              std::strlen( pathfinding_stats::caller_name( pathfinding_stats::current_caller() ) ) );
+    const pathfinding_stats::search_timer timer( route_scale::map );
+    return find_route( f, t, settings, pre_closed, nullptr );
+}
+
+std::vector<std::vector<tripoint>> map::route_batch( const std::vector<route_request> &requests )
+const
+{
+    ZoneScoped;
+    // Nothing the searches read may be updated while they run, so bring it all up to date first
+    int minz = OVERMAP_HEIGHT;
+    int maxz = -OVERMAP_DEPTH;
+    for( const route_request &request : requests ) {
+        minz = std::min( { minz, request.f.z, request.t.z } );
+        maxz = std::max( { maxz, request.f.z, request.t.z } );
+    }
+    // Ledges and ramps reach one level further
+    minz = std::max( minz - 1, -OVERMAP_DEPTH );
+    maxz = std::min( maxz + 1, OVERMAP_HEIGHT );
+    if( minz > maxz ) {
+        return {};
+    }
+    allocate_caches( minz, maxz );
+    for( int z = minz; z <= maxz; z++ ) {
+        get_pathfinding_cache_ref( z );
+    }
+
+    std::vector<std::vector<tripoint>> results( requests.size() );
+    std::vector<int> unknown;
+    for( size_t i = 0; i < requests.size(); i++ ) {
+        const route_request &r = requests[i];
+        const pathfinding_stats::search_timer timer( route_scale::map );
+        const std::vector<tripoint> *known = inbounds( r.f ) ? get_pathfinding_cache( r.f.z ).routes.find(
+                r.f, r.t, r.settings, r.pre_closed, get_pathfinding_cache( r.f.z ).submap_generation ) : nullptr;
+        if( known != nullptr ) {
+            pathfinding_stats::count_cached();
+            results[i] = *known;
+        } else {
+            unknown.push_back( i );
+        }
+    }
+
+    std::vector<route_corridor> searched( unknown.size() );
+    const route_caller caller = pathfinding_stats::current_caller();
+    get_thread_pool().parallel_for( 0, static_cast<int>( unknown.size() ), [&]( int i ) {
+        const pathfinding_stats::caller_scope tag( caller );
+        const pathfinding_stats::search_timer timer( route_scale::map );
+        const route_request &r = requests[unknown[i]];
+        results[unknown[i]] = find_route( r.f, r.t, r.settings, r.pre_closed, &searched[i] );
+    } );
+
+    // In order of the requests, so the route cache ends up the same however the work was split
+    for( size_t i = 0; i < unknown.size(); i++ ) {
+        const route_request &r = requests[unknown[i]];
+        if( r.f.z == r.t.z && searched[i].any() ) {
+            pathfinding_cache &cache = get_pathfinding_cache( r.f.z );
+            cache.routes.insert( r.f, r.t, r.settings, r.pre_closed, searched[i], cache.generation,
+                                 results[unknown[i]] );
+        }
+    }
+    return results;
+}
+
+std::vector<tripoint> map::find_route( const tripoint &f, const tripoint &t,
+                                       const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                       route_corridor *searched ) const
 {
     /* TODO: If the origin or destination is out of bound, figure out the closest
      * in-bounds point and go to that, then to the real origin/destination.
@@ -208,25 +644,13 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     if( !inbounds( t ) ) {
         tripoint clipped = t;
         clip_to_bounds( clipped );
-        return route( f, clipped, settings, pre_closed );
+        return find_route( f, clipped, settings, pre_closed, searched );
     }
     // First, check for a simple straight line on flat ground
-    // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
-    if( f.z == t.z ) {
-        const auto line_path = line_to( f, t );
-        const auto &pf_cache = get_pathfinding_cache_ref( f.z );
-        // Check all points for any special case (including just hard terrain)
-        if( !( pf_cache.special[f.x][f.y] & non_normal ) &&
-        std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
-        return !( pf_cache.special[p.x][p.y] & non_normal );
-        } ) ) {
-            const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
-
-            if( is_disjoint( sorted_line, pre_closed ) ) {
-                return line_path;
-            }
-        }
+    ret = flat_line_route( *this, f, t, pre_closed );
+    if( !ret.empty() ) {
+        pathfinding_stats::count_shortcut();
+        return ret;
     }
 
     // If expected path length is greater than max distance, allow only line path, like above
@@ -234,13 +658,55 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    // Climbing through the stairs each level lists is a lot cheaper than searching a box on all levels
+    if( f.z != t.z && has_zlevels() && settings.allow_climb_stairs ) {
+        ret = route_by_stairs( f, t, settings, pre_closed, searched );
+        if( !ret.empty() ) {
+            return ret;
+        }
+    }
+
+    // Nothing in reach changed since the last time
+    const bool remember = f.z == t.z && searched == nullptr;
+    pathfinding_cache &cache = get_pathfinding_cache( f.z );
+    if( remember ) {
+        get_pathfinding_cache_ref( f.z );
+        if( const std::vector<tripoint> *known = cache.routes.find( f, t, settings, pre_closed,
+                cache.submap_generation ) ) {
+            pathfinding_stats::count_cached();
+            return *known;
+        }
+    }
+
+    route_corridor searched_here;
+    route_corridor &reached = searched != nullptr ? *searched : searched_here;
+    // The box searched by default doesn't reach far past the ends of the route,
+    // so long routes are planned over the walkable areas of submaps first
+    // Bashers are left to the box, the areas don't know where they could break through
+    if( f.z == t.z && settings.bash_strength == 0 && rl_dist( f, t ) > SEEX * 2 ) {
+        const std::optional<route_corridor> corridor = plan_corridor( get_pathfinding_cache_ref( f.z ),
+                f.xy(), t.xy() );
+        if( corridor ) {
+            ret = route_within( f, t, settings, pre_closed, &*corridor, reached );
+        }
+    }
+    if( ret.empty() ) {
+        ret = route_within( f, t, settings, pre_closed, nullptr, reached );
+    }
+
+    if( remember ) {
+        cache.routes.insert( f, t, settings, pre_closed, reached, cache.generation, ret );
+    }
+    return ret;
+}
+
+std::vector<tripoint> map::route_within( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+        const route_corridor *corridor, route_corridor &searched ) const
+{
+    std::vector<tripoint> ret;
+
     int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     int minx = std::min( f.x, t.x ) - pad;
@@ -251,10 +717,33 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     int maxy = std::max( f.y, t.y ) + pad;
     // Same TODO: as above
     int maxz = std::max( f.z, t.z );
+    if( corridor != nullptr ) {
+        minx = MAPSIZE_X;
+        miny = MAPSIZE_Y;
+        maxx = 0;
+        maxy = 0;
+        for( int sm = 0; sm < MAPSIZE * MAPSIZE; sm++ ) {
+            if( corridor->test( sm ) ) {
+                minx = std::min( minx, sm / MAPSIZE * SEEX );
+                miny = std::min( miny, sm % MAPSIZE * SEEY );
+                maxx = std::max( maxx, ( sm / MAPSIZE + 1 ) * SEEX );
+                maxy = std::max( maxy, ( sm % MAPSIZE + 1 ) * SEEY );
+            }
+        }
+    }
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
+    if( corridor != nullptr ) {
+        searched |= *corridor;
+    } else {
+        for( int smx = minx / SEEX; smx <= maxx / SEEX; smx++ ) {
+            for( int smy = miny / SEEY; smy <= maxy / SEEY; smy++ ) {
+                searched.set( smx * MAPSIZE + smy );
+            }
+        }
+    }
 
-    pathfinder pf( point( minx, miny ), point( maxx, maxy ) );
+    pathfinder &pf = pathfinder::workspace();
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -268,6 +757,11 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     pf.unclose_point( t );
     pf.add_point( 0, 0, f, f );
 
+    if( f.z == t.z ) {
+        return jump_route( f, t, settings, pre_closed, pf, point( minx, miny ), point( maxx, maxy ),
+                           corridor );
+    }
+
     bool done = false;
 
     do {
@@ -275,7 +769,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
+        auto &cur_state = layer.state_at( parent_index );
         if( cur_state == ASL_CLOSED ) {
             continue;
         }
@@ -311,149 +805,34 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             if( p.x < minx || p.x >= maxx || p.y < miny || p.y >= maxy ) {
                 continue;
             }
-
-            if( layer.state[index] == ASL_CLOSED ) {
-                continue;
-            }
-
-            int part = -1;
-            const vehicle *veh = veh_at_internal( p, part );
-            if( cur_veh &&
-                !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
-                //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
+            if( corridor != nullptr && !corridor->test( p.x / SEEX * MAPSIZE + p.y / SEEY ) ) {
                 continue;
             }
 
-            if( veh && veh != cur_veh &&
-                !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
-                //Same as above but moving into rather than out of a vehicle
+            if( layer.state_at( index ) == ASL_CLOSED ) {
                 continue;
             }
 
-            // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
-                }
-
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->cpart( part ).hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
+            const route_step step = route_step_cost( cur, cur_veh, p, settings );
+            if( step.ledge ) {
+                tripoint below( p.xy(), p.z - 1 );
+                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
+                    // Otherwise this would have been a huge fall
+                    auto &layer = pf.get_layer( p.z - 1 );
+                    // From cur, not p, because we won't be walking on air
+                    pf.add_point( layer.gscore[parent_index] + 10,
+                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                  cur, below );
                 }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
-
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+            }
+            if( step.cost < 0 ) {
+                if( step.close ) {
+                    // Close it so that next time we won't try to calculate costs
+                    layer.state[index] = ASL_CLOSED;
                 }
-
+                continue;
             }
+            const int newg = layer.gscore[parent_index] + step.cost;
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
@@ -549,3 +928,322 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
     return ret;
 }
+
+std::vector<tripoint> map::route_shared( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings ) const
+{
+    if( f == t || f.z != t.z || !inbounds( f ) || !inbounds( t ) ) {
+        return route( f, t, settings );
+    }
+    ZoneScoped;
+    ZoneText( pathfinding_stats::caller_name( pathfinding_stats::current_caller() ),
+              std::strlen( pathfinding_stats::caller_name( pathfinding_stats::current_caller() ) ) );
+    const pathfinding_stats::search_timer timer( route_scale::map );
+    std::vector<tripoint> ret = flat_line_route( *this, f, t, {} );
+    if( !ret.empty() ) {
+        pathfinding_stats::count_shortcut();
+        return ret;
+    }
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return ret;
+    }
+
+    // Brings the cache up to date, which drops fields of changed terrain
+    get_pathfinding_cache_ref( t.z );
+    pathfinding_cache &cache = get_pathfinding_cache( t.z );
+    auto iter = std::find_if( cache.route_fields.begin(), cache.route_fields.end(),
+    [&]( const route_field & field ) {
+        return field.target == t && field.settings == settings;
+    } );
+    if( iter == cache.route_fields.end() ) {
+        // Only a few targets are shared by many creatures
+        constexpr size_t max_fields = 8;
+        if( cache.route_fields.size() >= max_fields ) {
+            cache.route_fields.erase( cache.route_fields.begin() );
+        }
+        cache.route_fields.push_back( { t, settings, 0, {} } );
+        iter = std::prev( cache.route_fields.end() );
+    }
+    route_field &field = *iter;
+    // Possibly worked out ahead by route_batch
+    if( const std::vector<tripoint> *known = cache.routes.find( f, t, settings, {},
+            cache.submap_generation ) ) {
+        pathfinding_stats::count_cached();
+        return *known;
+    }
+    // A* is cheaper than the field until a few creatures go the same way
+    constexpr int popular_requests = 3;
+    if( ++field.requests < popular_requests ) {
+        return route( f, t, settings );
+    }
+    if( field.cost.empty() ) {
+        build_route_field( field );
+    }
+
+    // Walk down the field
+    tripoint cur = f;
+    while( cur != t ) {
+        const int cur_cost = field.cost[flat_index( cur )];
+        if( cur_cost == INT_MAX || ret.size() > static_cast<size_t>( settings.max_length ) ) {
+            return {};
+        }
+        int cur_part;
+        const vehicle *cur_veh = veh_at_internal( cur, cur_part );
+        for( const tripoint &p : points_in_radius( cur, 1 ) ) {
+            if( p == cur || !inbounds( p ) || field.cost[flat_index( p )] == INT_MAX ) {
+                continue;
+            }
+            const route_step step = route_step_cost( cur, cur_veh, p, settings );
+            if( step.cost >= 0 && step.cost + field.cost[flat_index( p )] == cur_cost ) {
+                ret.push_back( p );
+                break;
+            }
+        }
+        if( ret.empty() || ret.back() == cur ) {
+            debugmsg( "Route field to %d:%d:%d is broken at %d:%d:%d", t.x, t.y, t.z, cur.x, cur.y, cur.z );
+            return {};
+        }
+        cur = ret.back();
+    }
+    return ret;
+}
+
+void map::build_route_field( route_field &field ) const
+{
+    const tripoint &t = field.target;
+    field.cost.assign( MAPSIZE_X * MAPSIZE_Y, INT_MAX );
+    field.cost[flat_index( t )] = 0;
+    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
+    open;
+    open.emplace( 0, t );
+    // Dijkstra outwards from the target, over the same steps as route() takes towards it
+    while( !open.empty() ) {
+        const auto [cost, cur] = open.top();
+        open.pop();
+        if( cost > field.cost[flat_index( cur )] ) {
+            continue;
+        }
+        pathfinding_stats::count_expanded();
+        for( const tripoint &from : points_in_radius( cur, 1 ) ) {
+            if( from == cur || !inbounds( from ) ) {
+                continue;
+            }
+            int from_part;
+            const vehicle *from_veh = veh_at_internal( from, from_part );
+            const route_step step = route_step_cost( from, from_veh, cur, field.settings );
+            // Drops down ledges lead off this z-level
+            if( step.cost < 0 || step.ledge ) {
+                continue;
+            }
+            const int from_cost = cost + step.cost;
+            int &best = field.cost[flat_index( from )];
+            if( from_cost <= field.settings.max_length && from_cost < best ) {
+                best = from_cost;
+                open.emplace( from_cost, from );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::jump_route( const tripoint &f, const tripoint &t,
+                                       const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                       pathfinder &pf, point min, point max, const route_corridor *corridor ) const
+{
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( f.z );
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> closed;
+    for( const tripoint &p : pre_closed ) {
+        if( p.z == f.z && p != f && p != t && inbounds( p ) ) {
+            closed.set( flat_index( p ) );
+        }
+    }
+    const auto in_bounds = [&]( point p ) {
+        return p.x >= min.x && p.x < max.x && p.y >= min.y && p.y < max.y &&
+               ( corridor == nullptr || corridor->test( p.x / SEEX * MAPSIZE + p.y / SEEY ) );
+    };
+    // Flat ground, which costs the same to cross whatever the settings are
+    const auto open = [&]( point p ) {
+        return in_bounds( p ) && !( pf_cache.special[p.x][p.y] & non_normal ) &&
+               !closed.test( p.x * MAPSIZE_Y + p.y );
+    };
+    // Surrounded by flat ground or the edge of the search, anything else needs a closer look
+    const auto plain = [&]( point p ) {
+        for( const point &d : eight_adjacent_offsets ) {
+            if( in_bounds( p + d ) && !open( p + d ) ) {
+                return false;
+            }
+        }
+        return true;
+    };
+    // Routes along the edge of the search can turn around its corners here
+    const auto forced = [&]( point p, point d ) {
+        if( d.x == 0 || d.y == 0 ) {
+            const point side( d.y, d.x );
+            return ( !in_bounds( p + side ) && in_bounds( p + side + d ) ) ||
+                   ( !in_bounds( p - side ) && in_bounds( p - side + d ) );
+        }
+        return ( !in_bounds( p - point( d.x, 0 ) ) && in_bounds( p + point( -d.x, d.y ) ) ) ||
+               ( !in_bounds( p - point( 0, d.y ) ) && in_bounds( p + point( d.x, -d.y ) ) );
+    };
+    const point target = t.xy();
+    const auto jump_straight = [&]( point p, point d ) -> std::optional<point> {
+        while( true ) {
+            p += d;
+            if( !open( p ) ) {
+                return std::nullopt;
+            }
+            if( p == target || !plain( p ) || forced( p, d ) ) {
+                return p;
+            }
+        }
+    };
+    // The next tile from `p` in direction `d` the search has to stop at, nullopt if there is none
+    const auto jump = [&]( point p, point d ) -> std::optional<point> {
+        if( d.x == 0 || d.y == 0 ) {
+            return jump_straight( p, d );
+        }
+        while( true ) {
+            p += d;
+            if( !open( p ) ) {
+                return std::nullopt;
+            }
+            if( p == target || !plain( p ) || forced( p, d ) ||
+                jump_straight( p, point( d.x, 0 ) ) || jump_straight( p, point( 0, d.y ) ) ) {
+                return p;
+            }
+        }
+    };
+
+    path_data_layer &layer = pf.get_layer( f.z );
+    bool done = false;
+    while( !pf.empty() ) {
+        const tripoint cur = pf.get_next();
+        const int cur_index = flat_index( cur );
+        astar_state &cur_state = layer.state_at( cur_index );
+        if( cur_state == ASL_CLOSED ) {
+            continue;
+        }
+        const int cur_g = layer.gscore[cur_index];
+        if( cur_g > settings.max_length ) {
+            // Shortest path would be too long, return empty vector
+            return std::vector<tripoint>();
+        }
+        if( cur == t ) {
+            done = true;
+            break;
+        }
+        cur_state = ASL_CLOSED;
+
+        if( cur != f && plain( cur.xy() ) && open( cur.xy() ) ) {
+            // Open ground, skip straight to the tiles where something could change
+            for( const point &d : eight_adjacent_offsets ) {
+                const std::optional<point> next = jump( cur.xy(), d );
+                if( !next ) {
+                    continue;
+                }
+                const tripoint p( *next, cur.z );
+                const int g = cur_g + ( d.x != 0 && d.y != 0 ? 3 : 2 ) * square_dist( cur, p );
+                if( layer.state_at( flat_index( p ) ) == ASL_NONE || g < layer.gscore[flat_index( p )] ) {
+                    pf.add_point( g, g + 2 * rl_dist( p, t ), cur, p );
+                }
+            }
+            continue;
+        }
+
+        int cur_part;
+        const vehicle *cur_veh = veh_at_internal( cur, cur_part );
+        for( const point &d : eight_adjacent_offsets ) {
+            const tripoint p = cur + d;
+            if( !in_bounds( p.xy() ) ) {
+                continue;
+            }
+            const int index = flat_index( p );
+            if( layer.state_at( index ) == ASL_CLOSED ) {
+                continue;
+            }
+            // Drops down ledges can't lead back up to this z-level
+            const route_step step = route_step_cost( cur, cur_veh, p, settings );
+            if( step.cost < 0 || step.ledge ) {
+                if( step.close ) {
+                    layer.state[index] = ASL_CLOSED;
+                }
+                continue;
+            }
+            const int g = cur_g + step.cost;
+            if( layer.state[index] == ASL_NONE || g < layer.gscore[index] ) {
+                pf.add_point( g, g + 2 * rl_dist( p, t ), cur, p );
+            }
+        }
+    }
+
+    std::vector<tripoint> ret;
+    if( !done ) {
+        return ret;
+    }
+    // Fill in the tiles jumped over
+    for( tripoint cur = t; cur != f; ) {
+        const tripoint &par = layer.parent[flat_index( cur )];
+        const tripoint d( sgn( par.x - cur.x ), sgn( par.y - cur.y ), 0 );
+        for( tripoint p = cur; p != par; p += d ) {
+            ret.push_back( p );
+        }
+        cur = par;
+    }
+    std::reverse( ret.begin(), ret.end() );
+    return ret;
+}
+
+std::vector<tripoint> map::route_by_stairs( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+        route_corridor *searched ) const
+{
+    // Only the most promising few stairs of each level are tried
+    constexpr size_t tried_stairs = 3;
+    const int dz = t.z > f.z ? 1 : -1;
+    std::vector<tripoint> ret;
+    tripoint cur = f;
+    while( cur.z != t.z ) {
+        const pathfinding_cache &cache = get_pathfinding_cache_ref( cur.z );
+        std::vector<point> stairs = dz > 0 ? cache.stairs_up : cache.stairs_down;
+        const auto detour = [&]( const point & p ) {
+            return rl_dist( cur.xy(), p ) + rl_dist( p, t.xy() );
+        };
+        std::stable_sort( stairs.begin(), stairs.end(), [&]( const point & a, const point & b ) {
+            return detour( a ) < detour( b );
+        } );
+        bool climbed = false;
+        for( size_t i = 0; i < stairs.size() && i < tried_stairs && !climbed; i++ ) {
+            const tripoint stair( stairs[i], cur.z );
+            tripoint dest( stair.xy(), cur.z + dz );
+            const bool found = dz > 0 ? vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) :
+                               vertical_move_destination<TFLAG_GOES_UP>( *this, dest );
+            if( !found || pre_closed.count( dest ) ) {
+                continue;
+            }
+            const std::vector<tripoint> leg = stair == cur ? std::vector<tripoint>() :
+                                              find_route( cur, stair, settings, pre_closed, searched );
+            if( stair != cur && leg.empty() ) {
+                continue;
+            }
+            ret.insert( ret.end(), leg.begin(), leg.end() );
+            // Stairs teleport, like in route_within
+            ret.push_back( dest );
+            cur = dest;
+            climbed = true;
+        }
+        if( !climbed ) {
+            return {};
+        }
+    }
+    if( cur != t ) {
+        const std::vector<tripoint> leg = find_route( cur, t, settings, pre_closed, searched );
+        if( leg.empty() ) {
+            return {};
+        }
+        ret.insert( ret.end(), leg.begin(), leg.end() );
+    }
+    // Flat ground costs 2 per tile, so this is the least the route could cost
+    if( static_cast<int>( ret.size() ) * 2 > settings.max_length ) {
+        return {};
+    }
+    return ret;
+}
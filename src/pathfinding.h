@@ -2,7 +2,15 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -38,15 +46,6 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
-struct pathfinding_cache {
-    pathfinding_cache();
-    ~pathfinding_cache() = default;
-
-    bool dirty;
-
-    pf_special special[MAPSIZE_X][MAPSIZE_Y];
-};
-
 struct pathfinding_settings {
     int bash_strength = 0;
     int max_dist = 0;
@@ -71,6 +70,156 @@ struct pathfinding_settings {
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
     pathfinding_settings &operator = ( const pathfinding_settings & ) = default;
+    bool operator==( const pathfinding_settings & ) const = default;
+};
+
+// Arguments of one map::route call, for map::route_batch
+struct route_request {
+    tripoint f;
+    tripoint t;
+    pathfinding_settings settings;
+    std::set<tripoint> pre_closed;
+};
+
+// Cheapest cost of a route from every tile of a z-level to one target, for creatures sharing it
+struct route_field {
+    tripoint target;
+    pathfinding_settings settings;
+    // Routes asked for, the costs are only worked out once a few creatures want them
+    int requests = 0;
+    // Indexed by `x * MAPSIZE_Y + y`, INT_MAX where the target is out of reach
+    std::vector<int> cost;
+};
+
+/**
+ * Results of recent map::route searches on one z-level.
+ *
+ * A result is kept until one of the submaps its search could reach is recomputed.
+ * Counts hits and misses so its effectiveness can be checked from the debug menu.
+ */
+class route_memo
+{
+    public:
+        using submaps = std::bitset<MAPSIZE *MAPSIZE>;
+
+        /** The remembered route, nullptr if there is none or a searched submap changed since. */
+        const std::vector<tripoint> *find( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                                           const std::array<int, MAPSIZE *MAPSIZE> &submap_generation ) const;
+        void insert( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                     const std::set<tripoint> &pre_closed, const submaps &searched, int generation,
+                     const std::vector<tripoint> &route );
+
+        std::uint64_t hits() const {
+            return hit_count;
+        }
+        std::uint64_t misses() const {
+            return miss_count;
+        }
+        void reset_stats() {
+            hit_count = 0;
+            miss_count = 0;
+        }
+
+    private:
+        static constexpr size_t max_entries = 64;
+
+        struct entry {
+            tripoint f;
+            tripoint t;
+            pathfinding_settings settings;
+            std::set<tripoint> pre_closed;
+            submaps searched;
+            int generation = 0;
+            std::vector<tripoint> route;
+        };
+
+        // Oldest first
+        std::vector<entry> entries;
+        mutable std::uint64_t hit_count = 0;
+        mutable std::uint64_t miss_count = 0;
+};
+
+/**
+ * Whether monsters were willing to step on each tile of one z-level, see monster::will_move_to.
+ *
+ * Each tile remembers one answer, for the kind of monster that asked last. Kinds are told
+ * apart by a mask of the monster traits the answer depends on. Forgotten every turn and
+ * whenever the map on the z-level or the one above changes.
+ */
+class move_memo
+{
+    public:
+        /** 1 or 0 for a remembered answer, -1 if there is none. */
+        int get( const point &p, std::uint32_t mode ) const {
+            if( entries.empty() ) {
+                return -1;
+            }
+            const entry &e = entries[p.x * MAPSIZE_Y + p.y];
+            return e.generation == generation && e.mode == mode ? e.allowed : -1;
+        }
+
+        void insert( const point &p, std::uint32_t mode, bool allowed ) {
+            if( entries.empty() ) {
+                entries.resize( MAPSIZE_X * MAPSIZE_Y );
+            }
+            entries[p.x * MAPSIZE_Y + p.y] = { mode, generation, allowed };
+        }
+
+        void clear() {
+            if( ++generation == 0 ) {
+                // Wrapped around, old entries could look current again
+                entries.clear();
+                generation = 1;
+            }
+        }
+
+    private:
+        struct entry {
+            std::uint32_t mode = 0;
+            std::uint32_t generation = 0;
+            bool allowed = false;
+        };
+
+        std::vector<entry> entries;
+        std::uint32_t generation = 1;
+};
+
+struct pathfinding_cache {
+    pathfinding_cache();
+    ~pathfinding_cache() = default;
+
+    bool dirty;
+    // Submaps to recompute, indexed by `smx * MAPSIZE + smy`, all of them if `dirty` is set
+    std::bitset<MAPSIZE *MAPSIZE> dirty_submaps;
+    // Bumped on every update, submaps remember the one they were last recomputed in
+    int generation = 0;
+    std::array<int, MAPSIZE *MAPSIZE> submap_generation = {};
+
+    route_memo routes;
+    move_memo monster_moves;
+
+    pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    // Walkable areas of each submap and how they connect, to plan long routes over
+    // Area of each tile within its submap, numbered from 1, 0 if it can't be walked on
+    std::uint8_t area[MAPSIZE_X][MAPSIZE_Y];
+    // Nodes of the areas of submap `smx * MAPSIZE + smy` start at first_node[smx * MAPSIZE + smy]
+    std::array<int, MAPSIZE *MAPSIZE + 1> first_node;
+    std::vector<point> node_submap;
+    std::vector<std::vector<int>> node_links;
+
+    // Node of the area containing the tile, -1 if it can't be walked on
+    int area_node( const point &p ) const;
+    // Numbers the tiles marked walkable in `area` and links the areas of neighbouring submaps
+    void update_areas();
+
+    // Tiles with stairs or ladders leading up and down from this level
+    std::vector<point> stairs_up;
+    std::vector<point> stairs_down;
+
+    // Shared routes to recent targets, dropped when the cache is rebuilt, see map::route_shared
+    std::vector<route_field> route_fields;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
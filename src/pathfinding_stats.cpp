@@ -0,0 +1,193 @@
+#include "pathfinding_stats.h"
+
+#include <atomic>
+
+#include "string_formatter.h"
+
+namespace pathfinding_stats
+{
+
+namespace
+{
+
+struct atomic_totals {
+    std::atomic<std::uint64_t> searches = 0;
+    std::atomic<std::uint64_t> expanded = 0;
+    std::atomic<std::uint64_t> shortcuts = 0;
+    std::atomic<std::uint64_t> cached = 0;
+    std::atomic<std::uint64_t> microseconds = 0;
+    std::array<std::atomic<std::uint64_t>, num_time_buckets> time_histogram = {};
+};
+
+constexpr int num_scales = static_cast<int>( route_scale::num_route_scales );
+constexpr int num_callers = static_cast<int>( route_caller::num_route_callers );
+
+std::array<std::array<atomic_totals, num_callers>, num_scales> all_totals;
+
+thread_local route_caller current = route_caller::other;
+thread_local search_timer *active = nullptr;
+
+atomic_totals &totals_of( route_scale scale, route_caller caller )
+{
+    return all_totals[static_cast<int>( scale )][static_cast<int>( caller )];
+}
+
+} // namespace
+
+caller_scope::caller_scope( route_caller caller ) : previous( current )
+{
+    current = caller;
+}
+
+caller_scope::~caller_scope()
+{
+    current = previous;
+}
+
+search_timer::search_timer( route_scale scale ) : outermost( active == nullptr ), scale( scale ),
+    caller( current )
+{
+    if( outermost ) {
+        active = this;
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+search_timer::~search_timer()
+{
+    if( !outermost ) {
+        return;
+    }
+    active = nullptr;
+    const std::uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - start ).count();
+    int bucket = 0;
+    for( std::uint64_t limit = 10; us >= limit && bucket < num_time_buckets - 1; limit *= 10 ) {
+        bucket++;
+    }
+    constexpr std::memory_order relaxed = std::memory_order_relaxed;
+    atomic_totals &t = totals_of( scale, caller );
+    t.searches.fetch_add( 1, relaxed );
+    t.expanded.fetch_add( expanded, relaxed );
+    t.shortcuts.fetch_add( shortcut ? 1 : 0, relaxed );
+    t.cached.fetch_add( cached ? 1 : 0, relaxed );
+    t.microseconds.fetch_add( us, relaxed );
+    t.time_histogram[bucket].fetch_add( 1, relaxed );
+}
+
+route_caller current_caller()
+{
+    return current;
+}
+
+const char *caller_name( route_caller caller )
+{
+    switch( caller ) {
+        case route_caller::other:
+            return "other";
+        case route_caller::monster:
+            return "monster";
+        case route_caller::npc:
+            return "npc";
+        case route_caller::player:
+            return "player";
+        case route_caller::vehicle:
+            return "vehicle";
+        case route_caller::num_route_callers:
+            break;
+    }
+    return "invalid";
+}
+
+const char *scale_name( route_scale scale )
+{
+    switch( scale ) {
+        case route_scale::map:
+            return "map";
+        case route_scale::overmap:
+            return "overmap";
+        case route_scale::num_route_scales:
+            break;
+    }
+    return "invalid";
+}
+
+void count_expanded( int nodes )
+{
+    if( active != nullptr ) {
+        active->expanded += nodes;
+    }
+}
+
+void count_shortcut()
+{
+    if( active != nullptr ) {
+        active->shortcut = true;
+    }
+}
+
+void count_cached()
+{
+    if( active != nullptr ) {
+        active->cached = true;
+    }
+}
+
+totals get( route_scale scale, route_caller caller )
+{
+    const atomic_totals &t = totals_of( scale, caller );
+    totals ret;
+    ret.searches = t.searches;
+    ret.expanded = t.expanded;
+    ret.shortcuts = t.shortcuts;
+    ret.cached = t.cached;
+    ret.microseconds = t.microseconds;
+    for( int i = 0; i < num_time_buckets; i++ ) {
+        ret.time_histogram[i] = t.time_histogram[i];
+    }
+    return ret;
+}
+
+void reset()
+{
+    for( std::array<atomic_totals, num_callers> &by_caller : all_totals ) {
+        for( atomic_totals &t : by_caller ) {
+            t.searches = 0;
+            t.expanded = 0;
+            t.shortcuts = 0;
+            t.cached = 0;
+            t.microseconds = 0;
+            for( std::atomic<std::uint64_t> &bucket : t.time_histogram ) {
+                bucket = 0;
+            }
+        }
+    }
+}
+
+std::string report()
+{
+    std::string ret;
+    for( int s = 0; s < num_scales; s++ ) {
+        for( int c = 0; c < num_callers; c++ ) {
+            const route_scale scale = static_cast<route_scale>( s );
+            const route_caller caller = static_cast<route_caller>( c );
+            const totals t = get( scale, caller );
+            if( t.searches == 0 ) {
+                continue;
+            }
+            const double searches = t.searches;
+            ret += string_format( "%s %s: %d searches, %.1f nodes and %.3f ms each, "
+                                  "%.0f%% straight lines, %.0f%% remembered, times (<10us, <100us, <1ms, <10ms, <100ms, more):",
+                                  scale_name( scale ), caller_name( caller ), t.searches, t.expanded / searches,
+                                  t.microseconds / searches / 1000.0, 100.0 * t.shortcuts / searches,
+                                  100.0 * t.cached / searches );
+            for( const std::uint64_t count : t.time_histogram ) {
+                ret += string_format( " %d", count );
+            }
+            ret += "\n";
+        }
+    }
+    return ret;
+}
+
+} // namespace pathfinding_stats
@@ -0,0 +1,106 @@
+#pragma once
+#ifndef CATA_SRC_PATHFINDING_STATS_H
+#define CATA_SRC_PATHFINDING_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/** Who a route search is made for, so the cost of pathfinding can be split by caller. */
+enum class route_caller : int {
+    other,
+    monster,
+    npc,
+    player,
+    vehicle,
+    num_route_callers
+};
+
+/** What a route search is made over. */
+enum class route_scale : int {
+    map,
+    overmap,
+    num_route_scales
+};
+
+/**
+ * Counters and timings of route searches, by scale and caller.
+ *
+ * Callers tag their searches with a @ref caller_scope, the searches themselves time
+ * and count them with a @ref search_timer. Safe to use from the thread pool.
+ */
+namespace pathfinding_stats
+{
+
+/** Buckets of the search time histogram, the first ends at 10us and each is ten times longer. */
+constexpr int num_time_buckets = 6;
+
+struct totals {
+    std::uint64_t searches = 0;
+    /** Nodes taken off the open list. */
+    std::uint64_t expanded = 0;
+    /** Searches answered by a straight line. */
+    std::uint64_t shortcuts = 0;
+    /** Searches answered by a remembered result. */
+    std::uint64_t cached = 0;
+    std::uint64_t microseconds = 0;
+    std::array<std::uint64_t, num_time_buckets> time_histogram = {};
+};
+
+/** Searches made on this thread while this lives are counted for `caller`. */
+class caller_scope
+{
+    public:
+        explicit caller_scope( route_caller caller );
+        ~caller_scope();
+        caller_scope( const caller_scope & ) = delete;
+        caller_scope &operator=( const caller_scope & ) = delete;
+
+    private:
+        route_caller previous;
+};
+
+/**
+ * Times a search and adds it to the totals of the current caller when it ends.
+ * Searches started on the same thread while one is timed count as part of that one.
+ */
+class search_timer
+{
+    public:
+        explicit search_timer( route_scale scale );
+        ~search_timer();
+        search_timer( const search_timer & ) = delete;
+        search_timer &operator=( const search_timer & ) = delete;
+
+    private:
+        friend void count_expanded( int nodes );
+        friend void count_shortcut();
+        friend void count_cached();
+
+        bool outermost;
+        route_scale scale;
+        route_caller caller;
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t expanded = 0;
+        bool shortcut = false;
+        bool cached = false;
+};
+
+route_caller current_caller();
+const char *caller_name( route_caller caller );
+const char *scale_name( route_scale scale );
+
+/** These add to the search timed on this thread, if there is one. */
+void count_expanded( int nodes = 1 );
+void count_shortcut();
+void count_cached();
+
+totals get( route_scale scale, route_caller caller );
+void reset();
+/** One line for each scale and caller that searched since the last reset. */
+std::string report();
+
+} // namespace pathfinding_stats
+
+#endif // CATA_SRC_PATHFINDING_STATS_H
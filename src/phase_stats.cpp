@@ -0,0 +1,22 @@
+#include "phase_stats.h"
+
+#include "string_formatter.h"
+
+namespace phase_stats
+{
+
+std::string report_line( const std::string &name, std::uint64_t count,
+                         std::uint64_t nanoseconds )
+{
+    const double ms = nanoseconds / 1e6;
+    return string_format( "%s: %.3f ms in %d calls, %.2f us each\n", name, ms, count,
+                          ms * 1000.0 / count );
+}
+
+std::string csv_line( const std::string &name, std::uint64_t count, std::uint64_t nanoseconds )
+{
+    const double us = nanoseconds / 1e3;
+    return string_format( "%s,%d,%.1f,%.2f\n", name, count, us, us / count );
+}
+
+} // namespace phase_stats
@@ -0,0 +1,213 @@
+#pragma once
+#ifndef CATA_SRC_PHASE_STATS_H
+#define CATA_SRC_PHASE_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * The timers and wall time totals the game's stats are made of. Each of them, like
+ * @ref monster_turn_stats or @ref lua_stats, is one of these for its own enum and names.
+ */
+namespace phase_stats
+{
+
+/** "name: 1.234 ms in 5 calls, 0.25 us each" and a newline. */
+std::string report_line( const std::string &name, std::uint64_t count,
+                         std::uint64_t nanoseconds );
+/** "name,5,1234.0,246.80" and a newline, the name being one or more columns itself. */
+std::string csv_line( const std::string &name, std::uint64_t count, std::uint64_t nanoseconds );
+
+/** Passes what it times and the time from its creation to its end to `add`. */
+template<typename Key, void( *add )( Key, std::chrono::nanoseconds )>
+class scoped_timer
+{
+    public:
+        template<typename... Args>
+        explicit scoped_timer( Args &&... args ) : key( std::forward<Args>( args )... ),
+            start( std::chrono::steady_clock::now() ) {
+        }
+        ~scoped_timer() {
+            add( std::move( key ), std::chrono::steady_clock::now() - start );
+        }
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        Key key;
+        std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Count and wall time of each of the phases numbered from 0 up to `last`, named by `name`.
+ * The totals are atomic, so phases can be timed on any thread.
+ */
+template<typename Phase, Phase last, const char *( *name )( Phase )>
+class per_phase
+{
+    public:
+        static constexpr int num_phases = static_cast<int>( last );
+
+        /**
+         * Adds the time from its creation to its end to `phase`.
+         * Timers of a phase started on the same thread while it is timed count as part of that one.
+         */
+        class timer
+        {
+            public:
+                explicit timer( Phase phase ) : outermost( !timing[static_cast<int>( phase )] ),
+                    phase( phase ) {
+                    if( outermost ) {
+                        timing[static_cast<int>( phase )] = true;
+                        start = std::chrono::steady_clock::now();
+                    }
+                }
+                ~timer() {
+                    if( !outermost ) {
+                        return;
+                    }
+                    timing[static_cast<int>( phase )] = false;
+                    constexpr std::memory_order relaxed = std::memory_order_relaxed;
+                    atomic_totals &t = totals[static_cast<int>( phase )];
+                    t.count.fetch_add( 1, relaxed );
+                    t.nanoseconds.fetch_add( std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::steady_clock::now() - start ).count(), relaxed );
+                }
+                timer( const timer & ) = delete;
+                timer &operator=( const timer & ) = delete;
+
+            private:
+                bool outermost;
+                Phase phase;
+                std::chrono::steady_clock::time_point start;
+        };
+
+        /** How many times the phase was timed since the last reset. */
+        static std::uint64_t count( Phase phase ) {
+            return totals[static_cast<int>( phase )].count;
+        }
+        static std::uint64_t microseconds( Phase phase ) {
+            return totals[static_cast<int>( phase )].nanoseconds / 1000;
+        }
+
+        static void reset() {
+            for( atomic_totals &t : totals ) {
+                t.count = 0;
+                t.nanoseconds = 0;
+            }
+        }
+        /** One line for each phase that was timed since the last reset. */
+        static std::string report() {
+            std::string ret;
+            for( int p = 0; p < num_phases; p++ ) {
+                const std::uint64_t times = totals[p].count;
+                if( times > 0 ) {
+                    ret += report_line( name( static_cast<Phase>( p ) ), times, totals[p].nanoseconds );
+                }
+            }
+            return ret;
+        }
+
+    private:
+        struct atomic_totals {
+            std::atomic<std::uint64_t> count = 0;
+            std::atomic<std::uint64_t> nanoseconds = 0;
+        };
+        static inline std::array<atomic_totals, num_phases> totals;
+        static inline thread_local std::array<bool, num_phases> timing = {};
+};
+
+/**
+ * Count and wall time of each id, timed as one of the kinds of `Kind`, named by `name`.
+ * The totals are behind a mutex, so ids can be timed on any thread.
+ */
+template<typename Kind, const char *( *name )( Kind )>
+class per_id
+{
+    public:
+        using key = std::pair<Kind, std::string>;
+
+        static void add( key k, std::chrono::nanoseconds time ) {
+            std::lock_guard<std::mutex> lock( totals_mutex );
+            id_totals &t = all_totals[std::move( k )];
+            t.count++;
+            t.nanoseconds += time.count();
+        }
+        /** Adds the time from its creation to its end to the totals of the kind and id. */
+        using timer = scoped_timer<key, add>;
+
+        /** How many times `id` was timed as `kind` since the last reset. */
+        static std::uint64_t count( Kind kind, const std::string &id ) {
+            return get_totals( kind, id ).count;
+        }
+        static std::uint64_t microseconds( Kind kind, const std::string &id ) {
+            return get_totals( kind, id ).nanoseconds / 1000;
+        }
+
+        static void reset() {
+            std::lock_guard<std::mutex> lock( totals_mutex );
+            all_totals.clear();
+        }
+        /** One line for each of the `max_lines` ids that took the longest since the last reset. */
+        static std::string report( int max_lines ) {
+            std::string ret;
+            int lines = 0;
+            for( const std::pair<key, id_totals> &elem : sorted_totals() ) {
+                if( lines++ >= max_lines ) {
+                    break;
+                }
+                ret += report_line( std::string( name( elem.first.first ) ) + " " + elem.first.second,
+                                    elem.second.count, elem.second.nanoseconds );
+            }
+            return ret;
+        }
+        /** All the totals since the last reset, one row for each kind and id, longest first. */
+        static std::string csv() {
+            std::string ret = "kind,id,calls,total_us,mean_us\n";
+            for( const std::pair<key, id_totals> &elem : sorted_totals() ) {
+                ret += csv_line( std::string( name( elem.first.first ) ) + "," + elem.first.second,
+                                 elem.second.count, elem.second.nanoseconds );
+            }
+            return ret;
+        }
+
+    private:
+        struct id_totals {
+            std::uint64_t count = 0;
+            std::uint64_t nanoseconds = 0;
+        };
+
+        static id_totals get_totals( Kind kind, const std::string &id ) {
+            std::lock_guard<std::mutex> lock( totals_mutex );
+            const auto iter = all_totals.find( key( kind, id ) );
+            return iter == all_totals.end() ? id_totals() : iter->second;
+        }
+        // Longest first
+        static std::vector<std::pair<key, id_totals>> sorted_totals() {
+            std::vector<std::pair<key, id_totals>> ret;
+            {
+                std::lock_guard<std::mutex> lock( totals_mutex );
+                ret.assign( all_totals.begin(), all_totals.end() );
+            }
+            std::stable_sort( ret.begin(), ret.end(), []( const std::pair<key, id_totals> &l,
+            const std::pair<key, id_totals> &r ) {
+                return l.second.nanoseconds > r.second.nanoseconds;
+            } );
+            return ret;
+        }
+
+        static inline std::mutex totals_mutex;
+        static inline std::map<key, id_totals> all_totals;
+};
+
+} // namespace phase_stats
+
+#endif // CATA_SRC_PHASE_STATS_H
@@ -594,7 +594,7 @@ void pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
             from_vehicle = cargo_part >= 0;
         } else {
             // Nothing to change, default is to pick from ground anyway.
-            if( g->m.has_flag( "SEALED", p ) ) {
+            if( g->m.has_flag( TFLAG_SEALED, p ) ) {
                 return;
             }
         }
@@ -651,7 +651,7 @@ void pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
         // Bail out if this square cannot be auto-picked-up
         if( g->check_zone( zone_type_id( "NO_AUTO_PICKUP" ), p ) ) {
             return;
-        } else if( g->m.has_flag( "SEALED", p ) ) {
+        } else if( g->m.has_flag( TFLAG_SEALED, p ) ) {
             return;
         }
     }
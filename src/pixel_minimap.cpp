@@ -21,6 +21,7 @@
 #include "color.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "cuboid_rectangle.h"
 #include "debug.h"
 #include "game.h"
 #include "game_constants.h"
@@ -124,10 +125,8 @@ SDL_Color get_critter_color( Creature *critter, int flicker, int mixture )
 } // namespace
 
 // a texture pool to avoid recreating textures every time player changes their view
-// at most 142 out of 144 textures can be in use due to regular player movement
-//  (moving from submap corner to new corner) with MAPSIZE = 11
-// textures are dumped when the player moves more than one submap in one update
-//  (teleporting, z-level change) to prevent running out of the remaining pool
+// at most 121 out of 144 textures are in use with MAPSIZE = 11, the textures of submaps
+// that went out of view are released before those coming into view are requested
 class pixel_minimap::shared_texture_pool
 {
     public:
@@ -231,21 +230,18 @@ void pixel_minimap::set_settings( const pixel_minimap_settings &settings )
 
 void pixel_minimap::prepare_cache_for_updates( const tripoint &center )
 {
-    const tripoint new_center_sm = get_map().get_abs_sub() + ms_to_sm_copy( center );
-    const tripoint center_sm_diff = cached_center_sm - new_center_sm;
-
-    //invalidate the cache if the game shifted more than one submap in the last update, or if z-level changed.
-    if( std::abs( center_sm_diff.x ) > 1 ||
-        std::abs( center_sm_diff.y ) > 1 ||
-        std::abs( center_sm_diff.z ) > 0 ) {
-        cache.clear();
-    } else {
-        for( auto &mcp : cache ) {
-            mcp.second.touched = false;
+    //the submaps still in view keep their textures, however far the view moved
+    const tripoint first_sm = get_map().get_abs_sub() + tripoint( 0, 0, center.z );
+    const half_open_rectangle<point> in_view( first_sm.xy(), first_sm.xy() + point( MAPSIZE,
+            MAPSIZE ) );
+    for( auto it = cache.begin(); it != cache.end(); ) {
+        if( it->first.z != first_sm.z || !in_view.contains( it->first.xy() ) ) {
+            it = cache.erase( it );
+        } else {
+            it->second.touched = false;
+            ++it;
         }
     }
-
-    cached_center_sm = new_center_sm;
 }
 
 //deletes the mapping of unused submap caches from the main map
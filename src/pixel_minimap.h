@@ -75,8 +75,6 @@ class pixel_minimap
 
         point pixel_size;
 
-        //track the previous viewing area to determine if the minimap cache needs to be cleared
-        tripoint cached_center_sm;
         // track presence of animated beacons to determine whether the minimap needs to be animated
         bool cached_has_animated_beacons = true;
 
@@ -2149,7 +2149,8 @@ std::vector<Creature *> targetable_creatures( const Character &c, const int rang
         const turret_data &turret )
 {
     const vehicle *veh_from_turret = turret ? turret.get_veh() : nullptr;
-    return g->get_creatures_if( [&c, range, veh_from_turret]( const Creature & critter ) -> bool {
+    return g->get_creatures_in_radius( c.pos(), range, [&c, range,
+    veh_from_turret]( const Creature & critter ) -> bool {
         if( std::round( rl_dist_exact( c.pos(), critter.pos() ) ) > range )
         {
             return false;
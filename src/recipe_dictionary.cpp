@@ -1,8 +1,10 @@
 #include "recipe_dictionary.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 
@@ -23,6 +25,7 @@
 #include "skill.h"
 #include "string_id.h"
 #include "string_utils.h"
+#include "translations.h"
 #include "uistate.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -93,29 +96,6 @@ recipe_filter recipe_filter_by_component( const itype_id &c )
     };
 }
 
-// searches for left-anchored partial match in the relevant recipe requirements set
-template <class group>
-bool search_reqs( group gp, const std::string &txt )
-{
-    return std::any_of( gp.begin(), gp.end(), [&]( const typename group::value_type & opts ) {
-        return std::any_of( opts.begin(),
-        opts.end(), [&]( const typename group::value_type::value_type & e ) {
-            return lcmatch( e.to_string(), txt );
-        } );
-    } );
-}
-// template specialization to make component searches easier
-template<>
-bool search_reqs( std::vector<std::vector<item_comp> >  gp,
-                  const std::string &txt )
-{
-    return std::any_of( gp.begin(), gp.end(), [&]( const std::vector<item_comp> &opts ) {
-        return std::any_of( opts.begin(), opts.end(), [&]( const item_comp & ic ) {
-            return lcmatch( item::nname( ic.type ), txt );
-        } );
-    } );
-}
-
 std::vector<const recipe *> recipe_subset::favorite() const
 {
     std::vector<const recipe *> res;
@@ -158,50 +138,105 @@ std::vector<const recipe *> recipe_subset::recent() const
 
     return res;
 }
-std::vector<const recipe *> recipe_subset::search( const std::string &txt,
-        const search_type key ) const
+namespace
 {
-    std::vector<const recipe *> res;
 
-    std::copy_if( recipes.begin(), recipes.end(), std::back_inserter( res ), [&]( const recipe * r ) {
-        if( !*r || r->obsolete ) {
-            return false;
-        }
-        switch( key ) {
-            case search_type::name:
-                return lcmatch( r->result_name(), txt );
+// The texts the searches look through, made and lowered once per recipe, search type and language.
+// Texts made of several names have them on separate lines, so a query can't match across two.
+struct recipe_search_index {
+    static constexpr int num_types = static_cast<int>
+                                     ( recipe_subset::search_type::description_result );
 
-            case search_type::skill:
-                return lcmatch( r->required_skills_string( nullptr, true, false ), txt );
+    int language_version = INVALID_LANGUAGE_VERSION;
+    std::unordered_map<const recipe *, std::array<std::optional<std::string>, num_types>> texts;
+};
 
-            case search_type::primary_skill:
-                return lcmatch( r->skill_used->name(), txt );
+recipe_search_index search_index;
 
-            case search_type::component:
-                return search_reqs( r->simple_requirements().get_components(), txt );
+template <class group>
+std::string requirement_names( const group &gp )
+{
+    std::string ret;
+    for( const auto &opts : gp ) {
+        for( const auto &e : opts ) {
+            ret += e.to_string() + "\n";
+        }
+    }
+    return ret;
+}
 
-            case search_type::tool:
-                return search_reqs( r->simple_requirements().get_tools(), txt );
+template<>
+std::string requirement_names( const std::vector<std::vector<item_comp>> &gp )
+{
+    std::string ret;
+    for( const std::vector<item_comp> &opts : gp ) {
+        for( const item_comp &ic : opts ) {
+            ret += item::nname( ic.type ) + "\n";
+        }
+    }
+    return ret;
+}
+
+std::string search_text( const recipe &r, const recipe_subset::search_type key )
+{
+    using search_type = recipe_subset::search_type;
+    switch( key ) {
+        case search_type::name:
+            return r.result_name();
+        case search_type::skill:
+            return r.required_skills_string( nullptr, true, false );
+        case search_type::primary_skill:
+            return r.skill_used->name();
+        case search_type::component:
+            return requirement_names( r.simple_requirements().get_components() );
+        case search_type::tool:
+            return requirement_names( r.simple_requirements().get_tools() );
+        case search_type::quality:
+            return requirement_names( r.simple_requirements().get_qualities() );
+        case search_type::quality_result: {
+            std::string ret;
+            for( const std::pair<const quality_id, int> &e : r.result()->qualities ) {
+                ret += e.first->name.translated() + "\n";
+            }
+            return ret;
+        }
+        default:
+            return std::string();
+    }
+}
 
-            case search_type::quality:
-                return search_reqs( r->simple_requirements().get_qualities(), txt );
+const std::string &indexed_search_text( const recipe &r, const recipe_subset::search_type key )
+{
+    if( search_index.language_version != detail::get_current_language_version() ) {
+        search_index.texts.clear();
+        search_index.language_version = detail::get_current_language_version();
+    }
+    std::optional<std::string> &text = search_index.texts[&r][static_cast<int>( key )];
+    if( !text ) {
+        text = to_lower_case( search_text( r, key ) );
+    }
+    return *text;
+}
 
-            case search_type::quality_result: {
-                const auto &quals = r->result()->qualities;
-                return std::any_of( quals.begin(), quals.end(), [&]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, txt );
-                } );
-            }
+} // namespace
 
-            case search_type::description_result: {
-                //TODO!: push this up, it's a potentially infinite one I think
-                detached_ptr<item> result = r->create_result();
-                return lcmatch( remove_color_tags( result->info_string( iteminfo_query::no_conditions ) ), txt );
-            }
+std::vector<const recipe *> recipe_subset::search( const std::string &txt,
+        const search_type key ) const
+{
+    std::vector<const recipe *> res;
+    const std::string needle = to_lower_case( txt );
 
-            default:
-                return false;
+    std::copy_if( recipes.begin(), recipes.end(), std::back_inserter( res ), [&]( const recipe * r ) {
+        if( !*r || r->obsolete ) {
+            return false;
+        }
+        if( key == search_type::description_result ) {
+            // Depends on the state of the game, so it isn't indexed
+            //TODO!: push this up, it's a potentially infinite one I think
+            detached_ptr<item> result = r->create_result();
+            return lcmatch( remove_color_tags( result->info_string( iteminfo_query::no_conditions ) ), txt );
         }
+        return indexed_search_text( *r, key ).find( needle ) != std::string::npos;
     } );
 
     return res;
@@ -494,6 +529,7 @@ void recipe_dictionary::finalize()
 void recipe_dictionary::reset()
 {
     deferred.clear();
+    search_index.texts.clear();
     recipe_dict.blueprints.clear();
     recipe_dict.autolearn.clear();
     recipe_dict.recipes.clear();
@@ -973,10 +973,25 @@ void region_terrain_and_furniture_settings::finalize()
             furniture[template_fid.id()].add( fid.id(), actual_pr.second );
         }
     }
+
+    for( const auto &pr : terrain ) {
+        const size_t index = pr.first.to_i();
+        terrain_templates.resize( std::max( terrain_templates.size(), index + 1 ) );
+        terrain_templates[index] = true;
+    }
+    for( const auto &pr : furniture ) {
+        const size_t index = pr.first.to_i();
+        furniture_templates.resize( std::max( furniture_templates.size(), index + 1 ) );
+        furniture_templates[index] = true;
+    }
 }
 
 ter_id region_terrain_and_furniture_settings::resolve( const ter_id &tid ) const
 {
+    const size_t index = tid.to_i();
+    if( index >= terrain_templates.size() || !terrain_templates[index] ) {
+        return tid;
+    }
     ter_id result = tid;
     auto region_list = terrain.find( result );
     while( region_list != terrain.end() ) {
@@ -988,6 +1003,10 @@ ter_id region_terrain_and_furniture_settings::resolve( const ter_id &tid ) const
 
 furn_id region_terrain_and_furniture_settings::resolve( const furn_id &fid ) const
 {
+    const size_t index = fid.to_i();
+    if( index >= furniture_templates.size() || !furniture_templates[index] ) {
+        return fid;
+    }
     furn_id result = fid;
     auto region_list = furniture.find( result );
     while( region_list != furniture.end() ) {
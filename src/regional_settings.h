@@ -206,6 +206,9 @@ struct region_terrain_and_furniture_settings {
     std::map<std::string, std::map<std::string, int>> unfinalized_furniture;
     std::map<ter_id, weighted_int_list<ter_id>> terrain;
     std::map<furn_id, weighted_int_list<furn_id>> furniture;
+    // Indexed by id, whether it has an entry above, so resolving everything else is cheap
+    std::vector<bool> terrain_templates;
+    std::vector<bool> furniture_templates;
 
     void finalize();
     ter_id resolve( const ter_id & ) const;
@@ -43,7 +43,7 @@ void safe_reference<T>::deserialize_global( const JsonArray &jsin )
 
         pair = false;
         uint32_t count = val.get_int();
-        record *rec = new record( id );
+        record *rec = new_record( id );
         rec->json_count = count;
         records_by_id.insert( {id, rec} );
     }
@@ -157,21 +157,99 @@ void serialize<item>( const safe_reference<item> &val, JsonOut &js );
 template<typename T>
 void safe_reference<T>::cleanup()
 {
-    std::set<record *> records;
-    for( auto &rec : records_by_pointer ) {
-        records.insert( rec.second );
-    }
-    for( auto &rec : records_by_id ) {
-        records.insert( rec.second );
-    }
-    for( record *rec : records ) {
+    while( first_record != nullptr ) {
+        record *rec = first_record;
         if( rec->mem_count > 0 ) {
             debugmsg( "Found a safe_reference entry with a mem_count.  It's advised to fully restart the game now in case of crashes." );
         }
-        delete rec;
+        if( !id_is_redirected( rec->id ) && rec->target.p != nullptr ) {
+            rec->target.p->safe_ref_record = nullptr;
+        }
+        delete_record( rec );
     }
     records_by_id.clear();
-    records_by_pointer.clear();
+}
+
+template<typename T>
+void safe_reference<T>::fill( T *obj )
+{
+    if( obj->safe_ref_record == nullptr ) {
+        obj->safe_ref_record = new_record( obj );
+    }
+    rec = obj->safe_ref_record;
+}
+
+template<typename T>
+void safe_reference<T>::remove()
+{
+    resolve_redirects();
+    if( rec == nullptr ) {
+        return;
+    }
+    //Check if we're the last in-memory reference
+    if( rec->mem_count == 1 ) {
+        if( base_id( rec->id ) == ID_NONE ) {
+            //If the record doesn't have an ID it's ok to just forget it
+            if( rec->target.p != nullptr ) {
+                rec->target.p->safe_ref_record = nullptr;
+            }
+            delete_record( rec );
+        } else if( rec->json_count == 0 && id_is_destroyed( rec->id ) ) {
+            //If there are no more references and the object is destroyed, forget it
+            records_by_id.erase( base_id( rec->id ) );
+            if( rec->target.p != nullptr ) {
+                rec->target.p->safe_ref_record = nullptr;
+            }
+            delete_record( rec );
+        } else {
+            //We need to keep this record around, just set its mem count to 0
+            rec->mem_count--;
+        }
+    } else {
+        //If we're not just decrease the count
+        rec->mem_count--;
+    }
+}
+
+template<typename T>
+void safe_reference<T>::merge( T *primary, T *secondary )
+{
+    record *sec_rec = secondary->safe_ref_record;
+
+    // The secondary doesn't have a record (i.e. there are no references
+    // to it to redirect) so there's nothing to do
+    if( sec_rec == nullptr ) {
+        return;
+    }
+    // Objects never point to a redirected record, references taken to the
+    // secondary from now on get a record of their own
+    secondary->safe_ref_record = nullptr;
+
+    record *pri_rec = primary->safe_ref_record;
+
+    //The primary doesn't have a record but the secondary does
+    if( pri_rec == nullptr ) {
+        //change the secondary's record to point to the primary now
+        sec_rec->target.p = primary;
+        primary->safe_ref_record = sec_rec;
+        return;
+    }
+
+    // They both have a record
+    // Neither of these records should be a redirect as this would imply
+    // that a secondary wasn't destroyed after being merged
+
+    //If the secondary doesn't have an ID
+    if( sec_rec->id == ID_NONE ) {
+        sec_rec->id = REDIRECTED_MASK;
+        sec_rec->target.redirect = pri_rec;
+        pri_rec->mem_count++;
+    } else {
+        //This is the worse case, we actually need a redirect
+        sec_rec->id = sec_rec->id | REDIRECTED_MASK;
+        sec_rec->target.redirect = pri_rec;
+        pri_rec->mem_count++;
+    }
 }
 
 template<typename T>
@@ -182,45 +260,49 @@ void safe_reference<T>::register_load( T *obj, id_type id )
     }
     rbi_it search = records_by_id.find( id );
     if( search != records_by_id.end() ) {
+        T *previous = search->second->target.p;
+        if( previous != nullptr && previous != obj && previous->safe_ref_record == search->second ) {
+            previous->safe_ref_record = nullptr;
+        }
         search->second->target.p = obj;
+        if( obj->safe_ref_record == nullptr ) {
+            obj->safe_ref_record = search->second;
+        }
     } else {
-        record *rec = new record( obj, id );
+        record *rec = new_record( obj, id );
         records_by_id.insert( {id, rec} );
-        records_by_pointer.insert( {obj, rec} );
+        obj->safe_ref_record = rec;
     }
 }
 
 template<typename T>
 typename safe_reference<T>::id_type safe_reference<T>::lookup_id( const T *obj )
 {
-    rbp_it search = records_by_pointer.find( obj );
-    if( search != records_by_pointer.end() ) {
-        if( search->second->id == ID_NONE ) {
-            search->second->id = generate_new_id();
-        }
-        return search->second->id;
+    record *rec = obj->safe_ref_record;
+    if( rec == nullptr ) {
+        return ID_NONE;
+    }
+    if( rec->id == ID_NONE ) {
+        rec->id = generate_new_id();
     }
-    return ID_NONE;
+    return rec->id;
 }
 
 template<typename T>
 void safe_reference<T>::mark_destroyed( T *obj )
 {
-    rbp_it search = records_by_pointer.find( obj );
-    if( search == records_by_pointer.end() ) {
-        return;
+    if( obj->safe_ref_record != nullptr ) {
+        obj->safe_ref_record->id |= DESTROYED_MASK;
     }
-    search->second->id |= DESTROYED_MASK;
 }
 
 template<typename T>
 void safe_reference<T>::mark_deallocated( T *obj )
 {
-    rbp_it search = records_by_pointer.find( obj );
-    if( search == records_by_pointer.end() ) {
-        return;
+    if( obj->safe_ref_record != nullptr ) {
+        obj->safe_ref_record->target.p = nullptr;
+        obj->safe_ref_record = nullptr;
     }
-    records_by_pointer.erase( search );
 }
 
 template<typename T>
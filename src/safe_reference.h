@@ -21,12 +21,15 @@
  * destroyed. It's important to check these things separately. In the case that the redirect ID bit
  * is set the pointer instead points to another record.
  *
- * Two in-memory global (really per GO type) unordered_maps are used to manage this. One that
- * contains object pointers -> record pointers and one that contains ids -> record pointers. There
- * are also two global json structures created when saving. These store the json counts of IDs and a
- * table of ID redirects. Both of these are cleaned when the json count for an ID hits 0. Objects
- * are not given a record until a safe reference to them is first created. These records can exist
- * in both, either or neither of the global lists during their life. IDs are not added to a record
+ * An object finds its record through a pointer stored in the object itself, see game_object, so
+ * taking a reference to it doesn't need a lookup. That pointer never points to a redirected record
+ * and is cleared when the record is deleted, the record's pointer is cleared in turn when the object
+ * is deallocated. A global (really per GO type) unordered_map contains ids -> record pointers. All
+ * records are also linked into a list, which is only walked by cleanup. There are also two global
+ * json structures created when saving. These store the json counts of IDs and a table of ID
+ * redirects. Both of these are cleaned when the json count for an ID hits 0. Objects are not given
+ * a record until a safe reference to them is first created. These records can be known by their
+ * object, the id map, both or neither during their life. IDs are not added to a record
  * until either the object itself or one of its references is saved. IDs only exist in records, not
  * in the objects themselves. Records are typically cleaned up when the counts indicate we can do
  * so, however we never forget an ID once one has been assigned and will keep that record loaded for
@@ -50,6 +53,7 @@
 #include <memory>
 #include <algorithm>
 #include <unordered_map>
+#include <utility>
 
 #include "debug.h"
 
@@ -61,6 +65,7 @@ class JsonOut;
 
 template<typename T> class cata_arena;
 template<typename T> class cache_reference;
+template<typename T> class game_object;
 
 void reset_save_ids( uint32_t prefix, bool quitting );
 
@@ -79,11 +84,10 @@ class safe_reference
         friend T;
         friend game;
         friend cata_arena<T>;
+        friend game_object<T>;
 
     protected:
-        using rbp_type = std::unordered_map<const T *, record *>;
         using rbi_type = std::unordered_map<id_type, record *>;
-        using rbp_it = typename rbp_type::iterator;
         using rbi_it = typename rbi_type::iterator;
 
         constexpr static id_type ID_NONE = 0;
@@ -107,29 +111,47 @@ class safe_reference
             id_type id;
             uint32_t mem_count;
             uint32_t json_count;
+            // Neighbours in the list of all records
+            record *prev = nullptr;
+            record *next = nullptr;
         };
         mutable record *rec;
 
-        inline static rbp_type records_by_pointer;
         inline static rbi_type records_by_id;
+        inline static record *first_record = nullptr;
         inline static uint32_t next_id = 1;
 
-        void fill( T *obj ) {
-            rbp_it search = records_by_pointer.find( obj );
-            if( search != records_by_pointer.end() ) {
-                rec = search->second;
+        template<typename... Args>
+        static record *new_record( Args &&... args ) {
+            record *ret = new record( std::forward<Args>( args )... );
+            ret->next = first_record;
+            if( first_record != nullptr ) {
+                first_record->prev = ret;
+            }
+            first_record = ret;
+            return ret;
+        }
+
+        static void delete_record( record *old_rec ) {
+            if( old_rec->prev != nullptr ) {
+                old_rec->prev->next = old_rec->next;
             } else {
-                rec = new record( obj );
-                records_by_pointer.insert( {obj, rec} );
+                first_record = old_rec->next;
             }
+            if( old_rec->next != nullptr ) {
+                old_rec->next->prev = old_rec->prev;
+            }
+            delete old_rec;
         }
+
+        void fill( T *obj );
         void fill( id_type id ) {
             rbi_it search = records_by_id.find( id );
             if( search != records_by_id.end() ) {
                 rec = search->second;
             } else {
                 //This is indicative of save scumming
-                rec = new record( id );
+                rec = new_record( id );
                 records_by_id.insert( {id, rec} );
             }
         }
@@ -151,7 +173,7 @@ class safe_reference
                 if( rec->mem_count == 1 && rec->json_count == 0 ) {
                     record *old_rec = rec;
                     rec = rec->target.redirect;
-                    delete old_rec;
+                    delete_record( old_rec );
                 } else {
                     rec->mem_count--;
                     rec = rec->target.redirect;
@@ -160,33 +182,7 @@ class safe_reference
             }
         }
 
-        void remove() {
-            resolve_redirects();
-            if( rec == nullptr ) {
-                return;
-            }
-            //Check if we're the last in-memory reference
-            if( rec->mem_count == 1 ) {
-                if( base_id( rec->id ) == ID_NONE ) {
-                    //If the record doesn't have an ID it's ok to just forget it
-                    records_by_pointer.erase( rec->target.p );
-                    delete rec;
-                } else if( rec->json_count == 0 && id_is_destroyed( rec->id ) ) {
-                    //If there are no more references and the object is destroyed, forget it
-                    records_by_id.erase( rec->id );
-                    if( rec->target.p != nullptr ) {
-                        records_by_pointer.erase( rec->target.p );
-                    }
-                    delete rec;
-                } else {
-                    //We need to keep this record around, just set its mem count to 0
-                    rec->mem_count--;
-                }
-            } else {
-                //If we're not just decrease the count
-                rec->mem_count--;
-            }
-        }
+        void remove();
 
         static void register_load( T *obj, id_type id );
 
@@ -338,46 +334,7 @@ class safe_reference
          * references to the secondary will now point to the primary.
          * Typically you'll want to destroy the secondary shortly afterwards.
          */
-        static void merge( T *primary, T *secondary ) {
-
-            rbp_it sec_search = records_by_pointer.find( secondary );
-
-            // The secondary doesn't have a record (i.e. there are no references
-            // to it to redirect) so there's nothing to do
-            if( sec_search == records_by_pointer.end() ) {
-                return;
-            }
-
-            rbp_it pri_search = records_by_pointer.find( primary );
-
-            //The primary doesn't have a record but the secondary does
-            if( pri_search == records_by_pointer.end() ) {
-                //change the secondary's record to point to the primary now
-                record *rec = sec_search->second;
-                rec->target.p = primary;
-                records_by_pointer.erase( secondary );
-                records_by_pointer.insert( {primary, rec} );
-                return;
-            }
-
-            // They both have a record
-            // Neither of these records should be a redirect as this would imply
-            // that a secondary wasn't destroyed after being merged
-            record *pri_rec = pri_search->second;
-            record *sec_rec = sec_search->second;
-
-            //If the secondary doesn't have an ID
-            if( sec_rec->id == ID_NONE ) {
-                sec_rec->id = REDIRECTED_MASK;
-                sec_rec->target.redirect = pri_rec;
-                pri_rec->mem_count++;
-            } else {
-                //This is the worse case, we actually need a redirect
-                sec_rec->id = sec_rec->id | REDIRECTED_MASK;
-                sec_rec->target.redirect = pri_rec;
-                pri_rec->mem_count++;
-            }
-        }
+        static void merge( T *primary, T *secondary );
 
 };
 
@@ -429,6 +386,9 @@ class cache_reference
     public:
 
         static void mark_destroyed( T *obj ) {
+            if( reference_map.empty() ) {
+                return;
+            }
             ref_map_it search = reference_map.find( obj );
             if( search == reference_map.end() ) {
                 return;
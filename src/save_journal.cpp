@@ -0,0 +1,181 @@
+#include "save_journal.h"
+
+#include <cstdint>
+#include <exception>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "binary_io.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "string_formatter.h"
+
+// Journal files start with this magic and version, the commit marker follows the entries.
+static constexpr char journal_magic[4] = { 'C', 'B', 'S', 'J' };
+static constexpr char commit_magic[4] = { 'D', 'O', 'N', 'E' };
+// Version 1 had no removals
+static constexpr std::uint32_t journal_version = 2;
+
+static std::string journal_dir( const std::string &journal_path )
+{
+    const size_t split = journal_path.find_last_of( '/' );
+    return split == std::string::npos ? std::string( "." ) : journal_path.substr( 0, split );
+}
+
+namespace
+{
+
+// FNV-1a over everything in the transaction
+class journal_checksum
+{
+    public:
+        void add( const std::string &value ) {
+            for( const char c : value ) {
+                hash ^= static_cast<unsigned char>( c );
+                hash *= 1099511628211ULL;
+            }
+        }
+        std::uint64_t value() const {
+            return hash;
+        }
+
+    private:
+        std::uint64_t hash = 14695981039346656037ULL;
+};
+
+} // namespace
+
+void save_journal::write_file_synced( const std::string &path, const std::string &data )
+{
+    // Use the same temp file + rename scheme as all other saving,
+    // so a crash mid-write never leaves a truncated file behind.
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout.write( data.data(), data.size() );
+    } );
+#if !defined(_WIN32)
+    const int fd = ::open( path.c_str(), O_RDONLY );
+    if( fd >= 0 ) {
+        ::fsync( fd );
+        ::close( fd );
+    }
+#endif
+}
+
+void save_journal::apply( const std::vector<entry> &entries )
+{
+    for( const entry &e : entries ) {
+        if( !e.remove ) {
+            write_file_synced( e.path, e.data );
+        } else if( file_exist( e.path ) && !remove_file( e.path ) ) {
+            throw std::runtime_error( string_format( "could not remove %s", e.path ) );
+        }
+    }
+}
+
+void save_journal::commit( const std::string &journal_path, const std::vector<entry> &entries )
+{
+    const std::string prefix = journal_dir( journal_path ) + "/";
+    std::ostringstream buffer;
+    binary_out out( buffer );
+    journal_checksum sum;
+    out.write_raw( journal_magic, sizeof( journal_magic ) );
+    out.write( journal_version );
+    out.write<std::uint32_t>( entries.size() );
+    for( const entry &e : entries ) {
+        if( e.path.compare( 0, prefix.size(), prefix ) != 0 ) {
+            throw std::runtime_error( string_format( "%s is outside of the journal directory", e.path ) );
+        }
+        const std::string relative_path = e.path.substr( prefix.size() );
+        out.write( relative_path );
+        out.write<std::uint8_t>( e.remove );
+        out.write( e.data );
+        sum.add( relative_path );
+        sum.add( e.remove ? "r" : "w" );
+        sum.add( e.data );
+    }
+    out.write_raw( commit_magic, sizeof( commit_magic ) );
+    out.write<std::uint32_t>( entries.size() );
+    out.write<std::uint64_t>( sum.value() );
+    write_file_synced( journal_path, buffer.str() );
+}
+
+void save_journal::checkpoint( const std::string &journal_path, const std::vector<entry> &entries )
+{
+    apply( entries );
+    remove_file( journal_path );
+}
+
+bool save_journal::recover( const std::string &journal_path )
+{
+    if( !file_exist( journal_path ) ) {
+        return false;
+    }
+    std::vector<entry> entries;
+    bool committed = false;
+    try {
+        std::istringstream buffer( read_entire_file( journal_path ) );
+        binary_in in( buffer );
+        char magic[sizeof( journal_magic )];
+        in.read_raw( magic, sizeof( magic ) );
+        if( std::string( magic, sizeof( magic ) ) !=
+            std::string( journal_magic, sizeof( journal_magic ) ) ) {
+            throw binary_error( "not a save journal" );
+        }
+        const std::uint32_t version = in.read<std::uint32_t>();
+        if( version < 1 || version > journal_version ) {
+            throw binary_error( string_format( "unknown save journal version %d", version ) );
+        }
+        journal_checksum sum;
+        const std::uint32_t count = in.read<std::uint32_t>();
+        for( std::uint32_t i = 0; i < count; ++i ) {
+            entry e;
+            e.path = in.read_string();
+            sum.add( e.path );
+            if( version >= 2 ) {
+                e.remove = in.read<std::uint8_t>() != 0;
+                sum.add( e.remove ? "r" : "w" );
+            }
+            e.data = in.read_string();
+            sum.add( e.data );
+            entries.push_back( std::move( e ) );
+        }
+        char marker[sizeof( commit_magic )];
+        in.read_raw( marker, sizeof( marker ) );
+        committed = std::string( marker, sizeof( marker ) ) ==
+                    std::string( commit_magic, sizeof( commit_magic ) ) &&
+                    in.read<std::uint32_t>() == count &&
+                    in.read<std::uint64_t>() == sum.value();
+    } catch( const binary_error &err ) {
+        DebugLog( DL::Warn, DC::Main ) << "Incomplete save journal " << journal_path << ": " << err.what();
+    }
+
+    if( !committed ) {
+        // The crash happened before the commit, none of the files were touched yet
+        DebugLog( DL::Warn, DC::Main ) << "Discarding uncommitted save journal " << journal_path;
+        remove_file( journal_path );
+        return false;
+    }
+
+    const std::string prefix = journal_dir( journal_path ) + "/";
+    for( entry &e : entries ) {
+        e.path = prefix + e.path;
+    }
+    DebugLog( DL::Info, DC::Main ) << "Restoring " << entries.size() << " files from save journal " <<
+                                   journal_path;
+    try {
+        checkpoint( journal_path, entries );
+    } catch( const std::exception &err ) {
+        // The journal stays around, so the next load tries again
+        debugmsg( "Failed to restore files from the save journal: %s", err.what() );
+        return false;
+    }
+    return true;
+}
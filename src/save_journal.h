@@ -0,0 +1,49 @@
+#pragma once
+#ifndef CATA_SRC_SAVE_JOURNAL_H
+#define CATA_SRC_SAVE_JOURNAL_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Write-ahead journal that makes a set of save files change together.
+ *
+ * A transaction is appended to the journal as one sequential write ending in a commit
+ * marker. Only once that is on disk are the save files themselves replaced (the checkpoint),
+ * after which the journal is removed. If the game dies in between, @ref recover replays the
+ * committed files on the next load. A transaction without a valid commit marker is discarded,
+ * which leaves the previous save untouched.
+ *
+ * All files of a transaction must be stored below the directory of the journal,
+ * they are recorded relative to it.
+ */
+namespace save_journal
+{
+
+struct entry {
+    std::string path;
+    std::string data;
+    // Remove the file instead of writing data to it
+    bool remove = false;
+};
+
+/** Write @p data to @p path and flush it to the disk before returning. Throws on failure. */
+void write_file_synced( const std::string &path, const std::string &data );
+/** Write or remove the files of @p entries in order, without a journal. Throws on failure. */
+void apply( const std::vector<entry> &entries );
+
+/** Durably record @p entries in the journal at @p journal_path. Throws on failure. */
+void commit( const std::string &journal_path, const std::vector<entry> &entries );
+/** Write the committed @p entries to their files and drop the journal. Throws on failure. */
+void checkpoint( const std::string &journal_path, const std::vector<entry> &entries );
+
+/**
+ * Finish a transaction interrupted after its commit, or discard one interrupted before it.
+ * Must be called before any of the journaled files are read.
+ * @return Whether files were restored from the journal.
+ */
+bool recover( const std::string &journal_path );
+
+} // namespace save_journal
+
+#endif // CATA_SRC_SAVE_JOURNAL_H
@@ -37,6 +37,7 @@
 #include "popup.h"
 #include "regional_settings.h"
 #include "scent_map.h"
+#include "simulation_area.h"
 #include "stats_tracker.h"
 #include "string_id.h"
 #include "translations.h"
@@ -232,7 +233,7 @@ void game::unserialize( std::istream &fin )
 
         coming_to_stairs.clear();
         for( auto elem : data.get_array( "stair_monsters" ) ) {
-            shared_ptr_fast<monster> stairtmp = make_shared_fast<monster>();
+            shared_ptr_fast<monster> stairtmp = make_shared_pooled<monster>();
             elem.read( *stairtmp );
             coming_to_stairs.push_back( stairtmp );
         }
@@ -411,181 +412,188 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        layer[z].ter_set( point( i, j ), tmp_otid );
                     }
                 }
                 jsin.end_array();
             }
             jsin.end_array();
             migrate_oter_ids( oter_id_migrations );
-        } else if( name == "region_id" ) {
-            std::string new_region_id;
-            jsin.read( new_region_id );
-            if( settings->id != new_region_id ) {
-                t_regional_settings_map_citr rit = region_settings_map.find( new_region_id );
-                if( rit != region_settings_map.end() ) {
-                    // TODO: optimize
-                    settings = &rit->second;
-                }
+        } else {
+            unserialize_side_table( jsin, name );
+        }
+    }
+}
+
+void overmap::unserialize_side_table( JsonIn &jsin, const std::string &name )
+{
+    if( name == "region_id" ) {
+        std::string new_region_id;
+        jsin.read( new_region_id );
+        if( settings->id != new_region_id ) {
+            t_regional_settings_map_citr rit = region_settings_map.find( new_region_id );
+            if( rit != region_settings_map.end() ) {
+                // TODO: optimize
+                settings = &rit->second;
             }
-        } else if( name == "mongroups" ) {
-            load_legacy_monstergroups( jsin );
-        } else if( name == "monster_groups" ) {
-            load_monster_groups( jsin );
-        } else if( name == "cities" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                jsin.start_object();
-                city new_city;
-                while( !jsin.end_object() ) {
-                    std::string city_member_name = jsin.get_member_name();
-                    if( city_member_name == "name" ) {
-                        jsin.read( new_city.name );
-                    } else if( city_member_name == "x" ) {
-                        jsin.read( new_city.pos.x() );
-                    } else if( city_member_name == "y" ) {
-                        jsin.read( new_city.pos.y() );
-                    } else if( city_member_name == "size" ) {
-                        jsin.read( new_city.size );
-                    }
+        }
+    } else if( name == "mongroups" ) {
+        load_legacy_monstergroups( jsin );
+    } else if( name == "monster_groups" ) {
+        load_monster_groups( jsin );
+    } else if( name == "cities" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            city new_city;
+            while( !jsin.end_object() ) {
+                std::string city_member_name = jsin.get_member_name();
+                if( city_member_name == "name" ) {
+                    jsin.read( new_city.name );
+                } else if( city_member_name == "x" ) {
+                    jsin.read( new_city.pos.x() );
+                } else if( city_member_name == "y" ) {
+                    jsin.read( new_city.pos.y() );
+                } else if( city_member_name == "size" ) {
+                    jsin.read( new_city.size );
                 }
-                cities.push_back( new_city );
             }
-        } else if( name == "connections_out" ) {
-            jsin.read( connections_out );
-        } else if( name == "electric_grid_connections" ) {
+            cities.push_back( new_city );
+        }
+    } else if( name == "connections_out" ) {
+        jsin.read( connections_out );
+    } else if( name == "electric_grid_connections" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
             jsin.start_array();
+            tripoint_om_omt origin;
+            jsin.read( origin );
+            auto &conn = electric_grid_connections[origin];
             while( !jsin.end_array() ) {
-                jsin.start_array();
-                tripoint_om_omt origin;
-                jsin.read( origin );
-                auto &conn = electric_grid_connections[origin];
-                while( !jsin.end_array() ) {
-                    tripoint offset;
-                    jsin.read( offset );
-                    for( size_t i = 0; i < conn.size(); i++ ) {
-                        if( offset == six_cardinal_directions[i] ) {
-                            conn.set( i, true );
-                            break;
-                        }
+                tripoint offset;
+                jsin.read( offset );
+                for( size_t i = 0; i < conn.size(); i++ ) {
+                    if( offset == six_cardinal_directions[i] ) {
+                        conn.set( i, true );
+                        break;
                     }
                 }
             }
-        } else if( name == "radios" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                jsin.start_object();
-                radio_tower new_radio{ point_om_sm( point_min ) };
-                while( !jsin.end_object() ) {
-                    const std::string radio_member_name = jsin.get_member_name();
-                    if( radio_member_name == "type" ) {
-                        const std::string radio_name = jsin.get_string();
-                        const auto mapping =
-                            find_if( radio_type_names.begin(), radio_type_names.end(),
-                        [radio_name]( const std::pair<radio_type, std::string> &p ) {
-                            return p.second == radio_name;
-                        } );
-                        if( mapping != radio_type_names.end() ) {
-                            new_radio.type = mapping->first;
-                        }
-                    } else if( radio_member_name == "x" ) {
-                        jsin.read( new_radio.pos.x() );
-                    } else if( radio_member_name == "y" ) {
-                        jsin.read( new_radio.pos.y() );
-                    } else if( radio_member_name == "strength" ) {
-                        jsin.read( new_radio.strength );
-                    } else if( radio_member_name == "message" ) {
-                        jsin.read( new_radio.message );
-                    } else if( radio_member_name == "frequency" ) {
-                        jsin.read( new_radio.frequency );
+        }
+    } else if( name == "radios" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            radio_tower new_radio{ point_om_sm( point_min ) };
+            while( !jsin.end_object() ) {
+                const std::string radio_member_name = jsin.get_member_name();
+                if( radio_member_name == "type" ) {
+                    const std::string radio_name = jsin.get_string();
+                    const auto mapping =
+                        find_if( radio_type_names.begin(), radio_type_names.end(),
+                    [radio_name]( const std::pair<radio_type, std::string> &p ) {
+                        return p.second == radio_name;
+                    } );
+                    if( mapping != radio_type_names.end() ) {
+                        new_radio.type = mapping->first;
                     }
+                } else if( radio_member_name == "x" ) {
+                    jsin.read( new_radio.pos.x() );
+                } else if( radio_member_name == "y" ) {
+                    jsin.read( new_radio.pos.y() );
+                } else if( radio_member_name == "strength" ) {
+                    jsin.read( new_radio.strength );
+                } else if( radio_member_name == "message" ) {
+                    jsin.read( new_radio.message );
+                } else if( radio_member_name == "frequency" ) {
+                    jsin.read( new_radio.frequency );
                 }
-                radios.push_back( new_radio );
             }
-        } else if( name == "monster_map" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                tripoint_om_sm monster_location;
-                monster new_monster;
-                monster_location.deserialize( jsin );
-                new_monster.deserialize( jsin );
-                monster_map->insert( std::make_pair( monster_location, std::move( new_monster ) ) );
-            }
-        } else if( name == "tracked_vehicles" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                jsin.start_object();
-                om_vehicle new_tracker;
-                int id;
-                while( !jsin.end_object() ) {
-                    std::string tracker_member_name = jsin.get_member_name();
-                    if( tracker_member_name == "id" ) {
-                        jsin.read( id );
-                    } else if( tracker_member_name == "x" ) {
-                        jsin.read( new_tracker.p.x() );
-                    } else if( tracker_member_name == "y" ) {
-                        jsin.read( new_tracker.p.y() );
-                    } else if( tracker_member_name == "name" ) {
-                        jsin.read( new_tracker.name );
-                    }
+            radios.push_back( new_radio );
+        }
+    } else if( name == "monster_map" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            tripoint_om_sm monster_location;
+            monster new_monster;
+            monster_location.deserialize( jsin );
+            new_monster.deserialize( jsin );
+            monster_map->insert( std::make_pair( monster_location, std::move( new_monster ) ) );
+        }
+    } else if( name == "tracked_vehicles" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            om_vehicle new_tracker;
+            int id;
+            while( !jsin.end_object() ) {
+                std::string tracker_member_name = jsin.get_member_name();
+                if( tracker_member_name == "id" ) {
+                    jsin.read( id );
+                } else if( tracker_member_name == "x" ) {
+                    jsin.read( new_tracker.p.x() );
+                } else if( tracker_member_name == "y" ) {
+                    jsin.read( new_tracker.p.y() );
+                } else if( tracker_member_name == "name" ) {
+                    jsin.read( new_tracker.name );
                 }
-                vehicles[id] = new_tracker;
             }
-        } else if( name == "scent_traces" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                jsin.start_object();
-                tripoint_abs_omt pos;
-                time_point time = calendar::before_time_starts;
-                int strength = 0;
-                while( !jsin.end_object() ) {
-                    std::string scent_member_name = jsin.get_member_name();
-                    if( scent_member_name == "pos" ) {
-                        jsin.read( pos );
-                    } else if( scent_member_name == "time" ) {
-                        jsin.read( time );
-                    } else if( scent_member_name == "strength" ) {
-                        jsin.read( strength );
-                    }
+            vehicles[id] = new_tracker;
+        }
+    } else if( name == "scent_traces" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            tripoint_abs_omt pos;
+            time_point time = calendar::before_time_starts;
+            int strength = 0;
+            while( !jsin.end_object() ) {
+                std::string scent_member_name = jsin.get_member_name();
+                if( scent_member_name == "pos" ) {
+                    jsin.read( pos );
+                } else if( scent_member_name == "time" ) {
+                    jsin.read( time );
+                } else if( scent_member_name == "strength" ) {
+                    jsin.read( strength );
                 }
-                scents[pos] = scent_trace( time, strength );
             }
-        } else if( name == "npcs" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
-                new_npc->deserialize( jsin );
-                if( !new_npc->get_fac_id().str().empty() ) {
-                    new_npc->set_fac( new_npc->get_fac_id() );
-                }
-                npcs.push_back( new_npc );
+            scents[pos] = scent_trace( time, strength );
+        }
+    } else if( name == "npcs" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
+            new_npc->deserialize( jsin );
+            if( !new_npc->get_fac_id().str().empty() ) {
+                new_npc->set_fac( new_npc->get_fac_id() );
             }
-        } else if( name == "overmap_special_placements" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                jsin.start_object();
-                overmap_special_id s;
-                while( !jsin.end_object() ) {
-                    std::string name = jsin.get_member_name();
-                    if( name == "special" ) {
-                        jsin.read( s );
-                    } else if( name == "placements" ) {
-                        jsin.start_array();
-                        while( !jsin.end_array() ) {
-                            jsin.start_object();
-                            while( !jsin.end_object() ) {
-                                std::string name = jsin.get_member_name();
-                                if( name == "points" ) {
-                                    jsin.start_array();
-                                    while( !jsin.end_array() ) {
-                                        jsin.start_object();
-                                        tripoint_om_omt p;
-                                        while( !jsin.end_object() ) {
-                                            std::string name = jsin.get_member_name();
-                                            if( name == "p" ) {
-                                                jsin.read( p );
-                                                overmap_special_placements[p] = s;
-                                            }
+            npcs.push_back( new_npc );
+        }
+    } else if( name == "overmap_special_placements" ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_object();
+            overmap_special_id s;
+            while( !jsin.end_object() ) {
+                std::string name = jsin.get_member_name();
+                if( name == "special" ) {
+                    jsin.read( s );
+                } else if( name == "placements" ) {
+                    jsin.start_array();
+                    while( !jsin.end_array() ) {
+                        jsin.start_object();
+                        while( !jsin.end_object() ) {
+                            std::string name = jsin.get_member_name();
+                            if( name == "points" ) {
+                                jsin.start_array();
+                                while( !jsin.end_array() ) {
+                                    jsin.start_object();
+                                    tripoint_om_omt p;
+                                    while( !jsin.end_object() ) {
+                                        std::string name = jsin.get_member_name();
+                                        if( name == "p" ) {
+                                            jsin.read( p );
+                                            overmap_special_placements[p] = s;
                                         }
                                     }
                                 }
@@ -594,23 +602,23 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
                     }
                 }
             }
-        } else if( name == "joins_used" ) {
-            std::vector<std::pair<om_pos_dir, std::string>> flat_index;
-            jsin.read( flat_index, true );
-            for( const std::pair<om_pos_dir, std::string> &p : flat_index ) {
-                joins_used.insert( p );
-            }
-        } else if( name == "mapgen_arg_storage" ) {
-            jsin.read( mapgen_arg_storage, true );
-        } else if( name == "mapgen_arg_index" ) {
-            std::vector<std::pair<tripoint_om_omt, int>> flat_index;
-            jsin.read( flat_index, true );
-            for( const std::pair<tripoint_om_omt, int> &p : flat_index ) {
-                mapgen_args_index.emplace( p.first, p.second );
-            }
-        } else {
-            jsin.skip_value();
         }
+    } else if( name == "joins_used" ) {
+        std::vector<std::pair<om_pos_dir, std::string>> flat_index;
+        jsin.read( flat_index, true );
+        for( const std::pair<om_pos_dir, std::string> &p : flat_index ) {
+            joins_used.insert( p );
+        }
+    } else if( name == "mapgen_arg_storage" ) {
+        jsin.read( mapgen_arg_storage, true );
+    } else if( name == "mapgen_arg_index" ) {
+        std::vector<std::pair<tripoint_om_omt, int>> flat_index;
+        jsin.read( flat_index, true );
+        for( const std::pair<tripoint_om_omt, int> &p : flat_index ) {
+            mapgen_args_index.emplace( p.first, p.second );
+        }
+    } else {
+        jsin.skip_value();
     }
 }
 
@@ -838,7 +846,6 @@ struct mongroup_hash {
 
 void overmap::save_monster_groups( JsonOut &jout ) const
 {
-    jout.member( "monster_groups" );
     jout.start_array();
     // Bin groups by their fields, except positions and monsters
     std::unordered_map<mongroup, std::list<tripoint_om_sm>, mongroup_hash, mongroup_bin_eq>
@@ -875,14 +882,15 @@ void overmap::serialize( std::ostream &fout ) const
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        auto &layer_terrain = layer[z].terrain;
+        ensure_layer_loaded( z - OVERMAP_DEPTH );
+        const map_layer &this_layer = layer[z];
         int count = 0;
         oter_id last_tertype( -1 );
         json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
             // NOLINTNEXTLINE(modernize-loop-convert)
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
+                oter_id t = this_layer.ter( point( i, j ) );
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
@@ -907,152 +915,175 @@ void overmap::serialize( std::ostream &fout ) const
     }
     json.end_array();
 
-    // temporary, to allow user to manually switch regions during play until regionmap is done.
-    json.member( "region_id", settings->id );
-    fout << '\n';
-
-    save_monster_groups( json );
-    fout << '\n';
-
-    json.member( "cities" );
-    json.start_array();
-    for( auto &i : cities ) {
-        json.start_object();
-        json.member( "name", i.name );
-        json.member( "x", i.pos.x() );
-        json.member( "y", i.pos.y() );
-        json.member( "size", i.size );
-        json.end_object();
+    for( const side_table_writer &table : side_table_writers() ) {
+        json.member( table.first );
+        table.second( json );
+        // Insert a newline occasionally so the file isn't totally unreadable.
+        fout << '\n';
     }
-    json.end_array();
-    fout << '\n';
 
-    json.member( "connections_out", connections_out );
+    json.end_object();
     fout << '\n';
+}
 
-    json.member( "radios" );
-    json.start_array();
-    for( auto &i : radios ) {
-        json.start_object();
-        json.member( "x", i.pos.x() );
-        json.member( "y", i.pos.y() );
-        json.member( "strength", i.strength );
-        json.member( "type", radio_type_names[i.type] );
-        json.member( "message", i.message );
-        json.member( "frequency", i.frequency );
-        json.end_object();
-    }
-    json.end_array();
-    fout << '\n';
+std::vector<overmap::side_table_writer> overmap::side_table_writers() const
+{
+    std::vector<side_table_writer> tables;
 
-    json.member( "monster_map" );
-    json.start_array();
-    for( auto &i : *monster_map ) {
-        i.first.serialize( json );
-        i.second.serialize( json );
-    }
-    json.end_array();
-    fout << '\n';
+    // temporary, to allow user to manually switch regions during play until regionmap is done.
+    tables.emplace_back( "region_id", [this]( JsonOut & json ) {
+        json.write( settings->id );
+    } );
 
-    json.member( "tracked_vehicles" );
-    json.start_array();
-    for( const auto &i : vehicles ) {
-        json.start_object();
-        json.member( "id", i.first );
-        json.member( "name", i.second.name );
-        json.member( "x", i.second.p.x() );
-        json.member( "y", i.second.p.y() );
-        json.end_object();
-    }
-    json.end_array();
-    fout << '\n';
+    tables.emplace_back( "monster_groups", [this]( JsonOut & json ) {
+        save_monster_groups( json );
+    } );
 
-    json.member( "scent_traces" );
-    json.start_array();
-    for( const auto &scent : scents ) {
-        json.start_object();
-        json.member( "pos", scent.first );
-        json.member( "time", scent.second.creation_time );
-        json.member( "strength", scent.second.initial_strength );
-        json.end_object();
-    }
-    json.end_array();
-    fout << '\n';
+    tables.emplace_back( "cities", [this]( JsonOut & json ) {
+        json.start_array();
+        for( auto &i : cities ) {
+            json.start_object();
+            json.member( "name", i.name );
+            json.member( "x", i.pos.x() );
+            json.member( "y", i.pos.y() );
+            json.member( "size", i.size );
+            json.end_object();
+        }
+        json.end_array();
+    } );
 
-    json.member( "npcs" );
-    json.start_array();
-    for( auto &i : npcs ) {
-        json.write( *i );
-    }
-    json.end_array();
-    fout << '\n';
+    tables.emplace_back( "connections_out", [this]( JsonOut & json ) {
+        json.write( connections_out );
+    } );
 
-    // Condense the overmap special placements so that all placements of a given special
-    // are grouped under a single key for that special.
-    std::map<overmap_special_id, std::vector<tripoint_om_omt>> condensed_overmap_special_placements;
-    for( const auto &placement : overmap_special_placements ) {
-        condensed_overmap_special_placements[placement.second].emplace_back( placement.first );
-    }
+    tables.emplace_back( "radios", [this]( JsonOut & json ) {
+        json.start_array();
+        for( auto &i : radios ) {
+            json.start_object();
+            json.member( "x", i.pos.x() );
+            json.member( "y", i.pos.y() );
+            json.member( "strength", i.strength );
+            json.member( "type", radio_type_names[i.type] );
+            json.member( "message", i.message );
+            json.member( "frequency", i.frequency );
+            json.end_object();
+        }
+        json.end_array();
+    } );
 
-    json.member( "overmap_special_placements" );
-    json.start_array();
-    for( const auto &placement : condensed_overmap_special_placements ) {
-        json.start_object();
-        json.member( "special", placement.first );
-        json.member( "placements" );
+    tables.emplace_back( "monster_map", [this]( JsonOut & json ) {
         json.start_array();
-        // When we have a discriminator for different instances of a given special,
-        // we'd use that that group them, but since that doesn't exist yet we'll
-        // dump all the points of a given special into a single entry.
-        json.start_object();
-        json.member( "points" );
+        for( auto &i : *monster_map ) {
+            i.first.serialize( json );
+            i.second.serialize( json );
+        }
+        json.end_array();
+    } );
+
+    tables.emplace_back( "tracked_vehicles", [this]( JsonOut & json ) {
         json.start_array();
-        for( const tripoint_om_omt &pos : placement.second ) {
+        for( const auto &i : vehicles ) {
             json.start_object();
-            json.member( "p", pos );
+            json.member( "id", i.first );
+            json.member( "name", i.second.name );
+            json.member( "x", i.second.p.x() );
+            json.member( "y", i.second.p.y() );
             json.end_object();
         }
         json.end_array();
-        json.end_object();
+    } );
+
+    tables.emplace_back( "scent_traces", [this]( JsonOut & json ) {
+        json.start_array();
+        for( const auto &scent : scents ) {
+            json.start_object();
+            json.member( "pos", scent.first );
+            json.member( "time", scent.second.creation_time );
+            json.member( "strength", scent.second.initial_strength );
+            json.end_object();
+        }
         json.end_array();
-        json.end_object();
-    }
-    json.end_array();
-    fout << '\n';
+    } );
+
+    tables.emplace_back( "npcs", [this]( JsonOut & json ) {
+        json.start_array();
+        for( auto &i : npcs ) {
+            json.write( *i );
+        }
+        json.end_array();
+    } );
+
+    tables.emplace_back( "overmap_special_placements", [this]( JsonOut & json ) {
+        // Condense the overmap special placements so that all placements of a given special
+        // are grouped under a single key for that special.
+        std::map<overmap_special_id, std::vector<tripoint_om_omt>> condensed_overmap_special_placements;
+        for( const auto &placement : overmap_special_placements ) {
+            condensed_overmap_special_placements[placement.second].emplace_back( placement.first );
+        }
 
-    json.member( "electric_grid_connections" );
-    json.start_array();
-    for( const auto &conn : electric_grid_connections ) {
         json.start_array();
-        json.write( conn.first );
-        for( size_t i = 0; i < six_cardinal_directions.size(); i++ ) {
-            if( conn.second[i] ) {
-                json.write( six_cardinal_directions[i] );
+        for( const auto &placement : condensed_overmap_special_placements ) {
+            json.start_object();
+            json.member( "special", placement.first );
+            json.member( "placements" );
+            json.start_array();
+            // When we have a discriminator for different instances of a given special,
+            // we'd use that that group them, but since that doesn't exist yet we'll
+            // dump all the points of a given special into a single entry.
+            json.start_object();
+            json.member( "points" );
+            json.start_array();
+            for( const tripoint_om_omt &pos : placement.second ) {
+                json.start_object();
+                json.member( "p", pos );
+                json.end_object();
             }
+            json.end_array();
+            json.end_object();
+            json.end_array();
+            json.end_object();
         }
         json.end_array();
+    } );
 
-    }
-    json.end_array();
+    tables.emplace_back( "electric_grid_connections", [this]( JsonOut & json ) {
+        json.start_array();
+        for( const auto &conn : electric_grid_connections ) {
+            json.start_array();
+            json.write( conn.first );
+            for( size_t i = 0; i < six_cardinal_directions.size(); i++ ) {
+                if( conn.second[i] ) {
+                    json.write( six_cardinal_directions[i] );
+                }
+            }
+            json.end_array();
 
-    std::vector<std::pair<om_pos_dir, std::string>> flattened_joins_used(
-                joins_used.begin(), joins_used.end() );
-    json.member( "joins_used", flattened_joins_used );
-    json.member( "mapgen_arg_storage", mapgen_arg_storage );
-    fout << '\n';
-    json.member( "mapgen_arg_index" );
-    json.start_array();
-    for( const std::pair<const tripoint_om_omt, int> &p : mapgen_args_index ) {
+        }
+        json.end_array();
+    } );
+
+    tables.emplace_back( "joins_used", [this]( JsonOut & json ) {
+        std::vector<std::pair<om_pos_dir, std::string>> flattened_joins_used(
+                    joins_used.begin(), joins_used.end() );
+        json.write( flattened_joins_used );
+    } );
+
+    tables.emplace_back( "mapgen_arg_storage", [this]( JsonOut & json ) {
+        json.write( mapgen_arg_storage );
+    } );
+
+    tables.emplace_back( "mapgen_arg_index", [this]( JsonOut & json ) {
         json.start_array();
-        json.write( p.first );
-        json.write( p.second );
+        for( const std::pair<const tripoint_om_omt, int> &p : mapgen_args_index ) {
+            json.start_array();
+            json.write( p.first );
+            json.write( p.second );
+            json.end_array();
+        }
         json.end_array();
-    }
-    json.end_array();
-    fout << '\n';
+    } );
 
-    json.end_object();
-    fout << '\n';
+    return tables;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1167,6 +1198,8 @@ void game::unserialize_master( std::istream &fin )
                 jsin.read( *faction_manager_ptr );
             } else if( name == "seed" ) {
                 jsin.read( seed );
+            } else if( name == "simulation_areas" ) {
+                jsin.read( *simulation_areas_ptr );
             } else if( name == "weather" ) {
                 JsonObject w = jsin.get_object();
                 w.read( "lightning", get_weather().lightning_active );
@@ -1204,6 +1237,7 @@ void game::serialize_master( std::ostream &fout )
 
         json.member( "factions", *faction_manager_ptr );
         json.member( "seed", seed );
+        json.member( "simulation_areas", *simulation_areas_ptr );
 
         json.member( "weather" );
         json.start_object();
@@ -1269,7 +1303,7 @@ void Creature_tracker::deserialize( JsonIn &jsin )
     jsin.start_array();
     while( !jsin.end_array() ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
-        shared_ptr_fast<monster> mptr = make_shared_fast<monster>();
+        shared_ptr_fast<monster> mptr = make_shared_pooled<monster>();
         jsin.read( *mptr );
         add( mptr );
     }
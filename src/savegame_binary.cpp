@@ -0,0 +1,484 @@
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "binary_io.h"
+#include "calendar.h"
+#include "debug.h"
+#include "field_type.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "json.h"
+#include "mapdata.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace
+{
+
+/**
+ * Tags of the records making up a binary submap.
+ * Every record is stored as tag, 32-bit payload length and payload, so readers can
+ * skip records they don't know about. Never renumber existing tags.
+ */
+enum class submap_record : std::uint8_t {
+    end = 0,
+    terrain = 1,
+    furniture = 2,
+    traps = 3,
+    radiation = 4,
+    fields = 5,
+    // Everything without a dedicated encoding, as a JSON object (see submap::store_entities)
+    json = 6,
+};
+
+/**
+ * Maps string ids to small local indices. int_ids are not stable between game
+ * sessions (they depend on the loaded mods), so the string ids are stored once per
+ * record and the tile data refers to them by index.
+ */
+class id_palette
+{
+    public:
+        std::uint16_t index_of( const std::string &id ) {
+            const auto iter = index.find( id );
+            if( iter != index.end() ) {
+                return iter->second;
+            }
+            const std::uint16_t result = ids.size();
+            ids.push_back( id );
+            index.emplace( id, result );
+            return result;
+        }
+
+        void write( binary_out &out ) const {
+            out.write<std::uint16_t>( ids.size() );
+            for( const std::string &id : ids ) {
+                out.write( id );
+            }
+        }
+
+    private:
+        std::vector<std::string> ids;
+        std::unordered_map<std::string, std::uint16_t> index;
+};
+
+std::vector<std::string> read_palette( binary_in &in )
+{
+    std::vector<std::string> result( in.read<std::uint16_t>() );
+    for( std::string &id : result ) {
+        id = in.read_string();
+    }
+    return result;
+}
+
+/**
+ * Writes a palette followed by (index, run length) pairs covering the whole submap
+ * (or any other area up to 65535 tiles), row by row (same order as the JSON terrain RLE).
+ */
+template<typename Func>
+void write_id_runs( binary_out &out, Func get_id, point size = point( SEEX, SEEY ) )
+{
+    id_palette palette;
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> runs;
+    for( int j = 0; j < size.y; j++ ) {
+        for( int i = 0; i < size.x; i++ ) {
+            const std::uint16_t idx = palette.index_of( get_id( point( i, j ) ) );
+            if( !runs.empty() && runs.back().first == idx ) {
+                runs.back().second++;
+            } else {
+                runs.emplace_back( idx, 1 );
+            }
+        }
+    }
+    palette.write( out );
+    out.write<std::uint16_t>( runs.size() );
+    for( const auto &run : runs ) {
+        out.write( run.first );
+        out.write( run.second );
+    }
+}
+
+template<typename StrId, typename Func>
+void read_id_runs( binary_in &in, Func set_id )
+{
+    const std::vector<std::string> palette = read_palette( in );
+    std::vector<decltype( StrId().id() )> resolved;
+    resolved.reserve( palette.size() );
+    for( const std::string &id : palette ) {
+        resolved.push_back( StrId( id ).id() );
+    }
+    const std::uint16_t num_runs = in.read<std::uint16_t>();
+    int cell = 0;
+    for( std::uint16_t r = 0; r < num_runs; ++r ) {
+        const std::uint16_t idx = in.read<std::uint16_t>();
+        const std::uint16_t length = in.read<std::uint16_t>();
+        if( idx >= resolved.size() || cell + length > SEEX * SEEY ) {
+            throw binary_error( "corrupt id run in binary submap" );
+        }
+        for( std::uint16_t n = 0; n < length; ++n, ++cell ) {
+            set_id( point( cell % SEEX, cell / SEEX ), resolved[idx] );
+        }
+    }
+    if( cell != SEEX * SEEY ) {
+        throw binary_error( "binary submap id runs do not cover the submap" );
+    }
+}
+
+void write_record( binary_out &out, submap_record tag, const std::string &payload )
+{
+    out.write( static_cast<std::uint8_t>( tag ) );
+    out.write<std::uint32_t>( payload.size() );
+    out.write_raw( payload.data(), payload.size() );
+}
+
+template<typename Func>
+void write_record( binary_out &out, submap_record tag, Func writer )
+{
+    std::ostringstream buffer;
+    binary_out record( buffer );
+    writer( record );
+    write_record( out, tag, buffer.str() );
+}
+
+} // namespace
+
+void submap::store_binary( binary_out &out ) const
+{
+    out.write<std::int32_t>( to_turn<int>( last_touched ) );
+    out.write<std::int32_t>( temperature );
+
+    write_record( out, submap_record::terrain, [&]( binary_out & rec ) {
+        write_id_runs( rec, [&]( point p ) {
+            return get_ter( p ).id().str();
+        } );
+    } );
+    write_record( out, submap_record::furniture, [&]( binary_out & rec ) {
+        write_id_runs( rec, [&]( point p ) {
+            return get_furn( p ).id().str();
+        } );
+    } );
+    write_record( out, submap_record::traps, [&]( binary_out & rec ) {
+        write_id_runs( rec, [&]( point p ) {
+            return get_trap( p ).id().str();
+        } );
+    } );
+
+    write_record( out, submap_record::radiation, [&]( binary_out & rec ) {
+        std::vector<std::pair<std::int32_t, std::uint16_t>> runs;
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                const int r = rad[i][j];
+                if( !runs.empty() && runs.back().first == r ) {
+                    runs.back().second++;
+                } else {
+                    runs.emplace_back( r, 1 );
+                }
+            }
+        }
+        rec.write<std::uint16_t>( runs.size() );
+        for( const auto &run : runs ) {
+            rec.write( run.first );
+            rec.write( run.second );
+        }
+    } );
+
+    if( field_count > 0 ) {
+        write_record( out, submap_record::fields, [&]( binary_out & rec ) {
+            id_palette palette;
+            std::ostringstream entries_buffer;
+            binary_out entries( entries_buffer );
+            std::uint32_t num_entries = 0;
+            for( int j = 0; j < SEEY; j++ ) {
+                for( int i = 0; i < SEEX; i++ ) {
+                    for( const auto &elem : fld[i][j] ) {
+                        const field_entry &cur = elem.second;
+                        entries.write<std::uint8_t>( i );
+                        entries.write<std::uint8_t>( j );
+                        entries.write( palette.index_of( cur.get_field_type().id().str() ) );
+                        entries.write<std::int32_t>( cur.get_field_intensity() );
+                        entries.write<std::int32_t>( to_turns<int>( cur.get_field_age() ) );
+                        num_entries++;
+                    }
+                }
+            }
+            palette.write( rec );
+            rec.write( num_entries );
+            const std::string data = entries_buffer.str();
+            rec.write_raw( data.data(), data.size() );
+        } );
+    }
+
+    write_record( out, submap_record::json, serialize_wrapper( [&]( JsonOut & jsout ) {
+        jsout.start_object();
+        store_entities( jsout );
+        jsout.end_object();
+    } ) );
+
+    out.write( static_cast<std::uint8_t>( submap_record::end ) );
+}
+
+void submap::load_binary( binary_in &in, int version, const tripoint offset )
+{
+    last_touched = time_point::from_turn( in.read<std::int32_t>() );
+    temperature = in.read<std::int32_t>();
+
+    while( true ) {
+        const submap_record tag = static_cast<submap_record>( in.read<std::uint8_t>() );
+        if( tag == submap_record::end ) {
+            break;
+        }
+        const std::uint32_t length = in.read<std::uint32_t>();
+        switch( tag ) {
+            case submap_record::terrain:
+                read_id_runs<ter_str_id>( in, [&]( point p, const ter_id & id ) {
+                    ter[p.x][p.y] = id;
+                } );
+                break;
+            case submap_record::furniture:
+                read_id_runs<furn_str_id>( in, [&]( point p, const furn_id & id ) {
+                    frn[p.x][p.y] = id;
+                } );
+                break;
+            case submap_record::traps:
+                read_id_runs<trap_str_id>( in, [&]( point p, const trap_id & id ) {
+                    trp[p.x][p.y] = id;
+                } );
+                break;
+            case submap_record::radiation: {
+                const std::uint16_t num_runs = in.read<std::uint16_t>();
+                int cell = 0;
+                for( std::uint16_t r = 0; r < num_runs; ++r ) {
+                    const std::int32_t strength = in.read<std::int32_t>();
+                    const std::uint16_t run = in.read<std::uint16_t>();
+                    for( std::uint16_t n = 0; n < run && cell < SEEX * SEEY; ++n, ++cell ) {
+                        rad[cell % SEEX][cell / SEEX] = strength;
+                    }
+                }
+                break;
+            }
+            case submap_record::fields: {
+                const std::vector<std::string> palette = read_palette( in );
+                std::vector<field_type_id> resolved;
+                resolved.reserve( palette.size() );
+                for( const std::string &id : palette ) {
+                    resolved.push_back( field_type_str_id( id ).id() );
+                }
+                const std::uint32_t num_entries = in.read<std::uint32_t>();
+                for( std::uint32_t n = 0; n < num_entries; ++n ) {
+                    const int i = in.read<std::uint8_t>();
+                    const int j = in.read<std::uint8_t>();
+                    const std::uint16_t idx = in.read<std::uint16_t>();
+                    const int intensity = in.read<std::int32_t>();
+                    const int age = in.read<std::int32_t>();
+                    if( i >= SEEX || j >= SEEY || idx >= resolved.size() ) {
+                        throw binary_error( "corrupt field record in binary submap" );
+                    }
+                    const field_type_id &ft = resolved[idx];
+                    if( fld[i][j].find_field( ft ) == nullptr ) {
+                        field_count++;
+                    }
+                    fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                    mark_field_tile( { i, j } );
+                }
+                break;
+            }
+            case submap_record::json: {
+                std::string data( length, '\0' );
+                in.read_raw( data.data(), length );
+                deserialize_wrapper( [&]( JsonIn & jsin ) {
+                    jsin.start_object();
+                    while( !jsin.end_object() ) {
+                        const std::string member_name = jsin.get_member_name();
+                        load( jsin, member_name, version, offset );
+                    }
+                }, data );
+                break;
+            }
+            default:
+                debugmsg( "Unknown binary submap record %d, skipping it", static_cast<int>( tag ) );
+                in.skip( length );
+                break;
+        }
+    }
+}
+
+namespace
+{
+
+// Binary overmap files start with this magic followed by the binary format version.
+constexpr char overmap_magic[4] = { 'C', 'B', 'O', 'M' };
+constexpr std::uint32_t overmap_binary_version = 1;
+const std::string layer_block_prefix = "layer.";
+
+std::string layer_block_name( int z )
+{
+    return layer_block_prefix + std::to_string( z );
+}
+
+} // namespace
+
+/*
+ * Binary overmap layout:
+ *   magic, format version, savegame version, number of blocks
+ *   directory: name, offset from the start of the file and length of each block
+ *   blocks
+ * Each terrain layer is an id palette and runs like in binary submaps. Every other
+ * table is a block of its own holding the same JSON value as in JSON overmap files.
+ */
+void overmap::serialize_binary( std::ostream &fout ) const
+{
+    std::vector<std::pair<std::string, std::string>> blocks;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        ensure_layer_loaded( z );
+        const map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+        std::ostringstream buffer;
+        binary_out out( buffer );
+        write_id_runs( out, [&]( point p ) {
+            return this_layer.ter( p ).id().str();
+        }, point( OMAPX, OMAPY ) );
+        blocks.emplace_back( layer_block_name( z ), buffer.str() );
+    }
+    for( const side_table_writer &table : side_table_writers() ) {
+        std::ostringstream buffer;
+        JsonOut json( buffer );
+        table.second( json );
+        blocks.emplace_back( table.first, buffer.str() );
+    }
+
+    binary_out out( fout );
+    out.write_raw( overmap_magic, sizeof( overmap_magic ) );
+    out.write( overmap_binary_version );
+    out.write<std::int32_t>( savegame_version );
+    out.write<std::uint32_t>( blocks.size() );
+    std::uint64_t offset = sizeof( overmap_magic ) + 4 + 4 + 4;
+    for( const auto &block : blocks ) {
+        offset += 4 + block.first.size() + 8 + 4;
+    }
+    for( const auto &block : blocks ) {
+        out.write( block.first );
+        out.write( offset );
+        out.write<std::uint32_t>( block.second.size() );
+        offset += block.second.size();
+    }
+    for( const auto &block : blocks ) {
+        out.write_raw( block.second.data(), block.second.size() );
+    }
+}
+
+void overmap::unserialize_binary( std::istream &fin, const std::string &file_path )
+{
+    binary_in in( fin );
+    char magic[sizeof( overmap_magic )];
+    in.read_raw( magic, sizeof( magic ) );
+    if( !std::equal( std::begin( magic ), std::end( magic ), std::begin( overmap_magic ) ) ) {
+        throw binary_error( "not a binary overmap file" );
+    }
+    const std::uint32_t format_version = in.read<std::uint32_t>();
+    if( format_version > overmap_binary_version ) {
+        throw binary_error( string_format( "binary overmap format %d is newer than supported %d",
+                                           format_version, overmap_binary_version ) );
+    }
+    savegame_loading_version = in.read<std::int32_t>();
+
+    struct block {
+        std::string name;
+        std::uint64_t offset;
+        std::uint32_t length;
+    };
+    std::vector<block> blocks( in.read<std::uint32_t>() );
+    for( block &b : blocks ) {
+        b.name = in.read_string();
+        b.offset = in.read<std::uint64_t>();
+        b.length = in.read<std::uint32_t>();
+    }
+
+    for( const block &b : blocks ) {
+        if( b.name.starts_with( layer_block_prefix ) ) {
+            const int z = std::stoi( b.name.substr( layer_block_prefix.size() ) );
+            if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+                continue;
+            }
+            if( z == 0 ) {
+                fin.seekg( b.offset );
+                read_layer_terrain( in, z );
+            } else {
+                // Most code only ever looks at the surface, other layers are read on first access
+                unloaded_layers[z + OVERMAP_DEPTH] = unloaded_layer{ file_path, b.offset, b.length };
+            }
+            continue;
+        }
+        fin.seekg( b.offset );
+        std::string data( b.length, '\0' );
+        in.read_raw( data.data(), data.size() );
+        std::istringstream table( data );
+        JsonIn jsin( table, file_path );
+        unserialize_side_table( jsin, b.name );
+    }
+}
+
+void overmap::load_layer( int z )
+{
+    const unloaded_layer source = *unloaded_layers[z + OVERMAP_DEPTH];
+    // Reset first, migrating obsolete ids calls back into ter_set
+    unloaded_layers[z + OVERMAP_DEPTH].reset();
+    read_from_file( source.path, [&]( std::istream & fin ) {
+        fin.seekg( source.offset );
+        binary_in in( fin );
+        read_layer_terrain( in, z );
+    } );
+}
+
+void overmap::read_layer_terrain( binary_in &in, int z )
+{
+    static const oter_str_id oter_omt_obsolete( "omt_obsolete" );
+
+    const std::vector<std::string> palette = read_palette( in );
+    std::vector<oter_id> resolved;
+    std::vector<bool> obsolete;
+    resolved.reserve( palette.size() );
+    for( const std::string &id : palette ) {
+        obsolete.push_back( is_oter_id_obsolete( id ) );
+        if( obsolete.back() ) {
+            resolved.emplace_back( oter_omt_obsolete );
+        } else if( oter_str_id( id ).is_valid() ) {
+            resolved.emplace_back( id );
+        } else {
+            debugmsg( "Loaded invalid oter_id '%s'", id );
+            resolved.emplace_back( oter_omt_obsolete );
+        }
+    }
+
+    map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+    std::unordered_map<tripoint_om_omt, std::string> oter_id_migrations;
+    const std::uint16_t num_runs = in.read<std::uint16_t>();
+    int cell = 0;
+    for( std::uint16_t r = 0; r < num_runs; ++r ) {
+        const std::uint16_t idx = in.read<std::uint16_t>();
+        const std::uint16_t length = in.read<std::uint16_t>();
+        if( idx >= resolved.size() || cell + length > OMAPX * OMAPY ) {
+            throw binary_error( "corrupt terrain run in binary overmap" );
+        }
+        if( r == 0 ) {
+            // Uniform layers never allocate per tile storage
+            this_layer.fill_terrain( resolved[idx] );
+        }
+        for( std::uint16_t n = 0; n < length; ++n, ++cell ) {
+            const point p( cell % OMAPX, cell / OMAPX );
+            this_layer.ter_set( p, resolved[idx] );
+            if( obsolete[idx] ) {
+                oter_id_migrations.emplace( tripoint_om_omt( p.x, p.y, z ), palette[idx] );
+            }
+        }
+    }
+    if( cell != OMAPX * OMAPY ) {
+        throw binary_error( "binary overmap terrain runs do not cover the layer" );
+    }
+    migrate_oter_ids( oter_id_migrations );
+}
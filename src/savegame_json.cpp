@@ -11,6 +11,7 @@
 #include <climits>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -523,14 +524,16 @@ void Character::load( const JsonObject &data )
     for( auto it = my_mutations.begin(); it != my_mutations.end(); ) {
         const trait_id &mid = it->first;
         if( mid.is_valid() ) {
-            on_mutation_gain( mid );
-            cached_mutations.push_back( &mid.obj() );
             ++it;
         } else {
             debugmsg( "character %s has invalid mutation %s, it will be ignored", name, mid.c_str() );
             it = my_mutations.erase( it );
         }
     }
+    rebuild_mutation_cache();
+    for( const std::pair<const trait_id, char_trait_data> &mut : my_mutations ) {
+        on_mutation_gain( mut.first );
+    }
     recalculate_size();
 
     data.read( "my_bionics", *my_bionics );
@@ -3107,6 +3110,7 @@ void Creature::load( const JsonObject &jsin )
     for( auto &it : body ) {
         it.second.set_location( new wield_item_location( this ) );
     }
+    index_body();
 
     fake = false; // see Creature::load
 
@@ -3199,21 +3203,20 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout,
+                           const std::unordered_map<tile_index, int> &palette ) const
 {
     jsout.start_array();
 
-    // Uses RLE for compression.
+    // Uses RLE for compression, uniform submaps are a single run.
 
-    mm_elem last;
+    std::pair<tile_index, int> last;
     int num_same = 1;
 
     const auto write_seq = [&]() {
         jsout.start_array();
-        jsout.write( last.tile.tile );
-        jsout.write( last.tile.subtile );
-        jsout.write( last.tile.rotation );
-        jsout.write( last.symbol );
+        jsout.write( palette.at( last.first ) );
+        jsout.write( last.second );
         if( num_same != 1 ) {
             jsout.write( num_same );
         }
@@ -3223,7 +3226,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     for( size_t y = 0; y < SEEY; y++ ) {
         for( size_t x = 0; x < SEEX; x++ ) {
             point p( x, y );
-            const mm_elem elem = { tile( p ), symbol( p ) };
+            const std::pair<tile_index, int> elem( tile_index_at( p ), symbol( p ) );
             if( x == 0 && y == 0 ) {
                 last = elem;
                 continue;
@@ -3242,7 +3245,41 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( JsonIn &jsin )
+void mm_submap::deserialize( JsonIn &jsin, const std::vector<tile_index> &palette )
+{
+    jsin.start_array();
+
+    tile_index tile = 0;
+    int sym = default_symbol;
+    size_t remaining = 0;
+
+    for( size_t y = 0; y < SEEY; y++ ) {
+        for( size_t x = 0; x < SEEX; x++ ) {
+            if( remaining > 0 ) {
+                remaining -= 1;
+            } else {
+                jsin.start_array();
+                const int idx = jsin.get_int();
+                if( idx < 0 || static_cast<size_t>( idx ) >= palette.size() ) {
+                    jsin.error( "memorized tile index out of range" );
+                }
+                tile = palette[idx];
+                sym = jsin.get_int();
+                if( jsin.test_int() ) {
+                    remaining = jsin.get_int() - 1;
+                }
+                jsin.end_array();
+            }
+            point p( x, y );
+            set_tile_index( p, tile );
+            set_symbol( p, sym );
+        }
+    }
+    jsin.end_array();
+    shrink();
+}
+
+void mm_submap::deserialize_legacy( JsonIn &jsin )
 {
     jsin.start_array();
 
@@ -3267,20 +3304,46 @@ void mm_submap::deserialize( JsonIn &jsin )
                 jsin.end_array();
             }
             point p( x, y );
-            // Try to avoid assigning to save up on memory
-            if( elem.tile != mm_submap::default_tile ) {
-                set_tile( p, elem.tile );
-            }
-            if( elem.symbol != mm_submap::default_symbol ) {
-                set_symbol( p, elem.symbol );
-            }
+            set_tile( p, elem.tile );
+            set_symbol( p, elem.symbol );
         }
     }
     jsin.end_array();
+    shrink();
 }
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Tile ids are written once per region, runs refer to them by index
+    std::unordered_map<mm_submap::tile_index, int> palette;
+    std::vector<mm_submap::tile_index> palette_order;
+    for( const auto &column : submaps ) {
+        for( const shared_ptr_fast<mm_submap> &sm : column ) {
+            for( size_t y = 0; y < SEEY; y++ ) {
+                for( size_t x = 0; x < SEEX; x++ ) {
+                    const mm_submap::tile_index idx = sm->tile_index_at( point( x, y ) );
+                    if( palette.emplace( idx, palette_order.size() ).second ) {
+                        palette_order.push_back( idx );
+                    }
+                }
+            }
+        }
+    }
+
+    jsout.start_object();
+    jsout.member( "palette" );
+    jsout.start_array();
+    for( const mm_submap::tile_index idx : palette_order ) {
+        const memorized_terrain_tile &tile = mm_submap::lookup_tile( idx );
+        jsout.start_array();
+        jsout.write( tile.tile );
+        jsout.write( tile.subtile );
+        jsout.write( tile.rotation );
+        jsout.end_array();
+    }
+    jsout.end_array();
+
+    jsout.member( "submaps" );
     jsout.start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -3290,30 +3353,74 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, palette );
             }
         }
     }
     jsout.end_array();
+    jsout.end_object();
 }
 
 void mm_region::deserialize( JsonIn &jsin )
 {
-    jsin.start_array();
-    // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
-    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
-        // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
-        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
-            shared_ptr_fast<mm_submap> &sm = submaps[x][y];
+    for( auto &column : submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
             sm = make_shared_fast<mm_submap>();
-            if( jsin.test_null() ) {
-                jsin.skip_null();
-            } else {
-                sm->deserialize( jsin );
+        }
+    }
+
+    const auto read_submaps = [&]( const std::function<void( mm_submap & )> &reader ) {
+        jsin.start_array();
+        // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
+            for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+                if( jsin.test_null() ) {
+                    jsin.skip_null();
+                } else {
+                    reader( *submaps[x][y] );
+                }
+            }
+        }
+        jsin.end_array();
+    };
+
+    if( jsin.test_array() ) {
+        // Regions saved before palettes were introduced
+        read_submaps( [&]( mm_submap & sm ) {
+            sm.deserialize_legacy( jsin );
+        } );
+        return;
+    }
+
+    std::vector<mm_submap::tile_index> palette;
+    bool has_palette = false;
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string name = jsin.get_member_name();
+        if( name == "palette" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                memorized_terrain_tile tile;
+                jsin.start_array();
+                tile.tile = jsin.get_string();
+                tile.subtile = jsin.get_int();
+                tile.rotation = jsin.get_int();
+                jsin.end_array();
+                palette.push_back( mm_submap::intern_tile( tile ) );
             }
+            has_palette = true;
+        } else if( name == "submaps" ) {
+            if( !has_palette ) {
+                jsin.error( "palette must come before submaps" );
+            }
+            read_submaps( [&]( mm_submap & sm ) {
+                sm.deserialize( jsin, palette );
+            } );
+        } else {
+            jsin.skip_value();
         }
     }
-    jsin.end_array();
 }
 
 void map_memory::load_legacy( JsonIn &jsin )
@@ -3593,6 +3700,7 @@ void event_multiset::deserialize( JsonIn &jsin )
     std::vector<std::pair<cata::event::data_type, int>> copy;
     jo.read( "event_counts", copy );
     counts_ = { copy.begin(), copy.end() };
+    summaries_.clear();
 }
 
 void stats_tracker::serialize( JsonOut &jsout ) const
@@ -3704,20 +3812,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3757,6 +3851,66 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_entities( jsout );
+}
+
+// Writes the items, with runs of identical ones, like a pile of the same ammo boxes,
+// written once as [ length, item ]
+static void write_item_runs( JsonOut &jsout, const location_vector<item> &items )
+{
+    std::string run_json;
+    int run_length = 0;
+    const auto write_run = [&]() {
+        if( run_length == 0 ) {
+            return;
+        }
+        if( run_length > 1 ) {
+            jsout.start_array();
+            jsout.write( run_length );
+        }
+        if( jsout.get_need_separator() ) {
+            jsout.write_separator();
+        }
+        *jsout.get_stream() << run_json;
+        jsout.set_need_separator();
+        if( run_length > 1 ) {
+            jsout.end_array();
+        }
+    };
+
+    jsout.start_array();
+    for( const item * const &it : items ) {
+        std::ostringstream buffer;
+        JsonOut item_json( buffer );
+        item_json.write( *it );
+        if( run_length > 0 && buffer.str() == run_json ) {
+            run_length++;
+            continue;
+        }
+        write_run();
+        run_json = buffer.str();
+        run_length = 1;
+    }
+    write_run();
+    jsout.end_array();
+}
+
+void submap::store_entities( JsonOut &jsout ) const
+{
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            write_item_runs( jsout, itm[i][j] );
+        }
+    }
+    jsout.end_array();
+
     // Write out as array of arrays of single entries
     jsout.member( "cosmetics" );
     jsout.start_array();
@@ -3903,20 +4057,32 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             const point p( i, j );
             jsin.start_array();
             while( !jsin.end_array() ) {
+                // Identical items are saved once with the length of their run
+                int run_length = 1;
+                const bool run = jsin.test_array();
+                if( run ) {
+                    jsin.start_array();
+                    run_length = jsin.get_int();
+                }
                 detached_ptr<item> tmp;
                 jsin.read( tmp );
-
-                if( tmp->is_emissive() ) {
-                    update_lum_add( p, *tmp );
+                if( run ) {
+                    jsin.end_array();
                 }
 
                 if( savegame_loading_version >= 27 && version < 27 ) {
                     tmp->legacy_fast_forward_time();
                 }
-                item &obj = *tmp;
-                itm[p.x][p.y].push_back( std::move( tmp ) );
-                if( obj.needs_processing() ) {
-                    active_items.add( obj );
+                for( int n = 0; n < run_length; n++ ) {
+                    detached_ptr<item> copy = n + 1 < run_length ? item::spawn( *tmp ) : std::move( tmp );
+                    if( copy->is_emissive() ) {
+                        update_lum_add( p, *copy );
+                    }
+                    item &obj = *copy;
+                    itm[p.x][p.y].push_back( std::move( copy ) );
+                    if( obj.needs_processing() ) {
+                        active_items.add( obj );
+                    }
                 }
             }
         }
@@ -3968,6 +4134,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                     field_count++;
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                mark_field_tile( { i, j } );
             }
         }
     } else if( member_name == "graffiti" ) {
@@ -158,73 +158,85 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    //the block and reduce scent properties are folded into a single scent_transfer value here
-    //block=0 reduce=1 normal=5
-    scent_array<char> scent_transfer;
-
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
-
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
-                center.z ).vehicle_obstructed_cache;
-
     // for loop constants
     const int scentmap_minx = center.x - SCENT_RADIUS;
     const int scentmap_maxx = center.x + SCENT_RADIUS;
     const int scentmap_miny = center.y - SCENT_RADIUS;
     const int scentmap_maxy = center.y + SCENT_RADIUS;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    // Squares with no scent on them or next to them stay at zero, so only the box around
+    // the scent needs updating
+    point active_min( scentmap_maxx + 2, scentmap_maxy + 2 );
+    point active_max( scentmap_minx - 2, scentmap_miny - 2 );
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny - 1; y <= scentmap_maxy + 1; ++y ) {
+            if( grscent[x][y] != 0 ) {
+                active_min.x = std::min( active_min.x, x );
+                active_min.y = std::min( active_min.y, y );
+                active_max.x = std::max( active_max.x, x );
+                active_max.y = std::max( active_max.y, y );
+            }
+        }
     }
+    const int minx = std::max( scentmap_minx, active_min.x - 1 );
+    const int maxx = std::min( scentmap_maxx, active_max.x + 1 );
+    const int miny = std::max( scentmap_miny, active_min.y - 1 );
+    const int maxy = std::min( scentmap_maxy, active_max.y + 1 );
+    if( minx > maxx || miny > maxy ) {
+        return;
+    }
+    const int width = maxx - minx + 1;
+    const int height = maxy - miny + 1;
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+    //the block and reduce scent properties are folded into a single scent_transfer value here
+    //block=0 reduce=1 normal=5
+    scent_array<char> scent_transfer;
+
+    // Indexed [x][y] like grscent, so the inner loops run over contiguous memory
+    std::array < std::array < int, 1 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 1 + SCENT_RADIUS * 2 >, 3 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < int, 1 + SCENT_RADIUS * 2 >, 3 + SCENT_RADIUS * 2 > squares_used_y;
 
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
 
+    // The new scent flag searching function. Should be wayyy faster than the old one.
+    m.scent_blockers( scent_transfer, point( minx - 1, miny - 1 ), point( maxx + 1, maxy + 1 ) );
+
+    for( int x = 0; x < width + 2; ++x ) {
+        const int abs_x = x + minx - 1;
+        const std::array<char, MAPSIZE_Y> &transfer = scent_transfer[abs_x];
+        const std::array<int, MAPSIZE_Y> &scent = grscent[abs_x];
+        for( int y = 0; y < height; ++y ) {
+            const int abs_y = y + miny;
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+            sum_3_scent_y[x][y] = transfer[abs_y - 1] * scent[abs_y - 1] + transfer[abs_y] * scent[abs_y] +
+                                  transfer[abs_y + 1] * scent[abs_y + 1];
+            squares_used_y[x][y] = transfer[abs_y - 1] + transfer[abs_y] + transfer[abs_y + 1];
         }
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+    // Squares across a diagonal vehicle wall from each other don't share scent,
+    // undo what the sums above took from there
+    const auto hole = [&]( bool blocked, point p ) {
+        return blocked && scent_transfer[p.x][p.y] == 5 ? 4 : 0;
+    };
+
+    for( int x = 1; x < width + 1; ++x ) {
+        for( int y = 0; y < height; ++y ) {
+            const point abs( x + minx - 1, y + miny );
 
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+            int squares_used = squares_used_y[x - 1][y] + squares_used_y[x][y] + squares_used_y[x + 1][y];
+            int total = sum_3_scent_y[x - 1][y] + sum_3_scent_y[x][y] + sum_3_scent_y[x + 1][y];
 
             //handle vehicle holes
-            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
-            }
-            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
-            }
+            const int hole_se = hole( blocked_cache[abs.x][abs.y].nw, abs + point_south_east );
+            const int hole_sw = hole( blocked_cache[abs.x][abs.y].ne, abs + point_south_west );
+            const int hole_nw = hole( blocked_cache[abs.x - 1][abs.y - 1].nw, abs + point_north_west );
+            const int hole_ne = hole( blocked_cache[abs.x + 1][abs.y - 1].ne, abs + point_north_east );
+            squares_used -= hole_se + hole_sw + hole_nw + hole_ne;
+            total -= hole_se * grscent[abs.x + 1][abs.y + 1] + hole_sw * grscent[abs.x - 1][abs.y + 1] +
+                     hole_nw * grscent[abs.x - 1][abs.y - 1] + hole_ne * grscent[abs.x + 1][abs.y - 1];
 
             //Lingering scent
             int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
@@ -232,14 +244,11 @@ void scent_map::update( const tripoint &center, map &m )
             temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
                            ( 45 - squares_used ) / 5;
 
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
+            new_scent[x - 1][y] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+    for( int x = 0; x < width; ++x ) {
+        std::copy_n( new_scent[x].begin(), height, grscent[x + minx].begin() + miny );
     }
 }
 
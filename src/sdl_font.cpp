@@ -329,21 +329,37 @@ bool CachedTTFFont::isGlyphProvided( const std::string &ch ) const
     return TTF_GlyphIsProvided( font.get(), UTF8_getch( ch ) );
 }
 
+CachedTTFFont::cached_t CachedTTFFont::make_glyph( const SDL_Renderer_Ptr &renderer,
+        const std::string &ch, const int color )
+{
+    return cached_t {
+        create_glyph( renderer, ch, color ),
+        static_cast<int>( width * utf8_wrapper( ch ).display_width() )
+    };
+}
+
 void CachedTTFFont::OutputChar( const SDL_Renderer_Ptr &renderer, const GeometryRenderer_Ptr &,
                                 const std::string &ch, point p,
                                 unsigned char color, const float opacity )
 {
-    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
-    if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry {
-            create_glyph( renderer, key.codepoints, key.color ),
-            static_cast<int>( width * utf8_wrapper( key.codepoints ).display_width() )
-        };
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
+    const unsigned char glyph_color = color & 0xf;
+    const cached_t *glyph = nullptr;
+    if( ch.size() == 1 && static_cast<unsigned char>( ch[0] ) < ascii_glyphs.size() ) {
+        std::optional<cached_t> &ascii = ascii_glyphs[static_cast<unsigned char>( ch[0] )][glyph_color];
+        if( !ascii ) {
+            ascii = make_glyph( renderer, ch, glyph_color );
+        }
+        glyph = &*ascii;
+    } else {
+        key_t key {ch, glyph_color};
+        auto it = glyph_cache_map.find( key );
+        if( it == std::end( glyph_cache_map ) ) {
+            cached_t new_entry = make_glyph( renderer, key.codepoints, key.color );
+            it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
+        }
+        glyph = &it->second;
     }
-    const cached_t &value = it->second;
+    const cached_t &value = *glyph;
 
     if( !value.texture ) {
         // Nothing we can do here )-:
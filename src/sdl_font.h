@@ -10,6 +10,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 
@@ -94,8 +95,9 @@ class CachedTTFFont : public Font
             std::string   codepoints;
             unsigned char color;
 
-            std::pair<std::string, unsigned char> as_pair() const {
-                return std::make_pair( codepoints, color );
+            // References the string instead of copying it for every hash and comparison
+            std::pair<const std::string &, unsigned char> as_pair() const {
+                return { codepoints, color };
             }
 
             friend bool operator==( const key_t &lhs, const key_t &rhs ) noexcept {
@@ -105,7 +107,7 @@ class CachedTTFFont : public Font
 
         struct key_t_hash {
             size_t operator()( const key_t &k ) const {
-                return cata::auto_hash<std::pair<std::string, unsigned char>>()( k.as_pair() );
+                return cata::tuple_hash()( k.as_pair() );
             }
         };
 
@@ -114,7 +116,11 @@ class CachedTTFFont : public Font
             int          width;
         };
 
+        cached_t make_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch, int color );
+
         std::unordered_map<key_t, cached_t, key_t_hash> glyph_cache_map;
+        // Glyphs of single ASCII characters, the bulk of any text, by character and color
+        std::array<std::array<std::optional<cached_t>, 16>, 128> ascii_glyphs;
 
         const bool fontblending;
 };
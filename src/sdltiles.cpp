@@ -56,6 +56,7 @@
 #include "npc.h"
 #include "options.h"
 #include "output.h"
+#include "overmap.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
 #include "overmap_ui.h"
@@ -67,6 +68,7 @@
 #include "sdl_geometry.h"
 #include "sdl_font.h"
 #include "sdlsound.h"
+#include "startup_timings.h"
 #include "string_formatter.h"
 #include "uistate.h"
 #include "ui_manager.h"
@@ -773,7 +775,8 @@ std::string cata_tiles::get_omt_id_rotation_and_subtile(
 
         if( !uistate.overmap_show_forest_trails &&
             is_ot_match( "forest_trail", cur_ter, ot_match_type::type ) ) {
-            return oter_id( "forest" );
+            static const oter_str_id forest( "forest" );
+            return forest.id();
         }
 
         return cur_ter;
@@ -897,7 +900,9 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
         for( int col = min_col; col < max_col; col++ ) {
             const tripoint_abs_omt omp = corner_NW + point( col, row );
 
-            const bool see = has_debug_vision || overmap_buffer.seen( omp );
+            // Looked up once for the queries below about this tile
+            const overmap_with_local_coords om_loc = overmap_buffer.get_existing_om_global( omp );
+            const bool see = has_debug_vision || ( om_loc && om_loc.om->seen( om_loc.local ) );
             const bool los = see && you.overmap_los( omp, sight_points );
             // the full string from the ter_id including _north etc.
             std::string id;
@@ -919,7 +924,8 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                 }
             }
 
-            const lit_level ll = overmap_buffer.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
+            const lit_level ll = om_loc && om_loc.om->is_explored( om_loc.local ) ? lit_level::LOW :
+                                 lit_level::LIT;
             // light level is now used for choosing between grayscale filter and normal lit tiles.
             draw_from_id_string( id, TILE_CATEGORY::C_OVERMAP_TERRAIN, "overmap_terrain", omp.raw(),
                                  subtile, rotation, ll, false, height_3d, 0 );
@@ -934,8 +940,8 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                                              omp.raw(), 0, 0, lit_level::LIT, false, 0 );
                     }
                 }
-                const int horde_size = overmap_buffer.get_horde_size( omp );
-                if( showhordes && los && horde_size >= HORDE_VISIBILITY_SIZE ) {
+                const int horde_size = showhordes && los ? overmap_buffer.get_horde_size( omp ) : 0;
+                if( horde_size >= HORDE_VISIBILITY_SIZE ) {
                     // a little bit of hardcoded fallbacks for hordes
                     if( find_tile_with_season( id ) ) {
                         draw_from_id_string( string_format( "overmap_horde_%d", horde_size ),
@@ -989,13 +995,13 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                 }
             }
 
-            if( blink && uistate.overmap_show_map_notes && overmap_buffer.has_note( omp ) ) {
+            if( blink && uistate.overmap_show_map_notes && om_loc && om_loc.om->has_note( om_loc.local ) ) {
 
                 nc_color ter_color = c_black;
                 std::string ter_sym = " ";
                 // Display notes in all situations, even when not seen
                 std::tie( ter_sym, ter_color, std::ignore ) =
-                    overmap_ui::get_note_display_info( overmap_buffer.note( omp ) );
+                    overmap_ui::get_note_display_info( om_loc.om->note( om_loc.local ) );
 
                 std::string note_name = "note_" + ter_sym + "_" + string_from_color( ter_color );
                 draw_from_id_string( note_name, TILE_CATEGORY::C_OVERMAP_NOTE, "overmap_note",
@@ -3564,14 +3570,17 @@ void catacurses::init_interface()
     // initialize sound set
     load_soundset();
 
-    font = std::make_unique<FontFallbackList>( renderer, format, fl.fontwidth, fl.fontheight,
-            windowsPalette, fl.typeface, fl.fontsize, fl.fontblending );
-    map_font = std::make_unique<FontFallbackList>( renderer, format, fl.map_fontwidth,
-               fl.map_fontheight,
-               windowsPalette, fl.map_typeface, fl.map_fontsize, fl.fontblending );
-    overmap_font = std::make_unique<FontFallbackList>( renderer, format, fl.overmap_fontwidth,
-                   fl.overmap_fontheight,
-                   windowsPalette, fl.overmap_typeface, fl.overmap_fontsize, fl.fontblending );
+    {
+        startup_timings::timer timing( "fonts", "interface" );
+        font = std::make_unique<FontFallbackList>( renderer, format, fl.fontwidth, fl.fontheight,
+                windowsPalette, fl.typeface, fl.fontsize, fl.fontblending );
+        map_font = std::make_unique<FontFallbackList>( renderer, format, fl.map_fontwidth,
+                   fl.map_fontheight,
+                   windowsPalette, fl.map_typeface, fl.map_fontsize, fl.fontblending );
+        overmap_font = std::make_unique<FontFallbackList>( renderer, format, fl.overmap_fontwidth,
+                       fl.overmap_fontheight,
+                       windowsPalette, fl.overmap_typeface, fl.overmap_fontsize, fl.fontblending );
+    }
     stdscr = newwin( get_terminal_height(), get_terminal_width(), point_zero );
     //newwin calls `new WINDOW`, and that will throw, but not return nullptr.
 
@@ -3642,7 +3651,7 @@ void input_manager::pump_events()
 
 // This is how we're actually going to handle input events, SDL getch
 // is simply a wrapper around this.
-input_event input_manager::get_input_event()
+input_event input_manager::get_device_input_event()
 {
     previously_pressed_key = 0;
 
@@ -12,7 +12,9 @@
 #include "hash_utils.h"
 #include "line.h"
 #include "omdata.h"
+#include "pathfinding_stats.h"
 #include "point.h"
+#include "profile.h"
 
 namespace pf
 {
@@ -43,6 +45,8 @@ struct point_node {
 directed_path<point> greedy_path( point source, point dest, point max,
                                   const two_node_scoring_fn<point> &scorer )
 {
+    ZoneScoped;
+    const pathfinding_stats::search_timer timer( route_scale::overmap );
     using Node = point_node;
     const auto inbounds = [ max ]( point  p ) {
         return p.x >= 0 && p.x < max.x && p.y >= 0 && p.y < max.y;
@@ -75,6 +79,7 @@ directed_path<point> greedy_path( point source, point dest, point max,
     while( !nodes[i].empty() ) {
         const Node mn( nodes[i].top() ); // get the best-looking node
         nodes[i].pop();
+        pathfinding_stats::count_expanded();
         // mark it visited
         closed[map_index( mn.pos )] = true;
         // if we've reached the end, draw the path and return
@@ -244,6 +249,8 @@ simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
         const tripoint_abs_omt &dest, const int radius, omt_scoring_fn scorer,
         std::optional<int> max_cost )
 {
+    ZoneScoped;
+    const pathfinding_stats::search_timer timer( route_scale::overmap );
     constexpr size_t max_search_count = 100000;
     simple_path<tripoint_abs_omt> ret;
     bool meet = false;
@@ -254,6 +261,7 @@ simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
     std::unordered_map<tripoint_abs_omt, navigation_node> &other_known_nodes ) {
         const tripoint_abs_omt cur_addr = open_set.top().addr;
         open_set.pop();
+        pathfinding_stats::count_expanded();
         if( other_known_nodes.find( cur_addr ) != other_known_nodes.end() ) {
             meet = true;
             tripoint_abs_omt addr = cur_addr;
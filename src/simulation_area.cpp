@@ -0,0 +1,132 @@
+#include "simulation_area.h"
+
+#include <algorithm>
+
+#include "game.h"
+#include "json.h"
+#include "map.h"
+#include "options.h"
+#include "point.h"
+
+// How often an area catches up with the time passed
+static constexpr time_duration actualize_interval = 1_hours;
+
+std::vector<tripoint_abs_sm> simulation_area::submaps() const
+{
+    std::vector<tripoint_abs_sm> ret;
+    ret.reserve( omts.size() * 4 );
+    for( const tripoint_abs_omt &omt : omts ) {
+        const tripoint_abs_sm sm = project_to<coords::sm>( omt );
+        ret.push_back( sm );
+        ret.push_back( sm + point_east );
+        ret.push_back( sm + point_south );
+        ret.push_back( sm + point_south_east );
+    }
+    return ret;
+}
+
+void simulation_area::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    jsout.member( "omts", omts );
+    jsout.member( "last_actualized", last_actualized );
+    jsout.end_object();
+}
+
+void simulation_area::deserialize( JsonIn &jsin )
+{
+    JsonObject jo = jsin.get_object();
+    jo.read( "omts", omts );
+    jo.read( "last_actualized", last_actualized );
+}
+
+bool simulation_areas::add( const std::set<tripoint_abs_omt> &omts )
+{
+    for( const tripoint_abs_omt &p : omts ) {
+        if( contains( p ) ) {
+            return true;
+        }
+    }
+    const int limit = get_option<int>( "SIMULATION_AREAS" );
+    if( omts.empty() || static_cast<int>( areas.size() ) >= limit ) {
+        return false;
+    }
+    areas.push_back( { omts, calendar::turn } );
+    covered.insert( omts.begin(), omts.end() );
+    return true;
+}
+
+void simulation_areas::remove_if( const std::function<bool( const simulation_area & )> &pred )
+{
+    areas.erase( std::remove_if( areas.begin(), areas.end(), pred ), areas.end() );
+    const int limit = std::max( get_option<int>( "SIMULATION_AREAS" ), 0 );
+    if( static_cast<int>( areas.size() ) > limit ) {
+        areas.resize( limit );
+    }
+    index_omts();
+}
+
+void simulation_areas::clear()
+{
+    areas.clear();
+    covered.clear();
+}
+
+bool simulation_areas::contains( const tripoint_abs_omt &p ) const
+{
+    return covered.contains( p );
+}
+
+bool simulation_areas::contains( const tripoint_abs_sm &p ) const
+{
+    return !covered.empty() && covered.contains( project_to<coords::omt>( p ) );
+}
+
+void simulation_areas::index_omts()
+{
+    covered.clear();
+    for( const simulation_area &area : areas ) {
+        covered.insert( area.omts.begin(), area.omts.end() );
+    }
+}
+
+void simulation_areas::update( const map &bubble )
+{
+    const tripoint abs_sub = bubble.get_abs_sub();
+    const half_open_rectangle<point_abs_sm> bubble_area( point_abs_sm( abs_sub.xy() ),
+            point_abs_sm( abs_sub.xy() ) + point( bubble.getmapsize(), bubble.getmapsize() ) );
+    const auto in_bubble = [&]( const simulation_area & area ) {
+        const std::vector<tripoint_abs_sm> sms = area.submaps();
+        return std::any_of( sms.begin(), sms.end(), [&]( const tripoint_abs_sm & sm ) {
+            return bubble_area.contains( sm.xy() );
+        } );
+    };
+    simulation_area *due = nullptr;
+    for( simulation_area &area : areas ) {
+        if( calendar::turn - area.last_actualized >= actualize_interval &&
+            ( due == nullptr || area.last_actualized < due->last_actualized ) &&
+            !in_bubble( area ) ) {
+            due = &area;
+        }
+    }
+    if( due == nullptr ) {
+        return;
+    }
+    due->last_actualized = calendar::turn;
+    // Loading the submaps actualizes them, see map::loadn
+    for( const tripoint_abs_omt &omt : due->omts ) {
+        tinymap tm;
+        tm.load( project_to<coords::sm>( omt ), false );
+    }
+}
+
+void simulation_areas::serialize( JsonOut &jsout ) const
+{
+    jsout.write( areas );
+}
+
+void simulation_areas::deserialize( JsonIn &jsin )
+{
+    jsin.read( areas );
+    index_omts();
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef CATA_SRC_SIMULATION_AREA_H
+#define CATA_SRC_SIMULATION_AREA_H
+
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "calendar.h"
+#include "coordinates.h"
+
+class JsonIn;
+class JsonOut;
+class map;
+
+/**
+ * A place away from the reality bubble that keeps being simulated, with less detail.
+ * Its submaps stay in the @ref mapbuffer, its electric grids are updated every turn like
+ * those in the bubble, see @ref distribution_grid_tracker, and the rest of what time does
+ * to it, see @ref map::actualize, is caught up with every now and then instead of all at
+ * once when the avatar comes back. Creatures, vehicles, fields and active items only move
+ * in the bubble, and nothing is seen.
+ */
+struct simulation_area {
+    std::set<tripoint_abs_omt> omts;
+    time_point last_actualized = calendar::turn_zero;
+
+    /** The submaps of all the overmap tiles. */
+    std::vector<tripoint_abs_sm> submaps() const;
+
+    void serialize( JsonOut &jsout ) const;
+    void deserialize( JsonIn &jsin );
+};
+
+/**
+ * All the @ref simulation_area of the game, as many as the SIMULATION_AREAS option allows.
+ * For now that's electric grids that do something on their own, like charging batteries
+ * from solar panels, which the @ref distribution_grid_tracker adds as they leave the bubble.
+ */
+class simulation_areas
+{
+    public:
+        /**
+         * Keep simulating @p omts. False if there's no room for another area, true if they
+         * were added or are simulated already.
+         */
+        bool add( const std::set<tripoint_abs_omt> &omts );
+        /** Remove the areas @p pred is true for, and the newest ones above the limit. */
+        void remove_if( const std::function<bool( const simulation_area & )> &pred );
+        void clear();
+
+        bool contains( const tripoint_abs_omt &p ) const;
+        bool contains( const tripoint_abs_sm &p ) const;
+        const std::vector<simulation_area> &get_all() const {
+            return areas;
+        }
+
+        /**
+         * Catch up with the time passed in the area that waited the longest, if it's due.
+         * One area a turn at most, so the cost is spread over many turns. Areas that are
+         * partly in @p bubble wait until they're out of it.
+         */
+        void update( const map &bubble );
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( JsonIn &jsin );
+
+    private:
+        void index_omts();
+
+        std::vector<simulation_area> areas;
+        // Overmap tiles of all the areas, for the lookups of the mapbuffer
+        std::set<tripoint_abs_omt> covered;
+};
+
+simulation_areas &get_simulation_areas();
+
+#endif // CATA_SRC_SIMULATION_AREA_H
@@ -0,0 +1,107 @@
+#pragma once
+#ifndef CATA_SRC_SLAB_ALLOCATOR_H
+#define CATA_SRC_SLAB_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "profile.h"
+
+/**
+ * Allocator that hands out single objects from large blocks, reusing freed ones first.
+ *
+ * Objects allocated one after another end up next to each other in memory, so loops over
+ * many of them touch fewer cache lines and pages. Requests for more than one object go to
+ * std::allocator. Not thread safe, and the blocks are never given back.
+ */
+template<typename T>
+class slab_allocator
+{
+    public:
+        using value_type = T;
+
+        /** Objects that fit in each block. */
+        static constexpr std::size_t slab_size = 64;
+
+        slab_allocator() = default;
+        template<typename U>
+        slab_allocator( const slab_allocator<U> & ) {} // NOLINT(google-explicit-constructor)
+
+        T *allocate( std::size_t n ) {
+            if( n != 1 ) {
+                return std::allocator<T>().allocate( n );
+            }
+            pool &p = get_pool();
+            if( p.free == nullptr ) {
+                p.slabs.emplace_back( std::make_unique<slot[]>( slab_size ) );
+                slot *slab = p.slabs.back().get();
+                for( std::size_t i = slab_size; i > 0; i-- ) {
+                    slab[i - 1].next = p.free;
+                    p.free = &slab[i - 1];
+                }
+            }
+            slot *s = p.free;
+            p.free = s->next;
+            p.live++;
+            p.allocations++;
+            TracyAllocN( s->storage, sizeof( T ), "slab_allocator" );
+            return reinterpret_cast<T *>( s->storage );
+        }
+
+        void deallocate( T *ptr, std::size_t n ) {
+            if( n != 1 ) {
+                std::allocator<T>().deallocate( ptr, n );
+                return;
+            }
+            TracyFreeN( ptr, "slab_allocator" );
+            pool &p = get_pool();
+            slot *s = reinterpret_cast<slot *>( ptr );
+            s->next = p.free;
+            p.free = s;
+            p.live--;
+        }
+
+        /** Number of blocks taken for objects of this type so far. */
+        static std::size_t slab_count() {
+            return get_pool().slabs.size();
+        }
+        /** Number of single objects currently allocated. */
+        static std::size_t live_count() {
+            return get_pool().live;
+        }
+        /** Number of single objects allocated so far, freed ones included. */
+        static std::size_t allocation_count() {
+            return get_pool().allocations;
+        }
+
+        template<typename U>
+        bool operator==( const slab_allocator<U> & ) const {
+            return true;
+        }
+        template<typename U>
+        bool operator!=( const slab_allocator<U> & ) const {
+            return false;
+        }
+
+    private:
+        union slot {
+            slot *next;
+            alignas( T ) unsigned char storage[sizeof( T )];
+        };
+
+        struct pool {
+            std::vector<std::unique_ptr<slot[]>> slabs;
+            slot *free = nullptr;
+            std::size_t live = 0;
+            std::size_t allocations = 0;
+        };
+
+        static pool &get_pool() {
+            // Leaked on purpose: objects in static storage may be freed after it would be destroyed
+            static pool *p = new pool();
+            return *p;
+        }
+};
+
+#endif // CATA_SRC_SLAB_ALLOCATOR_H
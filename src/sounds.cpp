@@ -11,6 +11,7 @@
 #include <system_error>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "avatar.h"
 #include "bodypart.h"
@@ -363,12 +364,25 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Only those closer than twice the volume can, so look them up by area,
+        // unless the sound carries further than the map reaches anyway.
+        if( vol <= 0 ) {
+            continue;
+        }
+        std::vector<monster *> listeners;
+        if( vol * 2 > MAPSIZE_X ) {
+            for( monster &critter : g->all_monsters() ) {
+                listeners.push_back( &critter );
+            }
+        } else {
+            listeners = g->get_monsters_in_radius( source, vol * 2 - 1 );
+        }
+        for( monster *critter : listeners ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = sound_distance( source, critter->pos() );
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+                critter->hear_sound( source, vol, dist );
             }
         }
     }
@@ -0,0 +1,141 @@
+#include "startup_timings.h"
+
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "debug.h"
+#include "fstream_utils.h"
+#include "string_formatter.h"
+
+namespace startup_timings
+{
+
+namespace
+{
+
+struct totals {
+    std::string phase;
+    std::string name;
+    std::uint64_t count = 0;
+    std::uint64_t microseconds = 0;
+};
+
+struct recording {
+    bool enabled = false;
+    std::string path;
+    // In the order they were first timed
+    std::vector<totals> all_totals;
+    std::map<std::pair<std::string, std::string>, size_t> index;
+};
+
+recording &get_recording()
+{
+    static recording rec;
+    return rec;
+}
+
+const totals *find_totals( const std::string &phase, const std::string &name )
+{
+    const recording &rec = get_recording();
+    const auto iter = rec.index.find( std::make_pair( phase, name ) );
+    return iter == rec.index.end() ? nullptr : &rec.all_totals[iter->second];
+}
+
+} // namespace
+
+void enable( const std::string &path )
+{
+    recording &rec = get_recording();
+    if( !rec.enabled ) {
+        // The recording was created above, so it is still alive when this runs at exit
+        std::atexit( write );
+    }
+    rec.enabled = true;
+    rec.path = path;
+}
+
+bool enabled()
+{
+    return get_recording().enabled;
+}
+
+timer::timer( const char *phase, const std::string &name ) : phase( phase ),
+    name( enabled() ? name : std::string() ), start( std::chrono::steady_clock::now() )
+{
+}
+
+timer::~timer()
+{
+    if( !enabled() ) {
+        return;
+    }
+    add( phase, name, std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start ).count() );
+}
+
+void add( const std::string &phase, const std::string &name, const std::uint64_t microseconds )
+{
+    recording &rec = get_recording();
+    if( !rec.enabled ) {
+        return;
+    }
+    const auto inserted = rec.index.emplace( std::make_pair( phase, name ), rec.all_totals.size() );
+    if( inserted.second ) {
+        rec.all_totals.push_back( { phase, name } );
+    }
+    totals &t = rec.all_totals[inserted.first->second];
+    t.count++;
+    t.microseconds += microseconds;
+}
+
+std::uint64_t count( const std::string &phase, const std::string &name )
+{
+    const totals *t = find_totals( phase, name );
+    return t ? t->count : 0;
+}
+
+std::uint64_t microseconds( const std::string &phase, const std::string &name )
+{
+    const totals *t = find_totals( phase, name );
+    return t ? t->microseconds : 0;
+}
+
+void reset()
+{
+    recording &rec = get_recording();
+    rec.all_totals.clear();
+    rec.index.clear();
+}
+
+std::string csv()
+{
+    std::string ret = "phase,name,calls,total_us\n";
+    for( const totals &t : get_recording().all_totals ) {
+        // Names are ids and file paths, quote them in case they contain commas
+        ret += string_format( "%s,\"%s\",%d,%d\n", t.phase, t.name, t.count, t.microseconds );
+    }
+    return ret;
+}
+
+void write()
+{
+    const recording &rec = get_recording();
+    if( !rec.enabled || rec.path.empty() ) {
+        return;
+    }
+    // This runs at exit, when there may be no UI left to show a popup on
+    try {
+        write_to_file( rec.path, []( std::ostream & fout ) {
+            fout << csv();
+        } );
+    } catch( const std::exception &err ) {
+        DebugLog( DL::Error, DC::Main ) << "Failed to write the startup timing report to " << rec.path
+                                        << ": " << err.what();
+    }
+}
+
+} // namespace startup_timings
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef CATA_SRC_STARTUP_TIMINGS_H
+#define CATA_SRC_STARTUP_TIMINGS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Wall time spent in the steps of starting the game and loading its data, by phase
+ * (e.g. "json file" or "finalize") and name within the phase. Nothing is recorded
+ * unless @ref enable was called, which the --startup-report command-line flag does.
+ */
+namespace startup_timings
+{
+
+/** Start recording, and write the report to `path` when the game exits. */
+void enable( const std::string &path );
+bool enabled();
+
+/** Adds the time from its creation to its end to the totals of `name` in `phase`. */
+class timer
+{
+    public:
+        timer( const char *phase, const std::string &name );
+        ~timer();
+        timer( const timer & ) = delete;
+        timer &operator=( const timer & ) = delete;
+
+    private:
+        const char *phase;
+        // Empty when not recording
+        std::string name;
+        std::chrono::steady_clock::time_point start;
+};
+
+void add( const std::string &phase, const std::string &name, std::uint64_t microseconds );
+
+/** How many times `name` was timed in `phase`, and for how long. */
+std::uint64_t count( const std::string &phase, const std::string &name );
+std::uint64_t microseconds( const std::string &phase, const std::string &name );
+
+void reset();
+/** All the totals, one row for each phase and name, in the order they were first timed. */
+std::string csv();
+/** Writes @ref csv to the path given to @ref enable. */
+void write();
+
+} // namespace startup_timings
+
+#endif // CATA_SRC_STARTUP_TIMINGS_H
@@ -27,24 +27,56 @@ void event_multiset::set_type( event_type type )
     type_ = type;
 }
 
-int event_multiset::count() const
+void event_multiset::summary::add( const std::string &field,
+                                   const cata::event::data_type &criteria,
+                                   const cata::event::data_type &data, int count )
 {
-    int total = 0;
-    for( const auto &pair : counts_ ) {
-        total += pair.second;
+    if( !event_data_matches( data, criteria ) ) {
+        return;
+    }
+    if( field.empty() ) {
+        total += count;
+        return;
     }
-    return total;
+    auto it = data.find( field );
+    if( it == data.end() ) {
+        return;
+    }
+    const int value = it->second.get<cata_variant_type::int_>();
+    total += count * value;
+    minimum = std::min( minimum, value );
+    maximum = std::max( maximum, value );
 }
 
-int event_multiset::count( const cata::event::data_type &criteria ) const
+const event_multiset::summary &event_multiset::summary_for( const std::string &field,
+        const cata::event::data_type &criteria ) const
 {
-    int total = 0;
+    auto it = summaries_.find( summary_key( field, criteria ) );
+    if( it != summaries_.end() ) {
+        return it->second;
+    }
+    summary result;
     for( const auto &pair : counts_ ) {
-        if( event_data_matches( pair.first, criteria ) ) {
-            total += pair.second;
-        }
+        result.add( field, criteria, pair.first, pair.second );
+    }
+    return summaries_.emplace( summary_key( field, criteria ), result ).first->second;
+}
+
+void event_multiset::add_to_summaries( const cata::event::data_type &data, int count )
+{
+    for( auto &pair : summaries_ ) {
+        pair.second.add( pair.first.first, pair.first.second, data, count );
     }
-    return total;
+}
+
+int event_multiset::count() const
+{
+    return count( {} );
+}
+
+int event_multiset::count( const cata::event::data_type &criteria ) const
+{
+    return summary_for( "", criteria ).total;
 }
 
 int event_multiset::total( const std::string &field ) const
@@ -54,59 +86,29 @@ int event_multiset::total( const std::string &field ) const
 
 int event_multiset::total( const std::string &field, const cata::event::data_type &criteria ) const
 {
-    int total = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
-            continue;
-        }
-        if( event_data_matches( pair.first, criteria ) ) {
-            total += pair.second * it->second.get<cata_variant_type::int_>();
-        }
-    }
-    return total;
+    return summary_for( field, criteria ).total;
 }
 
 int event_multiset::minimum( const std::string &field ) const
 {
-    int minimum = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
-            continue;
-        }
-        const int potential = it->second.get<cata_variant_type::int_>();
-        if( potential < minimum ) {
-            minimum = potential;
-        }
-    }
-    return minimum;
+    return summary_for( field, {} ).minimum;
 }
 
 int event_multiset::maximum( const std::string &field ) const
 {
-    int maximum = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
-            continue;
-        }
-        const int potential = it->second.get<cata_variant_type::int_>();
-        if( potential > maximum ) {
-            maximum = potential;
-        }
-    }
-    return maximum;
+    return summary_for( field, {} ).maximum;
 }
 
 void event_multiset::add( const cata::event &e )
 {
     counts_[e.data()]++;
+    add_to_summaries( e.data(), 1 );
 }
 
 void event_multiset::add( const counts_type::value_type &e )
 {
     counts_[e.first] += e.second;
+    add_to_summaries( e.first, e.second );
 }
 
 base_watcher::~base_watcher()
@@ -148,6 +150,12 @@ event_multiset &stats_tracker::get_events( event_type type )
 event_multiset stats_tracker::get_events(
     const string_id<event_transformation> &transform_id )
 {
+    if( events_being_sent == 0 ) {
+        auto it = event_transformation_states.find( transform_id );
+        if( it != event_transformation_states.end() && it->second ) {
+            return it->second->events();
+        }
+    }
     return transform_id->value( *this );
 }
 
@@ -167,7 +175,7 @@ void stats_tracker::add_watcher( const string_id<event_transformation> &id,
 {
     event_transformation_watchers[id].insert( watcher );
     watcher->on_subscribe( this );
-    std::unique_ptr<stats_tracker_state> &state = event_transformation_states[ id ];
+    std::unique_ptr<event_transformation_state> &state = event_transformation_states[ id ];
     if( !state ) {
         state = id->watch( *this );
     }
@@ -274,7 +282,9 @@ void stats_tracker::notify( const cata::event &e )
 
     auto it = event_type_watchers.find( type );
     if( it != event_type_watchers.end() ) {
+        events_being_sent++;
         it->second.send_to_all( &event_multiset_watcher::event_added, e, *this );
+        events_being_sent--;
     }
 
     if( e.type() == event_type::game_start ) {
@@ -1,6 +1,7 @@
 #ifndef CATA_SRC_STATS_TRACKER_H
 #define CATA_SRC_STATS_TRACKER_H
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -74,8 +75,26 @@ class event_multiset
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
     private:
+        struct summary {
+            int total = 0;
+            int minimum = 0;
+            int maximum = 0;
+
+            void add( const std::string &field, const cata::event::data_type &criteria,
+                      const cata::event::data_type &data, int count );
+        };
+        // Field ("" to count the events) and criteria of a query
+        using summary_key = std::pair<std::string, cata::event::data_type>;
+
+        // Finds the summary of a query, working it out the first time the query is made
+        const summary &summary_for( const std::string &field,
+                                    const cata::event::data_type &criteria ) const;
+        void add_to_summaries( const cata::event::data_type &, int count );
+
         event_type type_;
         counts_type counts_;
+        // Every query made so far, kept up to date as events are added
+        mutable std::map<summary_key, summary> summaries_;
 };
 
 class base_watcher
@@ -146,6 +165,13 @@ class stats_tracker_state
         virtual ~stats_tracker_state() = 0;
 };
 
+class event_transformation_state : public stats_tracker_state
+{
+    public:
+        // The transformed events, kept up to date as events come in
+        virtual const event_multiset &events() const = 0;
+};
+
 class stats_tracker : public event_subscriber
 {
     public:
@@ -186,12 +212,15 @@ class stats_tracker : public event_subscriber
         std::unordered_map<string_id<event_transformation>, watcher_set<event_multiset_watcher>>
                 event_transformation_watchers;
         std::unordered_map<string_id<event_statistic>, watcher_set<stat_watcher>> stat_watchers;
-        std::unordered_map<string_id<event_transformation>, std::unique_ptr<stats_tracker_state>>
-                event_transformation_states;
+        std::unordered_map<string_id<event_transformation>,
+            std::unique_ptr<event_transformation_state>> event_transformation_states;
         std::unordered_map<string_id<event_statistic>, std::unique_ptr<stats_tracker_state>>
                 stat_states;
 
         std::unordered_set<string_id<score>> initial_scores;
+        // How many events are being sent to the watchers right now.  While it is
+        // non-zero the watched states might not have caught up with the event yet.
+        int events_being_sent = 0;
 };
 
 #endif // CATA_SRC_STATS_TRACKER_H
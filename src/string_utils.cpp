@@ -38,6 +38,38 @@ bool lcmatch( const translation &str, const std::string &qry )
     return lcmatch( str.translated(), qry );
 }
 
+lcmatcher::lcmatcher( const std::string &qry )
+{
+    wide = locale.name() != "en_US.UTF-8" && locale.name() != "C";
+    if( wide ) {
+        wneedle = utf8_to_wstr( qry );
+        std::use_facet<std::ctype<wchar_t>>( locale ).tolower( wneedle.data(),
+                wneedle.data() + wneedle.size() );
+    } else {
+        needle.reserve( qry.size() );
+        std::transform( qry.begin(), qry.end(), std::back_inserter( needle ), tolower );
+    }
+}
+
+bool lcmatcher::operator()( const std::string &str ) const
+{
+    if( wide ) {
+        std::wstring whaystack = utf8_to_wstr( str );
+        std::use_facet<std::ctype<wchar_t>>( locale ).tolower( whaystack.data(),
+                whaystack.data() + whaystack.size() );
+        return whaystack.find( wneedle ) != std::wstring::npos;
+    }
+    return std::search( str.begin(), str.end(), needle.begin(), needle.end(),
+    []( char hay, char needle_char ) {
+        return static_cast<char>( tolower( hay ) ) == needle_char;
+    } ) != str.end() || needle.empty();
+}
+
+bool lcmatcher::operator()( const translation &str ) const
+{
+    return ( *this )( str.translated() );
+}
+
 bool lcequal( const std::string &str1, const std::string &str2 )
 {
     return to_lower_case( str1 ) == to_lower_case( str2 );
@@ -128,44 +160,62 @@ int ci_find_substr( const std::string &str1, const std::string &str2 )
 
 bool wildcard_match( const std::string &text_in, const std::string &pattern_in )
 {
-    std::string text = text_in;
+    return wildcard_pattern( pattern_in ).matches( text_in );
+}
+
+wildcard_pattern::wildcard_pattern( const std::string &pattern_in )
+    : parts( string_split( wildcard_trim_rule( pattern_in ), '*' ) )
+{
+}
 
+bool wildcard_pattern::matches( const std::string &text ) const
+{
     if( text.empty() ) {
         return false;
     } else if( text == "*" ) {
         return true;
     }
 
-    std::vector<std::string> pattern = string_split( wildcard_trim_rule( pattern_in ), '*' );
+    const std::locale loc = std::locale();
+    const auto ci_equal = [&loc]( const char a, const char b ) {
+        return std::toupper( a, loc ) == std::toupper( b, loc );
+    };
+    // Position of part in text at or after from, npos if it isn't there
+    const auto find_from = [&]( const std::string & part, const size_t from ) {
+        const auto it = std::search( text.begin() + from, text.end(), part.begin(), part.end(),
+                                     ci_equal );
+        return it == text.end() ? std::string::npos : static_cast<size_t>( it - text.begin() );
+    };
+    const auto equal_at = [&]( const std::string & part, const size_t at ) {
+        return std::equal( part.begin(), part.end(), text.begin() + at, ci_equal );
+    };
 
-    if( pattern.size() == 1 ) { // no * found
-        return ( text.length() == pattern[0].length() && ci_find_substr( text, pattern[0] ) != -1 );
+    if( parts.size() == 1 ) { // no * found
+        return text.length() == parts[0].length() && equal_at( parts[0], 0 );
     }
 
-    for( auto it = pattern.begin(); it != pattern.end(); ++it ) {
-        if( it == pattern.begin() && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( 0, it->length() ), *it ) == -1 ) {
+    // Start of the text not consumed by the parts matched so far
+    size_t rest = 0;
+    for( auto it = parts.begin(); it != parts.end(); ++it ) {
+        if( it->empty() ) {
+            continue;
+        }
+        if( it == parts.begin() ) {
+            if( text.length() < it->length() || !equal_at( *it, 0 ) ) {
                 return false;
             }
-
-            text = text.substr( it->length(), text.length() - it->length() );
-        } else if( it == pattern.end() - 1 && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( text.length() - it->length(),
-                                             it->length() ), *it ) == -1 ) {
+            rest = it->length();
+        } else if( it == parts.end() - 1 ) {
+            if( text.length() - rest < it->length() ||
+                !equal_at( *it, text.length() - it->length() ) ) {
                 return false;
             }
         } else {
-            if( !( *it ).empty() ) {
-                int pos = ci_find_substr( text, *it );
-                if( pos == -1 ) {
-                    return false;
-                }
-
-                text = text.substr( pos + static_cast<int>( it->length() ),
-                                    static_cast<int>( text.length() ) - pos );
+            const size_t pos = find_from( *it, rest );
+            if( pos == std::string::npos ) {
+                return false;
             }
+            rest = pos + it->length();
         }
     }
 
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_STRING_UTILS_H
 #define CATA_SRC_STRING_UTILS_H
 
+#include <locale>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,26 @@ class translation;
 bool lcmatch( const std::string &str, const std::string &qry );
 bool lcmatch( const translation &str, const std::string &qry );
 
+/**
+ * Does what @ref lcmatch does for one query and many subjects: the query is lowered, and the
+ * locale looked up, once when the matcher is made. In the "C" and en_US locales the subjects
+ * are compared without making lowered copies of them.
+ */
+class lcmatcher
+{
+    public:
+        explicit lcmatcher( const std::string &qry );
+
+        bool operator()( const std::string &str ) const;
+        bool operator()( const translation &str ) const;
+
+    private:
+        std::locale locale;
+        bool wide = false;
+        std::string needle;
+        std::wstring wneedle;
+};
+
 /** Perform case insensitive comparison of 2 strings. */
 bool lcequal( const std::string &str1, const std::string &str2 );
 
@@ -71,6 +92,21 @@ int ci_find_substr( const std::string &str1, const std::string &str2 );
  */
 bool wildcard_match( const std::string &text_in, const std::string &pattern_in );
 
+/**
+ * A pattern of @ref wildcard_match, trimmed and split at the '*' once so it can be
+ * matched against many texts.
+ */
+class wildcard_pattern
+{
+    public:
+        explicit wildcard_pattern( const std::string &pattern_in );
+
+        bool matches( const std::string &text ) const;
+
+    private:
+        std::vector<std::string> parts;
+};
+
 /**
  * Remove excessive '*' in wildcard rule.
  */
@@ -36,8 +36,11 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.trp, second.trp );
     std::swap( first.rad, second.rad );
     std::swap( first.is_uniform, second.is_uniform );
+    first.light_emitters_dirty = true;
+    second.light_emitters_dirty = true;
     std::swap( first.active_items, second.active_items );
     std::swap( first.field_count, second.field_count );
+    std::swap( first.field_tiles, second.field_tiles );
     std::swap( first.last_touched, second.last_touched );
     std::swap( first.spawns, second.spawns );
     std::swap( first.vehicles, second.vehicles );
@@ -48,6 +51,9 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.legacy_computer, second.legacy_computer );
     std::swap( first.temperature, second.temperature );
     std::swap( first.cosmetics, second.cosmetics );
+    std::swap( first.cosmetic_tiles, second.cosmetic_tiles );
+    first.modified = true;
+    second.modified = true;
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -236,12 +242,26 @@ submap::submap( tripoint offset ) : maptile_soa<SEEX, SEEY>( offset )
 
 submap::~submap() = default;
 
+std::size_t submap::memory_usage() const
+{
+    std::size_t bytes = sizeof( submap ) + spawns.capacity() * sizeof( spawn_point ) +
+                        field_tiles.count() * sizeof( field_entry ) +
+                        light_emitters.capacity() * sizeof( point );
+    for( const std::unique_ptr<vehicle> &veh : vehicles ) {
+        bytes += sizeof( vehicle ) + veh->part_count() * sizeof( vehicle_part );
+    }
+    return bytes;
+}
+
 void submap::update_lum_rem( point p, const item &i )
 {
     is_uniform = false;
+    modified = true;
     if( !i.is_emissive() ) {
         return;
-    } else if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
+    }
+    light_emitters_dirty = true;
+    if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
         lum[p.x][p.y]--;
         return;
     }
@@ -260,8 +280,25 @@ void submap::update_lum_rem( point p, const item &i )
     }
 }
 
+const std::vector<point> &submap::get_light_emitters() const
+{
+    if( light_emitters_dirty ) {
+        light_emitters.clear();
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                if( lum[x][y] ) {
+                    light_emitters.emplace_back( x, y );
+                }
+            }
+        }
+        light_emitters_dirty = false;
+    }
+    return light_emitters;
+}
+
 void submap::insert_cosmetic( point p, const std::string &type, const std::string &str )
 {
+    modified = true;
     cosmetic_t ins;
 
     ins.pos = p;
@@ -269,6 +306,15 @@ void submap::insert_cosmetic( point p, const std::string &type, const std::strin
     ins.str = str;
 
     cosmetics.push_back( ins );
+    cosmetic_tiles.set( p.x * SEEY + p.y );
+}
+
+void submap::update_cosmetic_tile( point p )
+{
+    const bool any = std::any_of( cosmetics.begin(), cosmetics.end(), [p]( const cosmetic_t &c ) {
+        return c.pos == p;
+    } );
+    cosmetic_tiles.set( p.x * SEEY + p.y, any );
 }
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
@@ -300,11 +346,17 @@ static cosmetic_find_result find_cosmetic(
 
 bool submap::has_graffiti( point p ) const
 {
+    if( !cosmetic_tiles.test( p.x * SEEY + p.y ) ) {
+        return false;
+    }
     return find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI ).result;
 }
 
 const std::string &submap::get_graffiti( point p ) const
 {
+    if( !cosmetic_tiles.test( p.x * SEEY + p.y ) ) {
+        return STRING_EMPTY;
+    }
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         return cosmetics[ fresult.ndx ].str;
@@ -315,6 +367,7 @@ const std::string &submap::get_graffiti( point p ) const
 void submap::set_graffiti( point p, const std::string &new_graffiti )
 {
     is_uniform = false;
+    modified = true;
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
@@ -327,14 +380,19 @@ void submap::set_graffiti( point p, const std::string &new_graffiti )
 void submap::delete_graffiti( point p )
 {
     is_uniform = false;
+    modified = true;
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
         cosmetics.pop_back();
+        update_cosmetic_tile( p );
     }
 }
 bool submap::has_signage( point p ) const
 {
+    if( !cosmetic_tiles.test( p.x * SEEY + p.y ) ) {
+        return false;
+    }
     if( frn[p.x][p.y].obj().has_flag( "SIGN" ) ) {
         return find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE ).result;
     }
@@ -343,6 +401,9 @@ bool submap::has_signage( point p ) const
 }
 std::string submap::get_signage( point p ) const
 {
+    if( !cosmetic_tiles.test( p.x * SEEY + p.y ) ) {
+        return STRING_EMPTY;
+    }
     if( frn[p.x][p.y].obj().has_flag( "SIGN" ) ) {
         const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
         if( fresult.result ) {
@@ -355,6 +416,7 @@ std::string submap::get_signage( point p ) const
 void submap::set_signage( point p, const std::string &s )
 {
     is_uniform = false;
+    modified = true;
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
@@ -366,10 +428,12 @@ void submap::set_signage( point p, const std::string &s )
 void submap::delete_signage( point p )
 {
     is_uniform = false;
+    modified = true;
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
         cosmetics.pop_back();
+        update_cosmetic_tile( p );
     }
 }
 
@@ -408,6 +472,7 @@ const computer *submap::get_computer( point p ) const
 
 computer *submap::get_computer( point p )
 {
+    modified = true;
     // need to update to std::map first so modifications to the returned object
     // only affects the exact point p
     update_legacy_computer();
@@ -420,6 +485,7 @@ computer *submap::get_computer( point p )
 
 void submap::set_computer( point p, const computer &c )
 {
+    modified = true;
     update_legacy_computer();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
@@ -431,10 +497,17 @@ void submap::set_computer( point p, const computer &c )
 
 void submap::delete_computer( point p )
 {
+    modified = true;
     update_legacy_computer();
     computers.erase( p );
 }
 
+bool submap::has_live_contents() const
+{
+    return !vehicles.empty() || !active_items.empty() || field_count > 0 ||
+           !active_furniture.empty() || !partial_constructions.empty();
+}
+
 bool submap::contains_vehicle( vehicle *veh )
 {
     const auto match = std::find_if(
@@ -453,6 +526,9 @@ void submap::rotate( int turns )
         return;
     }
 
+    modified = true;
+    light_emitters_dirty = true;
+
     const auto rotate_point = [turns]( point  p ) {
         return p.rotate( turns, { SEEX, SEEY } );
     };
@@ -507,8 +583,19 @@ void submap::rotate( int turns )
         }
     }
 
+    field_tiles.reset();
+    for( int i = 0; i < SEEX; i++ ) {
+        for( int j = 0; j < SEEY; j++ ) {
+            if( fld[i][j].field_count() > 0 ) {
+                mark_field_tile( { i, j } );
+            }
+        }
+    }
+
+    cosmetic_tiles.reset();
     for( auto &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
+        cosmetic_tiles.set( elem.pos.x * SEEY + elem.pos.y );
     }
 
     for( auto &elem : spawns ) {
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -25,6 +26,8 @@
 
 class JsonIn;
 class JsonOut;
+class binary_in;
+class binary_out;
 class map;
 struct trap;
 struct ter_t;
@@ -96,10 +99,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_trap( point p, trap_id trap ) {
             is_uniform = false;
+            modified = true;
             trp[p.x][p.y] = trap;
         }
 
         void set_all_traps( const trap_id &trap ) {
+            modified = true;
             std::uninitialized_fill_n( &trp[0][0], elements, trap );
         }
 
@@ -109,10 +114,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_furn( point p, furn_id furn ) {
             is_uniform = false;
+            modified = true;
             frn[p.x][p.y] = furn;
         }
 
         void set_all_furn( const furn_id &furn ) {
+            modified = true;
             std::uninitialized_fill_n( &frn[0][0], elements, furn );
         }
 
@@ -122,10 +129,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_ter( point p, ter_id terr ) {
             is_uniform = false;
+            modified = true;
             ter[p.x][p.y] = terr;
         }
 
         void set_all_ter( const ter_id &terr ) {
+            modified = true;
             std::uninitialized_fill_n( &ter[0][0], elements, terr );
         }
 
@@ -135,6 +144,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_radiation( point p, const int radiation ) {
             is_uniform = false;
+            modified = true;
             rad[p.x][p.y] = radiation;
         }
 
@@ -144,20 +154,32 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_lum( point p, uint8_t luminance ) {
             is_uniform = false;
+            modified = true;
             lum[p.x][p.y] = luminance;
+            light_emitters_dirty = true;
         }
 
         void update_lum_add( point p, const item &i ) {
             is_uniform = false;
+            modified = true;
             if( i.is_emissive() && lum[p.x][p.y] < 255 ) {
                 lum[p.x][p.y]++;
+                light_emitters_dirty = true;
             }
         }
 
         void update_lum_rem( point p, const item &i );
 
+        /**
+         * Squares with a non-zero light count, in the order of a scan over x then y.
+         * Rebuilt from the counts when they changed, so lighting doesn't have to check every square.
+         */
+        const std::vector<point> &get_light_emitters() const;
+
         // TODO: Replace this as it essentially makes itm public
         location_vector<item> &get_items( const point &p ) {
+            // Callers may change the items in any way, assume they do
+            modified = true;
             return itm[p.x][p.y];
         }
 
@@ -167,6 +189,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         // TODO: Replace this as it essentially makes fld public
         field &get_field( point p ) {
+            modified = true;
             return fld[p.x][p.y];
         }
 
@@ -174,6 +197,11 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /** Remember that the tile at p has fields, see @ref field_tiles. */
+        void mark_field_tile( point p ) {
+            field_tiles.set( p.x * SEEY + p.y );
+        }
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -187,6 +215,7 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         void set_temperature( int new_temperature ) {
+            modified = true;
             temperature = new_temperature;
         }
 
@@ -219,15 +248,60 @@ class submap : maptile_soa<SEEX, SEEY>
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
+        /**
+         * Compact binary encoding, see savegame_binary.cpp.
+         * Terrain, furniture, traps, radiation and fields are stored as binary records,
+         * everything else (items, vehicles...) as embedded JSON records.
+         */
+        void store_binary( binary_out &out ) const;
+        void load_binary( binary_in &in, int version, const tripoint offset );
+
+        /**
+         * Approximate bytes taken by the submap, its fields, vehicles and spawns.
+         * The items are counted on their own.
+         */
+        std::size_t memory_usage() const;
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
 
+        /**
+         * Whether this submap changed since it was last loaded from or written to disk.
+         * Unmodified quads are not rewritten by @ref mapbuffer::save.
+         * The mutators of this class set it, code changing the public members
+         * below directly has to call @ref mark_modified itself.
+         */
+        bool is_modified() const {
+            return modified;
+        }
+        void mark_modified() {
+            modified = true;
+        }
+        void clear_modified() {
+            modified = false;
+        }
+        /**
+         * Whether this submap has contents that get updated in place while it is in the
+         * reality bubble (without going through the mutators), so it has to be assumed modified.
+         */
+        bool has_live_contents() const;
+
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
+        /**
+         * Tiles that have an entry in @ref cosmetics, by x * SEEY + y, so looking for graffiti
+         * or signage on a plain tile doesn't have to search them.
+         */
+        std::bitset<SEEX * SEEY> cosmetic_tiles;
 
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Tiles that may have fields, by x * SEEY + y. Each tile gets set when a field
+         * is added to it, and reset by field processing once it finds the tile empty.
+         */
+        std::bitset<SEEX * SEEY> field_tiles;
         time_point last_touched = calendar::turn_zero;
         std::vector<spawn_point> spawns;
         /**
@@ -245,8 +319,16 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        // New submaps haven't been written yet
+        bool modified = true;
+        mutable std::vector<point> light_emitters;
+        mutable bool light_emitters_dirty = true;
 
         void update_legacy_computer();
+        /** Sets or resets the bit of p in @ref cosmetic_tiles after cosmetics got removed. */
+        void update_cosmetic_tile( point p );
+        /** Writes the members that have no dedicated binary encoding. */
+        void store_entities( JsonOut &jsout ) const;
 
         static constexpr size_t elements = SEEX * SEEY;
 };
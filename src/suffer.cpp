@@ -1391,7 +1391,9 @@ void Character::suffer_from_artifacts()
         add_effect( effect_attention, 3_turns );
     }
 
-    if( has_artifact_with( AEP_BAD_WEATHER ) && calendar::once_every( 1_minutes ) &&
+    // The timer is cheaper than looking through the inventory, so it goes first. The dice go
+    // after, so no random numbers are drawn without the artifact.
+    if( calendar::once_every( 1_minutes ) && has_artifact_with( AEP_BAD_WEATHER ) &&
         get_weather().weather_id->precip < precip_class::heavy ) {
         weather_manager &wm = get_weather();
         wm.weather_override = wm.get_cur_weather_gen().get_bad_weather();
@@ -1549,9 +1551,10 @@ void Character::suffer()
         process_bionic( bio );
     }
 
+    const bool check_water_damage = calendar::once_every( 1_minutes );
     for( std::pair<const trait_id, char_trait_data> &mut : my_mutations ) {
         const mutation_branch &mdata = mut.first.obj();
-        if( calendar::once_every( 1_minutes ) ) {
+        if( check_water_damage && mdata.weakness_to_water != 0 ) {
             suffer_water_damage( mdata );
         }
         char_trait_data &tdata = mut.second;
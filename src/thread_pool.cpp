@@ -0,0 +1,171 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "cached_options.h"
+#include "profile.h"
+
+// Set on threads currently running a task, nested parallel_for calls run inline there
+static thread_local bool running_task = false;
+
+static int configured_workers()
+{
+    if( worker_threads >= 0 ) {
+        return worker_threads;
+    }
+    // Leave a core for the rest of the system, there's no point in more than a few threads
+    // for the amount of work a turn has.
+    static const int hardware = static_cast<int>( std::thread::hardware_concurrency() );
+    return std::clamp( hardware - 1, 0, 7 );
+}
+
+thread_pool &get_thread_pool()
+{
+    static std::unique_ptr<thread_pool> instance;
+    const int workers = configured_workers();
+    if( !instance ) {
+        instance = std::make_unique<thread_pool>( workers );
+    } else if( instance->concurrency() != workers + 1 && !running_task ) {
+        // Tasks asking for the pool keep getting the one they run on
+        instance->run_main_thread_tasks();
+        instance = std::make_unique<thread_pool>( workers );
+    }
+    return *instance;
+}
+
+thread_pool::thread_pool( int workers ) : worker_count( workers ) {}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    job_available.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+void thread_pool::parallel_for( const half_open_rectangle<point> &area,
+                                const std::function<void( const point & )> &func )
+{
+    const int width = area.p_max.x - area.p_min.x;
+    const int height = area.p_max.y - area.p_min.y;
+    if( width <= 0 || height <= 0 ) {
+        return;
+    }
+    parallel_for( 0, width * height, [&]( int i ) {
+        func( area.p_min + point( i % width, i / width ) );
+    } );
+}
+
+void thread_pool::post_to_main_thread( std::function<void()> task )
+{
+    std::lock_guard<std::mutex> lock( main_thread_mutex );
+    main_thread_tasks.push_back( std::move( task ) );
+}
+
+void thread_pool::run_main_thread_tasks()
+{
+    while( true ) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock( main_thread_mutex );
+            if( main_thread_tasks.empty() ) {
+                return;
+            }
+            task = std::move( main_thread_tasks.front() );
+            main_thread_tasks.pop_front();
+        }
+        // Not holding the lock, the task may post more
+        task();
+    }
+}
+
+void thread_pool::parallel_for( int begin, int end, const std::function<void( int )> &func )
+{
+    if( end <= begin ) {
+        return;
+    }
+    if( running_task || worker_count == 0 || end - begin == 1 ) {
+        for( int i = begin; i < end; ++i ) {
+            func( i );
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( mutex );
+    if( workers.empty() ) {
+        // Started on first use so builds that never need them don't pay for the threads
+        for( int i = 0; i < worker_count; ++i ) {
+            workers.emplace_back( &thread_pool::run, this, i, generation );
+        }
+    }
+    job = &func;
+    next_index = begin;
+    end_index = end;
+    error = nullptr;
+    generation++;
+    job_available.notify_all();
+
+    running_task = true;
+    work_on_current_job( lock );
+    running_task = false;
+    job_done.wait( lock, [this]() {
+        return busy_workers == 0;
+    } );
+    job = nullptr;
+    if( error ) {
+        std::exception_ptr rethrown = error;
+        error = nullptr;
+        std::rethrow_exception( rethrown );
+    }
+}
+
+void thread_pool::work_on_current_job( std::unique_lock<std::mutex> &lock )
+{
+    ZoneScopedN( "thread_pool job" );
+    while( next_index < end_index ) {
+        const int index = next_index++;
+        lock.unlock();
+        std::exception_ptr failure;
+        try {
+            ( *job )( index );
+        } catch( ... ) {
+            failure = std::current_exception();
+        }
+        lock.lock();
+        if( failure && !error ) {
+            error = failure;
+        }
+    }
+}
+
+void thread_pool::run( int index, unsigned int seen_generation )
+{
+#if defined(USE_TRACY)
+    const std::string name = "Worker " + std::to_string( index + 1 );
+    tracy::SetThreadName( name.c_str() );
+#else
+    static_cast<void>( index );
+#endif
+    running_task = true;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        job_available.wait( lock, [&]() {
+            return stopping || generation != seen_generation;
+        } );
+        if( stopping ) {
+            return;
+        }
+        seen_generation = generation;
+        busy_workers++;
+        work_on_current_job( lock );
+        if( --busy_workers == 0 ) {
+            job_done.notify_all();
+        }
+    }
+}
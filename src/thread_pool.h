@@ -0,0 +1,90 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cuboid_rectangle.h"
+#include "point.h"
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * Worker threads shared by everything in the game that splits up its work, so they don't
+ * each start their own. Threads that mostly wait for the disk, like the background saver,
+ * are kept separate so they don't hold up the workers.
+ *
+ * The game state is not thread safe. Work run on the pool may only read game data that
+ * nobody modifies meanwhile and write to outputs no other task touches. It must not call
+ * debugmsg, touch the UI or change the game in any other way, anything like that has to be
+ * handed to the main thread with @ref post_to_main_thread.
+ */
+class thread_pool
+{
+    public:
+        /** @param workers Number of threads besides the calling one, 0 runs everything inline. */
+        explicit thread_pool( int workers );
+        ~thread_pool();
+
+        /**
+         * Call @p func for each index in [begin, end), spread over the workers and the
+         * calling thread, and return once all calls are done. If any call throws, one of
+         * the exceptions is rethrown here. Calls from inside a task run serially.
+         */
+        void parallel_for( int begin, int end, const std::function<void( int )> &func );
+        /** As above, calling @p func for each point in @p area, e.g. the submaps of a map. */
+        void parallel_for( const half_open_rectangle<point> &area,
+                           const std::function<void( const point & )> &func );
+
+        /**
+         * Queue @p task to run on the main thread, the next time it calls
+         * @ref run_main_thread_tasks. Can be called from any thread.
+         */
+        void post_to_main_thread( std::function<void()> task );
+        /** Run the tasks posted so far, in the order they were posted. Main thread only. */
+        void run_main_thread_tasks();
+
+        /** Number of threads that work on a @ref parallel_for, including the caller. */
+        int concurrency() const {
+            return worker_count + 1;
+        }
+
+    private:
+        void run( int index, unsigned int seen_generation );
+        void work_on_current_job( std::unique_lock<std::mutex> &lock );
+
+        const int worker_count;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable job_available;
+        std::condition_variable job_done;
+        // Only one job runs at a time, guarded by mutex
+        const std::function<void( int )> *job = nullptr;
+        int next_index = 0;
+        int end_index = 0;
+        int busy_workers = 0;
+        unsigned int generation = 0;
+        std::exception_ptr error;
+        bool stopping = false;
+
+        std::mutex main_thread_mutex;
+        std::deque<std::function<void()>> main_thread_tasks;
+};
+
+/**
+ * The pool of the game, with the number of workers set by the WORKER_THREADS option, or
+ * picked from the hardware. It is rebuilt when the option changes, so don't keep the
+ * reference past the function that got it.
+ */
+thread_pool &get_thread_pool();
+
+#endif // CATA_SRC_THREAD_POOL_H
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef CATA_SRC_TRIPOINT_MAP_H
+#define CATA_SRC_TRIPOINT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flat_hash_map.h"
+#include "point.h"
+
+namespace cata
+{
+
+/**
+ * The point packed into 64 bits, 28 each for x and y and 8 for z. Unique for points within
+ * 2^27 of the origin on x and y and 128 on z, which covers local and absolute map square
+ * coordinates of any reasonable world. Points outside of that still work as hash keys,
+ * they just share keys with others.
+ */
+constexpr std::uint64_t pack_tripoint( const tripoint &p )
+{
+    constexpr std::uint64_t xy_mask = ( std::uint64_t( 1 ) << 28 ) - 1;
+    return ( static_cast<std::uint64_t>( static_cast<std::uint32_t>( p.x ) ) & xy_mask ) |
+           ( ( static_cast<std::uint64_t>( static_cast<std::uint32_t>( p.y ) ) & xy_mask ) << 28 ) |
+           ( static_cast<std::uint64_t>( static_cast<std::uint8_t>( p.z ) ) << 56 );
+}
+
+/** Hashes points by @ref pack_tripoint, the tables mix the bits further themselves. */
+struct tripoint_hash {
+    std::size_t operator()( const tripoint &p ) const noexcept {
+        return static_cast<std::size_t>( pack_tripoint( p ) );
+    }
+};
+
+/** For containers keyed on points that are looked up all the time, e.g. every turn. */
+template<typename Value>
+using tripoint_map = flat_hash_map<tripoint, Value, tripoint_hash>;
+using tripoint_set = flat_hash_set<tripoint, tripoint_hash>;
+
+} // namespace cata
+
+#endif // CATA_SRC_TRIPOINT_MAP_H
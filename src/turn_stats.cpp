@@ -0,0 +1,220 @@
+#include "turn_stats.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "debug.h"
+#include "string_formatter.h"
+
+namespace turn_stats
+{
+
+namespace
+{
+
+struct turn_history {
+    turn_record current;
+    // Ring buffer of the last turns, oldest at `next` once it is full
+    std::array<turn_record, history_size> kept;
+    int next = 0;
+    int size = 0;
+    std::uint64_t turns = 0;
+    std::array<std::uint64_t, num_phases> total_nanoseconds = {};
+};
+
+turn_history &get_history()
+{
+    static turn_history history;
+    return history;
+}
+
+double to_ms( std::uint64_t ns )
+{
+    return ns / 1e6;
+}
+
+} // namespace
+
+std::uint64_t turn_record::total_nanoseconds() const
+{
+    return std::accumulate( nanoseconds.begin(), nanoseconds.end(), std::uint64_t( 0 ) );
+}
+
+std::string turn_record::slowest_phases( int how_many, const std::string &sep ) const
+{
+    std::vector<std::pair<std::uint64_t, int>> phases;
+    for( int p = 0; p < num_phases; p++ ) {
+        if( nanoseconds[p] > 0 ) {
+            phases.emplace_back( nanoseconds[p], p );
+        }
+    }
+    std::sort( phases.begin(), phases.end(), std::greater<>() );
+    std::string ret;
+    for( int i = 0; i < std::min<int>( how_many, phases.size() ); i++ ) {
+        if( i > 0 ) {
+            ret += sep;
+        }
+        const turn_phase phase = static_cast<turn_phase>( phases[i].second );
+        ret += string_format( "%s %.2f ms", phase_name( phase ), to_ms( phases[i].first ) );
+    }
+    return ret;
+}
+
+const char *phase_name( turn_phase phase )
+{
+    switch( phase ) {
+        case turn_phase::timed_events:
+            return "timed_events";
+        case turn_phase::missions:
+            return "missions";
+        case turn_phase::scent:
+            return "scent";
+        case turn_phase::floor_caches:
+            return "floor_caches";
+        case turn_phase::falling:
+            return "falling";
+        case turn_phase::vehmove:
+            return "vehmove";
+        case turn_phase::fields:
+            return "fields";
+        case turn_phase::items:
+            return "items";
+        case turn_phase::grid:
+            return "grid";
+        case turn_phase::sounds:
+            return "sounds";
+        case turn_phase::map_cache:
+            return "map_cache";
+        case turn_phase::monmove:
+            return "monmove";
+        case turn_phase::npc_move:
+            return "npc_move";
+        case turn_phase::avatar:
+            return "avatar";
+        case turn_phase::lua_hooks:
+            return "lua_hooks";
+        case turn_phase::num_turn_phases:
+            break;
+    }
+    return "invalid";
+}
+
+void add( turn_phase phase, std::chrono::nanoseconds time )
+{
+    get_history().current.nanoseconds[static_cast<int>( phase )] += time.count();
+}
+
+bool end_turn( std::chrono::milliseconds slow_turn )
+{
+    turn_history &h = get_history();
+    const turn_record &turn = h.current;
+    for( int p = 0; p < num_phases; p++ ) {
+        h.total_nanoseconds[p] += turn.nanoseconds[p];
+    }
+    h.turns++;
+    const std::uint64_t total = turn.total_nanoseconds();
+    const std::uint64_t slow_ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+                                  ( slow_turn ).count();
+    const bool slow = slow_ns > 0 && total > slow_ns;
+    if( slow ) {
+        DebugLog( DL::Warn, DC::Main ) << string_format( "Slow turn took %.2f ms: %s",
+                                       to_ms( total ), turn.slowest_phases( num_phases, ", " ) );
+    }
+    h.kept[h.next] = turn;
+    h.next = ( h.next + 1 ) % history_size;
+    h.size = std::min( h.size + 1, history_size );
+    h.current = turn_record();
+    return slow;
+}
+
+const turn_record &last_turn()
+{
+    static const turn_record none;
+    const turn_history &h = get_history();
+    if( h.size == 0 ) {
+        return none;
+    }
+    return h.kept[( h.next + history_size - 1 ) % history_size];
+}
+
+int turns_kept()
+{
+    return get_history().size;
+}
+
+std::array<int, num_buckets> histogram()
+{
+    const turn_history &h = get_history();
+    std::array<int, num_buckets> ret = {};
+    for( int i = 0; i < h.size; i++ ) {
+        const double ms = to_ms( h.kept[i].total_nanoseconds() );
+        const auto limit = std::find_if( histogram_limits.begin(), histogram_limits.end(),
+        [ms]( int limit ) {
+            return ms < limit;
+        } );
+        ret[limit - histogram_limits.begin()]++;
+    }
+    return ret;
+}
+
+std::string bucket_label( int bucket )
+{
+    if( bucket < num_buckets - 1 ) {
+        return string_format( "<%d", histogram_limits[bucket] );
+    }
+    return string_format( ">=%d", histogram_limits.back() );
+}
+
+std::uint64_t turns()
+{
+    return get_history().turns;
+}
+
+std::uint64_t microseconds( turn_phase phase )
+{
+    return get_history().total_nanoseconds[static_cast<int>( phase )] / 1000;
+}
+
+void reset()
+{
+    get_history() = turn_history();
+}
+
+std::string report()
+{
+    const turn_history &h = get_history();
+    if( h.turns == 0 ) {
+        return std::string();
+    }
+    turn_record kept_total;
+    std::uint64_t slowest = 0;
+    for( int i = 0; i < h.size; i++ ) {
+        for( int p = 0; p < num_phases; p++ ) {
+            kept_total.nanoseconds[p] += h.kept[i].nanoseconds[p];
+        }
+        slowest = std::max( slowest, h.kept[i].total_nanoseconds() );
+    }
+    std::string ret = string_format( "Last %d turns: %.2f ms each, slowest %.2f ms\n", h.size,
+                                     to_ms( kept_total.total_nanoseconds() ) / h.size,
+                                     to_ms( slowest ) );
+    const std::array<int, num_buckets> buckets = histogram();
+    for( int b = 0; b < num_buckets; b++ ) {
+        ret += string_format( "%s ms: %d\n", bucket_label( b ), buckets[b] );
+    }
+    ret += string_format( "\n%d turns since the last reset:\n", h.turns );
+    for( int p = 0; p < num_phases; p++ ) {
+        if( h.total_nanoseconds[p] == 0 ) {
+            continue;
+        }
+        const double ms = to_ms( h.total_nanoseconds[p] );
+        const turn_phase phase = static_cast<turn_phase>( p );
+        ret += string_format( "%s: %.3f ms, %.3f ms each turn\n", phase_name( phase ), ms,
+                              ms / h.turns );
+    }
+    return ret;
+}
+
+} // namespace turn_stats
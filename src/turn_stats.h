@@ -0,0 +1,87 @@
+#pragma once
+#ifndef CATA_SRC_TURN_STATS_H
+#define CATA_SRC_TURN_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "phase_stats.h"
+
+/** The parts of @ref game::do_turn that are timed separately. */
+enum class turn_phase : int {
+    timed_events,
+    missions,
+    scent,
+    floor_caches,
+    falling,
+    vehmove,
+    fields,
+    items,
+    grid,
+    sounds,
+    map_cache,
+    monmove,
+    npc_move,
+    /** Everything the avatar does after their turn, @ref Character::process_turn. */
+    avatar,
+    lua_hooks,
+    num_turn_phases
+};
+
+/**
+ * Wall time spent in each phase of the world's turns, kept for the last few turns
+ * so slow ones can be looked at after the fact. The time the avatar's own actions
+ * take, which includes waiting for the keyboard, is not part of a turn.
+ */
+namespace turn_stats
+{
+
+constexpr int num_phases = static_cast<int>( turn_phase::num_turn_phases );
+/** How many of the last turns are kept. */
+constexpr int history_size = 100;
+/** Turns of up to these many milliseconds count in each bucket, the last one takes the rest. */
+constexpr std::array<int, 9> histogram_limits = { 1, 2, 5, 10, 20, 50, 100, 200, 500 };
+constexpr int num_buckets = histogram_limits.size() + 1;
+
+struct turn_record {
+    std::array<std::uint64_t, num_phases> nanoseconds = {};
+
+    std::uint64_t total_nanoseconds() const;
+    /** The phases that took longest, slowest first, as "name 1.23 ms" separated by `sep`. */
+    std::string slowest_phases( int how_many, const std::string &sep ) const;
+};
+
+const char *phase_name( turn_phase phase );
+
+void add( turn_phase phase, std::chrono::nanoseconds time );
+/** Adds the time from its creation to its end to `phase` of the current turn. */
+using phase_timer = phase_stats::scoped_timer<turn_phase, add>;
+/**
+ * Moves the current turn into the history.
+ * @return Whether it took longer than `slow_turn`, in which case it is written to the
+ * debug log. A `slow_turn` of zero never counts a turn as slow.
+ */
+bool end_turn( std::chrono::milliseconds slow_turn );
+
+/** The last turn that ended, or an empty one if none did since the last reset. */
+const turn_record &last_turn();
+/** How many turns are in the history. */
+int turns_kept();
+/** How many of the turns in the history fall into each bucket of @ref histogram_limits. */
+std::array<int, num_buckets> histogram();
+/** "<1", "<2" and so on, and ">=500" for the last one. */
+std::string bucket_label( int bucket );
+
+/** How many turns ended since the last reset. */
+std::uint64_t turns();
+std::uint64_t microseconds( turn_phase phase );
+
+void reset();
+/** The phases in the history and since the last reset, and the histogram. */
+std::string report();
+
+} // namespace turn_stats
+
+#endif // CATA_SRC_TURN_STATS_H
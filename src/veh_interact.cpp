@@ -3135,6 +3135,7 @@ void veh_interact::complete_vehicle( player &p )
             // Need map-relative coordinates to compare to output of look_around.
             // Need to call coord_translate() directly since it's a new part.
             const point q = veh->coord_translate( d );
+            here.set_pathfinding_cache_dirty( veh->global_pos3() + q );
 
             if( vpinfo.has_flag( VPFLAG_CONE_LIGHT ) ||
                 vpinfo.has_flag( VPFLAG_WIDE_CONE_LIGHT ) ||
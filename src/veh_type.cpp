@@ -106,6 +106,24 @@ static const std::unordered_map<std::string, vpart_bitflags> vpart_bitflag_map =
     { "RAIL", VPFLAG_RAIL },
     { "TURRET_CONTROLS", VPFLAG_TURRET_CONTROLS },
     { "ROOF", VPFLAG_ROOF },
+    { "WIND_POWERED", VPFLAG_WIND_POWERED },
+    { "FUNNEL", VPFLAG_FUNNEL },
+    { "UNMOUNT_ON_MOVE", VPFLAG_UNMOUNT_ON_MOVE },
+    { "EMITTER", VPFLAG_EMITTER },
+    { "STEERABLE", VPFLAG_STEERABLE },
+    { "TRACKED", VPFLAG_TRACKED },
+    { "SECURITY", VPFLAG_SECURITY },
+    { "EXTRA_DRAG", VPFLAG_EXTRA_DRAG },
+    { "CAMERA", VPFLAG_CAMERA },
+    { "TURRET", VPFLAG_TURRET },
+    { "HALF_BOARD", VPFLAG_HALF_BOARD },
+    { "FULL_BOARD", VPFLAG_FULL_BOARD },
+    { "WINDSHIELD", VPFLAG_WINDSHIELD },
+    { "SEAT", VPFLAG_SEAT },
+    { "BED", VPFLAG_BED },
+    { "LOW_FINAL_AIR_DRAG", VPFLAG_LOW_FINAL_AIR_DRAG },
+    { "NO_ROOF_NEEDED", VPFLAG_NO_ROOF_NEEDED },
+    { "PROTRUSION", VPFLAG_PROTRUSION },
 };
 
 static const std::vector<std::pair<std::string, int>> standard_terrain_mod = {{
@@ -75,6 +75,24 @@ enum vpart_bitflags : int {
     VPFLAG_RAIL,
     VPFLAG_TURRET_CONTROLS,
     VPFLAG_ROOF,
+    VPFLAG_WIND_POWERED,
+    VPFLAG_FUNNEL,
+    VPFLAG_UNMOUNT_ON_MOVE,
+    VPFLAG_EMITTER,
+    VPFLAG_STEERABLE,
+    VPFLAG_TRACKED,
+    VPFLAG_SECURITY,
+    VPFLAG_EXTRA_DRAG,
+    VPFLAG_CAMERA,
+    VPFLAG_TURRET,
+    VPFLAG_HALF_BOARD,
+    VPFLAG_FULL_BOARD,
+    VPFLAG_WINDSHIELD,
+    VPFLAG_SEAT,
+    VPFLAG_BED,
+    VPFLAG_LOW_FINAL_AIR_DRAG,
+    VPFLAG_NO_ROOF_NEEDED,
+    VPFLAG_PROTRUSION,
 
     NUM_VPFLAGS
 };
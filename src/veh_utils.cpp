@@ -158,6 +158,8 @@ bool repair_part( vehicle &veh, vehicle_part &pt, Character &who_c )
     const std::string startdurability = colorize( pt.get_base().damage_symbol(),
                                         pt.get_base().damage_color() );
     bool wasbroken = pt.is_broken();
+    // Whether a part can be bashed through depends on its hp
+    get_map().set_pathfinding_cache_dirty( veh.global_part_pos3( pt ) );
     if( wasbroken ) {
         const units::angle dir = pt.direction;
         point loc = pt.mount;
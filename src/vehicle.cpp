@@ -71,6 +71,7 @@
 #include "veh_type.h"
 #include "vehicle_move.h"
 #include "vehicle_selector.h"
+#include "vehicle_turn_stats.h"
 #include "weather.h"
 #include "weather_gen.h"
 
@@ -126,6 +127,7 @@ class RemovePartHandler
                 bool permit_oob ) = 0;
         virtual void set_transparency_cache_dirty( int z ) = 0;
         virtual void set_floor_cache_dirty( int z ) = 0;
+        virtual void set_pathfinding_cache_dirty( const tripoint &loc ) = 0;
         virtual void removed( vehicle &veh, int part ) = 0;
         virtual void spawn_animal_from_part( item &base, const tripoint &loc ) = 0;
 };
@@ -150,6 +152,9 @@ class DefaultRemovePartHandler : public RemovePartHandler
         void set_floor_cache_dirty( const int z ) override {
             get_map().set_floor_cache_dirty( z );
         }
+        void set_pathfinding_cache_dirty( const tripoint &loc ) override {
+            get_map().set_pathfinding_cache_dirty( loc );
+        }
         void removed( vehicle &veh, const int part ) override {
             avatar &player_character = get_avatar();
             // If the player is currently working on the removed part, stop them as it's futile now.
@@ -215,6 +220,9 @@ class MapgenRemovePartHandler : public RemovePartHandler
         void set_floor_cache_dirty( const int /*z*/ ) override {
             // Ignored for now. We don't initialize the floor cache in mapgen anyway.
         }
+        void set_pathfinding_cache_dirty( const tripoint &/*loc*/ ) override {
+            // Ignored, nothing routes through the map in mapgen.
+        }
         void removed( vehicle &veh, const int /*part*/ ) override {
             // TODO: check if this is necessary, it probably isn't during mapgen
             m.dirty_vehicle_list.insert( &veh );
@@ -338,6 +346,7 @@ void vehicle::copy_static_from( const vehicle &source )
     coeff_rolling_dirty = source.coeff_rolling_dirty;
     coeff_air_dirty = source.coeff_air_dirty;
     coeff_water_dirty = source.coeff_water_dirty;
+    drag_profile_dirty = source.drag_profile_dirty;
     coeff_air_changed = source.coeff_air_changed;
     is_floating = source.is_floating;
     in_water = source.in_water;
@@ -500,6 +509,7 @@ void vehicle::add_steerable_wheels()
     for( auto &wheel : wheels ) {
         parts[ wheel.first ].id = wheel.second;
     }
+    feature_parts_count = -1;
 }
 
 void vehicle::init_state( int init_veh_fuel, int init_veh_status )
@@ -2028,6 +2038,7 @@ bool vehicle::remove_part( const int p, RemovePartHandler &handler )
 
     remove_dependent_part( "SEAT", "SEATBELT" );
     remove_dependent_part( "BATTERY_MOUNT", "NEEDS_BATTERY_MOUNT" );
+    handler.set_pathfinding_cache_dirty( part_loc );
 
     // Release any animal held by the part
     if( parts[p].has_flag( vehicle_part::animal_flag ) ) {
@@ -2124,8 +2135,10 @@ void vehicle::part_removal_cleanup()
             here.add_vehicle_to_cache( this );
         }
     }
-    shift_if_needed();
-    refresh(); // Rebuild cached indices
+    // Shifting refreshes on its own, and if parts were erased the indices were already rebuilt
+    if( !shift_if_needed() && !changed ) {
+        refresh(); // Rebuild cached indices
+    }
     coeff_air_dirty = coeff_air_changed;
     coeff_air_changed = false;
 }
@@ -2698,6 +2711,17 @@ int vehicle::part_with_feature( point pt, const std::string &flag, bool unbroken
     return -1;
 }
 
+int vehicle::part_with_feature( point pt, vpart_bitflags const flag, bool unbroken ) const
+{
+    std::vector<int> parts_here = parts_at_relative( pt, false );
+    for( auto &elem : parts_here ) {
+        if( part_flag( elem, flag ) && ( !unbroken || !parts[ elem ].is_broken() ) ) {
+            return elem;
+        }
+    }
+    return -1;
+}
+
 int vehicle::avail_part_with_feature( int part, vpart_bitflags const flag, bool unbroken ) const
 {
     int part_a = part_with_feature( part, flag, unbroken );
@@ -2724,8 +2748,10 @@ int vehicle::avail_part_with_feature( point pt, const std::string &flag,
 
 bool vehicle::has_part( const std::string &flag, bool enabled ) const
 {
-    return std::any_of( parts.begin(), parts.end(), [&flag, &enabled]( const vehicle_part & e ) {
-        return !e.removed && ( !enabled || e.enabled ) && !e.is_broken() && e.info().has_flag( flag );
+    const std::vector<int> &candidates = parts_with_type_feature( flag );
+    return std::any_of( candidates.begin(), candidates.end(), [this, &enabled]( int p ) {
+        const vehicle_part &e = parts[p];
+        return !e.removed && ( !enabled || e.enabled ) && !e.is_broken();
     } );
 }
 
@@ -2733,11 +2759,12 @@ bool vehicle::has_part( const tripoint &pos, const std::string &flag, bool enabl
 {
     const tripoint relative_pos = pos - global_pos3();
 
-    for( const auto &e : parts ) {
+    for( int p : parts_with_type_feature( flag ) ) {
+        const vehicle_part &e = parts[p];
         if( e.precalc[0] != relative_pos ) {
             continue;
         }
-        if( !e.removed && ( !enabled || e.enabled ) && !e.is_broken() && e.info().has_flag( flag ) ) {
+        if( !e.removed && ( !enabled || e.enabled ) && !e.is_broken() ) {
             return true;
         }
     }
@@ -2937,6 +2964,48 @@ vehicle_part_with_feature_range<vpart_bitflags> vehicle::get_enabled_parts(
               part_status_flag::available ) );
 }
 
+void vehicle::drop_feature_parts_if_stale() const
+{
+    if( feature_parts_count != part_count() ) {
+        feature_parts.clear();
+        bitflag_parts.clear();
+        location_parts.clear();
+        feature_parts_count = part_count();
+    }
+}
+
+const std::vector<int> &vehicle::parts_with_type_feature( const std::string &feature ) const
+{
+    drop_feature_parts_if_stale();
+    const auto found = feature_parts.find( feature );
+    if( found != feature_parts.end() ) {
+        return found->second;
+    }
+    std::vector<int> &ret = feature_parts[feature];
+    for( int p = 0; p < part_count(); p++ ) {
+        if( parts[p].info().has_flag( feature ) ) {
+            ret.push_back( p );
+        }
+    }
+    return ret;
+}
+
+const std::vector<int> &vehicle::parts_with_type_feature( const vpart_bitflags f ) const
+{
+    drop_feature_parts_if_stale();
+    const auto found = bitflag_parts.find( f );
+    if( found != bitflag_parts.end() ) {
+        return found->second;
+    }
+    std::vector<int> &ret = bitflag_parts[f];
+    for( int p = 0; p < part_count(); p++ ) {
+        if( parts[p].info().has_flag( f ) ) {
+            ret.push_back( p );
+        }
+    }
+    return ret;
+}
+
 /**
  * Returns all parts in the vehicle that exist in the given location slot. If
  * the empty string is passed in, returns all parts with no slot.
@@ -2945,10 +3014,22 @@ vehicle_part_with_feature_range<vpart_bitflags> vehicle::get_enabled_parts(
  */
 std::vector<int> vehicle::all_parts_at_location( const std::string &location ) const
 {
+    drop_feature_parts_if_stale();
+    auto found = location_parts.find( location );
+    if( found == location_parts.end() ) {
+        std::vector<int> &at_location = location_parts[location];
+        for( int p = 0; p < part_count(); p++ ) {
+            if( parts[p].info().location == location ) {
+                at_location.push_back( p );
+            }
+        }
+        found = location_parts.find( location );
+    }
     std::vector<int> parts_found;
-    for( size_t part_index = 0; part_index < parts.size(); ++part_index ) {
-        if( part_info( part_index ).location == location && !parts[part_index].removed ) {
-            parts_found.push_back( part_index );
+    parts_found.reserve( found->second.size() );
+    for( int p : found->second ) {
+        if( !parts[p].removed ) {
+            parts_found.push_back( p );
         }
     }
     return parts_found;
@@ -3562,7 +3643,7 @@ int vehicle::fuel_left( const itype_id &ftype, bool recurse ) const
         }
         // As do any other engine flagged as perpetual
         //TODO!: push up
-    } else if( item::spawn_temporary( ftype )->has_flag( flag_PERPETUAL ) ) {
+    } else if( ftype->has_flag( flag_PERPETUAL ) ) {
         fl += 10;
     }
 
@@ -4157,6 +4238,7 @@ double vehicle::coeff_air_drag() const
     if( !coeff_air_dirty ) {
         return coefficient_air_resistance;
     }
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::drag );
     constexpr double c_air_base = 0.25;
     constexpr double c_air_mod = 0.1;
     constexpr double base_height = 1.4;
@@ -4176,16 +4258,16 @@ double vehicle::coeff_air_drag() const
         if( p.info().location != part_location_center ) {
             return false;
         }
-        return !( p.inside || p.info().has_flag( "NO_ROOF_NEEDED" ) ||
-                  p.info().has_flag( "WINDSHIELD" ) ||
-                  p.info().has_flag( "OPENABLE" ) );
+        return !( p.inside || p.info().has_flag( VPFLAG_NO_ROOF_NEEDED ) ||
+                  p.info().has_flag( VPFLAG_WINDSHIELD ) ||
+                  p.info().has_flag( VPFLAG_OPENABLE ) );
     };
 
     const auto d_protrusion = [&]( std::vector<int> parts_at ) {
         if( parts_at.size() > 1 ) {
             return false;
         } else {
-            return parts[ parts_at.front() ].info().has_flag( "PROTRUSION" );
+            return parts[ parts_at.front() ].info().has_flag( VPFLAG_PROTRUSION );
         }
     };
     const auto d_check_min = [&]( int &value, const vehicle_part & p, bool test ) {
@@ -4208,23 +4290,23 @@ double vehicle::coeff_air_drag() const
         d_check_min( drag[ col ].pro, parts[ p ], d_protrusion( parts_at ) );
         for( int pa_index : parts_at ) {
             const vehicle_part &pa = parts[ pa_index ];
-            d_check_max( drag[ col ].hboard, pa, pa.info().has_flag( "HALF_BOARD" ) );
-            d_check_max( drag[ col ].fboard, pa, pa.info().has_flag( "FULL_BOARD" ) );
-            d_check_max( drag[ col ].aisle, pa, pa.info().has_flag( "AISLE" ) );
-            d_check_max( drag[ col ].shield, pa, pa.info().has_flag( "WINDSHIELD" ) &&
+            d_check_max( drag[ col ].hboard, pa, pa.info().has_flag( VPFLAG_HALF_BOARD ) );
+            d_check_max( drag[ col ].fboard, pa, pa.info().has_flag( VPFLAG_FULL_BOARD ) );
+            d_check_max( drag[ col ].aisle, pa, pa.info().has_flag( VPFLAG_AISLE ) );
+            d_check_max( drag[ col ].shield, pa, pa.info().has_flag( VPFLAG_WINDSHIELD ) &&
                          pa.is_available() );
-            d_check_max( drag[ col ].seat, pa, pa.info().has_flag( "SEAT" ) ||
-                         pa.info().has_flag( "BED" ) );
+            d_check_max( drag[ col ].seat, pa, pa.info().has_flag( VPFLAG_SEAT ) ||
+                         pa.info().has_flag( VPFLAG_BED ) );
             d_check_max( drag[ col ].turret, pa, pa.info().location == part_location_onroof &&
-                         !pa.info().has_flag( "SOLAR_PANEL" ) );
-            d_check_max( drag[ col ].roof, pa, pa.info().has_flag( "ROOF" ) );
-            d_check_max( drag[ col ].panel, pa, pa.info().has_flag( "SOLAR_PANEL" ) );
-            d_check_max( drag[ col ].windmill, pa, pa.info().has_flag( "WIND_TURBINE" ) );
-            d_check_max( drag[ col ].rotor, pa, pa.info().has_flag( "ROTOR" ) );
-            d_check_max( drag[ col ].sail, pa, pa.info().has_flag( "WIND_POWERED" ) );
+                         !pa.info().has_flag( VPFLAG_SOLAR_PANEL ) );
+            d_check_max( drag[ col ].roof, pa, pa.info().has_flag( VPFLAG_ROOF ) );
+            d_check_max( drag[ col ].panel, pa, pa.info().has_flag( VPFLAG_SOLAR_PANEL ) );
+            d_check_max( drag[ col ].windmill, pa, pa.info().has_flag( VPFLAG_WIND_TURBINE ) );
+            d_check_max( drag[ col ].rotor, pa, pa.info().has_flag( VPFLAG_ROTOR ) );
+            d_check_max( drag[ col ].sail, pa, pa.info().has_flag( VPFLAG_WIND_POWERED ) );
             d_check_max( drag[ col ].exposed, pa, d_exposed( pa ) );
-            d_check_min( drag[ col ].last, pa, pa.info().has_flag( "LOW_FINAL_AIR_DRAG" ) ||
-                         pa.info().has_flag( "HALF_BOARD" ) );
+            d_check_min( drag[ col ].last, pa, pa.info().has_flag( VPFLAG_LOW_FINAL_AIR_DRAG ) ||
+                         pa.info().has_flag( VPFLAG_HALF_BOARD ) );
         }
     }
     double height = 0;
@@ -4296,29 +4378,39 @@ double vehicle::coeff_rolling_drag() const
     if( !coeff_rolling_dirty ) {
         return coefficient_rolling_resistance;
     }
-    constexpr double wheel_ratio = 1.25;
-    constexpr double base_wheels = 4.0;
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::drag );
     // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
     // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
     // and N is mass * accel from gravity (aka weight)
     constexpr double sae_ratio = 0.000225;
     constexpr double newton_ratio = GRAVITY_OF_EARTH * sae_ratio;
-    double wheel_factor = 0;
+    if( drag_profile_dirty ) {
+        refresh_drag_profile();
+    }
+    coefficient_rolling_resistance = newton_ratio * wheel_drag_factor * to_kilogram( total_mass() );
+    coeff_rolling_dirty = false;
+    return coefficient_rolling_resistance;
+}
+
+void vehicle::refresh_drag_profile() const
+{
+    constexpr double wheel_ratio = 1.25;
+    constexpr double base_wheels = 4.0;
+    wheel_drag_factor = 0;
     if( wheelcache.empty() ) {
-        wheel_factor = 50;
+        wheel_drag_factor = 50;
     } else {
         // should really sum the each wheel's c_rolling_resistance * it's share of vehicle mass
         for( auto wheel : wheelcache ) {
-            wheel_factor += parts[ wheel ].info().wheel_rolling_resistance();
+            wheel_drag_factor += parts[ wheel ].info().wheel_rolling_resistance();
         }
         // mildly increasing rolling resistance for vehicles with more than 4 wheels and mildly
         // decrease it for vehicles with less
-        wheel_factor *= wheel_ratio /
-                        ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
+        wheel_drag_factor *= wheel_ratio /
+                             ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
     }
-    coefficient_rolling_resistance = newton_ratio * wheel_factor * to_kilogram( total_mass() );
-    coeff_rolling_dirty = false;
-    return coefficient_rolling_resistance;
+    structure_part_count = all_parts_at_location( part_location_structure ).size();
+    drag_profile_dirty = false;
 }
 
 double vehicle::water_hull_height() const
@@ -4417,15 +4509,18 @@ double vehicle::coeff_water_drag() const
     if( !coeff_water_dirty ) {
         return coefficient_water_resistance;
     }
-    std::vector<int> structure_indices = all_parts_at_location( part_location_structure );
-    if( structure_indices.empty() ) {
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::drag );
+    if( drag_profile_dirty ) {
+        refresh_drag_profile();
+    }
+    if( structure_part_count == 0 ) {
         // huh?
         coeff_water_dirty = false;
         hull_height = 0.3;
         draft_m = 1.0;
         return 1250.0;
     }
-    double hull_coverage = static_cast<double>( floating.size() ) / structure_indices.size();
+    double hull_coverage = static_cast<double>( floating.size() ) / structure_part_count;
 
     int tile_width = mount_max.y - mount_min.y + 1;
     double width_m = tile_to_width( tile_width );
@@ -4438,7 +4533,7 @@ double vehicle::coeff_water_drag() const
     // actual area in m = # of structure tiles * length in tiles * width in meters /
     //                    ( length in tiles * width in tiles )
     // actual area in m = # of structure tiles * width in meters / width in tiles
-    double actual_area_m = width_m * structure_indices.size() / tile_width;
+    double actual_area_m = width_m * structure_part_count / tile_width;
 
     // effective hull area is actual hull area * hull coverage
     hull_area = actual_area_m * std::max( 0.1, hull_coverage );
@@ -4985,14 +5080,17 @@ void vehicle::update_alternator_load()
 
 void vehicle::power_parts()
 {
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::power );
     update_alternator_load();
     // Things that drain energy: engines and accessories.
     int engine_epower = total_engine_epower_w();
     int epower = engine_epower + total_accessory_epower_w() + total_alternator_epower_w();
 
     int delta_energy_bat = power_to_energy_bat( epower, 1_turns );
-    int storage_deficit_bat = std::max( 0, fuel_capacity( fuel_type_battery ) -
-                                        fuel_left( fuel_type_battery ) - delta_energy_bat );
+    // Counting the stored energy walks the whole power network, so only do it for reactors
+    const int storage_deficit_bat = reactors.empty() ? 0 :
+                                    std::max( 0, fuel_capacity( fuel_type_battery ) -
+                                              fuel_left( fuel_type_battery ) - delta_energy_bat );
     // Reactors trigger only on demand. If we'd otherwise run out of power, see
     // if we can spin up the reactors.
     if( !reactors.empty() && storage_deficit_bat > 0 ) {
@@ -5856,9 +5954,12 @@ void vehicle::enable_refresh()
  */
 void vehicle::refresh()
 {
+    feature_parts_count = -1;
+    drag_profile_dirty = true;
     if( no_refresh ) {
         return;
     }
+    const vehicle_turn_stats::phase_timer timer( vehicle_phase::refresh );
 
     alternators.clear();
     engines.clear();
@@ -5940,22 +6041,22 @@ void vehicle::refresh()
         if( vpi.has_flag( VPFLAG_ROTOR ) ) {
             rotors.push_back( p );
         }
-        if( vpi.has_flag( "WIND_TURBINE" ) ) {
+        if( vpi.has_flag( VPFLAG_WIND_TURBINE ) ) {
             wind_turbines.push_back( p );
         }
-        if( vpi.has_flag( "WIND_POWERED" ) ) {
+        if( vpi.has_flag( VPFLAG_WIND_POWERED ) ) {
             sails.push_back( p );
         }
-        if( vpi.has_flag( "WATER_WHEEL" ) ) {
+        if( vpi.has_flag( VPFLAG_WATER_WHEEL ) ) {
             water_wheels.push_back( p );
         }
-        if( vpi.has_flag( "FUNNEL" ) ) {
+        if( vpi.has_flag( VPFLAG_FUNNEL ) ) {
             funnels.push_back( p );
         }
-        if( vpi.has_flag( "UNMOUNT_ON_MOVE" ) ) {
+        if( vpi.has_flag( VPFLAG_UNMOUNT_ON_MOVE ) ) {
             loose_parts.push_back( p );
         }
-        if( vpi.has_flag( "EMITTER" ) ) {
+        if( vpi.has_flag( VPFLAG_EMITTER ) ) {
             emitters.push_back( p );
         }
         if( vpi.has_flag( VPFLAG_WHEEL ) ) {
@@ -5970,29 +6071,29 @@ void vehicle::refresh()
                 rail_profile.push_back( rail_pos );
             }
         }
-        if( ( vpi.has_flag( "STEERABLE" ) && part_with_feature( pt, "STEERABLE", true ) != -1 ) ||
-            vpi.has_flag( "TRACKED" ) ) {
+        if( ( vpi.has_flag( VPFLAG_STEERABLE ) && part_with_feature( pt, VPFLAG_STEERABLE, true ) != -1 ) ||
+            vpi.has_flag( VPFLAG_TRACKED ) ) {
             // TRACKED contributes to steering effectiveness but
             //  (a) doesn't count as a steering axle for install difficulty
             //  (b) still contributes to drag for the center of steering calculation
             steering.push_back( p );
         }
-        if( vpi.has_flag( "SECURITY" ) ) {
+        if( vpi.has_flag( VPFLAG_SECURITY ) ) {
             speciality.push_back( p );
         }
-        if( vp.part().enabled && vpi.has_flag( "EXTRA_DRAG" ) ) {
+        if( vp.part().enabled && vpi.has_flag( VPFLAG_EXTRA_DRAG ) ) {
             extra_drag += vpi.power;
         }
-        if( vpi.has_flag( "EXTRA_DRAG" ) && ( vpi.has_flag( "WIND_TURBINE" ) ||
-                                              vpi.has_flag( "WATER_WHEEL" ) ) ) {
+        if( vpi.has_flag( VPFLAG_EXTRA_DRAG ) && ( vpi.has_flag( VPFLAG_WIND_TURBINE ) ||
+                                              vpi.has_flag( VPFLAG_WATER_WHEEL ) ) ) {
             extra_drag += vpi.power;
         }
-        if( camera_on && vpi.has_flag( "CAMERA" ) ) {
+        if( camera_on && vpi.has_flag( VPFLAG_CAMERA ) ) {
             vp.part().enabled = true;
-        } else if( !camera_on && vpi.has_flag( "CAMERA" ) ) {
+        } else if( !camera_on && vpi.has_flag( VPFLAG_CAMERA ) ) {
             vp.part().enabled = false;
         }
-        if( vpi.has_flag( "TURRET" ) && !has_part( global_part_pos3( vp.part() ), "TURRET_CONTROLS" ) ) {
+        if( vpi.has_flag( VPFLAG_TURRET ) && !has_part( global_part_pos3( vp.part() ), "TURRET_CONTROLS" ) ) {
             vp.part().enabled = false;
         }
     }
@@ -6856,6 +6957,8 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
 
     dmg -= std::min<int>( dmg, part_info( p ).damage_reduction.type_resist( type ) );
     int dres = dmg - parts[p].hp();
+    // Whether a part can be bashed through depends on its hp
+    here.set_pathfinding_cache_dirty( global_part_pos3( p ) );
     if( mod_hp( parts[ p ], 0 - dmg, type ) ) {
         insides_dirty = true;
         pivot_dirty = true;
@@ -7374,6 +7477,28 @@ bool vehicle_part_with_feature_range<vpart_bitflags>::matches( const size_t part
            ( !( part_status_flag::enabled & required_ ) || vp.enabled );
 }
 
+static size_t next_part_in( const std::vector<int> &candidates, const size_t part,
+                            const size_t part_count )
+{
+    const auto found = std::lower_bound( candidates.begin(), candidates.end(),
+                                         static_cast<int>( part ) );
+    return found == candidates.end() ? part_count : static_cast<size_t>( *found );
+}
+
+template<>
+size_t vehicle_part_with_feature_range<std::string>::next_candidate( const size_t part ) const
+{
+    return next_part_in( this->vehicle().parts_with_type_feature( feature_ ), part,
+                         this->part_count() );
+}
+
+template<>
+size_t vehicle_part_with_feature_range<vpart_bitflags>::next_candidate( const size_t part ) const
+{
+    return next_part_in( this->vehicle().parts_with_type_feature( feature_ ), part,
+                         this->part_count() );
+}
+
 bool vehicle::is_loaded() const
 {
     return attached && get_map().inbounds( global_pos3() );
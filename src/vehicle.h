@@ -723,6 +723,15 @@ class vehicle
         vehicle_part_with_feature_range<std::string> get_enabled_parts( std::string feature ) const;
         vehicle_part_with_feature_range<vpart_bitflags> get_enabled_parts( vpart_bitflags f ) const;
         /**@}*/
+        /**
+         * Indices of the parts whose type has the given feature, in order and whatever
+         * their state. The ranges above only look at these. Kept until the next
+         * @ref refresh or change in the number of parts.
+         */
+        /**@{*/
+        const std::vector<int> &parts_with_type_feature( const std::string &feature ) const;
+        const std::vector<int> &parts_with_type_feature( vpart_bitflags f ) const;
+        /**@}*/
 
         // returns the list of indices of parts at certain position (not accounting frame direction)
         std::vector<int> parts_at_relative( point dp, bool use_cache ) const;
@@ -731,6 +740,7 @@ class vehicle
         int part_with_feature( int p, const std::string &f, bool unbroken ) const;
         int part_with_feature( point pt, const std::string &f, bool unbroken ) const;
         int part_with_feature( int p, vpart_bitflags f, bool unbroken ) const;
+        int part_with_feature( point pt, vpart_bitflags f, bool unbroken ) const;
 
         // returns index of part, inner to given, with certain flag, or -1
         int avail_part_with_feature( int p, const std::string &f, bool unbroken ) const;
@@ -1544,6 +1554,9 @@ class vehicle
         mutable double draft_m = 1;
         mutable double hull_height = 0.3;
         mutable double hull_area = 0; // total area of hull in m^2
+        // Parts of the rolling and water drag that don't change with the vehicle's mass
+        mutable double wheel_drag_factor = 0;
+        mutable size_t structure_part_count = 0;
 
         // Cached points occupied by the vehicle
         std::set<tripoint> occupied_points;
@@ -1711,6 +1724,15 @@ class vehicle
     private:
         bool no_refresh = false;
 
+        // See parts_with_type_feature, built for each feature when first asked for
+        mutable std::map<std::string, std::vector<int>> feature_parts;
+        mutable std::map<int, std::vector<int>> bitflag_parts;
+        // Same for the parts in each location slot, see all_parts_at_location
+        mutable std::map<std::string, std::vector<int>> location_parts;
+        // Number of parts when the above were built, -1 when they need to be dropped
+        mutable int feature_parts_count = -1;
+        void drop_feature_parts_if_stale() const;
+
         // if true, pivot_cache needs to be recalculated
         mutable bool pivot_dirty = true;
         mutable bool mass_dirty = true;
@@ -1720,6 +1742,9 @@ class vehicle
         mutable bool coeff_rolling_dirty = true;
         mutable bool coeff_air_dirty = true;
         mutable bool coeff_water_dirty = true;
+        // set by refresh, as changes to mass alone leave the wheels and hull shape as they were
+        mutable bool drag_profile_dirty = true;
+        void refresh_drag_profile() const;
         // air uses a two stage dirty check: one dirty bit gets set on part install,
         // removal, or breakage. The other dirty bit only gets set during part_removal_cleanup,
         // and that's the bit that controls recalculation.  The intent is to only recalculate
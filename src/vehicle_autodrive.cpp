@@ -29,7 +29,9 @@
 #include "mapdata.h"
 #include "messages.h"
 #include "options.h"
+#include "pathfinding_stats.h"
 #include "point.h"
+#include "profile.h"
 #include "tileray.h"
 #include "translations.h"
 #include "type_id.h"
@@ -282,6 +284,9 @@ struct auto_navigation_data {
     int max_steer;
 
     std::array<vehicle_profile, NUM_ORIENTATIONS> profiles;
+    // what the profiles were computed from: the pivot, then the mount of each part and rotor;
+    // they only need recomputing when the vehicle's footprint changes
+    std::vector<point> profiles_footprint;
     // known obstacles on the view map
     bool is_obstacle[NAV_VIEW_SIZE_X][NAV_VIEW_SIZE_Y];
     // where on the nav map the vehicle pivot may be placed
@@ -296,6 +301,7 @@ struct auto_navigation_data {
 
     void clear() {
         current_omt = { 0, 0, -100 };
+        profiles_footprint.clear();
         path.clear();
     }
     vehicle_profile &profile( orientation dir ) {
@@ -346,6 +352,7 @@ class vehicle::autodrive_controller
         bool check_drivable( tripoint pt ) const;
         void compute_obstacles();
         vehicle_profile compute_profile( orientation facing ) const;
+        std::vector<point> compute_footprint() const;
         void compute_valid_positions();
         void compute_goal_zone();
         void precompute_data();
@@ -636,6 +643,25 @@ vehicle_profile vehicle::autodrive_controller::compute_profile( orientation faci
 }
 
 
+std::vector<point> vehicle::autodrive_controller::compute_footprint() const
+{
+    std::vector<point> ret;
+    ret.reserve( driven_veh.parts.size() + 2 * driven_veh.rotors.size() + 1 );
+    ret.emplace_back( driven_veh.pivot_point() );
+    for( const vehicle_part &part : driven_veh.parts ) {
+        if( !part.removed ) {
+            ret.emplace_back( part.mount );
+        }
+    }
+    for( int part_num : driven_veh.rotors ) {
+        const vehicle_part &part = driven_veh.cpart( part_num );
+        // the diameter goes in as a point too, so a changed rotor is noticed
+        ret.emplace_back( part.mount );
+        ret.emplace_back( part.info().rotor_diameter(), 0 );
+    }
+    return ret;
+}
+
 // Return true if the map tile at the given position (in map coordinates)
 // can be driven on (not an obstacle).
 // The logic should match what is in vehicle::part_collision().
@@ -744,15 +770,21 @@ void vehicle::autodrive_controller::compute_obstacles()
 void vehicle::autodrive_controller::compute_valid_positions()
 {
     const coord_transformation veh_rot = {point_zero, -data.nav_to_map.rotation, point_zero};
+    std::vector<point> offsets;
     for( orientation facing : all_orientations() ) {
         const vehicle_profile &profile = data.profile( data.nav_to_map.transform( facing ) );
+        // the rotated vehicle points don't depend on where on the nav map they are
+        offsets.clear();
+        for( point veh_pt : profile.occupied_zone ) {
+            offsets.emplace_back( veh_rot.transform( veh_pt ) - veh_rot.transform( point_zero ) );
+        }
         for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
             for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
                 const point nav_pt( mx, my );
+                const point view_origin = data.nav_to_view.transform( nav_pt );
                 bool valid = true;
-                for( point veh_pt : profile.occupied_zone ) {
-                    const point view_pt = data.nav_to_view.transform( nav_pt ) + veh_rot.transform(
-                                              veh_pt ) - veh_rot.transform( point_zero );
+                for( point offset : offsets ) {
+                    const point view_pt = view_origin + offset;
                     if( !data.view_bounds.contains( view_pt ) || data.is_obstacle[view_pt.x][view_pt.y] ) {
                         valid = false;
                         break;
@@ -824,8 +856,12 @@ void vehicle::autodrive_controller::precompute_data()
         // TODO: change it during simulation based on vehicle speed and terrain
         // or maybe just keep track of player moves?
         data.max_steer = 1;
-        for( orientation dir : all_orientations() ) {
-            data.profile( dir ) = compute_profile( dir );
+        std::vector<point> footprint = compute_footprint();
+        if( footprint != data.profiles_footprint ) {
+            for( orientation dir : all_orientations() ) {
+                data.profile( dir ) = compute_profile( dir );
+            }
+            data.profiles_footprint = std::move( footprint );
         }
 
         // initialize navigation data
@@ -952,6 +988,9 @@ std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compu
     if( speed_tps == 0 || speed_tps < -1 ) {
         return std::nullopt;
     }
+    ZoneScoped;
+    const pathfinding_stats::caller_scope tag( route_caller::vehicle );
+    const pathfinding_stats::search_timer timer( route_scale::map );
     // TODO: tweak this
     constexpr size_t max_search_count = 10000;
     std::vector<navigation_step> ret;
@@ -968,6 +1007,7 @@ std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compu
     while( !open_set.empty() ) {
         const node_address cur_addr = open_set.top().addr;
         open_set.pop();
+        pathfinding_stats::count_expanded();
         const navigation_node &cur_node = known_nodes[cur_addr];
         if( cur_node.is_goal ) {
             node_address addr = cur_addr;
@@ -32,6 +32,7 @@
 #include "options.h"
 #include "player.h"
 #include "point_float.h"
+#include "profile.h"
 #include "rng.h"
 #include "sounds.h"
 #include "string_id.h"
@@ -475,13 +476,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
-    Character &player_character = get_player_character();
-    const bool pl_ctrl = player_in_control( player_character );
     Creature *critter = g->critter_at( p, true );
     player *ph = dynamic_cast<player *>( critter );
 
-    Creature *driver = pl_ctrl ? &player_character : nullptr;
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -526,7 +523,7 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
             return ret;
         }
         // we just ran into a fish, so move it out of the way
-        if( here.has_flag( "SWIMMABLE", critter->pos() ) ) {
+        if( here.has_flag( TFLAG_SWIMMABLE, critter->pos() ) ) {
             tripoint end_pos = critter->pos();
             tripoint start_pos;
             const units::angle angle =
@@ -600,6 +597,10 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         // Hit nothing or we aren't actually hitting
         return ret;
     }
+    // Only worked out for actual hits, every structural part is checked each move
+    Character &player_character = get_player_character();
+    const bool pl_ctrl = player_in_control( player_character );
+    Creature *driver = pl_ctrl ? &player_character : nullptr;
     stop_autodriving();
     // Calculate mass AFTER checking for collision
     //  because it involves iterating over all cargo
@@ -1264,6 +1265,7 @@ float get_collision_factor( const float delta_v )
 
 vehicle *vehicle::act_on_map()
 {
+    ZoneScoped;
     const tripoint pt = global_pos3();
     map &here = get_map();
     if( !here.inbounds( pt ) ) {
@@ -1289,6 +1291,7 @@ vehicle *vehicle::act_on_map()
         }
 
         here.on_vehicle_moved( sm_pos.z );
+        here.set_pathfinding_cache_dirty( sm_pos.z );
         // Destroy vehicle (sank to nowhere)
         here.destroy_vehicle( this );
         return nullptr;
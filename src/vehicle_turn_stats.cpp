@@ -0,0 +1,23 @@
+#include "vehicle_turn_stats.h"
+
+namespace vehicle_turn_stats
+{
+
+const char *phase_name( vehicle_phase phase )
+{
+    switch( phase ) {
+        case vehicle_phase::move:
+            return "vehmove";
+        case vehicle_phase::refresh:
+            return "refresh";
+        case vehicle_phase::drag:
+            return "drag";
+        case vehicle_phase::power:
+            return "power";
+        case vehicle_phase::num_vehicle_phases:
+            break;
+    }
+    return "invalid";
+}
+
+} // namespace vehicle_turn_stats
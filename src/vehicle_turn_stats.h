@@ -0,0 +1,62 @@
+#pragma once
+#ifndef CATA_SRC_VEHICLE_TURN_STATS_H
+#define CATA_SRC_VEHICLE_TURN_STATS_H
+
+#include <cstdint>
+#include <string>
+
+#include "phase_stats.h"
+
+/** The parts of the vehicles' turns that are timed separately. */
+enum class vehicle_phase : int {
+    /** Moving all the vehicles on the map, @ref map::vehmove, which includes their collisions. */
+    move,
+    /** Rebuilding the cached part lists of a vehicle, @ref vehicle::refresh. */
+    refresh,
+    /** Recalculating the air, rolling and water drag coefficients when they are dirty. */
+    drag,
+    /** Balancing what the parts produce and consume, @ref vehicle::power_parts. */
+    power,
+    num_vehicle_phases
+};
+
+/**
+ * Wall time spent in each phase of the vehicles' turns. Phases are timed on their own,
+ * so time spent refreshing during a move counts towards both.
+ */
+namespace vehicle_turn_stats
+{
+
+const char *phase_name( vehicle_phase phase );
+
+using stats = phase_stats::per_phase<vehicle_phase, vehicle_phase::num_vehicle_phases,
+      phase_name>;
+/**
+ * Adds the time from its creation to its end to `phase`.
+ * Timers of a phase started on the same thread while it is timed count as part of that one.
+ */
+using phase_timer = stats::timer;
+
+/** How many times the phase was timed since the last reset. */
+inline std::uint64_t count( vehicle_phase phase )
+{
+    return stats::count( phase );
+}
+inline std::uint64_t microseconds( vehicle_phase phase )
+{
+    return stats::microseconds( phase );
+}
+
+inline void reset()
+{
+    stats::reset();
+}
+/** One line for each phase that was timed since the last reset. */
+inline std::string report()
+{
+    return stats::report();
+}
+
+} // namespace vehicle_turn_stats
+
+#endif // CATA_SRC_VEHICLE_TURN_STATS_H
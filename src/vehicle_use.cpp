@@ -1495,7 +1495,7 @@ void vehicle::operate_scoop()
             }
             item *that_item_there = nullptr;
             map_stack items = g->m.i_at( position );
-            if( g->m.has_flag( "SEALED", position ) ) {
+            if( g->m.has_flag( TFLAG_SEALED, position ) ) {
                 // Ignore it. Street sweepers are not known for their ability to harvest crops.
                 continue;
             }
@@ -1637,9 +1637,12 @@ void vehicle::open_or_close( const int part_index, const bool opening )
         sfx::play_variant_sound( opening ? "vehicle_open" : "vehicle_close",
                                  parts[ part_index ].info().get_id().str(), 100 - dist * 3 );
     }
+    // Routes remembered through closed doors are no good any more, and the other way round
+    here.set_pathfinding_cache_dirty( part_location );
     for( auto const &vec : find_lines_of_parts( part_index, "OPENABLE" ) ) {
         for( auto const &partID : vec ) {
             parts[partID].open = opening;
+            here.set_pathfinding_cache_dirty( global_part_pos3( partID ) );
         }
     }
 
@@ -1963,7 +1966,7 @@ void vehicle::interact_with( const tripoint &pos, int interact_part )
     std::vector<std::string> menu_items;
     std::vector<uilist_entry> options_message;
     const bool has_items_on_ground = here.sees_some_items( pos, g->u );
-    const bool items_are_sealed = here.has_flag( "SEALED", pos );
+    const bool items_are_sealed = here.has_flag( TFLAG_SEALED, pos );
 
     auto turret = turret_query( pos );
 
@@ -0,0 +1,2 @@
+// NOLINT(cata-header-guard)
+#define VERSION "dd66b0d"
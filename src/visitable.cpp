@@ -145,6 +145,54 @@ static T sum_no_wrap( T a, T b )
     return a + b;
 }
 
+static VisitResponse visit_internal( const std::function<VisitResponse( item *, item * )> &func,
+                                     item *node, item *parent );
+
+/**
+ * Visits what a character carries in the same order as its visit_items, except that stacks
+ * in its inventory of empty items for which @ref passes_over holds are passed over whole,
+ * instead of calling the visitor on every item in them.
+ */
+class character_query_view
+{
+    public:
+        character_query_view( const Character &ch, const location_inventory &inv,
+                              const std::function<bool( const item & )> &passes_over ) :
+            ch( ch ), inv( inv ), passes_over( passes_over ) {}
+
+        VisitResponse visit_items( const std::function<VisitResponse( const item * )> &func ) const {
+            const auto visit = [&func]( item * node, item * ) {
+                return func( node );
+            };
+            if( !ch.primary_weapon().is_null() &&
+                visit_internal( visit, &ch.primary_weapon(), nullptr ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+            for( item *e : ch.worn ) {
+                if( visit_internal( visit, e, nullptr ) == VisitResponse::ABORT ) {
+                    return VisitResponse::ABORT;
+                }
+            }
+            for( const std::vector<item *> *stack : inv.const_slice() ) {
+                const item &front = *stack->front();
+                if( front.contents.empty() && passes_over( front ) ) {
+                    continue;
+                }
+                for( item *e : *stack ) {
+                    if( visit_internal( visit, e, nullptr ) == VisitResponse::ABORT ) {
+                        return VisitResponse::ABORT;
+                    }
+                }
+            }
+            return VisitResponse::NEXT;
+        }
+
+    private:
+        const Character &ch;
+        const location_inventory &inv;
+        std::function<bool( const item & )> passes_over;
+};
+
 template <typename T>
 static int has_quality_internal( const T &self, const quality_id &qual, int level, int limit )
 {
@@ -271,7 +319,13 @@ bool visitable<Character>::has_quality( const quality_id &qual, int level, int q
         }
     }
 
-    return qty <= 0 ? true : has_quality_internal( *this, qual, level, qty ) == qty;
+    if( qty <= 0 ) {
+        return true;
+    }
+    const character_query_view view( *self, self->inv, [&qual, level]( const item & e ) {
+        return e.get_quality( qual ) < level;
+    } );
+    return has_quality_internal( view, qual, level, qty ) == qty;
 }
 
 template <typename T>
@@ -527,7 +581,7 @@ VisitResponse visitable<map_cursor>::visit_items(
     auto cur = static_cast<map_cursor *>( this );
     map &here = get_map();
     // skip inaccessible items
-    if( here.has_flag( "SEALED", *cur ) && !here.has_flag( "LIQUIDCONT", *cur ) ) {
+    if( here.has_flag( TFLAG_SEALED, *cur ) && !here.has_flag( "LIQUIDCONT", *cur ) ) {
         return VisitResponse::NEXT;
     }
 
@@ -1087,7 +1141,10 @@ int visitable<Character>::charges_of( const itype_id &what, int limit,
         return std::min( qty, limit );
     }
 
-    return charges_of_internal( *this, *this, what, limit, filter, std::move( visitor ) );
+    const character_query_view view( *self, self->inv, [&what]( const item & e ) {
+        return e.typeId() != what;
+    } );
+    return charges_of_internal( view, *this, what, limit, filter, std::move( visitor ) );
 }
 
 template <typename T>
@@ -1178,7 +1235,13 @@ int visitable<Character>::amount_of( const itype_id &what, bool pseudo, int limi
         return std::min( qty, limit );
     }
 
-    return amount_of_internal( *this, what, pseudo, limit, filter );
+    if( what.str() == "any" ) {
+        return amount_of_internal( *this, what, pseudo, limit, filter );
+    }
+    const character_query_view view( *self, self->inv, [&what]( const item & e ) {
+        return e.typeId() != what;
+    } );
+    return amount_of_internal( view, what, pseudo, limit, filter );
 }
 
 /** @relates visitable */
@@ -32,9 +32,10 @@ class vehicle_part_iterator
             return range_.get();
         }
         void skip_to_next_valid( size_t i ) {
+            i = range().next_candidate( i );
             while( i < range().part_count() &&
                    !range().matches( i ) ) {
-                ++i;
+                i = range().next_candidate( i + 1 );
             }
             if( i < range().part_count() ) {
                 vp_.emplace( range().vehicle(), i );
@@ -97,7 +98,8 @@ template<class T> struct iterator_traits<vehicle_part_iterator<T>> {
  * The generic range, it misses the `bool contained(size_t)` function that is
  * required by the iterator class. You need to derive from it and implement
  * that function. It uses the curiously recurring template pattern (CRTP),
- * so use your derived range class as @ref range_type.
+ * so use your derived range class as @ref range_type. A derived range that
+ * knows which parts can match may also hide @ref next_candidate.
  */
 template<typename range_type>
 class generic_vehicle_part_range
@@ -139,6 +141,11 @@ class generic_vehicle_part_range
         ::vehicle &vehicle() const {
             return vehicle_.get();
         }
+
+        /** First part at or after @p part that may match, or part_count() if none can. */
+        size_t next_candidate( size_t part ) const {
+            return part;
+        }
 };
 
 /** A range that contains all parts of the vehicle. */
@@ -167,6 +174,7 @@ class vehicle_part_with_feature_range : public
                     feature_( std::move( f ) ), required_( r ) { }
 
         bool matches( size_t part ) const;
+        size_t next_candidate( size_t part ) const;
 };
 
 #endif // CATA_SRC_VPART_RANGE_H
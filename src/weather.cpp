@@ -967,7 +967,7 @@ double get_local_windpower( double windpower, const oter_id &omter, const tripoi
 
 bool is_wind_blocker( const tripoint &location )
 {
-    return g->m.has_flag( "BLOCK_WIND", location );
+    return g->m.has_flag( TFLAG_BLOCK_WIND, location );
 }
 
 // Description of Wind Speed - https://en.wikipedia.org/wiki/Beaufort_scale
@@ -1078,6 +1078,7 @@ void weather_manager::update_weather()
 
     sfx::do_ambient();
     temperature = w.temperature;
+    clear_temp_cache();
     lightning_active = false;
     // Check weather every few turns, instead of every turn.
     // TODO: predict when the weather changes and use that time.
@@ -1114,7 +1115,9 @@ void weather_manager::set_nextweather( time_point t )
 
 auto weather_manager::get_temperature( const tripoint &location ) const -> units::temperature
 {
-    const auto &cached = temperature_cache.find( location );
+    // By absolute position, the map may shift before the cache is cleared
+    const tripoint abs_location = g->m.getabs( location );
+    const auto &cached = temperature_cache.find( abs_location );
     if( cached != temperature_cache.end() ) {
         return cached->second;
     }
@@ -1132,7 +1135,10 @@ auto weather_manager::get_temperature( const tripoint &location ) const -> units
                            location.z < 0 ? temperatures::annual_average : temperature );
 
     // Hack: adding temperatures between temperatures makes no sense
-    return units::from_celsius( std::round( units::fahrenheit_to_celsius( base_f + added_f ) ) );
+    const units::temperature result = units::from_celsius( std::round( units::fahrenheit_to_celsius(
+                                          base_f + added_f ) ) );
+    temperature_cache.emplace( abs_location, result );
+    return result;
 }
 
 auto weather_manager::get_temperature( const tripoint_abs_omt &location ) const ->
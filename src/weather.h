@@ -203,7 +203,10 @@ class weather_manager
         // The time at which weather will shift next.
         time_point nextweather;
 
-        /** temperature cache, cleared every turn, sparse map of map tripoints to temperatures */
+        /**
+         * temperature cache, cleared every turn and when the weather changes,
+         * sparse map of absolute map square tripoints to temperatures
+         */
         mutable std::unordered_map< tripoint, units::temperature > temperature_cache;
         // Returns outdoor or indoor temperature of given location (in local coords).
         auto get_temperature( const tripoint &location ) const -> units::temperature;
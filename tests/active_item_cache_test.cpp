@@ -1,15 +1,21 @@
 #include "catch/catch.hpp"
 
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
+#include "detached_ptr.h"
 #include "game.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
 #include "point.h"
 #include "state_helpers.h"
+#include "type_id.h"
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
 {
@@ -50,3 +56,76 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active items come up for processing every processing_speed calls", "[item]" )
+{
+    std::vector<detached_ptr<item>> apples;
+    for( int i = 0; i < 100; i++ ) {
+        apples.push_back( item::spawn( itype_id( "apple" ) ) );
+    }
+    detached_ptr<item> rock = item::spawn( itype_id( "rock" ) );
+    const int speed = apples.front()->processing_speed();
+    REQUIRE( speed > 1 );
+    REQUIRE( rock->processing_speed() == 1 );
+
+    active_item_cache cache;
+    CHECK( cache.empty() );
+    for( detached_ptr<item> &apple : apples ) {
+        cache.add( *apple );
+        // Adding twice keeps one reference
+        cache.add( *apple );
+    }
+    cache.add( *rock );
+    CHECK( cache.get().size() == apples.size() + 1 );
+
+    std::map<const item *, int> times_processed;
+    for( int i = 0; i < speed; i++ ) {
+        for( const item *it : cache.get_for_processing() ) {
+            times_processed[it]++;
+        }
+    }
+    CHECK( times_processed[&*rock] == speed );
+    for( const detached_ptr<item> &apple : apples ) {
+        CHECK( times_processed[&*apple] >= 1 );
+    }
+    // Some item comes up on every call
+    CHECK( cache.get_for_processing().size() >= 1 );
+
+    for( detached_ptr<item> &apple : apples ) {
+        cache.remove( &*apple );
+    }
+    CHECK( cache.get().size() == 1 );
+    cache.remove( &*rock );
+    CHECK( cache.empty() );
+}
+
+TEST_CASE( "active items come up in the order they were added", "[item]" )
+{
+    // Which apples come up on a turn only depends on the order they were added in,
+    // not on where they were allocated
+    const auto first_processed = []( std::vector<detached_ptr<item>> &apples ) {
+        active_item_cache cache;
+        for( detached_ptr<item> &apple : apples ) {
+            cache.add( *apple );
+        }
+        std::set<std::size_t> indices;
+        for( const item *it : cache.get_for_processing() ) {
+            for( std::size_t i = 0; i < apples.size(); i++ ) {
+                if( &*apples[i] == it ) {
+                    indices.insert( i );
+                }
+            }
+        }
+        return indices;
+    };
+    std::vector<detached_ptr<item>> apples;
+    std::vector<detached_ptr<item>> more_apples;
+    for( int i = 0; i < 100; i++ ) {
+        apples.push_back( item::spawn( itype_id( "apple" ) ) );
+        more_apples.push_back( item::spawn( itype_id( "apple" ) ) );
+    }
+    const std::set<std::size_t> indices = first_processed( apples );
+    CHECK( indices.count( 0 ) == 1 );
+    CHECK( indices.size() < apples.size() );
+    CHECK( first_processed( more_apples ) == indices );
+}
@@ -0,0 +1,37 @@
+#include "catch/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "advanced_inv_area.h"
+#include "advanced_inv_listitem.h"
+#include "calendar.h"
+#include "item.h"
+#include "map.h"
+#include "point.h"
+#include "state_helpers.h"
+
+TEST_CASE( "advanced inventory squares restack only when their items change", "[advanced_inv]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint pos( 60, 60, 0 );
+    for( int i = 0; i < 3; i++ ) {
+        // Not counted by charges, so they are listed as one stack of three
+        here.add_item( pos, item::spawn( "hammer", calendar::turn ) );
+    }
+    advanced_inv_area square( AIM_CENTER );
+    square.pos = pos;
+
+    const std::vector<advanced_inv_listitem> &stacks = square.listed_stacks( false );
+    REQUIRE( stacks.size() == 1 );
+    CHECK( stacks.front().stacks == 3 );
+    const std::string name = stacks.front().name;
+    CHECK( square.listed_stacks( false ).front().name == name );
+
+    here.add_item( pos, item::spawn( "screwdriver", calendar::turn ) );
+    CHECK( square.listed_stacks( false ).size() == 2 );
+
+    here.i_clear( pos );
+    CHECK( square.listed_stacks( false ).empty() );
+}
@@ -0,0 +1,39 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "background_saver.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "game.h"
+
+TEST_CASE( "background saver writes files in order", "[savegame]" )
+{
+    const std::string base = g->get_world_base_save_path() + "/bg_save_test_" +
+                             get_pid_string() + "/";
+    REQUIRE( assure_dir_exist( base ) );
+    const std::string file1 = base + "first.json";
+    const std::string file2 = base + "second.json";
+
+    background_saver saver;
+    bool callback_ran = false;
+
+    saver.write( file1, "outdated" );
+    saver.write( file2, "second" );
+    // Written after the outdated data
+    saver.write( file1, "first" );
+    saver.on_written( [&]() {
+        callback_ran = true;
+    } );
+
+    saver.wait();
+    CHECK( callback_ran );
+    CHECK( !saver.busy() );
+    CHECK( !saver.is_pending( file1 ) );
+    CHECK( read_entire_file( file1 ) == "first" );
+    CHECK( read_entire_file( file2 ) == "second" );
+
+    REQUIRE( remove_file( file1 ) );
+    REQUIRE( remove_file( file2 ) );
+    REQUIRE( remove_directory( base ) );
+}
@@ -0,0 +1,416 @@
+// Save/load throughput benchmark over a copy of a real world.
+//
+// Usage: cata_bench <world directory> [--user-dir=<dir>] [--generate=<quads>]
+//
+// The world is copied into a scratch user directory first, the original is never written to.
+// For each kind of save data the stages that apply are run and reported with wall time,
+// bytes read or written and heap allocations:
+//   load               read and parse everything that is on disk
+//   generate-missing   map only: run mapgen for quads next to the saved ones
+//   serialize          serialize everything that is loaded into memory
+//   write              save everything to disk the way the game does
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "binary_io.h"
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "color.h"
+#include "coordinate_conversions.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "game_constants.h"
+#include "init.h"
+#include "json.h"
+#include "language.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "map_archive.h"
+#include "map_memory.h"
+#include "mapbuffer.h"
+#include "memory_stats.h"
+#include "options.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "point.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+std::atomic<std::size_t> allocation_count{ 0 };
+
+struct stage_result {
+    std::string data;
+    std::string stage;
+    double seconds = 0.0;
+    std::uintmax_t bytes = 0;
+    std::size_t allocations = 0;
+    std::size_t count = 0;
+};
+
+std::vector<stage_result> results;
+
+// Run @p stage, which returns the number of bytes it handled, and record the result.
+void measure( const std::string &data, const std::string &stage, std::size_t count,
+              const std::function<std::uintmax_t()> &func )
+{
+    const std::size_t allocations_before = allocation_count.load( std::memory_order_relaxed );
+    const auto start = std::chrono::steady_clock::now();
+    const std::uintmax_t bytes = func();
+    const auto end = std::chrono::steady_clock::now();
+    stage_result result;
+    result.data = data;
+    result.stage = stage;
+    result.seconds = std::chrono::duration<double>( end - start ).count();
+    result.bytes = bytes;
+    result.allocations = allocation_count.load( std::memory_order_relaxed ) - allocations_before;
+    result.count = count;
+    results.push_back( result );
+}
+
+std::uintmax_t total_size( const std::vector<std::string> &paths )
+{
+    std::uintmax_t size = 0;
+    for( const std::string &path : paths ) {
+        std::error_code ec;
+        const std::uintmax_t file_size = std::filesystem::file_size( path, ec );
+        if( !ec ) {
+            size += file_size;
+        }
+    }
+    return size;
+}
+
+std::uintmax_t directory_size( const std::string &dir )
+{
+    if( !dir_exist( dir ) ) {
+        return 0;
+    }
+    return total_size( get_files_from_path( "", dir, true ) );
+}
+
+std::string file_name( const std::string &path )
+{
+    return std::filesystem::path( path ).filename().string();
+}
+
+// Quads stored in the world, both loose files and segment archives
+std::set<tripoint> find_saved_quads( const std::string &maps_dir )
+{
+    std::set<tripoint> quads;
+    for( const char *ext : {
+             ".map", ".mapb"
+         } ) {
+        for( const std::string &path : get_files_from_path( ext, maps_dir, true, true ) ) {
+            tripoint p;
+            if( std::sscanf( file_name( path ).c_str(), "%d.%d.%d.", &p.x, &p.y, &p.z ) == 3 ) {
+                quads.insert( p );
+            }
+        }
+    }
+    for( const std::string &path : get_files_from_path( ".seg", maps_dir, false, true ) ) {
+        for( const tripoint &p : segment_archive( path ).quads() ) {
+            quads.insert( p );
+        }
+    }
+    return quads;
+}
+
+void bench_overmaps( const std::string &world_dir )
+{
+    std::set<point_abs_om> positions;
+    std::vector<std::string> files;
+    for( const std::string &path : get_files_from_path( "o.", world_dir, false ) ) {
+        point p;
+        if( std::sscanf( file_name( path ).c_str(), "o.%d.%d", &p.x, &p.y ) == 2 ) {
+            positions.insert( point_abs_om( p ) );
+            files.push_back( path );
+        }
+    }
+
+    std::vector<overmap *> loaded;
+    measure( "overmap", "load", positions.size(), [&]() {
+        for( const point_abs_om &p : positions ) {
+            loaded.push_back( &overmap_buffer.get( p ) );
+        }
+        return total_size( files );
+    } );
+    const bool binary = get_option<std::string>( "MAP_STORAGE_FORMAT" ) == "binary";
+    measure( "overmap", "serialize", loaded.size(), [&]() {
+        std::uintmax_t bytes = 0;
+        for( const overmap *om : loaded ) {
+            std::ostringstream buffer;
+            if( binary ) {
+                om->serialize_binary( buffer );
+            } else {
+                om->serialize( buffer );
+            }
+            bytes += buffer.str().size();
+        }
+        return bytes;
+    } );
+    measure( "overmap", "write", loaded.size(), [&]() {
+        overmap_buffer.save();
+        std::vector<std::string> written;
+        for( const point_abs_om &p : positions ) {
+            written.push_back( binary ? overmapbuffer::binary_terrain_filename( p ) :
+                               overmapbuffer::terrain_filename( p ) );
+        }
+        return total_size( written );
+    } );
+}
+
+void bench_submaps( const std::string &world_dir, int generate )
+{
+    const std::string maps_dir = world_dir + "/maps";
+    const std::set<tripoint> quads = find_saved_quads( maps_dir );
+
+    measure( "map", "load", quads.size(), [&]() {
+        for( const tripoint &om_addr : quads ) {
+            MAPBUFFER.lookup_submap( omt_to_sm_copy( om_addr ) );
+        }
+        return directory_size( maps_dir );
+    } );
+
+    // Neighbours of saved quads that were never visited
+    std::set<tripoint> missing;
+    for( const tripoint &om_addr : quads ) {
+        for( const point &offset : four_adjacent_offsets ) {
+            const tripoint neighbour = om_addr + offset;
+            if( static_cast<int>( missing.size() ) < generate && !quads.contains( neighbour ) &&
+                !MAPBUFFER.is_submap_loaded( omt_to_sm_copy( neighbour ) ) ) {
+                missing.insert( neighbour );
+            }
+        }
+    }
+    measure( "map", "generate-missing", missing.size(), [&]() {
+        // Test mode adds expensive consistency checks to overmap generation
+        test_mode = false;
+        on_out_of_scope restore_test_mode( []() {
+            test_mode = true;
+        } );
+        for( const tripoint &om_addr : missing ) {
+            if( MAPBUFFER.is_submap_loaded( omt_to_sm_copy( om_addr ) ) ) {
+                continue;
+            }
+            tinymap tm;
+            tm.load( tripoint_abs_sm( omt_to_sm_copy( om_addr ) ), false );
+        }
+        return std::uintmax_t( 0 );
+    } );
+
+    std::size_t submap_count = 0;
+    for( auto it = MAPBUFFER.begin(); it != MAPBUFFER.end(); ++it ) {
+        if( it->second != nullptr ) {
+            submap_count++;
+        }
+    }
+    const bool binary = get_option<std::string>( "MAP_STORAGE_FORMAT" ) == "binary";
+    measure( "map", "serialize", submap_count, [&]() {
+        std::ostringstream buffer;
+        for( auto it = MAPBUFFER.begin(); it != MAPBUFFER.end(); ++it ) {
+            if( it->second == nullptr ) {
+                continue;
+            }
+            if( binary ) {
+                binary_out out( buffer );
+                it->second->store_binary( out );
+            } else {
+                JsonOut jsout( buffer );
+                jsout.start_object();
+                it->second->store( jsout );
+                jsout.end_object();
+            }
+        }
+        return std::uintmax_t( buffer.str().size() );
+    } );
+
+    measure( "map", "write", submap_count, [&]() {
+        // Measure a full save, not just the quads that happen to be modified
+        for( auto it = MAPBUFFER.begin(); it != MAPBUFFER.end(); ++it ) {
+            if( it->second != nullptr ) {
+                it->second->mark_modified();
+            }
+        }
+        MAPBUFFER.save();
+        return directory_size( maps_dir );
+    } );
+}
+
+void bench_map_memory( const WORLDPTR world )
+{
+    // Map memory is never read from disk in test mode
+    test_mode = false;
+    on_out_of_scope restore_test_mode( []() {
+        test_mode = true;
+    } );
+    for( const save_t &save : world->world_saves ) {
+        get_avatar().set_save_id( save.decoded_name() );
+        const std::string dir = g->get_player_base_save_path() + ".mm1";
+        std::vector<tripoint> regions;
+        const std::vector<std::string> files = get_files_from_path( ".mmr", dir, false, true );
+        for( const std::string &path : files ) {
+            tripoint p;
+            if( std::sscanf( file_name( path ).c_str(), "%d.%d.%d.", &p.x, &p.y, &p.z ) == 3 ) {
+                // Center of the region in map squares
+                regions.push_back( tripoint( ( p.x * MM_REG_SIZE + MM_REG_SIZE / 2 ) * SEEX,
+                                             ( p.y * MM_REG_SIZE + MM_REG_SIZE / 2 ) * SEEY, p.z ) );
+            }
+        }
+
+        const std::string data = "map memory (" + save.decoded_name() + ")";
+        std::vector<std::unique_ptr<map_memory>> memories;
+        measure( data, "load", regions.size(), [&]() {
+            for( const tripoint &p : regions ) {
+                memories.push_back( std::make_unique<map_memory>() );
+                memories.back()->load( p );
+            }
+            return total_size( files );
+        } );
+        measure( data, "write", regions.size(), [&]() {
+            for( size_t i = 0; i < regions.size(); ++i ) {
+                memories[i]->save( regions[i] );
+            }
+            return directory_size( dir );
+        } );
+    }
+}
+
+void copy_tree( const std::string &from, const std::string &to )
+{
+    std::filesystem::copy( std::filesystem::path( from ), std::filesystem::path( to ),
+                           std::filesystem::copy_options::recursive |
+                           std::filesystem::copy_options::overwrite_existing );
+}
+
+void print_results()
+{
+    std::printf( "%-32s %-18s %8s %12s %14s %14s %10s\n", "data", "stage", "count", "seconds", "bytes",
+                 "allocations", "MB/s" );
+    for( const stage_result &r : results ) {
+        const double mb_per_second = r.seconds > 0.0 ? r.bytes / r.seconds / ( 1024.0 * 1024.0 ) : 0.0;
+        std::printf( "%-32s %-18s %8zu %12.4f %14ju %14zu %10.2f\n", r.data.c_str(), r.stage.c_str(),
+                     r.count, r.seconds, r.bytes, r.allocations, mb_per_second );
+    }
+}
+
+std::string extract_argument( std::vector<std::string> &args, const std::string &tag )
+{
+    for( auto iter = args.begin(); iter != args.end(); ++iter ) {
+        if( iter->starts_with( tag ) ) {
+            std::string value = iter->substr( tag.size() );
+            args.erase( iter );
+            return value;
+        }
+    }
+    return std::string();
+}
+
+} // namespace
+
+// Count every heap allocation made anywhere in the program
+void *operator new( std::size_t size )
+{
+    allocation_count.fetch_add( 1, std::memory_order_relaxed );
+    if( void *ptr = std::malloc( size == 0 ? 1 : size ) ) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+int main( int argc, const char *argv[] )
+{
+    std::vector<std::string> args( argv + 1, argv + argc );
+    std::string user_dir = extract_argument( args, "--user-dir=" );
+    if( user_dir.empty() ) {
+        user_dir = "./bench_user_dir/";
+    } else if( !user_dir.ends_with( "/" ) ) {
+        user_dir += "/";
+    }
+    const std::string generate_arg = extract_argument( args, "--generate=" );
+    const int generate = generate_arg.empty() ? 16 : std::atoi( generate_arg.c_str() );
+    if( args.size() != 1 || !dir_exist( args[0] ) ) {
+        std::fprintf( stderr, "Usage: %s <world directory> [--user-dir=<dir>] [--generate=<quads>]\n",
+                      argv[0] );
+        std::fprintf( stderr, "  The world is copied into the user dir, all its contents will be erased!\n" );
+        return EXIT_FAILURE;
+    }
+    std::string world_path = args[0];
+    while( world_path.size() > 1 && world_path.ends_with( "/" ) ) {
+        world_path.pop_back();
+    }
+    const std::string world_name = file_name( world_path );
+
+    // Run without any UI, like the tests
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+    try {
+        remove_tree( user_dir );
+        assure_dir_exist( user_dir );
+        PATH_INFO::init_base_path( "" );
+        PATH_INFO::init_user_dir( user_dir );
+        PATH_INFO::set_standard_filenames();
+        assure_dir_exist( PATH_INFO::config_dir() );
+        assure_dir_exist( PATH_INFO::savedir() );
+        copy_tree( world_path, PATH_INFO::savedir() + world_name );
+
+        init_language_system();
+        get_options().init();
+        get_options().load();
+        init_colors();
+
+        g = std::make_unique<game>();
+        g->load_static_data();
+        world_generator->init();
+        const WORLDPTR world = world_generator->get_world( world_name );
+        if( world == nullptr ) {
+            std::fprintf( stderr, "Could not open world %s\n", world_name.c_str() );
+            return EXIT_FAILURE;
+        }
+        world_generator->set_active_world( world );
+        loading_ui ui( false );
+        init::load_world_modfiles( ui, g->get_world_base_save_path() + "/" + SAVE_ARTIFACTS );
+
+        const std::string world_dir = g->get_world_base_save_path();
+        bench_overmaps( world_dir );
+        bench_submaps( world_dir, generate );
+        bench_map_memory( world );
+    } catch( const std::exception &err ) {
+        std::fprintf( stderr, "Benchmark failed: %s\n", err.what() );
+        return EXIT_FAILURE;
+    }
+
+    print_results();
+    std::printf( "\n%s", memory_stats::report().c_str() );
+    g.reset();
+    return EXIT_SUCCESS;
+}
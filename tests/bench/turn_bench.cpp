@@ -0,0 +1,307 @@
+// Turn simulation benchmark over a copy of a real save.
+//
+// Usage: cata_turn_bench <world directory> [--save=<character>] [--turns=<n>]
+//                        [--actions=<file>] [--json=<file>] [--user-dir=<dir>]
+//
+// The world is copied into a scratch user directory first, the original is never written to.
+// The save, by default the first one in the world, is loaded without any UI and the game then
+// runs turn after turn. Without an action list the character just waits for --turns turns
+// (100 by default). An action list has one action per line, blank lines and lines starting
+// with # are skipped:
+//   wait <turns>               pass that many turns
+//   move <direction> <steps>   walk n, ne, e, se, s, sw, w or nw, a turn for each step
+//
+// Reported are the turns per second, the time each phase of the turns took, see turn_stats.h,
+// and the memory held at the end, see memory_stats.h, as a table or, with --json, written to
+// that file as a JSON object.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "avatar_action.h"
+#include "cached_options.h"
+#include "color.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "json.h"
+#include "language.h"
+#include "map.h"
+#include "memory_stats.h"
+#include "options.h"
+#include "path_info.h"
+#include "point.h"
+#include "turn_stats.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+struct action {
+    // Zero to wait
+    point step;
+    int times = 0;
+};
+
+struct bench_result {
+    int turns = 0;
+    double seconds = 0.0;
+};
+
+std::string extract_argument( std::vector<std::string> &args, const std::string &tag )
+{
+    for( auto iter = args.begin(); iter != args.end(); ++iter ) {
+        if( iter->starts_with( tag ) ) {
+            std::string value = iter->substr( tag.size() );
+            args.erase( iter );
+            return value;
+        }
+    }
+    return std::string();
+}
+
+std::string file_name( const std::string &path )
+{
+    return std::filesystem::path( path ).filename().string();
+}
+
+void copy_tree( const std::string &from, const std::string &to )
+{
+    std::filesystem::copy( std::filesystem::path( from ), std::filesystem::path( to ),
+                           std::filesystem::copy_options::recursive |
+                           std::filesystem::copy_options::overwrite_existing );
+}
+
+bool read_actions( const std::string &path, std::vector<action> &actions )
+{
+    static const std::map<std::string, point> directions = {
+        { "n", point_north }, { "ne", point_north_east }, { "e", point_east },
+        { "se", point_south_east }, { "s", point_south }, { "sw", point_south_west },
+        { "w", point_west }, { "nw", point_north_west },
+    };
+    bool valid = true;
+    const bool read = read_from_file( path, [&]( std::istream & fin ) {
+        std::string line;
+        for( int line_number = 1; std::getline( fin, line ); line_number++ ) {
+            std::istringstream words( line );
+            std::string verb;
+            if( !( words >> verb ) || verb.starts_with( "#" ) ) {
+                continue;
+            }
+            action act;
+            std::string direction;
+            if( verb == "move" && words >> direction && directions.contains( direction ) ) {
+                act.step = directions.at( direction );
+            } else if( verb != "wait" ) {
+                valid = false;
+            }
+            if( !( words >> act.times ) || act.times < 0 ) {
+                valid = false;
+            }
+            if( !valid ) {
+                std::fprintf( stderr, "%s:%d: can't read the action \"%s\"\n", path.c_str(),
+                              line_number, line.c_str() );
+                return;
+            }
+            actions.push_back( act );
+        }
+    } );
+    return read && valid;
+}
+
+// Runs one turn, false once the game is over
+bool simulate_turn( const point &step )
+{
+    avatar &u = get_avatar();
+    if( step != point_zero ) {
+        avatar_action::move( u, get_map(), step );
+    }
+    // Whatever the character has left of the turn is spent waiting, the game never asks for input
+    u.moves = std::min( u.moves, 0 );
+    return !g->do_turn();
+}
+
+bench_result run( const std::vector<action> &actions )
+{
+    bench_result result;
+    turn_stats::reset();
+    const auto start = std::chrono::steady_clock::now();
+    bool game_over = false;
+    for( const action &act : actions ) {
+        for( int i = 0; i < act.times && !game_over; i++ ) {
+            game_over = !simulate_turn( act.step );
+            if( game_over ) {
+                std::fprintf( stderr, "The game ended after %d turns\n", result.turns );
+            } else {
+                result.turns++;
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                     start ).count();
+    return result;
+}
+
+double turns_per_second( const bench_result &result )
+{
+    return result.seconds > 0.0 ? result.turns / result.seconds : 0.0;
+}
+
+void print_results( const bench_result &result )
+{
+    std::printf( "%d turns in %.3f s, %.2f turns per second\n\n", result.turns, result.seconds,
+                 turns_per_second( result ) );
+    std::printf( "%-16s %14s %14s\n", "phase", "ms", "ms per turn" );
+    for( int p = 0; p < turn_stats::num_phases; p++ ) {
+        const turn_phase phase = static_cast<turn_phase>( p );
+        const double ms = turn_stats::microseconds( phase ) / 1000.0;
+        std::printf( "%-16s %14.3f %14.4f\n", turn_stats::phase_name( phase ), ms,
+                     result.turns > 0 ? ms / result.turns : 0.0 );
+    }
+    std::printf( "\n%s", memory_stats::report().c_str() );
+}
+
+bool write_json( const std::string &path, const std::string &world, const std::string &save,
+                 const bench_result &result )
+{
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "world", world );
+        jsout.member( "save", save );
+        jsout.member( "turns", result.turns );
+        jsout.member( "seconds", result.seconds );
+        jsout.member( "turns_per_second", turns_per_second( result ) );
+        jsout.member( "phases_ms" );
+        jsout.start_object();
+        for( int p = 0; p < turn_stats::num_phases; p++ ) {
+            const turn_phase phase = static_cast<turn_phase>( p );
+            const double ms = turn_stats::microseconds( phase ) / 1000.0;
+            jsout.member( turn_stats::phase_name( phase ), ms );
+        }
+        jsout.end_object();
+        // Of the last turn_stats::history_size turns
+        jsout.member( "histogram_ms" );
+        jsout.start_object();
+        const std::array<int, turn_stats::num_buckets> buckets = turn_stats::histogram();
+        for( int b = 0; b < turn_stats::num_buckets; b++ ) {
+            jsout.member( turn_stats::bucket_label( b ), buckets[b] );
+        }
+        jsout.end_object();
+        memory_stats::serialize( jsout );
+        jsout.end_object();
+    }, "benchmark results" );
+}
+
+} // namespace
+
+int main( int argc, const char *argv[] )
+{
+    std::vector<std::string> args( argv + 1, argv + argc );
+    std::string user_dir = extract_argument( args, "--user-dir=" );
+    if( user_dir.empty() ) {
+        user_dir = "./bench_user_dir/";
+    } else if( !user_dir.ends_with( "/" ) ) {
+        user_dir += "/";
+    }
+    const std::string save_name = extract_argument( args, "--save=" );
+    const std::string turns_arg = extract_argument( args, "--turns=" );
+    const std::string actions_path = extract_argument( args, "--actions=" );
+    const std::string json_path = extract_argument( args, "--json=" );
+    if( args.size() != 1 || !dir_exist( args[0] ) ) {
+        std::fprintf( stderr, "Usage: %s <world directory> [--save=<character>] [--turns=<n>]\n"
+                      "       [--actions=<file>] [--json=<file>] [--user-dir=<dir>]\n", argv[0] );
+        std::fprintf( stderr, "  The world is copied into the user dir, all its contents will be erased!\n" );
+        return EXIT_FAILURE;
+    }
+    std::vector<action> actions;
+    if( !actions_path.empty() ) {
+        if( !read_actions( actions_path, actions ) ) {
+            return EXIT_FAILURE;
+        }
+    } else {
+        const int turns = turns_arg.empty() ? 100 : std::atoi( turns_arg.c_str() );
+        actions.push_back( { point_zero, turns } );
+    }
+    std::string world_path = args[0];
+    while( world_path.size() > 1 && world_path.ends_with( "/" ) ) {
+        world_path.pop_back();
+    }
+    const std::string world_name = file_name( world_path );
+
+    // Run without any UI, like the tests
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+    bench_result result;
+    std::string loaded_save;
+    try {
+        remove_tree( user_dir );
+        assure_dir_exist( user_dir );
+        PATH_INFO::init_base_path( "" );
+        PATH_INFO::init_user_dir( user_dir );
+        PATH_INFO::set_standard_filenames();
+        assure_dir_exist( PATH_INFO::config_dir() );
+        assure_dir_exist( PATH_INFO::savedir() );
+        copy_tree( world_path, PATH_INFO::savedir() + world_name );
+
+        init_language_system();
+        get_options().init();
+        get_options().load();
+        init_colors();
+
+        g = std::make_unique<game>();
+        g->load_static_data();
+        world_generator->init();
+        const WORLDPTR world = world_generator->get_world( world_name );
+        if( world == nullptr || world->world_saves.empty() ) {
+            std::fprintf( stderr, "Could not find a save in the world %s\n", world_name.c_str() );
+            return EXIT_FAILURE;
+        }
+        const save_t *save = &world->world_saves.front();
+        if( !save_name.empty() ) {
+            save = nullptr;
+            for( const save_t &candidate : world->world_saves ) {
+                if( candidate.decoded_name() == save_name ) {
+                    save = &candidate;
+                }
+            }
+            if( save == nullptr ) {
+                std::fprintf( stderr, "The world %s has no save of %s\n", world_name.c_str(),
+                              save_name.c_str() );
+                return EXIT_FAILURE;
+            }
+        }
+        loaded_save = save->decoded_name();
+        world_generator->set_active_world( world );
+        g->setup();
+        if( !g->load( *save ) ) {
+            std::fprintf( stderr, "Could not load the save of %s\n", loaded_save.c_str() );
+            return EXIT_FAILURE;
+        }
+
+        result = run( actions );
+    } catch( const std::exception &err ) {
+        std::fprintf( stderr, "Benchmark failed: %s\n", err.what() );
+        return EXIT_FAILURE;
+    }
+
+    print_results( result );
+    if( !json_path.empty() && !write_json( json_path, world_name, loaded_save, result ) ) {
+        return EXIT_FAILURE;
+    }
+    g.reset();
+    return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 #include "catch/catch.hpp"
 
 #include "avatar.h"
+#include "binary_io.h"
 #include "catacharset.h"
 #include "catalua_impl.h"
 #include "catalua_serde.h"
@@ -10,10 +11,15 @@
 #include "debug.h"
 #include "faction.h"
 #include "fstream_utils.h"
+#include "item.h"
 #include "json.h"
+#include "map.h"
+#include "map_helpers.h"
 #include "mapdata.h"
 #include "options.h"
+#include "options_helpers.h"
 #include "point.h"
+#include "state_helpers.h"
 #include "string_formatter.h"
 #include "stringmaker.h"
 #include "type_id.h"
@@ -22,7 +28,9 @@
 #include "units_mass.h"
 #include "units_volume.h"
 
+#include <cstdint>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <stdexcept>
 
@@ -330,6 +338,58 @@ TEST_CASE( "lua_table_serde", "[lua]" )
     CHECK( inner_val.as<int>() == 4 );
 }
 
+TEST_CASE( "lua_table_binary_serde", "[lua]" )
+{
+    sol::state lua = make_lua_state();
+
+    sol::table t = lua.create_table();
+    t["member_bool"] = true;
+    t["member_float"] = 16.5;
+    t["member_int"] = int64_t( 1 ) << 40;
+    t["member_usertype"] = tripoint( 7, 5, 3 );
+    // Many tables with the same keys, the keys are written once
+    for( int i = 1; i <= 100; i++ ) {
+        sol::table st = lua.create_table();
+        st["inner_val"] = i;
+        st["name"] = "tile";
+        t[i] = st;
+    }
+    REQUIRE( cata::count_lua_table_values( t ) == 8 + 100 * 6 );
+
+    std::stringstream data;
+    binary_out out( data );
+    cata::serialize_lua_table_binary( t, out );
+
+    sol::table nt = lua.create_table();
+    binary_in in( data );
+    cata::deserialize_lua_table_binary( nt, in );
+    CHECK( in.eof() );
+
+    sol::object mem_bool = nt["member_bool"];
+    REQUIRE( mem_bool.is<bool>() );
+    CHECK( mem_bool.as<bool>() );
+
+    sol::object mem_float = nt["member_float"];
+    REQUIRE( mem_float.is<double>() );
+    CHECK( mem_float.as<double>() == 16.5 );
+
+    sol::object mem_int = nt["member_int"];
+    REQUIRE( mem_int.is<int64_t>() );
+    CHECK( mem_int.as<int64_t>() == int64_t( 1 ) << 40 );
+
+    sol::object mem_usertype = nt["member_usertype"];
+    REQUIRE( mem_usertype.is<tripoint>() );
+    CHECK( mem_usertype.as<tripoint>() == tripoint( 7, 5, 3 ) );
+
+    for( int i = 1; i <= 100; i++ ) {
+        sol::object inner = nt[i];
+        REQUIRE( inner.is<sol::table>() );
+        sol::table nts = inner;
+        CHECK( nts["inner_val"].get<int>() == i );
+        CHECK( nts["name"].get<std::string>() == "tile" );
+    }
+}
+
 TEST_CASE( "lua_table_serde_error_no_reg", "[lua]" )
 {
     sol::state lua = make_lua_state();
@@ -770,4 +830,69 @@ TEST_CASE( "lua_units_functions", "[lua]" )
     REQUIRE( lua_volume_milliliters == units::to_milliliter( units::from_liter( volume_liters ) ) );
 }
 
+TEST_CASE( "lua_function_source", "[lua]" )
+{
+    sol::state lua = make_lua_state();
+
+    lua.script( "\n\nfunction from_third_line() end", "test_chunk.lua" );
+    sol::protected_function func = lua.globals()["from_third_line"];
+    REQUIRE( func.valid() );
+    CHECK( get_function_source( func ) == "[string \"test_chunk.lua\"]:3" );
+    // Finding the source leaves the stack as it was
+    CHECK( lua_gettop( lua.lua_state() ) == 0 );
+}
+
+TEST_CASE( "lua_bulk_queries", "[lua]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_grass" ) );
+    map &here = get_map();
+    const tripoint corner( 40, 40, 0 );
+    here.ter_set( corner + point_east, ter_id( "t_dirt" ) );
+    here.add_item( corner, item::spawn( itype_id( "apple" ) ) );
+    here.add_item( corner + point_south, item::spawn( itype_id( "apple" ) ) );
+    here.add_item( corner + point_south, item::spawn( itype_id( "rock" ) ) );
+
+    sol::state lua = make_lua_state();
+    lua.globals()["from"] = corner;
+    lua.globals()["to"] = corner + point( 2, 1 );
+
+    sol::table rect = lua.script( "return gapi.get_map():get_ter_in_rect( to, from )" );
+    REQUIRE( rect.size() == 6 );
+    for( int i = 1; i <= 6; i++ ) {
+        CAPTURE( i );
+        CHECK( rect.get<ter_id>( i ) == ter_id( i == 2 ? "t_dirt" : "t_grass" ) );
+    }
+
+    sol::table all_items = lua.script( "return gapi.get_map():get_items_in_radius( from, 1 )" );
+    CHECK( all_items.size() == 3 );
+    sol::table apples = lua.script(
+                            "return gapi.get_map():get_items_in_radius( from, 1, ItypeId.new( \"apple\" ) )" );
+    REQUIRE( apples.size() == 2 );
+    CHECK( apples.get<item *>( 1 )->typeId() == itype_id( "apple" ) );
+}
+
+TEST_CASE( "lua_time_budget_stops_endless_loop", "[lua]" )
+{
+    override_option call_limit( "LUA_CALL_TIME_LIMIT", "50" );
+    override_option turn_limit( "LUA_TURN_TIME_LIMIT", "0" );
+    sol::state lua = make_lua_state();
+
+    lua.script( "function forever() while true do end end\nfunction quick() return 5 end" );
+    sol::protected_function forever = lua.globals()["forever"];
+    sol::protected_function quick = lua.globals()["quick"];
+    {
+        const lua_time_budget budget( lua );
+        sol::protected_function_result res = forever();
+        CHECK_FALSE( res.valid() );
+    }
+    {
+        // The next call gets its own time
+        const lua_time_budget budget( lua );
+        sol::protected_function_result res = quick();
+        REQUIRE( res.valid() );
+        CHECK( res.get<int>() == 5 );
+    }
+}
+
 #endif
@@ -0,0 +1,47 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "cellular_automata.h"
+#include "point.h"
+#include "rng.h"
+
+// The automaton cell by cell, as the rules are written down
+static std::vector<std::vector<int>> reference_automaton( point size, int alive, int iterations,
+                                  int birth_limit, int stasis_limit )
+{
+    std::vector<std::vector<int>> current( size.x, std::vector<int>( size.y, 0 ) );
+    for( int i = 0; i < size.x; i++ ) {
+        for( int j = 0; j < size.y; j++ ) {
+            current[i][j] = x_in_y( alive, 100 );
+        }
+    }
+    for( int iteration = 0; iteration < iterations; iteration++ ) {
+        std::vector<std::vector<int>> next( size.x, std::vector<int>( size.y, 0 ) );
+        for( int i = 1; i < size.x - 1; i++ ) {
+            for( int j = 1; j < size.y - 1; j++ ) {
+                const int neighbors = CellularAutomata::neighbor_count( current, size, point( i, j ) );
+                next[i][j] = neighbors > ( current[i][j] ? stasis_limit : birth_limit );
+            }
+        }
+        current = next;
+    }
+    return current;
+}
+
+TEST_CASE( "cellular automaton follows its rules cell by cell", "[mapgen]" )
+{
+    for( const point &size : {
+             point( 1, 1 ), point( 2, 7 ), point( 24, 24 ), point( 41, 17 ), point( 96, 96 )
+         } ) {
+        for( const int iterations : { 0, 1, 5 } ) {
+            CAPTURE( size, iterations );
+            rng_set_engine_seed( 1234 );
+            const std::vector<std::vector<int>> expected = reference_automaton( size, 55, iterations, 5,
+                    4 );
+            rng_set_engine_seed( 1234 );
+            CHECK( CellularAutomata::generate_cellular_automaton( size, 55, iterations, 5, 4 ) ==
+                   expected );
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <optional>
+#include <unordered_set>
+
+#include "clzones.h"
+#include "faction.h"
+#include "line.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const zone_type_id zone_LOOT_UNSORTED( "LOOT_UNSORTED" );
+
+// What the queries near a point should find, by checking every square around it
+static std::unordered_set<tripoint> zone_squares_near( const tripoint &where, int range )
+{
+    const zone_manager &mgr = zone_manager::get_manager();
+    std::unordered_set<tripoint> ret;
+    for( int x = where.x - range; x <= where.x + range; x++ ) {
+        for( int y = where.y - range; y <= where.y + range; y++ ) {
+            const tripoint p( x, y, where.z );
+            if( mgr.has( zone_LOOT_UNSORTED, p ) ) {
+                ret.insert( p );
+            }
+        }
+    }
+    return ret;
+}
+
+TEST_CASE( "zones found near a point match a scan of the squares around it", "[zone]" )
+{
+    clear_all_state();
+    zone_manager::reset_manager();
+    zone_manager &mgr = zone_manager::get_manager();
+    const tripoint origin( 1000, 1000, 0 );
+    mgr.add( "a", zone_LOOT_UNSORTED, your_fac, false, true, origin, origin + tripoint( 4, 2, 0 ) );
+    mgr.add( "b", zone_LOOT_UNSORTED, your_fac, false, true, origin + tripoint( 10, -6, 0 ),
+             origin + tripoint( 12, 8, 0 ) );
+    mgr.add( "c", zone_LOOT_UNSORTED, your_fac, false, true, origin + tripoint( -3, -3, 1 ),
+             origin + tripoint( 3, 3, 1 ) );
+
+    for( const tripoint &where : {
+             origin, origin + tripoint( 7, 1, 0 ), origin + tripoint( -9, 4, 0 ),
+             origin + tripoint( 20, 20, 0 ), origin + tripoint( 0, 8, 1 )
+         } ) {
+        for( const int range : { 0, 1, 3, 6, 15 } ) {
+            CAPTURE( where, range );
+            const std::unordered_set<tripoint> expected = zone_squares_near( where, range );
+            CHECK( mgr.get_near( zone_LOOT_UNSORTED, where, range ) == expected );
+            CHECK( mgr.has_near( zone_LOOT_UNSORTED, where, range ) == !expected.empty() );
+
+            const std::optional<tripoint> nearest = mgr.get_nearest( zone_LOOT_UNSORTED, where, range );
+            int nearest_dist = INT_MAX;
+            for( int z = where.z - range; z <= where.z + range; z++ ) {
+                for( const tripoint &p : zone_squares_near( tripoint( where.xy(), z ), range ) ) {
+                    nearest_dist = std::min( nearest_dist, square_dist( p, where ) );
+                }
+            }
+            if( nearest_dist == INT_MAX ) {
+                CHECK( !nearest );
+            } else {
+                REQUIRE( nearest );
+                CHECK( mgr.has( zone_LOOT_UNSORTED, *nearest ) );
+                CHECK( square_dist( *nearest, where ) == nearest_dist );
+            }
+        }
+    }
+}
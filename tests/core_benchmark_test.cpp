@@ -0,0 +1,281 @@
+#include "catch/catch.hpp"
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "coordinates.h"
+#include "flat_set.h"
+#include "item.h"
+#include "json.h"
+#include "line.h"
+#include "lru_cache.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_id.h"
+#include "tripoint_map.h"
+#include "type_id.h"
+#include "units.h"
+
+// Timings of the small building blocks the rest of the game is made of, so a commit that slows
+// one of them down shows up before it spreads everywhere.
+// Run with: cata_test "[core_benchmark]"
+// For results a script can compare, add a reporter: -r xml -o core_benchmark.xml
+
+namespace
+{
+
+struct bench_obj {};
+using bench_obj_id = string_id<bench_obj>;
+
+std::string make_json_list( int size )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_array();
+    for( int i = 0; i < size; i++ ) {
+        jsout.start_object();
+        jsout.member( "id", "thing_" + std::to_string( i ) );
+        jsout.member( "weight", i * 10 );
+        jsout.member( "volume", "250 ml" );
+        jsout.member( "flags", std::vector<std::string> { "FLAG_A", "FLAG_B", "FLAG_C" } );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    return os.str();
+}
+
+} // namespace
+
+TEST_CASE( "coordinate_conversion_benchmark", "[.][core_benchmark][coordinates][benchmark]" )
+{
+    const tripoint_abs_ms origin( 123456, -65432, 0 );
+    BENCHMARK( "project_to sm" ) {
+        int sum = 0;
+        for( int i = 0; i < 1000; i++ ) {
+            sum += project_to<coords::sm>( origin + tripoint( i, i, 0 ) ).x();
+        }
+        return sum;
+    };
+    BENCHMARK( "project_remain om" ) {
+        int sum = 0;
+        for( int i = 0; i < 1000; i++ ) {
+            const auto [om, omt] = project_remain<coords::om>( point_abs_omt( i * 7, -i * 3 ) );
+            sum += om.x() + omt.y();
+        }
+        return sum;
+    };
+}
+
+TEST_CASE( "line_to_benchmark", "[.][core_benchmark][line][benchmark]" )
+{
+    BENCHMARK( "line_to point, 60 tiles" ) {
+        return line_to( point_zero, point( 60, 23 ) ).size();
+    };
+    BENCHMARK( "line_to tripoint, 60 tiles" ) {
+        return line_to( tripoint_zero, tripoint( 60, 23, 2 ) ).size();
+    };
+    BENCHMARK( "rl_dist" ) {
+        int sum = 0;
+        for( int i = 0; i < 1000; i++ ) {
+            sum += rl_dist( tripoint( i, -i, 0 ), tripoint_zero );
+        }
+        return sum;
+    };
+}
+
+TEST_CASE( "rng_benchmark", "[.][core_benchmark][rng][benchmark]" )
+{
+    BENCHMARK( "rng" ) {
+        return rng( 0, 100 );
+    };
+    BENCHMARK( "rng_float" ) {
+        return rng_float( 0.0, 1.0 );
+    };
+    BENCHMARK( "one_in" ) {
+        return one_in( 10 );
+    };
+    BENCHMARK( "dice" ) {
+        return dice( 3, 6 );
+    };
+}
+
+TEST_CASE( "string_id_benchmark", "[.][core_benchmark][string_id][benchmark]" )
+{
+    std::vector<std::string> names;
+    for( int i = 0; i < 100; i++ ) {
+        names.push_back( "bench_obj_" + std::to_string( i ) );
+    }
+    // Interns them, later constructions only look them up
+    for( const std::string &name : names ) {
+        static_cast<void>( bench_obj_id( name ) );
+    }
+    BENCHMARK( "intern known strings" ) {
+        int sum = 0;
+        for( const std::string &name : names ) {
+            sum += !bench_obj_id( name ).is_empty();
+        }
+        return sum;
+    };
+    const bench_obj_id first( names.front() );
+    const bench_obj_id last( names.back() );
+    BENCHMARK( "compare" ) {
+        return first == last;
+    };
+
+    const itype_id rock( "rock" );
+    BENCHMARK( "itype_id::is_valid" ) {
+        return rock.is_valid();
+    };
+    BENCHMARK( "itype_id::obj" ) {
+        return &rock.obj();
+    };
+}
+
+TEST_CASE( "json_parsing_benchmark", "[.][core_benchmark][json][benchmark]" )
+{
+    const std::string json = make_json_list( 100 );
+    BENCHMARK( "read 100 objects" ) {
+        std::istringstream is( json );
+        JsonIn jsin( is );
+        int sum = 0;
+        for( JsonObject jo : jsin.get_array() ) {
+            sum += jo.get_string( "id" ).size() + jo.get_int( "weight" );
+            sum += jo.get_string( "volume" ).size() + jo.get_string_array( "flags" ).size();
+        }
+        return sum;
+    };
+}
+
+TEST_CASE( "flat_set_benchmark", "[.][core_benchmark][flat_set][benchmark]" )
+{
+    std::vector<int> values;
+    for( int i = 0; i < 1000; i++ ) {
+        values.push_back( ( i * 7919 ) % 1000 );
+    }
+    BENCHMARK( "insert 1000" ) {
+        cata::flat_set<int> s;
+        for( int v : values ) {
+            s.insert( v );
+        }
+        return s.size();
+    };
+    const cata::flat_set<int> s( values.begin(), values.end() );
+    BENCHMARK( "count 1000" ) {
+        int found = 0;
+        for( int v : values ) {
+            found += s.count( v * 2 );
+        }
+        return found;
+    };
+}
+
+TEST_CASE( "units_benchmark", "[.][core_benchmark][units][benchmark]" )
+{
+    BENCHMARK( "add masses" ) {
+        units::mass sum = 0_gram;
+        for( int i = 0; i < 1000; i++ ) {
+            sum += units::from_gram( i ) * 3;
+        }
+        return sum;
+    };
+    BENCHMARK( "divide volumes" ) {
+        int sum = 0;
+        for( int i = 1; i <= 1000; i++ ) {
+            sum += units::from_liter( 10 ) / units::from_milliliter( i );
+        }
+        return sum;
+    };
+}
+
+TEST_CASE( "item_weight_benchmark", "[.][core_benchmark][item][benchmark]" )
+{
+    detached_ptr<item> bottle = item::spawn( "bottle_plastic", calendar::turn );
+    detached_ptr<item> water = item::spawn( "water", calendar::turn );
+    water->charges = bottle->get_remaining_capacity_for_liquid( *water );
+    bottle->put_in( std::move( water ) );
+    const detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+    BENCHMARK( "rock" ) {
+        return rock->weight();
+    };
+    BENCHMARK( "bottle of water" ) {
+        return bottle->weight();
+    };
+}
+
+TEST_CASE( "visitable_benchmark", "[.][core_benchmark][visitable][benchmark]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    you.wear_item( item::spawn( "backpack" ), false );
+    for( int i = 0; i < 20; i++ ) {
+        you.i_add( item::spawn( "spoon", calendar::turn ) );
+    }
+    you.i_add( item::spawn( "hammer", calendar::turn ) );
+    const itype_id spoon( "spoon" );
+    const quality_id hammering( "HAMMER" );
+    BENCHMARK( "amount_of" ) {
+        return you.amount_of( spoon );
+    };
+    BENCHMARK( "has_amount" ) {
+        return you.has_amount( spoon, 20 );
+    };
+    BENCHMARK( "has_quality" ) {
+        return you.has_quality( hammering, 1, 1 );
+    };
+}
+
+TEST_CASE( "tripoint_map_benchmark", "[.][core_benchmark][flat_hash_map][benchmark]" )
+{
+    std::unordered_map<tripoint, int> node_map;
+    cata::tripoint_map<int> flat_map;
+    for( int x = 0; x < 60; x++ ) {
+        for( int y = 0; y < 60; y += 3 ) {
+            node_map.emplace( tripoint( x, y, 0 ), x + y );
+            flat_map.emplace( tripoint( x, y, 0 ), x + y );
+        }
+    }
+    const auto look_up_all = []( const auto & m ) {
+        int found = 0;
+        for( int x = 0; x < 60; x++ ) {
+            for( int y = 0; y < 60; y++ ) {
+                found += m.count( tripoint( x, y, 0 ) );
+            }
+        }
+        return found;
+    };
+    BENCHMARK( "std::unordered_map lookups" ) {
+        return look_up_all( node_map );
+    };
+    BENCHMARK( "cata::tripoint_map lookups" ) {
+        return look_up_all( flat_map );
+    };
+}
+
+TEST_CASE( "lru_cache_benchmark", "[.][core_benchmark][lru_cache][benchmark]" )
+{
+    BENCHMARK( "insert over the limit" ) {
+        lru_cache<tripoint, int> cache;
+        for( int i = 0; i < 1000; i++ ) {
+            cache.insert( 100, tripoint( i, 0, 0 ), i );
+        }
+        return cache.list().size();
+    };
+    lru_cache<tripoint, int> cache;
+    for( int i = 0; i < 100; i++ ) {
+        cache.insert( 100, tripoint( i, 0, 0 ), i );
+    }
+    BENCHMARK( "get" ) {
+        int sum = 0;
+        for( int i = 0; i < 200; i++ ) {
+            sum += cache.get( tripoint( i, 0, 0 ), -1 );
+        }
+        return sum;
+    };
+}
@@ -35,6 +35,7 @@
 #include "requirements.h"
 #include "state_helpers.h"
 #include "string_id.h"
+#include "string_utils.h"
 #include "type_id.h"
 #include "value_ptr.h"
 
@@ -74,6 +75,14 @@ TEST_CASE( "recipe_subset" )
                 CHECK( comp_recipes.size() == 1 );
                 CHECK( std::find( comp_recipes.begin(), comp_recipes.end(), r ) != comp_recipes.end() );
             }
+            THEN( "it's found by its name and components in any case" ) {
+                using search_type = recipe_subset::search_type;
+                const std::string name = r->result_name();
+                CHECK( subset.search( name ).size() == 1 );
+                CHECK( subset.search( to_upper_case( name ) ).size() == 1 );
+                CHECK( subset.search( "WaTeR", search_type::component ).size() == 1 );
+                CHECK( subset.search( "no such component", search_type::component ).empty() );
+            }
             AND_WHEN( "the subset is cleared" ) {
                 subset.clear();
 
@@ -778,3 +787,21 @@ TEST_CASE( "tool selection ui", "[crafting][ui]" )
         }
     }
 }
+
+TEST_CASE( "crafting_inventory_is_rebuilt_for_another_radius", "[crafting]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    const tripoint test_origin( 60, 60, 0 );
+    you.setpos( test_origin );
+    you.i_add( item::spawn( "rock" ) );
+    get_map().add_item( test_origin + point( 3, 0 ), item::spawn( "hammer" ) );
+
+    const itype_id hammer( "hammer" );
+    const itype_id rock( "rock" );
+    CHECK( you.crafting_inventory( tripoint_zero, 1 ).amount_of( hammer ) == 0 );
+    CHECK( you.crafting_inventory( tripoint_zero, 1 ).amount_of( rock ) == 1 );
+    CHECK( you.crafting_inventory( tripoint_zero, 5 ).amount_of( hammer ) == 1 );
+    CHECK( you.crafting_inventory( tripoint_zero, 5 ).amount_of( rock ) == 1 );
+}
@@ -136,3 +136,21 @@ TEST_CASE( "Check distribution of attacks to body parts for larger attacker." )
     calculate_bodypart_distribution( creature_size::medium, creature_size::small, 100,
                                      expected_larger.max );
 }
+
+TEST_CASE( "body parts are found in their own body", "[creature][anatomy]" )
+{
+    monster zombie( mtype_id( "mon_zombie" ) );
+    for( std::pair<const bodypart_str_id, bodypart> &elem : zombie.get_body() ) {
+        CHECK( &zombie.get_part( elem.first ) == &elem.second );
+    }
+
+    const bodypart_id torso( "torso" );
+    const int torso_hp = zombie.get_part_hp_cur( torso );
+    monster copy( zombie );
+    copy.mod_part_hp_cur( torso, -1 );
+    CHECK( copy.get_part_hp_cur( torso ) == torso_hp - 1 );
+    CHECK( zombie.get_part_hp_cur( torso ) == torso_hp );
+    for( std::pair<const bodypart_str_id, bodypart> &elem : copy.get_body() ) {
+        CHECK( &copy.get_part( elem.first ) == &elem.second );
+    }
+}
@@ -0,0 +1,105 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "character.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monfaction.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+
+// What the radius query should find, by checking every monster
+static std::vector<monster *> monsters_near( const tripoint &center, int radius )
+{
+    std::vector<monster *> ret;
+    for( monster &critter : g->all_monsters() ) {
+        if( rl_dist( center, critter.pos() ) <= radius ) {
+            ret.push_back( &critter );
+        }
+    }
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+static std::vector<monster *> monsters_in_radius( const tripoint &center, int radius )
+{
+    std::vector<monster *> ret = g->get_monsters_in_radius( center, radius );
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+TEST_CASE( "monsters found by area match a scan of all monsters", "[creature][monster]" )
+{
+    clear_all_state();
+    const tripoint center = get_player_character().pos();
+    std::vector<monster *> spawned;
+    for( int i = 0; i < 40; i++ ) {
+        const tripoint p = center + point( ( i * 7 ) % 61 - 30, ( i * 13 ) % 41 - 20 );
+        spawned.push_back( &spawn_test_monster( "mon_zombie", p ) );
+    }
+    const auto check_radii = [&]() {
+        for( const int radius : { 0, 1, 5, 12, 13, 25, 60 } ) {
+            CAPTURE( radius );
+            CHECK( monsters_in_radius( center, radius ) == monsters_near( center, radius ) );
+            CHECK( monsters_in_radius( center + point( 11, -5 ), radius ) ==
+                   monsters_near( center + point( 11, -5 ), radius ) );
+        }
+    };
+    check_radii();
+
+    SECTION( "after moving across submaps" ) {
+        for( size_t i = 0; i < spawned.size(); i += 3 ) {
+            spawned[i]->setpos( spawned[i]->pos() + point( 25, 1 ) );
+        }
+        check_radii();
+    }
+
+    SECTION( "after swapping" ) {
+        REQUIRE( g->swap_critters( *spawned[0], *spawned[1] ) );
+        check_radii();
+    }
+
+    SECTION( "after removal" ) {
+        g->remove_zombie( *spawned[2] );
+        CHECK( std::find( spawned.begin(), spawned.end(), spawned[2] ) != spawned.end() );
+        const std::vector<monster *> found = monsters_in_radius( center, 60 );
+        CHECK( std::find( found.begin(), found.end(), spawned[2] ) == found.end() );
+        check_radii();
+    }
+}
+
+TEST_CASE( "hostile monsters found by area match their faction attitudes", "[creature][monster]" )
+{
+    clear_all_state();
+    const tripoint center = get_player_character().pos();
+    monster &zombie = spawn_test_monster( "mon_zombie", center + point( 3, 0 ) );
+    monster &tame = spawn_test_monster( "mon_zombie", center + point( -4, 2 ) );
+    tame.friendly = -1;
+    g->critter_tracker->update_faction( tame );
+    spawn_test_monster( "mon_dog", center + point( 0, 6 ) );
+    spawn_test_monster( "mon_dog", center + point( 30, 0 ) );
+
+    const tripoint reach( 10, 10, 0 );
+    std::vector<monster *> expected;
+    for( monster *critter : g->get_monsters_in_radius( center, 20 ) ) {
+        const mfaction_id listed = critter->friendly == 0 ? critter->faction :
+                                   mfaction_str_id( "player" ).id();
+        const mf_attitude att = zombie.faction.obj().attitude( listed );
+        if( square_dist( center, critter->pos() ) <= 10 && att != MFA_NEUTRAL && att != MFA_FRIENDLY ) {
+            expected.push_back( critter );
+        }
+    }
+    std::vector<monster *> found;
+    for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_hostiles_in_rect(
+             zombie.faction, center - reach, center + reach ) ) {
+        found.push_back( critter.get() );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( found.begin(), found.end() );
+    CHECK( found == expected );
+}
@@ -30,6 +30,22 @@ TEST_CASE( "Adrenaline decays into adrenaline comedown" )
     CHECK( to_turns<int>( e.get_duration() ) == to_turns<int>( on_remove.duration ) );
 }
 
+TEST_CASE( "Effects only look up the mods they have" )
+{
+    REQUIRE( effect_adrenaline.is_valid() );
+    CHECK( effect_adrenaline->has_mod( "SPEED" ) );
+    CHECK( effect_adrenaline->has_mod( "INT" ) );
+    CHECK_FALSE( effect_adrenaline->has_mod( "PAIN" ) );
+
+    const effect e( &*effect_adrenaline, 10_turns, bodypart_str_id( "torso" ), 1,
+                    calendar::turn );
+    CHECK( e.get_mod( "SPEED" ) == 20 );
+    CHECK( e.get_mod( "INT" ) == -8 );
+    CHECK( e.get_mod( "PAIN" ) == 0 );
+    CHECK( e.get_amount( "PAIN" ) == 0 );
+    CHECK_FALSE( e.activated( calendar::turn, "PAIN", 0, false, 1.0 ) );
+}
+
 TEST_CASE( "Removed adrenaline still triggers adrenaline comedown" )
 {
     REQUIRE( effect_adrenaline.is_valid() );
@@ -173,6 +173,23 @@ TEST_CASE( "grid_and_vehicle_outside_bubble", "[grids][vehicle]" )
     }
 }
 
+TEST_CASE( "grids_of_only_batteries_and_connectors_are_not_updated", "[grids]" )
+{
+    clear_all_state();
+    put_player_underground();
+    map &m = get_map();
+    auto setup = set_up_grid( m );
+    CHECK_FALSE( setup.grid.requires_updates() );
+
+    const tripoint lamp_local_pos = tripoint( 15, 10, 0 );
+    m.furn_set( lamp_local_pos, f_floor_lamp_on );
+    distribution_grid &grid = get_distribution_grid_tracker().grid_at( tripoint_abs_ms(
+                                  m.getabs( lamp_local_pos ) ) );
+    REQUIRE( active_tiles::furn_at<steady_consumer_tile>( tripoint_abs_ms(
+                 m.getabs( lamp_local_pos ) ) ) );
+    CHECK( grid.requires_updates() );
+}
+
 struct grid_setup_consumer {
     distribution_grid &grid;
     steady_consumer_tile &consumer;
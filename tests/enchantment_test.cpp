@@ -215,6 +215,24 @@ static void tests_stats( Character &guy, int s_base, int d_base, int p_base, int
     }
 }
 
+TEST_CASE( "Enchantments of an item replaced in place are picked up",
+           "[magic][enchantment][character]" )
+{
+    clear_all_state();
+    Character &guy = get_player_character();
+    clear_character( *guy.as_player(), true );
+
+    item &relic = give_item( guy, "test_relic_mods_speed" );
+    REQUIRE( guy.bonus_from_enchantments( 100, enchant_vals::mod::SPEED ) != 0 );
+    REQUIRE( guy.bonus_from_enchantments( 100, enchant_vals::mod::ATTACK_COST ) == 0 );
+
+    // Same item in the same place, other enchantments
+    relic = *item::spawn_temporary( "test_relic_mods_atk_cost" );
+    guy.recalculate_enchantment_cache();
+    CHECK( guy.bonus_from_enchantments( 100, enchant_vals::mod::SPEED ) == 0 );
+    CHECK( guy.bonus_from_enchantments( 100, enchant_vals::mod::ATTACK_COST ) != 0 );
+}
+
 TEST_CASE( "Enchantments modify stats", "[magic][enchantment][character]" )
 {
     clear_all_state();
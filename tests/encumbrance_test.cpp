@@ -16,6 +16,7 @@
 #include "material.h"
 #include "npc.h"
 #include "player.h"
+#include "player_helpers.h"
 #include "state_helpers.h"
 #include "type_id.h"
 
@@ -150,3 +151,44 @@ TEST_CASE( "tiny_character", "[encumbrance]" )
                                 add_trait( "SMALL2" ) );
     }
 }
+
+TEST_CASE( "encumbrance_recalculated_only_on_change", "[encumbrance]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    you.wear_item( item::spawn( "tshirt", calendar::turn ) );
+    you.reset_encumbrance();
+    REQUIRE_FALSE( you.get_check_encumbrance() );
+
+    SECTION( "flagged by the clothing" ) {
+        you.flag_encumbrance();
+        CHECK( you.get_check_encumbrance() );
+    }
+    SECTION( "carrying something more" ) {
+        you.i_add( item::spawn( "rock", calendar::turn ) );
+        CHECK( you.get_check_encumbrance() );
+    }
+    you.check_item_encumbrance_flag();
+    CHECK_FALSE( you.get_check_encumbrance() );
+}
+
+TEST_CASE( "refitting_worn_clothing_updates_encumbrance", "[encumbrance]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    you.wear_item( item::spawn( "greatcoat", calendar::turn ) );
+    you.reset_encumbrance();
+    const int before = you.encumb( body_part_torso );
+    REQUIRE( before == greatcoat_e );
+
+    // What the refit of a repair kit does
+    you.worn.back()->set_flag( flag_id( "FIT" ) );
+    you.check_item_encumbrance_flag();
+    CHECK( you.encumb( body_part_torso ) < before );
+
+    you.worn.back()->unset_flag( flag_id( "FIT" ) );
+    you.check_item_encumbrance_flag();
+    CHECK( you.encumb( body_part_torso ) == before );
+}
@@ -58,3 +58,32 @@ TEST_CASE( "destroy_bus_before_subscriber", "[event]" )
                   character_id( 5 ), mtype_id( "zombie" ) ) );
     CHECK( sub.events.size() == 1 );
 }
+
+struct kills_monsters_subscriber : public test_subscriber {
+    bool wants( event_type type ) const override {
+        return type == event_type::character_kills_monster;
+    }
+};
+
+TEST_CASE( "subscribers_get_only_the_events_they_want", "[event]" )
+{
+    event_bus bus;
+    test_subscriber all;
+    kills_monsters_subscriber kills;
+    bus.subscribe( &all );
+    bus.subscribe( &kills );
+
+    bus.send( cata::event::make<event_type::character_kills_character>(
+                  character_id( 5 ), character_id( 6 ), "Victim" ) );
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), mtype_id( "zombie" ) ) );
+    CHECK( all.events.size() == 2 );
+    REQUIRE( kills.events.size() == 1 );
+    CHECK( kills.events[0].type() == event_type::character_kills_monster );
+
+    bus.unsubscribe( &kills );
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), mtype_id( "zombie" ) ) );
+    CHECK( all.events.size() == 3 );
+    CHECK( kills.events.size() == 1 );
+}
@@ -0,0 +1,57 @@
+#include "catch/catch.hpp"
+
+#include "avatar.h"
+#include "calendar.h"
+#include "game.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const efftype_id effect_sleep( "sleep" );
+
+TEST_CASE( "sleeping_with_nothing_around_is_fast_forwarded", "[fast_forward]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    you.setpos( tripoint( 60, 60, 0 ) );
+    REQUIRE_FALSE( g->can_fast_forward() );
+
+    you.add_effect( effect_sleep, 8_hours );
+    CHECK( g->can_fast_forward() );
+
+    SECTION( "a hostile monster close by" ) {
+        spawn_test_monster( "mon_zombie", you.pos() + tripoint( 3, 0, 0 ) );
+        CHECK_FALSE( g->can_fast_forward() );
+    }
+    SECTION( "a hostile monster far away" ) {
+        monster &zombie = spawn_test_monster( "mon_zombie", you.pos() + tripoint( 30, 0, 0 ) );
+        // Standing around, not going anywhere
+        zombie.set_goal( zombie.pos() );
+        CHECK( g->can_fast_forward() );
+
+        zombie.wander_to( you.pos(), 50 );
+        CHECK_FALSE( g->can_fast_forward() );
+    }
+}
+
+TEST_CASE( "travelling_with_nothing_in_view_defers_the_map_cache", "[fast_forward]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    you.setpos( tripoint( 60, 60, 0 ) );
+    // Away from the turns the caches are rebuilt on anyway
+    calendar::turn = calendar::turn_zero + 3_turns;
+    REQUIRE_FALSE( g->can_defer_travel_map_cache() );
+
+    you.set_destination( { you.pos() + tripoint_east, you.pos() + tripoint( 2, 0, 0 ) } );
+    REQUIRE( you.has_destination() );
+    CHECK( g->can_defer_travel_map_cache() );
+
+    spawn_test_monster( "mon_zombie", you.pos() + tripoint( 40, 0, 0 ) );
+    CHECK_FALSE( g->can_defer_travel_map_cache() );
+}
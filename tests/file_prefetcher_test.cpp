@@ -0,0 +1,37 @@
+#include "catch/catch.hpp"
+
+#include <ostream>
+#include <string>
+
+#include "cata_utility.h"
+#include "file_prefetcher.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+
+TEST_CASE( "file prefetcher returns requested files once", "[savegame]" )
+{
+    const std::string path = g->get_world_base_save_path() + "/prefetch_test_" +
+                             get_pid_string() + ".txt";
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout << "contents";
+    } );
+
+    file_prefetcher prefetcher;
+    CHECK( !prefetcher.take( path ) );
+
+    prefetcher.request( path );
+    prefetcher.request( path );
+    CHECK( prefetcher.is_requested( path ) );
+    // Either read in the background or handed back to be read by the caller
+    const std::optional<std::string> data = prefetcher.take( path );
+    CHECK( ( !data || *data == "contents" ) );
+    CHECK( !prefetcher.is_requested( path ) );
+    CHECK( !prefetcher.take( path ) );
+
+    prefetcher.request( path + ".missing" );
+    prefetcher.clear();
+    CHECK( !prefetcher.is_requested( path + ".missing" ) );
+
+    REQUIRE( remove_file( path ) );
+}
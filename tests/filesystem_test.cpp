@@ -80,6 +80,7 @@ static void filesystem_test_group( int serial, const std::string &s1, const std:
     REQUIRE( file_exist( file1_1 ) );
     REQUIRE( read_from_file( file1_1, reader ) );
     CHECK( readbuf == writebuf );
+    CHECK( try_read_entire_file( file1_1 ) == writebuf );
     REQUIRE( rename_file( file1_1, file1_2 ) );
     REQUIRE( !rename_file( file1_1, file1_2 ) );
     REQUIRE( file_exist( file1_2 ) );
@@ -88,6 +89,8 @@ static void filesystem_test_group( int serial, const std::string &s1, const std:
     REQUIRE( !dir_exist( file1_2 ) );
     REQUIRE( remove_file( file1_2 ) );
     REQUIRE( !remove_file( file1_2 ) );
+    CHECK( !try_read_entire_file( file1_2 ) );
+    CHECK( read_entire_file( file1_2 ).empty() );
 
     // Copying file
     REQUIRE( write_to_file( file1_1, writer, nullptr ) );
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flat_hash_map.h"
+#include "point.h"
+#include "rng.h"
+#include "tripoint_map.h"
+
+TEST_CASE( "flat_hash_map_behaves_like_unordered_map", "[flat_hash_map]" )
+{
+    cata::flat_hash_map<int, std::string> flat;
+    std::map<int, std::string> reference;
+    for( int i = 0; i < 5000; i++ ) {
+        const int key = rng( -300, 300 );
+        switch( rng( 0, 3 ) ) {
+            case 0:
+                flat[key] = std::to_string( i );
+                reference[key] = std::to_string( i );
+                break;
+            case 1:
+                CHECK( flat.erase( key ) == reference.erase( key ) );
+                break;
+            case 2:
+                CHECK( flat.try_emplace( key, "emplaced" ).second ==
+                       reference.try_emplace( key, "emplaced" ).second );
+                break;
+            default:
+                CHECK( flat.contains( key ) == reference.contains( key ) );
+                break;
+        }
+        REQUIRE( flat.size() == reference.size() );
+    }
+    for( const auto &entry : reference ) {
+        const auto iter = flat.find( entry.first );
+        REQUIRE( iter != flat.end() );
+        CHECK( iter->second == entry.second );
+    }
+    const std::map<int, std::string> iterated( flat.begin(), flat.end() );
+    CHECK( iterated == reference );
+}
+
+TEST_CASE( "flat_hash_map_erasing_keeps_other_iterators_valid", "[flat_hash_map]" )
+{
+    cata::flat_hash_map<int, std::unique_ptr<int>> flat;
+    for( int i = 0; i < 100; i++ ) {
+        flat.emplace( i, std::make_unique<int>( i ) );
+    }
+    const auto kept = flat.find( 42 );
+    for( auto iter = flat.begin(); iter != flat.end(); ) {
+        if( iter->first % 2 == 1 ) {
+            iter = flat.erase( iter );
+        } else {
+            ++iter;
+        }
+    }
+    CHECK( flat.size() == 50 );
+    CHECK( *kept->second == 42 );
+    CHECK_THROWS( flat.at( 43 ) );
+
+    flat.clear();
+    CHECK( flat.empty() );
+    CHECK( flat.begin() == flat.end() );
+}
+
+TEST_CASE( "tripoint_set_and_packed_keys", "[flat_hash_map][tripoint]" )
+{
+    CHECK( cata::pack_tripoint( tripoint( 1, 2, 3 ) ) != cata::pack_tripoint( tripoint( 2, 1, 3 ) ) );
+    CHECK( cata::pack_tripoint( tripoint( -1, 0, 0 ) ) != cata::pack_tripoint( tripoint( 0, -1, 0 ) ) );
+    CHECK( cata::pack_tripoint( tripoint( 0, 0, -1 ) ) != cata::pack_tripoint( tripoint_zero ) );
+
+    cata::tripoint_set points;
+    for( int x = -20; x < 20; x++ ) {
+        for( int z = -10; z <= 10; z++ ) {
+            points.insert( tripoint( x * 1000, -x, z ) );
+        }
+    }
+    CHECK( points.size() == 40 * 21 );
+    CHECK( points.contains( tripoint( -20000, 20, -10 ) ) );
+    CHECK_FALSE( points.contains( tripoint( -20000, 20, 11 ) ) );
+    CHECK_FALSE( points.insert( tripoint( 0, 0, 0 ) ).second );
+}
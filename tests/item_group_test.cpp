@@ -1,9 +1,11 @@
 #include <algorithm>
+#include <map>
 #include <utility>
 #include <vector>
 
 #include "catch/catch.hpp"
 
+#include "calendar.h"
 #include "flag.h"
 #include "item.h"
 #include "item_group.h"
@@ -176,3 +178,33 @@ TEST_CASE( "item_modifier modifies charges for item", "[item_group]" )
         }
     }
 }
+
+TEST_CASE( "distribution rolls land on entries in proportion to their probability", "[item_group]" )
+{
+    Item_group group( Item_group::G_DISTRIBUTION, 100, 0, 0 );
+    group.add_item_entry( itype_id( "rock" ), 10 );
+    group.add_item_entry( itype_id( "stick" ), 30 );
+    group.add_item_entry( itype_id( "pebble" ), 60 );
+
+    const auto roll_many = [&group]() {
+        std::map<itype_id, int> counts;
+        Item_spawn_data::RecursionList rec;
+        for( int i = 0; i < 10000; i++ ) {
+            for( detached_ptr<item> &it : group.create( calendar::turn, rec ) ) {
+                counts[it->typeId()]++;
+            }
+        }
+        return counts;
+    };
+
+    std::map<itype_id, int> counts = roll_many();
+    CHECK( counts[itype_id( "rock" )] == Approx( 1000 ).margin( 200 ) );
+    CHECK( counts[itype_id( "stick" )] == Approx( 3000 ).margin( 300 ) );
+    CHECK( counts[itype_id( "pebble" )] == Approx( 6000 ).margin( 300 ) );
+
+    group.remove_item( itype_id( "stick" ) );
+    counts = roll_many();
+    CHECK( counts[itype_id( "stick" )] == 0 );
+    CHECK( counts[itype_id( "rock" )] == Approx( 10000 / 7 ).margin( 250 ) );
+    CHECK( counts[itype_id( "pebble" )] == Approx( 60000 / 7 ).margin( 250 ) );
+}
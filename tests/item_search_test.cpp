@@ -0,0 +1,38 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "item.h"
+#include "item_search.h"
+#include "string_utils.h"
+
+TEST_CASE( "item filters match names and exclusions", "[item][item_search]" )
+{
+    const detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+    const detached_ptr<item> hammer = item::spawn( "hammer", calendar::turn );
+
+    CHECK( item_filter_from_string( "ROCK" )( *rock ) );
+    CHECK_FALSE( item_filter_from_string( "rock" )( *hammer ) );
+    CHECK_FALSE( item_filter_from_string( "-rock" )( *rock ) );
+    CHECK( item_filter_from_string( "-rock" )( *hammer ) );
+    CHECK( item_filter_from_string( "rock,hammer" )( *hammer ) );
+    CHECK_FALSE( item_filter_from_string( "hammer,-ham" )( *hammer ) );
+}
+
+TEST_CASE( "lcmatcher matches like lcmatch", "[item_search]" )
+{
+    const lcmatcher match( "RoCk" );
+    CHECK( match( "a small rock" ) );
+    CHECK( match( "ROCKS" ) );
+    CHECK_FALSE( match( "roc" ) );
+    CHECK( lcmatcher( "" )( "" ) );
+    CHECK( lcmatcher( "" )( "rock" ) );
+}
+
+TEST_CASE( "item filters with several parts don't depend on their order", "[item][item_search]" )
+{
+    const detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+    CHECK( item_filter_from_string( "d:nothing,c:spare,rock" )( *rock ) ==
+           item_filter_from_string( "rock,c:spare,d:nothing" )( *rock ) );
+    CHECK_FALSE( item_filter_from_string( "hammer,-rock" )( *rock ) );
+    CHECK_FALSE( item_filter_from_string( "," )( *rock ) );
+}
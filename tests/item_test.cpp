@@ -35,6 +35,40 @@ TEST_CASE( "item_volume", "[item]" )
     }
 }
 
+TEST_CASE( "measures_are_remembered_only_while_asked_to", "[item]" )
+{
+    item &bag = *item::spawn_temporary( "bag_plastic" );
+    bag.put_in( item::spawn( "rock" ) );
+    const units::mass with_rock = bag.weight();
+    const units::volume volume_with_rock = bag.volume();
+    {
+        const scoped_item_measure_cache measures;
+        CHECK( bag.weight() == with_rock );
+        CHECK( bag.volume() == volume_with_rock );
+        bag.put_in( item::spawn( "rock" ) );
+        // Nothing is supposed to change while the measures are remembered
+        CHECK( bag.weight() == with_rock );
+        CHECK( bag.volume() == volume_with_rock );
+    }
+    CHECK( bag.weight() > with_rock );
+    CHECK( bag.weight() == bag.weight( false ) + 2 * item::spawn_temporary( "rock" )->weight() );
+}
+
+TEST_CASE( "names_are_remembered_only_while_asked_to", "[item]" )
+{
+    item &bottle = *item::spawn_temporary( "bottle_plastic" );
+    const std::string empty_bottle = bottle.tname();
+    {
+        const scoped_item_name_cache names;
+        CHECK( bottle.tname() == empty_bottle );
+        CHECK( bottle.tname( 2 ) != empty_bottle );
+        bottle.put_in( item::spawn( "water" ) );
+        // Nothing is supposed to change while the names are remembered
+        CHECK( bottle.tname() == empty_bottle );
+    }
+    CHECK( bottle.tname() != empty_bottle );
+}
+
 TEST_CASE( "simple_item_layers", "[item]" )
 {
     CHECK( item::spawn_temporary( "arm_warmers" )->get_layer() == UNDERWEAR_LAYER );
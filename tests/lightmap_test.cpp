@@ -0,0 +1,161 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "calendar.h"
+#include "character.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "options_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "shadowcasting.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const time_point midnight = calendar::turn_zero + 0_hours;
+static const time_point midday = calendar::turn_zero + 12_hours;
+
+static std::vector<float> lightmap_of( const map &here, int z )
+{
+    const level_cache &cache = here.access_cache( z );
+    std::vector<float> result;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const four_quadrants &lm = cache.lm[x][y];
+            result.insert( result.end(), lm.values.begin(), lm.values.end() );
+            result.push_back( cache.sm[x][y] );
+        }
+    }
+    return result;
+}
+
+static std::vector<float> transparency_of( const map &here, int z )
+{
+    const level_cache &cache = here.access_cache( z );
+    return std::vector<float>( &cache.transparency_cache[0][0],
+                               &cache.transparency_cache[0][0] + MAPSIZE_X * MAPSIZE_Y );
+}
+
+static std::vector<int> pathfinding_of( const map &here, int z )
+{
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( z );
+    std::vector<int> result;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            result.push_back( cache.special[x][y] );
+            result.push_back( cache.area[x][y] );
+        }
+    }
+    return result;
+}
+
+// What generate_lightmap produces when it can't reuse anything
+static std::vector<float> rebuilt_lightmap_of( map &here, int z )
+{
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+    return lightmap_of( here, z );
+}
+
+TEST_CASE( "kept lightmap matches a full rebuild", "[lightmap][vision]" )
+{
+    clear_all_state();
+    override_option verify( "VERIFY_LIGHTMAP", "true" );
+    map &here = get_map();
+    set_time( midnight );
+    const tripoint lamp = get_player_character().pos() + point( 4, 2 );
+    const int z = lamp.z;
+
+    here.ter_set( lamp, ter_id( "t_utility_light" ) );
+    CAPTURE( lamp );
+    const std::vector<float> lit = rebuilt_lightmap_of( here, z );
+
+    SECTION( "unchanged turn keeps the lightmap" ) {
+        // Checked against a rebuild by the option
+        here.build_map_cache( z );
+        CHECK( lightmap_of( here, z ) == lit );
+    }
+
+    SECTION( "moved light" ) {
+        here.ter_set( lamp, t_floor );
+        here.ter_set( lamp + point_east, ter_id( "t_utility_light" ) );
+        here.build_map_cache( z );
+        const std::vector<float> updated = lightmap_of( here, z );
+        CHECK( updated != lit );
+        CHECK( updated == rebuilt_lightmap_of( here, z ) );
+    }
+
+    SECTION( "wall next to the light" ) {
+        here.ter_set( lamp + point_west, ter_id( "t_brick_wall" ) );
+        here.build_map_cache( z );
+        const std::vector<float> updated = lightmap_of( here, z );
+        CHECK( updated != lit );
+        CHECK( updated == rebuilt_lightmap_of( here, z ) );
+    }
+}
+
+TEST_CASE( "sunlight cast from changed tiles matches a full rebuild", "[lightmap][vision]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+    set_time( midday );
+    const tripoint roof = get_player_character().pos() + tripoint( 3, 3, 1 );
+    const int z = roof.z - 1;
+
+    // A small roofed shelter, so the level below has to be cast tile by tile
+    for( const tripoint &p : here.points_in_radius( roof, 2 ) ) {
+        here.ter_set( p, t_floor );
+    }
+    const std::vector<float> lit = rebuilt_lightmap_of( here, z );
+
+    SECTION( "roof tile removed" ) {
+        here.ter_set( roof, t_open_air );
+        here.build_map_cache( z );
+        const std::vector<float> updated = lightmap_of( here, z );
+        CHECK( updated != lit );
+        CHECK( updated == rebuilt_lightmap_of( here, z ) );
+    }
+
+    SECTION( "roof extended" ) {
+        here.ter_set( roof + point( 3, 0 ), t_floor );
+        here.build_map_cache( z );
+        const std::vector<float> updated = lightmap_of( here, z );
+        CHECK( updated != lit );
+        CHECK( updated == rebuilt_lightmap_of( here, z ) );
+    }
+}
+
+TEST_CASE( "caches moved by a map shift match a full rebuild", "[lightmap][vision][pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+    set_time( midday );
+    // A roofed shelter and a wall next to a submap edge, so they move from one submap to another
+    const tripoint roof = get_player_character().pos() + tripoint( SEEX, 3, 1 );
+    const int z = roof.z - 1;
+    for( const tripoint &p : here.points_in_radius( roof, 2 ) ) {
+        here.ter_set( p, t_floor );
+    }
+    here.ter_set( roof + tripoint( 0, 4, -1 ), ter_id( "t_brick_wall" ) );
+    rebuilt_lightmap_of( here, z );
+    static_cast<void>( pathfinding_of( here, z ) );
+
+    const point shift = GENERATE( point_east, point_north_west );
+    CAPTURE( shift );
+    here.shift( shift );
+    here.build_map_cache( z );
+    const std::vector<float> lit = lightmap_of( here, z );
+    const std::vector<float> transparency = transparency_of( here, z );
+    const std::vector<int> pathfinding = pathfinding_of( here, z );
+
+    CHECK( lit == rebuilt_lightmap_of( here, z ) );
+    CHECK( transparency == transparency_of( here, z ) );
+    here.set_pathfinding_cache_dirty( z );
+    CHECK( pathfinding == pathfinding_of( here, z ) );
+}
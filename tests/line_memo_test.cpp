@@ -0,0 +1,105 @@
+#include "catch/catch.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "line_memo.h"
+#include "map.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+TEST_CASE( "line memo remembers results until cleared", "[map]" )
+{
+    line_memo memo;
+    const std::optional<std::uint64_t> a = line_memo::key( { 1, 2, 0 }, { 3, 4, 0 } );
+    const std::optional<std::uint64_t> b = line_memo::key( { 3, 4, 0 }, { 1, 2, 0 } );
+    REQUIRE( a );
+    REQUIRE( b );
+    CHECK( *a != *b );
+    CHECK( !line_memo::key( { -1, 2, 0 }, { 3, 4, 0 } ) );
+    CHECK( !line_memo::key( { 1, 2, 0 }, { 3, 4, 0 }, 0, 1000 ) );
+
+    CHECK( memo.get( *a ) == -1 );
+    memo.insert( *a, true );
+    memo.insert( *b, false );
+    CHECK( memo.get( *a ) == 1 );
+    CHECK( memo.get( *b ) == 0 );
+    memo.clear();
+    CHECK( memo.get( *a ) == -1 );
+}
+
+TEST_CASE( "clear path notices terrain changes", "[map]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 65, 60, 0 );
+    REQUIRE( here.clear_path( from, to, 10, 1, 100 ) );
+
+    here.ter_set( from + point( 2, 0 ), ter_id( "t_brick_wall" ) );
+    CHECK( !here.clear_path( from, to, 10, 1, 100 ) );
+
+    here.ter_set( from + point( 2, 0 ), t_floor );
+    CHECK( here.clear_path( from, to, 10, 1, 100 ) );
+}
+
+TEST_CASE( "line of sight results are shared between vision ranges", "[map][vision]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 66, 63, 0 );
+    line_memo &memo = here.get_sees_cache();
+    memo.clear();
+    memo.reset_stats();
+
+    REQUIRE( here.sees( from, to, 60 ) );
+    CHECK( memo.misses() == 1 );
+    CHECK( memo.hits() == 0 );
+
+    // A different observer on the same square with shorter night vision
+    CHECK( here.sees( from, to, 8 ) );
+    // Or looking back the other way
+    CHECK( here.sees( to, from, 10 ) );
+    CHECK( memo.hits() == 2 );
+    // Ranges are checked before the cache
+    CHECK( !here.sees( from, to, 3 ) );
+    CHECK( memo.hits() == 2 );
+    CHECK( memo.misses() == 1 );
+}
+
+TEST_CASE( "lines of sight checked together match single checks", "[map][vision]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint origin( 60, 60, 0 );
+    for( int y = -5; y <= 5; y += 2 ) {
+        here.ter_set( origin + point( 3, y ), ter_id( "t_brick_wall" ) );
+    }
+    here.build_map_cache( 0 );
+    std::vector<std::pair<tripoint, tripoint>> lines;
+    for( int x = -8; x <= 8; x += 3 ) {
+        for( int y = -8; y <= 8; y++ ) {
+            lines.emplace_back( origin, origin + point( x, y ) );
+        }
+    }
+    std::vector<bool> single;
+    line_memo &memo = here.get_sees_cache();
+    memo.clear();
+    for( const std::pair<tripoint, tripoint> &line : lines ) {
+        single.push_back( here.sees( line.first, line.second, 60 ) );
+    }
+
+    memo.clear();
+    here.sees_batch( lines );
+    memo.reset_stats();
+    for( size_t i = 0; i < lines.size(); i++ ) {
+        CAPTURE( lines[i].second );
+        CHECK( here.sees( lines[i].first, lines[i].second, 60 ) == single[i] );
+    }
+    CHECK( memo.misses() == 0 );
+}
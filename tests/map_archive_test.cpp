@@ -0,0 +1,80 @@
+#include "catch/catch.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "map_archive.h"
+
+static segment_archive::record make_record( const tripoint &om_addr, const std::string &data )
+{
+    segment_archive::record rec;
+    rec.om_addr = om_addr;
+    rec.format = segment_archive::record_format::binary;
+    rec.data = data;
+    return rec;
+}
+
+TEST_CASE( "segment archive keeps the latest record of each quad", "[savegame]" )
+{
+    const std::string path = g->get_world_base_save_path() + "/segment_archive_test_" +
+                             get_pid_string() + ".seg";
+    const tripoint first( 1, 2, 0 );
+    const tripoint second( 3, 4, 0 );
+    // Long enough that dropping it outweighs the index a compacted file starts with
+    const std::string old_data( 256, 'o' );
+    {
+        segment_archive archive( path );
+        CHECK( !archive.contains( first ) );
+        archive.append( { make_record( first, old_data ), make_record( second, "second" ) } );
+        archive.append( { make_record( first, "new" ) } );
+        CHECK( archive.read( first )->data == "new" );
+    }
+
+    SECTION( "appended records are found after reopening" ) {
+        segment_archive archive( path );
+        CHECK( archive.read( first )->data == "new" );
+        CHECK( archive.read( second )->data == "second" );
+        CHECK( archive.read( first )->format == segment_archive::record_format::binary );
+        CHECK( !archive.read( tripoint_zero ) );
+    }
+
+    SECTION( "compaction keeps only live records" ) {
+        segment_archive archive( path );
+        const std::string before = read_entire_file( path );
+        archive.compact();
+        CHECK( read_entire_file( path ).size() < before.size() );
+        CHECK( archive.read( first )->data == "new" );
+
+        segment_archive reopened( path );
+        CHECK( reopened.read( first )->data == "new" );
+        CHECK( reopened.read( second )->data == "second" );
+        CHECK( !reopened.needs_compaction() );
+    }
+
+    SECTION( "truncated tail is dropped" ) {
+        write_to_file( path, [&]( std::ostream & fout ) {
+            const std::string data = read_entire_file( path );
+            fout << data.substr( 0, data.size() - 2 );
+        } );
+        std::string msg = capture_debugmsg_during( [&]() {
+            segment_archive archive( path );
+            CHECK( archive.needs_compaction() );
+            CHECK( archive.read( first )->data == old_data );
+            archive.append( { make_record( second, "replaced" ) } );
+            CHECK( !archive.needs_compaction() );
+        } );
+        CHECK( msg.find( "truncated" ) != std::string::npos );
+
+        segment_archive reopened( path );
+        CHECK( reopened.read( first )->data == old_data );
+        CHECK( reopened.read( second )->data == "replaced" );
+    }
+
+    REQUIRE( remove_file( path ) );
+}
@@ -75,7 +75,76 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    mm_region region;
+    for( auto &column : region.submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
+            sm = make_shared_fast<mm_submap>();
+        }
+    }
+    const memorized_terrain_tile grass{ "t_grass", 1, 2 };
+    const memorized_terrain_tile wall{ "t_wall", 0, 3 };
+    mm_submap &uniform = *region.submaps[0][0];
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            uniform.set_tile( point( x, y ), grass );
+        }
+    }
+    mm_submap &mixed = *region.submaps[2][1];
+    mixed.set_tile( point( 3, 4 ), wall );
+    mixed.set_symbol( point( 5, 6 ), 'x' );
+
+    std::ostringstream out;
+    JsonOut jsout( out );
+    region.serialize( jsout );
+
+    std::istringstream in( out.str() );
+    JsonIn jsin( in );
+    mm_region loaded;
+    loaded.deserialize( jsin );
+
+    CHECK( loaded.submaps[0][0]->tile( point( 7, 8 ) ) == grass );
+    CHECK( loaded.submaps[2][1]->tile( point( 3, 4 ) ) == wall );
+    CHECK( loaded.submaps[2][1]->tile( point( 4, 4 ) ) == mm_submap::default_tile );
+    CHECK( loaded.submaps[2][1]->symbol( point( 5, 6 ) ) == 'x' );
+    CHECK( loaded.submaps[1][1]->is_empty() );
+}
+
+TEST_CASE( "map_memory_region_tracks_changes", "[map_memory]" )
+{
+    mm_region region;
+    for( auto &column : region.submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
+            sm = make_shared_fast<mm_submap>();
+        }
+    }
+    CHECK_FALSE( region.is_dirty() );
+    // Already what the submap holds
+    region.submaps[1][2]->set_symbol( point( 3, 4 ), mm_submap::default_symbol );
+    region.submaps[1][2]->set_tile( point( 3, 4 ), mm_submap::default_tile );
+    CHECK_FALSE( region.is_dirty() );
+    region.submaps[1][2]->set_symbol( point( 3, 4 ), 'x' );
+    CHECK( region.is_dirty() );
+}
+
+TEST_CASE( "map_memory_loads_legacy_regions", "[map_memory]" )
+{
+    std::string data = "[[[\"t_dirt\",0,1,35,144]]";
+    for( int i = 1; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+        data += ",null";
+    }
+    data += "]";
+    std::istringstream in( data );
+    JsonIn jsin( in );
+    mm_region loaded;
+    loaded.deserialize( jsin );
+
+    const memorized_terrain_tile dirt{ "t_dirt", 0, 1 };
+    CHECK( loaded.submaps[0][0]->tile( point( 11, 11 ) ) == dirt );
+    CHECK( loaded.submaps[0][0]->symbol( point( 0, 0 ) ) == 35 );
+    CHECK( loaded.submaps[1][0]->is_empty() );
+}
 
 #include <chrono>
 
@@ -1,5 +1,6 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -9,8 +10,10 @@
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
 #include "point.h"
 #include "state_helpers.h"
+#include "submap.h"
 #include "type_id.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
@@ -75,6 +78,35 @@ TEST_CASE( "tinymap_bounds_checking" )
     }
 }
 
+TEST_CASE( "for_each_tile_visits_the_clipped_area_once" )
+{
+    clear_all_state();
+    tinymap m;
+    m.load( tripoint_zero, false );
+    const tripoint from( -3, 5, 0 );
+    const tripoint to( SEEX + 2, SEEY * 2 + 4, 0 );
+    const tripoint marked( SEEX + 1, SEEY + 2, 0 );
+    m.ter_set( marked, ter_id( "t_rock" ) );
+    std::vector<tripoint> seen;
+    std::vector<tripoint> rocks;
+    bool matches = true;
+    m.for_each_tile( to, from, [&]( const submap & sm, point l, const tripoint & p ) {
+        seen.push_back( p );
+        matches &= sm.get_ter( l ) == m.ter( p ) && sm.get_furn( l ) == m.furn( p );
+        if( sm.get_ter( l ) == ter_id( "t_rock" ) ) {
+            rocks.push_back( p );
+        }
+    } );
+    CHECK( matches );
+    CHECK( std::find( rocks.begin(), rocks.end(), marked ) != rocks.end() );
+
+    std::vector<tripoint> expected;
+    for( const tripoint &p : m.points_in_rectangle( from, to ) ) {
+        expected.push_back( p );
+    }
+    CHECK_THAT( seen, Catch::UnorderedEquals( expected ) );
+}
+
 TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
 {
     clear_all_state();
@@ -0,0 +1,51 @@
+#include "catch/catch.hpp"
+
+#include <iterator>
+#include <memory>
+
+#include "coordinate_conversions.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "point.h"
+#include "submap.h"
+
+static void add_uniform_quad( const tripoint &om_addr )
+{
+    const tripoint sm_addr = omt_to_sm_copy( om_addr );
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        // Uniform quads are regenerated instead of saved, so nothing is written to disk
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_addr + offset );
+        sm->is_uniform = true;
+        REQUIRE( MAPBUFFER.add_submap( sm_addr + offset, sm ) );
+    }
+}
+
+TEST_CASE( "mapbuffer evicts least recently used quads first", "[savegame]" )
+{
+    clear_map();
+    // Start from just the reality bubble
+    MAPBUFFER.evict_least_recently_used( 0 );
+    const tripoint origin = get_map().get_abs_sub();
+    const tripoint far_omt = sm_to_omt_copy( origin ) + tripoint( 100, 100, 0 );
+    const tripoint older = far_omt;
+    const tripoint newer = far_omt + point_east;
+    add_uniform_quad( older );
+    add_uniform_quad( newer );
+    // Using the first quad makes it the most recent one
+    REQUIRE( MAPBUFFER.lookup_submap( omt_to_sm_copy( older ) ) != nullptr );
+
+    const std::size_t loaded = std::distance( MAPBUFFER.begin(), MAPBUFFER.end() );
+    CHECK( MAPBUFFER.evict_least_recently_used( loaded - 4 ) == 4 );
+    CHECK( MAPBUFFER.is_submap_loaded( omt_to_sm_copy( older ) ) );
+    CHECK( !MAPBUFFER.is_submap_loaded( omt_to_sm_copy( newer ) ) );
+
+    // The reality bubble stays no matter how small the budget is
+    MAPBUFFER.evict_least_recently_used( 0 );
+    CHECK( !MAPBUFFER.is_submap_loaded( omt_to_sm_copy( older ) ) );
+    CHECK( MAPBUFFER.is_submap_loaded( origin ) );
+    CHECK( MAPBUFFER.is_submap_loaded( origin + point( MAPSIZE - 1, MAPSIZE - 1 ) ) );
+}
@@ -1,6 +1,14 @@
 #include "catch/catch.hpp"
 
+#include <string>
+
+#include "calendar.h"
+#include "map.h"
+#include "map_helpers.h"
 #include "mapgen.h"
+#include "mapgen_stats.h"
+#include "point.h"
+#include "state_helpers.h"
 #include "type_id.h"
 
 TEST_CASE( "connects_to", "[mapgen][connects]" )
@@ -88,3 +96,30 @@ TEST_CASE( "connects_to", "[mapgen][connects]" )
         CHECK( connects_to( oter_id( "sewer_nesw" ), west ) );
     }
 }
+
+TEST_CASE( "mapgen statistics count placements by kind and id", "[mapgen]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_pavement" ) );
+    mapgen_stats::reset();
+    const std::string trash( "trash" );
+    for( int i = 0; i < 3; i++ ) {
+        get_map().place_items( item_group_id( trash ), 100, tripoint( 50, 50, 0 ),
+                               tripoint( 60, 60, 0 ), false, calendar::turn );
+    }
+    {
+        const mapgen_stats::timer timer( mapgen_kind::nested, "test_chunk" );
+    }
+
+    CHECK( mapgen_stats::count( mapgen_kind::items, trash ) == 3 );
+    CHECK( mapgen_stats::count( mapgen_kind::nested, "test_chunk" ) == 1 );
+    CHECK( mapgen_stats::count( mapgen_kind::json, trash ) == 0 );
+    CHECK( mapgen_stats::report( 1 ).find( '\n' ) == mapgen_stats::report( 1 ).size() - 1 );
+    const std::string csv = mapgen_stats::csv();
+    CHECK( csv.find( "items,trash,3," ) != std::string::npos );
+    CHECK( csv.find( "nested,test_chunk,1," ) != std::string::npos );
+
+    mapgen_stats::reset();
+    CHECK( mapgen_stats::count( mapgen_kind::items, trash ) == 0 );
+    CHECK( mapgen_stats::report( 10 ).empty() );
+}
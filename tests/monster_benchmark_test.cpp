@@ -0,0 +1,109 @@
+#include "catch/catch.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "calendar.h"
+#include "character.h"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "monster_turn_stats.h"
+#include "pathfinding_stats.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "type_id.h"
+
+// Timings of the monsters' turns around the player, split by what they spend it on,
+// so they can be compared between commits.
+// Run with: cata_test "[monster][benchmark]"
+
+static constexpr int benchmark_turns = 20;
+
+static void build_fenced_field( map &here, const tripoint &center )
+{
+    // Fences every few tiles with gaps in them, so monsters have to go around
+    const ter_id fence( "t_chainfence" );
+    for( int x = -50; x <= 50; x += 10 ) {
+        for( int y = -50; y <= 50; y++ ) {
+            if( std::abs( y ) % 15 != 7 ) {
+                here.ter_set( center + point( x, y ), fence );
+            }
+        }
+    }
+}
+
+static void spawn_horde( int count, const tripoint &center )
+{
+    // Walkers, fast ones, ones with special attacks, flyers, and animals the zombies hunt
+    static const std::array<std::string, 6> types = {{
+            "mon_zombie", "mon_zombie_dog", "mon_zombie_smoker", "mon_manhack", "mon_dog", "mon_pig"
+        }
+    };
+    map &here = get_map();
+    int spawned = 0;
+    // Visits every tile of the square around the player once, in an order that spreads
+    // the monsters over all of it
+    constexpr int side = 111;
+    for( int i = 0; spawned < count && i < side * side; i++ ) {
+        const int tile = i * 7919 % ( side * side );
+        const tripoint p = center + point( tile % side - side / 2, tile / side - side / 2 );
+        if( rl_dist( p, center ) < 4 || !here.passable( p ) || !g->is_empty( p ) ) {
+            continue;
+        }
+        spawn_test_monster( types[spawned % types.size()], p );
+        spawned++;
+    }
+    REQUIRE( spawned == count );
+}
+
+static void monster_turn_benchmark( int count )
+{
+    clear_all_state();
+    map &here = get_map();
+    Character &you = get_player_character();
+    const tripoint center = you.pos();
+    build_fenced_field( here, center );
+    spawn_horde( count, center );
+    rng_set_engine_seed( 4242424242 );
+
+    monster_turn_stats::reset();
+    pathfinding_stats::reset();
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < benchmark_turns; turn++ ) {
+        // The horde is here to be timed, not to end the run early
+        you.set_all_parts_hp_to_max();
+        g->monmove();
+        calendar::turn += 1_turns;
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start ).count();
+
+    const pathfinding_stats::totals routes = pathfinding_stats::get( route_scale::map,
+            route_caller::monster );
+    cata_printf( "%d monsters, %d turns: %.3f ms, %.3f ms per turn\n", count, benchmark_turns,
+                 total_ms, total_ms / benchmark_turns );
+    cata_printf( "%sroute: %.3f ms in %d searches\n", monster_turn_stats::report(),
+                 routes.microseconds / 1000.0, routes.searches );
+    CHECK( monster_turn_stats::count( monster_phase::plan ) > 0 );
+    CHECK( monster_turn_stats::count( monster_phase::move ) > 0 );
+}
+
+TEST_CASE( "monster_turn_benchmark", "[.][monster][benchmark]" )
+{
+    SECTION( "100 monsters" ) {
+        monster_turn_benchmark( 100 );
+    }
+    SECTION( "500 monsters" ) {
+        monster_turn_benchmark( 500 );
+    }
+    SECTION( "2000 monsters" ) {
+        monster_turn_benchmark( 2000 );
+    }
+}
@@ -354,3 +354,23 @@ TEST_CASE( "monster_move_through_vehicle_holes" )
     CHECK( m2 == nullptr );
 
 }
+
+TEST_CASE( "remembered monster moves follow terrain changes", "[monster][pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    // Clear of the player
+    const tripoint origin = get_avatar().pos() + point( 10, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", origin );
+    monster &other = spawn_test_monster( "mon_zombie", origin + point_south );
+    const tripoint target = origin + point_east;
+    CHECK( zombie.will_move_to( target ) );
+    CHECK( other.will_move_to( target ) );
+
+    here.ter_set( target, t_rock_wall );
+    CHECK_FALSE( zombie.will_move_to( target ) );
+    CHECK_FALSE( other.will_move_to( target ) );
+
+    here.ter_set( target, t_floor );
+    CHECK( other.will_move_to( target ) );
+}
@@ -191,3 +191,20 @@ TEST_CASE( "Mutating with full mutagen accumulation results in multiple mutation
         }
     }
 }
+
+TEST_CASE( "has_trait follows gained and lost mutations", "[mutations]" )
+{
+    const trait_id trait_fleet( "FLEET" );
+    const trait_id trait_goodhearing( "GOODHEARING" );
+    REQUIRE( mutation_branch::get_index( trait_fleet ) >= 0 );
+    CHECK( mutation_branch::get_index( trait_id( "not_a_real_trait" ) ) == -1 );
+
+    npc dummy;
+    CHECK_FALSE( dummy.has_trait( trait_fleet ) );
+    dummy.set_mutation( trait_fleet );
+    CHECK( dummy.has_trait( trait_fleet ) );
+    CHECK_FALSE( dummy.has_trait( trait_goodhearing ) );
+    CHECK_FALSE( dummy.has_trait( trait_id( "not_a_real_trait" ) ) );
+    dummy.unset_mutation( trait_fleet );
+    CHECK_FALSE( dummy.has_trait( trait_fleet ) );
+}
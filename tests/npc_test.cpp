@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "avatar.h"
 #include "calendar.h"
 #include "faction.h"
 #include "field.h"
@@ -21,6 +22,7 @@
 #include "npc.h"
 #include "npc_class.h"
 #include "numeric_interval.h"
+#include "options_helpers.h"
 #include "overmapbuffer.h"
 #include "pimpl.h"
 #include "player_helpers.h"
@@ -508,3 +510,73 @@ TEST_CASE( "random npc spawn chance" )
     CHECK( npc_overmap::spawn_chance_in_hour( 4 * days_in_year, 1.0 ) == Approx( 0.25 / 24.0 ) );
     CHECK( npc_overmap::spawn_chance_in_hour( 8 * days_in_year, 1.0 ) == Approx( 0.125 / 24.0 ) );
 }
+
+TEST_CASE( "npc_continues_along_its_path_without_deciding", "[npc]" )
+{
+    clear_all_state();
+    g->faction_manager_ptr->create_if_needed();
+    clear_npcs();
+    clear_creatures();
+
+    Character &player_character = get_player_character();
+    npc &guy = spawn_npc( player_character.pos().xy() + point( 10, 0 ), "thug" );
+    guy.set_attitude( NPCATT_NULL );
+    const tripoint start = guy.pos();
+    REQUIRE_FALSE( guy.in_danger() );
+
+    SECTION( "with nowhere to go it has nothing to continue" ) {
+        guy.path.clear();
+        CHECK_FALSE( guy.continue_action() );
+        CHECK( guy.pos() == start );
+    }
+
+    SECTION( "it takes the next step of its path" ) {
+        guy.path = { start + tripoint_east, start + tripoint_east * 2 };
+        guy.set_moves( 100 );
+        CHECK( guy.continue_action() );
+        CHECK( guy.pos() == start + tripoint_east );
+        CHECK( guy.path.size() == 1 );
+    }
+}
+
+TEST_CASE( "npc_decisions_are_shared_out_by_count", "[npc]" )
+{
+    clear_all_state();
+    g->faction_manager_ptr->create_if_needed();
+    clear_npcs();
+    clear_creatures();
+    override_option budget( "NPC_AI_BUDGET", "1" );
+
+    const point origin = get_player_character().pos().xy();
+    std::vector<npc *> guys;
+    for( int i = 0; i < 3; i++ ) {
+        npc &guy = spawn_npc( origin + point( 30 + 3 * i, 0 ), "thug" );
+        guy.set_attitude( NPCATT_NULL );
+        guys.push_back( &guy );
+    }
+
+    g->monmove();
+    int deferred = 0;
+    for( const npc *guy : guys ) {
+        deferred += guy->deferred_turns;
+    }
+    // Only one of the distant NPCs gets to decide, however long that takes
+    CHECK( deferred == 2 );
+}
+
+TEST_CASE( "npc_sizes_up_characters_again_each_turn", "[npc]" )
+{
+    clear_all_state();
+    g->faction_manager_ptr->create_if_needed();
+    clear_npcs();
+
+    avatar &you = get_avatar();
+    npc &guy = spawn_npc( you.pos().xy() + point( 5, 0 ), "thug" );
+    guy.regen_ai_cache();
+    const float unarmed = guy.character_danger( you );
+    CHECK( guy.character_danger( you ) == unarmed );
+
+    arm_character( you, "glock_19" );
+    calendar::turn += 1_turns;
+    CHECK( guy.character_danger( you ) > unarmed );
+}
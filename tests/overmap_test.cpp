@@ -1,15 +1,23 @@
 #include "catch/catch.hpp"
 
 #include <algorithm>
+#include <istream>
 #include <memory>
+#include <ostream>
+#include <string>
 #include <vector>
 
 #include "calendar.h"
+#include "cata_utility.h"
 #include "enums.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
 #include "game_constants.h"
 #include "numeric_interval.h"
 #include "omdata.h"
 #include "overmap.h"
+#include "overmap_location.h"
 #include "overmap_special.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
@@ -213,3 +221,110 @@ TEST_CASE( "mutable_overmap_placement", "[overmap][slow]" )
         CHECK( successes > num_trials_per_overmap / 2 );
     }
 }
+
+TEST_CASE( "overmap_binary_round_trip", "[overmap]" )
+{
+    clear_all_state();
+    const oter_id field( "field" );
+    const oter_id forest( "forest" );
+    overmap original( point_abs_om( 7, 8 ) );
+    original.ter_set( tripoint_om_omt( 3, 4, 0 ), forest );
+    original.ter_set( tripoint_om_omt( 5, 6, -3 ), field );
+    const time_point tp = calendar::turn_zero + time_duration::from_turns( 50 );
+    original.set_scent( { 75, 85, 0 }, scent_trace( tp, 90 ) );
+
+    const std::string path = g->get_world_base_save_path() + "/overmap_binary_test_" +
+                             get_pid_string() + ".bin";
+    write_to_file( path, [&]( std::ostream & fout ) {
+        original.serialize_binary( fout );
+    } );
+
+    overmap loaded( point_abs_om( 7, 8 ) );
+    REQUIRE( read_from_file( path, [&]( std::istream & fin ) {
+        loaded.unserialize_binary( fin, path );
+    } ) );
+    CHECK( loaded.ter( tripoint_om_omt( 3, 4, 0 ) ) == forest );
+    CHECK( loaded.ter( tripoint_om_omt( 4, 4, 0 ) ) == original.ter( tripoint_om_omt( 4, 4, 0 ) ) );
+    // Read lazily from the file on first access
+    CHECK( loaded.ter( tripoint_om_omt( 5, 6, -3 ) ) == field );
+    CHECK( loaded.ter( tripoint_om_omt( 5, 7, -3 ) ) == oter_id( "empty_rock" ) );
+    CHECK( loaded.ter( tripoint_om_omt( 5, 6, 4 ) ) == oter_id( "open_air" ) );
+    CHECK( loaded.scent_at( { 75, 85, 0 } ).initial_strength == 90 );
+
+    REQUIRE( remove_file( path ) );
+}
+
+TEST_CASE( "remembered travel paths follow overmap changes", "[overmap][pathfinding]" )
+{
+    clear_all_state();
+    const oter_id field( "field" );
+    const tripoint_abs_omt src( 10, 10, 0 );
+    const tripoint_abs_omt dest( 40, 20, 0 );
+    for( int x = 5; x <= 45; x++ ) {
+        for( int y = 5; y <= 25; y++ ) {
+            overmap_buffer.ter_set( tripoint_abs_omt( x, y, 0 ), field );
+        }
+    }
+    const overmap_path_params params = overmap_path_params::for_npc();
+    const std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+    REQUIRE( path.size() > 2 );
+    CHECK( path.front() == dest );
+    CHECK( path.back() == src );
+
+    // Further along the same path
+    const tripoint_abs_omt midway = path[path.size() / 2];
+    const std::vector<tripoint_abs_omt> rest = overmap_buffer.get_travel_path( midway, dest, params );
+    CHECK( rest == std::vector<tripoint_abs_omt>( path.begin(), path.begin() + path.size() / 2 + 1 ) );
+
+    // Blocking the path makes the next search find another one
+    overmap_buffer.ter_set( midway, oter_id( "empty_rock" ) );
+    const std::vector<tripoint_abs_omt> detour = overmap_buffer.get_travel_path( src, dest, params );
+    REQUIRE( !detour.empty() );
+    CHECK( std::find( detour.begin(), detour.end(), midway ) == detour.end() );
+}
+
+TEST_CASE( "overmap locations match the types of their terrains", "[overmap]" )
+{
+    for( const char *id : {
+             "field", "land", "water", "wilderness", "subterranean", "road", "forest_edge", "lake_shore"
+         } ) {
+        const overmap_location &loc = overmap_location_id( id ).obj();
+        const std::vector<oter_type_id> types = loc.get_all_terrains();
+        for( const oter_t &ter : overmap_terrains::get_all() ) {
+            CAPTURE( id, ter.id.str() );
+            const bool expected = std::any_of( types.begin(), types.end(),
+            [&ter]( const oter_type_id & type ) {
+                return ter.type_is( type );
+            } );
+            CHECK( loc.test( ter.id.id() ) == expected );
+        }
+    }
+}
+
+TEST_CASE( "found overmap terrains match a check of every point searched", "[overmap]" )
+{
+    clear_all_state();
+    const tripoint_abs_omt origin( 90, 90, 0 );
+    for( int i = 0; i < 6; i++ ) {
+        overmap_buffer.ter_set( origin + point( i * 2 - 5, 3 - i ), oter_id( "forest_water" ) );
+        overmap_buffer.ter_set( origin + point( 4 - i, i * 3 - 7 ), oter_id( "field" ) );
+    }
+
+    omt_find_params params;
+    params.types = { { "forest_water", ot_match_type::type }, { "field", ot_match_type::prefix } };
+    params.search_range = 12;
+    std::vector<tripoint_abs_omt> expected;
+    for( const tripoint_abs_omt &p : closest_points_first( origin, 0, params.search_range ) ) {
+        if( overmap_buffer.check_ot( "forest_water", ot_match_type::type, p ) ||
+            overmap_buffer.check_ot( "field", ot_match_type::prefix, p ) ) {
+            expected.push_back( p );
+        }
+    }
+    REQUIRE( !expected.empty() );
+    CHECK( overmap_buffer.find_all( origin, params ) == expected );
+
+    params.types = { { "field", ot_match_type::exact } };
+    const tripoint_abs_omt closest = overmap_buffer.find_closest( origin, params );
+    REQUIRE( closest != overmap::invalid_tripoint );
+    CHECK( overmap_buffer.check_ot( "field", ot_match_type::exact, closest ) );
+}
@@ -0,0 +1,420 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "character.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "pathfinding_stats.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "units_angle.h"
+#include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+
+TEST_CASE( "long routes go around walls far from their ends", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+    const tripoint from = center + point( -30, 0 );
+    const tripoint to = center + point( 30, 0 );
+    const int gap_y = 5;
+
+    // Only passable far outside the box around the ends
+    const ter_id wall( "t_brick_wall" );
+    for( int y = 0; y < MAPSIZE_Y; y++ ) {
+        if( y != gap_y ) {
+            here.ter_set( tripoint( center.x, y, center.z ), wall );
+        }
+    }
+
+    const pathfinding_settings settings( 0, 200, 1000, 0, false, false, true, false, false );
+    const std::vector<tripoint> route = here.route( from, to, settings );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        CHECK( square_dist( prev, p ) == 1 );
+        CHECK( here.passable( p ) );
+        prev = p;
+    }
+    CHECK( std::find( route.begin(), route.end(), tripoint( center.x, gap_y, center.z ) ) != route.end() );
+
+    SECTION( "no route once the gap is closed" ) {
+        here.ter_set( tripoint( center.x, gap_y, center.z ), wall );
+        CHECK( here.route( from, to, settings ).empty() );
+    }
+}
+
+// What route() charges for a route over flat ground
+static int flat_route_cost( const tripoint &from, const std::vector<tripoint> &route )
+{
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        cost += p.x != prev.x && p.y != prev.y ? 3 : 2;
+        prev = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "shared routes are as short as separate ones", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint target = get_player_character().pos();
+
+    // A room with one door between the target and the crowd
+    const ter_id wall( "t_brick_wall" );
+    for( int d = -6; d <= 6; d++ ) {
+        here.ter_set( target + point( d, -6 ), wall );
+        here.ter_set( target + point( d, 6 ), wall );
+        here.ter_set( target + point( -6, d ), wall );
+        here.ter_set( target + point( 6, d ), wall );
+    }
+    here.ter_set( target + point( 6, 3 ), t_floor );
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    for( int i = 0; i < 5; i++ ) {
+        const tripoint from = target + point( 14 + i, -10 + 4 * i );
+        CAPTURE( from );
+        const std::vector<tripoint> separate = here.route( from, target, settings );
+        const std::vector<tripoint> shared = here.route_shared( from, target, settings );
+        REQUIRE( !separate.empty() );
+        REQUIRE( !shared.empty() );
+        CHECK( shared.back() == target );
+        CHECK( flat_route_cost( from, shared ) == flat_route_cost( from, separate ) );
+        CHECK( std::find( shared.begin(), shared.end(), target + point( 6, 3 ) ) != shared.end() );
+    }
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( target.z );
+    REQUIRE( cache.route_fields.size() == 1 );
+    CHECK( !cache.route_fields.front().cost.empty() );
+
+    SECTION( "terrain changes drop the field" ) {
+        here.ter_set( target + point( 6, 3 ), wall );
+        CHECK( here.route_shared( target + point( 14, 0 ), target, settings ).empty() );
+        CHECK( here.get_pathfinding_cache_ref( target.z ).route_fields.front().cost.empty() );
+    }
+}
+
+TEST_CASE( "shared routes between the map borders stay on the map", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const int z = get_player_character().posz();
+    // Off the top border flat_index wraps round to the bottom one, right where this starts
+    const tripoint target( 10, 0, z );
+    const tripoint from( 9, MAPSIZE_Y - 1, z );
+    // Across the map but for a gap, so the routes have to leave the straight line
+    const ter_id wall( "t_brick_wall" );
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        if( x != 20 ) {
+            here.ter_set( tripoint( x, MAPSIZE_Y / 2, z ), wall );
+        }
+    }
+
+    const pathfinding_settings settings( 0, MAPSIZE_Y * 2, 1000, 0, false, false, true, false,
+                                         false );
+    // The last one walks down the field
+    for( int i = 0; i < 3; i++ ) {
+        CAPTURE( i );
+        const std::vector<tripoint> shared = here.route_shared( from, target, settings );
+        REQUIRE( !shared.empty() );
+        CHECK( shared.back() == target );
+        tripoint prev = from;
+        for( const tripoint &p : shared ) {
+            CHECK( here.inbounds( p ) );
+            CHECK( square_dist( prev, p ) == 1 );
+            prev = p;
+        }
+    }
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( z );
+    REQUIRE( cache.route_fields.size() == 1 );
+    CHECK( !cache.route_fields.front().cost.empty() );
+}
+
+static std::vector<int> pathfinding_cache_of( map &here, int z )
+{
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( z );
+    std::vector<int> result;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            result.push_back( cache.special[x][y] );
+            result.push_back( cache.area[x][y] );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "pathfinding cache updated by submap matches a full rebuild", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+    const std::vector<int> before = pathfinding_cache_of( here, center.z );
+
+    here.ter_set( center + point( 3, 0 ), ter_id( "t_brick_wall" ) );
+    here.ter_set( center + point( SEEX, 0 ), ter_id( "t_rock_floor" ) );
+    here.furn_set( center + point( 0, 5 ), furn_id( "f_rubble" ) );
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( center.z );
+    CHECK( !cache.dirty );
+    CHECK( cache.dirty_submaps.none() );
+    const std::vector<int> updated = pathfinding_cache_of( here, center.z );
+    CHECK( updated != before );
+
+    here.set_pathfinding_cache_dirty( center.z );
+    CHECK( pathfinding_cache_of( here, center.z ) == updated );
+}
+
+TEST_CASE( "repeated routes are remembered until their area changes", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint from = get_player_character().pos();
+    const tripoint to = from + point( 8, 4 );
+    const ter_id wall( "t_brick_wall" );
+    // Not a straight line, so the route is searched for
+    here.ter_set( from + point( 4, 2 ), wall );
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    route_memo &memo = here.get_route_cache( from.z );
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    REQUIRE( !first.empty() );
+    memo.reset_stats();
+
+    CHECK( here.route( from, to, settings ) == first );
+    CHECK( memo.hits() == 1 );
+
+    SECTION( "change far away" ) {
+        here.ter_set( tripoint( 0, 0, from.z ), wall );
+        CHECK( here.route( from, to, settings ) == first );
+        CHECK( memo.hits() == 2 );
+    }
+
+    SECTION( "change on the route" ) {
+        here.ter_set( first[first.size() / 2], wall );
+        const std::vector<tripoint> rerouted = here.route( from, to, settings );
+        CHECK( memo.hits() == 1 );
+        CHECK( rerouted != first );
+        CHECK( rerouted.back() == to );
+    }
+}
+
+TEST_CASE( "remembered routes are forgotten when vehicle doors move", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint from = get_player_character().pos();
+    const tripoint to = from + point( 8, 4 );
+    // Not a straight line, so the route is searched for
+    here.ter_set( from + point( 4, 2 ), ter_id( "t_brick_wall" ) );
+    vehicle *veh = here.add_vehicle( vproto_id( "cube_van" ), from + point( 4, 10 ), 0_degrees,
+                                     0, 0 );
+    REQUIRE( veh != nullptr );
+    int door = -1;
+    for( const vpart_reference &vp : veh->get_avail_parts( "OPENABLE" ) ) {
+        veh->close( vp.part_index() );
+        door = vp.part_index();
+    }
+    REQUIRE( door >= 0 );
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, true, false, true, false, false );
+    route_memo &memo = here.get_route_cache( from.z );
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    REQUIRE( !first.empty() );
+    memo.reset_stats();
+    CHECK( here.route( from, to, settings ) == first );
+    CHECK( memo.hits() == 1 );
+
+    veh->open( door );
+    CHECK( here.route( from, to, settings ) == first );
+    CHECK( memo.hits() == 1 );
+}
+
+TEST_CASE( "batched routes match separate ones", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+    const ter_id wall( "t_brick_wall" );
+    for( int y = -8; y <= 8; y++ ) {
+        here.ter_set( center + point( 2, y ), wall );
+    }
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    std::vector<route_request> requests;
+    for( int i = 0; i < 6; i++ ) {
+        requests.push_back( { center + point( -4, 2 * i - 6 ), center + point( 6, 6 - 2 * i ), settings, {} } );
+    }
+    const std::vector<std::vector<tripoint>> batched = here.route_batch( requests );
+    REQUIRE( batched.size() == requests.size() );
+
+    route_memo &memo = here.get_route_cache( center.z );
+    memo.reset_stats();
+    for( size_t i = 0; i < requests.size(); i++ ) {
+        CAPTURE( i );
+        CHECK( !batched[i].empty() );
+        // Same pre_closed as the request, the default one isn't empty
+        CHECK( here.route( requests[i].f, requests[i].t, settings, requests[i].pre_closed ) ==
+               batched[i] );
+    }
+    CHECK( memo.hits() == requests.size() );
+}
+
+TEST_CASE( "routes jumping over open ground are as short as a full search", "[pathfinding]" )
+{
+    clear_all_state();
+    // Rounded circular distances can overestimate what's left of a route, so the search
+    // isn't always exact with them
+    const bool old_trigdist = trigdist;
+    trigdist = false;
+    const on_out_of_scope restore_trigdist( [old_trigdist]() {
+        trigdist = old_trigdist;
+    } );
+    map &here = get_map();
+    const tripoint target = get_player_character().pos();
+    const ter_id wall( "t_brick_wall" );
+    // Scattered walls with open ground between them
+    for( int x = -20; x <= 20; x++ ) {
+        for( int y = -20; y <= 20; y++ ) {
+            if( ( x * 7 + y * 13 + x * y ) % 5 == 0 && ( x != 0 || y != 0 ) ) {
+                here.ter_set( target + point( x, y ), wall );
+            }
+        }
+    }
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    // Differs in nothing that matters here, so the field isn't answered from the route cache
+    pathfinding_settings field_settings = settings;
+    field_settings.avoid_sharp = true;
+    int compared = 0;
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint from = target + point( 19 - 3 * i, ( i * 11 ) % 39 - 19 );
+        if( here.impassable( from ) ) {
+            continue;
+        }
+        CAPTURE( from );
+        // The first few requests don't use the field yet
+        const pathfinding_cache &cache = here.get_pathfinding_cache_ref( target.z );
+        const bool field_built = !cache.route_fields.empty() && !cache.route_fields.front().cost.empty();
+        const std::vector<tripoint> by_field = here.route_shared( from, target, field_settings );
+        const std::vector<tripoint> jumped = here.route( from, target, settings );
+        CHECK( by_field.empty() == jumped.empty() );
+        if( !jumped.empty() && field_built ) {
+            CHECK( jumped.back() == target );
+            CHECK( flat_route_cost( from, jumped ) == flat_route_cost( from, by_field ) );
+            compared++;
+        }
+        tripoint prev = from;
+        for( const tripoint &p : jumped ) {
+            CHECK( square_dist( prev, p ) == 1 );
+            CHECK( here.passable( p ) );
+            prev = p;
+        }
+    }
+    CHECK( compared > 4 );
+}
+
+TEST_CASE( "routes between z-levels go through the stairs", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+    const tripoint from = get_player_character().pos();
+    const tripoint stairs = from + point( 5, 3 );
+    const tripoint to = from + tripoint( -6, 8, 1 );
+
+    // An upper floor covering both ends, reached only by the stairs
+    for( int x = -10; x <= 10; x++ ) {
+        for( int y = -10; y <= 10; y++ ) {
+            here.ter_set( from + tripoint( x, y, 1 ), t_floor );
+        }
+    }
+    here.ter_set( stairs, ter_id( "t_stairs_up" ) );
+    here.ter_set( stairs + tripoint_above, ter_id( "t_stairs_down" ) );
+
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    const std::vector<tripoint> route = here.route( from, to, settings );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    const auto climb = std::find( route.begin(), route.end(), stairs );
+    REQUIRE( climb != route.end() );
+    REQUIRE( std::next( climb ) != route.end() );
+    CHECK( *std::next( climb ) == stairs + tripoint_above );
+
+    SECTION( "no route without stairs" ) {
+        here.ter_set( stairs, t_floor );
+        CHECK( here.route( from, to, settings ).empty() );
+    }
+}
+
+TEST_CASE( "route searches are counted for their caller", "[pathfinding]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint from = get_player_character().pos();
+    const tripoint to = from + point( 8, 4 );
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    pathfinding_stats::reset();
+
+    {
+        const pathfinding_stats::caller_scope tag( route_caller::npc );
+        REQUIRE( !here.route( from, to, settings ).empty() );
+    }
+    here.ter_set( from + point( 4, 2 ), ter_id( "t_brick_wall" ) );
+    {
+        const pathfinding_stats::caller_scope tag( route_caller::monster );
+        REQUIRE( !here.route( from, to, settings ).empty() );
+        REQUIRE( !here.route( from, to, settings ).empty() );
+    }
+    CHECK( pathfinding_stats::current_caller() == route_caller::other );
+
+    const pathfinding_stats::totals npcs = pathfinding_stats::get( route_scale::map, route_caller::npc );
+    CHECK( npcs.searches == 1 );
+    CHECK( npcs.shortcuts == 1 );
+    CHECK( npcs.expanded == 0 );
+    const pathfinding_stats::totals monsters = pathfinding_stats::get( route_scale::map,
+            route_caller::monster );
+    CHECK( monsters.searches == 2 );
+    CHECK( monsters.shortcuts == 0 );
+    CHECK( monsters.cached == 1 );
+    CHECK( monsters.expanded > 0 );
+    CHECK( pathfinding_stats::get( route_scale::map, route_caller::other ).searches == 0 );
+    CHECK( !pathfinding_stats::report().empty() );
+
+    pathfinding_stats::reset();
+    CHECK( pathfinding_stats::report().empty() );
+}
+
+TEST_CASE( "route_benchmark", "[.][pathfinding][benchmark]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+    // Fences every few tiles, so nothing goes in a straight line
+    const ter_id fence( "t_chainfence" );
+    for( int x = -20; x <= 20; x += 5 ) {
+        for( int y = -20; y <= 20; y++ ) {
+            if( y != x ) {
+                here.ter_set( center + point( x, y ), fence );
+            }
+        }
+    }
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    // More pairs of ends than the route cache holds, so every route is searched for
+    int pair = 0;
+    BENCHMARK( "route across fences" ) {
+        pair = ( pair + 1 ) % 100;
+        return here.route( center + point( -22, pair % 10 ), center + point( 22, -pair / 10 ), settings );
+    };
+}
@@ -0,0 +1,58 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "phase_stats.h"
+
+namespace
+{
+
+enum class test_phase : int {
+    first,
+    second,
+    num_test_phases
+};
+
+const char *test_phase_name( test_phase phase )
+{
+    return phase == test_phase::first ? "first" : "second";
+}
+
+using test_phases = phase_stats::per_phase<test_phase, test_phase::num_test_phases,
+      test_phase_name>;
+using test_ids = phase_stats::per_id<test_phase, test_phase_name>;
+
+} // namespace
+
+TEST_CASE( "phase_stats_counts_the_outermost_timer_of_a_phase", "[phase_stats]" )
+{
+    test_phases::reset();
+    {
+        test_phases::timer outer( test_phase::first );
+        test_phases::timer inner( test_phase::first );
+        test_phases::timer other( test_phase::second );
+    }
+    CHECK( test_phases::count( test_phase::first ) == 1 );
+    CHECK( test_phases::count( test_phase::second ) == 1 );
+    CHECK( test_phases::report().find( "first: " ) == 0 );
+    test_phases::reset();
+    CHECK( test_phases::report().empty() );
+}
+
+TEST_CASE( "phase_stats_keeps_ids_of_each_kind_apart", "[phase_stats]" )
+{
+    test_ids::reset();
+    {
+        test_ids::timer a( test_phase::first, "a" );
+        test_ids::timer b( test_phase::second, "a" );
+        test_ids::timer c( test_phase::second, "a" );
+    }
+    CHECK( test_ids::count( test_phase::first, "a" ) == 1 );
+    CHECK( test_ids::count( test_phase::second, "a" ) == 2 );
+    CHECK( test_ids::count( test_phase::first, "b" ) == 0 );
+    const std::string csv = test_ids::csv();
+    CHECK( csv.find( "kind,id,calls,total_us,mean_us\n" ) == 0 );
+    CHECK( csv.find( "\nsecond,a,2," ) != std::string::npos );
+    test_ids::reset();
+    CHECK( test_ids::report( 10 ).empty() );
+}
@@ -204,3 +204,38 @@ TEST_CASE( "Items don't rot away on map load if in a freezer" )
     auto normal_stack_after = m.i_at( normal_pnt );
     REQUIRE( normal_stack_after.empty() );
 }
+
+TEST_CASE( "Rot caught up at once adds up to the rot of every hour", "[item]" )
+{
+    weather_manager weather;
+    set_map_temperature( weather, 18_c );
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    const time_point start = calendar::turn;
+
+    // A root cellar keeps the same temperature whatever the weather did in the meantime
+    for( const bool seals : { true, false } ) {
+        for( const int hours : { 2, 3, 30, 500, 2000 } ) {
+            CAPTURE( seals, hours );
+            calendar::turn = start;
+            detached_ptr<item> hourly = item::spawn( "meat_cooked" );
+            detached_ptr<item> at_once = item::spawn( "meat_cooked" );
+            for( int i = 0; i < hours; i++ ) {
+                calendar::turn += 1_hours;
+                if( hourly ) {
+                    hourly = item::process_rot( std::move( hourly ), seals, tripoint_zero, nullptr,
+                                                temperature_flag::TEMP_ROOT_CELLAR, weather );
+                }
+            }
+            at_once = item::process_rot( std::move( at_once ), seals, tripoint_zero, nullptr,
+                                         temperature_flag::TEMP_ROOT_CELLAR, weather );
+
+            REQUIRE( !hourly == !at_once );
+            if( hourly ) {
+                CHECK( hourly->get_rot() == at_once->get_rot() );
+            }
+        }
+    }
+    calendar::turn = start;
+}
@@ -0,0 +1,74 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "cata_arena.h"
+#include "detached_ptr.h"
+#include "item.h"
+#include "safe_reference.h"
+
+TEST_CASE( "safe references share a record and see the object destroyed", "[item][safe_reference]" )
+{
+    cleanup_arenas();
+    safe_reference<item> copy;
+    {
+        detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+        const safe_reference<item> first( *rock );
+        copy = first;
+        CHECK( copy == first );
+        CHECK( copy == &*rock );
+        CHECK( copy.get_const() == &*rock );
+    }
+    CHECK( copy.is_destroyed() );
+    CHECK_FALSE( copy );
+    cleanup_arenas();
+    CHECK( copy.is_destroyed() );
+    CHECK( copy.get_const() == nullptr );
+}
+
+TEST_CASE( "a reference to a copied item doesn't follow the copy", "[item][safe_reference]" )
+{
+    detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+    const safe_reference<item> ref( *rock );
+    detached_ptr<item> other = item::spawn( *rock );
+    CHECK( ref == &*rock );
+    CHECK( ref != safe_reference<item>( *other ) );
+}
+
+TEST_CASE( "references to assigned items stay with their own item", "[item][safe_reference]" )
+{
+    detached_ptr<item> rock = item::spawn( "rock", calendar::turn );
+    detached_ptr<item> other = item::spawn( "rock", calendar::turn );
+    const safe_reference<item> to_rock( *rock );
+    const safe_reference<item> to_other( *other );
+    *other = *rock;
+    CHECK( to_rock == &*rock );
+    CHECK( to_other == &*other );
+    other = detached_ptr<item>();
+    CHECK( to_rock == &*rock );
+    CHECK_FALSE( to_rock.is_destroyed() );
+    CHECK( to_other.is_destroyed() );
+}
+
+TEST_CASE( "references to a merged item point to the item it was merged into",
+           "[item][safe_reference]" )
+{
+    detached_ptr<item> primary = item::spawn( "rock", calendar::turn );
+    detached_ptr<item> secondary = item::spawn( "rock", calendar::turn );
+    const safe_reference<item> to_secondary( *secondary );
+
+    SECTION( "primary without references" ) {
+        safe_reference<item>::merge( &*primary, &*secondary );
+        CHECK( to_secondary == &*primary );
+        CHECK( safe_reference<item>( *primary ) == to_secondary );
+    }
+    SECTION( "primary with references" ) {
+        const safe_reference<item> to_primary( *primary );
+        safe_reference<item>::merge( &*primary, &*secondary );
+        CHECK( to_secondary == to_primary );
+    }
+    // Detached items without a location count as unloaded, so check where it points
+    secondary = detached_ptr<item>();
+    cleanup_arenas();
+    CHECK( to_secondary == &*primary );
+    CHECK_FALSE( to_secondary.is_destroyed() );
+}
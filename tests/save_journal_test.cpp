@@ -0,0 +1,81 @@
+#include "catch/catch.hpp"
+
+#include <ostream>
+#include <string>
+
+#include "background_saver.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "save_journal.h"
+
+TEST_CASE( "save journal replays only committed transactions", "[savegame]" )
+{
+    const std::string base = g->get_world_base_save_path() + "/journal_test_" +
+                             get_pid_string();
+    REQUIRE( assure_dir_exist( base ) );
+    const std::string journal = base + "/" + SAVE_JOURNAL;
+    const std::string file1 = base + "/first.json";
+    const std::string file2 = base + "/second.json";
+    save_journal::write_file_synced( file1, "old" );
+
+    SECTION( "committed journal is checkpointed on recovery" ) {
+        save_journal::commit( journal, { { file1, "new" }, { file2, "second" } } );
+        // Crashed before the checkpoint
+        CHECK( read_entire_file( file1 ) == "old" );
+
+        CHECK( save_journal::recover( journal ) );
+        CHECK( !file_exist( journal ) );
+        CHECK( read_entire_file( file1 ) == "new" );
+        CHECK( read_entire_file( file2 ) == "second" );
+        REQUIRE( remove_file( file2 ) );
+    }
+
+    SECTION( "removals are replayed with the writes" ) {
+        save_journal::commit( journal, { { file2, "second" }, { file1, "", true } } );
+        CHECK( save_journal::recover( journal ) );
+        CHECK( !file_exist( file1 ) );
+        CHECK( read_entire_file( file2 ) == "second" );
+        REQUIRE( remove_file( file2 ) );
+        save_journal::write_file_synced( file1, "old" );
+    }
+
+    SECTION( "journal without commit marker is dropped" ) {
+        save_journal::commit( journal, { { file1, "new" } } );
+        write_to_file( journal, [&]( std::ostream & fout ) {
+            const std::string data = read_entire_file( journal );
+            fout << data.substr( 0, data.size() - 3 );
+        } );
+
+        CHECK( !save_journal::recover( journal ) );
+        CHECK( !file_exist( journal ) );
+        CHECK( read_entire_file( file1 ) == "old" );
+    }
+
+    SECTION( "background saver writes transactions through the journal" ) {
+        background_saver saver;
+        bool callback_ran = false;
+        saver.begin_transaction( journal );
+        saver.write( file1, "new" );
+        saver.on_written( [&]() {
+            callback_ran = true;
+        } );
+        saver.write( file2, "second" );
+        CHECK( saver.is_pending( file1 ) );
+        saver.end_transaction();
+        // Queued after the transaction, not folded into it
+        saver.remove( file2 );
+        CHECK( saver.is_pending( file2 ) );
+
+        saver.wait();
+        CHECK( callback_ran );
+        CHECK( !saver.busy() );
+        CHECK( !file_exist( journal ) );
+        CHECK( read_entire_file( file1 ) == "new" );
+        CHECK( !file_exist( file2 ) );
+    }
+
+    REQUIRE( remove_file( file1 ) );
+    REQUIRE( remove_directory( base ) );
+}
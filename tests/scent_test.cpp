@@ -123,6 +123,106 @@ void old_scent_map_update( const tripoint &center, map &m,
     }
 }
 
+// The diffusion as it was before it was limited to the squares around the scent
+static void full_box_scent_update( const tripoint &center, map &m,
+                                   std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X> scent_transfer;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+            int temp_scent = grscent[abs.x][abs.y] * ( 250 - squares_used * scent_transfer[abs.x][abs.y] );
+            temp_scent -= grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] * ( 45 - squares_used ) / 5;
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+TEST_CASE( "scent diffusion around the scent matches diffusing everywhere", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    for( int y = -6; y <= 6; y++ ) {
+        here.ter_set( origin + point( 4, y ), t_brick_wall );
+    }
+    here.ter_set( origin + point( 4, 0 ), t_rock_wall_half );
+    g->scent.reset();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> expected;
+    for( auto &elem : expected ) {
+        elem.fill( 0 );
+    }
+    for( const point &p : {
+             point( 2, 1 ), point( -20, 13 ), point( 35, -38 )
+         } ) {
+        g->scent.set( origin + p, 1000, scenttype_id( "sc_human" ) );
+        expected[origin.x + p.x][origin.y + p.y] = 1000;
+    }
+
+    for( int turn = 0; turn < 5; turn++ ) {
+        g->scent.update( origin, here );
+        full_box_scent_update( origin, here, expected );
+    }
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            CAPTURE( x, y );
+            if( expected[x][y] != g->scent.get( { x, y, 0 } ) ) {
+                CHECK( expected[x][y] == g->scent.get( { x, y, 0 } ) );
+            }
+        }
+    }
+}
+
 TEST_CASE( "scent_matches_old", "[.]" )
 {
     clear_all_state();
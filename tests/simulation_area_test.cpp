@@ -0,0 +1,58 @@
+#include "catch/catch.hpp"
+
+#include <set>
+#include <sstream>
+
+#include "calendar.h"
+#include "coordinates.h"
+#include "json.h"
+#include "options_helpers.h"
+#include "simulation_area.h"
+
+TEST_CASE( "simulation_areas_are_limited_by_the_option", "[simulation_area]" )
+{
+    override_option opt( "SIMULATION_AREAS", "1" );
+    simulation_areas areas;
+    const std::set<tripoint_abs_omt> first = {
+        tripoint_abs_omt( 10, 10, 0 ), tripoint_abs_omt( 11, 10, 0 )
+    };
+    const std::set<tripoint_abs_omt> second = { tripoint_abs_omt( 50, 50, 0 ) };
+
+    REQUIRE( areas.add( first ) );
+    CHECK( areas.contains( tripoint_abs_omt( 11, 10, 0 ) ) );
+    const tripoint_abs_sm corner = project_to<coords::sm>( tripoint_abs_omt( 10, 10, 0 ) );
+    CHECK( areas.contains( corner + point_south_east ) );
+    CHECK_FALSE( areas.contains( tripoint_abs_omt( 10, 10, 1 ) ) );
+
+    // Already simulated, takes no room
+    CHECK( areas.add( { tripoint_abs_omt( 10, 10, 0 ) } ) );
+    CHECK( areas.get_all().size() == 1 );
+    CHECK_FALSE( areas.add( second ) );
+    CHECK_FALSE( areas.contains( tripoint_abs_omt( 50, 50, 0 ) ) );
+
+    areas.remove_if( []( const simulation_area & ) {
+        return true;
+    } );
+    CHECK_FALSE( areas.contains( tripoint_abs_omt( 10, 10, 0 ) ) );
+    CHECK( areas.add( second ) );
+}
+
+TEST_CASE( "simulation_areas_survive_saving", "[simulation_area]" )
+{
+    override_option opt( "SIMULATION_AREAS", "4" );
+    simulation_areas areas;
+    REQUIRE( areas.add( { tripoint_abs_omt( 3, -4, 0 ), tripoint_abs_omt( 4, -4, 0 ) } ) );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    areas.serialize( jsout );
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    simulation_areas loaded;
+    loaded.deserialize( jsin );
+
+    REQUIRE( loaded.get_all().size() == 1 );
+    CHECK( loaded.get_all().front().omts == areas.get_all().front().omts );
+    CHECK( loaded.get_all().front().last_actualized == calendar::turn );
+    CHECK( loaded.contains( tripoint_abs_omt( 4, -4, 0 ) ) );
+}
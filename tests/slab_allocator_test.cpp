@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "cata_arena.h"
+#include "detached_ptr.h"
+#include "item.h"
+#include "memory_fast.h"
+#include "memory_stats.h"
+#include "slab_allocator.h"
+#include "type_id.h"
+
+namespace
+{
+struct pooled_thing {
+    std::uint64_t a = 1;
+    std::uint64_t b = 2;
+};
+} // namespace
+
+TEST_CASE( "slab allocator reuses freed objects before taking new blocks", "[memory]" )
+{
+    slab_allocator<pooled_thing> alloc;
+    std::vector<pooled_thing *> things;
+    for( std::size_t i = 0; i < slab_allocator<pooled_thing>::slab_size; i++ ) {
+        things.push_back( alloc.allocate( 1 ) );
+    }
+    const std::size_t slabs = slab_allocator<pooled_thing>::slab_count();
+    CHECK( std::set<pooled_thing *>( things.begin(), things.end() ).size() == things.size() );
+
+    pooled_thing *freed = things[3];
+    alloc.deallocate( freed, 1 );
+    CHECK( alloc.allocate( 1 ) == freed );
+    CHECK( slab_allocator<pooled_thing>::slab_count() == slabs );
+
+    for( pooled_thing *thing : things ) {
+        alloc.deallocate( thing, 1 );
+    }
+}
+
+TEST_CASE( "slab allocator counts live and total allocations", "[memory]" )
+{
+    slab_allocator<pooled_thing> alloc;
+    const std::size_t live = slab_allocator<pooled_thing>::live_count();
+    const std::size_t total = slab_allocator<pooled_thing>::allocation_count();
+    pooled_thing *first = alloc.allocate( 1 );
+    pooled_thing *second = alloc.allocate( 1 );
+    alloc.deallocate( first, 1 );
+    CHECK( slab_allocator<pooled_thing>::live_count() == live + 1 );
+    CHECK( slab_allocator<pooled_thing>::allocation_count() == total + 2 );
+    alloc.deallocate( second, 1 );
+    CHECK( slab_allocator<pooled_thing>::live_count() == live );
+
+    const std::vector<memory_stats::type_allocations> types = memory_stats::collect_types();
+    REQUIRE( !types.empty() );
+    CHECK( types.front().live == slab_allocator<item>::live_count() );
+}
+
+TEST_CASE( "pooled shared pointers construct and destroy their objects", "[memory]" )
+{
+    const shared_ptr_fast<std::vector<int>> v = make_shared_pooled<std::vector<int>>( 3, 7 );
+    CHECK( *v == std::vector<int>( { 7, 7, 7 } ) );
+    weak_ptr_fast<std::vector<int>> weak = v;
+    const shared_ptr_fast<std::vector<int>> other = make_shared_pooled<std::vector<int>>( *v );
+    CHECK( *other == *v );
+    CHECK( !weak.expired() );
+}
+
+TEST_CASE( "destroyed items give their memory to the next items made", "[memory][item]" )
+{
+    cleanup_arenas();
+    item *first = nullptr;
+    {
+        detached_ptr<item> rock = item::spawn( itype_id( "rock" ) );
+        first = &*rock;
+    }
+    CHECK( cata_arena<item>::cleanup() );
+    CHECK_FALSE( cata_arena<item>::cleanup() );
+
+    const std::size_t slabs = slab_allocator<item>::slab_count();
+    detached_ptr<item> again = item::spawn( itype_id( "rock" ) );
+    CHECK( &*again == first );
+    CHECK( slab_allocator<item>::slab_count() == slabs );
+}
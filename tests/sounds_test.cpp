@@ -0,0 +1,39 @@
+#include "catch/catch.hpp"
+
+#include "character.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "sounds.h"
+#include "state_helpers.h"
+
+TEST_CASE( "monsters only hear sounds within reach", "[sounds][monster]" )
+{
+    clear_all_state();
+    // Other tests leave their sounds behind
+    sounds::reset_sounds();
+    const tripoint origin = get_player_character().pos() + point( 20, 0 );
+    monster &near = spawn_test_monster( "mon_zombie", origin + point( 5, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", origin + point( 0, 45 ) );
+    for( monster *critter : {
+             &near, &far
+         } ) {
+        critter->anger = 100;
+        critter->morale = 10;
+        critter->wandf = 0;
+    }
+
+    SECTION( "a quiet sound is heard nearby" ) {
+        sounds::sound( origin, 20, sounds::sound_t::combat, "bang" );
+        sounds::process_sounds();
+        CHECK( near.wandf > 0 );
+        CHECK( far.wandf == 0 );
+    }
+
+    SECTION( "a loud sound is heard across the map" ) {
+        sounds::sound( origin, 100, sounds::sound_t::combat, "boom" );
+        sounds::process_sounds();
+        CHECK( near.wandf > 0 );
+        CHECK( far.wandf > 0 );
+    }
+}
@@ -0,0 +1,34 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "startup_timings.h"
+
+TEST_CASE( "startup timings add up by phase and name", "[init]" )
+{
+    // No path, so nothing gets written at exit
+    startup_timings::enable( "" );
+    startup_timings::reset();
+
+    startup_timings::add( "json file", "data/json/a.json", 100 );
+    startup_timings::add( "json file", "data/json/a.json", 50 );
+    startup_timings::add( "loader", "GENERIC", 7 );
+    {
+        startup_timings::timer timing( "loader", "TOOL" );
+    }
+
+    CHECK( startup_timings::count( "json file", "data/json/a.json" ) == 2 );
+    CHECK( startup_timings::microseconds( "json file", "data/json/a.json" ) == 150 );
+    CHECK( startup_timings::count( "loader", "TOOL" ) == 1 );
+    CHECK( startup_timings::count( "loader", "a.json" ) == 0 );
+
+    const std::string csv = startup_timings::csv();
+    CHECK( csv.find( "phase,name,calls,total_us\n" ) == 0 );
+    // In the order they were first timed
+    CHECK( csv.find( "json file,\"data/json/a.json\",2,150\n" ) < csv.find( "loader,\"GENERIC\",1,7\n" ) );
+    CHECK( csv.find( "loader,\"GENERIC\",1,7\n" ) < csv.find( "loader,\"TOOL\",1," ) );
+
+    startup_timings::reset();
+    CHECK( startup_timings::count( "json file", "data/json/a.json" ) == 0 );
+    CHECK( startup_timings::csv() == "phase,name,calls,total_us\n" );
+}
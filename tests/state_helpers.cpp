@@ -13,6 +13,7 @@ void clear_all_state( )
 {
     disable_mapgen = true;
     get_weather().weather_id = weather_type_id( "clear" );
+    get_weather().clear_temp_cache();
     clear_map();
     clear_avatar();
     set_time( calendar::turn_zero );
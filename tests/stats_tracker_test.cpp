@@ -133,6 +133,41 @@ TEST_CASE( "stats_tracker_maximum_events", "[stats]" )
     CHECK( s.get_events( am ).maximum( "z" ) == 5 );
 }
 
+TEST_CASE( "event_multiset_queries_made_before_and_after_adding_agree", "[stats]" )
+{
+    constexpr event_type ctd = event_type::character_takes_damage;
+    const character_id u_id = g->u.getID();
+    character_id other_id = u_id;
+    ++other_id;
+    const cata::event::data_type damage_to_u{ { "character", cata_variant( u_id ) } };
+    const auto damage_data = [&]( character_id who, int damage ) {
+        return cata::event::make<ctd>( who, damage ).data();
+    };
+
+    event_multiset early( ctd );
+    CHECK( early.count() == 0 );
+    CHECK( early.count( damage_to_u ) == 0 );
+    CHECK( early.total( "damage" ) == 0 );
+    CHECK( early.total( "damage", damage_to_u ) == 0 );
+    CHECK( early.minimum( "damage" ) == 0 );
+    CHECK( early.maximum( "damage" ) == 0 );
+
+    event_multiset late( ctd );
+    for( event_multiset *set : { &early, &late } ) {
+        set->add( { damage_data( u_id, 7 ), 3 } );
+        set->add( { damage_data( other_id, -2 ), 2 } );
+        set->add( cata::event::make<ctd>( u_id, 11 ) );
+    }
+    for( event_multiset *set : { &early, &late } ) {
+        CHECK( set->count() == 6 );
+        CHECK( set->count( damage_to_u ) == 4 );
+        CHECK( set->total( "damage" ) == 28 );
+        CHECK( set->total( "damage", damage_to_u ) == 32 );
+        CHECK( set->minimum( "damage" ) == -2 );
+        CHECK( set->maximum( "damage" ) == 11 );
+    }
+}
+
 TEST_CASE( "stats_tracker_with_event_statistics", "[stats]" )
 {
     stats_tracker s;
@@ -441,6 +476,16 @@ TEST_CASE( "stats_tracker_watchers", "[stats]" )
         b.send( other_kill );
         CHECK( kills_watcher.value == cata_variant( 2 ) );
         CHECK( zombie_kills_watcher.value == cata_variant( 1 ) );
+
+        // The watched sets are read as they are, they should match working them out again
+        for( const char *id : {
+                 "avatar_kills", "avatar_species_kills", "avatar_zombie_kills"
+             } ) {
+            CAPTURE( id );
+            const string_id<event_transformation> transformation( id );
+            CHECK( s.get_events( transformation ).counts() ==
+                   transformation->value( s ).counts() );
+        }
     }
 
     SECTION( "damage" ) {
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "output.h"
+#include "string_utils.h"
 
 static void test_remove_color_tags( const std::string &original, const std::string &expected )
 {
@@ -38,3 +39,24 @@ TEST_CASE( "trim_by_length" )
     CHECK( trim_by_length( "MRE 主菜（鸡肉意大利香蒜沙司通心粉）（新鲜）",
                            36 ) == "MRE 主菜（鸡肉意大利香蒜沙司通心粉…" );
 }
+
+TEST_CASE( "wildcard_match" )
+{
+    CHECK( wildcard_match( "wooden arrow", "wooD*aRrOW" ) );
+    CHECK( wildcard_match( "wooden arrow", "wood*" ) );
+    CHECK( wildcard_match( "wooden arrow", "*arrow" ) );
+    CHECK( wildcard_match( "wooden arrow", "*en*ar*" ) );
+    CHECK( wildcard_match( "wooden arrow", "**wooden arrow" ) );
+    CHECK( wildcard_match( "wooden arrow", "Wooden Arrow" ) );
+    CHECK_FALSE( wildcard_match( "wooden arrow", "wooden" ) );
+    CHECK_FALSE( wildcard_match( "wooden arrow", "*bolt" ) );
+    CHECK_FALSE( wildcard_match( "wooden arrow", "arrow*wooden" ) );
+    // The end of the pattern can't match what its start already did
+    CHECK_FALSE( wildcard_match( "arrow", "arrow*row" ) );
+    CHECK_FALSE( wildcard_match( "", "*" ) );
+
+    const wildcard_pattern pattern( "*an*" );
+    CHECK( pattern.matches( "can" ) );
+    CHECK( pattern.matches( "BANDAGE" ) );
+    CHECK_FALSE( pattern.matches( "rock" ) );
+}
@@ -1,8 +1,16 @@
 #include "catch/catch.hpp"
 
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_io.h"
 #include "submap.h"
+#include "field_type.h"
+#include "game.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -90,3 +98,176 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap binary round trip", "[submap][savegame]" )
+{
+    const ter_id t_grass( "t_grass" );
+    const ter_id t_dirt( "t_dirt" );
+    const furn_id f_chair( "f_chair" );
+    const trap_id tr_bubblewrap = trap_str_id( "tr_bubblewrap" ).id();
+    const field_type_id fd_fire( "fd_fire" );
+
+    submap original( tripoint_zero );
+    original.set_all_ter( t_grass );
+    original.set_ter( point( 3, 4 ), t_dirt );
+    original.set_ter( point( SEEX - 1, SEEY - 1 ), t_dirt );
+    original.set_furn( point( 5, 5 ), f_chair );
+    original.set_trap( point( 1, 2 ), tr_bubblewrap );
+    original.set_radiation( point( 7, 8 ), 42 );
+    original.get_field( point( 2, 3 ) ).add_field( fd_fire, 2, 10_turns );
+    original.field_count++;
+    original.get_items( point( 6, 6 ) ).push_back( item::spawn( itype_id( "rock" ) ) );
+    original.set_temperature( 17 );
+
+    std::ostringstream buffer;
+    binary_out out( buffer );
+    original.store_binary( out );
+
+    submap loaded( tripoint_zero );
+    std::istringstream input( buffer.str() );
+    binary_in in( input );
+    loaded.load_binary( in, savegame_version, tripoint_zero );
+    CHECK( in.eof() );
+
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            CHECK( loaded.get_ter( p ) == original.get_ter( p ) );
+            CHECK( loaded.get_furn( p ) == original.get_furn( p ) );
+            CHECK( loaded.get_trap( p ) == original.get_trap( p ) );
+            CHECK( loaded.get_radiation( p ) == original.get_radiation( p ) );
+        }
+    }
+    CHECK( loaded.get_temperature() == 17 );
+    CHECK( loaded.field_count == 1 );
+    CHECK( loaded.field_tiles.count() == 1 );
+    CHECK( loaded.field_tiles[2 * SEEY + 3] );
+    const field_entry *fire = loaded.get_field( point( 2, 3 ) ).find_field( fd_fire );
+    REQUIRE( fire != nullptr );
+    CHECK( fire->get_field_intensity() == 2 );
+    CHECK( fire->get_field_age() == 10_turns );
+    REQUIRE( loaded.get_items( point( 6, 6 ) ).size() == 1 );
+    CHECK( loaded.get_items( point( 6, 6 ) ).front()->typeId() == itype_id( "rock" ) );
+}
+
+static std::string stored_binary( const submap &sm )
+{
+    std::ostringstream buffer;
+    binary_out out( buffer );
+    sm.store_binary( out );
+    return buffer.str();
+}
+
+TEST_CASE( "identical items are saved once with the length of their run", "[submap][savegame]" )
+{
+    submap one_rock( tripoint_zero );
+    one_rock.get_items( point( 6, 6 ) ).push_back( item::spawn( itype_id( "rock" ) ) );
+
+    submap original( tripoint_zero );
+    const std::vector<std::string> pile = { "rock", "rock", "rock", "stick", "rock", "rock" };
+    for( const std::string &id : pile ) {
+        original.get_items( point( 6, 6 ) ).push_back( item::spawn( itype_id( id ) ) );
+    }
+    for( int i = 0; i < 200; i++ ) {
+        original.get_items( point( 6, 6 ) ).push_back( item::spawn( itype_id( "rock" ) ) );
+    }
+    const std::string stored = stored_binary( original );
+    // Three runs of rocks and a stick, not two hundred rocks
+    CHECK( stored.size() < stored_binary( one_rock ).size() * 2 );
+
+    submap loaded( tripoint_zero );
+    std::istringstream input( stored );
+    binary_in in( input );
+    loaded.load_binary( in, savegame_version, tripoint_zero );
+    CHECK( in.eof() );
+    REQUIRE( loaded.get_items( point( 6, 6 ) ).size() == pile.size() + 200 );
+    int i = 0;
+    for( const item *it : loaded.get_items( point( 6, 6 ) ) ) {
+        CAPTURE( i );
+        CHECK( it->typeId() == itype_id( i < static_cast<int>( pile.size() ) ? pile[i] : "rock" ) );
+        i++;
+    }
+}
+
+TEST_CASE( "submap modification tracking", "[submap][savegame]" )
+{
+    submap sm( tripoint_zero );
+    // Never written to disk
+    CHECK( sm.is_modified() );
+
+    sm.clear_modified();
+    const submap &const_sm = sm;
+    CHECK( const_sm.get_ter( point_zero ) == ter_id( 0 ) );
+    CHECK( const_sm.get_items( point_zero ).empty() );
+    CHECK_FALSE( sm.is_modified() );
+
+    SECTION( "terrain" ) {
+        sm.set_ter( point_zero, ter_id( 1 ) );
+        CHECK( sm.is_modified() );
+    }
+    SECTION( "items" ) {
+        sm.get_items( point_zero );
+        CHECK( sm.is_modified() );
+    }
+    SECTION( "fields" ) {
+        sm.get_field( point_zero );
+        CHECK( sm.is_modified() );
+    }
+    SECTION( "cosmetics" ) {
+        sm.set_graffiti( point_zero, "graffiti" );
+        CHECK( sm.is_modified() );
+    }
+}
+
+TEST_CASE( "submap light emitters follow the light counts", "[submap][lightmap]" )
+{
+    submap sm( tripoint_zero );
+    CHECK( sm.get_light_emitters().empty() );
+
+    sm.set_lum( point( 3, 1 ), 2 );
+    sm.set_lum( point( 1, 5 ), 1 );
+    CHECK( sm.get_light_emitters() == std::vector<point> { point( 1, 5 ), point( 3, 1 ) } );
+
+    sm.rotate( 2 );
+    CHECK( sm.get_light_emitters() == std::vector<point> {
+        point( SEEX - 4, SEEY - 2 ), point( SEEX - 2, SEEY - 6 )
+    } );
+
+    sm.set_lum( point( SEEX - 4, SEEY - 2 ), 0 );
+    CHECK( sm.get_light_emitters() == std::vector<point> { point( SEEX - 2, SEEY - 6 ) } );
+}
+
+TEST_CASE( "submap field tiles follow the fields when rotated", "[submap][field]" )
+{
+    const field_type_id fd_fire( "fd_fire" );
+    submap sm( tripoint_zero );
+    sm.get_field( point( 1, 2 ) ).add_field( fd_fire, 1, 0_turns );
+    sm.mark_field_tile( point( 1, 2 ) );
+
+    sm.rotate( 1 );
+    REQUIRE( sm.get_field( point( SEEY - 3, 1 ) ).find_field( fd_fire ) != nullptr );
+    CHECK( sm.field_tiles.count() == 1 );
+    CHECK( sm.field_tiles[( SEEY - 3 ) * SEEY + 1] );
+}
+
+TEST_CASE( "submap cosmetic tiles follow graffiti and signage", "[submap]" )
+{
+    submap sm( tripoint_zero );
+    sm.set_graffiti( point( 1, 2 ), "graffiti" );
+    sm.set_signage( point( 1, 2 ), "sign" );
+    CHECK( sm.cosmetic_tiles.count() == 1 );
+    CHECK( sm.get_graffiti( point( 1, 2 ) ) == "graffiti" );
+    CHECK_FALSE( sm.has_graffiti( point( 2, 1 ) ) );
+
+    sm.rotate( 1 );
+    CHECK( sm.has_graffiti( point( SEEY - 3, 1 ) ) );
+    CHECK( sm.cosmetic_tiles[( SEEY - 3 ) * SEEY + 1] );
+
+    // The signage is still there after the graffiti is gone
+    sm.delete_graffiti( point( SEEY - 3, 1 ) );
+    CHECK( sm.cosmetic_tiles[( SEEY - 3 ) * SEEY + 1] );
+    sm.delete_signage( point( SEEY - 3, 1 ) );
+    CHECK( sm.cosmetic_tiles.none() );
+    CHECK( sm.cosmetics.empty() );
+}
@@ -0,0 +1,95 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cuboid_rectangle.h"
+#include "point.h"
+#include "thread_pool.h"
+
+TEST_CASE( "thread pool runs every index exactly once", "[thread_pool]" )
+{
+    thread_pool pool( 3 );
+    std::vector<std::atomic<int>> calls( 100 );
+
+    pool.parallel_for( 0, 100, [&]( int i ) {
+        calls[i]++;
+        // Nested calls run inline on the worker
+        pool.parallel_for( 0, 2, [&]( int ) {
+            calls[i]++;
+        } );
+    } );
+    for( const std::atomic<int> &count : calls ) {
+        CHECK( count == 3 );
+    }
+
+    pool.parallel_for( 5, 5, [&]( int ) {
+        FAIL( "empty range" );
+    } );
+}
+
+TEST_CASE( "thread pool rethrows exceptions from tasks", "[thread_pool]" )
+{
+    thread_pool pool( 2 );
+    std::atomic<int> done = 0;
+    CHECK_THROWS_AS( pool.parallel_for( 0, 10, [&]( int i ) {
+        if( i == 4 ) {
+            throw std::runtime_error( "task failed" );
+        }
+        done++;
+    } ), std::runtime_error );
+    CHECK( done == 9 );
+
+    // Still usable afterwards
+    pool.parallel_for( 0, 4, [&]( int ) {
+        done++;
+    } );
+    CHECK( done == 13 );
+}
+
+TEST_CASE( "thread pool without workers runs inline", "[thread_pool]" )
+{
+    thread_pool pool( 0 );
+    CHECK( pool.concurrency() == 1 );
+    int sum = 0;
+    pool.parallel_for( 0, 4, [&]( int i ) {
+        sum += i;
+    } );
+    CHECK( sum == 6 );
+}
+
+TEST_CASE( "thread pool covers every point of an area", "[thread_pool]" )
+{
+    thread_pool pool( 3 );
+    const half_open_rectangle<point> area( point( -2, 3 ), point( 5, 7 ) );
+    std::vector<std::atomic<int>> calls( 7 * 4 );
+    pool.parallel_for( area, [&]( const point & p ) {
+        REQUIRE( area.contains( p ) );
+        calls[( p.y - 3 ) * 7 + p.x + 2]++;
+    } );
+    for( const std::atomic<int> &count : calls ) {
+        CHECK( count == 1 );
+    }
+}
+
+TEST_CASE( "thread pool runs posted tasks on the main thread", "[thread_pool]" )
+{
+    thread_pool pool( 2 );
+    const std::thread::id main_thread = std::this_thread::get_id();
+    std::vector<int> order;
+    pool.parallel_for( 0, 8, [&]( int i ) {
+        if( i % 2 == 0 ) {
+            pool.post_to_main_thread( [&, i]() {
+                CHECK( std::this_thread::get_id() == main_thread );
+                order.push_back( i );
+            } );
+        }
+    } );
+    CHECK( order.empty() );
+    pool.run_main_thread_tasks();
+    std::sort( order.begin(), order.end() );
+    CHECK( order == std::vector<int>( { 0, 2, 4, 6 } ) );
+}
@@ -0,0 +1,45 @@
+#include "catch/catch.hpp"
+
+#include <array>
+#include <chrono>
+
+#include "turn_stats.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE( "turn_stats_keeps_the_last_turns", "[turn_stats]" )
+{
+    turn_stats::reset();
+    CHECK( turn_stats::last_turn().total_nanoseconds() == 0 );
+    CHECK( turn_stats::report().empty() );
+
+    turn_stats::add( turn_phase::monmove, 3ms );
+    turn_stats::add( turn_phase::fields, 1ms );
+    turn_stats::add( turn_phase::monmove, 1ms );
+    CHECK_FALSE( turn_stats::end_turn( 0ms ) );
+    CHECK( turn_stats::last_turn().total_nanoseconds() == 5'000'000 );
+    CHECK( turn_stats::last_turn().slowest_phases( 1, ", " ) == "monmove 4.00 ms" );
+
+    SECTION( "slow turns" ) {
+        turn_stats::add( turn_phase::items, 20ms );
+        CHECK( turn_stats::end_turn( 10ms ) );
+        turn_stats::add( turn_phase::items, 5ms );
+        CHECK_FALSE( turn_stats::end_turn( 10ms ) );
+    }
+
+    SECTION( "histogram of the history" ) {
+        for( int i = 0; i < turn_stats::history_size * 2; i++ ) {
+            turn_stats::add( turn_phase::vehmove, i % 2 == 0 ? 150us : 700ms );
+            turn_stats::end_turn( 0ms );
+        }
+        CHECK( turn_stats::turns() == turn_stats::history_size * 2 + 1 );
+        CHECK( turn_stats::turns_kept() == turn_stats::history_size );
+        const std::array<int, turn_stats::num_buckets> buckets = turn_stats::histogram();
+        CHECK( buckets.front() == turn_stats::history_size / 2 );
+        CHECK( buckets.back() == turn_stats::history_size / 2 );
+        CHECK( turn_stats::bucket_label( 0 ) == "<1" );
+        CHECK( turn_stats::bucket_label( turn_stats::num_buckets - 1 ) == ">=500" );
+        CHECK( turn_stats::last_turn().total_nanoseconds() == 700'000'000 );
+    }
+    turn_stats::reset();
+}
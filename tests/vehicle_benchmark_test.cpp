@@ -0,0 +1,119 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "calendar.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "tileray.h"
+#include "type_id.h"
+#include "vehicle.h"
+#include "vehicle_turn_stats.h"
+#include "vpart_position.h"
+
+// Timings of vehicles driving through a course with things to crash into every few turns,
+// split by what the turns spend it on, so they can be compared between commits.
+// Run with: cata_test "[vehicle][benchmark]"
+
+static constexpr int benchmark_turns = 100;
+static constexpr int turns_between_obstacles = 5;
+// In 100ths of mph, slow enough not to wreck the vehicle on the first obstacle
+static constexpr int course_velocity = 10 * 100;
+
+static vehicle &spawn_large_custom_vehicle( const tripoint &where )
+{
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vproto_id( "none" ), where, -90_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+    // 25 by 20 frames, with wheels down both sides
+    for( int x = 0; x < 25; x++ ) {
+        for( int y = 0; y < 20; y++ ) {
+            REQUIRE( veh->install_part( point( x, y ), vpart_id( "frame_vertical" ), true ) >= 0 );
+        }
+    }
+    for( int x = 0; x < 25; x += 6 ) {
+        REQUIRE( veh->install_part( point( x, 0 ), vpart_id( "wheel" ), true ) >= 0 );
+        REQUIRE( veh->install_part( point( x, 19 ), vpart_id( "wheel" ), true ) >= 0 );
+    }
+    here.add_vehicle_to_cache( veh );
+    return *veh;
+}
+
+static void place_obstacles_ahead( vehicle &veh )
+{
+    map &here = get_map();
+    tileray ahead( veh.face.dir() );
+    ahead.advance( 100 );
+    const point step( std::clamp( ahead.dx(), -1, 1 ), std::clamp( ahead.dy(), -1, 1 ) );
+    for( const tripoint &p : veh.get_points() ) {
+        const tripoint obstacle = p + step * 3;
+        if( here.inbounds( obstacle ) && !here.veh_at( obstacle ) ) {
+            here.furn_set( obstacle, f_chair );
+        }
+    }
+}
+
+static void vehicle_turn_benchmark( vehicle &veh )
+{
+    map &here = get_map();
+    veh.tags.insert( "IN_CONTROL_OVERRIDE" );
+    veh.engine_on = true;
+    veh.cruise_velocity = course_velocity;
+    const int part_count = veh.part_count();
+    const tripoint start_pos = veh.global_pos3();
+    rng_set_engine_seed( 4242424242 );
+
+    vehicle_turn_stats::reset();
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < benchmark_turns; turn++ ) {
+        if( turn % turns_between_obstacles == 0 ) {
+            place_obstacles_ahead( veh );
+        }
+        // Crashing slows it down, the course is driven at the same speed throughout
+        veh.velocity = course_velocity;
+        veh.skidding = false;
+        here.vehmove();
+        veh.idle( true );
+        // Bring it back so the course never runs off the map
+        here.displace_vehicle( veh, start_pos - veh.global_pos3() );
+        calendar::turn += 1_turns;
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start ).count();
+
+    cata_printf( "%s, %d parts, %d turns: %.3f ms, %.3f ms per turn\n", veh.name, part_count,
+                 benchmark_turns, total_ms, total_ms / benchmark_turns );
+    cata_printf( "%s", vehicle_turn_stats::report() );
+    CHECK( vehicle_turn_stats::count( vehicle_phase::move ) == benchmark_turns );
+    CHECK( vehicle_turn_stats::count( vehicle_phase::power ) > 0 );
+}
+
+static vehicle &spawn_prototype( const std::string &id, const tripoint &where )
+{
+    vehicle *veh = get_map().add_vehicle( vproto_id( id ), where, -90_degrees, 100, 0 );
+    REQUIRE( veh != nullptr );
+    return *veh;
+}
+
+TEST_CASE( "vehicle_turn_benchmark", "[.][vehicle][benchmark]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_pavement" ) );
+    const tripoint start_pos( 60, 60, 0 );
+
+    SECTION( "small car" ) {
+        vehicle_turn_benchmark( spawn_prototype( "car_mini", start_pos ) );
+    }
+    SECTION( "semi truck" ) {
+        vehicle_turn_benchmark( spawn_prototype( "semi_truck", start_pos ) );
+    }
+    SECTION( "500 part custom vehicle" ) {
+        vehicle_turn_benchmark( spawn_large_custom_vehicle( start_pos + point( -20, -10 ) ) );
+    }
+}
@@ -9,6 +9,7 @@
 #include "bodypart.h"
 #include "calendar.h"
 #include "game.h"
+#include "item.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "point.h"
@@ -301,3 +302,32 @@ TEST_CASE( "vehicle_drag", "[vehicle] [engine]" )
     test_vehicle_drag( "raft", 0.997815, 9.743243, 5.517750, 239, 508 );
     test_vehicle_drag( "inflatable_boat", 0.469560, 3.616690, 2.048188, 602, 1173 );
 }
+
+TEST_CASE( "drag_of_a_loaded_vehicle_matches_a_full_rebuild", "[vehicle]" )
+{
+    clear_all_state();
+    vehicle *veh_ptr = setup_drag_test( vproto_id( "car" ) );
+    REQUIRE( veh_ptr != nullptr );
+    const double c_rolling_empty = veh_ptr->coeff_rolling_drag();
+    const double c_water_empty = veh_ptr->coeff_water_drag();
+
+    // Loading cargo only changes the mass, so the wheels and hull are not looked at again
+    int cargo = -1;
+    for( const vpart_reference vp : veh_ptr->get_avail_parts( "CARGO" ) ) {
+        cargo = vp.part_index();
+        break;
+    }
+    REQUIRE( cargo >= 0 );
+    for( int i = 0; i < 20; i++ ) {
+        veh_ptr->add_item( cargo, item::spawn( itype_id( "rock" ) ) );
+    }
+    const double c_rolling_loaded = veh_ptr->coeff_rolling_drag();
+    const double c_water_loaded = veh_ptr->coeff_water_drag();
+    CHECK( c_rolling_loaded > c_rolling_empty );
+    CHECK( c_water_loaded > c_water_empty );
+
+    veh_ptr->suspend_refresh();
+    veh_ptr->enable_refresh();
+    CHECK( veh_ptr->coeff_rolling_drag() == Approx( c_rolling_loaded ) );
+    CHECK( veh_ptr->coeff_water_drag() == Approx( c_water_loaded ) );
+}
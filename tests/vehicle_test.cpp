@@ -17,6 +17,7 @@
 #include "vehicle.h"
 #include "vehicle_part.h"
 #include "vpart_position.h"
+#include "vpart_range.h"
 #include "veh_type.h"
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
@@ -201,3 +202,84 @@ TEST_CASE( "vehicle_rotation_reverse" )
         }
     }
 }
+
+// Parts the feature ranges should yield, by checking every part
+static std::vector<int> parts_by_scan( const vehicle &veh, const std::string &feature )
+{
+    std::vector<int> ret;
+    for( int p = 0; p < veh.part_count(); p++ ) {
+        const vehicle_part &vp = veh.cpart( p );
+        if( vp.info().has_flag( feature ) && !vp.removed && !vp.is_broken() ) {
+            ret.push_back( p );
+        }
+    }
+    return ret;
+}
+
+static std::vector<int> parts_by_range( const vehicle &veh, const std::string &feature )
+{
+    std::vector<int> ret;
+    for( const vpart_reference &vp : veh.get_parts_including_carried( feature ) ) {
+        ret.push_back( static_cast<int>( vp.part_index() ) );
+    }
+    return ret;
+}
+
+TEST_CASE( "feature_ranges_match_a_scan_of_all_parts", "[vehicle]" )
+{
+    clear_all_state();
+    const tripoint vehicle_origin( 60, 60, 0 );
+    vehicle *veh_ptr = get_map().add_vehicle( vproto_id( "car" ), vehicle_origin, 0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+
+    for( const std::string feature : {
+             "ENGINE", "WHEEL", "SEAT", "LIGHT", "CARGO", "NO_SUCH_FEATURE"
+         } ) {
+        CAPTURE( feature );
+        CHECK( parts_by_range( veh, feature ) == parts_by_scan( veh, feature ) );
+    }
+    CHECK( size( veh.get_any_parts( VPFLAG_WHEEL ) ) == size( veh.get_any_parts( "WHEEL" ) ) );
+
+    const std::vector<int> wheels = parts_by_scan( veh, "WHEEL" );
+    REQUIRE( wheels.size() > 1 );
+    veh.set_hp( veh.part( wheels.front() ), 0 );
+    veh.install_part( veh.part( wheels.back() ).mount, vpart_id( "wheel_mount_light" ), true );
+    CHECK( parts_by_range( veh, "WHEEL" ) == parts_by_scan( veh, "WHEEL" ) );
+    CHECK( parts_by_range( veh, "WHEEL_MOUNT" ) == parts_by_scan( veh, "WHEEL_MOUNT" ) );
+}
+
+TEST_CASE( "part_queries_match_a_scan_of_all_parts", "[vehicle]" )
+{
+    clear_all_state();
+    const tripoint vehicle_origin( 60, 60, 0 );
+    vehicle *veh_ptr = get_map().add_vehicle( vproto_id( "car" ), vehicle_origin, 0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+
+    const auto structure_by_scan = [&veh]() {
+        std::vector<int> ret;
+        for( int p = 0; p < veh.part_count(); p++ ) {
+            if( !veh.part( p ).removed && veh.part_info( p ).location == "structure" ) {
+                ret.push_back( p );
+            }
+        }
+        return ret;
+    };
+    CHECK( veh.all_parts_at_location( "structure" ) == structure_by_scan() );
+    CHECK( veh.has_part( "ENGINE" ) );
+    CHECK_FALSE( veh.has_part( "NO_SUCH_FEATURE" ) );
+
+    const std::vector<int> engines = parts_by_scan( veh, "ENGINE" );
+    REQUIRE( !engines.empty() );
+    const tripoint engine_pos = veh.global_part_pos3( engines.front() );
+    CHECK( veh.has_part( engine_pos, "ENGINE" ) );
+    for( int p : engines ) {
+        veh.set_hp( veh.part( p ), 0 );
+    }
+    CHECK_FALSE( veh.has_part( "ENGINE" ) );
+    CHECK_FALSE( veh.has_part( engine_pos, "ENGINE" ) );
+
+    veh.remove_part( engines.front() );
+    CHECK( veh.all_parts_at_location( "structure" ) == structure_by_scan() );
+}
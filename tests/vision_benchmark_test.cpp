@@ -0,0 +1,186 @@
+#include "catch/catch.hpp"
+
+#include <set>
+#include <string>
+
+#include "calendar.h"
+#include "character.h"
+#include "game_constants.h"
+#include "lightmap.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "point.h"
+#include "shadowcasting.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "units.h"
+#include "vehicle.h"
+#include "vehicle_part.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+#include "weather.h"
+
+// Timings of the vision and lighting stages on fixed scenes, so they can be compared between commits.
+// Run with: cata_test "[vision][benchmark]"
+
+// Reaches the stages of map::build_map_cache that aren't public
+class map_stages : public map
+{
+    public:
+        static void transparency( map &m, int z ) {
+            const auto update_weather = &map_stages::update_weather_transparency;
+            const auto build = &map_stages::build_transparency_cache;
+            m.set_transparency_cache_dirty( z );
+            ( m.*update_weather )();
+            ( m.*build )( z, get_weather().weather_id->sight_penalty );
+        }
+        static void seen( map &m, const tripoint &origin ) {
+            const auto build = &map_stages::build_seen_cache;
+            ( m.*build )( origin, origin.z );
+        }
+        static void lightmap( map &m, int z ) {
+            const auto generate = &map_stages::generate_lightmap;
+            ( m.*generate )( z );
+        }
+};
+
+static const time_point midnight = calendar::turn_zero + 0_hours;
+static const time_point midday = calendar::turn_zero + 12_hours;
+
+static four_quadrants light_output[MAPSIZE_X][MAPSIZE_Y];
+
+static void build_dense_city( map &here )
+{
+    const ter_id wall( "t_brick_wall" );
+    const ter_id window( "t_window" );
+    const ter_id roof( "t_flat_roof" );
+    // 16x16 blocks of 8x8 rooms, separated by 8 wide streets
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( x % 24 >= 16 || y % 24 >= 16 ) {
+                continue;
+            }
+            const tripoint p( x, y, 0 );
+            here.ter_set( p + tripoint_above, roof );
+            if( x % 8 == 0 || y % 8 == 0 ) {
+                const bool gap = x % 8 == 4 || y % 8 == 4;
+                here.ter_set( p, !gap ? wall : x % 24 == 4 || y % 24 == 4 ? window : t_floor );
+            } else {
+                here.ter_set( p, t_floor );
+            }
+        }
+    }
+}
+
+static void build_multi_level_building( map &here, const tripoint &center )
+{
+    const ter_id wall( "t_brick_wall" );
+    const ter_id window( "t_window" );
+    const ter_id roof( "t_flat_roof" );
+    constexpr int radius = 30;
+    for( int z = 0; z <= 4; z++ ) {
+        for( int dx = -radius; dx <= radius; dx++ ) {
+            for( int dy = -radius; dy <= radius; dy++ ) {
+                const tripoint p( center.x + dx, center.y + dy, z );
+                if( z == 4 ) {
+                    here.ter_set( p, roof );
+                } else if( dx % 10 == 0 || dy % 10 == 0 ) {
+                    here.ter_set( p, ( dx + dy ) % 5 == 0 ? window : wall );
+                } else {
+                    here.ter_set( p, t_floor );
+                }
+            }
+        }
+    }
+}
+
+static void build_vehicle_with_headlights( map &here, const tripoint &center )
+{
+    vehicle *veh = here.add_vehicle( vproto_id( "car" ), center + point( 4, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+    std::set<point> mounts;
+    for( const vpart_reference &vp : veh->get_all_parts() ) {
+        mounts.insert( vp.mount() );
+    }
+    for( const point &mount : mounts ) {
+        veh->install_part( mount, vpart_id( "headlight" ), true );
+    }
+    for( vehicle_part *light : veh->lights() ) {
+        light->enabled = true;
+    }
+    here.add_vehicle_to_cache( veh );
+}
+
+static void vision_benchmark( const std::string &fixture )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint origin = get_player_character().pos();
+    const int z = origin.z;
+
+    set_time( fixture == "vehicle with headlights" ? midnight : midday );
+    if( fixture == "dense city" ) {
+        build_dense_city( here );
+    } else if( fixture == "multi-level building" ) {
+        build_multi_level_building( here, origin );
+    } else if( fixture == "vehicle with headlights" ) {
+        build_vehicle_with_headlights( here, origin );
+    }
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+    const level_cache &cache = here.access_cache( z );
+
+    BENCHMARK( "build_transparency_cache" ) {
+        map_stages::transparency( here, z );
+    };
+    BENCHMARK( "castLightAll" ) {
+        castLightAll<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                     accumulate_transparency>( light_output, cache.transparency_cache,
+                                               cache.vehicle_obscured_cache, origin.xy(), 0, LIGHT_SOURCE_BRIGHT );
+    };
+    BENCHMARK( "cast_zlight" ) {
+        array_of_grids_of<float> outputs;
+        array_of_grids_of<const float> transparency;
+        array_of_grids_of<const bool> floors;
+        array_of_grids_of<const diagonal_blocks> blocked;
+        for( int level = -OVERMAP_DEPTH; level <= OVERMAP_HEIGHT; level++ ) {
+            level_cache &ch = here.access_cache( level );
+            outputs[level + OVERMAP_DEPTH] = &ch.camera_cache;
+            transparency[level + OVERMAP_DEPTH] = &ch.transparency_cache;
+            floors[level + OVERMAP_DEPTH] = &ch.floor_cache;
+            blocked[level + OVERMAP_DEPTH] = &ch.vehicle_obscured_cache;
+        }
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            outputs, transparency, floors, blocked, origin, 0, 1.0f );
+    };
+    BENCHMARK( "build_seen_cache" ) {
+        map_stages::seen( here, origin );
+    };
+    BENCHMARK( "generate_lightmap (rebuilt)" ) {
+        here.invalidate_map_cache( z );
+        map_stages::lightmap( here, z );
+    };
+    BENCHMARK( "generate_lightmap (unchanged)" ) {
+        map_stages::lightmap( here, z );
+    };
+    // The benchmarks above write into these
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+}
+
+TEST_CASE( "vision_benchmark", "[.][vision][lightmap][benchmark]" )
+{
+    SECTION( "open field" ) {
+        vision_benchmark( "open field" );
+    }
+    SECTION( "dense city" ) {
+        vision_benchmark( "dense city" );
+    }
+    SECTION( "multi-level building" ) {
+        vision_benchmark( "multi-level building" );
+    }
+    SECTION( "vehicle with headlights" ) {
+        vision_benchmark( "vehicle with headlights" );
+    }
+}
@@ -1,8 +1,12 @@
 #include "catch/catch.hpp"
 
+#include "avatar.h"
 #include "calendar.h"
 #include "inventory.h"
 #include "item.h"
+#include "player_helpers.h"
+#include "state_helpers.h"
+#include "type_id.h"
 
 TEST_CASE( "visitable_summation" )
 {
@@ -19,3 +23,44 @@ TEST_CASE( "visitable_summation" )
 
     CHECK( test_inv.charges_of( itype_id( "water" ), item::INFINITE_CHARGES ) > 1 );
 }
+
+TEST_CASE( "character_queries_count_what_visiting_finds", "[visitable]" )
+{
+    clear_all_state();
+    avatar &you = get_avatar();
+    clear_character( you );
+    // So nothing is dropped
+    you.wear_item( item::spawn( "backpack" ), false );
+    for( int i = 0; i < 5; i++ ) {
+        you.i_add( item::spawn( "spoon", calendar::turn ) );
+    }
+    detached_ptr<item> bottle_of_water = item::spawn( "bottle_plastic", calendar::turn );
+    detached_ptr<item> water_in_bottle = item::spawn( "water", calendar::turn );
+    water_in_bottle->charges = 2;
+    bottle_of_water->put_in( std::move( water_in_bottle ) );
+    you.i_add( std::move( bottle_of_water ) );
+    you.i_add( item::spawn( "hammer", calendar::turn ) );
+
+    int spoons = 0;
+    int water = 0;
+    int hammers = 0;
+    const quality_id hammering( "HAMMER" );
+    you.visit_items( [&]( const item * e ) {
+        spoons += e->typeId() == itype_id( "spoon" );
+        water += e->typeId() == itype_id( "water" ) ? e->charges : 0;
+        hammers += e->get_quality( hammering ) >= 1;
+        return VisitResponse::NEXT;
+    } );
+    REQUIRE( spoons == 5 );
+    REQUIRE( water == 2 );
+    REQUIRE( hammers == 1 );
+
+    CHECK( you.amount_of( itype_id( "spoon" ) ) == spoons );
+    CHECK( you.has_amount( itype_id( "spoon" ), 5 ) );
+    CHECK_FALSE( you.has_amount( itype_id( "spoon" ), 6 ) );
+    CHECK( you.charges_of( itype_id( "water" ) ) == water );
+    CHECK( you.amount_of( itype_id( "bottle_plastic" ) ) == 1 );
+    CHECK( you.amount_of( itype_id( "water" ) ) == 1 );
+    CHECK( you.has_quality( hammering, 1, 1 ) );
+    CHECK_FALSE( you.has_quality( hammering, 1, 2 ) );
+}